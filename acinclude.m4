@@ -9,8 +9,45 @@ AC_DEFUN([AX_LIBPHDI_CHECK_LOCAL],
 
   dnl Check for internationalization functions in libphdi/libphdi_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
+
+  dnl Headers and functions included in libphdi/libphdi_mapped_file.c
+  AC_CHECK_HEADERS([errno.h fcntl.h sys/mman.h sys/stat.h unistd.h])
+
+  AC_CHECK_FUNCS([mmap munmap])
+
+  dnl Headers and functions included in libphdi/libphdi_statistics.c
+  AC_CHECK_HEADERS([sys/time.h])
+
+  AC_CHECK_FUNCS([clock_gettime])
 ])
 
+dnl Function to detect if static tracing probes should be enabled
+AC_DEFUN([AX_LIBPHDI_CHECK_ENABLE_PROBES],
+  [AX_COMMON_ARG_ENABLE(
+    [probes],
+    [probes],
+    [enable static tracing probes (USDT)],
+    [no])
+
+  AS_IF(
+    [test "x$ac_cv_enable_probes" != xno],
+    [AC_CHECK_HEADERS([sys/sdt.h])
+
+    AS_IF(
+      [test "x$ac_cv_header_sys_sdt_h" != xyes],
+      [AC_MSG_FAILURE(
+        [Missing header: sys/sdt.h required for static tracing probes],
+        [1])
+      ])
+
+    AC_DEFINE(
+      [HAVE_LIBPHDI_PROBES],
+      [1],
+      [Define to 1 if static tracing probes should be used.])
+
+    ac_cv_enable_probes=yes])
+  ])
+
 dnl Function to detect if phditools dependencies are available
 AC_DEFUN([AX_PHDITOOLS_CHECK_LOCAL],
   [AC_CHECK_HEADERS([signal.h sys/signal.h unistd.h])
@@ -32,6 +69,19 @@ AC_DEFUN([AX_PHDITOOLS_CHECK_LOCAL],
     [test "x$ac_cv_enable_winapi" = xno],
     [AC_CHECK_FUNCS([clock_gettime getegid geteuid time])
   ])
+
+  dnl Functions included in phditools/bench_handle.c
+  AC_SEARCH_LIBS(
+    [log1p],
+    [m])
+])
+
+dnl Function to detect if the benchmark dependencies are available
+AC_DEFUN([AX_LIBPHDI_CHECK_BENCHMARKS],
+  [dnl Headers and functions included in tests/phdi_bench_metadata.c
+  AC_CHECK_HEADERS([malloc.h])
+
+  AC_CHECK_FUNCS([mallinfo2])
 ])
 
 dnl Function to check if DLL support is needed
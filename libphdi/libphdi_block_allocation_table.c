@@ -0,0 +1,693 @@
+/*
+ * Block allocation table functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libphdi_block_allocation_table.h"
+#include "libphdi_definitions.h"
+#include "libphdi_libbfio.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_libcnotify.h"
+#include "libphdi_probes.h"
+#include "libphdi_statistics.h"
+
+/* Creates a block allocation table
+ * Make sure the value block_allocation_table is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_block_allocation_table_initialize(
+     libphdi_block_allocation_table_t **block_allocation_table,
+     int file_io_pool_entry,
+     off64_t file_offset,
+     uint32_t number_of_entries,
+     int maximum_number_of_loaded_pages,
+     libcerror_error_t **error )
+{
+	static char *function    = "libphdi_block_allocation_table_initialize";
+	size_t pages_size        = 0;
+	uint32_t number_of_pages = 0;
+
+	if( block_allocation_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block allocation table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_allocation_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block allocation table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_loaded_pages <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of loaded pages value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_pages = number_of_entries / LIBPHDI_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES_PER_PAGE;
+
+	if( ( number_of_entries % LIBPHDI_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES_PER_PAGE ) != 0 )
+	{
+		number_of_pages += 1;
+	}
+	pages_size = sizeof( libphdi_block_allocation_table_page_t * ) * number_of_pages;
+
+	if( pages_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid pages size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*block_allocation_table = memory_allocate_structure(
+	                           libphdi_block_allocation_table_t );
+
+	if( *block_allocation_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block allocation table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *block_allocation_table,
+	     0,
+	     sizeof( libphdi_block_allocation_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block allocation table.",
+		 function );
+
+		memory_free(
+		 *block_allocation_table );
+
+		*block_allocation_table = NULL;
+
+		return( -1 );
+	}
+	( *block_allocation_table )->pages = (libphdi_block_allocation_table_page_t **) memory_allocate(
+	                                                                                 pages_size );
+
+	if( ( *block_allocation_table )->pages == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create pages.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *block_allocation_table )->pages,
+	     0,
+	     pages_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear pages.",
+		 function );
+
+		goto on_error;
+	}
+	( *block_allocation_table )->file_io_pool_entry             = file_io_pool_entry;
+	( *block_allocation_table )->file_offset                    = file_offset;
+	( *block_allocation_table )->number_of_entries              = number_of_entries;
+	( *block_allocation_table )->number_of_pages                = number_of_pages;
+	( *block_allocation_table )->maximum_number_of_loaded_pages = maximum_number_of_loaded_pages;
+
+	return( 1 );
+
+on_error:
+	if( *block_allocation_table != NULL )
+	{
+		if( ( *block_allocation_table )->pages != NULL )
+		{
+			memory_free(
+			 ( *block_allocation_table )->pages );
+		}
+		memory_free(
+		 *block_allocation_table );
+
+		*block_allocation_table = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a block allocation table
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_block_allocation_table_free(
+     libphdi_block_allocation_table_t **block_allocation_table,
+     libcerror_error_t **error )
+{
+	libphdi_block_allocation_table_page_t *next_page = NULL;
+	libphdi_block_allocation_table_page_t *page      = NULL;
+	static char *function                            = "libphdi_block_allocation_table_free";
+
+	if( block_allocation_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block allocation table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_allocation_table != NULL )
+	{
+		page = ( *block_allocation_table )->first_page;
+
+		while( page != NULL )
+		{
+			next_page = page->next_page;
+
+			memory_free(
+			 page );
+
+			page = next_page;
+		}
+		if( ( *block_allocation_table )->pages != NULL )
+		{
+			memory_free(
+			 ( *block_allocation_table )->pages );
+		}
+		memory_free(
+		 *block_allocation_table );
+
+		*block_allocation_table = NULL;
+	}
+	return( 1 );
+}
+
+/* Moves a page to the front of the most recently used list
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_block_allocation_table_move_page_to_front(
+     libphdi_block_allocation_table_t *block_allocation_table,
+     libphdi_block_allocation_table_page_t *page,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_block_allocation_table_move_page_to_front";
+
+	if( block_allocation_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block allocation table.",
+		 function );
+
+		return( -1 );
+	}
+	if( page == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid page.",
+		 function );
+
+		return( -1 );
+	}
+	if( page == block_allocation_table->first_page )
+	{
+		return( 1 );
+	}
+	page->previous_page->next_page = page->next_page;
+
+	if( page->next_page != NULL )
+	{
+		page->next_page->previous_page = page->previous_page;
+	}
+	else
+	{
+		block_allocation_table->last_page = page->previous_page;
+	}
+	page->previous_page = NULL;
+	page->next_page     = block_allocation_table->first_page;
+
+	block_allocation_table->first_page->previous_page = page;
+	block_allocation_table->first_page                = page;
+
+	return( 1 );
+}
+
+/* Retrieves a specific page, the page is read if it is not loaded
+ * When the maximum number of loaded pages is reached the least recently used page is reused
+ * A page that was marked as referenced by a concurrent reader is given a second chance,
+ * it is moved to the front of the most recently used list instead and its mark is cleared
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_block_allocation_table_read_page(
+     libphdi_block_allocation_table_t *block_allocation_table,
+     libbfio_pool_t *file_io_pool,
+     uint32_t page_index,
+     libphdi_block_allocation_table_page_t **page,
+     libcerror_error_t **error )
+{
+	libphdi_block_allocation_table_page_t *safe_page = NULL;
+	static char *function                            = "libphdi_block_allocation_table_read_page";
+	size_t read_size                                 = 0;
+	ssize_t read_count                               = 0;
+	off64_t file_offset                              = 0;
+	uint32_t entry_index                             = 0;
+	uint32_t number_of_entries                       = 0;
+	uint32_t value_32bit                             = 0;
+
+	if( block_allocation_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block allocation table.",
+		 function );
+
+		return( -1 );
+	}
+	if( page_index >= block_allocation_table->number_of_pages )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid page index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( page == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid page.",
+		 function );
+
+		return( -1 );
+	}
+	safe_page = block_allocation_table->pages[ page_index ];
+
+	if( safe_page != NULL )
+	{
+		libphdi_statistics_atomic_set32(
+		 &( safe_page->is_referenced ),
+		 0 );
+
+		if( libphdi_block_allocation_table_move_page_to_front(
+		     block_allocation_table,
+		     safe_page,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to move page: %" PRIu32 " to front.",
+			 function,
+			 page_index );
+
+			return( -1 );
+		}
+		*page = safe_page;
+
+		return( 1 );
+	}
+	if( block_allocation_table->number_of_loaded_pages >= block_allocation_table->maximum_number_of_loaded_pages )
+	{
+		/* Reuse the least recently used page that was not referenced since
+		 * it was last considered, every iteration clears a referenced mark
+		 * hence the loop ends
+		 */
+		safe_page = block_allocation_table->last_page;
+
+		while( libphdi_statistics_atomic_get32(
+		        &( safe_page->is_referenced ) ) != 0 )
+		{
+			libphdi_statistics_atomic_set32(
+			 &( safe_page->is_referenced ),
+			 0 );
+
+			if( libphdi_block_allocation_table_move_page_to_front(
+			     block_allocation_table,
+			     safe_page,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to move page: %" PRIu32 " to front.",
+				 function,
+				 safe_page->page_index );
+
+				return( -1 );
+			}
+			safe_page = block_allocation_table->last_page;
+		}
+		block_allocation_table->last_page = safe_page->previous_page;
+
+		if( block_allocation_table->last_page != NULL )
+		{
+			block_allocation_table->last_page->next_page = NULL;
+		}
+		else
+		{
+			block_allocation_table->first_page = NULL;
+		}
+		block_allocation_table->pages[ safe_page->page_index ] = NULL;
+		block_allocation_table->number_of_loaded_pages        -= 1;
+	}
+	else
+	{
+		safe_page = memory_allocate_structure(
+		             libphdi_block_allocation_table_page_t );
+
+		if( safe_page == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create page.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	number_of_entries = block_allocation_table->number_of_entries - ( page_index * LIBPHDI_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES_PER_PAGE );
+
+	if( number_of_entries > LIBPHDI_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES_PER_PAGE )
+	{
+		number_of_entries = LIBPHDI_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES_PER_PAGE;
+	}
+	read_size   = (size_t) number_of_entries * 4;
+	file_offset = block_allocation_table->file_offset + ( (off64_t) page_index * LIBPHDI_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES_PER_PAGE * 4 );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading block allocation table page: %" PRIu32 " at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 page_index,
+		 file_offset,
+		 file_offset );
+	}
+#endif
+	read_count = libbfio_pool_read_buffer_at_offset(
+	              file_io_pool,
+	              block_allocation_table->file_io_pool_entry,
+	              (uint8_t *) safe_page->entries,
+	              read_size,
+	              file_offset,
+	              error );
+
+	LIBPHDI_PROBE4(
+	 block_allocation_table__page__read,
+	 block_allocation_table->file_io_pool_entry,
+	 page_index,
+	 (int64_t) file_offset,
+	 (int64_t) read_count );
+
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block allocation table page: %" PRIu32 " at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 page_index,
+		 file_offset,
+		 file_offset );
+
+		goto on_error;
+	}
+	/* The entries are decoded in place, each entry is read before it is overwritten
+	 */
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( ( (uint8_t *) safe_page->entries )[ entry_index * 4 ] ),
+		 value_32bit );
+
+		safe_page->entries[ entry_index ] = value_32bit;
+	}
+	for( entry_index = number_of_entries;
+	     entry_index < LIBPHDI_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES_PER_PAGE;
+	     entry_index++ )
+	{
+		safe_page->entries[ entry_index ] = 0;
+	}
+	safe_page->page_index    = page_index;
+	safe_page->previous_page = NULL;
+	safe_page->next_page     = block_allocation_table->first_page;
+	safe_page->is_referenced = 0;
+
+	if( block_allocation_table->first_page != NULL )
+	{
+		block_allocation_table->first_page->previous_page = safe_page;
+	}
+	else
+	{
+		block_allocation_table->last_page = safe_page;
+	}
+	block_allocation_table->first_page             = safe_page;
+	block_allocation_table->pages[ page_index ]    = safe_page;
+	block_allocation_table->number_of_loaded_pages += 1;
+
+	*page = safe_page;
+
+	return( 1 );
+
+on_error:
+	if( safe_page != NULL )
+	{
+		memory_free(
+		 safe_page );
+	}
+	return( -1 );
+}
+
+/* Retrieves a specific entry
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_block_allocation_table_get_entry_by_index(
+     libphdi_block_allocation_table_t *block_allocation_table,
+     libbfio_pool_t *file_io_pool,
+     uint32_t entry_index,
+     uint32_t *entry,
+     libcerror_error_t **error )
+{
+	libphdi_block_allocation_table_page_t *page = NULL;
+	static char *function                       = "libphdi_block_allocation_table_get_entry_by_index";
+	uint32_t page_index                         = 0;
+
+	if( block_allocation_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block allocation table.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index >= block_allocation_table->number_of_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	page_index = entry_index / LIBPHDI_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES_PER_PAGE;
+
+	if( libphdi_block_allocation_table_read_page(
+	     block_allocation_table,
+	     file_io_pool,
+	     page_index,
+	     &page,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read page: %" PRIu32 ".",
+		 function,
+		 page_index );
+
+		return( -1 );
+	}
+	*entry = page->entries[ entry_index % LIBPHDI_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES_PER_PAGE ];
+
+	return( 1 );
+}
+
+/* Retrieves a specific entry if its page is loaded
+ * The page is not read and not moved in the most recently used list, so that
+ * the block allocation table can be used by concurrent readers. The page is
+ * only marked as referenced, atomically, so that it is not reused the next
+ * time a page is read
+ * Returns 1 if successful, 0 if the page is not loaded or -1 on error
+ */
+int libphdi_block_allocation_table_get_loaded_entry_by_index(
+     libphdi_block_allocation_table_t *block_allocation_table,
+     uint32_t entry_index,
+     uint32_t *entry,
+     libcerror_error_t **error )
+{
+	libphdi_block_allocation_table_page_t *page = NULL;
+	static char *function                       = "libphdi_block_allocation_table_get_loaded_entry_by_index";
+
+	if( block_allocation_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block allocation table.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index >= block_allocation_table->number_of_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	page = block_allocation_table->pages[ entry_index / LIBPHDI_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES_PER_PAGE ];
+
+	if( page == NULL )
+	{
+		return( 0 );
+	}
+	/* Only mark the page when needed to prevent concurrent readers from writing the same cache line
+	 */
+	if( libphdi_statistics_atomic_get32(
+	     &( page->is_referenced ) ) == 0 )
+	{
+		libphdi_statistics_atomic_set32(
+		 &( page->is_referenced ),
+		 1 );
+	}
+	*entry = page->entries[ entry_index % LIBPHDI_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES_PER_PAGE ];
+
+	return( 1 );
+}
+
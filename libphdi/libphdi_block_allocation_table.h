@@ -0,0 +1,144 @@
+/*
+ * Block allocation table functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPHDI_BLOCK_ALLOCATION_TABLE_H )
+#define _LIBPHDI_BLOCK_ALLOCATION_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libphdi_definitions.h"
+#include "libphdi_libbfio.h"
+#include "libphdi_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libphdi_block_allocation_table_page libphdi_block_allocation_table_page_t;
+
+struct libphdi_block_allocation_table_page
+{
+	/* The page index
+	 */
+	uint32_t page_index;
+
+	/* The (decoded) entries
+	 */
+	uint32_t entries[ LIBPHDI_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES_PER_PAGE ];
+
+	/* The previous (more recently used) page
+	 */
+	libphdi_block_allocation_table_page_t *previous_page;
+
+	/* The next (less recently used) page
+	 */
+	libphdi_block_allocation_table_page_t *next_page;
+
+	/* Value to indicate the page was used by a concurrent reader, which is updated atomically
+	 */
+	int is_referenced;
+};
+
+typedef struct libphdi_block_allocation_table libphdi_block_allocation_table_t;
+
+struct libphdi_block_allocation_table
+{
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The file offset
+	 */
+	off64_t file_offset;
+
+	/* The number of entries
+	 */
+	uint32_t number_of_entries;
+
+	/* The number of pages
+	 */
+	uint32_t number_of_pages;
+
+	/* The pages, contains a page if it is loaded or NULL otherwise
+	 */
+	libphdi_block_allocation_table_page_t **pages;
+
+	/* The most recently used page
+	 */
+	libphdi_block_allocation_table_page_t *first_page;
+
+	/* The least recently used page
+	 */
+	libphdi_block_allocation_table_page_t *last_page;
+
+	/* The number of loaded pages
+	 */
+	int number_of_loaded_pages;
+
+	/* The maximum number of loaded pages
+	 */
+	int maximum_number_of_loaded_pages;
+};
+
+int libphdi_block_allocation_table_initialize(
+     libphdi_block_allocation_table_t **block_allocation_table,
+     int file_io_pool_entry,
+     off64_t file_offset,
+     uint32_t number_of_entries,
+     int maximum_number_of_loaded_pages,
+     libcerror_error_t **error );
+
+int libphdi_block_allocation_table_free(
+     libphdi_block_allocation_table_t **block_allocation_table,
+     libcerror_error_t **error );
+
+int libphdi_block_allocation_table_move_page_to_front(
+     libphdi_block_allocation_table_t *block_allocation_table,
+     libphdi_block_allocation_table_page_t *page,
+     libcerror_error_t **error );
+
+int libphdi_block_allocation_table_read_page(
+     libphdi_block_allocation_table_t *block_allocation_table,
+     libbfio_pool_t *file_io_pool,
+     uint32_t page_index,
+     libphdi_block_allocation_table_page_t **page,
+     libcerror_error_t **error );
+
+int libphdi_block_allocation_table_get_entry_by_index(
+     libphdi_block_allocation_table_t *block_allocation_table,
+     libbfio_pool_t *file_io_pool,
+     uint32_t entry_index,
+     uint32_t *entry,
+     libcerror_error_t **error );
+
+int libphdi_block_allocation_table_get_loaded_entry_by_index(
+     libphdi_block_allocation_table_t *block_allocation_table,
+     uint32_t entry_index,
+     uint32_t *entry,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPHDI_BLOCK_ALLOCATION_TABLE_H ) */
+
@@ -0,0 +1,489 @@
+/*
+ * Borrowed buffers functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libphdi_borrowed_buffers.h"
+#include "libphdi_libcdata.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_libcthreads.h"
+
+/* Creates borrowed buffers
+ * Make sure the value borrowed_buffers is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_borrowed_buffers_initialize(
+     libphdi_borrowed_buffers_t **borrowed_buffers,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_borrowed_buffers_initialize";
+
+	if( borrowed_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid borrowed buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( *borrowed_buffers != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid borrowed buffers value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*borrowed_buffers = memory_allocate_structure(
+	                     libphdi_borrowed_buffers_t );
+
+	if( *borrowed_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create borrowed buffers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *borrowed_buffers,
+	     0,
+	     sizeof( libphdi_borrowed_buffers_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear borrowed buffers.",
+		 function );
+
+		memory_free(
+		 *borrowed_buffers );
+
+		*borrowed_buffers = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *borrowed_buffers )->buffers_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create buffers array.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *borrowed_buffers )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *borrowed_buffers != NULL )
+	{
+		if( ( *borrowed_buffers )->buffers_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *borrowed_buffers )->buffers_array ),
+			 NULL,
+			 NULL );
+		}
+		memory_free(
+		 *borrowed_buffers );
+
+		*borrowed_buffers = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees borrowed buffers
+ * The buffers themselves are not owned by the borrowed buffers and are not freed
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_borrowed_buffers_free(
+     libphdi_borrowed_buffers_t **borrowed_buffers,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_borrowed_buffers_free";
+	int result            = 1;
+
+	if( borrowed_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid borrowed buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( *borrowed_buffers != NULL )
+	{
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *borrowed_buffers )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( libcdata_array_free(
+		     &( ( *borrowed_buffers )->buffers_array ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free buffers array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *borrowed_buffers );
+
+		*borrowed_buffers = NULL;
+	}
+	return( result );
+}
+
+/* Appends a borrowed buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_borrowed_buffers_append_buffer(
+     libphdi_borrowed_buffers_t *borrowed_buffers,
+     const uint8_t *buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_borrowed_buffers_append_buffer";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( borrowed_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid borrowed buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     borrowed_buffers->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_append_entry(
+	     borrowed_buffers->buffers_array,
+	     &entry_index,
+	     (intptr_t *) buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append buffer to array.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     borrowed_buffers->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Removes a borrowed buffer
+ * A buffer that was borrowed multiple times is removed once
+ * Returns 1 if successful, 0 if the buffer was not borrowed or -1 on error
+ */
+int libphdi_borrowed_buffers_remove_buffer(
+     libphdi_borrowed_buffers_t *borrowed_buffers,
+     const uint8_t *buffer,
+     libcerror_error_t **error )
+{
+	intptr_t *entry       = NULL;
+	static char *function = "libphdi_borrowed_buffers_remove_buffer";
+	int entry_index       = 0;
+	int number_of_entries = 0;
+	int result            = 0;
+
+	if( borrowed_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid borrowed buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     borrowed_buffers->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_number_of_entries(
+	     borrowed_buffers->buffers_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		result = -1;
+	}
+	/* The most recently borrowed buffers are at the end of the array
+	 */
+	for( entry_index = number_of_entries - 1;
+	     entry_index >= 0;
+	     entry_index-- )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     borrowed_buffers->buffers_array,
+		     entry_index,
+		     &entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d.",
+			 function,
+			 entry_index );
+
+			result = -1;
+
+			break;
+		}
+		if( entry == (intptr_t *) buffer )
+		{
+			if( libcdata_array_remove_entry(
+			     borrowed_buffers->buffers_array,
+			     entry_index,
+			     &entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to remove entry: %d.",
+				 function,
+				 entry_index );
+
+				result = -1;
+			}
+			else
+			{
+				result = 1;
+			}
+			break;
+		}
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     borrowed_buffers->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of borrowed buffers
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_borrowed_buffers_get_number_of_buffers(
+     libphdi_borrowed_buffers_t *borrowed_buffers,
+     int *number_of_buffers,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_borrowed_buffers_get_number_of_buffers";
+	int result            = 1;
+
+	if( borrowed_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid borrowed buffers.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     borrowed_buffers->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_number_of_entries(
+	     borrowed_buffers->buffers_array,
+	     number_of_buffers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     borrowed_buffers->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
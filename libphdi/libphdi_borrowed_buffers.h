@@ -0,0 +1,82 @@
+/*
+ * Borrowed buffers functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPHDI_BORROWED_BUFFERS_H )
+#define _LIBPHDI_BORROWED_BUFFERS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libphdi_libcdata.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libphdi_borrowed_buffers libphdi_borrowed_buffers_t;
+
+/* The borrowed buffers keep track of the buffers that were borrowed from
+ * a memory region, such as a memory mapped file, and have not been released
+ */
+struct libphdi_borrowed_buffers
+{
+	/* The buffers array, the same buffer is contained once for every time it was borrowed
+	 */
+	libcdata_array_t *buffers_array;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libphdi_borrowed_buffers_initialize(
+     libphdi_borrowed_buffers_t **borrowed_buffers,
+     libcerror_error_t **error );
+
+int libphdi_borrowed_buffers_free(
+     libphdi_borrowed_buffers_t **borrowed_buffers,
+     libcerror_error_t **error );
+
+int libphdi_borrowed_buffers_append_buffer(
+     libphdi_borrowed_buffers_t *borrowed_buffers,
+     const uint8_t *buffer,
+     libcerror_error_t **error );
+
+int libphdi_borrowed_buffers_remove_buffer(
+     libphdi_borrowed_buffers_t *borrowed_buffers,
+     const uint8_t *buffer,
+     libcerror_error_t **error );
+
+int libphdi_borrowed_buffers_get_number_of_buffers(
+     libphdi_borrowed_buffers_t *borrowed_buffers,
+     int *number_of_buffers,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPHDI_BORROWED_BUFFERS_H ) */
+
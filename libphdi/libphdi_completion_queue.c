@@ -0,0 +1,723 @@
+/*
+ * Completion queue functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libphdi_completion_queue.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_libcthreads.h"
+#include "libphdi_read_request.h"
+
+/* Creates a completion queue
+ * Make sure the value completion_queue is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_completion_queue_initialize(
+     libphdi_completion_queue_t **completion_queue,
+     int maximum_number_of_requests,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_completion_queue_initialize";
+	size_t requests_size  = 0;
+
+	if( completion_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid completion queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *completion_queue != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid completion queue value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_requests <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of requests value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	requests_size = sizeof( libphdi_read_request_t * ) * maximum_number_of_requests;
+
+	if( requests_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid requests size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*completion_queue = memory_allocate_structure(
+	                     libphdi_completion_queue_t );
+
+	if( *completion_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create completion queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *completion_queue,
+	     0,
+	     sizeof( libphdi_completion_queue_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear completion queue.",
+		 function );
+
+		memory_free(
+		 *completion_queue );
+
+		*completion_queue = NULL;
+
+		return( -1 );
+	}
+	( *completion_queue )->requests = (libphdi_read_request_t **) memory_allocate(
+	                                                                requests_size );
+
+	if( ( *completion_queue )->requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *completion_queue )->requests,
+	     0,
+	     requests_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear requests.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *completion_queue )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *completion_queue )->completed_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize completed condition.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *completion_queue )->maximum_number_of_requests = maximum_number_of_requests;
+
+	return( 1 );
+
+on_error:
+	if( *completion_queue != NULL )
+	{
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( ( *completion_queue )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *completion_queue )->mutex ),
+			 NULL );
+		}
+#endif
+		if( ( *completion_queue )->requests != NULL )
+		{
+			memory_free(
+			 ( *completion_queue )->requests );
+		}
+		memory_free(
+		 *completion_queue );
+
+		*completion_queue = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a completion queue
+ * The completed requests that were not retrieved are freed as well
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_completion_queue_free(
+     libphdi_completion_queue_t **completion_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_completion_queue_free";
+	int request_index     = 0;
+	int result            = 1;
+
+	if( completion_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid completion queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *completion_queue != NULL )
+	{
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_condition_free(
+		     &( ( *completion_queue )->completed_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free completed condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *completion_queue )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		for( request_index = 0;
+		     request_index < ( *completion_queue )->maximum_number_of_requests;
+		     request_index++ )
+		{
+			if( libphdi_read_request_free(
+			     &( ( *completion_queue )->requests[ request_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free request: %d.",
+				 function,
+				 request_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 ( *completion_queue )->requests );
+
+		memory_free(
+		 *completion_queue );
+
+		*completion_queue = NULL;
+	}
+	return( result );
+}
+
+/* Reserves a request in the completion queue
+ * The reserved request is pending until it is completed or cancelled
+ * Returns 1 if successful, 0 if the maximum number of requests was reached or -1 on error
+ */
+int libphdi_completion_queue_reserve_request(
+     libphdi_completion_queue_t *completion_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_completion_queue_reserve_request";
+	int result            = 0;
+
+	if( completion_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid completion queue.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     completion_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( completion_queue->number_of_pending_requests + completion_queue->number_of_completed_requests ) < completion_queue->maximum_number_of_requests )
+	{
+		completion_queue->number_of_pending_requests += 1;
+
+		result = 1;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     completion_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Cancels a reserved request in the completion queue
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_completion_queue_cancel_request(
+     libphdi_completion_queue_t *completion_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_completion_queue_cancel_request";
+	int result            = 1;
+
+	if( completion_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid completion queue.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     completion_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( completion_queue->number_of_pending_requests <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid completion queue - number of pending requests value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		completion_queue->number_of_pending_requests -= 1;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	/* Waiters are woken up since there can be no more pending requests
+	 */
+	if( libcthreads_condition_broadcast(
+	     completion_queue->completed_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast completed condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     completion_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Completes a reserved request in the completion queue
+ * The completion queue takes over management of the request
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_completion_queue_complete_request(
+     libphdi_completion_queue_t *completion_queue,
+     libphdi_read_request_t *read_request,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_completion_queue_complete_request";
+	int request_index     = 0;
+	int result            = 1;
+
+	if( completion_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid completion queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     completion_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( completion_queue->number_of_pending_requests <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid completion queue - number of pending requests value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		/* The reservation guarantees that there is room for the request
+		 */
+		request_index = ( completion_queue->first_request_index + completion_queue->number_of_completed_requests ) % completion_queue->maximum_number_of_requests;
+
+		completion_queue->requests[ request_index ] = read_request;
+
+		completion_queue->number_of_pending_requests   -= 1;
+		completion_queue->number_of_completed_requests += 1;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_condition_broadcast(
+		     completion_queue->completed_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast completed condition.",
+			 function );
+
+			result = -1;
+		}
+#endif
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     completion_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a completed request from the completion queue
+ * If wait is set the function waits until a request is completed, unless there are no pending requests
+ * The caller takes over management of the request
+ * Returns 1 if successful, 0 if no completed request is available or -1 on error
+ */
+int libphdi_completion_queue_get_completed_request(
+     libphdi_completion_queue_t *completion_queue,
+     uint8_t wait,
+     libphdi_read_request_t **read_request,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_completion_queue_get_completed_request";
+	int result            = 0;
+
+	if( completion_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid completion queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     completion_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( wait != 0 )
+	    && ( completion_queue->number_of_completed_requests == 0 )
+	    && ( completion_queue->number_of_pending_requests > 0 ) )
+	{
+		if( libcthreads_condition_wait(
+		     completion_queue->completed_condition,
+		     completion_queue->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for completed condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 completion_queue->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+#endif
+	if( completion_queue->number_of_completed_requests > 0 )
+	{
+		*read_request = completion_queue->requests[ completion_queue->first_request_index ];
+
+		completion_queue->requests[ completion_queue->first_request_index ] = NULL;
+
+		completion_queue->first_request_index = ( completion_queue->first_request_index + 1 ) % completion_queue->maximum_number_of_requests;
+
+		completion_queue->number_of_completed_requests -= 1;
+
+		result = 1;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     completion_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of pending and completed requests
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_completion_queue_get_number_of_requests(
+     libphdi_completion_queue_t *completion_queue,
+     int *number_of_pending_requests,
+     int *number_of_completed_requests,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_completion_queue_get_number_of_requests";
+
+	if( completion_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid completion queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_pending_requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of pending requests.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_completed_requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of completed requests.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     completion_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_pending_requests   = completion_queue->number_of_pending_requests;
+	*number_of_completed_requests = completion_queue->number_of_completed_requests;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     completion_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
@@ -0,0 +1,115 @@
+/*
+ * Completion queue functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPHDI_COMPLETION_QUEUE_H )
+#define _LIBPHDI_COMPLETION_QUEUE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libphdi_libcerror.h"
+#include "libphdi_libcthreads.h"
+#include "libphdi_read_request.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libphdi_completion_queue libphdi_completion_queue_t;
+
+/* The completion queue tracks the submitted read requests, a request is pending
+ * from when it is submitted until it is completed and is then queued until it is
+ * retrieved. The number of pending and completed requests together is limited
+ * so that submitting a request never has to wait for a request to be retrieved
+ */
+struct libphdi_completion_queue
+{
+	/* The completed requests
+	 */
+	libphdi_read_request_t **requests;
+
+	/* The maximum number of requests
+	 */
+	int maximum_number_of_requests;
+
+	/* The index of the first completed request
+	 */
+	int first_request_index;
+
+	/* The number of completed requests
+	 */
+	int number_of_completed_requests;
+
+	/* The number of pending requests
+	 */
+	int number_of_pending_requests;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when a request completes
+	 */
+	libcthreads_condition_t *completed_condition;
+#endif
+};
+
+int libphdi_completion_queue_initialize(
+     libphdi_completion_queue_t **completion_queue,
+     int maximum_number_of_requests,
+     libcerror_error_t **error );
+
+int libphdi_completion_queue_free(
+     libphdi_completion_queue_t **completion_queue,
+     libcerror_error_t **error );
+
+int libphdi_completion_queue_reserve_request(
+     libphdi_completion_queue_t *completion_queue,
+     libcerror_error_t **error );
+
+int libphdi_completion_queue_cancel_request(
+     libphdi_completion_queue_t *completion_queue,
+     libcerror_error_t **error );
+
+int libphdi_completion_queue_complete_request(
+     libphdi_completion_queue_t *completion_queue,
+     libphdi_read_request_t *read_request,
+     libcerror_error_t **error );
+
+int libphdi_completion_queue_get_completed_request(
+     libphdi_completion_queue_t *completion_queue,
+     uint8_t wait,
+     libphdi_read_request_t **read_request,
+     libcerror_error_t **error );
+
+int libphdi_completion_queue_get_number_of_requests(
+     libphdi_completion_queue_t *completion_queue,
+     int *number_of_pending_requests,
+     int *number_of_completed_requests,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPHDI_COMPLETION_QUEUE_H ) */
+
@@ -0,0 +1,68 @@
+/*
+ * Data block functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPHDI_DATA_BLOCK_H )
+#define _LIBPHDI_DATA_BLOCK_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libphdi_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libphdi_data_block libphdi_data_block_t;
+
+struct libphdi_data_block
+{
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+};
+
+int libphdi_data_block_initialize(
+     libphdi_data_block_t **data_block,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libphdi_data_block_free(
+     libphdi_data_block_t **data_block,
+     libcerror_error_t **error );
+
+ssize_t libphdi_data_block_copy_data(
+         libphdi_data_block_t *data_block,
+         size_t data_offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPHDI_DATA_BLOCK_H ) */
+
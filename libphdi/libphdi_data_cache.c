@@ -0,0 +1,2021 @@
+/*
+ * Shared data cache functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libphdi_data_block.h"
+#include "libphdi_data_cache.h"
+#include "libphdi_definitions.h"
+#include "libphdi_libcdata.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_libcthreads.h"
+#include "libphdi_types.h"
+
+/* The maximum number of hash buckets of a shard
+ */
+#define LIBPHDI_DATA_CACHE_MAXIMUM_NUMBER_OF_BUCKETS	1048576
+
+/* Frees a data cache file
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_data_cache_file_free(
+     libphdi_data_cache_file_t **data_cache_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_data_cache_file_free";
+
+	if( data_cache_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_cache_file != NULL )
+	{
+		if( ( *data_cache_file )->location_data != NULL )
+		{
+			memory_free(
+			 ( *data_cache_file )->location_data );
+		}
+		memory_free(
+		 *data_cache_file );
+
+		*data_cache_file = NULL;
+	}
+	return( 1 );
+}
+
+/* Frees a data cache entry
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_data_cache_entry_free(
+     libphdi_data_cache_entry_t **data_cache_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_data_cache_entry_free";
+	int result            = 1;
+
+	if( data_cache_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_cache_entry != NULL )
+	{
+		if( ( *data_cache_entry )->data_block != NULL )
+		{
+			if( libphdi_data_block_free(
+			     &( ( *data_cache_entry )->data_block ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data block.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *data_cache_entry );
+
+		*data_cache_entry = NULL;
+	}
+	return( result );
+}
+
+/* Creates a data cache
+ * The maximum cache size is divided equally between the shards of the cache
+ * and must be at least the data block size for every shard
+ * Make sure the value data_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_data_cache_initialize(
+     libphdi_data_cache_t **data_cache,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	libphdi_data_cache_shard_t *data_cache_shard       = NULL;
+	libphdi_internal_data_cache_t *internal_data_cache = NULL;
+	static char *function                              = "libphdi_data_cache_initialize";
+	size64_t number_of_buckets                         = 0;
+	int shard_index                                    = 0;
+
+	if( data_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid data cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_cache_size < (size64_t) ( LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS * LIBPHDI_DATA_BLOCK_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid maximum cache size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_cache = memory_allocate_structure(
+	                       libphdi_internal_data_cache_t );
+
+	if( internal_data_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_data_cache,
+	     0,
+	     sizeof( libphdi_internal_data_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data cache.",
+		 function );
+
+		memory_free(
+		 internal_data_cache );
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( internal_data_cache->files_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create files array.",
+		 function );
+
+		goto on_error;
+	}
+	for( shard_index = 0;
+	     shard_index < LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		data_cache_shard = &( internal_data_cache->shards[ shard_index ] );
+
+		data_cache_shard->maximum_cache_size = maximum_cache_size / LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS;
+
+		number_of_buckets = data_cache_shard->maximum_cache_size / LIBPHDI_DATA_BLOCK_SIZE;
+
+		if( number_of_buckets > (size64_t) LIBPHDI_DATA_CACHE_MAXIMUM_NUMBER_OF_BUCKETS )
+		{
+			number_of_buckets = (size64_t) LIBPHDI_DATA_CACHE_MAXIMUM_NUMBER_OF_BUCKETS;
+		}
+		data_cache_shard->buckets = (libphdi_data_cache_entry_t **) memory_allocate(
+		                                                             sizeof( libphdi_data_cache_entry_t * ) * (size_t) number_of_buckets );
+
+		if( data_cache_shard->buckets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buckets of shard: %d.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     data_cache_shard->buckets,
+		     0,
+		     sizeof( libphdi_data_cache_entry_t * ) * (size_t) number_of_buckets ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear buckets of shard: %d.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		data_cache_shard->number_of_buckets = (int) number_of_buckets;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_initialize(
+		     &( data_cache_shard->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize read/write lock of shard: %d.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#endif
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( internal_data_cache->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	internal_data_cache->maximum_cache_size   = maximum_cache_size;
+	internal_data_cache->next_file_identifier = 1;
+
+	*data_cache = (libphdi_data_cache_t *) internal_data_cache;
+
+	return( 1 );
+
+on_error:
+	if( internal_data_cache != NULL )
+	{
+		for( shard_index = 0;
+		     shard_index < LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS;
+		     shard_index++ )
+		{
+			data_cache_shard = &( internal_data_cache->shards[ shard_index ] );
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+			if( data_cache_shard->read_write_lock != NULL )
+			{
+				libcthreads_read_write_lock_free(
+				 &( data_cache_shard->read_write_lock ),
+				 NULL );
+			}
+#endif
+			if( data_cache_shard->buckets != NULL )
+			{
+				memory_free(
+				 data_cache_shard->buckets );
+			}
+		}
+		if( internal_data_cache->files_array != NULL )
+		{
+			libcdata_array_free(
+			 &( internal_data_cache->files_array ),
+			 NULL,
+			 NULL );
+		}
+		memory_free(
+		 internal_data_cache );
+	}
+	return( -1 );
+}
+
+/* Frees a data cache
+ * The data cache must be freed after the handles that use it
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_data_cache_free(
+     libphdi_data_cache_t **data_cache,
+     libcerror_error_t **error )
+{
+	libphdi_data_cache_entry_t *data_cache_entry       = NULL;
+	libphdi_data_cache_entry_t *next_data_cache_entry  = NULL;
+	libphdi_data_cache_shard_t *data_cache_shard       = NULL;
+	libphdi_internal_data_cache_t *internal_data_cache = NULL;
+	static char *function                              = "libphdi_data_cache_free";
+	int result                                         = 1;
+	int shard_index                                    = 0;
+
+	if( data_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_cache != NULL )
+	{
+		internal_data_cache = (libphdi_internal_data_cache_t *) *data_cache;
+
+		if( internal_data_cache->number_of_clients != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid data cache - %d handles still use the data cache.",
+			 function,
+			 internal_data_cache->number_of_clients );
+
+			return( -1 );
+		}
+		*data_cache = NULL;
+
+		for( shard_index = 0;
+		     shard_index < LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS;
+		     shard_index++ )
+		{
+			data_cache_shard = &( internal_data_cache->shards[ shard_index ] );
+			data_cache_entry = data_cache_shard->first_entry;
+
+			while( data_cache_entry != NULL )
+			{
+				next_data_cache_entry = data_cache_entry->next_entry;
+
+				if( libphdi_data_cache_entry_free(
+				     &data_cache_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free entry of shard: %d.",
+					 function,
+					 shard_index );
+
+					result = -1;
+				}
+				data_cache_entry = next_data_cache_entry;
+			}
+			memory_free(
+			 data_cache_shard->buckets );
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+			if( libcthreads_read_write_lock_free(
+			     &( data_cache_shard->read_write_lock ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free read/write lock of shard: %d.",
+				 function,
+				 shard_index );
+
+				result = -1;
+			}
+#endif
+		}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( internal_data_cache->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( libcdata_array_free(
+		     &( internal_data_cache->files_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_data_cache_file_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free files array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 internal_data_cache );
+	}
+	return( result );
+}
+
+/* Retrieves the maximum size of the cached data
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_data_cache_get_maximum_cache_size(
+     libphdi_data_cache_t *data_cache,
+     size64_t *maximum_cache_size,
+     libcerror_error_t **error )
+{
+	libphdi_internal_data_cache_t *internal_data_cache = NULL;
+	static char *function                              = "libphdi_data_cache_get_maximum_cache_size";
+
+	if( data_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_cache = (libphdi_internal_data_cache_t *) data_cache;
+
+	if( maximum_cache_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum cache size.",
+		 function );
+
+		return( -1 );
+	}
+	/* The maximum cache size does not change after initialization
+	 */
+	*maximum_cache_size = internal_data_cache->maximum_cache_size;
+
+	return( 1 );
+}
+
+/* Retrieves the size of the cached data
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_data_cache_get_cache_size(
+     libphdi_data_cache_t *data_cache,
+     size64_t *cache_size,
+     libcerror_error_t **error )
+{
+	libphdi_data_cache_shard_t *data_cache_shard       = NULL;
+	libphdi_internal_data_cache_t *internal_data_cache = NULL;
+	static char *function                              = "libphdi_data_cache_get_cache_size";
+	size64_t safe_cache_size                           = 0;
+	int shard_index                                    = 0;
+
+	if( data_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_cache = (libphdi_internal_data_cache_t *) data_cache;
+
+	if( cache_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache size.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		data_cache_shard = &( internal_data_cache->shards[ shard_index ] );
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_read(
+		     data_cache_shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock of shard: %d for reading.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		safe_cache_size += data_cache_shard->cache_size;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_read(
+		     data_cache_shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock of shard: %d for reading.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+	}
+	*cache_size = safe_cache_size;
+
+	return( 1 );
+}
+
+/* Retrieves the number of hits and misses of the data cache
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_data_cache_get_statistics(
+     libphdi_data_cache_t *data_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	libphdi_data_cache_shard_t *data_cache_shard       = NULL;
+	libphdi_internal_data_cache_t *internal_data_cache = NULL;
+	static char *function                              = "libphdi_data_cache_get_statistics";
+	uint64_t safe_number_of_hits                       = 0;
+	uint64_t safe_number_of_misses                     = 0;
+	int shard_index                                    = 0;
+
+	if( data_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_cache = (libphdi_internal_data_cache_t *) data_cache;
+
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		data_cache_shard = &( internal_data_cache->shards[ shard_index ] );
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_read(
+		     data_cache_shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock of shard: %d for reading.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		safe_number_of_hits   += data_cache_shard->number_of_hits;
+		safe_number_of_misses += data_cache_shard->number_of_misses;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_read(
+		     data_cache_shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock of shard: %d for reading.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+	}
+	*number_of_hits   = safe_number_of_hits;
+	*number_of_misses = safe_number_of_misses;
+
+	return( 1 );
+}
+
+/* Calculates the hash of a file identifier and offset
+ * The hash selects both the shard and the hash bucket within the shard
+ * Returns the hash
+ */
+uint64_t libphdi_data_cache_get_hash(
+          uint64_t file_identifier,
+          off64_t file_offset )
+{
+	uint64_t hash = ( file_identifier << 40 ) ^ (uint64_t) file_offset;
+
+	/* Mix the bits so that neighbouring offsets are spread over the shards
+	 */
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ULL;
+	hash ^= hash >> 33;
+
+	return( hash );
+}
+
+/* Retrieves the entry of a specific file identifier and offset from a shard
+ * This function is not multi-thread safe acquire the shard read/write lock before call
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libphdi_data_cache_shard_get_entry(
+     libphdi_data_cache_shard_t *data_cache_shard,
+     uint64_t hash,
+     uint64_t file_identifier,
+     off64_t file_offset,
+     libphdi_data_cache_entry_t **data_cache_entry,
+     libcerror_error_t **error )
+{
+	libphdi_data_cache_entry_t *safe_data_cache_entry = NULL;
+	static char *function                             = "libphdi_data_cache_shard_get_entry";
+	int bucket_index                                  = 0;
+
+	if( data_cache_shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache shard.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_cache_shard->number_of_buckets <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data cache shard - number of buckets value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_cache_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache entry.",
+		 function );
+
+		return( -1 );
+	}
+	bucket_index = (int) ( ( hash / LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS ) % data_cache_shard->number_of_buckets );
+
+	safe_data_cache_entry = data_cache_shard->buckets[ bucket_index ];
+
+	while( safe_data_cache_entry != NULL )
+	{
+		if( ( safe_data_cache_entry->file_identifier == file_identifier )
+		 && ( safe_data_cache_entry->file_offset == file_offset ) )
+		{
+			*data_cache_entry = safe_data_cache_entry;
+
+			return( 1 );
+		}
+		safe_data_cache_entry = safe_data_cache_entry->next_bucket_entry;
+	}
+	return( 0 );
+}
+
+/* Evicts the least recently used entry from a shard
+ * This function is not multi-thread safe acquire the shard read/write lock before call
+ * Returns 1 if successful, 0 if the shard is empty or -1 on error
+ */
+int libphdi_data_cache_shard_evict_entry(
+     libphdi_data_cache_shard_t *data_cache_shard,
+     int shard_index,
+     libcerror_error_t **error )
+{
+	libphdi_data_cache_entry_t *bucket_entry     = NULL;
+	libphdi_data_cache_entry_t *data_cache_entry = NULL;
+	static char *function                        = "libphdi_data_cache_shard_evict_entry";
+	uint64_t hash                                = 0;
+	int bucket_index                             = 0;
+
+	if( data_cache_shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache shard.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_cache_shard->number_of_buckets <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data cache shard - number of buckets value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( shard_index < 0 )
+	 || ( shard_index >= LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid shard index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	data_cache_entry = data_cache_shard->last_entry;
+
+	if( data_cache_entry == NULL )
+	{
+		return( 0 );
+	}
+	data_cache_shard->last_entry = data_cache_entry->previous_entry;
+
+	if( data_cache_shard->last_entry != NULL )
+	{
+		data_cache_shard->last_entry->next_entry = NULL;
+	}
+	else
+	{
+		data_cache_shard->first_entry = NULL;
+	}
+	hash = libphdi_data_cache_get_hash(
+	        data_cache_entry->file_identifier,
+	        data_cache_entry->file_offset );
+
+	bucket_index = (int) ( ( hash / LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS ) % data_cache_shard->number_of_buckets );
+
+	if( data_cache_shard->buckets[ bucket_index ] == data_cache_entry )
+	{
+		data_cache_shard->buckets[ bucket_index ] = data_cache_entry->next_bucket_entry;
+	}
+	else
+	{
+		bucket_entry = data_cache_shard->buckets[ bucket_index ];
+
+		while( ( bucket_entry != NULL )
+		    && ( bucket_entry->next_bucket_entry != data_cache_entry ) )
+		{
+			bucket_entry = bucket_entry->next_bucket_entry;
+		}
+		if( bucket_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing entry in bucket: %d.",
+			 function,
+			 bucket_index );
+
+			return( -1 );
+		}
+		bucket_entry->next_bucket_entry = data_cache_entry->next_bucket_entry;
+	}
+	data_cache_shard->cache_size -= data_cache_entry->data_block->data_size;
+
+	if( data_cache_entry->client != NULL )
+	{
+		data_cache_entry->client->cache_sizes[ shard_index ] -= data_cache_entry->data_block->data_size;
+	}
+	if( libphdi_data_cache_entry_free(
+	     &data_cache_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free entry.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Creates a data cache client
+ * Every handle that uses the data cache is a client, the cached data is accounted per client
+ * Make sure the value data_cache_client is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_data_cache_client_initialize(
+     libphdi_data_cache_client_t **data_cache_client,
+     libphdi_data_cache_t *data_cache,
+     int number_of_files,
+     libcerror_error_t **error )
+{
+	libphdi_internal_data_cache_t *internal_data_cache = NULL;
+	static char *function                              = "libphdi_data_cache_client_initialize";
+
+	if( data_cache_client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache client.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_cache_client != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid data cache client value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_cache = (libphdi_internal_data_cache_t *) data_cache;
+
+	if( ( number_of_files <= 0 )
+	 || ( (size_t) number_of_files > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint64_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of files value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*data_cache_client = memory_allocate_structure(
+	                      libphdi_data_cache_client_t );
+
+	if( *data_cache_client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data cache client.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *data_cache_client,
+	     0,
+	     sizeof( libphdi_data_cache_client_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data cache client.",
+		 function );
+
+		memory_free(
+		 *data_cache_client );
+
+		*data_cache_client = NULL;
+
+		return( -1 );
+	}
+	( *data_cache_client )->file_identifiers = (uint64_t *) memory_allocate(
+	                                                         sizeof( uint64_t ) * number_of_files );
+
+	if( ( *data_cache_client )->file_identifiers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file identifiers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *data_cache_client )->file_identifiers,
+	     0,
+	     sizeof( uint64_t ) * number_of_files ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file identifiers.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_data_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	internal_data_cache->number_of_clients += 1;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_data_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		internal_data_cache->number_of_clients -= 1;
+
+		goto on_error;
+	}
+#endif
+	( *data_cache_client )->data_cache      = internal_data_cache;
+	( *data_cache_client )->number_of_files = number_of_files;
+
+	return( 1 );
+
+on_error:
+	if( *data_cache_client != NULL )
+	{
+		if( ( *data_cache_client )->file_identifiers != NULL )
+		{
+			memory_free(
+			 ( *data_cache_client )->file_identifiers );
+		}
+		memory_free(
+		 *data_cache_client );
+
+		*data_cache_client = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a data cache client
+ * The cached data that was added by the client remains in the data cache
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_data_cache_client_free(
+     libphdi_data_cache_client_t **data_cache_client,
+     libcerror_error_t **error )
+{
+	libphdi_data_cache_entry_t *data_cache_entry       = NULL;
+	libphdi_data_cache_file_t *data_cache_file         = NULL;
+	libphdi_data_cache_shard_t *data_cache_shard       = NULL;
+	libphdi_internal_data_cache_t *internal_data_cache = NULL;
+	static char *function                              = "libphdi_data_cache_client_free";
+	int file_entry_index                               = 0;
+	int file_index                                     = 0;
+	int number_of_file_entries                         = 0;
+	int result                                         = 1;
+	int shard_index                                    = 0;
+
+	if( data_cache_client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache client.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_cache_client == NULL )
+	{
+		return( 1 );
+	}
+	internal_data_cache = ( *data_cache_client )->data_cache;
+
+	/* Detach the entries that were added by the client
+	 */
+	for( shard_index = 0;
+	     shard_index < LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		data_cache_shard = &( internal_data_cache->shards[ shard_index ] );
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_write(
+		     data_cache_shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock of shard: %d for writing.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		data_cache_entry = data_cache_shard->first_entry;
+
+		while( data_cache_entry != NULL )
+		{
+			if( data_cache_entry->client == *data_cache_client )
+			{
+				data_cache_entry->client = NULL;
+			}
+			data_cache_entry = data_cache_entry->next_entry;
+		}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     data_cache_shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock of shard: %d for writing.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_data_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* Release the files that are referenced by the client, since file identifiers
+	 * are not reused the data of a released file is no longer found and ages out
+	 */
+	if( libcdata_array_get_number_of_entries(
+	     internal_data_cache->files_array,
+	     &number_of_file_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of files.",
+		 function );
+
+		result = -1;
+	}
+	for( file_index = 0;
+	     ( result == 1 ) && ( file_index < ( *data_cache_client )->number_of_files );
+	     file_index++ )
+	{
+		if( ( *data_cache_client )->file_identifiers[ file_index ] == 0 )
+		{
+			continue;
+		}
+		for( file_entry_index = 0;
+		     file_entry_index < number_of_file_entries;
+		     file_entry_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_data_cache->files_array,
+			     file_entry_index,
+			     (intptr_t **) &data_cache_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve file: %d.",
+				 function,
+				 file_entry_index );
+
+				result = -1;
+
+				break;
+			}
+			if( ( data_cache_file != NULL )
+			 && ( data_cache_file->identifier == ( *data_cache_client )->file_identifiers[ file_index ] ) )
+			{
+				data_cache_file->number_of_references -= 1;
+
+				if( data_cache_file->number_of_references <= 0 )
+				{
+					if( libcdata_array_remove_entry(
+					     internal_data_cache->files_array,
+					     file_entry_index,
+					     (intptr_t **) &data_cache_file,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+						 "%s: unable to remove file: %d.",
+						 function,
+						 file_entry_index );
+
+						result = -1;
+					}
+					else
+					{
+						number_of_file_entries -= 1;
+
+						libphdi_data_cache_file_free(
+						 &data_cache_file,
+						 NULL );
+					}
+				}
+				break;
+			}
+		}
+	}
+	internal_data_cache->number_of_clients -= 1;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_data_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	memory_free(
+	 ( *data_cache_client )->file_identifiers );
+
+	memory_free(
+	 *data_cache_client );
+
+	*data_cache_client = NULL;
+
+	return( result );
+}
+
+/* Sets the location and size of a specific file of the client
+ * Files with the same location and size share the cached data of all clients
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_data_cache_client_set_file(
+     libphdi_data_cache_client_t *data_cache_client,
+     int file_index,
+     const uint8_t *location_data,
+     size_t location_data_size,
+     size64_t file_size,
+     libcerror_error_t **error )
+{
+	libphdi_data_cache_file_t *data_cache_file         = NULL;
+	libphdi_data_cache_file_t *new_data_cache_file     = NULL;
+	libphdi_internal_data_cache_t *internal_data_cache = NULL;
+	static char *function                              = "libphdi_data_cache_client_set_file";
+	int file_entry_index                               = 0;
+	int number_of_file_entries                         = 0;
+
+	if( data_cache_client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache client.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_cache = data_cache_client->data_cache;
+
+	if( ( file_index < 0 )
+	 || ( file_index >= data_cache_client->number_of_files ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_cache_client->file_identifiers[ file_index ] != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid data cache client - file: %d value already set.",
+		 function,
+		 file_index );
+
+		return( -1 );
+	}
+	if( location_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid location data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( location_data_size == 0 )
+	 || ( location_data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid location data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_data_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_number_of_entries(
+	     internal_data_cache->files_array,
+	     &number_of_file_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of files.",
+		 function );
+
+		goto on_error;
+	}
+	for( file_entry_index = 0;
+	     file_entry_index < number_of_file_entries;
+	     file_entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_data_cache->files_array,
+		     file_entry_index,
+		     (intptr_t **) &data_cache_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file: %d.",
+			 function,
+			 file_entry_index );
+
+			goto on_error;
+		}
+		if( ( data_cache_file != NULL )
+		 && ( data_cache_file->file_size == file_size )
+		 && ( data_cache_file->location_data_size == location_data_size )
+		 && ( memory_compare(
+		       data_cache_file->location_data,
+		       location_data,
+		       location_data_size ) == 0 ) )
+		{
+			break;
+		}
+		data_cache_file = NULL;
+	}
+	if( data_cache_file == NULL )
+	{
+		new_data_cache_file = memory_allocate_structure(
+		                       libphdi_data_cache_file_t );
+
+		if( new_data_cache_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create file.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     new_data_cache_file,
+		     0,
+		     sizeof( libphdi_data_cache_file_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear file.",
+			 function );
+
+			memory_free(
+			 new_data_cache_file );
+
+			new_data_cache_file = NULL;
+
+			goto on_error;
+		}
+		new_data_cache_file->location_data = (uint8_t *) memory_allocate(
+		                                                  sizeof( uint8_t ) * location_data_size );
+
+		if( new_data_cache_file->location_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create location data.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     new_data_cache_file->location_data,
+		     location_data,
+		     location_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy location data.",
+			 function );
+
+			goto on_error;
+		}
+		new_data_cache_file->location_data_size = location_data_size;
+		new_data_cache_file->file_size          = file_size;
+		new_data_cache_file->identifier         = internal_data_cache->next_file_identifier;
+
+		if( libcdata_array_append_entry(
+		     internal_data_cache->files_array,
+		     &file_entry_index,
+		     (intptr_t *) new_data_cache_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append file to array.",
+			 function );
+
+			goto on_error;
+		}
+		internal_data_cache->next_file_identifier += 1;
+
+		data_cache_file     = new_data_cache_file;
+		new_data_cache_file = NULL;
+	}
+	data_cache_file->number_of_references += 1;
+
+	data_cache_client->file_identifiers[ file_index ] = data_cache_file->identifier;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_data_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( new_data_cache_file != NULL )
+	{
+		libphdi_data_cache_file_free(
+		 &new_data_cache_file,
+		 NULL );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_data_cache->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the size of the cached data that was added by the client
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_data_cache_client_get_cache_size(
+     libphdi_data_cache_client_t *data_cache_client,
+     size64_t *cache_size,
+     libcerror_error_t **error )
+{
+	libphdi_data_cache_shard_t *data_cache_shard = NULL;
+	static char *function                        = "libphdi_data_cache_client_get_cache_size";
+	size64_t safe_cache_size                     = 0;
+	int shard_index                              = 0;
+
+	if( data_cache_client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache client.",
+		 function );
+
+		return( -1 );
+	}
+	if( cache_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache size.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		data_cache_shard = &( data_cache_client->data_cache->shards[ shard_index ] );
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_read(
+		     data_cache_shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock of shard: %d for reading.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		safe_cache_size += data_cache_client->cache_sizes[ shard_index ];
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_read(
+		     data_cache_shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock of shard: %d for reading.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+	}
+	*cache_size = safe_cache_size;
+
+	return( 1 );
+}
+
+/* Retrieves a copy of the cached data of a specific file and offset
+ * Returns the number of bytes copied, 0 if not cached or -1 on error
+ */
+ssize_t libphdi_data_cache_client_copy_data(
+         libphdi_data_cache_client_t *data_cache_client,
+         int file_index,
+         off64_t file_offset,
+         size_t data_offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libphdi_data_cache_entry_t *data_cache_entry = NULL;
+	libphdi_data_cache_shard_t *data_cache_shard = NULL;
+	static char *function                        = "libphdi_data_cache_client_copy_data";
+	ssize_t read_count                           = 0;
+	uint64_t file_identifier                     = 0;
+	uint64_t hash                                = 0;
+	int result                                   = 0;
+
+	if( data_cache_client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache client.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_index < 0 )
+	 || ( file_index >= data_cache_client->number_of_files ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	file_identifier = data_cache_client->file_identifiers[ file_index ];
+
+	if( file_identifier == 0 )
+	{
+		return( 0 );
+	}
+	hash = libphdi_data_cache_get_hash(
+	        file_identifier,
+	        file_offset );
+
+	data_cache_shard = &( data_cache_client->data_cache->shards[ hash % LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS ] );
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     data_cache_shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock of shard for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libphdi_data_cache_shard_get_entry(
+	          data_cache_shard,
+	          hash,
+	          file_identifier,
+	          file_offset,
+	          &data_cache_entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry from shard.",
+		 function );
+
+		read_count = -1;
+	}
+	else if( result == 0 )
+	{
+		data_cache_shard->number_of_misses += 1;
+	}
+	else
+	{
+		/* Move the entry to the front of the least recently used list
+		 */
+		if( data_cache_entry != data_cache_shard->first_entry )
+		{
+			data_cache_entry->previous_entry->next_entry = data_cache_entry->next_entry;
+
+			if( data_cache_entry->next_entry != NULL )
+			{
+				data_cache_entry->next_entry->previous_entry = data_cache_entry->previous_entry;
+			}
+			else
+			{
+				data_cache_shard->last_entry = data_cache_entry->previous_entry;
+			}
+			data_cache_entry->previous_entry = NULL;
+			data_cache_entry->next_entry     = data_cache_shard->first_entry;
+
+			data_cache_shard->first_entry->previous_entry = data_cache_entry;
+			data_cache_shard->first_entry                 = data_cache_entry;
+		}
+		data_cache_shard->number_of_hits += 1;
+
+		read_count = libphdi_data_block_copy_data(
+		              data_cache_entry->data_block,
+		              data_offset,
+		              buffer,
+		              buffer_size,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy data block data.",
+			 function );
+		}
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     data_cache_shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock of shard for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Inserts the data block of a specific file and offset into the data cache
+ * The data cache takes over management of the data block and evicts the least recently
+ * used data of the shard when needed. If the data is already cached, for example since
+ * another client read it concurrently, the data block is freed
+ * Returns 1 if successful, 0 if the data block was not inserted or -1 on error
+ */
+int libphdi_data_cache_client_insert_data_block(
+     libphdi_data_cache_client_t *data_cache_client,
+     int file_index,
+     off64_t file_offset,
+     libphdi_data_block_t **data_block,
+     libcerror_error_t **error )
+{
+	libphdi_data_cache_entry_t *data_cache_entry     = NULL;
+	libphdi_data_cache_entry_t *new_data_cache_entry = NULL;
+	libphdi_data_cache_shard_t *data_cache_shard     = NULL;
+	static char *function                            = "libphdi_data_cache_client_insert_data_block";
+	uint64_t file_identifier                         = 0;
+	uint64_t hash                                    = 0;
+	int bucket_index                                 = 0;
+	int result                                       = 0;
+	int shard_index                                  = 0;
+
+	if( data_cache_client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache client.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_index < 0 )
+	 || ( file_index >= data_cache_client->number_of_files ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_block == NULL )
+	 || ( *data_block == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data block.",
+		 function );
+
+		return( -1 );
+	}
+	new_data_cache_entry = memory_allocate_structure(
+	                        libphdi_data_cache_entry_t );
+
+	if( new_data_cache_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     new_data_cache_entry,
+	     0,
+	     sizeof( libphdi_data_cache_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entry.",
+		 function );
+
+		memory_free(
+		 new_data_cache_entry );
+
+		return( -1 );
+	}
+	/* The entry takes over management of the data block
+	 */
+	new_data_cache_entry->data_block = *data_block;
+	*data_block                      = NULL;
+
+	file_identifier = data_cache_client->file_identifiers[ file_index ];
+
+	hash = libphdi_data_cache_get_hash(
+	        file_identifier,
+	        file_offset );
+
+	shard_index      = (int) ( hash % LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS );
+	data_cache_shard = &( data_cache_client->data_cache->shards[ shard_index ] );
+
+	if( ( file_identifier == 0 )
+	 || ( (size64_t) new_data_cache_entry->data_block->data_size > data_cache_shard->maximum_cache_size ) )
+	{
+		libphdi_data_cache_entry_free(
+		 &new_data_cache_entry,
+		 NULL );
+
+		return( 0 );
+	}
+	new_data_cache_entry->file_identifier = file_identifier;
+	new_data_cache_entry->file_offset     = file_offset;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     data_cache_shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock of shard: %d for writing.",
+		 function,
+		 shard_index );
+
+		goto on_error;
+	}
+#endif
+	result = libphdi_data_cache_shard_get_entry(
+	          data_cache_shard,
+	          hash,
+	          file_identifier,
+	          file_offset,
+	          &data_cache_entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry from shard: %d.",
+		 function,
+		 shard_index );
+	}
+	else if( result == 0 )
+	{
+		while( ( data_cache_shard->cache_size + new_data_cache_entry->data_block->data_size ) > data_cache_shard->maximum_cache_size )
+		{
+			result = libphdi_data_cache_shard_evict_entry(
+			          data_cache_shard,
+			          shard_index,
+			          error );
+
+			if( result != 1 )
+			{
+				break;
+			}
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to evict entry from shard: %d.",
+			 function,
+			 shard_index );
+		}
+		else
+		{
+			bucket_index = (int) ( ( hash / LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS ) % data_cache_shard->number_of_buckets );
+
+			new_data_cache_entry->next_bucket_entry   = data_cache_shard->buckets[ bucket_index ];
+			data_cache_shard->buckets[ bucket_index ] = new_data_cache_entry;
+
+			new_data_cache_entry->next_entry = data_cache_shard->first_entry;
+
+			if( data_cache_shard->first_entry != NULL )
+			{
+				data_cache_shard->first_entry->previous_entry = new_data_cache_entry;
+			}
+			else
+			{
+				data_cache_shard->last_entry = new_data_cache_entry;
+			}
+			data_cache_shard->first_entry = new_data_cache_entry;
+
+			new_data_cache_entry->client = data_cache_client;
+
+			data_cache_shard->cache_size                  += new_data_cache_entry->data_block->data_size;
+			data_cache_client->cache_sizes[ shard_index ] += new_data_cache_entry->data_block->data_size;
+
+			new_data_cache_entry = NULL;
+
+			result = 1;
+		}
+	}
+	else
+	{
+		result = 0;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     data_cache_shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock of shard: %d for writing.",
+		 function,
+		 shard_index );
+
+		goto on_error;
+	}
+#endif
+	if( new_data_cache_entry != NULL )
+	{
+		libphdi_data_cache_entry_free(
+		 &new_data_cache_entry,
+		 NULL );
+	}
+	return( result );
+
+on_error:
+	if( new_data_cache_entry != NULL )
+	{
+		libphdi_data_cache_entry_free(
+		 &new_data_cache_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
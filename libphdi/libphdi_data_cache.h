@@ -0,0 +1,294 @@
+/*
+ * Shared data cache functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPHDI_DATA_CACHE_H )
+#define _LIBPHDI_DATA_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libphdi_data_block.h"
+#include "libphdi_definitions.h"
+#include "libphdi_extern.h"
+#include "libphdi_libcdata.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_libcthreads.h"
+#include "libphdi_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libphdi_internal_data_cache libphdi_internal_data_cache_t;
+
+typedef struct libphdi_data_cache_client libphdi_data_cache_client_t;
+
+typedef struct libphdi_data_cache_file libphdi_data_cache_file_t;
+
+struct libphdi_data_cache_file
+{
+	/* The file identifier, identifiers are not reused
+	 */
+	uint64_t identifier;
+
+	/* The location data
+	 */
+	uint8_t *location_data;
+
+	/* The location data size
+	 */
+	size_t location_data_size;
+
+	/* The file size
+	 */
+	size64_t file_size;
+
+	/* The number of clients that reference the file
+	 */
+	int number_of_references;
+};
+
+typedef struct libphdi_data_cache_entry libphdi_data_cache_entry_t;
+
+struct libphdi_data_cache_entry
+{
+	/* The identifier of the file that contains the data
+	 */
+	uint64_t file_identifier;
+
+	/* The offset of the data in the file
+	 */
+	off64_t file_offset;
+
+	/* The data block
+	 */
+	libphdi_data_block_t *data_block;
+
+	/* The client that added the entry or NULL if the client was freed
+	 */
+	libphdi_data_cache_client_t *client;
+
+	/* The next entry in the hash bucket
+	 */
+	libphdi_data_cache_entry_t *next_bucket_entry;
+
+	/* The previous (more recently used) entry
+	 */
+	libphdi_data_cache_entry_t *previous_entry;
+
+	/* The next (less recently used) entry
+	 */
+	libphdi_data_cache_entry_t *next_entry;
+};
+
+typedef struct libphdi_data_cache_shard libphdi_data_cache_shard_t;
+
+/* A shard of the shared data cache is a least recently used cache with a hash table
+ */
+struct libphdi_data_cache_shard
+{
+	/* The hash buckets
+	 */
+	libphdi_data_cache_entry_t **buckets;
+
+	/* The number of hash buckets
+	 */
+	int number_of_buckets;
+
+	/* The first (most recently used) entry
+	 */
+	libphdi_data_cache_entry_t *first_entry;
+
+	/* The last (least recently used) entry
+	 */
+	libphdi_data_cache_entry_t *last_entry;
+
+	/* The size of the cached data
+	 */
+	size64_t cache_size;
+
+	/* The maximum size of the cached data
+	 */
+	size64_t maximum_cache_size;
+
+	/* The number of cache hits
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of cache misses
+	 */
+	uint64_t number_of_misses;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+struct libphdi_data_cache_client
+{
+	/* The data cache
+	 */
+	libphdi_internal_data_cache_t *data_cache;
+
+	/* The file identifiers by file index, where 0 represents a file that is not cached
+	 */
+	uint64_t *file_identifiers;
+
+	/* The number of files
+	 */
+	int number_of_files;
+
+	/* The size of the cached data that was added by the client per shard
+	 */
+	size64_t cache_sizes[ LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS ];
+};
+
+struct libphdi_internal_data_cache
+{
+	/* The maximum size of the cached data
+	 */
+	size64_t maximum_cache_size;
+
+	/* The shards
+	 */
+	libphdi_data_cache_shard_t shards[ LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS ];
+
+	/* The files array
+	 */
+	libcdata_array_t *files_array;
+
+	/* The next file identifier
+	 */
+	uint64_t next_file_identifier;
+
+	/* The number of clients
+	 */
+	int number_of_clients;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libphdi_data_cache_file_free(
+     libphdi_data_cache_file_t **data_cache_file,
+     libcerror_error_t **error );
+
+int libphdi_data_cache_entry_free(
+     libphdi_data_cache_entry_t **data_cache_entry,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_data_cache_initialize(
+     libphdi_data_cache_t **data_cache,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_data_cache_free(
+     libphdi_data_cache_t **data_cache,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_data_cache_get_maximum_cache_size(
+     libphdi_data_cache_t *data_cache,
+     size64_t *maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_data_cache_get_cache_size(
+     libphdi_data_cache_t *data_cache,
+     size64_t *cache_size,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_data_cache_get_statistics(
+     libphdi_data_cache_t *data_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+uint64_t libphdi_data_cache_get_hash(
+          uint64_t file_identifier,
+          off64_t file_offset );
+
+int libphdi_data_cache_shard_get_entry(
+     libphdi_data_cache_shard_t *data_cache_shard,
+     uint64_t hash,
+     uint64_t file_identifier,
+     off64_t file_offset,
+     libphdi_data_cache_entry_t **data_cache_entry,
+     libcerror_error_t **error );
+
+int libphdi_data_cache_shard_evict_entry(
+     libphdi_data_cache_shard_t *data_cache_shard,
+     int shard_index,
+     libcerror_error_t **error );
+
+int libphdi_data_cache_client_initialize(
+     libphdi_data_cache_client_t **data_cache_client,
+     libphdi_data_cache_t *data_cache,
+     int number_of_files,
+     libcerror_error_t **error );
+
+int libphdi_data_cache_client_free(
+     libphdi_data_cache_client_t **data_cache_client,
+     libcerror_error_t **error );
+
+int libphdi_data_cache_client_set_file(
+     libphdi_data_cache_client_t *data_cache_client,
+     int file_index,
+     const uint8_t *location_data,
+     size_t location_data_size,
+     size64_t file_size,
+     libcerror_error_t **error );
+
+int libphdi_data_cache_client_get_cache_size(
+     libphdi_data_cache_client_t *data_cache_client,
+     size64_t *cache_size,
+     libcerror_error_t **error );
+
+ssize_t libphdi_data_cache_client_copy_data(
+         libphdi_data_cache_client_t *data_cache_client,
+         int file_index,
+         off64_t file_offset,
+         size_t data_offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+int libphdi_data_cache_client_insert_data_block(
+     libphdi_data_cache_client_t *data_cache_client,
+     int file_index,
+     off64_t file_offset,
+     libphdi_data_block_t **data_block,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPHDI_DATA_CACHE_H ) */
+
@@ -33,13 +33,19 @@
 #include "libphdi_libbfio.h"
 #include "libphdi_libcdata.h"
 #include "libphdi_libcerror.h"
+#include "libphdi_libcnotify.h"
 #include "libphdi_libclocale.h"
 #include "libphdi_libcpath.h"
-#include "libphdi_libfcache.h"
-#include "libphdi_libfdata.h"
+#include "libphdi_libcthreads.h"
 #include "libphdi_libuna.h"
+#include "libphdi_metadata_index.h"
+#include "libphdi_segment_table.h"
+#include "libphdi_statistics.h"
 #include "libphdi_storage_image.h"
+#include "libphdi_storage_image_cache.h"
+#include "libphdi_storage_image_registry.h"
 #include "libphdi_system_string.h"
+#include "libphdi_unused.h"
 
 /* Creates an extent table
  * Make sure the value extent_table is referencing, is set to NULL
@@ -101,6 +107,23 @@ int libphdi_extent_table_initialize(
 
 		goto on_error;
 	}
+	( *extent_table )->maximum_number_of_cached_extent_files = LIBPHDI_MAXIMUM_CACHE_ENTRIES_EXTENT_FILES;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *extent_table )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
@@ -150,6 +173,21 @@ int libphdi_extent_table_free(
 
 			result = -1;
 		}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *extent_table )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *extent_table );
 
@@ -179,33 +217,33 @@ int libphdi_extent_table_clear(
 
 		return( -1 );
 	}
-	if( extent_table->extent_files_stream != NULL )
+	if( extent_table->segment_table != NULL )
 	{
-		if( libfdata_stream_free(
-		     &( extent_table->extent_files_stream ),
+		if( libphdi_segment_table_free(
+		     &( extent_table->segment_table ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free extent files stream.",
+			 "%s: unable to free segment table.",
 			 function );
 
 			result = -1;
 		}
 	}
-	if( extent_table->extent_files_list != NULL )
+	if( extent_table->extent_index != NULL )
 	{
-		if( libfdata_list_free(
-		     &( extent_table->extent_files_list ),
+		if( libphdi_segment_table_free(
+		     &( extent_table->extent_index ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free extent files list.",
+			 "%s: unable to free extent index.",
 			 function );
 
 			result = -1;
@@ -213,7 +251,7 @@ int libphdi_extent_table_clear(
 	}
 	if( extent_table->extent_files_cache != NULL )
 	{
-		if( libfcache_cache_free(
+		if( libphdi_storage_image_cache_free(
 		     &( extent_table->extent_files_cache ),
 		     error ) != 1 )
 		{
@@ -227,20 +265,13 @@ int libphdi_extent_table_clear(
 			result = -1;
 		}
 	}
-	if( memory_set(
-	     extent_table,
-	     0,
-	     sizeof( libphdi_extent_table_t ) ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to extent table.",
-		 function );
+	/* The read/write lock and the maximum number of cached extent files are retained
+	 */
+	extent_table->disk_type         = 0;
+	extent_table->image_type        = 0;
+	extent_table->number_of_extents = 0;
+	extent_table->last_extent_index = 0;
 
-		result = -1;
-	}
 	return( result );
 }
 
@@ -249,13 +280,15 @@ int libphdi_extent_table_clear(
  */
 int libphdi_extent_table_initialize_extents(
      libphdi_extent_table_t *extent_table,
-     libphdi_io_handle_t *io_handle,
+     libphdi_io_handle_t *io_handle LIBPHDI_ATTRIBUTE_UNUSED,
      int disk_type,
      libcerror_error_t **error )
 {
 	static char *function = "libphdi_extent_table_initialize_extents";
 	int result            = 0;
 
+	LIBPHDI_UNREFERENCED_PARAMETER( io_handle )
+
 	if( extent_table == NULL )
 	{
 		libcerror_error_set(
@@ -281,16 +314,8 @@ int libphdi_extent_table_initialize_extents(
 	}
 	if( disk_type == LIBPHDI_DISK_TYPE_FIXED )
 	{
-		result = libfdata_stream_initialize(
-		          &( extent_table->extent_files_stream ),
-		          (intptr_t *) io_handle,
-		          NULL,
-		          NULL,
-		          NULL,
-		          (ssize_t (*)(intptr_t *, intptr_t *, int, int, uint8_t *, size_t, uint32_t, uint8_t, libcerror_error_t **)) &libphdi_storage_image_read_segment_data,
-		          NULL,
-		          (off64_t (*)(intptr_t *, intptr_t *, int, int, off64_t, libcerror_error_t **)) &libphdi_storage_image_seek_segment_offset,
-		          LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+		result = libphdi_segment_table_initialize(
+		          &( extent_table->segment_table ),
 		          error );
 
 		if( result != 1 )
@@ -299,7 +324,7 @@ int libphdi_extent_table_initialize_extents(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create extent files stream.",
+			 "%s: unable to create segment table.",
 			 function );
 
 			goto on_error;
@@ -307,14 +332,8 @@ int libphdi_extent_table_initialize_extents(
 	}
 	else if( disk_type == LIBPHDI_DISK_TYPE_EXPANDING )
 	{
-		result = libfdata_list_initialize(
-		          &( extent_table->extent_files_list ),
-		          (intptr_t *) io_handle,
-		          NULL,
-		          NULL,
-		          (int (*)(intptr_t *, intptr_t *, libfdata_list_element_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libphdi_storage_image_read_element_data,
-		          NULL,
-		          LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+		result = libphdi_segment_table_initialize(
+		          &( extent_table->extent_index ),
 		          error );
 
 		if( result != 1 )
@@ -323,15 +342,15 @@ int libphdi_extent_table_initialize_extents(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create extent files list.",
+			 "%s: unable to create extent index.",
 			 function );
 
 			goto on_error;
 		}
-		result = libfcache_cache_initialize(
-			  &( extent_table->extent_files_cache ),
-			  LIBPHDI_MAXIMUM_CACHE_ENTRIES_EXTENT_FILES,
-			  error );
+		result = libphdi_storage_image_cache_initialize(
+		          &( extent_table->extent_files_cache ),
+		          extent_table->maximum_number_of_cached_extent_files,
+		          error );
 
 		if( result != 1 )
 		{
@@ -350,34 +369,37 @@ int libphdi_extent_table_initialize_extents(
 	return( 1 );
 
 on_error:
-	if( extent_table->extent_files_list != NULL )
+	if( extent_table->extent_index != NULL )
 	{
-		libfdata_list_free(
-		 &( extent_table->extent_files_list ),
+		libphdi_segment_table_free(
+		 &( extent_table->extent_index ),
 		 NULL );
 	}
-	if( extent_table->extent_files_stream != NULL )
+	if( extent_table->segment_table != NULL )
 	{
-		libfdata_stream_free(
-		 &( extent_table->extent_files_stream ),
+		libphdi_segment_table_free(
+		 &( extent_table->segment_table ),
 		 NULL );
 	}
 	return( -1 );
 }
 
-/* Retrieves an extent file at a specific offset from the extent table
+/* Retrieves the index of the extent at a specific offset
+ * Sequential reads typically remain within the most recently looked up extent,
+ * hence it is checked before the extent index is searched. The hint is updated
+ * atomically and the extent index is not modified after the image is opened,
+ * hence the function can be called by concurrent readers
  * Returns 1 if successful or -1 on error
  */
-int libphdi_extent_table_get_extent_file_at_offset(
+int libphdi_extent_table_get_extent_index_at_offset(
      libphdi_extent_table_t *extent_table,
      off64_t offset,
-     libbfio_pool_t *file_io_pool,
      int *extent_index,
-     off64_t *extent_file_data_offset,
-     libphdi_storage_image_t **extent_file,
      libcerror_error_t **error )
 {
-	static char *function = "libphdi_extent_table_get_extent_file_at_offset";
+	libphdi_segment_table_segment_t *segment = NULL;
+	static char *function                    = "libphdi_extent_table_get_extent_index_at_offset";
+	int last_extent_index                    = 0;
 
 	if( extent_table == NULL )
 	{
@@ -390,46 +412,86 @@ int libphdi_extent_table_get_extent_file_at_offset(
 
 		return( -1 );
 	}
-	if( libfdata_list_get_element_value_at_offset(
-	     extent_table->extent_files_list,
-	     (intptr_t *) file_io_pool,
-	     (libfdata_cache_t *) extent_table->extent_files_cache,
+	if( extent_table->extent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extent table - missing extent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent index.",
+		 function );
+
+		return( -1 );
+	}
+	last_extent_index = libphdi_statistics_atomic_get32(
+	                     &( extent_table->last_extent_index ) );
+
+	if( ( last_extent_index >= 0 )
+	 && ( last_extent_index < extent_table->extent_index->number_of_segments ) )
+	{
+		segment = &( extent_table->extent_index->segments[ last_extent_index ] );
+
+		if( ( offset >= segment->media_offset )
+		 && ( (size64_t) ( offset - segment->media_offset ) < segment->size ) )
+		{
+			*extent_index = last_extent_index;
+
+			return( 1 );
+		}
+	}
+	if( libphdi_segment_table_get_segment_index_at_offset(
+	     extent_table->extent_index,
 	     offset,
 	     extent_index,
-	     extent_file_data_offset,
-	     (intptr_t **) extent_file,
-	     0,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element at offset: %" PRIi64 " (0x%08" PRIx64 ") from extent files list.",
+		 "%s: unable to retrieve segment index at offset: %" PRIi64 " (0x%08" PRIx64 ").",
 		 function,
 		 offset,
 		 offset );
 
 		return( -1 );
 	}
+	libphdi_statistics_atomic_set32(
+	 &( extent_table->last_extent_index ),
+	 *extent_index );
+
 	return( 1 );
 }
 
-/* Appends an extent to the extent table based on the image values
+/* Retrieves an extent file at a specific offset from the extent table
+ * The storage image is read when it is not in the extent files cache
+ * This function is not multi-thread safe acquire write lock before call
  * Returns 1 if successful or -1 on error
  */
-int libphdi_extent_table_append_extent(
+int libphdi_extent_table_get_extent_file_at_offset(
      libphdi_extent_table_t *extent_table,
-     int image_type,
-     int file_io_pool_entry,
-     size64_t extent_file_size,
-     off64_t extent_offset,
-     size64_t extent_size,
+     off64_t offset,
+     libbfio_pool_t *file_io_pool,
+     int *extent_index,
+     off64_t *extent_file_data_offset,
+     libphdi_storage_image_t **extent_file,
      libcerror_error_t **error )
 {
-	static char *function = "libphdi_extent_table_append_extent";
-	int element_index     = 0;
-	int segment_index     = 0;
+	libphdi_segment_table_segment_t *segment = NULL;
+	libphdi_storage_image_t *storage_image   = NULL;
+	static char *function                    = "libphdi_extent_table_get_extent_file_at_offset";
+	int result                               = 0;
 
 	if( extent_table == NULL )
 	{
@@ -442,123 +504,1358 @@ int libphdi_extent_table_append_extent(
 
 		return( -1 );
 	}
-	if( extent_table->image_type == 0 )
+	if( extent_table->extent_index == NULL )
 	{
-		if( image_type == LIBPHDI_IMAGE_TYPE_COMPRESSED )
-		{
-			if( extent_table->disk_type != LIBPHDI_DISK_TYPE_EXPANDING )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-				 "%s: image type not supported for disk type.",
-				 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extent table - missing extent index.",
+		 function );
 
-				return( -1 );
-			}
-		}
-		else if( image_type == LIBPHDI_IMAGE_TYPE_PLAIN )
-		{
-			if( extent_table->disk_type != LIBPHDI_DISK_TYPE_FIXED )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-				 "%s: image type not supported for disk type.",
-				 function );
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
 
-				return( -1 );
-			}
-		}
-		else
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported image type.",
-			 function );
+		return( -1 );
+	}
+	if( extent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent index.",
+		 function );
 
-			return( -1 );
-		}
-		extent_table->image_type = image_type;
+		return( -1 );
 	}
-	else if( extent_table->image_type != image_type )
+	if( extent_file_data_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: mixed image types not supported.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file data offset.",
 		 function );
 
 		return( -1 );
 	}
-	if( image_type == LIBPHDI_IMAGE_TYPE_PLAIN )
+	if( extent_file == NULL )
 	{
-		if( ( extent_offset < 0 )
-		 || ( (size64_t) extent_offset >= extent_file_size ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid extent offset value out of bounds.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
 
-			return( -1 );
-		}
-		if( extent_size > ( extent_file_size - (size64_t) extent_offset ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid extent size value out of bounds.",
-			 function );
+		return( -1 );
+	}
+	result = libphdi_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          offset,
+	          extent_index,
+	          error );
 
-			return( -1 );
-		}
-		if( libfdata_stream_append_segment(
-		     extent_table->extent_files_stream,
-		     &segment_index,
-		     file_io_pool_entry,
-		     extent_offset,
-		     extent_size,
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append segment to extent files stream.",
-			 function );
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent index at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
 
-			return( -1 );
-		}
+		goto on_error;
 	}
-	else if( image_type == LIBPHDI_IMAGE_TYPE_COMPRESSED )
+	segment = &( extent_table->extent_index->segments[ *extent_index ] );
+
+	*extent_file_data_offset = offset - segment->media_offset;
+
+	result = libphdi_storage_image_cache_get_storage_image_by_index(
+	          extent_table->extent_files_cache,
+	          *extent_index,
+	          extent_file,
+	          error );
+
+	if( result == -1 )
 	{
-		if( extent_offset != 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid extent offset value out of bounds.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve storage image: %d from extent files cache.",
+		 function,
+		 *extent_index );
 
-			return( -1 );
-		}
-		if( libfdata_list_append_element_with_mapped_size(
-		     extent_table->extent_files_list,
-		     &element_index,
-		     file_io_pool_entry,
-		     0,
-		     extent_file_size,
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		libphdi_statistics_add_value(
+		 extent_table->statistics,
+		 LIBPHDI_STATISTIC_EXTENT_FILES_CACHE_HITS,
+		 1 );
+
+		return( 1 );
+	}
+	libphdi_statistics_add_value(
+	 extent_table->statistics,
+	 LIBPHDI_STATISTIC_EXTENT_FILES_CACHE_MISSES,
+	 1 );
+	if( libphdi_extent_table_read_extent_file(
+	     extent_table,
+	     file_io_pool,
+	     *extent_index,
+	     &storage_image,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read storage image: %d.",
+		 function,
+		 *extent_index );
+
+		goto on_error;
+	}
+	if( libphdi_storage_image_cache_set_storage_image_by_index(
+	     extent_table->extent_files_cache,
+	     *extent_index,
+	     storage_image,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set storage image: %d in extent files cache.",
+		 function,
+		 *extent_index );
+
+		goto on_error;
+	}
+	*extent_file = storage_image;
+
+	return( 1 );
+
+on_error:
+	if( storage_image != NULL )
+	{
+		libphdi_storage_image_free(
+		 &storage_image,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the number of extent files
+ * Only the extents of compressed storage image files have an extent file
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_extent_table_get_number_of_extent_files(
+     libphdi_extent_table_t *extent_table,
+     int *number_of_extent_files,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_extent_table_get_number_of_extent_files";
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extent_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of extent files.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_table->extent_index == NULL )
+	 || ( extent_table->extent_files_cache == NULL ) )
+	{
+		*number_of_extent_files = 0;
+	}
+	else
+	{
+		*number_of_extent_files = extent_table->extent_index->number_of_segments;
+	}
+	return( 1 );
+}
+
+/* Retrieves the block size of the storage images of the extent table
+ * The block size is read from the file header of the first storage image, which
+ * is taken from the metadata index when available, the header is not cached
+ * The storage images of a snapshot share the same block size, the other extents
+ * are only checked to start at a multiple of the block size
+ * An error reading the file header is not fatal, since the layer map is optional
+ * The extent index is not modified after the image is opened hence no lock is needed
+ * Returns 1 if successful, 0 if the block size cannot be determined or -1 on error
+ */
+int libphdi_extent_table_get_block_size(
+     libphdi_extent_table_t *extent_table,
+     libbfio_pool_t *file_io_pool,
+     size64_t *block_size,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *read_error          = NULL;
+	libphdi_storage_image_t *storage_image = NULL;
+	static char *function                  = "libphdi_extent_table_get_block_size";
+	size64_t safe_block_size               = 0;
+	int extent_index                       = 0;
+	int file_io_pool_entry                 = 0;
+	int result                             = 0;
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_table->extent_index == NULL )
+	 || ( extent_table->extent_index->number_of_segments == 0 ) )
+	{
+		return( 0 );
+	}
+	file_io_pool_entry = extent_table->extent_index->segments[ 0 ].file_io_pool_entry;
+
+	if( extent_table->metadata_index != NULL )
+	{
+		result = libphdi_metadata_index_get_storage_image_block_size(
+		          extent_table->metadata_index,
+		          file_io_pool_entry,
+		          &safe_block_size,
+		          &read_error );
+	}
+	if( result == 0 )
+	{
+		if( libphdi_storage_image_initialize(
+		     &storage_image,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create storage image.",
+			 function );
+
+			return( -1 );
+		}
+		storage_image->statistics = extent_table->statistics;
+
+		result = libphdi_storage_image_read_file_header(
+		          storage_image,
+		          file_io_pool,
+		          file_io_pool_entry,
+		          &read_error );
+
+		if( result == 1 )
+		{
+			result = libphdi_storage_image_get_block_size(
+			          storage_image,
+			          &safe_block_size,
+			          &read_error );
+		}
+		libphdi_storage_image_free(
+		 &storage_image,
+		 NULL );
+	}
+	if( result != 1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( ( libcnotify_verbose != 0 )
+		 && ( read_error != NULL ) )
+		{
+			libcnotify_print_error_backtrace(
+			 read_error );
+		}
+#endif
+		libcerror_error_free(
+		 &read_error );
+
+		return( 0 );
+	}
+	if( safe_block_size == 0 )
+	{
+		return( 0 );
+	}
+	/* The blocks of every storage image must be aligned with the blocks of the first
+	 */
+	for( extent_index = 1;
+	     extent_index < extent_table->extent_index->number_of_segments;
+	     extent_index++ )
+	{
+		if( ( (size64_t) extent_table->extent_index->segments[ extent_index ].media_offset % safe_block_size ) != 0 )
+		{
+			return( 0 );
+		}
+	}
+	*block_size = safe_block_size;
+
+	return( 1 );
+}
+
+/* Determines if the extent file of a specific extent is in the extent files cache
+ * The order of the extent files cache is not changed
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if the extent file is cached, 0 if not or -1 on error
+ */
+int libphdi_extent_table_has_extent_file(
+     libphdi_extent_table_t *extent_table,
+     int extent_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_extent_table_has_extent_file";
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table->extent_files_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extent table - missing extent files cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_index < extent_table->extent_files_cache->entries_size )
+	 && ( extent_table->extent_files_cache->entries[ extent_index ] != NULL ) )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Reads the extent file of a specific extent
+ * The storage image file header and block allocation table are read, the extent files cache is not used
+ * If the metadata index contains the storage image, it is used instead of the storage image file
+ * This function only reads the extent index and can be called concurrently for different extents
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_extent_table_read_extent_file(
+     libphdi_extent_table_t *extent_table,
+     libbfio_pool_t *file_io_pool,
+     int extent_index,
+     libphdi_storage_image_t **extent_file,
+     libcerror_error_t **error )
+{
+	libphdi_storage_image_t *storage_image = NULL;
+	static char *function                  = "libphdi_extent_table_read_extent_file";
+	int file_io_pool_entry                 = 0;
+	int result                             = 0;
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table->extent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extent table - missing extent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_index < 0 )
+	 || ( extent_index >= extent_table->extent_index->number_of_segments ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libphdi_storage_image_initialize(
+	     &storage_image,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create storage image.",
+		 function );
+
+		goto on_error;
+	}
+	storage_image->statistics = extent_table->statistics;
+
+	file_io_pool_entry = extent_table->extent_index->segments[ extent_index ].file_io_pool_entry;
+
+	if( extent_table->metadata_index != NULL )
+	{
+		result = libphdi_metadata_index_get_storage_image(
+		          extent_table->metadata_index,
+		          file_io_pool_entry,
+		          storage_image,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve storage image: %d from metadata index.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+	}
+	if( result == 0 )
+	{
+		result = libphdi_storage_image_read_file_io_pool(
+		          storage_image,
+		          file_io_pool,
+		          file_io_pool_entry,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read storage image: %d.",
+		 function,
+		 extent_index );
+
+		goto on_error;
+	}
+	if( extent_table->storage_image_registry != NULL )
+	{
+		if( libphdi_storage_image_share_block_allocation_table(
+		     storage_image,
+		     extent_table->storage_image_registry,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to share block allocation table of storage image: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+	}
+	*extent_file = storage_image;
+
+	return( 1 );
+
+on_error:
+	if( storage_image != NULL )
+	{
+		libphdi_storage_image_free(
+		 &storage_image,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the extent file of a specific extent in the extent files cache
+ * The extent files cache takes over management of the extent file
+ * The extent file is counted as a miss of the extent files cache, since it was read
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_extent_table_set_extent_file(
+     libphdi_extent_table_t *extent_table,
+     int extent_index,
+     libphdi_storage_image_t *extent_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_extent_table_set_extent_file";
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libphdi_storage_image_cache_set_storage_image_by_index(
+	     extent_table->extent_files_cache,
+	     extent_index,
+	     extent_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set storage image: %d in extent files cache.",
+		 function,
+		 extent_index );
+
+		return( -1 );
+	}
+	extent_table->extent_files_cache->number_of_misses += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the range of blocks at a specific offset from the extent table
+ * using only the storage images and block allocation table pages that are loaded
+ * The extent table is not modified hence a read lock is sufficient
+ * Returns 1 if successful, 0 if the storage image or block allocation table page is not loaded or -1 on error
+ */
+int libphdi_extent_table_get_loaded_block_range_at_offset(
+     libphdi_extent_table_t *extent_table,
+     off64_t offset,
+     size64_t maximum_range_size,
+     int *file_io_pool_entry,
+     off64_t *range_file_offset,
+     size64_t *range_size,
+     uint8_t *range_is_sparse,
+     libcerror_error_t **error )
+{
+	libphdi_segment_table_segment_t *segment = NULL;
+	libphdi_storage_image_t *storage_image   = NULL;
+	static char *function                    = "libphdi_extent_table_get_loaded_block_range_at_offset";
+	off64_t storage_image_data_offset        = 0;
+	int extent_index                         = 0;
+	int result                               = 0;
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table->extent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extent table - missing extent index.",
+		 function );
+
+		return( -1 );
+	}
+	result = libphdi_extent_table_get_extent_index_at_offset(
+	          extent_table,
+	          offset,
+	          &extent_index,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent index at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	segment = &( extent_table->extent_index->segments[ extent_index ] );
+
+	storage_image_data_offset = offset - segment->media_offset;
+
+	result = libphdi_storage_image_cache_peek_storage_image_by_index(
+	          extent_table->extent_files_cache,
+	          extent_index,
+	          &storage_image,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve storage image: %d from extent files cache.",
+		 function,
+		 extent_index );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	result = libphdi_storage_image_get_block_range(
+	          storage_image,
+	          NULL,
+	          storage_image_data_offset,
+	          maximum_range_size,
+	          file_io_pool_entry,
+	          range_file_offset,
+	          range_size,
+	          range_is_sparse,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block range at offset: %" PRIi64 " (0x%08" PRIx64 ") from storage image.",
+		 function,
+		 storage_image_data_offset,
+		 storage_image_data_offset );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the range of blocks at a specific offset from the extent table
+ * The range does not exceed the maximum range size or the end of the extent
+ * Returns 1 if the range is allocated, 0 if the range is sparse or -1 on error
+ */
+int libphdi_extent_table_get_block_range_at_offset(
+     libphdi_extent_table_t *extent_table,
+     off64_t offset,
+     libbfio_pool_t *file_io_pool,
+     size64_t maximum_range_size,
+     int *file_io_pool_entry,
+     off64_t *range_file_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	libphdi_storage_image_t *storage_image = NULL;
+	static char *function                  = "libphdi_extent_table_get_block_range_at_offset";
+	off64_t storage_image_data_offset      = 0;
+	uint8_t range_is_sparse                = 0;
+	int extent_index                       = 0;
+	int result                             = 0;
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table->segment_table != NULL )
+	{
+		/* Data stored in plain extent files is contiguous within a segment
+		 * and the segment table is not modified after it was built hence no lock is needed
+		 */
+		result = libphdi_segment_table_get_range_at_offset(
+		          extent_table->segment_table,
+		          offset,
+		          maximum_range_size,
+		          file_io_pool_entry,
+		          range_file_offset,
+		          range_size,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range at offset: %" PRIi64 " (0x%08" PRIx64 ") from segment table.",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     extent_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libphdi_extent_table_get_loaded_block_range_at_offset(
+	          extent_table,
+	          offset,
+	          maximum_range_size,
+	          file_io_pool_entry,
+	          range_file_offset,
+	          range_size,
+	          &range_is_sparse,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve loaded block range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     extent_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result == -1 )
+	{
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		libphdi_statistics_add_value(
+		 extent_table->statistics,
+		 LIBPHDI_STATISTIC_EXTENT_FILES_CACHE_HITS,
+		 1 );
+
+		if( range_is_sparse != 0 )
+		{
+			return( 0 );
+		}
+		return( 1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	/* The storage image or block allocation table page needs to be read, which modifies
+	 * the extent files cache, hence the write lock. Another thread can have read it
+	 * in the meantime, which libphdi_extent_table_get_extent_file_at_offset handles
+	 */
+	if( libcthreads_read_write_lock_grab_for_write(
+	     extent_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libphdi_extent_table_get_extent_file_at_offset(
+	     extent_table,
+	     offset,
+	     file_io_pool,
+	     &extent_index,
+	     &storage_image_data_offset,
+	     &storage_image,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent file at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		result = -1;
+	}
+	else
+	{
+		result = libphdi_storage_image_get_block_range_at_offset(
+		          storage_image,
+		          file_io_pool,
+		          storage_image_data_offset,
+		          maximum_range_size,
+		          file_io_pool_entry,
+		          range_file_offset,
+		          range_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block range at offset: %" PRIi64 " (0x%08" PRIx64 ") from storage image.",
+			 function,
+			 storage_image_data_offset,
+			 storage_image_data_offset );
+		}
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     extent_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the allocation range at a specific offset
+ * Data stored in plain extent files is always allocated
+ * Returns 1 if the range is allocated, 0 if the range is sparse or -1 on error
+ */
+int libphdi_extent_table_get_allocation_range_at_offset(
+     libphdi_extent_table_t *extent_table,
+     off64_t offset,
+     libbfio_pool_t *file_io_pool,
+     size64_t maximum_range_size,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	static char *function     = "libphdi_extent_table_get_allocation_range_at_offset";
+	off64_t range_file_offset = 0;
+	int file_io_pool_entry    = 0;
+	int result                = 0;
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_range_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum range size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table->segment_table != NULL )
+	{
+		*range_size = maximum_range_size;
+
+		return( 1 );
+	}
+	result = libphdi_extent_table_get_block_range_at_offset(
+	          extent_table,
+	          offset,
+	          file_io_pool,
+	          maximum_range_size,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          range_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Reads data at a specific offset from the segment table into a buffer
+ * The segment table is not modified after it was built hence no lock is needed
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libphdi_extent_table_read_buffer_at_offset(
+         libphdi_extent_table_t *extent_table,
+         libbfio_pool_t *file_io_pool,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libphdi_extent_table_read_buffer_at_offset";
+	ssize_t read_count    = 0;
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libphdi_segment_table_read_buffer_at_offset(
+	              extent_table->segment_table,
+	              file_io_pool,
+	              extent_table->statistics,
+	              buffer,
+	              buffer_size,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer from segment table at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Sets the maximum number of storage images in the extent files cache
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_extent_table_set_maximum_number_of_cached_extent_files(
+     libphdi_extent_table_t *extent_table,
+     int maximum_number_of_cached_extent_files,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_extent_table_set_maximum_number_of_cached_extent_files";
+	int result            = 1;
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_cached_extent_files <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of cached extent files value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     extent_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	extent_table->maximum_number_of_cached_extent_files = maximum_number_of_cached_extent_files;
+
+	if( extent_table->extent_files_cache != NULL )
+	{
+		if( libphdi_storage_image_cache_set_maximum_number_of_entries(
+		     extent_table->extent_files_cache,
+		     maximum_number_of_cached_extent_files,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of entries of extent files cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     extent_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the extent files cache statistics
+ * A miss means the storage image file header and block allocation table were read
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_extent_table_get_extent_files_cache_statistics(
+     libphdi_extent_table_t *extent_table,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_extent_table_get_extent_files_cache_statistics";
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     extent_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( extent_table->extent_files_cache != NULL )
+	{
+		*number_of_hits   = libphdi_statistics_atomic_get(
+		                     &( extent_table->extent_files_cache->number_of_hits ) );
+		*number_of_misses = extent_table->extent_files_cache->number_of_misses;
+	}
+	else
+	{
+		*number_of_hits   = 0;
+		*number_of_misses = 0;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     extent_table->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Appends an extent to the extent table based on the image values
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_extent_table_append_extent(
+     libphdi_extent_table_t *extent_table,
+     int image_type,
+     int file_io_pool_entry,
+     size64_t extent_file_size,
+     off64_t extent_offset,
+     size64_t extent_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_extent_table_append_extent";
+
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table->image_type == 0 )
+	{
+		if( image_type == LIBPHDI_IMAGE_TYPE_COMPRESSED )
+		{
+			if( extent_table->disk_type != LIBPHDI_DISK_TYPE_EXPANDING )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: image type not supported for disk type.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( image_type == LIBPHDI_IMAGE_TYPE_PLAIN )
+		{
+			if( extent_table->disk_type != LIBPHDI_DISK_TYPE_FIXED )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: image type not supported for disk type.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported image type.",
+			 function );
+
+			return( -1 );
+		}
+		extent_table->image_type = image_type;
+	}
+	else if( extent_table->image_type != image_type )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: mixed image types not supported.",
+		 function );
+
+		return( -1 );
+	}
+	if( image_type == LIBPHDI_IMAGE_TYPE_PLAIN )
+	{
+		if( ( extent_offset < 0 )
+		 || ( (size64_t) extent_offset >= extent_file_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid extent offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( extent_size > ( extent_file_size - (size64_t) extent_offset ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid extent size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( libphdi_segment_table_append_segment(
+		     extent_table->segment_table,
+		     file_io_pool_entry,
+		     extent_offset,
+		     extent_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment to segment table.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( image_type == LIBPHDI_IMAGE_TYPE_COMPRESSED )
+	{
+		if( extent_offset != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid extent offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( libphdi_segment_table_append_segment(
+		     extent_table->extent_index,
+		     file_io_pool_entry,
 		     0,
 		     extent_size,
 		     error ) != 1 )
@@ -567,7 +1864,7 @@ int libphdi_extent_table_append_extent(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append element to extent files list.",
+			 "%s: unable to append extent to extent index.",
 			 function );
 
 			return( -1 );
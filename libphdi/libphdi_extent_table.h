@@ -30,9 +30,13 @@
 #include "libphdi_io_handle.h"
 #include "libphdi_libbfio.h"
 #include "libphdi_libcerror.h"
-#include "libphdi_libfcache.h"
-#include "libphdi_libfdata.h"
+#include "libphdi_libcthreads.h"
+#include "libphdi_metadata_index.h"
+#include "libphdi_segment_table.h"
+#include "libphdi_statistics.h"
 #include "libphdi_storage_image.h"
+#include "libphdi_storage_image_cache.h"
+#include "libphdi_storage_image_registry.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -54,17 +58,43 @@ struct libphdi_extent_table
 	 */
 	int number_of_extents;
 
-	/* The extent files list used for compressed storage image files
+	/* The extent index used to look up the storage image file at an offset
 	 */
-	libfdata_list_t *extent_files_list;
+	libphdi_segment_table_t *extent_index;
+
+	/* The index of the most recently looked up extent, which is updated atomically
+	 */
+	int last_extent_index;
 
 	/* The extent files cache used for compressed storage image files
 	 */
-	libfcache_cache_t *extent_files_cache;
+	libphdi_storage_image_cache_t *extent_files_cache;
+
+	/* The maximum number of storage images in the extent files cache
+	 */
+	int maximum_number_of_cached_extent_files;
+
+	/* The segment table used for plain storage image files
+	 */
+	libphdi_segment_table_t *segment_table;
+
+	/* The read statistics, which are managed by the handle
+	 */
+	libphdi_statistics_t *statistics;
 
-	/* The extent files stream used for plain storage image files
+	/* The metadata index, which is managed by the handle
 	 */
-	libfdata_stream_t *extent_files_stream;
+	libphdi_metadata_index_t *metadata_index;
+
+	/* The storage image registry, which is managed by the user
+	 */
+	libphdi_storage_image_registry_t *storage_image_registry;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
 };
 
 int libphdi_extent_table_initialize(
@@ -85,6 +115,12 @@ int libphdi_extent_table_initialize_extents(
      int disk_type,
      libcerror_error_t **error );
 
+int libphdi_extent_table_get_extent_index_at_offset(
+     libphdi_extent_table_t *extent_table,
+     off64_t offset,
+     int *extent_index,
+     libcerror_error_t **error );
+
 int libphdi_extent_table_get_extent_file_at_offset(
      libphdi_extent_table_t *extent_table,
      off64_t offset,
@@ -94,6 +130,82 @@ int libphdi_extent_table_get_extent_file_at_offset(
      libphdi_storage_image_t **extent_file,
      libcerror_error_t **error );
 
+int libphdi_extent_table_get_number_of_extent_files(
+     libphdi_extent_table_t *extent_table,
+     int *number_of_extent_files,
+     libcerror_error_t **error );
+
+int libphdi_extent_table_get_block_size(
+     libphdi_extent_table_t *extent_table,
+     libbfio_pool_t *file_io_pool,
+     size64_t *block_size,
+     libcerror_error_t **error );
+
+int libphdi_extent_table_has_extent_file(
+     libphdi_extent_table_t *extent_table,
+     int extent_index,
+     libcerror_error_t **error );
+
+int libphdi_extent_table_read_extent_file(
+     libphdi_extent_table_t *extent_table,
+     libbfio_pool_t *file_io_pool,
+     int extent_index,
+     libphdi_storage_image_t **extent_file,
+     libcerror_error_t **error );
+
+int libphdi_extent_table_set_extent_file(
+     libphdi_extent_table_t *extent_table,
+     int extent_index,
+     libphdi_storage_image_t *extent_file,
+     libcerror_error_t **error );
+
+int libphdi_extent_table_get_loaded_block_range_at_offset(
+     libphdi_extent_table_t *extent_table,
+     off64_t offset,
+     size64_t maximum_range_size,
+     int *file_io_pool_entry,
+     off64_t *range_file_offset,
+     size64_t *range_size,
+     uint8_t *range_is_sparse,
+     libcerror_error_t **error );
+
+int libphdi_extent_table_get_block_range_at_offset(
+     libphdi_extent_table_t *extent_table,
+     off64_t offset,
+     libbfio_pool_t *file_io_pool,
+     size64_t maximum_range_size,
+     int *file_io_pool_entry,
+     off64_t *range_file_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+int libphdi_extent_table_get_allocation_range_at_offset(
+     libphdi_extent_table_t *extent_table,
+     off64_t offset,
+     libbfio_pool_t *file_io_pool,
+     size64_t maximum_range_size,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+ssize_t libphdi_extent_table_read_buffer_at_offset(
+         libphdi_extent_table_t *extent_table,
+         libbfio_pool_t *file_io_pool,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int libphdi_extent_table_set_maximum_number_of_cached_extent_files(
+     libphdi_extent_table_t *extent_table,
+     int maximum_number_of_cached_extent_files,
+     libcerror_error_t **error );
+
+int libphdi_extent_table_get_extent_files_cache_statistics(
+     libphdi_extent_table_t *extent_table,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
 int libphdi_extent_table_append_extent(
      libphdi_extent_table_t *extent_table,
      int image_type,
@@ -27,6 +27,10 @@
 #include <wide_string.h>
 
 #include "libphdi_block_descriptor.h"
+#include "libphdi_borrowed_buffers.h"
+#include "libphdi_completion_queue.h"
+#include "libphdi_data_block.h"
+#include "libphdi_data_cache.h"
 #include "libphdi_data_files.h"
 #include "libphdi_debug.h"
 #include "libphdi_definitions.h"
@@ -39,6 +43,7 @@
 #include "libphdi_image_values.h"
 #include "libphdi_io_handle.h"
 #include "libphdi_handle.h"
+#include "libphdi_layer_map.h"
 #include "libphdi_libbfio.h"
 #include "libphdi_libcdata.h"
 #include "libphdi_libcdirectory.h"
@@ -48,9 +53,23 @@
 #include "libphdi_libcthreads.h"
 #include "libphdi_libfcache.h"
 #include "libphdi_libfdata.h"
+#include "libphdi_mapped_file.h"
+#include "libphdi_metadata_index.h"
+#include "libphdi_metadata_request.h"
+#include "libphdi_probes.h"
+#include "libphdi_read_request.h"
+#include "libphdi_read_vector.h"
+#include "libphdi_readahead.h"
 #include "libphdi_snapshot.h"
 #include "libphdi_snapshot_values.h"
+#include "libphdi_statistics.h"
 #include "libphdi_storage_image.h"
+#include "libphdi_storage_image_registry.h"
+#include "libphdi_unused.h"
+
+/* The data returned for sparse ranges by libphdi_handle_borrow_buffer_at_offset
+ */
+static uint8_t libphdi_handle_zero_data[ LIBPHDI_DATA_BLOCK_SIZE ];
 
 /* Creates a handle
  * Make sure the value handle is referencing, is set to NULL
@@ -184,6 +203,32 @@ int libphdi_handle_initialize(
 
 		goto on_error;
 	}
+	if( libphdi_statistics_initialize(
+	     &( internal_handle->statistics ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( libphdi_borrowed_buffers_initialize(
+	     &( internal_handle->zero_data_borrowed_buffers ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create zero data borrowed buffers.",
+		 function );
+
+		goto on_error;
+	}
 	if( libphdi_i18n_initialize(
 	     error ) != 1 )
 	{
@@ -210,8 +255,36 @@ int libphdi_handle_initialize(
 
 		goto on_error;
 	}
+	if( libcthreads_read_write_lock_initialize(
+	     &( internal_handle->data_block_cache_read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize data block cache read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( internal_handle->number_of_borrowed_buffers_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize number of borrowed buffers mutex.",
+		 function );
+
+		goto on_error;
+	}
 #endif
-	internal_handle->maximum_number_of_open_handles = LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES;
+	internal_handle->maximum_number_of_open_handles        = LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES;
+	internal_handle->maximum_number_of_cached_extent_files = LIBPHDI_MAXIMUM_CACHE_ENTRIES_EXTENT_FILES;
+	internal_handle->data_block_cache_size                 = LIBPHDI_DEFAULT_DATA_BLOCK_CACHE_SIZE;
 
 	*handle = (libphdi_handle_t *) internal_handle;
 
@@ -220,6 +293,32 @@ int libphdi_handle_initialize(
 on_error:
 	if( internal_handle != NULL )
 	{
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( internal_handle->number_of_borrowed_buffers_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( internal_handle->number_of_borrowed_buffers_mutex ),
+			 NULL );
+		}
+		if( internal_handle->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( internal_handle->read_write_lock ),
+			 NULL );
+		}
+#endif
+		if( internal_handle->zero_data_borrowed_buffers != NULL )
+		{
+			libphdi_borrowed_buffers_free(
+			 &( internal_handle->zero_data_borrowed_buffers ),
+			 NULL );
+		}
+		if( internal_handle->statistics != NULL )
+		{
+			libphdi_statistics_free(
+			 &( internal_handle->statistics ),
+			 NULL );
+		}
 		if( internal_handle->data_files != NULL )
 		{
 			libphdi_data_files_free(
@@ -260,6 +359,8 @@ on_error:
 }
 
 /* Frees a handle
+ * The handle is not freed if buffers borrowed with libphdi_handle_borrow_buffer_at_offset
+ * have not been released
  * Returns 1 if successful or -1 on error
  */
 int libphdi_handle_free(
@@ -268,6 +369,7 @@ int libphdi_handle_free(
 {
 	libphdi_internal_handle_t *internal_handle = NULL;
 	static char *function                      = "libphdi_handle_free";
+	int number_of_clones                       = 0;
 	int result                                 = 1;
 
 	if( handle == NULL )
@@ -285,6 +387,91 @@ int libphdi_handle_free(
 	{
 		internal_handle = (libphdi_internal_handle_t *) *handle;
 
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_write(
+		     internal_handle->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		/* The parsed metadata is shared with the clones of the handle,
+		 * hence the handle is freed when its last clone is freed
+		 */
+		number_of_clones = internal_handle->number_of_clones;
+
+		if( number_of_clones > 0 )
+		{
+			internal_handle->free_on_last_clone = 1;
+		}
+		/* Borrowed buffers reference the memory mapped extent data files,
+		 * which are unmapped when the handle is freed
+		 */
+		else if( internal_handle->number_of_borrowed_buffers != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid handle - %" PRIu64 " borrowed buffers have not been released.",
+			 function,
+			 internal_handle->number_of_borrowed_buffers );
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+			libcthreads_read_write_lock_release_for_write(
+			 internal_handle->read_write_lock,
+			 NULL );
+#endif
+			return( -1 );
+		}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     internal_handle->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( number_of_clones > 0 )
+		{
+			*handle = NULL;
+
+			return( 1 );
+		}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		/* The outstanding asynchronous reads are completed before the handle is closed
+		 */
+		if( internal_handle->async_read_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( internal_handle->async_read_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join asynchronous read thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( internal_handle->extent_data_file_io_pool != NULL )
 		 || ( internal_handle->file_io_handle != NULL ) )
 		{
@@ -304,6 +491,58 @@ int libphdi_handle_free(
 		}
 		*handle = NULL;
 
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		/* The pending readahead requests are completed before the thread pool is joined
+		 */
+		if( internal_handle->readahead_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( internal_handle->readahead_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join readahead thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		if( internal_handle->readahead != NULL )
+		{
+			if( libphdi_readahead_free(
+			     &( internal_handle->readahead ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free readahead.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( internal_handle->completion_queue != NULL )
+		{
+			if( libphdi_completion_queue_free(
+			     &( internal_handle->completion_queue ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free completion queue.",
+				 function );
+
+				result = -1;
+			}
+		}
 #if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
 		if( libcthreads_read_write_lock_free(
 		     &( internal_handle->read_write_lock ),
@@ -318,7 +557,59 @@ int libphdi_handle_free(
 
 			result = -1;
 		}
+		if( libcthreads_read_write_lock_free(
+		     &( internal_handle->data_block_cache_read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free data block cache read/write lock.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( internal_handle->number_of_borrowed_buffers_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free number of borrowed buffers mutex.",
+			 function );
+
+			result = -1;
+		}
 #endif
+		if( libphdi_statistics_free(
+		     &( internal_handle->statistics ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free statistics.",
+			 function );
+
+			result = -1;
+		}
+		if( libphdi_borrowed_buffers_free(
+		     &( internal_handle->zero_data_borrowed_buffers ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free zero data borrowed buffers.",
+			 function );
+
+			result = -1;
+		}
 		if( libphdi_data_files_free(
 		     &( internal_handle->data_files ),
 		     error ) != 1 )
@@ -332,6 +623,22 @@ int libphdi_handle_free(
 
 			result = -1;
 		}
+		if( internal_handle->metadata_index != NULL )
+		{
+			if( libphdi_metadata_index_free(
+			     &( internal_handle->metadata_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free metadata index.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libcdata_array_free(
 		     &( internal_handle->snapshot_values_array ),
 		     (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_snapshot_values_free,
@@ -393,360 +700,610 @@ int libphdi_handle_free(
 	return( result );
 }
 
-/* Signals a handle to abort its current activity
+/* Clones a handle that has its extent data files opened
+ * The clone shares the parsed metadata and the data block cache with the source handle
  * Returns 1 if successful or -1 on error
  */
-int libphdi_handle_signal_abort(
-     libphdi_handle_t *handle,
+int libphdi_handle_clone(
+     libphdi_handle_t **destination_handle,
+     libphdi_handle_t *source_handle,
+     uint8_t clone_flags,
      libcerror_error_t **error )
 {
-	libphdi_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libphdi_handle_signal_abort";
+	libphdi_internal_handle_t *internal_destination_handle = NULL;
+	libphdi_internal_handle_t *parent_handle               = NULL;
+	static char *function                                  = "libphdi_handle_clone";
 
-	if( handle == NULL )
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	uint8_t parent_handle_locked                           = 0;
+#endif
+
+	if( destination_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid destination handle.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libphdi_internal_handle_t *) handle;
-
-	if( internal_handle->io_handle == NULL )
+	if( *destination_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination handle value already set.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->io_handle->abort = 1;
-
-	return( 1 );
-}
-
-/* Opens a handle
- * Returns 1 if successful or -1 on error
- */
-int libphdi_handle_open(
-     libphdi_handle_t *handle,
-     const char *filename,
-     int access_flags,
-     libcerror_error_t **error )
-{
-	libbfio_handle_t *file_io_handle           = NULL;
-	libcdirectory_directory_t *directory       = NULL;
-	libphdi_internal_handle_t *internal_handle = NULL;
-	char *data_files_path_end                  = NULL;
-	char *disk_descriptor_xml_path             = NULL;
-	static char *function                      = "libphdi_handle_open";
-	size_t data_files_path_length              = 0;
-	size_t disk_descriptor_xml_path_size       = 0;
-	size_t filename_length                     = 0;
-	int is_directory                           = 0;
-	int result                                 = 1;
-
-	if( handle == NULL )
+	if( source_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid source handle.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libphdi_internal_handle_t *) handle;
-
-	if( filename == NULL )
+	if( ( clone_flags & ~( LIBPHDI_CLONE_FLAG_SEPARATE_FILE_IO_POOL ) ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid filename.",
-		 function );
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported clone flags: 0x%02" PRIx8 ".",
+		 function,
+		 clone_flags );
 
 		return( -1 );
 	}
-	if( ( ( access_flags & LIBPHDI_ACCESS_FLAG_READ ) == 0 )
-	 && ( ( access_flags & LIBPHDI_ACCESS_FLAG_WRITE ) == 0 ) )
+	/* The clone of a clone shares the parsed metadata of the original handle
+	 */
+	parent_handle = (libphdi_internal_handle_t *) source_handle;
+
+	if( parent_handle->parent_handle != NULL )
+	{
+		parent_handle = parent_handle->parent_handle;
+	}
+	internal_destination_handle = memory_allocate_structure(
+	                               libphdi_internal_handle_t );
+
+	if( internal_destination_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported access flags.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( ( access_flags & LIBPHDI_ACCESS_FLAG_WRITE ) != 0 )
+	if( memory_set(
+	     internal_destination_handle,
+	     0,
+	     sizeof( libphdi_internal_handle_t ) ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: write access currently not supported.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear destination handle.",
 		 function );
 
+		memory_free(
+		 internal_destination_handle );
+
 		return( -1 );
 	}
-	if( libcdirectory_directory_initialize(
-	     &directory,
+	if( libphdi_io_handle_initialize(
+	     &( internal_destination_handle->io_handle ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create directory.",
+		 "%s: unable to create IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	is_directory = libcdirectory_directory_open(
-	                directory,
-	                filename,
-	                NULL );
+	if( libphdi_statistics_initialize(
+	     &( internal_destination_handle->statistics ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create statistics.",
+		 function );
 
-	if( libcdirectory_directory_free(
-	     &directory,
+		goto on_error;
+	}
+	if( libphdi_borrowed_buffers_initialize(
+	     &( internal_destination_handle->zero_data_borrowed_buffers ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free directory.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create zero data borrowed buffers.",
 		 function );
 
 		goto on_error;
 	}
-	if( libbfio_file_initialize(
-	     &file_io_handle,
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( internal_destination_handle->read_write_lock ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file IO handle.",
+		 "%s: unable to initialize read/write lock.",
 		 function );
 
 		goto on_error;
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libbfio_handle_set_track_offsets_read(
-	     file_io_handle,
-	     1,
+	if( libcthreads_mutex_initialize(
+	     &( internal_destination_handle->number_of_borrowed_buffers_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize number of borrowed buffers mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_read_write_lock_grab_for_write(
+	     parent_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set track offsets read in file IO handle.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		goto on_error;
 	}
+	parent_handle_locked = 1;
 #endif
-	if( is_directory == 1 )
+	if( ( parent_handle->extent_data_file_io_pool == NULL )
+	 || ( parent_handle->current_snapshot_values == NULL ) )
 	{
-		filename_length = narrow_string_length(
-		                   filename );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid source handle - missing extent data file IO pool.",
+		 function );
 
-		if( libcpath_path_join(
-		     &disk_descriptor_xml_path,
-		     &disk_descriptor_xml_path_size,
-		     filename,
-		     filename_length,
-		     "DiskDescriptor.xml",
-		     19,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create DiskDescriptor.xml path.",
-			 function );
+		goto on_error;
+	}
+	if( parent_handle->number_of_clones == INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid source handle - number of clones value out of bounds.",
+		 function );
 
-			goto on_error;
-		}
-		if( libbfio_file_set_name(
-		     file_io_handle,
-		     disk_descriptor_xml_path,
-		     disk_descriptor_xml_path_size - 1,
+		goto on_error;
+	}
+	if( ( clone_flags & LIBPHDI_CLONE_FLAG_SEPARATE_FILE_IO_POOL ) != 0 )
+	{
+		if( libbfio_pool_clone(
+		     &( internal_destination_handle->extent_data_file_io_pool ),
+		     parent_handle->extent_data_file_io_pool,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set filename in file IO handle.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create extent data file IO pool.",
 			 function );
 
 			goto on_error;
 		}
-		filename        = disk_descriptor_xml_path;
-		filename_length = disk_descriptor_xml_path_size - 1;
+		internal_destination_handle->extent_data_file_io_pool_created_in_library = 1;
 	}
 	else
 	{
-		filename_length = narrow_string_length(
-		                   filename );
+		internal_destination_handle->extent_data_file_io_pool = parent_handle->extent_data_file_io_pool;
+	}
+	internal_destination_handle->disk_type                             = parent_handle->disk_type;
+	internal_destination_handle->extent_values_array                   = parent_handle->extent_values_array;
+	internal_destination_handle->image_values_array                    = parent_handle->image_values_array;
+	internal_destination_handle->snapshot_values_array                 = parent_handle->snapshot_values_array;
+	internal_destination_handle->data_files                            = parent_handle->data_files;
+	internal_destination_handle->current_snapshot_values               = parent_handle->current_snapshot_values;
+	internal_destination_handle->disk_parameters                       = parent_handle->disk_parameters;
+	internal_destination_handle->layer_map                             = parent_handle->layer_map;
+	internal_destination_handle->data_block_cache                      = parent_handle->data_block_cache;
+	internal_destination_handle->data_block_cache_size                 = parent_handle->data_block_cache_size;
+	internal_destination_handle->data_cache                            = parent_handle->data_cache;
+	internal_destination_handle->data_cache_client                     = parent_handle->data_cache_client;
+	internal_destination_handle->memory_map_extent_data_files          = parent_handle->memory_map_extent_data_files;
+	internal_destination_handle->mapped_files_array                    = parent_handle->mapped_files_array;
+	internal_destination_handle->access_flags                          = parent_handle->access_flags;
+	internal_destination_handle->maximum_number_of_open_handles        = parent_handle->maximum_number_of_open_handles;
+	internal_destination_handle->maximum_number_of_cached_extent_files = parent_handle->maximum_number_of_cached_extent_files;
+	internal_destination_handle->number_of_metadata_prefetch_threads   = parent_handle->number_of_metadata_prefetch_threads;
+	internal_destination_handle->parent_handle                         = parent_handle;
 
-		if( libbfio_file_set_name(
-		     file_io_handle,
-		     filename,
-		     filename_length,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set filename in file IO handle.",
-			 function );
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	internal_destination_handle->data_block_cache_read_write_lock = parent_handle->data_block_cache_read_write_lock;
+#endif
+	parent_handle->number_of_clones += 1;
 
-			goto on_error;
-		}
-	}
-	if( libphdi_handle_open_file_io_handle(
-	     handle,
-	     file_io_handle,
-	     access_flags,
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	parent_handle_locked = 0;
+
+	if( libcthreads_read_write_lock_release_for_write(
+	     parent_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open handle from file: %s.",
-		 function,
-		 filename );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	filename_length = narrow_string_length(
-	                   filename );
+#endif
+	*destination_handle = (libphdi_handle_t *) internal_destination_handle;
 
-	data_files_path_end = narrow_string_search_character_reverse(
-	                       filename,
-	                       (int) LIBCPATH_SEPARATOR,
-	                       filename_length + 1 );
+	return( 1 );
 
-	if( data_files_path_end != NULL )
+on_error:
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( parent_handle_locked != 0 )
 	{
-		data_files_path_length = (size_t) ( data_files_path_end - filename );
+		libcthreads_read_write_lock_release_for_write(
+		 parent_handle->read_write_lock,
+		 NULL );
 	}
-	if( data_files_path_length > 0 )
+#endif
+	if( internal_destination_handle != NULL )
 	{
+		if( internal_destination_handle->extent_data_file_io_pool_created_in_library != 0 )
+		{
+			libbfio_pool_close_all(
+			 internal_destination_handle->extent_data_file_io_pool,
+			 NULL );
+			libbfio_pool_free(
+			 &( internal_destination_handle->extent_data_file_io_pool ),
+			 NULL );
+		}
 #if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
-		if( libcthreads_read_write_lock_grab_for_write(
-		     internal_handle->read_write_lock,
-		     error ) != 1 )
+		if( internal_destination_handle->number_of_borrowed_buffers_mutex != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to grab read/write lock for writing.",
-			 function );
-
-			return( -1 );
+			libcthreads_mutex_free(
+			 &( internal_destination_handle->number_of_borrowed_buffers_mutex ),
+			 NULL );
+		}
+		if( internal_destination_handle->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( internal_destination_handle->read_write_lock ),
+			 NULL );
 		}
 #endif
-		if( libphdi_data_files_set_path(
-		     internal_handle->data_files,
-		     filename,
-		     data_files_path_length,
-		     error ) != 1 )
+		if( internal_destination_handle->zero_data_borrowed_buffers != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set data files path.",
-			 function );
-
-			result = -1;
+			libphdi_borrowed_buffers_free(
+			 &( internal_destination_handle->zero_data_borrowed_buffers ),
+			 NULL );
 		}
-#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
-		if( libcthreads_read_write_lock_release_for_write(
-		     internal_handle->read_write_lock,
-		     error ) != 1 )
+		if( internal_destination_handle->statistics != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to release read/write lock for writing.",
-			 function );
-
-			return( -1 );
+			libphdi_statistics_free(
+			 &( internal_destination_handle->statistics ),
+			 NULL );
+		}
+		if( internal_destination_handle->io_handle != NULL )
+		{
+			libphdi_io_handle_free(
+			 &( internal_destination_handle->io_handle ),
+			 NULL );
 		}
-#endif
-	}
-	internal_handle->file_io_handle_created_in_library = 1;
-
-	if( disk_descriptor_xml_path != NULL )
-	{
-		memory_free(
-		 disk_descriptor_xml_path );
-
-		disk_descriptor_xml_path = NULL;
-	}
-	return( result );
-
-on_error:
-	if( file_io_handle != NULL )
-	{
-		libbfio_handle_free(
-		 &file_io_handle,
-		 NULL );
-	}
-	if( disk_descriptor_xml_path != NULL )
-	{
 		memory_free(
-		 disk_descriptor_xml_path );
-	}
-	if( directory != NULL )
-	{
-		libcdirectory_directory_free(
-		 &directory,
-		 NULL );
+		 internal_destination_handle );
 	}
 	return( -1 );
 }
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
-
-/* Opens a handle
- * Returns 1 if successful or -1 on error
+/* Closes a clone
+ * The clone releases the parsed metadata it shares with its parent handle.
+ * The parent handle is freed if it was freed before and this was its last clone
+ * Returns 0 if successful or -1 on error
  */
-int libphdi_handle_open_wide(
+int libphdi_internal_handle_close_clone(
+     libphdi_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	libphdi_handle_t *parent_handle = NULL;
+	static char *function           = "libphdi_internal_handle_close_clone";
+	uint8_t free_parent_handle      = 0;
+	int result                      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->parent_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing parent handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->number_of_borrowed_buffers != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - %" PRIu64 " borrowed buffers have not been released.",
+		 function,
+		 internal_handle->number_of_borrowed_buffers );
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+#endif
+		return( -1 );
+	}
+	if( internal_handle->extent_data_file_io_pool_created_in_library != 0 )
+	{
+		if( libbfio_pool_close_all(
+		     internal_handle->extent_data_file_io_pool,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close all files in extent data file IO pool.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_pool_free(
+		     &( internal_handle->extent_data_file_io_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free extent data file IO pool.",
+			 function );
+
+			result = -1;
+		}
+		internal_handle->extent_data_file_io_pool_created_in_library = 0;
+	}
+	internal_handle->extent_data_file_io_pool = NULL;
+	internal_handle->current_offset           = 0;
+	internal_handle->extent_values_array      = NULL;
+	internal_handle->image_values_array       = NULL;
+	internal_handle->snapshot_values_array    = NULL;
+	internal_handle->data_files               = NULL;
+	internal_handle->current_snapshot_values  = NULL;
+	internal_handle->disk_parameters          = NULL;
+	internal_handle->layer_map                = NULL;
+	internal_handle->data_block_cache         = NULL;
+	internal_handle->data_cache               = NULL;
+	internal_handle->data_cache_client        = NULL;
+	internal_handle->mapped_files_array       = NULL;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	internal_handle->data_block_cache_read_write_lock = NULL;
+
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->parent_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab parent handle read/write lock for writing.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->parent_handle->number_of_clones -= 1;
+
+	if( ( internal_handle->parent_handle->number_of_clones == 0 )
+	 && ( internal_handle->parent_handle->free_on_last_clone != 0 ) )
+	{
+		free_parent_handle = 1;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->parent_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release parent handle read/write lock for writing.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	parent_handle = (libphdi_handle_t *) internal_handle->parent_handle;
+
+	internal_handle->parent_handle = NULL;
+
+	if( free_parent_handle != 0 )
+	{
+		if( libphdi_handle_free(
+		     &parent_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free parent handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Determines if the handle shares its parsed metadata with other handles
+ * A clone shares the parsed metadata of its parent handle and a handle
+ * with clones shares its parsed metadata with the clones
+ * This function is not multi-thread safe acquire read lock before call
+ * Returns 1 if the parsed metadata is shared or 0 if not
+ */
+int libphdi_internal_handle_shares_metadata(
+     libphdi_internal_handle_t *internal_handle )
+{
+	if( internal_handle == NULL )
+	{
+		return( 0 );
+	}
+	if( ( internal_handle->parent_handle != NULL )
+	 || ( internal_handle->number_of_clones > 0 ) )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Signals a handle to abort its current activity
+ * The abort applies to the open, metadata warm up and reads that are in progress,
+ * reads started afterwards are not aborted
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_signal_abort(
      libphdi_handle_t *handle,
-     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_signal_abort";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->io_handle->abort = 1;
+
+	internal_handle->io_handle->abort_generation += 1;
+
+	return( 1 );
+}
+
+/* Opens a handle
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_open(
+     libphdi_handle_t *handle,
+     const char *filename,
      int access_flags,
      libcerror_error_t **error )
 {
 	libbfio_handle_t *file_io_handle           = NULL;
 	libcdirectory_directory_t *directory       = NULL;
 	libphdi_internal_handle_t *internal_handle = NULL;
-	wchar_t *data_files_path_end               = NULL;
-	wchar_t *disk_descriptor_xml_path          = NULL;
-	static char *function                      = "libphdi_handle_open_wide";
+	char *data_files_path_end                  = NULL;
+	char *disk_descriptor_xml_path             = NULL;
+	static char *function                      = "libphdi_handle_open";
 	size_t data_files_path_length              = 0;
 	size_t disk_descriptor_xml_path_size       = 0;
 	size_t filename_length                     = 0;
@@ -813,7 +1370,7 @@ int libphdi_handle_open_wide(
 
 		goto on_error;
 	}
-	is_directory = libcdirectory_directory_open_wide(
+	is_directory = libcdirectory_directory_open(
 	                directory,
 	                filename,
 	                NULL );
@@ -862,15 +1419,15 @@ int libphdi_handle_open_wide(
 #endif
 	if( is_directory == 1 )
 	{
-		filename_length = wide_string_length(
+		filename_length = narrow_string_length(
 		                   filename );
 
-		if( libcpath_path_join_wide(
+		if( libcpath_path_join(
 		     &disk_descriptor_xml_path,
 		     &disk_descriptor_xml_path_size,
 		     filename,
 		     filename_length,
-		     L"DiskDescriptor.xml",
+		     "DiskDescriptor.xml",
 		     19,
 		     error ) != 1 )
 		{
@@ -883,7 +1440,7 @@ int libphdi_handle_open_wide(
 
 			goto on_error;
 		}
-		if( libbfio_file_set_name_wide(
+		if( libbfio_file_set_name(
 		     file_io_handle,
 		     disk_descriptor_xml_path,
 		     disk_descriptor_xml_path_size - 1,
@@ -898,13 +1455,15 @@ int libphdi_handle_open_wide(
 
 			goto on_error;
 		}
+		filename        = disk_descriptor_xml_path;
+		filename_length = disk_descriptor_xml_path_size - 1;
 	}
 	else
 	{
-		filename_length = wide_string_length(
+		filename_length = narrow_string_length(
 		                   filename );
 
-		if( libbfio_file_set_name_wide(
+		if( libbfio_file_set_name(
 		     file_io_handle,
 		     filename,
 		     filename_length,
@@ -930,16 +1489,16 @@ int libphdi_handle_open_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open handle: %ls.",
+		 "%s: unable to open handle from file: %s.",
 		 function,
 		 filename );
 
 		goto on_error;
 	}
-	filename_length = wide_string_length(
+	filename_length = narrow_string_length(
 	                   filename );
 
-	data_files_path_end = wide_string_search_character_reverse(
+	data_files_path_end = narrow_string_search_character_reverse(
 	                       filename,
 	                       (int) LIBCPATH_SEPARATOR,
 	                       filename_length + 1 );
@@ -965,7 +1524,7 @@ int libphdi_handle_open_wide(
 			return( -1 );
 		}
 #endif
-		if( libphdi_data_files_set_path_wide(
+		if( libphdi_data_files_set_path(
 		     internal_handle->data_files,
 		     filename,
 		     data_files_path_length,
@@ -1028,22 +1587,27 @@ on_error:
 	return( -1 );
 }
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
 
-/* Opens a handle using a Basic File IO (bfio) handle
+/* Opens a handle
  * Returns 1 if successful or -1 on error
  */
-int libphdi_handle_open_file_io_handle(
+int libphdi_handle_open_wide(
      libphdi_handle_t *handle,
-     libbfio_handle_t *file_io_handle,
+     const wchar_t *filename,
      int access_flags,
      libcerror_error_t **error )
 {
+	libbfio_handle_t *file_io_handle           = NULL;
+	libcdirectory_directory_t *directory       = NULL;
 	libphdi_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libphdi_handle_open_file_io_handle";
-	uint8_t file_io_handle_opened_in_library   = 0;
-	int bfio_access_flags                      = 0;
-	int file_io_handle_is_open                 = 0;
+	wchar_t *data_files_path_end               = NULL;
+	wchar_t *disk_descriptor_xml_path          = NULL;
+	static char *function                      = "libphdi_handle_open_wide";
+	size_t data_files_path_length              = 0;
+	size_t disk_descriptor_xml_path_size       = 0;
+	size_t filename_length                     = 0;
+	int is_directory                           = 0;
 	int result                                 = 1;
 
 	if( handle == NULL )
@@ -1059,13 +1623,13 @@ int libphdi_handle_open_file_io_handle(
 	}
 	internal_handle = (libphdi_internal_handle_t *) handle;
 
-	if( file_io_handle == NULL )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file IO handle.",
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
@@ -1093,123 +1657,251 @@ int libphdi_handle_open_file_io_handle(
 
 		return( -1 );
 	}
-	if( ( access_flags & LIBPHDI_ACCESS_FLAG_READ ) != 0 )
+	if( libcdirectory_directory_initialize(
+	     &directory,
+	     error ) != 1 )
 	{
-		bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create directory.",
+		 function );
+
+		goto on_error;
 	}
-	file_io_handle_is_open = libbfio_handle_is_open(
-	                          file_io_handle,
-	                          error );
+	is_directory = libcdirectory_directory_open_wide(
+	                directory,
+	                filename,
+	                NULL );
 
-	if( file_io_handle_is_open == -1 )
+	if( libcdirectory_directory_free(
+	     &directory,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to determine if file IO handle is open.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free directory.",
 		 function );
 
 		goto on_error;
 	}
-	else if( file_io_handle_is_open == 0 )
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
-		if( libbfio_handle_open(
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libbfio_handle_set_track_offsets_read(
+	     file_io_handle,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set track offsets read in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( is_directory == 1 )
+	{
+		filename_length = wide_string_length(
+		                   filename );
+
+		if( libcpath_path_join_wide(
+		     &disk_descriptor_xml_path,
+		     &disk_descriptor_xml_path_size,
+		     filename,
+		     filename_length,
+		     L"DiskDescriptor.xml",
+		     19,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create DiskDescriptor.xml path.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_file_set_name_wide(
 		     file_io_handle,
-		     bfio_access_flags,
+		     disk_descriptor_xml_path,
+		     disk_descriptor_xml_path_size - 1,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to open file IO handle.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set filename in file IO handle.",
 			 function );
 
 			goto on_error;
 		}
-		file_io_handle_opened_in_library = 1;
 	}
-#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
-		 function );
+		filename_length = wide_string_length(
+		                   filename );
 
-		return( -1 );
+		if( libbfio_file_set_name_wide(
+		     file_io_handle,
+		     filename,
+		     filename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set filename in file IO handle.",
+			 function );
+
+			goto on_error;
+		}
 	}
-#endif
-	if( libphdi_internal_handle_open_read(
-	     internal_handle,
+	if( libphdi_handle_open_file_io_handle(
+	     handle,
 	     file_io_handle,
+	     access_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read from file IO handle.",
-		 function );
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle: %ls.",
+		 function,
+		 filename );
 
-		result = -1;
+		goto on_error;
 	}
-	else
+	filename_length = wide_string_length(
+	                   filename );
+
+	data_files_path_end = wide_string_search_character_reverse(
+	                       filename,
+	                       (int) LIBCPATH_SEPARATOR,
+	                       filename_length + 1 );
+
+	if( data_files_path_end != NULL )
 	{
-		internal_handle->file_io_handle                   = file_io_handle;
-		internal_handle->file_io_handle_opened_in_library = file_io_handle_opened_in_library;
-		internal_handle->access_flags                     = access_flags;
+		data_files_path_length = (size_t) ( data_files_path_end - filename );
 	}
+	if( data_files_path_length > 0 )
+	{
 #if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+		if( libcthreads_read_write_lock_grab_for_write(
+		     internal_handle->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( libphdi_data_files_set_path_wide(
+		     internal_handle->data_files,
+		     filename,
+		     data_files_path_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set data files path.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     internal_handle->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+	}
+	internal_handle->file_io_handle_created_in_library = 1;
+
+	if( disk_descriptor_xml_path != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
+		memory_free(
+		 disk_descriptor_xml_path );
 
-		return( -1 );
+		disk_descriptor_xml_path = NULL;
 	}
-#endif
 	return( result );
 
 on_error:
-	if( file_io_handle_opened_in_library != 0 )
+	if( file_io_handle != NULL )
 	{
-		libbfio_handle_close(
-		 file_io_handle,
-		 error );
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( disk_descriptor_xml_path != NULL )
+	{
+		memory_free(
+		 disk_descriptor_xml_path );
+	}
+	if( directory != NULL )
+	{
+		libcdirectory_directory_free(
+		 &directory,
+		 NULL );
 	}
 	return( -1 );
 }
 
-/* Opens the extent data files
- * If the extent data filenames were not set explicitly this function assumes the extent data files
- * are in the same location as the descriptor file
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Opens a handle using a Basic File IO (bfio) handle
  * Returns 1 if successful or -1 on error
  */
-int libphdi_handle_open_extent_data_files(
+int libphdi_handle_open_file_io_handle(
      libphdi_handle_t *handle,
+     libbfio_handle_t *file_io_handle,
+     int access_flags,
      libcerror_error_t **error )
 {
-	libbfio_pool_t *file_io_pool                  = NULL;
-	libphdi_image_values_t *image_values          = NULL;
-	libphdi_internal_handle_t *internal_handle    = NULL;
-	system_character_t *extent_data_file_location = NULL;
-	static char *function                         = "libphdi_handle_open_extent_data_files";
-	size_t extent_data_file_location_size         = 0;
-	int image_index                               = 0;
-	int number_of_images                          = 0;
-	int result                                    = 0;
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_open_file_io_handle";
+	uint8_t file_io_handle_opened_in_library   = 0;
+	int bfio_access_flags                      = 0;
+	int file_io_handle_is_open                 = 0;
+	int result                                 = 1;
 
 	if( handle == NULL )
 	{
@@ -1224,7 +1916,181 @@ int libphdi_handle_open_extent_data_files(
 	}
 	internal_handle = (libphdi_internal_handle_t *) handle;
 
-	if( ( ( internal_handle->access_flags & LIBPHDI_ACCESS_FLAG_READ ) == 0 )
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( access_flags & LIBPHDI_ACCESS_FLAG_READ ) == 0 )
+	 && ( ( access_flags & LIBPHDI_ACCESS_FLAG_WRITE ) == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & LIBPHDI_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & LIBPHDI_ACCESS_FLAG_READ ) != 0 )
+	{
+		bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
+	}
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to determine if file IO handle is open.",
+		 function );
+
+		goto on_error;
+	}
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     bfio_access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		file_io_handle_opened_in_library = 1;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->io_handle->abort = 0;
+
+	if( libphdi_internal_handle_open_read(
+	     internal_handle,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file IO handle.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_handle->file_io_handle                   = file_io_handle;
+		internal_handle->file_io_handle_opened_in_library = file_io_handle_opened_in_library;
+		internal_handle->access_flags                     = access_flags;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+	if( file_io_handle_opened_in_library != 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 error );
+	}
+	return( -1 );
+}
+
+/* Opens the extent data files
+ * If the extent data filenames were not set explicitly this function assumes the extent data files
+ * are in the same location as the descriptor file
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_open_extent_data_files(
+     libphdi_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libbfio_pool_t *file_io_pool                   = NULL;
+	libcdata_array_t *mapped_files_array           = NULL;
+	libphdi_image_values_t *image_values           = NULL;
+	libphdi_internal_handle_t *internal_handle     = NULL;
+	libphdi_data_cache_client_t *data_cache_client = NULL;
+	libphdi_mapped_file_t *mapped_file             = NULL;
+	system_character_t *extent_data_file_location  = NULL;
+#if defined( HAVE_MMAP ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	libcerror_error_t *mapped_file_error           = NULL;
+#endif
+	static char *function                          = "libphdi_handle_open_extent_data_files";
+	size64_t extent_data_file_size                 = 0;
+	size_t extent_data_file_location_size          = 0;
+	int image_index                                = 0;
+	int number_of_images                           = 0;
+	int result                                     = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( ( ( internal_handle->access_flags & LIBPHDI_ACCESS_FLAG_READ ) == 0 )
 	 && ( ( internal_handle->access_flags & LIBPHDI_ACCESS_FLAG_WRITE ) == 0 ) )
 	{
 		libcerror_error_set(
@@ -1324,6 +2190,41 @@ int libphdi_handle_open_extent_data_files(
 
 		goto on_error;
 	}
+	if( internal_handle->data_cache != NULL )
+	{
+		if( libphdi_data_cache_client_initialize(
+		     &data_cache_client,
+		     internal_handle->data_cache,
+		     number_of_images,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create data cache client.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( internal_handle->memory_map_extent_data_files != 0 )
+	{
+		if( libcdata_array_initialize(
+		     &mapped_files_array,
+		     number_of_images,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create mapped files array.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	for( image_index = 0;
 	     image_index < number_of_images;
 	     image_index++ )
@@ -1399,11 +2300,128 @@ int libphdi_handle_open_extent_data_files(
 
 			goto on_error;
 		}
+		if( data_cache_client != NULL )
+		{
+			if( libbfio_pool_get_size(
+			     file_io_pool,
+			     image_values->file_io_pool_entry,
+			     &extent_data_file_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to retrieve size of extent data file: %" PRIs_SYSTEM ".",
+				 function,
+				 extent_data_file_location );
+
+				goto on_error;
+			}
+			if( libphdi_data_cache_client_set_file(
+			     data_cache_client,
+			     image_values->file_io_pool_entry,
+			     (uint8_t *) extent_data_file_location,
+			     extent_data_file_location_size * sizeof( system_character_t ),
+			     extent_data_file_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set extent data file: %" PRIs_SYSTEM " in data cache client.",
+				 function,
+				 extent_data_file_location );
+
+				goto on_error;
+			}
+		}
+#if defined( HAVE_MMAP ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( mapped_files_array != NULL )
+		{
+			if( libphdi_mapped_file_initialize(
+			     &mapped_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create mapped file.",
+				 function );
+
+				goto on_error;
+			}
+			/* An extent data file that cannot be mapped, such as an empty file
+			 * or a file that does not fit in the address space, is left unmapped
+			 * and read through the file IO pool, the error is only reported in
+			 * debug output
+			 */
+			if( libphdi_mapped_file_open(
+			     mapped_file,
+			     extent_data_file_location,
+			     &mapped_file_error ) != 1 )
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: unable to map extent data file: %" PRIs_SYSTEM ".\n",
+					 function,
+					 extent_data_file_location );
+
+					libcnotify_print_error_backtrace(
+					 mapped_file_error );
+				}
+#endif
+				libcerror_error_free(
+				 &mapped_file_error );
+
+				if( libphdi_mapped_file_free(
+				     &mapped_file,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free mapped file.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			else if( libcdata_array_set_entry_by_index(
+			     mapped_files_array,
+			     image_values->file_io_pool_entry,
+			     (intptr_t *) mapped_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set mapped file: %d in array.",
+				 function,
+				 image_values->file_io_pool_entry );
+
+				goto on_error;
+			}
+			mapped_file = NULL;
+		}
+#endif /* defined( HAVE_MMAP ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
 		memory_free(
 		 extent_data_file_location );
 
 		extent_data_file_location = NULL;
 	}
+	/* The data cache client needs to be set before reading so that the data block cache
+	 * of the handle is not created
+	 */
+	internal_handle->data_cache_client = data_cache_client;
+
 	if( libphdi_internal_handle_open_read_extent_data_files(
 	     internal_handle,
 	     file_io_pool,
@@ -1420,6 +2438,7 @@ int libphdi_handle_open_extent_data_files(
 	}
 	internal_handle->extent_data_file_io_pool                    = file_io_pool;
 	internal_handle->extent_data_file_io_pool_created_in_library = 1;
+	internal_handle->mapped_files_array                          = mapped_files_array;
 
 #if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -1439,6 +2458,27 @@ int libphdi_handle_open_extent_data_files(
 	return( 1 );
 
 on_error:
+	if( data_cache_client != NULL )
+	{
+		internal_handle->data_cache_client = NULL;
+
+		libphdi_data_cache_client_free(
+		 &data_cache_client,
+		 NULL );
+	}
+	if( mapped_file != NULL )
+	{
+		libphdi_mapped_file_free(
+		 &mapped_file,
+		 NULL );
+	}
+	if( mapped_files_array != NULL )
+	{
+		libcdata_array_free(
+		 &mapped_files_array,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_mapped_file_free,
+		 NULL );
+	}
 	if( file_io_pool != NULL )
 	{
 		libbfio_pool_close_all(
@@ -1702,6 +2742,11 @@ int libphdi_handle_open_extent_data_file(
 
 		goto on_error;
 	}
+	libphdi_statistics_add_value(
+	 internal_handle->statistics,
+	 LIBPHDI_STATISTIC_NUMBER_OF_FILE_IO_HANDLE_OPENS,
+	 1 );
+
 	return( 1 );
 
 on_error:
@@ -1835,6 +2880,11 @@ int libphdi_handle_open_extent_data_file_wide(
 
 		goto on_error;
 	}
+	libphdi_statistics_add_value(
+	 internal_handle->statistics,
+	 LIBPHDI_STATISTIC_NUMBER_OF_FILE_IO_HANDLE_OPENS,
+	 1 );
+
 	return( 1 );
 
 on_error:
@@ -1873,6 +2923,23 @@ int libphdi_handle_close(
 	}
 	internal_handle = (libphdi_internal_handle_t *) handle;
 
+	if( internal_handle->parent_handle != NULL )
+	{
+		result = libphdi_internal_handle_close_clone(
+		          internal_handle,
+		          error );
+
+		if( result != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close clone.",
+			 function );
+		}
+		return( result );
+	}
 	if( internal_handle->file_io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -1899,6 +2966,40 @@ int libphdi_handle_close(
 		return( -1 );
 	}
 #endif
+	if( internal_handle->number_of_borrowed_buffers != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - %" PRIu64 " borrowed buffers have not been released.",
+		 function,
+		 internal_handle->number_of_borrowed_buffers );
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+#endif
+		return( -1 );
+	}
+	if( internal_handle->number_of_clones != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - %d clones have not been freed.",
+		 function,
+		 internal_handle->number_of_clones );
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+#endif
+		return( -1 );
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -1989,6 +3090,24 @@ int libphdi_handle_close(
 	internal_handle->extent_data_file_io_pool = NULL;
 	internal_handle->current_offset           = 0;
 
+	if( internal_handle->mapped_files_array != NULL )
+	{
+		if( libcdata_array_free(
+		     &( internal_handle->mapped_files_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_mapped_file_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mapped files array.",
+			 function );
+
+			result = -1;
+		}
+	}
+
 	if( libphdi_io_handle_clear(
 	     internal_handle->io_handle,
 	     error ) != 1 )
@@ -2028,15 +3147,31 @@ int libphdi_handle_close(
 
 		result = -1;
 	}
-	if( libfdata_vector_free(
-	     &( internal_handle->data_block_vector ),
+	if( internal_handle->metadata_index != NULL )
+	{
+		if( libphdi_metadata_index_clear(
+		     internal_handle->metadata_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to clear metadata index.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libphdi_layer_map_free(
+	     &( internal_handle->layer_map ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free data block vector.",
+		 "%s: unable to free layer map.",
 		 function );
 
 		result = -1;
@@ -2054,6 +3189,49 @@ int libphdi_handle_close(
 
 		result = -1;
 	}
+	if( libphdi_data_cache_client_free(
+	     &( internal_handle->data_cache_client ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free data cache client.",
+		 function );
+
+		result = -1;
+	}
+	if( libphdi_statistics_reset(
+	     internal_handle->statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to reset statistics.",
+		 function );
+
+		result = -1;
+	}
+
+	if( internal_handle->readahead != NULL )
+	{
+		if( libphdi_readahead_clear(
+		     internal_handle->readahead,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to clear readahead.",
+			 function );
+
+			result = -1;
+		}
+	}
 #if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -2089,6 +3267,7 @@ int libphdi_internal_handle_open_read(
 	int image_index                                              = 0;
 	int number_of_extents                                        = 0;
 	int number_of_images                                         = 0;
+	int result                                                   = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -2101,24 +3280,24 @@ int libphdi_internal_handle_open_read(
 
 		return( -1 );
 	}
-	if( internal_handle->disk_parameters != NULL )
+	if( internal_handle->extent_values_array == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - disk parameters value already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent values array.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->data_block_vector != NULL )
+	if( internal_handle->disk_parameters != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - data block vector value already set.",
+		 "%s: invalid handle - disk parameters value already set.",
 		 function );
 
 		return( -1 );
@@ -2134,40 +3313,6 @@ int libphdi_internal_handle_open_read(
 
 		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "Reading Disk descriptor XML file:\n" );
-	}
-#endif
-	if( libphdi_disk_descriptor_xml_file_initialize(
-	     &disk_descriptor_xml_file,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create disk descriptor XML file.",
-		 function );
-
-		goto on_error;
-	}
-	if( libphdi_disk_descriptor_xml_file_read_file_io_handle(
-	     disk_descriptor_xml_file,
-	     file_io_handle,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read disk descriptor XML file.",
-		 function );
-
-		goto on_error;
-	}
 	if( libphdi_disk_parameters_initialize(
 	     &( internal_handle->disk_parameters ),
 	     error ) != 1 )
@@ -2181,146 +3326,202 @@ int libphdi_internal_handle_open_read(
 
 		goto on_error;
 	}
-	if( libphdi_disk_descriptor_xml_file_get_disk_parameters(
-	     disk_descriptor_xml_file,
-	     internal_handle->disk_parameters,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve disk parameters from disk descriptor XML file.",
-		 function );
-
-		goto on_error;
-	}
-	if( libphdi_disk_descriptor_xml_file_get_storage_data(
-	     disk_descriptor_xml_file,
-	     internal_handle->extent_values_array,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve storage data from disk descriptor XML file.",
-		 function );
-
-		goto on_error;
-	}
-	if( libphdi_disk_descriptor_xml_file_get_disk_type(
-	     disk_descriptor_xml_file,
-	     &( internal_handle->disk_type ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve disk type from disk descriptor XML file.",
-		 function );
-
-		goto on_error;
-	}
-	if( libphdi_disk_descriptor_xml_file_get_snapshots(
-	     disk_descriptor_xml_file,
-	     internal_handle->snapshot_values_array,
-	     error ) != 1 )
+	if( internal_handle->metadata_index != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve snapshots from disk descriptor XML file.",
-		 function );
+		result = libphdi_internal_handle_read_metadata_index(
+		          internal_handle,
+		          file_io_handle,
+		          error );
 
-		goto on_error;
-	}
-	if( libphdi_disk_descriptor_xml_file_free(
-	     &disk_descriptor_xml_file,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free disk descriptor XML file.",
-		 function );
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read metadata index.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
-	if( libcdata_array_get_number_of_entries(
-	     internal_handle->extent_values_array,
-	     &number_of_extents,
-	     error ) != 1 )
+	if( result == 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of extents.",
-		 function );
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "Reading Disk descriptor XML file:\n" );
+		}
+#endif
+		if( libphdi_disk_descriptor_xml_file_initialize(
+		     &disk_descriptor_xml_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create disk descriptor XML file.",
+			 function );
 
-		goto on_error;
-	}
-	if( number_of_extents == 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid number of extents value out of bounds.",
-		 function );
+			goto on_error;
+		}
+		if( libphdi_disk_descriptor_xml_file_read_file_io_handle(
+		     disk_descriptor_xml_file,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read disk descriptor XML file.",
+			 function );
 
-		goto on_error;
-	}
-	for( extent_index = 0;
-	     extent_index < number_of_extents;
-	     extent_index++ )
-	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_handle->extent_values_array,
-		     extent_index,
-		     (intptr_t **) &extent_values,
+			goto on_error;
+		}
+		if( libphdi_disk_descriptor_xml_file_get_disk_parameters(
+		     disk_descriptor_xml_file,
+		     internal_handle->disk_parameters,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve extent values: %d from array.",
-			 function,
-			 extent_index );
+			 "%s: unable to retrieve disk parameters from disk descriptor XML file.",
+			 function );
 
 			goto on_error;
 		}
-		if( libphdi_extent_values_get_number_of_images(
-		     extent_values,
-		     &number_of_images,
+		if( libphdi_disk_descriptor_xml_file_get_storage_data(
+		     disk_descriptor_xml_file,
+		     internal_handle->extent_values_array,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of extents.",
+			 "%s: unable to retrieve storage data from disk descriptor XML file.",
 			 function );
 
 			goto on_error;
 		}
-		if( number_of_images == 0 )
+		if( libphdi_disk_descriptor_xml_file_get_disk_type(
+		     disk_descriptor_xml_file,
+		     &( internal_handle->disk_type ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid number of images value out of bounds.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve disk type from disk descriptor XML file.",
 			 function );
 
 			goto on_error;
 		}
-		for( image_index = 0;
+		if( libphdi_disk_descriptor_xml_file_get_snapshots(
+		     disk_descriptor_xml_file,
+		     internal_handle->snapshot_values_array,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve snapshots from disk descriptor XML file.",
+			 function );
+
+			goto on_error;
+		}
+		if( libphdi_disk_descriptor_xml_file_free(
+		     &disk_descriptor_xml_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free disk descriptor XML file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_handle->extent_values_array,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_extents == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of extents value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_handle->extent_values_array,
+		     extent_index,
+		     (intptr_t **) &extent_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent values: %d from array.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libphdi_extent_values_get_number_of_images(
+		     extent_values,
+		     &number_of_images,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of extents.",
+			 function );
+
+			goto on_error;
+		}
+		if( number_of_images == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of images value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		for( image_index = 0;
 		     image_index < number_of_images;
 		     image_index++ )
 		{
@@ -2375,12 +3576,6 @@ on_error:
 		 &( internal_handle->data_block_cache ),
 		 NULL );
 	}
-	if( internal_handle->data_block_vector != NULL )
-	{
-		libfdata_vector_free(
-		 &( internal_handle->data_block_vector ),
-		 NULL );
-	}
 	if( internal_handle->disk_parameters != NULL )
 	{
 		libphdi_disk_parameters_free(
@@ -2398,6 +3593,7 @@ int libphdi_internal_handle_open_read_extent_data_files(
      libbfio_pool_t *file_io_pool,
      libcerror_error_t **error )
 {
+	libcerror_error_t *metadata_index_error           = NULL;
 	libphdi_extent_values_t *extent_values            = NULL;
 	libphdi_image_values_t *image_values              = NULL;
 	libphdi_snapshot_values_t *parent_snapshot_values = NULL;
@@ -2405,6 +3601,7 @@ int libphdi_internal_handle_open_read_extent_data_files(
 	libphdi_storage_image_t *storage_image            = NULL;
 	static char *function                             = "libphdi_internal_handle_open_read_extent_data_files";
 	size64_t image_file_size                          = 0;
+	size64_t layer_map_block_size                     = 0;
 	int extent_index                                  = 0;
 	int image_index                                   = 0;
 	int image_type                                    = 0;
@@ -2413,6 +3610,7 @@ int libphdi_internal_handle_open_read_extent_data_files(
 	int number_of_images                              = 0;
 	int number_of_snapshots                           = 0;
 	int parent_snapshot_index                         = 0;
+	int result                                        = 0;
 	int snapshot_index                                = 0;
 
 	if( internal_handle == NULL )
@@ -2580,6 +3778,23 @@ int libphdi_internal_handle_open_read_extent_data_files(
 
 			goto on_error;
 		}
+		if( libphdi_extent_table_set_maximum_number_of_cached_extent_files(
+		     snapshot_values->extent_table,
+		     internal_handle->maximum_number_of_cached_extent_files,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of cached extent files.",
+			 function );
+
+			goto on_error;
+		}
+		snapshot_values->extent_table->statistics             = internal_handle->statistics;
+		snapshot_values->extent_table->storage_image_registry = internal_handle->storage_image_registry;
+
 		for( extent_index = 0;
 		     extent_index < number_of_extents;
 		     extent_index++ )
@@ -2702,6 +3917,95 @@ int libphdi_internal_handle_open_read_extent_data_files(
 			goto on_error;
 		}
 	}
+	if( internal_handle->metadata_index != NULL )
+	{
+		/* The metadata index is only used to speed up opening the image,
+		 * the error is only reported in debug output
+		 */
+		if( libphdi_internal_handle_update_metadata_index(
+		     internal_handle,
+		     file_io_pool,
+		     &metadata_index_error ) != 1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_print_error_backtrace(
+				 metadata_index_error );
+			}
+#endif
+			libcerror_error_free(
+			 &metadata_index_error );
+		}
+	}
+	if( libphdi_internal_handle_initialize_data_block_cache(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize data block cache.",
+		 function );
+
+		goto on_error;
+	}
+	/* A snapshot chain is resolved via the layer map to prevent a lookup per layer
+	 */
+	result = libphdi_internal_handle_get_layer_map_block_size(
+	          internal_handle,
+	          file_io_pool,
+	          &layer_map_block_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine layer map block size.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libphdi_layer_map_initialize(
+		     &( internal_handle->layer_map ),
+		     internal_handle->disk_parameters->media_size,
+		     layer_map_block_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create layer map.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( internal_handle->number_of_metadata_prefetch_threads > 0 )
+	{
+		if( libphdi_internal_handle_read_metadata(
+		     internal_handle,
+		     file_io_pool,
+		     internal_handle->number_of_metadata_prefetch_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to prefetch metadata.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
@@ -2714,252 +4018,7867 @@ on_error:
 	return( -1 );
 }
 
-/* Reads a block of data at a specific offset into a buffer using a Basic File IO (bfio) pool
- * Returns the number of bytes read or -1 on error
+/* Reads the disk descriptor XML file values from the metadata index
+ * The metadata index is only used if it matches the disk descriptor XML file
+ * Returns 1 if successful, 0 if the metadata index is missing or not valid or -1 on error
  */
-ssize_t libphdi_internal_handle_read_block_from_file_io_pool(
-         libphdi_snapshot_values_t *snapshot_values,
-         libbfio_pool_t *file_io_pool,
-         void *buffer,
-         size_t buffer_size,
-         off64_t file_offset,
-         int level,
-         libcerror_error_t **error )
+int libphdi_internal_handle_read_metadata_index(
+     libphdi_internal_handle_t *internal_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
 {
-	libphdi_block_descriptor_t *block_descriptor = NULL;
-	libphdi_storage_image_t *storage_image       = NULL;
-	static char *function                        = "libphdi_internal_handle_read_block_from_file_io_pool";
-	size64_t block_size                          = 0;
-	size_t read_size                             = 0;
-	ssize_t read_count                           = 0;
-	off64_t block_offset                         = 0;
-	off64_t storage_image_data_offset            = 0;
-	int extent_number                            = 0;
-	int result                                   = 0;
+	static char *function = "libphdi_internal_handle_read_metadata_index";
+	int result            = 0;
 
-	if( snapshot_values == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid snapshot values.",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( internal_handle->metadata_index == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing metadata index.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( libphdi_metadata_index_read_descriptor_file_io_handle(
+	     internal_handle->metadata_index,
+	     file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid element data size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read disk descriptor XML file checksum.",
+		 function );
+
+		return( -1 );
+	}
+	result = libphdi_metadata_index_read_file(
+	          internal_handle->metadata_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read metadata index file.",
 		 function );
 
 		return( -1 );
 	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
 		libcnotify_printf(
-		 "%s: requested offset: %" PRIi64 " (0x%08" PRIx64 ") at level: %d\n",
-		 function,
-		 file_offset,
-		 file_offset,
-		 level );
+		 "Reading metadata index:\n" );
 	}
 #endif
-	if( libphdi_extent_table_get_extent_file_at_offset(
-	     snapshot_values->extent_table,
-	     file_offset,
-	     file_io_pool,
-	     &extent_number,
-	     &storage_image_data_offset,
-	     &storage_image,
+	if( libphdi_metadata_index_get_disk_parameters(
+	     internal_handle->metadata_index,
+	     internal_handle->disk_parameters,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve disk parameters from metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libphdi_metadata_index_get_extents(
+	     internal_handle->metadata_index,
+	     internal_handle->extent_values_array,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extents from metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libphdi_metadata_index_get_disk_type(
+	     internal_handle->metadata_index,
+	     &( internal_handle->disk_type ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve disk type from metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libphdi_metadata_index_get_snapshots(
+	     internal_handle->metadata_index,
+	     internal_handle->snapshot_values_array,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve extent file at offset: %" PRIi64 " (0x%08" PRIx64 ") from extent table.",
-		 function,
-		 file_offset,
-		 file_offset );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve snapshots from metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Updates the metadata index after the extent data files were opened
+ * If the metadata index matches the extent data files the storage images are read from
+ * the metadata index, otherwise the metadata index file is (re)written
+ * On error the metadata index is cleared, so that it is not used
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_internal_handle_update_metadata_index(
+     libphdi_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	libphdi_image_values_t *image_values       = NULL;
+	libphdi_snapshot_values_t *snapshot_values = NULL;
+	static char *function                      = "libphdi_internal_handle_update_metadata_index";
+	int file_io_pool_entry                     = 0;
+	int image_index                            = 0;
+	int number_of_file_io_pool_entries         = 0;
+	int number_of_images                       = 0;
+	int number_of_snapshots                    = 0;
+	int result                                 = 0;
+	int snapshot_index                         = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->disk_parameters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing disk parameters.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->metadata_index->is_valid != 0 )
+	{
+		result = libphdi_metadata_index_validate_storage_images(
+		          internal_handle->metadata_index,
+		          file_io_pool,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to validate storage images of metadata index.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( result == 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "Writing metadata index:\n" );
+		}
+#endif
+		if( libphdi_metadata_index_set_values(
+		     internal_handle->metadata_index,
+		     internal_handle->disk_type,
+		     internal_handle->disk_parameters,
+		     internal_handle->extent_values_array,
+		     internal_handle->snapshot_values_array,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set values in metadata index.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_array_get_number_of_entries(
+		     internal_handle->image_values_array,
+		     &number_of_images,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of images.",
+			 function );
+
+			goto on_error;
+		}
+		for( image_index = 0;
+		     image_index < number_of_images;
+		     image_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_handle->image_values_array,
+			     image_index,
+			     (intptr_t **) &image_values,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve image values: %d from array.",
+				 function,
+				 image_index );
+
+				goto on_error;
+			}
+			if( image_values->file_io_pool_entry >= number_of_file_io_pool_entries )
+			{
+				number_of_file_io_pool_entries = image_values->file_io_pool_entry + 1;
+			}
+		}
+		/* The storage images are stored in order of their file IO pool entry,
+		 * images that share a file IO pool entry are stored once
+		 */
+		for( file_io_pool_entry = 0;
+		     file_io_pool_entry < number_of_file_io_pool_entries;
+		     file_io_pool_entry++ )
+		{
+			for( image_index = 0;
+			     image_index < number_of_images;
+			     image_index++ )
+			{
+				if( libcdata_array_get_entry_by_index(
+				     internal_handle->image_values_array,
+				     image_index,
+				     (intptr_t **) &image_values,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve image values: %d from array.",
+					 function,
+					 image_index );
+
+					goto on_error;
+				}
+				if( image_values->file_io_pool_entry == file_io_pool_entry )
+				{
+					break;
+				}
+			}
+			if( image_index >= number_of_images )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing image values for file IO pool entry: %d.",
+				 function,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+			if( libphdi_metadata_index_append_storage_image(
+			     internal_handle->metadata_index,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     image_values->type,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append storage image: %d to metadata index.",
+				 function,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+			if( internal_handle->io_handle->abort == 1 )
+			{
+				goto on_error;
+			}
+		}
+		if( libphdi_metadata_index_write_file(
+		     internal_handle->metadata_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write metadata index file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_handle->snapshot_values_array,
+	     &number_of_snapshots,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of snapshots.",
+		 function );
+
+		goto on_error;
+	}
+	for( snapshot_index = 0;
+	     snapshot_index < number_of_snapshots;
+	     snapshot_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_handle->snapshot_values_array,
+		     snapshot_index,
+		     (intptr_t **) &snapshot_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve snapshot values: %d from array.",
+			 function,
+			 snapshot_index );
+
+			goto on_error;
+		}
+		snapshot_values->extent_table->metadata_index = internal_handle->metadata_index;
+	}
+	return( 1 );
+
+on_error:
+	for( snapshot_index = 0;
+	     snapshot_index < number_of_snapshots;
+	     snapshot_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_handle->snapshot_values_array,
+		     snapshot_index,
+		     (intptr_t **) &snapshot_values,
+		     NULL ) == 1 )
+		{
+			snapshot_values->extent_table->metadata_index = NULL;
+		}
+	}
+	libphdi_metadata_index_clear(
+	 internal_handle->metadata_index,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Reads the storage image metadata of the snapshots
+ * The storage image file header and block allocation table of every extent that is not
+ * in the extent files cache are read, up to the maximum number of cached extent files
+ * per snapshot. With multi-thread support the storage images are read concurrently
+ * by a bounded number of worker threads. The workers only read at explicit offsets
+ * through the file IO pool, which reopens a handle that was closed because of the
+ * maximum number of open handles, hence no worker depends on a handle staying open
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_internal_handle_read_metadata(
+     libphdi_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libcdata_array_t *requests_array             = NULL;
+	libphdi_metadata_request_t *metadata_request = NULL;
+	libphdi_snapshot_values_t *snapshot_values   = NULL;
+	static char *function                        = "libphdi_internal_handle_read_metadata";
+	int entry_index                              = 0;
+	int extent_index                             = 0;
+	int number_of_extent_files                   = 0;
+	int number_of_requests                       = 0;
+	int number_of_snapshots                      = 0;
+	int request_index                            = 0;
+	int result                                   = 0;
+	int snapshot_index                           = 0;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *thread_pool       = NULL;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBPHDI_METADATA_PREFETCH_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_handle->snapshot_values_array,
+	     &number_of_snapshots,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of snapshots.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &requests_array,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create requests array.",
+		 function );
+
+		goto on_error;
+	}
+	for( snapshot_index = 0;
+	     snapshot_index < number_of_snapshots;
+	     snapshot_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_handle->snapshot_values_array,
+		     snapshot_index,
+		     (intptr_t **) &snapshot_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve snapshot values: %d from array.",
+			 function,
+			 snapshot_index );
+
+			goto on_error;
+		}
+		if( libphdi_extent_table_get_number_of_extent_files(
+		     snapshot_values->extent_table,
+		     &number_of_extent_files,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of extent files of snapshot: %d.",
+			 function,
+			 snapshot_index );
+
+			goto on_error;
+		}
+		/* Storage images beyond the maximum number of cached extent files
+		 * would evict the storage images that were read before
+		 */
+		if( number_of_extent_files > snapshot_values->extent_table->maximum_number_of_cached_extent_files )
+		{
+			number_of_extent_files = snapshot_values->extent_table->maximum_number_of_cached_extent_files;
+		}
+		for( extent_index = 0;
+		     extent_index < number_of_extent_files;
+		     extent_index++ )
+		{
+			result = libphdi_extent_table_has_extent_file(
+			          snapshot_values->extent_table,
+			          extent_index,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if extent file: %d of snapshot: %d is cached.",
+				 function,
+				 extent_index,
+				 snapshot_index );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				continue;
+			}
+			if( libphdi_metadata_request_initialize(
+			     &metadata_request,
+			     snapshot_values->extent_table,
+			     extent_index,
+			     file_io_pool,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create metadata request.",
+				 function );
+
+				goto on_error;
+			}
+			if( libcdata_array_append_entry(
+			     requests_array,
+			     &entry_index,
+			     (intptr_t *) metadata_request,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append metadata request to array.",
+				 function );
+
+				goto on_error;
+			}
+			metadata_request = NULL;
+		}
+	}
+	if( libcdata_array_get_number_of_entries(
+	     requests_array,
+	     &number_of_requests,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of metadata requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_threads > number_of_requests )
+	{
+		number_of_threads = number_of_requests;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( number_of_threads > 1 )
+	{
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     number_of_threads,
+		     LIBPHDI_METADATA_PREFETCH_MAXIMUM_NUMBER_OF_PENDING_REQUESTS,
+		     (int (*)(intptr_t *, void *)) &libphdi_internal_handle_metadata_request_callback,
+		     (void *) internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create metadata prefetch thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		for( request_index = 0;
+		     request_index < number_of_requests;
+		     request_index++ )
+		{
+			if( internal_handle->io_handle->abort != 0 )
+			{
+				break;
+			}
+			if( libcdata_array_get_entry_by_index(
+			     requests_array,
+			     request_index,
+			     (intptr_t **) &metadata_request,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve metadata request: %d from array.",
+				 function,
+				 request_index );
+
+				metadata_request = NULL;
+
+				goto on_error;
+			}
+			/* The push blocks while the maximum number of pending requests is reached
+			 */
+			if( libcthreads_thread_pool_push(
+			     thread_pool,
+			     (intptr_t *) metadata_request,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push metadata request: %d onto thread pool queue.",
+				 function,
+				 request_index );
+
+				metadata_request = NULL;
+
+				goto on_error;
+			}
+		}
+		metadata_request = NULL;
+
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join metadata prefetch thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#else
+	number_of_threads = 1;
+
+#endif /* defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT ) */
+
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			goto on_error;
+		}
+		if( libcdata_array_get_entry_by_index(
+		     requests_array,
+		     request_index,
+		     (intptr_t **) &metadata_request,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve metadata request: %d from array.",
+			 function,
+			 request_index );
+
+			metadata_request = NULL;
+
+			goto on_error;
+		}
+		/* Without worker threads the storage images are read here
+		 */
+		if( number_of_threads <= 1 )
+		{
+			if( libphdi_metadata_request_read(
+			     metadata_request,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read metadata request: %d.",
+				 function,
+				 request_index );
+
+				metadata_request = NULL;
+
+				goto on_error;
+			}
+		}
+		else if( metadata_request->result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read extent file: %d.",
+			 function,
+			 metadata_request->extent_index );
+
+			metadata_request = NULL;
+
+			goto on_error;
+		}
+		if( libphdi_extent_table_set_extent_file(
+		     metadata_request->extent_table,
+		     metadata_request->extent_index,
+		     metadata_request->storage_image,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set extent file: %d.",
+			 function,
+			 metadata_request->extent_index );
+
+			metadata_request = NULL;
+
+			goto on_error;
+		}
+		metadata_request->storage_image = NULL;
+
+		libphdi_statistics_add_value(
+		 internal_handle->statistics,
+		 LIBPHDI_STATISTIC_EXTENT_FILES_CACHE_MISSES,
+		 1 );
+	}
+	metadata_request = NULL;
+
+	if( libcdata_array_free(
+	     &requests_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_metadata_request_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free requests array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+#endif
+	if( metadata_request != NULL )
+	{
+		libphdi_metadata_request_free(
+		 &metadata_request,
+		 NULL );
+	}
+	if( requests_array != NULL )
+	{
+		libcdata_array_free(
+		 &requests_array,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_metadata_request_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a range of blocks of data at a specific offset into a buffer using a Basic File IO (bfio) pool
+ * Consecutive blocks that are stored contiguously in the same file are read at once,
+ * consecutive sparse blocks are filled or read from the parent snapshot at once
+ * This function does not use shared seek state and can be called with the read lock
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libphdi_internal_handle_read_block_from_file_io_pool(
+         libphdi_internal_handle_t *internal_handle,
+         libphdi_snapshot_values_t *snapshot_values,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t file_offset,
+         int level,
+         libcerror_error_t **error )
+{
+	static char *function     = "libphdi_internal_handle_read_block_from_file_io_pool";
+	size64_t range_size       = 0;
+	size_t buffer_offset      = 0;
+	size_t read_size          = 0;
+	ssize_t read_count        = 0;
+	off64_t range_file_offset = 0;
+	int file_io_pool_entry    = 0;
+	int result                = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( snapshot_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid snapshot values.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: requested offset: %" PRIi64 " (0x%08" PRIx64 ") at level: %d\n",
+		 function,
+		 file_offset,
+		 file_offset,
+		 level );
+	}
+#endif
+	result = libphdi_extent_table_get_block_range_at_offset(
+	          snapshot_values->extent_table,
+	          file_offset,
+	          file_io_pool,
+	          (size64_t) buffer_size,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block range at offset: %" PRIi64 " (0x%08" PRIx64 ") from extent table.",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	LIBPHDI_PROBE6(
+	 block__resolve,
+	 (int64_t) file_offset,
+	 level,
+	 result,
+	 file_io_pool_entry,
+	 (int64_t) range_file_offset,
+	 (uint64_t) range_size );
+
+	read_size = (size_t) range_size;
+
+	if( result != 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading from file IO pool entry: %d\n",
+			 function,
+			 file_io_pool_entry );
+
+			libcnotify_printf(
+			 "%s: reading from offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIzd "\n",
+			 function,
+			 range_file_offset,
+			 range_file_offset,
+			 read_size );
+		}
+#endif
+		read_count = libphdi_statistics_read_buffer_at_offset(
+		              internal_handle->statistics,
+		              file_io_pool,
+		              file_io_pool_entry,
+		              (uint8_t *) buffer,
+		              read_size,
+		              range_file_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data from file IO pool entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 file_io_pool_entry,
+			 range_file_offset,
+			 range_file_offset );
+
+			return( -1 );
+		}
+		libphdi_statistics_add_snapshot_depth_value(
+		 internal_handle->statistics,
+		 level,
+		 (uint64_t) read_size );
+	}
+	else if( snapshot_values->parent_snapshot_values != NULL )
+	{
+		LIBPHDI_PROBE3(
+		 block__parent,
+		 (int64_t) file_offset,
+		 level,
+		 (uint64_t) read_size );
+
+		/* The parent snapshot can be stored with a different layout
+		 * hence the sparse range is read in one or more parts
+		 */
+		while( buffer_offset < read_size )
+		{
+			read_count = libphdi_internal_handle_read_block_from_file_io_pool(
+				      internal_handle,
+				      snapshot_values->parent_snapshot_values,
+			              file_io_pool,
+				      &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				      read_size - buffer_offset,
+				      file_offset + (off64_t) buffer_offset,
+				      level + 1,
+				      error );
+
+			if( read_count <= 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer from parent snapshot at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 file_offset + (off64_t) buffer_offset,
+				 file_offset + (off64_t) buffer_offset );
+
+				return( -1 );
+			}
+			buffer_offset += (size_t) read_count;
+		}
+	}
+	else
+	{
+		LIBPHDI_PROBE3(
+		 block__sparse,
+		 (int64_t) file_offset,
+		 level,
+		 (uint64_t) read_size );
+
+		if( memory_set(
+		     buffer,
+		     0,
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to fill buffer with sparse blocks.",
+			 function );
+
+			return( -1 );
+		}
+		libphdi_statistics_add_value(
+		 internal_handle->statistics,
+		 LIBPHDI_STATISTIC_SPARSE_BYTES_READ,
+		 (uint64_t) read_size );
+	}
+	return( (ssize_t) read_size );
+}
+
+/* Determines the block size of the layer map
+ * The block size is the least common multiple of the block sizes of the snapshots in the chain,
+ * so that every block of the layer map is resolved by whole storage image blocks
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if no layer map should be used or -1 on error
+ */
+int libphdi_internal_handle_get_layer_map_block_size(
+     libphdi_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     size64_t *block_size,
+     libcerror_error_t **error )
+{
+	libphdi_snapshot_values_t *snapshot_values = NULL;
+	static char *function                      = "libphdi_internal_handle_get_layer_map_block_size";
+	size64_t greatest_common_divisor           = 0;
+	size64_t remainder                         = 0;
+	size64_t safe_block_size                   = 0;
+	size64_t snapshot_block_size               = 0;
+	size64_t value                             = 0;
+	int number_of_snapshots                    = 0;
+	int result                                 = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->disk_type != LIBPHDI_DISK_TYPE_EXPANDING )
+	{
+		return( 0 );
+	}
+	for( snapshot_values = internal_handle->current_snapshot_values;
+	     snapshot_values != NULL;
+	     snapshot_values = snapshot_values->parent_snapshot_values )
+	{
+		number_of_snapshots++;
+	}
+	/* A single snapshot is resolved by a single lookup
+	 */
+	if( number_of_snapshots <= 1 )
+	{
+		return( 0 );
+	}
+	for( snapshot_values = internal_handle->current_snapshot_values;
+	     snapshot_values != NULL;
+	     snapshot_values = snapshot_values->parent_snapshot_values )
+	{
+		result = libphdi_extent_table_get_block_size(
+		          snapshot_values->extent_table,
+		          file_io_pool,
+		          &snapshot_block_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block size of snapshot.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		if( safe_block_size == 0 )
+		{
+			safe_block_size = snapshot_block_size;
+		}
+		else
+		{
+			/* Determine the greatest common divisor
+			 */
+			greatest_common_divisor = safe_block_size;
+			remainder               = snapshot_block_size;
+
+			while( remainder != 0 )
+			{
+				value                   = greatest_common_divisor % remainder;
+				greatest_common_divisor = remainder;
+				remainder               = value;
+			}
+			value = safe_block_size / greatest_common_divisor;
+
+			if( value > ( LIBPHDI_LAYER_MAP_MAXIMUM_BLOCK_SIZE / snapshot_block_size ) )
+			{
+				return( 0 );
+			}
+			safe_block_size = value * snapshot_block_size;
+		}
+		if( safe_block_size > LIBPHDI_LAYER_MAP_MAXIMUM_BLOCK_SIZE )
+		{
+			return( 0 );
+		}
+	}
+	*block_size = safe_block_size;
+
+	return( 1 );
+}
+
+/* Initializes the data block cache
+ * The data block cache is not created when the handle uses the shared data cache
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_internal_handle_initialize_data_block_cache(
+     libphdi_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function          = "libphdi_internal_handle_initialize_data_block_cache";
+	size64_t maximum_cache_entries = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->data_block_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - data block cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->data_block_cache_size == 0 )
+	 || ( internal_handle->data_cache_client != NULL ) )
+	{
+		return( 1 );
+	}
+	maximum_cache_entries = internal_handle->data_block_cache_size / LIBPHDI_DATA_BLOCK_SIZE;
+
+	if( maximum_cache_entries == 0 )
+	{
+		maximum_cache_entries = 1;
+	}
+	else if( maximum_cache_entries > (size64_t) INT_MAX )
+	{
+		maximum_cache_entries = (size64_t) INT_MAX;
+	}
+	if( libfcache_cache_initialize(
+	     &( internal_handle->data_block_cache ),
+	     (int) maximum_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data block cache.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a copy of the cached data of a data block
+ * The data block cache is direct mapped, a data block is stored in the cache entry
+ * that corresponds with the data block number
+ * The data block cache is not modified by the lookup hence the data block cache read/write lock
+ * for reading is sufficient, cache entries are only replaced with the lock for writing
+ * This function is not multi-thread safe acquire data block cache read/write lock before call
+ * Returns the number of bytes copied, 0 if not cached or -1 on error
+ */
+ssize_t libphdi_internal_handle_copy_from_data_block_cache(
+         libphdi_internal_handle_t *internal_handle,
+         int cache_entry_index,
+         off64_t data_block_offset,
+         size_t data_offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value = NULL;
+	libphdi_data_block_t *data_block     = NULL;
+	static char *function                = "libphdi_internal_handle_copy_from_data_block_cache";
+	off64_t cache_value_offset           = 0;
+	int64_t cache_value_timestamp        = 0;
+	int cache_value_file_index           = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_get_value_by_index(
+	     internal_handle->data_block_cache,
+	     cache_entry_index,
+	     &cache_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache entry: %d from data block cache.",
+		 function,
+		 cache_entry_index );
+
+		return( -1 );
+	}
+	if( cache_value == NULL )
+	{
+		return( 0 );
+	}
+	if( libfcache_cache_value_get_identifier(
+	     cache_value,
+	     &cache_value_file_index,
+	     &cache_value_offset,
+	     &cache_value_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache value identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( cache_value_offset != data_block_offset )
+	{
+		return( 0 );
+	}
+	if( libfcache_cache_value_get_value(
+	     cache_value,
+	     (intptr_t **) &data_block,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data block from cache value.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_block == NULL )
+	{
+		return( 0 );
+	}
+	return( libphdi_data_block_copy_data(
+	         data_block,
+	         data_offset,
+	         buffer,
+	         buffer_size,
+	         error ) );
+}
+
+/* Reads (media) data of a single data block at a specific offset into a buffer
+ * The data block is read via the data block cache and the I/O of a cache miss
+ * is done without holding the data block cache lock
+ * This function does not use shared seek state and can be called with the read lock
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libphdi_internal_handle_read_data_block_from_file_io_pool(
+         libphdi_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libphdi_data_block_t *data_block = NULL;
+	static char *function            = "libphdi_internal_handle_read_data_block_from_file_io_pool";
+	size64_t data_block_size         = 0;
+	size_t data_offset               = 0;
+	ssize_t read_count               = 0;
+	off64_t data_block_offset        = 0;
+	int cache_entry_index            = 0;
+	int number_of_cache_entries      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->disk_parameters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing disk parameters.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->data_block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing data block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= internal_handle->disk_parameters->media_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     internal_handle->data_block_cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of data block cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of data block cache entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset       = (size_t) ( offset % LIBPHDI_DATA_BLOCK_SIZE );
+	data_block_offset = offset - (off64_t) data_offset;
+	cache_entry_index = (int) ( ( data_block_offset / LIBPHDI_DATA_BLOCK_SIZE ) % number_of_cache_entries );
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->data_block_cache_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab data block cache read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libphdi_internal_handle_copy_from_data_block_cache(
+	              internal_handle,
+	              cache_entry_index,
+	              data_block_offset,
+	              data_offset,
+	              buffer,
+	              buffer_size,
+	              error );
+
+	if( read_count > 0 )
+	{
+		libphdi_statistics_add_value(
+		 internal_handle->statistics,
+		 LIBPHDI_STATISTIC_DATA_BLOCK_CACHE_HITS,
+		 1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->data_block_cache_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release data block cache read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to copy data block: %" PRIi64 " (0x%08" PRIx64 ") from cache.",
+		 function,
+		 data_block_offset,
+		 data_block_offset );
+
+		return( -1 );
+	}
+	else if( read_count > 0 )
+	{
+		return( read_count );
+	}
+	/* The last data block can be smaller than the data block size
+	 */
+	data_block_size = internal_handle->disk_parameters->media_size - (size64_t) data_block_offset;
+
+	if( data_block_size > LIBPHDI_DATA_BLOCK_SIZE )
+	{
+		data_block_size = LIBPHDI_DATA_BLOCK_SIZE;
+	}
+	if( libphdi_data_block_initialize(
+	     &data_block,
+	     (size_t) data_block_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data block.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libphdi_internal_handle_read_data_from_file_io_pool(
+	              internal_handle,
+	              file_io_pool,
+	              data_block->data,
+	              data_block->data_size,
+	              data_block_offset,
+	              error );
+
+	if( read_count != (ssize_t) data_block->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 data_block_offset,
+		 data_block_offset );
+
+		goto on_error;
+	}
+	read_count = libphdi_data_block_copy_data(
+	              data_block,
+	              data_offset,
+	              buffer,
+	              buffer_size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy data block data.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->data_block_cache_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab data block cache read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	/* The cache takes over management of the data block
+	 */
+	if( libfcache_cache_set_value_by_index(
+	     internal_handle->data_block_cache,
+	     cache_entry_index,
+	     0,
+	     data_block_offset,
+	     0,
+	     (intptr_t *) data_block,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_data_block_free,
+	     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set data block in cache entry: %d.",
+		 function,
+		 cache_entry_index );
+
+		read_count = -1;
+	}
+	else
+	{
+		data_block = NULL;
+
+		libphdi_statistics_add_value(
+		 internal_handle->statistics,
+		 LIBPHDI_STATISTIC_DATA_BLOCK_CACHE_MISSES,
+		 1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->data_block_cache_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release data block cache read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( read_count == -1 )
+	{
+		goto on_error;
+	}
+	return( read_count );
+
+on_error:
+	if( data_block != NULL )
+	{
+		libphdi_data_block_free(
+		 &data_block,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data of a single data block at a specific offset into a buffer
+ * The data block is read via the shared data cache, which caches data by extent data file
+ * and offset. Only data blocks that are stored contiguously in a single extent data file
+ * are cached, other data blocks are read directly
+ * This function does not use shared seek state and can be called with the read lock
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libphdi_internal_handle_read_data_block_from_data_cache(
+         libphdi_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libphdi_data_block_t *data_block = NULL;
+	static char *function            = "libphdi_internal_handle_read_data_block_from_data_cache";
+	size64_t data_block_size         = 0;
+	size64_t range_size              = 0;
+	size_t data_offset               = 0;
+	size_t read_size                 = 0;
+	ssize_t read_count               = 0;
+	off64_t data_block_offset        = 0;
+	off64_t range_file_offset        = 0;
+	int file_io_pool_entry           = 0;
+	int result                       = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->disk_parameters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing disk parameters.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_snapshot_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing current snapshot values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->data_cache_client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing data cache client.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= internal_handle->disk_parameters->media_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset       = (size_t) ( offset % LIBPHDI_DATA_BLOCK_SIZE );
+	data_block_offset = offset - (off64_t) data_offset;
+
+	/* The last data block can be smaller than the data block size
+	 */
+	data_block_size = internal_handle->disk_parameters->media_size - (size64_t) data_block_offset;
+
+	if( data_block_size > LIBPHDI_DATA_BLOCK_SIZE )
+	{
+		data_block_size = LIBPHDI_DATA_BLOCK_SIZE;
+	}
+	read_size = (size_t) data_block_size - data_offset;
+
+	if( read_size > buffer_size )
+	{
+		read_size = buffer_size;
+	}
+	result = libphdi_internal_handle_get_data_range_at_offset(
+	          internal_handle,
+	          file_io_pool,
+	          data_block_offset,
+	          data_block_size,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 data_block_offset,
+		 data_block_offset );
+
+		return( -1 );
+	}
+	if( ( result == 0 )
+	 || ( range_size < data_block_size ) )
+	{
+		return( libphdi_internal_handle_read_data_from_file_io_pool(
+		         internal_handle,
+		         file_io_pool,
+		         buffer,
+		         read_size,
+		         offset,
+		         error ) );
+	}
+	read_count = libphdi_data_cache_client_copy_data(
+	              internal_handle->data_cache_client,
+	              file_io_pool_entry,
+	              range_file_offset,
+	              data_offset,
+	              buffer,
+	              read_size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to copy data block: %" PRIi64 " (0x%08" PRIx64 ") from data cache.",
+		 function,
+		 data_block_offset,
+		 data_block_offset );
+
+		return( -1 );
+	}
+	else if( read_count > 0 )
+	{
+		libphdi_statistics_add_value(
+		 internal_handle->statistics,
+		 LIBPHDI_STATISTIC_DATA_BLOCK_CACHE_HITS,
+		 1 );
+
+		return( read_count );
+	}
+	libphdi_statistics_add_value(
+	 internal_handle->statistics,
+	 LIBPHDI_STATISTIC_DATA_BLOCK_CACHE_MISSES,
+	 1 );
+
+	if( libphdi_data_block_initialize(
+	     &data_block,
+	     (size_t) data_block_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data block.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libphdi_internal_handle_read_data_from_file_io_pool(
+	              internal_handle,
+	              file_io_pool,
+	              data_block->data,
+	              data_block->data_size,
+	              data_block_offset,
+	              error );
+
+	if( read_count != (ssize_t) data_block->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 data_block_offset,
+		 data_block_offset );
+
+		goto on_error;
+	}
+	read_count = libphdi_data_block_copy_data(
+	              data_block,
+	              data_offset,
+	              buffer,
+	              read_size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy data block data.",
+		 function );
+
+		goto on_error;
+	}
+	/* The data cache takes over management of the data block
+	 */
+	if( libphdi_data_cache_client_insert_data_block(
+	     internal_handle->data_cache_client,
+	     file_io_pool_entry,
+	     range_file_offset,
+	     &data_block,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to insert data block: %" PRIi64 " (0x%08" PRIx64 ") into data cache.",
+		 function,
+		 data_block_offset,
+		 data_block_offset );
+
+		goto on_error;
+	}
+	return( read_count );
+
+on_error:
+	if( data_block != NULL )
+	{
+		libphdi_data_block_free(
+		 &data_block,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data of multiple whole data blocks at a specific offset into a buffer
+ * The leading data blocks that are not in the shared data cache are read directly with
+ * a single read and added to the shared data cache afterwards. Reading stops after the
+ * first data block that is cached, which is copied from the shared data cache
+ * The offset must be aligned with the data block size and the buffer size must be
+ * a multiple of the data block size that does not exceed the (media) data
+ * This function does not use shared seek state and can be called with the read lock
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libphdi_internal_handle_read_data_blocks_from_data_cache(
+         libphdi_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libphdi_data_block_t *data_block = NULL;
+	static char *function            = "libphdi_internal_handle_read_data_blocks_from_data_cache";
+	size64_t range_size              = 0;
+	size_t buffer_offset             = 0;
+	size_t uncached_size             = 0;
+	ssize_t cached_read_count        = 0;
+	ssize_t read_count               = 0;
+	off64_t data_block_offset        = 0;
+	off64_t range_file_offset        = 0;
+	int file_io_pool_entry           = 0;
+	int result                       = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->disk_parameters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing disk parameters.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->data_cache_client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing data cache client.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX )
+	 || ( ( buffer_size % LIBPHDI_DATA_BLOCK_SIZE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( ( offset % LIBPHDI_DATA_BLOCK_SIZE ) != 0 )
+	 || ( (size64_t) buffer_size > internal_handle->disk_parameters->media_size )
+	 || ( (size64_t) offset > ( internal_handle->disk_parameters->media_size - buffer_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Sparse data blocks and data blocks that are not stored contiguously are not cached
+	 * but are read directly together with the other uncached data blocks
+	 */
+	while( uncached_size < buffer_size )
+	{
+		data_block_offset = offset + (off64_t) uncached_size;
+
+		result = libphdi_internal_handle_get_data_range_at_offset(
+		          internal_handle,
+		          file_io_pool,
+		          data_block_offset,
+		          LIBPHDI_DATA_BLOCK_SIZE,
+		          &file_io_pool_entry,
+		          &range_file_offset,
+		          &range_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 data_block_offset,
+			 data_block_offset );
+
+			return( -1 );
+		}
+		if( ( result != 0 )
+		 && ( range_size == LIBPHDI_DATA_BLOCK_SIZE ) )
+		{
+			cached_read_count = libphdi_data_cache_client_copy_data(
+			                     internal_handle->data_cache_client,
+			                     file_io_pool_entry,
+			                     range_file_offset,
+			                     0,
+			                     &( buffer[ uncached_size ] ),
+			                     LIBPHDI_DATA_BLOCK_SIZE,
+			                     error );
+
+			if( cached_read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to copy data block: %" PRIi64 " (0x%08" PRIx64 ") from data cache.",
+				 function,
+				 data_block_offset,
+				 data_block_offset );
+
+				return( -1 );
+			}
+			else if( cached_read_count > 0 )
+			{
+				libphdi_statistics_add_value(
+				 internal_handle->statistics,
+				 LIBPHDI_STATISTIC_DATA_BLOCK_CACHE_HITS,
+				 1 );
+
+				break;
+			}
+			libphdi_statistics_add_value(
+			 internal_handle->statistics,
+			 LIBPHDI_STATISTIC_DATA_BLOCK_CACHE_MISSES,
+			 1 );
+		}
+		uncached_size += LIBPHDI_DATA_BLOCK_SIZE;
+	}
+	if( uncached_size == 0 )
+	{
+		return( cached_read_count );
+	}
+	read_count = libphdi_internal_handle_read_data_from_file_io_pool(
+	              internal_handle,
+	              file_io_pool,
+	              buffer,
+	              uncached_size,
+	              offset,
+	              error );
+
+	if( read_count != (ssize_t) uncached_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data blocks at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	for( buffer_offset = 0;
+	     buffer_offset < uncached_size;
+	     buffer_offset += LIBPHDI_DATA_BLOCK_SIZE )
+	{
+		data_block_offset = offset + (off64_t) buffer_offset;
+
+		result = libphdi_internal_handle_get_data_range_at_offset(
+		          internal_handle,
+		          file_io_pool,
+		          data_block_offset,
+		          LIBPHDI_DATA_BLOCK_SIZE,
+		          &file_io_pool_entry,
+		          &range_file_offset,
+		          &range_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 data_block_offset,
+			 data_block_offset );
+
+			goto on_error;
+		}
+		if( ( result == 0 )
+		 || ( range_size < LIBPHDI_DATA_BLOCK_SIZE ) )
+		{
+			continue;
+		}
+		if( libphdi_data_block_initialize(
+		     &data_block,
+		     LIBPHDI_DATA_BLOCK_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create data block.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     data_block->data,
+		     &( buffer[ buffer_offset ] ),
+		     LIBPHDI_DATA_BLOCK_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data block data.",
+			 function );
+
+			goto on_error;
+		}
+		/* The data cache takes over management of the data block
+		 */
+		if( libphdi_data_cache_client_insert_data_block(
+		     internal_handle->data_cache_client,
+		     file_io_pool_entry,
+		     range_file_offset,
+		     &data_block,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to insert data block: %" PRIi64 " (0x%08" PRIx64 ") into data cache.",
+			 function,
+			 data_block_offset,
+			 data_block_offset );
+
+			goto on_error;
+		}
+	}
+	if( uncached_size < buffer_size )
+	{
+		return( read_count + cached_read_count );
+	}
+	return( read_count );
+
+on_error:
+	if( data_block != NULL )
+	{
+		libphdi_data_block_free(
+		 &data_block,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Determines the size of the data blocks at a specific offset that are not cached
+ * This is used to read data blocks that were prefetched by readahead from
+ * the data block cache while reading the other data blocks directly
+ * The offset must be aligned with the data block size
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_internal_handle_get_uncached_data_blocks_size(
+     libphdi_internal_handle_t *internal_handle,
+     off64_t offset,
+     size_t maximum_size,
+     size_t *uncached_size,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value = NULL;
+	static char *function                = "libphdi_internal_handle_get_uncached_data_blocks_size";
+	size_t safe_uncached_size            = 0;
+	off64_t cache_value_offset           = 0;
+	int64_t cache_value_timestamp        = 0;
+	int cache_entry_index                = 0;
+	int cache_value_file_index           = 0;
+	int number_of_cache_entries          = 0;
+	int result                           = 1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->data_block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing data block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( ( offset % LIBPHDI_DATA_BLOCK_SIZE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncached_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncached size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     internal_handle->data_block_cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of data block cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of data block cache entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->data_block_cache_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab data block cache read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	while( safe_uncached_size < maximum_size )
+	{
+		cache_entry_index = (int) ( ( offset / LIBPHDI_DATA_BLOCK_SIZE ) % number_of_cache_entries );
+
+		if( libfcache_cache_get_value_by_index(
+		     internal_handle->data_block_cache,
+		     cache_entry_index,
+		     &cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cache entry: %d from data block cache.",
+			 function,
+			 cache_entry_index );
+
+			result = -1;
+
+			break;
+		}
+		if( cache_value != NULL )
+		{
+			if( libfcache_cache_value_get_identifier(
+			     cache_value,
+			     &cache_value_file_index,
+			     &cache_value_offset,
+			     &cache_value_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve cache value identifier.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			if( cache_value_offset == offset )
+			{
+				break;
+			}
+		}
+		safe_uncached_size += LIBPHDI_DATA_BLOCK_SIZE;
+		offset             += LIBPHDI_DATA_BLOCK_SIZE;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->data_block_cache_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release data block cache read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result == 1 )
+	{
+		if( safe_uncached_size > maximum_size )
+		{
+			safe_uncached_size = maximum_size;
+		}
+		*uncached_size = safe_uncached_size;
+	}
+	return( result );
+}
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+
+/* Updates the readahead with a read and queues the data to prefetch
+ * This function does not use shared seek state and can be called with the read lock
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_internal_handle_readahead(
+     libphdi_internal_handle_t *internal_handle,
+     off64_t offset,
+     size64_t read_size,
+     libcerror_error_t **error )
+{
+	libphdi_readahead_request_t *request = NULL;
+	static char *function                = "libphdi_internal_handle_readahead";
+	size64_t maximum_prefetch_size       = 0;
+	size64_t prefetch_size               = 0;
+	off64_t prefetch_offset              = 0;
+	int result                           = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->disk_parameters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing disk parameters.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->readahead == NULL )
+	 || ( internal_handle->readahead_thread_pool == NULL )
+	 || ( internal_handle->data_block_cache == NULL ) )
+	{
+		return( 1 );
+	}
+	result = libphdi_readahead_update(
+	          internal_handle->readahead,
+	          offset,
+	          read_size,
+	          &prefetch_offset,
+	          &prefetch_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update readahead.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 1 );
+	}
+	/* Prefetching more than half of the data block cache would evict
+	 * prefetched data blocks before they are read
+	 */
+	maximum_prefetch_size = internal_handle->data_block_cache_size / 2;
+
+	if( prefetch_size > maximum_prefetch_size )
+	{
+		prefetch_size = maximum_prefetch_size;
+	}
+	if( (size64_t) prefetch_offset < internal_handle->disk_parameters->media_size )
+	{
+		if( prefetch_size > ( internal_handle->disk_parameters->media_size - (size64_t) prefetch_offset ) )
+		{
+			prefetch_size = internal_handle->disk_parameters->media_size - (size64_t) prefetch_offset;
+		}
+	}
+	else
+	{
+		prefetch_size = 0;
+	}
+	if( prefetch_size == 0 )
+	{
+		if( libphdi_readahead_complete_request(
+		     internal_handle->readahead,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to complete readahead request.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( libphdi_readahead_request_initialize(
+	     &request,
+	     internal_handle->readahead,
+	     prefetch_offset,
+	     prefetch_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create readahead request.",
+		 function );
+
+		goto on_error;
+	}
+	/* The number of pending requests is limited by the readahead
+	 * so that pushing to the thread pool does not block
+	 */
+	if( libcthreads_thread_pool_push(
+	     internal_handle->readahead_thread_pool,
+	     (intptr_t *) request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push readahead request onto thread pool queue.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( request != NULL )
+	{
+		libphdi_readahead_request_free(
+		 &request,
+		 NULL );
+	}
+	libphdi_readahead_complete_request(
+	 internal_handle->readahead,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Prefetches the data of a readahead request into the shared data cache if the handle
+ * uses one, otherwise into the data block cache of the handle
+ * This function is the callback of the readahead thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_internal_handle_readahead_callback(
+     libphdi_readahead_request_t *request,
+     libphdi_internal_handle_t *internal_handle )
+{
+	libcerror_error_t *error  = NULL;
+	uint8_t *data_block_data  = NULL;
+	static char *function     = "libphdi_internal_handle_readahead_callback";
+	size_t uncached_size      = 0;
+	ssize_t read_count        = 0;
+	off64_t end_offset        = 0;
+	off64_t offset            = 0;
+	uint32_t abort_generation = 0;
+	uint8_t data_byte         = 0;
+	int result                = 1;
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		goto on_error;
+	}
+	/* The handle can have been closed after the request was queued
+	 */
+	if( ( internal_handle->extent_data_file_io_pool != NULL )
+	 && ( internal_handle->disk_parameters != NULL )
+	 && ( internal_handle->current_snapshot_values != NULL )
+	 && ( ( internal_handle->data_cache_client != NULL )
+	  || ( internal_handle->data_block_cache != NULL ) ) )
+	{
+		offset     = request->offset - ( request->offset % LIBPHDI_DATA_BLOCK_SIZE );
+		end_offset = request->offset + (off64_t) request->size;
+
+		if( (size64_t) end_offset > internal_handle->disk_parameters->media_size )
+		{
+			end_offset = (off64_t) internal_handle->disk_parameters->media_size;
+		}
+		/* The read path looks up the data blocks in the shared data cache if the handle
+		 * uses one, hence the data blocks are prefetched into the shared data cache
+		 */
+		if( internal_handle->data_cache_client != NULL )
+		{
+			/* Only whole data blocks are stored in the shared data cache
+			 */
+			end_offset -= end_offset % LIBPHDI_DATA_BLOCK_SIZE;
+
+			data_block_data = (uint8_t *) memory_allocate(
+			                               sizeof( uint8_t ) * LIBPHDI_DATA_BLOCK_SIZE );
+
+			if( data_block_data == NULL )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create data block data.",
+				 function );
+
+				result     = -1;
+				end_offset = offset;
+			}
+		}
+		abort_generation = internal_handle->io_handle->abort_generation;
+
+		while( offset < end_offset )
+		{
+			if( internal_handle->io_handle->abort_generation != abort_generation )
+			{
+				break;
+			}
+			if( internal_handle->data_cache_client != NULL )
+			{
+				/* Reading a data block via the shared data cache stores the data block in the cache
+				 */
+				read_count = libphdi_internal_handle_read_data_blocks_from_data_cache(
+				              internal_handle,
+				              internal_handle->extent_data_file_io_pool,
+				              data_block_data,
+				              LIBPHDI_DATA_BLOCK_SIZE,
+				              offset,
+				              &error );
+
+				if( read_count == -1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to prefetch data block: %" PRIi64 " (0x%08" PRIx64 ") into data cache.",
+					 function,
+					 offset,
+					 offset );
+
+					result = -1;
+
+					break;
+				}
+				offset += LIBPHDI_DATA_BLOCK_SIZE;
+
+				continue;
+			}
+			if( libphdi_internal_handle_get_uncached_data_blocks_size(
+			     internal_handle,
+			     offset,
+			     LIBPHDI_DATA_BLOCK_SIZE,
+			     &uncached_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if data block: %" PRIi64 " (0x%08" PRIx64 ") is cached.",
+				 function,
+				 offset,
+				 offset );
+
+				result = -1;
+
+				break;
+			}
+			if( uncached_size > 0 )
+			{
+				/* Reading a single byte of the data block stores the data block in the cache
+				 */
+				read_count = libphdi_internal_handle_read_data_block_from_file_io_pool(
+				              internal_handle,
+				              internal_handle->extent_data_file_io_pool,
+				              &data_byte,
+				              1,
+				              offset,
+				              &error );
+
+				if( read_count == -1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to prefetch data block: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 offset,
+					 offset );
+
+					result = -1;
+
+					break;
+				}
+			}
+			offset += LIBPHDI_DATA_BLOCK_SIZE;
+		}
+		if( data_block_data != NULL )
+		{
+			memory_free(
+			 data_block_data );
+
+			data_block_data = NULL;
+		}
+	}
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		result = -1;
+	}
+	if( libphdi_readahead_complete_request(
+	     request->readahead,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to complete readahead request.",
+		 function );
+
+		result = -1;
+	}
+	if( libphdi_readahead_request_free(
+	     &request,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free readahead request.",
+		 function );
+
+		result = -1;
+	}
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	/* Readahead is a hint, the error is only reported in debug output
+	 */
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( request != NULL )
+	{
+		libphdi_readahead_request_free(
+		 &request,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the storage image metadata of a metadata request
+ * This function is the callback of the metadata prefetch thread pool
+ * The error is kept in the result of the request, which is checked after the thread pool was joined
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_internal_handle_metadata_request_callback(
+     libphdi_metadata_request_t *metadata_request,
+     libphdi_internal_handle_t *internal_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libphdi_internal_handle_metadata_request_callback";
+
+	if( metadata_request == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata request.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		goto on_error;
+	}
+	/* The remaining requests are skipped when the handle was signalled to abort
+	 */
+	if( internal_handle->io_handle->abort != 0 )
+	{
+		return( 1 );
+	}
+	if( libphdi_metadata_request_read(
+	     metadata_request,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read metadata of extent file: %d.",
+		 function,
+		 metadata_request->extent_index );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Reads the data of an asynchronous read request
+ * This function is the callback of the asynchronous read thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_internal_handle_async_read_callback(
+     libphdi_read_request_t *read_request,
+     libphdi_internal_handle_t *internal_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libphdi_internal_handle_async_read_callback";
+
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		goto on_error;
+	}
+	read_request->read_count = libphdi_handle_read_buffer_at_offset(
+	                            (libphdi_handle_t *) internal_handle,
+	                            read_request->buffer,
+	                            read_request->buffer_size,
+	                            read_request->offset,
+	                            &error );
+
+	/* A failed read is reported by the read count of the request
+	 */
+	if( read_request->read_count == -1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( libphdi_completion_queue_complete_request(
+	     internal_handle->completion_queue,
+	     read_request,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to complete read request.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_request != NULL )
+	{
+		libphdi_read_request_free(
+		 &read_request,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT ) */
+
+/* Reads a range of data at a specific offset into a buffer using the layer map
+ * Mixed blocks are read by walking the snapshot chain
+ * This function does not use shared seek state and can be called with the read lock
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libphdi_internal_handle_read_layer_map_range_from_file_io_pool(
+         libphdi_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function     = "libphdi_internal_handle_read_layer_map_range_from_file_io_pool";
+	size64_t range_size       = 0;
+	size_t read_size          = 0;
+	ssize_t read_count        = 0;
+	off64_t range_file_offset = 0;
+	int file_io_pool_entry    = 0;
+	int range_layer           = 0;
+	uint8_t range_type        = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libphdi_layer_map_get_range_at_offset(
+	     internal_handle->layer_map,
+	     internal_handle->current_snapshot_values,
+	     file_io_pool,
+	     offset,
+	     (size64_t) buffer_size,
+	     &range_type,
+	     &range_layer,
+	     &file_io_pool_entry,
+	     &range_file_offset,
+	     &range_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range at offset: %" PRIi64 " (0x%08" PRIx64 ") from layer map.",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	read_size = (size_t) range_size;
+
+	switch( range_type )
+	{
+		case LIBPHDI_LAYER_MAP_ENTRY_TYPE_ALLOCATED:
+			read_count = libphdi_statistics_read_buffer_at_offset(
+			              internal_handle->statistics,
+			              file_io_pool,
+			              file_io_pool_entry,
+			              buffer,
+			              read_size,
+			              range_file_offset,
+			              error );
+
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read data from file IO pool entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 file_io_pool_entry,
+				 range_file_offset,
+				 range_file_offset );
+
+				return( -1 );
+			}
+			libphdi_statistics_add_snapshot_depth_value(
+			 internal_handle->statistics,
+			 range_layer,
+			 (uint64_t) read_size );
+
+			break;
+
+		case LIBPHDI_LAYER_MAP_ENTRY_TYPE_SPARSE:
+			if( memory_set(
+			     buffer,
+			     0,
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to fill buffer with sparse blocks.",
+				 function );
+
+				return( -1 );
+			}
+			libphdi_statistics_add_value(
+			 internal_handle->statistics,
+			 LIBPHDI_STATISTIC_SPARSE_BYTES_READ,
+			 (uint64_t) read_size );
+
+			break;
+
+		case LIBPHDI_LAYER_MAP_ENTRY_TYPE_MIXED:
+			read_count = libphdi_internal_handle_read_block_from_file_io_pool(
+			              internal_handle,
+			              internal_handle->current_snapshot_values,
+			              file_io_pool,
+			              buffer,
+			              read_size,
+			              offset,
+			              0,
+			              error );
+
+			if( read_count <= 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer from current snapshot at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset,
+				 offset );
+
+				return( -1 );
+			}
+			read_size = (size_t) read_count;
+
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported range type: %" PRIu8 ".",
+			 function,
+			 range_type );
+
+			return( -1 );
+	}
+	return( (ssize_t) read_size );
+}
+
+/* Reads (media) data at a specific offset into a buffer using a Basic File IO (bfio) pool
+ * This function bypasses the data block cache
+ * This function does not use shared seek state and can be called with the read lock
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libphdi_internal_handle_read_data_from_file_io_pool(
+         libphdi_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function     = "libphdi_internal_handle_read_data_from_file_io_pool";
+	size_t buffer_offset      = 0;
+	size_t read_size          = 0;
+	ssize_t read_count        = 0;
+	uint32_t abort_generation = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->disk_parameters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing disk parameters.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_snapshot_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing current snapshot values.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_handle->disk_parameters->media_size )
+	{
+		return( 0 );
+	}
+	if( internal_handle->current_snapshot_values->extent_table->segment_table != NULL )
+	{
+		read_size = buffer_size;
+
+		if( ( (size64_t) read_size > internal_handle->disk_parameters->media_size )
+		 || ( (size64_t) offset > ( internal_handle->disk_parameters->media_size - read_size ) ) )
+		{
+			read_size = (size_t) ( internal_handle->disk_parameters->media_size - offset );
+		}
+		read_count = libphdi_extent_table_read_buffer_at_offset(
+		              internal_handle->current_snapshot_values->extent_table,
+		              file_io_pool,
+		              (uint8_t *) buffer,
+		              read_size,
+		              offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from segment table at offset: %" PRIi64 " (0x%" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		libphdi_statistics_add_snapshot_depth_value(
+		 internal_handle->statistics,
+		 0,
+		 (uint64_t) read_size );
+
+		buffer_offset = read_size;
+	}
+	else
+	{
+		abort_generation = internal_handle->io_handle->abort_generation;
+
+		while( buffer_offset < buffer_size )
+		{
+			read_size = buffer_size - buffer_offset;
+
+			if( ( (size64_t) read_size > internal_handle->disk_parameters->media_size )
+			 || ( (size64_t) offset > ( internal_handle->disk_parameters->media_size - read_size ) ) )
+			{
+				read_size = (size_t) ( internal_handle->disk_parameters->media_size - offset );
+			}
+			if( internal_handle->layer_map != NULL )
+			{
+				read_count = libphdi_internal_handle_read_layer_map_range_from_file_io_pool(
+					      internal_handle,
+				              file_io_pool,
+					      &(( (uint8_t *) buffer )[ buffer_offset ] ),
+					      read_size,
+					      offset,
+					      error );
+			}
+			else
+			{
+				read_count = libphdi_internal_handle_read_block_from_file_io_pool(
+					      internal_handle,
+					      internal_handle->current_snapshot_values,
+				              file_io_pool,
+					      &(( (uint8_t *) buffer )[ buffer_offset ] ),
+					      read_size,
+					      offset,
+					      0,
+					      error );
+			}
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer from current snapshot.",
+				 function );
+
+				return( -1 );
+			}
+			buffer_offset += read_count;
+			offset        += (off64_t) read_count;
+
+			if( (size64_t) offset >= internal_handle->disk_parameters->media_size )
+			{
+				break;
+			}
+			if( internal_handle->io_handle->abort_generation != abort_generation )
+			{
+				break;
+			}
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Reads (media) data at a specific offset into a buffer using a Basic File IO (bfio) pool
+ * Partial data blocks are read via the data block cache, whole data blocks are read directly
+ * When the handle uses the shared data cache all data blocks are read via the shared data cache,
+ * where whole data blocks that are not cached are read directly and added to the cache afterwards
+ * This function does not use shared seek state and can be called with the read lock
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libphdi_internal_handle_read_buffer_at_offset_from_file_io_pool(
+         libphdi_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function         = "libphdi_internal_handle_read_buffer_at_offset_from_file_io_pool";
+	size_t buffer_offset          = 0;
+	size_t data_block_offset      = 0;
+	size_t direct_read_size       = 0;
+	size_t read_size              = 0;
+	size_t whole_data_blocks_size = 0;
+	ssize_t read_count            = 0;
+	uint32_t abort_generation     = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->disk_parameters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing disk parameters.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid element data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: requested offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 offset,
+		 offset );
+	}
+#endif
+	if( (size64_t) offset >= internal_handle->disk_parameters->media_size )
+	{
+		return( 0 );
+	}
+	/* Only an abort signalled after the read started stops the read
+	 */
+	abort_generation = internal_handle->io_handle->abort_generation;
+
+	while( buffer_offset < buffer_size )
+	{
+		read_size         = buffer_size - buffer_offset;
+		data_block_offset = (size_t) ( offset % LIBPHDI_DATA_BLOCK_SIZE );
+		direct_read_size  = 0;
+
+		if( internal_handle->data_cache_client != NULL )
+		{
+			/* Every data block is looked up in the shared data cache since it can contain
+			 * data blocks that were read by other handles, hence whole data blocks are
+			 * read via the shared data cache as well
+			 */
+			direct_read_size = 0;
+		}
+		else if( internal_handle->data_block_cache == NULL )
+		{
+			direct_read_size = read_size;
+		}
+		else if( ( data_block_offset == 0 )
+		      && ( read_size >= LIBPHDI_DATA_BLOCK_SIZE ) )
+		{
+			/* Whole data blocks are read directly to prevent large reads from evicting the cache
+			 */
+			direct_read_size = read_size - ( read_size % LIBPHDI_DATA_BLOCK_SIZE );
+
+			/* Data blocks that were prefetched by readahead are read from the cache
+			 */
+			if( internal_handle->readahead != NULL )
+			{
+				if( libphdi_internal_handle_get_uncached_data_blocks_size(
+				     internal_handle,
+				     offset,
+				     direct_read_size,
+				     &direct_read_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to determine size of uncached data blocks at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 offset,
+					 offset );
+
+					return( -1 );
+				}
+			}
+		}
+		if( direct_read_size > 0 )
+		{
+			read_count = libphdi_internal_handle_read_data_from_file_io_pool(
+			              internal_handle,
+			              file_io_pool,
+			              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			              direct_read_size,
+			              offset,
+			              error );
+		}
+		else if( internal_handle->data_cache_client != NULL )
+		{
+			whole_data_blocks_size = read_size;
+
+			if( (size64_t) whole_data_blocks_size > ( internal_handle->disk_parameters->media_size - (size64_t) offset ) )
+			{
+				whole_data_blocks_size = (size_t) ( internal_handle->disk_parameters->media_size - (size64_t) offset );
+			}
+			whole_data_blocks_size -= whole_data_blocks_size % LIBPHDI_DATA_BLOCK_SIZE;
+
+			if( ( data_block_offset == 0 )
+			 && ( whole_data_blocks_size > 0 ) )
+			{
+				/* The whole data blocks that are not cached are read with a single read
+				 */
+				read_count = libphdi_internal_handle_read_data_blocks_from_data_cache(
+				              internal_handle,
+				              file_io_pool,
+				              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				              whole_data_blocks_size,
+				              offset,
+				              error );
+			}
+			else
+			{
+				read_count = libphdi_internal_handle_read_data_block_from_data_cache(
+				              internal_handle,
+				              file_io_pool,
+				              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				              read_size,
+				              offset,
+				              error );
+			}
+		}
+		else
+		{
+			read_count = libphdi_internal_handle_read_data_block_from_file_io_pool(
+			              internal_handle,
+			              file_io_pool,
+			              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			              read_size,
+			              offset,
+			              error );
+		}
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		else if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_offset += (size_t) read_count;
+		offset        += (off64_t) read_count;
+
+		if( (size64_t) offset >= internal_handle->disk_parameters->media_size )
+		{
+			break;
+		}
+		if( internal_handle->io_handle->abort_generation != abort_generation )
+		{
+			break;
+		}
+	}
+	libphdi_statistics_add_value(
+	 internal_handle->statistics,
+	 LIBPHDI_STATISTIC_LOGICAL_BYTES_READ,
+	 (uint64_t) buffer_offset );
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( ( internal_handle->readahead != NULL )
+	 && ( buffer_offset > 0 ) )
+	{
+		if( libphdi_internal_handle_readahead(
+		     internal_handle,
+		     offset - (off64_t) buffer_offset,
+		     (size64_t) buffer_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to start readahead.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( (ssize_t) buffer_offset );
+}
+
+/* Reads (media) data at the current offset into a buffer using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libphdi_internal_handle_read_buffer_from_file_io_pool(
+         libphdi_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libphdi_internal_handle_read_buffer_from_file_io_pool";
+	ssize_t read_count    = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libphdi_internal_handle_read_buffer_at_offset_from_file_io_pool(
+	              internal_handle,
+	              file_io_pool,
+	              buffer,
+	              buffer_size,
+	              internal_handle->current_offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 internal_handle->current_offset,
+		 internal_handle->current_offset );
+
+		return( -1 );
+	}
+	internal_handle->current_offset += (off64_t) read_count;
+
+	return( read_count );
+}
+
+/* Reads (media) data from the current offset into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libphdi_handle_read_buffer(
+         libphdi_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_read_buffer";
+	ssize_t read_count                         = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libphdi_internal_handle_read_buffer_from_file_io_pool(
+		      internal_handle,
+	              internal_handle->extent_data_file_io_pool,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads (media) data at a specific offset
+ * This function does not change the current offset and concurrent calls
+ * only need to acquire the read lock
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libphdi_handle_read_buffer_at_offset(
+         libphdi_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_read_buffer_at_offset";
+	ssize_t read_count                         = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libphdi_internal_handle_read_buffer_at_offset_from_file_io_pool(
+	              internal_handle,
+	              internal_handle->extent_data_file_io_pool,
+	              buffer,
+	              buffer_size,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads (media) data of multiple requests at specific offsets
+ * The stored data of the requests is read in order of the extent data files
+ * and the offsets in these files, where neighbouring data is read at once
+ * This function does not change the current offset and concurrent calls
+ * only need to acquire the read lock
+ * The number of bytes read of each request is set in read counts, or -1 if the
+ * request failed
+ * Returns 1 if successful, 0 if one or more requests failed or -1 on error
+ */
+int libphdi_handle_read_vector(
+     libphdi_handle_t *handle,
+     void **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_requests,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *request_error           = NULL;
+	libphdi_internal_handle_t *internal_handle = NULL;
+	libphdi_read_vector_t *read_vector         = NULL;
+	uint8_t *request_buffer                    = NULL;
+	static char *function                      = "libphdi_handle_read_vector";
+	size64_t range_size                        = 0;
+	size_t buffer_offset                       = 0;
+	size_t read_size                           = 0;
+	off64_t range_file_offset                  = 0;
+	int file_io_pool_entry                     = 0;
+	int request_index                          = 0;
+	int result                                 = 1;
+	int range_result                           = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_counts == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read counts.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_requests < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of requests value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		if( buffers[ request_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid request: %d - missing buffer.",
+			 function,
+			 request_index );
+
+			return( -1 );
+		}
+		if( buffer_sizes[ request_index ] > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid request: %d - buffer size value exceeds maximum.",
+			 function,
+			 request_index );
+
+			return( -1 );
+		}
+		if( offsets[ request_index ] < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+			 "%s: invalid request: %d - offset value less than zero.",
+			 function,
+			 request_index );
+
+			return( -1 );
+		}
+	}
+	if( libphdi_read_vector_initialize(
+	     &read_vector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read vector.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		libphdi_read_vector_free(
+		 &read_vector,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_handle->disk_parameters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing disk parameters.",
+		 function );
+
+		goto on_error;
+	}
+	/* Resolve the requests into the ranges of stored data, sparse data is
+	 * filled directly
+	 */
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		request_buffer = (uint8_t *) buffers[ request_index ];
+		read_size      = buffer_sizes[ request_index ];
+
+		if( (size64_t) offsets[ request_index ] >= internal_handle->disk_parameters->media_size )
+		{
+			read_size = 0;
+		}
+		else if( (size64_t) read_size > ( internal_handle->disk_parameters->media_size - (size64_t) offsets[ request_index ] ) )
+		{
+			read_size = (size_t) ( internal_handle->disk_parameters->media_size - (size64_t) offsets[ request_index ] );
+		}
+		read_counts[ request_index ] = (ssize_t) read_size;
+
+		buffer_offset = 0;
+
+		while( buffer_offset < read_size )
+		{
+			range_result = libphdi_internal_handle_get_data_range_at_offset(
+			                internal_handle,
+			                internal_handle->extent_data_file_io_pool,
+			                offsets[ request_index ] + (off64_t) buffer_offset,
+			                (size64_t) ( read_size - buffer_offset ),
+			                &file_io_pool_entry,
+			                &range_file_offset,
+			                &range_size,
+			                &request_error );
+
+			if( ( range_result == -1 )
+			 || ( range_size == 0 )
+			 || ( range_size > (size64_t) ( read_size - buffer_offset ) ) )
+			{
+				/* A request that cannot be resolved only fails the request itself
+				 */
+				if( request_error != NULL )
+				{
+#if defined( HAVE_DEBUG_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						libcnotify_print_error_backtrace(
+						 request_error );
+					}
+#endif
+					libcerror_error_free(
+					 &request_error );
+				}
+				read_counts[ request_index ] = -1;
+
+				result = 0;
+
+				break;
+			}
+			if( range_result == 0 )
+			{
+				if( memory_set(
+				     &( request_buffer[ buffer_offset ] ),
+				     0,
+				     (size_t) range_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear request: %d buffer.",
+					 function,
+					 request_index );
+
+					goto on_error;
+				}
+				libphdi_statistics_add_value(
+				 internal_handle->statistics,
+				 LIBPHDI_STATISTIC_SPARSE_BYTES_READ,
+				 range_size );
+			}
+			else if( libphdi_read_vector_append_segment(
+			          read_vector,
+			          request_index,
+			          file_io_pool_entry,
+			          range_file_offset,
+			          &( request_buffer[ buffer_offset ] ),
+			          (size_t) range_size,
+			          error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append request: %d segment to read vector.",
+				 function,
+				 request_index );
+
+				goto on_error;
+			}
+			buffer_offset += (size_t) range_size;
+		}
+	}
+	if( libphdi_read_vector_sort(
+	     read_vector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to sort read vector.",
+		 function );
+
+		goto on_error;
+	}
+	range_result = libphdi_read_vector_read_from_file_io_pool(
+	                read_vector,
+	                internal_handle->extent_data_file_io_pool,
+	                internal_handle->statistics,
+	                read_counts,
+	                number_of_requests,
+	                error );
+
+	if( range_result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read read vector.",
+		 function );
+
+		goto on_error;
+	}
+	else if( range_result == 0 )
+	{
+		result = 0;
+	}
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		if( read_counts[ request_index ] > 0 )
+		{
+			libphdi_statistics_add_value(
+			 internal_handle->statistics,
+			 LIBPHDI_STATISTIC_LOGICAL_BYTES_READ,
+			 (uint64_t) read_counts[ request_index ] );
+		}
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		libphdi_read_vector_free(
+		 &read_vector,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	if( libphdi_read_vector_free(
+	     &read_vector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free read vector.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	if( read_vector != NULL )
+	{
+		libphdi_read_vector_free(
+		 &read_vector,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Initializes the completion queue and thread pool used by asynchronous reads
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_internal_handle_initialize_async_read(
+     libphdi_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_internal_handle_initialize_async_read";
+	int result            = 1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->completion_queue == NULL )
+	{
+		if( libphdi_completion_queue_initialize(
+		     &( internal_handle->completion_queue ),
+		     LIBPHDI_ASYNC_READ_MAXIMUM_NUMBER_OF_REQUESTS,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create completion queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( ( result == 1 )
+	 && ( internal_handle->async_read_thread_pool == NULL ) )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( internal_handle->async_read_thread_pool ),
+		     NULL,
+		     LIBPHDI_ASYNC_READ_NUMBER_OF_THREADS,
+		     LIBPHDI_ASYNC_READ_MAXIMUM_NUMBER_OF_REQUESTS,
+		     (int (*)(intptr_t *, void *)) &libphdi_internal_handle_async_read_callback,
+		     (void *) internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create asynchronous read thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Submits an asynchronous read of (media) data at a specific offset
+ * The read is completed on a worker thread, or directly if the library was built
+ * without multi-thread support. The buffer must remain valid until the completed
+ * read has been retrieved with libphdi_handle_get_completed_read, which returns
+ * the user data to identify the read
+ * This function does not change the current offset
+ * Returns 1 if successful, 0 if the maximum number of outstanding reads was reached or -1 on error
+ */
+int libphdi_handle_submit_read_buffer_at_offset(
+     libphdi_handle_t *handle,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     intptr_t user_data,
+     libcerror_error_t **error )
+{
+	libphdi_completion_queue_t *completion_queue = NULL;
+	libphdi_internal_handle_t *internal_handle   = NULL;
+	libphdi_read_request_t *read_request         = NULL;
+	static char *function                        = "libphdi_handle_submit_read_buffer_at_offset";
+	int result                                   = 0;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *thread_pool       = NULL;
+#else
+	libcerror_error_t *read_error                = NULL;
+#endif
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( libphdi_internal_handle_initialize_async_read(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize asynchronous read.",
+		 function );
+
+		return( -1 );
+	}
+	/* The completion queue and thread pool remain valid until the handle is freed
+	 */
+	completion_queue = internal_handle->completion_queue;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	thread_pool = internal_handle->async_read_thread_pool;
+#endif
+	result = libphdi_completion_queue_reserve_request(
+	          completion_queue,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to reserve request in completion queue.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libphdi_read_request_initialize(
+	     &read_request,
+	     (uint8_t *) buffer,
+	     buffer_size,
+	     offset,
+	     user_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read request.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	/* The number of requests is limited by the completion queue
+	 * so that pushing to the thread pool does not block
+	 */
+	if( libcthreads_thread_pool_push(
+	     thread_pool,
+	     (intptr_t *) read_request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push read request onto thread pool queue.",
+		 function );
+
+		goto on_error;
+	}
+#else
+	read_request->read_count = libphdi_handle_read_buffer_at_offset(
+	                            handle,
+	                            read_request->buffer,
+	                            read_request->buffer_size,
+	                            read_request->offset,
+	                            &read_error );
+
+	/* A failed read is reported by the read count of the request
+	 */
+	if( read_request->read_count == -1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 read_error );
+		}
+#endif
+		libcerror_error_free(
+		 &read_error );
+	}
+	if( libphdi_completion_queue_complete_request(
+	     completion_queue,
+	     read_request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to complete read request.",
+		 function );
+
+		goto on_error;
+	}
+#endif /* defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT ) */
+
+	return( 1 );
+
+on_error:
+	if( read_request != NULL )
+	{
+		libphdi_read_request_free(
+		 &read_request,
+		 NULL );
+	}
+	libphdi_completion_queue_cancel_request(
+	 completion_queue,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Retrieves a completed asynchronous read
+ * If wait is set the function waits until a read completes, unless there are no outstanding reads
+ * The read count is the number of bytes read or -1 if the read failed
+ * Returns 1 if successful, 0 if no completed read is available or -1 on error
+ */
+int libphdi_handle_get_completed_read(
+     libphdi_handle_t *handle,
+     uint8_t wait,
+     intptr_t *user_data,
+     ssize_t *read_count,
+     libcerror_error_t **error )
+{
+	libphdi_completion_queue_t *completion_queue = NULL;
+	libphdi_internal_handle_t *internal_handle   = NULL;
+	libphdi_read_request_t *read_request         = NULL;
+	static char *function                        = "libphdi_handle_get_completed_read";
+	int result                                   = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( user_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid user data.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_count == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read count.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	completion_queue = internal_handle->completion_queue;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( completion_queue == NULL )
+	{
+		return( 0 );
+	}
+	/* The lock is not held while waiting since the outstanding
+	 * reads need to grab the lock for reading
+	 */
+	result = libphdi_completion_queue_get_completed_request(
+	          completion_queue,
+	          wait,
+	          &read_request,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve completed request from completion queue.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		*user_data  = read_request->user_data;
+		*read_count = read_request->read_count;
+
+		if( libphdi_read_request_free(
+		     &read_request,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read request.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the number of outstanding asynchronous reads
+ * Outstanding reads are the reads that were submitted and not yet retrieved
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_get_number_of_outstanding_reads(
+     libphdi_handle_t *handle,
+     int *number_of_outstanding_reads,
+     libcerror_error_t **error )
+{
+	libphdi_completion_queue_t *completion_queue = NULL;
+	libphdi_internal_handle_t *internal_handle   = NULL;
+	static char *function                        = "libphdi_handle_get_number_of_outstanding_reads";
+	int number_of_completed_requests             = 0;
+	int number_of_pending_requests               = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( number_of_outstanding_reads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of outstanding reads.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	completion_queue = internal_handle->completion_queue;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( completion_queue != NULL )
+	{
+		if( libphdi_completion_queue_get_number_of_requests(
+		     completion_queue,
+		     &number_of_pending_requests,
+		     &number_of_completed_requests,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of requests from completion queue.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*number_of_outstanding_reads = number_of_pending_requests + number_of_completed_requests;
+
+	return( 1 );
+}
+
+/* Seeks a certain offset of the (media) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libphdi_internal_handle_seek_offset(
+         libphdi_internal_handle_t *internal_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libphdi_handle_seek_offset";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->disk_parameters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing disk parameters.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += internal_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) internal_handle->disk_parameters->media_size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the (media) data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libphdi_handle_seek_offset(
+         libphdi_handle_t *handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_seek_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libphdi_internal_handle_seek_offset(
+	          internal_handle,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		offset = -1;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset of the (media) data
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_get_offset(
+     libphdi_handle_t *handle,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_get_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*offset = internal_handle->current_offset;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the data range at a specific offset
+ * The data is resolved via the parent snapshots if needed
+ * The range does not exceed the maximum range size and is either stored contiguously or fully sparse
+ * This function does not use shared seek state and can be called with the read lock
+ * Returns 1 if the range is allocated, 0 if the range is sparse or -1 on error
+ */
+int libphdi_internal_handle_get_data_range_at_offset(
+     libphdi_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     size64_t maximum_range_size,
+     int *file_io_pool_entry,
+     off64_t *range_file_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	libphdi_snapshot_values_t *snapshot_values = NULL;
+	static char *function                      = "libphdi_internal_handle_get_data_range_at_offset";
+	size64_t layer_range_size                  = 0;
+	size64_t safe_range_size                   = 0;
+	off64_t layer_range_file_offset            = 0;
+	off64_t safe_range_file_offset             = 0;
+	int layer_file_io_pool_entry               = 0;
+	int range_layer                            = 0;
+	int result                                 = 0;
+	int safe_file_io_pool_entry                = -1;
+	uint8_t range_type                         = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->disk_parameters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing disk parameters.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_snapshot_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing current snapshot values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= internal_handle->disk_parameters->media_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_range_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum range size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_file_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range file offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_range_size > ( internal_handle->disk_parameters->media_size - (size64_t) offset ) )
+	{
+		maximum_range_size = internal_handle->disk_parameters->media_size - (size64_t) offset;
+	}
+	if( internal_handle->layer_map == NULL )
+	{
+		/* Without a layer map every range is resolved via the snapshot chain
+		 */
+		safe_range_size = maximum_range_size;
+		range_type      = LIBPHDI_LAYER_MAP_ENTRY_TYPE_MIXED;
+	}
+	else
+	{
+		if( libphdi_layer_map_get_range_at_offset(
+		     internal_handle->layer_map,
+		     internal_handle->current_snapshot_values,
+		     file_io_pool,
+		     offset,
+		     maximum_range_size,
+		     &range_type,
+		     &range_layer,
+		     &safe_file_io_pool_entry,
+		     &safe_range_file_offset,
+		     &safe_range_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range at offset: %" PRIi64 " (0x%08" PRIx64 ") from layer map.",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+	}
+	switch( range_type )
+	{
+		case LIBPHDI_LAYER_MAP_ENTRY_TYPE_ALLOCATED:
+			result = 1;
+			break;
+
+		case LIBPHDI_LAYER_MAP_ENTRY_TYPE_SPARSE:
+			result = 0;
+			break;
+
+		case LIBPHDI_LAYER_MAP_ENTRY_TYPE_MIXED:
+			/* The block is partially stored in different layers, or there is no layer map,
+			 * the data at the offset is stored in the first layer that has it allocated
+			 */
+			snapshot_values = internal_handle->current_snapshot_values;
+
+			while( snapshot_values != NULL )
+			{
+				result = libphdi_extent_table_get_block_range_at_offset(
+				          snapshot_values->extent_table,
+				          offset,
+				          file_io_pool,
+				          safe_range_size,
+				          &layer_file_io_pool_entry,
+				          &layer_range_file_offset,
+				          &layer_range_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve block range at offset: %" PRIi64 " (0x%08" PRIx64 ") from snapshot.",
+					 function,
+					 offset,
+					 offset );
+
+					return( -1 );
+				}
+				/* The range is allocated while this layer is allocated
+				 * and sparse while all layers are sparse
+				 */
+				if( ( result != 0 )
+				 || ( layer_range_size < safe_range_size ) )
+				{
+					safe_range_size = layer_range_size;
+				}
+				if( result != 0 )
+				{
+					safe_file_io_pool_entry = layer_file_io_pool_entry;
+					safe_range_file_offset  = layer_range_file_offset;
+
+					break;
+				}
+				snapshot_values = snapshot_values->parent_snapshot_values;
+			}
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported range type: %" PRIu8 ".",
+			 function,
+			 range_type );
+
+			return( -1 );
+	}
+	*file_io_pool_entry = safe_file_io_pool_entry;
+	*range_file_offset  = safe_range_file_offset;
+	*range_size         = safe_range_size;
+
+	return( result );
+}
+
+/* Retrieves the allocation range at a specific offset
+ * The range does not exceed the (media) data and is either fully allocated or fully sparse
+ * This function does not use shared seek state and can be called with the read lock
+ * Returns 1 if the range is allocated, 0 if the range is sparse or -1 on error
+ */
+int libphdi_internal_handle_get_allocation_range_at_offset(
+     libphdi_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     uint8_t allocation_flags,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	static char *function       = "libphdi_internal_handle_get_allocation_range_at_offset";
+	size64_t maximum_range_size = 0;
+	size64_t safe_range_size    = 0;
+	off64_t range_file_offset   = 0;
+	int file_io_pool_entry      = 0;
+	int result                  = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->disk_parameters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing disk parameters.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_snapshot_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing current snapshot values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= internal_handle->disk_parameters->media_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_range_size = internal_handle->disk_parameters->media_size - (size64_t) offset;
+
+	/* Without parent snapshots the allocation of the current snapshot is the allocation
+	 * of the (media) data
+	 */
+	if( ( ( allocation_flags & LIBPHDI_ALLOCATION_FLAG_CURRENT_SNAPSHOT_ONLY ) != 0 )
+	 || ( internal_handle->current_snapshot_values->parent_snapshot_values == NULL ) )
+	{
+		result = libphdi_extent_table_get_allocation_range_at_offset(
+		          internal_handle->current_snapshot_values->extent_table,
+		          offset,
+		          file_io_pool,
+		          maximum_range_size,
+		          &safe_range_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve allocation range at offset: %" PRIi64 " (0x%08" PRIx64 ") from current snapshot.",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		*range_size = safe_range_size;
+
+		return( result );
+	}
+	/* The data range is resolved via the parent snapshots, also without a layer map
+	 */
+	result = libphdi_internal_handle_get_data_range_at_offset(
+	          internal_handle,
+	          file_io_pool,
+	          offset,
+	          maximum_range_size,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &safe_range_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	*range_size = safe_range_size;
+
+	return( result );
+}
+
+
+/* Retrieves the offset of the next allocated or sparse range at or after a specific offset
+ * This function does not use shared seek state and can be called with the read lock
+ * Returns 1 if successful, 0 if no such range exists before the end of the (media) data or -1 on error
+ */
+int libphdi_internal_handle_get_next_allocation_offset(
+     libphdi_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     uint8_t allocation_flags,
+     uint8_t is_allocated,
+     off64_t *next_offset,
+     libcerror_error_t **error )
+{
+	static char *function     = "libphdi_internal_handle_get_next_allocation_offset";
+	size64_t range_size       = 0;
+	uint32_t abort_generation = 0;
+	int result                = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->disk_parameters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing disk parameters.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( next_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid next offset.",
+		 function );
+
+		return( -1 );
+	}
+	abort_generation = internal_handle->io_handle->abort_generation;
+
+	while( (size64_t) offset < internal_handle->disk_parameters->media_size )
+	{
+		result = libphdi_internal_handle_get_allocation_range_at_offset(
+		          internal_handle,
+		          file_io_pool,
+		          offset,
+		          allocation_flags,
+		          &range_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve allocation range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		if( ( ( result != 0 ) && ( is_allocated != 0 ) )
+		 || ( ( result == 0 ) && ( is_allocated == 0 ) ) )
+		{
+			*next_offset = offset;
+
+			return( 1 );
+		}
+		if( range_size == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid range size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		offset += (off64_t) range_size;
+
+		if( internal_handle->io_handle->abort_generation != abort_generation )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+			 "%s: abort requested.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Retrieves the offset of the next allocated data at or after a specific offset
+ * If allocation flags contain LIBPHDI_ALLOCATION_FLAG_CURRENT_SNAPSHOT_ONLY only the data
+ * stored in the current snapshot is considered, otherwise the data of parent snapshots as well
+ * Returns 1 if successful, 0 if there is no allocated data at or after the offset or -1 on error
+ */
+int libphdi_handle_get_next_data_offset(
+     libphdi_handle_t *handle,
+     off64_t offset,
+     uint8_t allocation_flags,
+     off64_t *data_offset,
+     libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_get_next_data_offset";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( allocation_flags & ~( LIBPHDI_ALLOCATION_FLAG_CURRENT_SNAPSHOT_ONLY ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported allocation flags: 0x%02" PRIx8 ".",
+		 function,
+		 allocation_flags );
+
+		return( -1 );
+	}
+	if( data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libphdi_internal_handle_get_next_allocation_offset(
+	          internal_handle,
+	          internal_handle->extent_data_file_io_pool,
+	          offset,
+	          allocation_flags,
+	          1,
+	          data_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve next data offset at or after offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the offset of the next hole (sparse data) at or after a specific offset
+ * The end of the (media) data is considered a hole
+ * If allocation flags contain LIBPHDI_ALLOCATION_FLAG_CURRENT_SNAPSHOT_ONLY only the data
+ * stored in the current snapshot is considered, otherwise the data of parent snapshots as well
+ * Returns 1 if successful, 0 if the offset is at or beyond the end of the (media) data or -1 on error
+ */
+int libphdi_handle_get_next_hole_offset(
+     libphdi_handle_t *handle,
+     off64_t offset,
+     uint8_t allocation_flags,
+     off64_t *hole_offset,
+     libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_get_next_hole_offset";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( allocation_flags & ~( LIBPHDI_ALLOCATION_FLAG_CURRENT_SNAPSHOT_ONLY ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported allocation flags: 0x%02" PRIx8 ".",
+		 function,
+		 allocation_flags );
+
+		return( -1 );
+	}
+	if( hole_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hole offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libphdi_internal_handle_get_next_allocation_offset(
+	          internal_handle,
+	          internal_handle->extent_data_file_io_pool,
+	          offset,
+	          allocation_flags,
+	          0,
+	          hole_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve next hole offset at or after offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+	}
+	else if( result == 0 )
+	{
+		/* The end of the (media) data is considered a hole
+		 */
+		if( (size64_t) offset < internal_handle->disk_parameters->media_size )
+		{
+			*hole_offset = (off64_t) internal_handle->disk_parameters->media_size;
+
+			result = 1;
+		}
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the next allocated range at or after a specific offset
+ * Call this function with the offset directly after the previous range to iterate all allocated ranges
+ * If allocation flags contain LIBPHDI_ALLOCATION_FLAG_CURRENT_SNAPSHOT_ONLY only the data
+ * stored in the current snapshot is considered, otherwise the data of parent snapshots as well
+ * Returns 1 if successful, 0 if there is no allocated data at or after the offset or -1 on error
+ */
+int libphdi_handle_get_allocated_range(
+     libphdi_handle_t *handle,
+     off64_t offset,
+     uint8_t allocation_flags,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_get_allocated_range";
+	off64_t data_offset                        = 0;
+	off64_t hole_offset                        = 0;
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( allocation_flags & ~( LIBPHDI_ALLOCATION_FLAG_CURRENT_SNAPSHOT_ONLY ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported allocation flags: 0x%02" PRIx8 ".",
+		 function,
+		 allocation_flags );
+
+		return( -1 );
+	}
+	if( range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libphdi_internal_handle_get_next_allocation_offset(
+	          internal_handle,
+	          internal_handle->extent_data_file_io_pool,
+	          offset,
+	          allocation_flags,
+	          1,
+	          &data_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve next data offset at or after offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+	}
+	else if( result != 0 )
+	{
+		result = libphdi_internal_handle_get_next_allocation_offset(
+		          internal_handle,
+		          internal_handle->extent_data_file_io_pool,
+		          data_offset,
+		          allocation_flags,
+		          0,
+		          &hole_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next hole offset at or after offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 data_offset,
+			 data_offset );
+		}
+		else
+		{
+			/* The end of the (media) data is considered a hole
+			 */
+			if( result == 0 )
+			{
+				hole_offset = (off64_t) internal_handle->disk_parameters->media_size;
+			}
+			*range_offset = data_offset;
+			*range_size   = (size64_t) ( hole_offset - data_offset );
+
+			result = 1;
+		}
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Adjusts the number of borrowed buffers
+ * The number of borrowed buffers is adjusted by concurrent readers hence it is protected by its own mutex
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_internal_handle_adjust_number_of_borrowed_buffers(
+     libphdi_internal_handle_t *internal_handle,
+     int adjustment,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_internal_handle_adjust_number_of_borrowed_buffers";
+	int result            = 1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( adjustment != -1 )
+	 && ( adjustment != 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported adjustment.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_handle->number_of_borrowed_buffers_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab number of borrowed buffers mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( adjustment == 1 )
+	{
+		internal_handle->number_of_borrowed_buffers += 1;
+	}
+	else if( internal_handle->number_of_borrowed_buffers == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - number of borrowed buffers value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_handle->number_of_borrowed_buffers -= 1;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->number_of_borrowed_buffers_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release number of borrowed buffers mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Borrows a buffer with the (media) data at a specific offset
+ * The buffer references the memory mapped extent data file or shared zero data
+ * for sparse data, hence the data is not copied. The buffer can contain less
+ * data than requested and remains valid until it is released. The data cannot
+ * be borrowed if the extent data file is not memory mapped
+ * Returns 1 if successful, 0 if the data cannot be borrowed or -1 on error
+ */
+int libphdi_handle_borrow_buffer_at_offset(
+     libphdi_handle_t *handle,
+     off64_t offset,
+     size_t maximum_buffer_size,
+     const uint8_t **buffer,
+     size_t *buffer_size,
+     libcerror_error_t **error )
+{
+	libphdi_borrowed_buffers_t *borrowed_buffers = NULL;
+	libphdi_internal_handle_t *internal_handle   = NULL;
+	libphdi_mapped_file_t *mapped_file           = NULL;
+	const uint8_t *safe_buffer                   = NULL;
+	static char *function                        = "libphdi_handle_borrow_buffer_at_offset";
+	size64_t range_size                          = 0;
+	size_t safe_buffer_size                      = 0;
+	off64_t range_file_offset                    = 0;
+	int file_io_pool_entry                       = 0;
+	int result                                   = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_buffer_size == 0 )
+	 || ( maximum_buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	/* The number of borrowed buffers has its own mutex hence the read lock is sufficient
+	 */
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		result = -1;
+	}
+	else if( internal_handle->disk_parameters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing disk parameters.",
+		 function );
+
+		result = -1;
+	}
+	else if( ( internal_handle->mapped_files_array != NULL )
+	      && ( (size64_t) offset < internal_handle->disk_parameters->media_size ) )
+	{
+		result = libphdi_internal_handle_get_data_range_at_offset(
+		          internal_handle,
+		          internal_handle->extent_data_file_io_pool,
+		          offset,
+		          (size64_t) maximum_buffer_size,
+		          &file_io_pool_entry,
+		          &range_file_offset,
+		          &range_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+		}
+		else if( result == 0 )
+		{
+			/* The range is sparse in the current snapshot and all its parents
+			 */
+			borrowed_buffers = internal_handle->zero_data_borrowed_buffers;
+			safe_buffer      = libphdi_handle_zero_data;
+			safe_buffer_size = sizeof( libphdi_handle_zero_data );
+
+			if( (size64_t) safe_buffer_size > range_size )
+			{
+				safe_buffer_size = (size_t) range_size;
+			}
+			result = 1;
+		}
+		else
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_handle->mapped_files_array,
+			     file_io_pool_entry,
+			     (intptr_t **) &mapped_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve mapped file: %d from array.",
+				 function,
+				 file_io_pool_entry );
+
+				result = -1;
+			}
+			else if( mapped_file == NULL )
+			{
+				result = 0;
+			}
+			else
+			{
+				/* The range can be stored in the extent data file of a parent snapshot
+				 */
+				borrowed_buffers = mapped_file->borrowed_buffers;
+
+				result = libphdi_mapped_file_get_data_at_offset(
+				          mapped_file,
+				          range_file_offset,
+				          range_size,
+				          &safe_buffer,
+				          &safe_buffer_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve data at offset: %" PRIi64 " (0x%08" PRIx64 ") from mapped file: %d.",
+					 function,
+					 range_file_offset,
+					 range_file_offset,
+					 file_io_pool_entry );
+				}
+			}
+		}
+		if( result == 1 )
+		{
+			if( libphdi_borrowed_buffers_append_buffer(
+			     borrowed_buffers,
+			     safe_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append borrowed buffer.",
+				 function );
+
+				result = -1;
+			}
+			else if( libphdi_internal_handle_adjust_number_of_borrowed_buffers(
+			          internal_handle,
+			          1,
+			          error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to increment number of borrowed buffers.",
+				 function );
+
+				libphdi_borrowed_buffers_remove_buffer(
+				 borrowed_buffers,
+				 safe_buffer,
+				 NULL );
+
+				result = -1;
+			}
+			else
+			{
+				*buffer      = safe_buffer;
+				*buffer_size = safe_buffer_size;
+			}
+		}
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Releases a buffer borrowed by libphdi_handle_borrow_buffer_at_offset
+ * The buffer must have been borrowed from the same handle
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_release_buffer(
+     libphdi_handle_t *handle,
+     const uint8_t *buffer,
+     libcerror_error_t **error )
+{
+	libphdi_borrowed_buffers_t *borrowed_buffers = NULL;
+	libphdi_internal_handle_t *internal_handle   = NULL;
+	libphdi_mapped_file_t *mapped_file           = NULL;
+	static char *function                        = "libphdi_handle_release_buffer";
+	int mapped_file_index                        = 0;
+	int number_of_mapped_files                   = 0;
+	int result                                   = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	/* The borrowed buffers and the number of borrowed buffers have their own lock
+	 * hence the read lock is sufficient
+	 */
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( buffer >= libphdi_handle_zero_data )
+	 && ( buffer < &( libphdi_handle_zero_data[ sizeof( libphdi_handle_zero_data ) ] ) ) )
+	{
+		borrowed_buffers = internal_handle->zero_data_borrowed_buffers;
+	}
+	else if( internal_handle->mapped_files_array != NULL )
+	{
+		if( libcdata_array_get_number_of_entries(
+		     internal_handle->mapped_files_array,
+		     &number_of_mapped_files,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of mapped files.",
+			 function );
+
+			result = -1;
+		}
+		for( mapped_file_index = 0;
+		     mapped_file_index < number_of_mapped_files;
+		     mapped_file_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_handle->mapped_files_array,
+			     mapped_file_index,
+			     (intptr_t **) &mapped_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve mapped file: %d from array.",
+				 function,
+				 mapped_file_index );
+
+				result = -1;
+
+				break;
+			}
+			if( ( mapped_file != NULL )
+			 && ( mapped_file->data != NULL )
+			 && ( buffer >= mapped_file->data )
+			 && ( buffer < &( mapped_file->data[ mapped_file->data_size ] ) ) )
+			{
+				borrowed_buffers = mapped_file->borrowed_buffers;
+
+				break;
+			}
+		}
+	}
+	if( ( result != -1 )
+	 && ( borrowed_buffers != NULL ) )
+	{
+		result = libphdi_borrowed_buffers_remove_buffer(
+		          borrowed_buffers,
+		          buffer,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove borrowed buffer.",
+			 function );
+		}
+	}
+	if( result == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer - not borrowed.",
+		 function );
+
+		result = -1;
+	}
+	else if( result == 1 )
+	{
+		if( libphdi_internal_handle_adjust_number_of_borrowed_buffers(
+		     internal_handle,
+		     -1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to decrement number of borrowed buffers.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the maximum number of (concurrent) open file handles
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_set_maximum_number_of_open_handles(
+     libphdi_handle_t *handle,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_set_maximum_number_of_open_handles";
+	int result                                 = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->extent_data_file_io_pool != NULL )
+	{
+		if( libbfio_pool_set_maximum_number_of_open_handles(
+		     internal_handle->extent_data_file_io_pool,
+		     maximum_number_of_open_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in extent data file IO pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets if the extent data files should be memory mapped
+ * Memory mapping is applied when the extent data files are opened by the library,
+ * it allows buffers to be borrowed without copying the data. An extent data file
+ * that cannot be mapped, such as an empty file, is read without memory mapping.
+ * The extent data files are mapped shared, hence if an extent data file is
+ * truncated while mapped, accessing the data beyond the new end of the file
+ * raises SIGBUS
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_set_memory_map_extent_data_files(
+     libphdi_handle_t *handle,
+     uint8_t memory_map_extent_data_files,
+     libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_set_memory_map_extent_data_files";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+#if !defined( HAVE_MMAP ) || defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( memory_map_extent_data_files != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: memory mapped extent data files not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( memory_map_extent_data_files != 0 )
+	{
+		internal_handle->memory_map_extent_data_files = 1;
+	}
+	else
+	{
+		internal_handle->memory_map_extent_data_files = 0;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the data block cache size
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_get_data_block_cache_size(
+     libphdi_handle_t *handle,
+     size64_t *cache_size,
+     libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_get_data_block_cache_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( cache_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*cache_size = internal_handle->data_block_cache_size;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the data block cache size
+ * The cache size is rounded down to a multiple of the data block size,
+ * a cache size of 0 disables the data block cache
+ * Cached data blocks are discarded when the cache size is changed
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_set_data_block_cache_size(
+     libphdi_handle_t *handle,
+     size64_t cache_size,
+     libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_set_data_block_cache_size";
+	int result                                 = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( ( cache_size != 0 )
+	 && ( cache_size < LIBPHDI_DATA_BLOCK_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid cache size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libphdi_internal_handle_shares_metadata(
+	     internal_handle ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - parsed metadata is shared with other handles.",
+		 function );
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+#endif
+		return( -1 );
+	}
+	internal_handle->data_block_cache_size = cache_size - ( cache_size % LIBPHDI_DATA_BLOCK_SIZE );
+
+	if( libfcache_cache_free(
+	     &( internal_handle->data_block_cache ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free data block cache.",
+		 function );
+
+		result = -1;
+	}
+	if( ( result == 1 )
+	 && ( internal_handle->current_snapshot_values != NULL ) )
+	{
+		if( libphdi_internal_handle_initialize_data_block_cache(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize data block cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the data block cache statistics
+ * The number of hits and misses are reset when the handle is closed or the statistics are reset
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_get_data_block_cache_statistics(
+     libphdi_handle_t *handle,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_get_data_block_cache_statistics";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_hits = libphdi_statistics_atomic_get(
+	                   &( internal_handle->statistics->values[ LIBPHDI_STATISTIC_DATA_BLOCK_CACHE_HITS ] ) );
+
+	*number_of_misses = libphdi_statistics_atomic_get(
+	                     &( internal_handle->statistics->values[ LIBPHDI_STATISTIC_DATA_BLOCK_CACHE_MISSES ] ) );
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the readahead window size
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_get_readahead_window_size(
+     libphdi_handle_t *handle,
+     size64_t *window_size,
+     libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_get_readahead_window_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( window_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid window size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->readahead == NULL )
+	{
+		*window_size = 0;
+	}
+	else
+	{
+		*window_size = internal_handle->readahead->maximum_window_size;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the readahead window size
+ * Readahead detects sequential reads and prefetches the data ahead of them
+ * into the data block cache on a worker thread. The window size is the maximum
+ * size of the data that is prefetched ahead of a sequential reader, it is rounded
+ * down to a multiple of the data block size and limited to half of the data block
+ * cache size. A window size of 0 disables readahead
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_set_readahead_window_size(
+     libphdi_handle_t *handle,
+     size64_t window_size,
+     libcerror_error_t **error )
+{
+	static char *function                           = "libphdi_handle_set_readahead_window_size";
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *previous_thread_pool = NULL;
+	libcthreads_thread_pool_t *thread_pool          = NULL;
+	libphdi_internal_handle_t *internal_handle      = NULL;
+	libphdi_readahead_t *previous_readahead         = NULL;
+	libphdi_readahead_t *readahead                  = NULL;
+	int result                                      = 1;
+#endif
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( window_size != 0 )
+	 && ( ( window_size < LIBPHDI_DATA_BLOCK_SIZE )
+	  ||  ( window_size > (size64_t) INT64_MAX ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid window size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( window_size != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: readahead requires multi-thread support.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+#else
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( window_size != 0 )
+	{
+		if( libphdi_readahead_initialize(
+		     &readahead,
+		     window_size - ( window_size % LIBPHDI_DATA_BLOCK_SIZE ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create readahead.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     LIBPHDI_READAHEAD_NUMBER_OF_THREADS,
+		     LIBPHDI_READAHEAD_MAXIMUM_NUMBER_OF_PENDING_REQUESTS,
+		     (int (*)(intptr_t *, void *)) &libphdi_internal_handle_readahead_callback,
+		     (void *) internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create readahead thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+	previous_readahead   = internal_handle->readahead;
+	previous_thread_pool = internal_handle->readahead_thread_pool;
+
+	internal_handle->readahead             = readahead;
+	internal_handle->readahead_thread_pool = thread_pool;
+
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	/* The previous thread pool is joined without holding the lock since
+	 * its pending requests need to grab the lock for reading
+	 */
+	if( previous_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &previous_thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join previous readahead thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( previous_readahead != NULL )
+	{
+		if( libphdi_readahead_free(
+		     &previous_readahead,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free previous readahead.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+
+on_error:
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	if( readahead != NULL )
+	{
+		libphdi_readahead_free(
+		 &readahead,
+		 NULL );
+	}
+	return( -1 );
+#endif /* !defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT ) */
+}
+
+/* Retrieves the maximum number of cached extent files
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_get_maximum_number_of_cached_extent_files(
+     libphdi_handle_t *handle,
+     int *maximum_number_of_cached_extent_files,
+     libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_get_maximum_number_of_cached_extent_files";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( maximum_number_of_cached_extent_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of cached extent files.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*maximum_number_of_cached_extent_files = internal_handle->maximum_number_of_cached_extent_files;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum number of cached extent files
+ * Storage images are evicted when the extent files cache contains more than the new maximum
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_set_maximum_number_of_cached_extent_files(
+     libphdi_handle_t *handle,
+     int maximum_number_of_cached_extent_files,
+     libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	libphdi_snapshot_values_t *snapshot_values = NULL;
+	static char *function                      = "libphdi_handle_set_maximum_number_of_cached_extent_files";
+	int number_of_snapshots                    = 0;
+	int result                                 = 1;
+	int snapshot_index                         = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( maximum_number_of_cached_extent_files <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of cached extent files value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libphdi_internal_handle_shares_metadata(
+	     internal_handle ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - parsed metadata is shared with other handles.",
+		 function );
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+#endif
+		return( -1 );
+	}
+	internal_handle->maximum_number_of_cached_extent_files = maximum_number_of_cached_extent_files;
+
+	if( libcdata_array_get_number_of_entries(
+	     internal_handle->snapshot_values_array,
+	     &number_of_snapshots,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of snapshots.",
+		 function );
+
+		result = -1;
+	}
+	for( snapshot_index = 0;
+	     ( result == 1 ) && ( snapshot_index < number_of_snapshots );
+	     snapshot_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_handle->snapshot_values_array,
+		     snapshot_index,
+		     (intptr_t **) &snapshot_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve snapshot values: %d from array.",
+			 function,
+			 snapshot_index );
+
+			result = -1;
+		}
+		else if( libphdi_extent_table_set_maximum_number_of_cached_extent_files(
+		          snapshot_values->extent_table,
+		          maximum_number_of_cached_extent_files,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of cached extent files of snapshot: %d.",
+			 function,
+			 snapshot_index );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the extent files cache statistics
+ * The statistics are the sum of the extent files caches of all snapshots,
+ * a miss means that a storage image file header and block allocation table were read
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_get_extent_files_cache_statistics(
+     libphdi_handle_t *handle,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	libphdi_snapshot_values_t *snapshot_values = NULL;
+	static char *function                      = "libphdi_handle_get_extent_files_cache_statistics";
+	uint64_t snapshot_number_of_hits           = 0;
+	uint64_t snapshot_number_of_misses         = 0;
+	uint64_t safe_number_of_hits               = 0;
+	uint64_t safe_number_of_misses             = 0;
+	int number_of_snapshots                    = 0;
+	int result                                 = 1;
+	int snapshot_index                         = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_number_of_entries(
+	     internal_handle->snapshot_values_array,
+	     &number_of_snapshots,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of snapshots.",
+		 function );
+
+		result = -1;
+	}
+	for( snapshot_index = 0;
+	     ( result == 1 ) && ( snapshot_index < number_of_snapshots );
+	     snapshot_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_handle->snapshot_values_array,
+		     snapshot_index,
+		     (intptr_t **) &snapshot_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve snapshot values: %d from array.",
+			 function,
+			 snapshot_index );
+
+			result = -1;
+		}
+		else if( libphdi_extent_table_get_extent_files_cache_statistics(
+		          snapshot_values->extent_table,
+		          &snapshot_number_of_hits,
+		          &snapshot_number_of_misses,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent files cache statistics of snapshot: %d.",
+			 function,
+			 snapshot_index );
+
+			result = -1;
+		}
+		else
+		{
+			safe_number_of_hits   += snapshot_number_of_hits;
+			safe_number_of_misses += snapshot_number_of_misses;
+		}
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result == 1 )
+	{
+		*number_of_hits   = safe_number_of_hits;
+		*number_of_misses = safe_number_of_misses;
+	}
+	return( result );
+}
+
+/* Retrieves the number of metadata prefetch threads
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_get_number_of_metadata_prefetch_threads(
+     libphdi_handle_t *handle,
+     int *number_of_threads,
+     libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_get_number_of_metadata_prefetch_threads";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( number_of_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of threads.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_threads = internal_handle->number_of_metadata_prefetch_threads;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the number of metadata prefetch threads
+ * When set the storage image file headers and block allocation tables of all snapshots
+ * are read concurrently by the metadata prefetch threads when the extent data files
+ * are opened, instead of when the storage images are first used. The number of threads
+ * is also used by libphdi_handle_warm_metadata. A number of threads of 0 disables
+ * the prefetch at open, which is the default
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_set_number_of_metadata_prefetch_threads(
+     libphdi_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_set_number_of_metadata_prefetch_threads";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBPHDI_METADATA_PREFETCH_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->number_of_metadata_prefetch_threads = number_of_threads;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Reads the storage image metadata of all snapshots up front
+ * The storage image file headers and block allocation tables are read concurrently
+ * by the metadata prefetch threads, or LIBPHDI_METADATA_PREFETCH_NUMBER_OF_THREADS threads
+ * if the number of metadata prefetch threads was not set. At most the maximum number
+ * of cached extent files are read per snapshot
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_warm_metadata(
+     libphdi_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_warm_metadata";
+	int number_of_threads                      = 0;
+	int result                                 = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
 		return( -1 );
 	}
-	if( libphdi_storage_image_get_block_size(
-	     storage_image,
-	     &block_size,
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve block size from storage image.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	result = libphdi_storage_image_get_block_descriptor_at_offset(
-	          storage_image,
-	          storage_image_data_offset,
-	          &block_descriptor,
-	          &block_offset,
-	          error );
-
-	if( result == -1 )
+#endif
+	if( libphdi_internal_handle_shares_metadata(
+	     internal_handle ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve block descriptor at offset: %" PRIi64 " (0x%08" PRIx64 ") from storage image.",
-		 function,
-		 storage_image_data_offset,
-		 storage_image_data_offset );
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - parsed metadata is shared with other handles.",
+		 function );
 
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+#endif
 		return( -1 );
 	}
-	else if( result == 0 )
+	if( internal_handle->extent_data_file_io_pool == NULL )
 	{
-		block_offset = storage_image_data_offset % block_size;
-	}
-	read_size = (size_t) ( block_size - block_offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
 
-	if( read_size > buffer_size )
-	{
-		read_size = buffer_size;
+		result = -1;
 	}
-	if( result != 0 )
+	else
 	{
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: reading block descriptor offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-			 function,
-			 block_descriptor->file_offset,
-			 block_descriptor->file_offset );
-
-			libcnotify_printf(
-			 "%s: reading block offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-			 function,
-			 block_offset,
-			 block_offset );
-
-			libcnotify_printf(
-			 "%s: reading from file IO pool entry: %d\n",
-			 function,
-			 block_descriptor->file_io_pool_entry );
+		internal_handle->io_handle->abort = 0;
 
-			libcnotify_printf(
-			 "%s: reading from offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-			 function,
-			 block_descriptor->file_offset + block_offset,
-			 block_descriptor->file_offset + block_offset );
-		}
-#endif
-		read_count = libbfio_pool_read_buffer_at_offset(
-		              file_io_pool,
-		              block_descriptor->file_io_pool_entry,
-		              buffer,
-		              read_size,
-		              block_descriptor->file_offset + block_offset,
-		              error );
+		number_of_threads = internal_handle->number_of_metadata_prefetch_threads;
 
-		if( read_count == -1 )
+		if( number_of_threads == 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read data from file IO pool entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 block_descriptor->file_io_pool_entry,
-			 block_descriptor->file_offset + block_offset,
-			 block_descriptor->file_offset + block_offset );
-
-			return( -1 );
+			number_of_threads = LIBPHDI_METADATA_PREFETCH_NUMBER_OF_THREADS;
 		}
-	}
-	else if( snapshot_values->parent_snapshot_values != NULL )
-	{
-		read_count = libphdi_internal_handle_read_block_from_file_io_pool(
-			      snapshot_values->parent_snapshot_values,
-		              file_io_pool,
-			      buffer,
-			      read_size,
-			      file_offset,
-			      level + 1,
-			      error );
-
-		if( read_count == -1 )
+		if( libphdi_internal_handle_read_metadata(
+		     internal_handle,
+		     internal_handle->extent_data_file_io_pool,
+		     number_of_threads,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read buffer from parent snapshot at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 file_offset,
-			 file_offset );
+			 "%s: unable to read metadata.",
+			 function );
 
-			return( -1 );
+			result = -1;
 		}
 	}
-	else
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		if( memory_set(
-		     buffer,
-		     0,
-		     read_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to fill buffer with sparse block.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-			return( -1 );
-		}
-		read_count = (ssize_t) read_size;
+		return( -1 );
 	}
-	return( read_count );
+#endif
+	return( result );
 }
 
-/* Reads (media) data at the current offset into a buffer using a Basic File IO (bfio) pool
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read or -1 on error
+/* Retrieves the read statistics
+ * The values are stored in the order of the LIBPHDI_STATISTIC definitions, if the number
+ * of values is smaller than the number of statistics only the first values are retrieved
+ * The statistics are reset when the handle is closed
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libphdi_internal_handle_read_buffer_from_file_io_pool(
-         libphdi_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libphdi_handle_get_statistics(
+     libphdi_handle_t *handle,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error )
 {
-	static char *function = "libphdi_internal_handle_read_buffer_from_file_io_pool";
-	size_t buffer_offset  = 0;
-	size_t read_size      = 0;
-	ssize_t read_count    = 0;
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_get_statistics";
+	int result                                 = 1;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -2970,172 +11889,213 @@ ssize_t libphdi_internal_handle_read_buffer_from_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->disk_parameters == NULL )
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing disk parameters.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_snapshot_values == NULL )
+#endif
+	if( libphdi_statistics_get_values(
+	     internal_handle->statistics,
+	     values,
+	     number_of_values,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing current snapshot values.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistic values.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( internal_handle->current_offset < 0 )
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+#endif
+	return( result );
+}
+
+/* Retrieves the number of bytes read from the snapshot at a specific depth
+ * A depth of 0 represents the current snapshot and 1 its parent
+ * Returns 1 if successful, 0 if the snapshot depth is not tracked or -1 on error
+ */
+int libphdi_handle_get_snapshot_depth_statistics(
+     libphdi_handle_t *handle,
+     int snapshot_depth,
+     uint64_t *number_of_bytes,
+     libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_get_snapshot_depth_statistics";
+	int result                                 = 0;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid element data size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->io_handle->abort = 0;
+#endif
+	result = libphdi_statistics_get_snapshot_depth_value(
+	          internal_handle->statistics,
+	          snapshot_depth,
+	          number_of_bytes,
+	          error );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( result == -1 )
 	{
-		libcnotify_printf(
-		 "%s: requested offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of bytes read from snapshot depth: %d.",
 		 function,
-		 internal_handle->current_offset,
-		 internal_handle->current_offset );
-	}
-#endif
-	if( (size64_t) internal_handle->current_offset >= internal_handle->disk_parameters->media_size )
-	{
-		return( 0 );
+		 snapshot_depth );
 	}
-	if( internal_handle->current_snapshot_values->extent_table->extent_files_stream != NULL )
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		read_size = buffer_size;
-
-		if( ( (size64_t) read_size > internal_handle->disk_parameters->media_size )
-		 || ( (size64_t) internal_handle->current_offset > ( internal_handle->disk_parameters->media_size - read_size ) ) )
-		{
-			read_size = (size_t) ( internal_handle->disk_parameters->media_size - internal_handle->current_offset );
-		}
-		read_count = libfdata_stream_read_buffer_at_offset(
-		              internal_handle->current_snapshot_values->extent_table->extent_files_stream,
-			      (intptr_t *) file_io_pool,
-			      (uint8_t *) buffer,
-			      read_size,
-			      internal_handle->current_offset,
-			      0,
-			      error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-		if( read_count != (ssize_t) read_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read buffer from extent files stream at offset: %" PRIi64 " (0x%" PRIx64 ").",
-			 function,
-			 internal_handle->current_offset,
-			 internal_handle->current_offset );
+		return( -1 );
+	}
+#endif
+	return( result );
+}
 
-			return( -1 );
-		}
-		buffer_offset = read_size;
+/* Resets the read statistics
+ * The statistic values are updated atomically hence the read lock is sufficient
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_handle_reset_statistics(
+     libphdi_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_reset_statistics";
+	int result                                 = 1;
 
-		internal_handle->current_offset += (off64_t) read_size;
-	}
-	else
+	if( handle == NULL )
 	{
-		while( buffer_offset < buffer_size )
-		{
-			read_size = buffer_size - buffer_offset;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-			if( ( (size64_t) read_size > internal_handle->disk_parameters->media_size )
-			 || ( (size64_t) internal_handle->current_offset > ( internal_handle->disk_parameters->media_size - read_size ) ) )
-			{
-				read_size = (size_t) ( internal_handle->disk_parameters->media_size - internal_handle->current_offset );
-			}
-			read_count = libphdi_internal_handle_read_block_from_file_io_pool(
-				      internal_handle->current_snapshot_values,
-			              file_io_pool,
-				      &(( (uint8_t *) buffer )[ buffer_offset ] ),
-				      read_size,
-				      internal_handle->current_offset,
-				      0,
-				      error );
+		return( -1 );
+	}
+	internal_handle = (libphdi_internal_handle_t *) handle;
 
-			if( read_count == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read buffer from current snapshot.",
-				 function );
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
 
-				return( -1 );
-			}
-			buffer_offset += read_count;
+		return( -1 );
+	}
+#endif
+	if( libphdi_statistics_reset(
+	     internal_handle->statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to reset statistics.",
+		 function );
 
-			internal_handle->current_offset += (off64_t) read_count;
+		result = -1;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-			if( (size64_t) internal_handle->current_offset >= internal_handle->disk_parameters->media_size )
-			{
-				break;
-			}
-			if( internal_handle->io_handle->abort != 0 )
-			{
-				break;
-			}
-		}
+		return( -1 );
 	}
-	return( (ssize_t) buffer_offset );
+#endif
+	return( result );
 }
 
-/* Reads (media) data from the current offset into a buffer
- * Returns the number of bytes read or -1 on error
+/* Sets if the time spent in IO should be measured
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libphdi_handle_read_buffer(
-         libphdi_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libphdi_handle_set_measure_io_time(
+     libphdi_handle_t *handle,
+     uint8_t measure_io_time,
+     libcerror_error_t **error )
 {
 	libphdi_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libphdi_handle_read_buffer";
-	ssize_t read_count                         = 0;
+	static char *function                      = "libphdi_handle_set_measure_io_time";
 
 	if( handle == NULL )
 	{
@@ -3150,13 +12110,13 @@ ssize_t libphdi_handle_read_buffer(
 	}
 	internal_handle = (libphdi_internal_handle_t *) handle;
 
-	if( internal_handle->extent_data_file_io_pool == NULL )
+	if( internal_handle->statistics == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing extent data file IO pool.",
+		 "%s: invalid handle - missing statistics.",
 		 function );
 
 		return( -1 );
@@ -3176,23 +12136,13 @@ ssize_t libphdi_handle_read_buffer(
 		return( -1 );
 	}
 #endif
-	read_count = libphdi_internal_handle_read_buffer_from_file_io_pool(
-		      internal_handle,
-	              internal_handle->extent_data_file_io_pool,
-		      buffer,
-		      buffer_size,
-		      error );
-
-	if( read_count == -1 )
+	if( measure_io_time != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
-
-		read_count = -1;
+		internal_handle->statistics->measure_io_time = 1;
+	}
+	else
+	{
+		internal_handle->statistics->measure_io_time = 0;
 	}
 #if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -3209,22 +12159,21 @@ ssize_t libphdi_handle_read_buffer(
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( 1 );
 }
 
-/* Reads (media) data at a specific offset
- * Returns the number of bytes read or -1 on error
+/* Sets the path to the extent data files
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libphdi_handle_read_buffer_at_offset(
-         libphdi_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libphdi_handle_set_extent_data_files_path(
+     libphdi_handle_t *handle,
+     const char *path,
+     size_t path_length,
+     libcerror_error_t **error )
 {
 	libphdi_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libphdi_handle_read_buffer_at_offset";
-	ssize_t read_count                         = 0;
+	static char *function                      = "libphdi_handle_set_extent_data_files_path";
+	int result                                 = 1;
 
 	if( handle == NULL )
 	{
@@ -3239,13 +12188,24 @@ ssize_t libphdi_handle_read_buffer_at_offset(
 	}
 	internal_handle = (libphdi_internal_handle_t *) handle;
 
-	if( internal_handle->extent_data_file_io_pool == NULL )
+	if( path == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing extent data file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_length > (size_t) ( SSIZE_MAX - 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid path length value exceeds maximum.",
 		 function );
 
 		return( -1 );
@@ -3265,41 +12225,37 @@ ssize_t libphdi_handle_read_buffer_at_offset(
 		return( -1 );
 	}
 #endif
-	if( libphdi_internal_handle_seek_offset(
-	     internal_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( libphdi_internal_handle_shares_metadata(
+	     internal_handle ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - parsed metadata is shared with other handles.",
 		 function );
 
-		read_count = -1;
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+#endif
+		return( -1 );
 	}
-	else
+	if( libphdi_data_files_set_path(
+	     internal_handle->data_files,
+	     path,
+	     path_length,
+	     error ) != 1 )
 	{
-		read_count = libphdi_internal_handle_read_buffer_from_file_io_pool(
-			      internal_handle,
-		              internal_handle->extent_data_file_io_pool,
-			      buffer,
-			      buffer_size,
-			      error );
-
-		if( read_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read buffer.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set data files path.",
+		 function );
 
-			read_count = -1;
-		}
+		result = -1;
 	}
 #if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -3316,22 +12272,25 @@ ssize_t libphdi_handle_read_buffer_at_offset(
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( result );
 }
 
-/* Seeks a certain offset of the (media) data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets the path to the extent data files
+ * Returns 1 if successful or -1 on error
  */
-off64_t libphdi_internal_handle_seek_offset(
-         libphdi_internal_handle_t *internal_handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libphdi_handle_set_extent_data_files_path_wide(
+     libphdi_handle_t *handle,
+     const wchar_t *path,
+     size_t path_length,
+     libcerror_error_t **error )
 {
-	static char *function = "libphdi_handle_seek_offset";
+	libphdi_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libphdi_handle_set_extent_data_files_path_wide";
+	int result                                 = 1;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -3342,65 +12301,111 @@ off64_t libphdi_internal_handle_seek_offset(
 
 		return( -1 );
 	}
-	if( internal_handle->disk_parameters == NULL )
+	internal_handle = (libphdi_internal_handle_t *) handle;
+
+	if( path == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing disk parameters.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+	if( path_length > (size_t) ( SSIZE_MAX - 1 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid path length value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( whence == SEEK_CUR )
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		offset += internal_handle->current_offset;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
 	}
-	else if( whence == SEEK_END )
+#endif
+	if( libphdi_internal_handle_shares_metadata(
+	     internal_handle ) != 0 )
 	{
-		offset += (off64_t) internal_handle->disk_parameters->media_size;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - parsed metadata is shared with other handles.",
+		 function );
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+#endif
+		return( -1 );
+	}
+	if( libphdi_data_files_set_path_wide(
+	     internal_handle->data_files,
+	     path,
+	     path_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set data files path.",
+		 function );
+
+		result = -1;
 	}
-	if( offset < 0 )
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->current_offset = offset;
-
-	return( offset );
+#endif
+	return( result );
 }
 
-/* Seeks a certain offset of the (media) data
- * Returns the offset if seek is successful or -1 on error
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Sets the filename of the metadata index
+ * The metadata index caches the parsed disk descriptor and storage image metadata,
+ * it is read on open and (re)written if it is missing or does not match the image
+ * Returns 1 if successful or -1 on error
  */
-off64_t libphdi_handle_seek_offset(
-         libphdi_handle_t *handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libphdi_handle_set_metadata_index_filename(
+     libphdi_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
 {
 	libphdi_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libphdi_handle_seek_offset";
+	static char *function                      = "libphdi_handle_set_metadata_index_filename";
+	int result                                 = 1;
 
 	if( handle == NULL )
 	{
@@ -3415,13 +12420,25 @@ off64_t libphdi_handle_seek_offset(
 	}
 	internal_handle = (libphdi_internal_handle_t *) handle;
 
-	if( internal_handle->extent_data_file_io_pool == NULL )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing extent data file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( filename_length == 0 )
+	 || ( filename_length > (size_t) ( SSIZE_MAX - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
 		 function );
 
 		return( -1 );
@@ -3441,22 +12458,39 @@ off64_t libphdi_handle_seek_offset(
 		return( -1 );
 	}
 #endif
-	offset = libphdi_internal_handle_seek_offset(
-	          internal_handle,
-	          offset,
-	          whence,
-	          error );
+	if( internal_handle->metadata_index == NULL )
+	{
+		if( libphdi_metadata_index_initialize(
+		     &( internal_handle->metadata_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create metadata index.",
+			 function );
 
-	if( offset == -1 )
+			result = -1;
+		}
+	}
+	if( result == 1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
+		if( libphdi_metadata_index_set_filename(
+		     internal_handle->metadata_index,
+		     filename,
+		     filename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set metadata index filename.",
+			 function );
 
-		offset = -1;
+			result = -1;
+		}
 	}
 #if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -3473,19 +12507,25 @@ off64_t libphdi_handle_seek_offset(
 		return( -1 );
 	}
 #endif
-	return( offset );
+	return( result );
 }
 
-/* Retrieves the current offset of the (media) data
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets the filename of the metadata index
+ * The metadata index caches the parsed disk descriptor and storage image metadata,
+ * it is read on open and (re)written if it is missing or does not match the image
  * Returns 1 if successful or -1 on error
  */
-int libphdi_handle_get_offset(
+int libphdi_handle_set_metadata_index_filename_wide(
      libphdi_handle_t *handle,
-     off64_t *offset,
+     const wchar_t *filename,
+     size_t filename_length,
      libcerror_error_t **error )
 {
 	libphdi_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libphdi_handle_get_offset";
+	static char *function                      = "libphdi_handle_set_metadata_index_filename_wide";
+	int result                                 = 1;
 
 	if( handle == NULL )
 	{
@@ -3500,30 +12540,31 @@ int libphdi_handle_get_offset(
 	}
 	internal_handle = (libphdi_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_handle == NULL )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( offset == NULL )
+	if( ( filename_length == 0 )
+	 || ( filename_length > (size_t) ( SSIZE_MAX - 1 ) ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3531,16 +12572,48 @@ int libphdi_handle_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	*offset = internal_handle->current_offset;
+	if( internal_handle->metadata_index == NULL )
+	{
+		if( libphdi_metadata_index_initialize(
+		     &( internal_handle->metadata_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create metadata index.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libphdi_metadata_index_set_filename_wide(
+		     internal_handle->metadata_index,
+		     filename,
+		     filename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set metadata index filename.",
+			 function );
 
+			result = -1;
+		}
+	}
 #if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3548,25 +12621,31 @@ int libphdi_handle_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 }
 
-/* Sets the maximum number of (concurrent) open file handles
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Sets the storage image registry
+ * The registry shares identical storage image block allocation tables, such as those
+ * of a base image, between handles. The registry is not managed by the handle and must
+ * be freed after the handle. Use NULL to not share block allocation tables
+ * This function needs to be called before the extent data files are opened
  * Returns 1 if successful or -1 on error
  */
-int libphdi_handle_set_maximum_number_of_open_handles(
+int libphdi_handle_set_storage_image_registry(
      libphdi_handle_t *handle,
-     int maximum_number_of_open_handles,
+     libphdi_storage_image_registry_t *storage_image_registry,
      libcerror_error_t **error )
 {
 	libphdi_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libphdi_handle_set_maximum_number_of_open_handles";
+	static char *function                      = "libphdi_handle_set_storage_image_registry";
 	int result                                 = 1;
 
 	if( handle == NULL )
@@ -3599,24 +12678,18 @@ int libphdi_handle_set_maximum_number_of_open_handles(
 #endif
 	if( internal_handle->extent_data_file_io_pool != NULL )
 	{
-		if( libbfio_pool_set_maximum_number_of_open_handles(
-		     internal_handle->extent_data_file_io_pool,
-		     maximum_number_of_open_handles,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set maximum number of open handles in extent data file IO pool.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - extent data file IO pool already exists.",
+		 function );
 
-			result = -1;
-		}
+		result = -1;
 	}
-	if( result == 1 )
+	else
 	{
-		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+		internal_handle->storage_image_registry = storage_image_registry;
 	}
 #if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -3636,17 +12709,24 @@ int libphdi_handle_set_maximum_number_of_open_handles(
 	return( result );
 }
 
-/* Sets the path to the extent data files
+/* Sets the shared data cache
+ * The data cache caches the data of the extent data files of multiple handles within
+ * a single memory budget. Data is cached by extent data file and offset so that data
+ * of a parent snapshot, that is shared between handles, is cached once. Both expanding
+ * and plain disk images take part in the memory budget. The data cache
+ * is not managed by the handle and must be freed after the handle. Use NULL to use
+ * the data block cache of the handle
+ * The data cache is not used when the extent data files are opened with a file IO pool
+ * This function needs to be called before the extent data files are opened
  * Returns 1 if successful or -1 on error
  */
-int libphdi_handle_set_extent_data_files_path(
+int libphdi_handle_set_data_cache(
      libphdi_handle_t *handle,
-     const char *path,
-     size_t path_length,
+     libphdi_data_cache_t *data_cache,
      libcerror_error_t **error )
 {
 	libphdi_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libphdi_handle_set_extent_data_files_path";
+	static char *function                      = "libphdi_handle_set_data_cache";
 	int result                                 = 1;
 
 	if( handle == NULL )
@@ -3662,28 +12742,6 @@ int libphdi_handle_set_extent_data_files_path(
 	}
 	internal_handle = (libphdi_internal_handle_t *) handle;
 
-	if( path == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid path.",
-		 function );
-
-		return( -1 );
-	}
-	if( path_length > (size_t) ( SSIZE_MAX - 1 ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid path length value exceeds maximum.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -3699,21 +12757,21 @@ int libphdi_handle_set_extent_data_files_path(
 		return( -1 );
 	}
 #endif
-	if( libphdi_data_files_set_path(
-	     internal_handle->data_files,
-	     path,
-	     path_length,
-	     error ) != 1 )
+	if( internal_handle->extent_data_file_io_pool != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set data files path.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - extent data file IO pool already exists.",
 		 function );
 
 		result = -1;
 	}
+	else
+	{
+		internal_handle->data_cache = data_cache;
+	}
 #if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -3732,19 +12790,16 @@ int libphdi_handle_set_extent_data_files_path(
 	return( result );
 }
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
-
-/* Sets the path to the extent data files
+/* Retrieves the size of the data in the shared data cache that was added by the handle
  * Returns 1 if successful or -1 on error
  */
-int libphdi_handle_set_extent_data_files_path_wide(
+int libphdi_handle_get_data_cache_size(
      libphdi_handle_t *handle,
-     const wchar_t *path,
-     size_t path_length,
+     size64_t *cache_size,
      libcerror_error_t **error )
 {
 	libphdi_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libphdi_handle_set_extent_data_files_path_wide";
+	static char *function                      = "libphdi_handle_get_data_cache_size";
 	int result                                 = 1;
 
 	if( handle == NULL )
@@ -3760,30 +12815,19 @@ int libphdi_handle_set_extent_data_files_path_wide(
 	}
 	internal_handle = (libphdi_internal_handle_t *) handle;
 
-	if( path == NULL )
+	if( cache_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid path.",
-		 function );
-
-		return( -1 );
-	}
-	if( path_length > (size_t) ( SSIZE_MAX - 1 ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid path length value exceeds maximum.",
+		 "%s: invalid cache size.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3791,29 +12835,32 @@ int libphdi_handle_set_extent_data_files_path_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( libphdi_data_files_set_path_wide(
-	     internal_handle->data_files,
-	     path,
-	     path_length,
-	     error ) != 1 )
+	if( internal_handle->data_cache_client == NULL )
+	{
+		*cache_size = 0;
+	}
+	else if( libphdi_data_cache_client_get_cache_size(
+	          internal_handle->data_cache_client,
+	          cache_size,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set data files path.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data cache size.",
 		 function );
 
 		result = -1;
 	}
 #if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3821,7 +12868,7 @@ int libphdi_handle_set_extent_data_files_path_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
@@ -3830,8 +12877,6 @@ int libphdi_handle_set_extent_data_files_path_wide(
 	return( result );
 }
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
-
 /* Retrieves the number of media size
  * Returns 1 if successful or -1 on error
  */
@@ -25,17 +25,27 @@
 #include <common.h>
 #include <types.h>
 
+#include "libphdi_borrowed_buffers.h"
+#include "libphdi_completion_queue.h"
+#include "libphdi_data_cache.h"
 #include "libphdi_data_files.h"
 #include "libphdi_disk_parameters.h"
 #include "libphdi_extern.h"
 #include "libphdi_io_handle.h"
+#include "libphdi_layer_map.h"
 #include "libphdi_libbfio.h"
 #include "libphdi_libcdata.h"
 #include "libphdi_libcerror.h"
 #include "libphdi_libcthreads.h"
 #include "libphdi_libfcache.h"
 #include "libphdi_libfdata.h"
+#include "libphdi_metadata_index.h"
+#include "libphdi_metadata_request.h"
+#include "libphdi_read_request.h"
+#include "libphdi_readahead.h"
 #include "libphdi_snapshot_values.h"
+#include "libphdi_statistics.h"
+#include "libphdi_storage_image_registry.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -93,14 +103,30 @@ struct libphdi_internal_handle
 	 */
 	libphdi_disk_parameters_t *disk_parameters;
 
-	/* The data block vector
+	/* The layer map, used to resolve blocks of a snapshot chain in a single lookup
 	 */
-	libfdata_vector_t *data_block_vector;
+	libphdi_layer_map_t *layer_map;
 
 	/* The data block cache
 	 */
 	libfcache_cache_t *data_block_cache;
 
+	/* The data block cache size
+	 */
+	size64_t data_block_cache_size;
+
+	/* The read statistics
+	 */
+	libphdi_statistics_t *statistics;
+
+	/* The readahead
+	 */
+	libphdi_readahead_t *readahead;
+
+	/* The completion queue of the asynchronous reads
+	 */
+	libphdi_completion_queue_t *completion_queue;
+
 	/* The extent data file IO pool
 	 */
 	libbfio_pool_t *extent_data_file_io_pool;
@@ -109,6 +135,22 @@ struct libphdi_internal_handle
 	 */
 	uint8_t extent_data_file_io_pool_created_in_library;
 
+	/* Value to indicate if the extent data files should be memory mapped
+	 */
+	uint8_t memory_map_extent_data_files;
+
+	/* The memory mapped extent data files array
+	 */
+	libcdata_array_t *mapped_files_array;
+
+	/* The buffers borrowed from the shared zero data
+	 */
+	libphdi_borrowed_buffers_t *zero_data_borrowed_buffers;
+
+	/* The number of borrowed buffers
+	 */
+	uint64_t number_of_borrowed_buffers;
+
 	/* The access flags
 	 */
 	int access_flags;
@@ -117,10 +159,62 @@ struct libphdi_internal_handle
 	 */
 	int maximum_number_of_open_handles;
 
+	/* The maximum number of storage images in the extent files cache of a snapshot
+	 */
+	int maximum_number_of_cached_extent_files;
+
+	/* The number of threads used to prefetch the storage image metadata
+	 */
+	int number_of_metadata_prefetch_threads;
+
+	/* The metadata index
+	 */
+	libphdi_metadata_index_t *metadata_index;
+
+	/* The storage image registry, which is managed by the user
+	 */
+	libphdi_storage_image_registry_t *storage_image_registry;
+
+	/* The shared data cache, which is managed by the user
+	 */
+	libphdi_data_cache_t *data_cache;
+
+	/* The client of the shared data cache
+	 */
+	libphdi_data_cache_client_t *data_cache_client;
+
+	/* The parent handle, of which a clone shares the parsed metadata
+	 */
+	libphdi_internal_handle_t *parent_handle;
+
+	/* The number of clones that share the parsed metadata of the handle
+	 */
+	int number_of_clones;
+
+	/* Value to indicate the handle is freed when its last clone is freed
+	 */
+	uint8_t free_on_last_clone;
+
 #if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
+
+	/* The data block cache read/write lock
+	 */
+	libcthreads_read_write_lock_t *data_block_cache_read_write_lock;
+
+	/* The number of borrowed buffers mutex
+	 */
+	libcthreads_mutex_t *number_of_borrowed_buffers_mutex;
+
+	/* The readahead thread pool
+	 */
+	libcthreads_thread_pool_t *readahead_thread_pool;
+
+	/* The asynchronous read thread pool
+	 */
+	libcthreads_thread_pool_t *async_read_thread_pool;
 #endif
 };
 
@@ -134,6 +228,20 @@ int libphdi_handle_free(
      libphdi_handle_t **handle,
      libcerror_error_t **error );
 
+LIBPHDI_EXTERN \
+int libphdi_handle_clone(
+     libphdi_handle_t **destination_handle,
+     libphdi_handle_t *source_handle,
+     uint8_t clone_flags,
+     libcerror_error_t **error );
+
+int libphdi_internal_handle_close_clone(
+     libphdi_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libphdi_internal_handle_shares_metadata(
+     libphdi_internal_handle_t *internal_handle );
+
 LIBPHDI_EXTERN \
 int libphdi_handle_signal_abort(
      libphdi_handle_t *handle,
@@ -208,6 +316,118 @@ int libphdi_internal_handle_open_read_extent_data_files(
      libbfio_pool_t *file_io_pool,
      libcerror_error_t **error );
 
+int libphdi_internal_handle_read_metadata_index(
+     libphdi_internal_handle_t *internal_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libphdi_internal_handle_update_metadata_index(
+     libphdi_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
+int libphdi_internal_handle_read_metadata(
+     libphdi_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libphdi_internal_handle_get_layer_map_block_size(
+     libphdi_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     size64_t *block_size,
+     libcerror_error_t **error );
+
+int libphdi_internal_handle_initialize_data_block_cache(
+     libphdi_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+ssize_t libphdi_internal_handle_copy_from_data_block_cache(
+         libphdi_internal_handle_t *internal_handle,
+         int cache_entry_index,
+         off64_t data_block_offset,
+         size_t data_offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+ssize_t libphdi_internal_handle_read_data_block_from_file_io_pool(
+         libphdi_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+ssize_t libphdi_internal_handle_read_data_block_from_data_cache(
+         libphdi_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+ssize_t libphdi_internal_handle_read_data_blocks_from_data_cache(
+         libphdi_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int libphdi_internal_handle_get_uncached_data_blocks_size(
+     libphdi_internal_handle_t *internal_handle,
+     off64_t offset,
+     size_t maximum_size,
+     size_t *uncached_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+
+int libphdi_internal_handle_readahead(
+     libphdi_internal_handle_t *internal_handle,
+     off64_t offset,
+     size64_t read_size,
+     libcerror_error_t **error );
+
+int libphdi_internal_handle_readahead_callback(
+     libphdi_readahead_request_t *request,
+     libphdi_internal_handle_t *internal_handle );
+
+int libphdi_internal_handle_metadata_request_callback(
+     libphdi_metadata_request_t *metadata_request,
+     libphdi_internal_handle_t *internal_handle );
+
+int libphdi_internal_handle_async_read_callback(
+     libphdi_read_request_t *read_request,
+     libphdi_internal_handle_t *internal_handle );
+
+#endif /* defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT ) */
+
+ssize_t libphdi_internal_handle_read_layer_map_range_from_file_io_pool(
+         libphdi_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+ssize_t libphdi_internal_handle_read_data_from_file_io_pool(
+         libphdi_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+ssize_t libphdi_internal_handle_read_buffer_at_offset_from_file_io_pool(
+         libphdi_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 ssize_t libphdi_internal_handle_read_buffer_from_file_io_pool(
          libphdi_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -230,6 +450,43 @@ ssize_t libphdi_handle_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+LIBPHDI_EXTERN \
+int libphdi_handle_read_vector(
+     libphdi_handle_t *handle,
+     void **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_requests,
+     libcerror_error_t **error );
+
+int libphdi_internal_handle_initialize_async_read(
+     libphdi_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_submit_read_buffer_at_offset(
+     libphdi_handle_t *handle,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     intptr_t user_data,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_get_completed_read(
+     libphdi_handle_t *handle,
+     uint8_t wait,
+     intptr_t *user_data,
+     ssize_t *read_count,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_get_number_of_outstanding_reads(
+     libphdi_handle_t *handle,
+     int *number_of_outstanding_reads,
+     libcerror_error_t **error );
+
 off64_t libphdi_internal_handle_seek_offset(
          libphdi_internal_handle_t *internal_handle,
          off64_t offset,
@@ -249,12 +506,182 @@ int libphdi_handle_get_offset(
      off64_t *offset,
      libcerror_error_t **error );
 
+int libphdi_internal_handle_get_data_range_at_offset(
+     libphdi_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     size64_t maximum_range_size,
+     int *file_io_pool_entry,
+     off64_t *range_file_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+int libphdi_internal_handle_get_allocation_range_at_offset(
+     libphdi_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     uint8_t allocation_flags,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+int libphdi_internal_handle_get_next_allocation_offset(
+     libphdi_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     uint8_t allocation_flags,
+     uint8_t is_allocated,
+     off64_t *next_offset,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_get_next_data_offset(
+     libphdi_handle_t *handle,
+     off64_t offset,
+     uint8_t allocation_flags,
+     off64_t *data_offset,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_get_next_hole_offset(
+     libphdi_handle_t *handle,
+     off64_t offset,
+     uint8_t allocation_flags,
+     off64_t *hole_offset,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_get_allocated_range(
+     libphdi_handle_t *handle,
+     off64_t offset,
+     uint8_t allocation_flags,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+int libphdi_internal_handle_adjust_number_of_borrowed_buffers(
+     libphdi_internal_handle_t *internal_handle,
+     int adjustment,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_borrow_buffer_at_offset(
+     libphdi_handle_t *handle,
+     off64_t offset,
+     size_t maximum_buffer_size,
+     const uint8_t **buffer,
+     size_t *buffer_size,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_release_buffer(
+     libphdi_handle_t *handle,
+     const uint8_t *buffer,
+     libcerror_error_t **error );
+
 LIBPHDI_EXTERN \
 int libphdi_handle_set_maximum_number_of_open_handles(
      libphdi_handle_t *handle,
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+LIBPHDI_EXTERN \
+int libphdi_handle_set_memory_map_extent_data_files(
+     libphdi_handle_t *handle,
+     uint8_t memory_map_extent_data_files,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_get_data_block_cache_size(
+     libphdi_handle_t *handle,
+     size64_t *cache_size,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_set_data_block_cache_size(
+     libphdi_handle_t *handle,
+     size64_t cache_size,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_get_data_block_cache_statistics(
+     libphdi_handle_t *handle,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_get_readahead_window_size(
+     libphdi_handle_t *handle,
+     size64_t *window_size,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_set_readahead_window_size(
+     libphdi_handle_t *handle,
+     size64_t window_size,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_get_maximum_number_of_cached_extent_files(
+     libphdi_handle_t *handle,
+     int *maximum_number_of_cached_extent_files,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_set_maximum_number_of_cached_extent_files(
+     libphdi_handle_t *handle,
+     int maximum_number_of_cached_extent_files,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_get_extent_files_cache_statistics(
+     libphdi_handle_t *handle,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_get_number_of_metadata_prefetch_threads(
+     libphdi_handle_t *handle,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_set_number_of_metadata_prefetch_threads(
+     libphdi_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_warm_metadata(
+     libphdi_handle_t *handle,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_get_statistics(
+     libphdi_handle_t *handle,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_get_snapshot_depth_statistics(
+     libphdi_handle_t *handle,
+     int snapshot_depth,
+     uint64_t *number_of_bytes,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_reset_statistics(
+     libphdi_handle_t *handle,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_set_measure_io_time(
+     libphdi_handle_t *handle,
+     uint8_t measure_io_time,
+     libcerror_error_t **error );
+
 LIBPHDI_EXTERN \
 int libphdi_handle_set_extent_data_files_path(
      libphdi_handle_t *handle,
@@ -273,6 +700,42 @@ int libphdi_handle_set_extent_data_files_path_wide(
 
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
+LIBPHDI_EXTERN \
+int libphdi_handle_set_metadata_index_filename(
+     libphdi_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBPHDI_EXTERN \
+int libphdi_handle_set_metadata_index_filename_wide(
+     libphdi_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBPHDI_EXTERN \
+int libphdi_handle_set_storage_image_registry(
+     libphdi_handle_t *handle,
+     libphdi_storage_image_registry_t *storage_image_registry,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_set_data_cache(
+     libphdi_handle_t *handle,
+     libphdi_data_cache_t *data_cache,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_handle_get_data_cache_size(
+     libphdi_handle_t *handle,
+     size64_t *cache_size,
+     libcerror_error_t **error );
+
 LIBPHDI_EXTERN \
 int libphdi_handle_get_media_size(
      libphdi_handle_t *handle,
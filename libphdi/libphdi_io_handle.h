@@ -39,6 +39,10 @@ struct libphdi_io_handle
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
+
+	/* The abort generation, incremented every time abort is signalled
+	 */
+	uint32_t abort_generation;
 };
 
 int libphdi_io_handle_initialize(
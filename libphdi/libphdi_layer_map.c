@@ -0,0 +1,938 @@
+/*
+ * Layer map functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libphdi_definitions.h"
+#include "libphdi_extent_table.h"
+#include "libphdi_layer_map.h"
+#include "libphdi_libbfio.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_libcnotify.h"
+#include "libphdi_libcthreads.h"
+#include "libphdi_snapshot_values.h"
+
+/* Creates a layer map
+ * Make sure the value layer_map is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_layer_map_initialize(
+     libphdi_layer_map_t **layer_map,
+     size64_t media_size,
+     size64_t block_size,
+     libcerror_error_t **error )
+{
+	static char *function      = "libphdi_layer_map_initialize";
+	size_t regions_size        = 0;
+	uint64_t number_of_blocks  = 0;
+	uint64_t number_of_regions = 0;
+
+	if( layer_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layer map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *layer_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid layer map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_size == 0 )
+	 || ( block_size > (size64_t) INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_blocks = media_size / block_size;
+
+	if( ( media_size % block_size ) != 0 )
+	{
+		number_of_blocks += 1;
+	}
+	number_of_regions = number_of_blocks / LIBPHDI_LAYER_MAP_NUMBER_OF_ENTRIES_PER_REGION;
+
+	if( ( number_of_blocks % LIBPHDI_LAYER_MAP_NUMBER_OF_ENTRIES_PER_REGION ) != 0 )
+	{
+		number_of_regions += 1;
+	}
+	if( number_of_regions > ( (uint64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libphdi_layer_map_entry_t * ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of regions value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*layer_map = memory_allocate_structure(
+	              libphdi_layer_map_t );
+
+	if( *layer_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create layer map.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *layer_map,
+	     0,
+	     sizeof( libphdi_layer_map_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear layer map.",
+		 function );
+
+		memory_free(
+		 *layer_map );
+
+		*layer_map = NULL;
+
+		return( -1 );
+	}
+	if( number_of_regions > 0 )
+	{
+		regions_size = (size_t) number_of_regions * sizeof( libphdi_layer_map_entry_t * );
+
+		( *layer_map )->regions = (libphdi_layer_map_entry_t **) memory_allocate(
+		                                                          regions_size );
+
+		if( ( *layer_map )->regions == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create regions.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     ( *layer_map )->regions,
+		     0,
+		     regions_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear regions.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *layer_map )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *layer_map )->media_size        = media_size;
+	( *layer_map )->block_size        = block_size;
+	( *layer_map )->number_of_blocks  = number_of_blocks;
+	( *layer_map )->number_of_regions = number_of_regions;
+
+	return( 1 );
+
+on_error:
+	if( *layer_map != NULL )
+	{
+		if( ( *layer_map )->regions != NULL )
+		{
+			memory_free(
+			 ( *layer_map )->regions );
+		}
+		memory_free(
+		 *layer_map );
+
+		*layer_map = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a layer map
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_layer_map_free(
+     libphdi_layer_map_t **layer_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_layer_map_free";
+	uint64_t region_index = 0;
+	int result            = 1;
+
+	if( layer_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layer map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *layer_map != NULL )
+	{
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *layer_map )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( ( *layer_map )->regions != NULL )
+		{
+			for( region_index = 0;
+			     region_index < ( *layer_map )->number_of_regions;
+			     region_index++ )
+			{
+				if( ( *layer_map )->regions[ region_index ] != NULL )
+				{
+					memory_free(
+					 ( *layer_map )->regions[ region_index ] );
+				}
+			}
+			memory_free(
+			 ( *layer_map )->regions );
+		}
+		memory_free(
+		 *layer_map );
+
+		*layer_map = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves a specific entry
+ * An entry of a region that has not been allocated yet is returned as unresolved
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_layer_map_get_entry_by_index(
+     libphdi_layer_map_t *layer_map,
+     uint64_t block_index,
+     libphdi_layer_map_entry_t *entry,
+     libcerror_error_t **error )
+{
+	libphdi_layer_map_entry_t *region = NULL;
+	static char *function             = "libphdi_layer_map_get_entry_by_index";
+	uint64_t region_index             = 0;
+
+	if( layer_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layer map.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_index >= layer_map->number_of_blocks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	region_index = block_index / LIBPHDI_LAYER_MAP_NUMBER_OF_ENTRIES_PER_REGION;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     layer_map->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	region = layer_map->regions[ region_index ];
+
+	if( region == NULL )
+	{
+		entry->file_offset        = 0;
+		entry->file_io_pool_entry = -1;
+		entry->layer              = 0;
+		entry->type               = LIBPHDI_LAYER_MAP_ENTRY_TYPE_UNRESOLVED;
+	}
+	else
+	{
+		*entry = region[ block_index % LIBPHDI_LAYER_MAP_NUMBER_OF_ENTRIES_PER_REGION ];
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     layer_map->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets a specific entry
+ * The region of the entry is allocated if needed
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_layer_map_set_entry_by_index(
+     libphdi_layer_map_t *layer_map,
+     uint64_t block_index,
+     libphdi_layer_map_entry_t *entry,
+     libcerror_error_t **error )
+{
+	libphdi_layer_map_entry_t *region = NULL;
+	static char *function             = "libphdi_layer_map_set_entry_by_index";
+	size_t region_size                = 0;
+	uint64_t region_index             = 0;
+	int result                        = 1;
+
+	if( layer_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layer map.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_index >= layer_map->number_of_blocks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	region_index = block_index / LIBPHDI_LAYER_MAP_NUMBER_OF_ENTRIES_PER_REGION;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     layer_map->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	region = layer_map->regions[ region_index ];
+
+	if( region == NULL )
+	{
+		region_size = sizeof( libphdi_layer_map_entry_t ) * LIBPHDI_LAYER_MAP_NUMBER_OF_ENTRIES_PER_REGION;
+
+		region = (libphdi_layer_map_entry_t *) memory_allocate(
+		                                        region_size );
+
+		if( region == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create region: %" PRIu64 ".",
+			 function,
+			 region_index );
+
+			result = -1;
+		}
+		else if( memory_set(
+		          region,
+		          0,
+		          region_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear region: %" PRIu64 ".",
+			 function,
+			 region_index );
+
+			memory_free(
+			 region );
+
+			region = NULL;
+			result = -1;
+		}
+		else
+		{
+			layer_map->regions[ region_index ] = region;
+		}
+	}
+	if( region != NULL )
+	{
+		region[ block_index % LIBPHDI_LAYER_MAP_NUMBER_OF_ENTRIES_PER_REGION ] = *entry;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     layer_map->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Resolves a specific entry by walking the snapshot chain
+ * A block that is stored in parts in different layers or files is resolved as mixed
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_layer_map_resolve_entry_by_index(
+     libphdi_layer_map_t *layer_map,
+     libphdi_snapshot_values_t *snapshot_values,
+     libbfio_pool_t *file_io_pool,
+     uint64_t block_index,
+     libphdi_layer_map_entry_t *entry,
+     libcerror_error_t **error )
+{
+	static char *function     = "libphdi_layer_map_resolve_entry_by_index";
+	size64_t block_data_size  = 0;
+	size64_t range_size       = 0;
+	off64_t block_offset      = 0;
+	off64_t range_file_offset = 0;
+	int file_io_pool_entry    = 0;
+	int layer                 = 0;
+	int result                = 0;
+
+	if( layer_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layer map.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_index >= layer_map->number_of_blocks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	block_offset    = (off64_t) ( block_index * layer_map->block_size );
+	block_data_size = layer_map->media_size - (size64_t) block_offset;
+
+	if( block_data_size > layer_map->block_size )
+	{
+		block_data_size = layer_map->block_size;
+	}
+	entry->file_offset        = 0;
+	entry->file_io_pool_entry = -1;
+	entry->layer              = 0;
+	entry->type               = LIBPHDI_LAYER_MAP_ENTRY_TYPE_SPARSE;
+
+	while( snapshot_values != NULL )
+	{
+		if( snapshot_values->extent_table == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid snapshot values: %d - missing extent table.",
+			 function,
+			 layer );
+
+			return( -1 );
+		}
+		if( layer > (int) UINT16_MAX )
+		{
+			entry->type = LIBPHDI_LAYER_MAP_ENTRY_TYPE_MIXED;
+
+			break;
+		}
+		result = libphdi_extent_table_get_block_range_at_offset(
+		          snapshot_values->extent_table,
+		          block_offset,
+		          file_io_pool,
+		          block_data_size,
+		          &file_io_pool_entry,
+		          &range_file_offset,
+		          &range_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block range at offset: %" PRIi64 " (0x%08" PRIx64 ") from snapshot: %d.",
+			 function,
+			 block_offset,
+			 block_offset,
+			 layer );
+
+			return( -1 );
+		}
+		if( range_size < block_data_size )
+		{
+			entry->type = LIBPHDI_LAYER_MAP_ENTRY_TYPE_MIXED;
+
+			break;
+		}
+		if( result != 0 )
+		{
+			entry->file_offset        = range_file_offset;
+			entry->file_io_pool_entry = file_io_pool_entry;
+			entry->layer              = (uint16_t) layer;
+			entry->type               = LIBPHDI_LAYER_MAP_ENTRY_TYPE_ALLOCATED;
+
+			break;
+		}
+		snapshot_values = snapshot_values->parent_snapshot_values;
+
+		layer++;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: block: %" PRIu64 " resolved to type: %" PRIu8 " in layer: %" PRIu16 "\n",
+		 function,
+		 block_index,
+		 entry->type,
+		 entry->layer );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves a specific entry and resolves it if needed
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_internal_layer_map_get_resolved_entry_by_index(
+     libphdi_layer_map_t *layer_map,
+     libphdi_snapshot_values_t *snapshot_values,
+     libbfio_pool_t *file_io_pool,
+     uint64_t block_index,
+     libphdi_layer_map_entry_t *entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_internal_layer_map_get_resolved_entry_by_index";
+
+	if( libphdi_layer_map_get_entry_by_index(
+	     layer_map,
+	     block_index,
+	     entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry: %" PRIu64 ".",
+		 function,
+		 block_index );
+
+		return( -1 );
+	}
+	if( entry->type != LIBPHDI_LAYER_MAP_ENTRY_TYPE_UNRESOLVED )
+	{
+		return( 1 );
+	}
+	/* The entry is resolved without holding the lock, if multiple threads
+	 * resolve the same entry they will store the same value
+	 */
+	if( libphdi_layer_map_resolve_entry_by_index(
+	     layer_map,
+	     snapshot_values,
+	     file_io_pool,
+	     block_index,
+	     entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to resolve entry: %" PRIu64 ".",
+		 function,
+		 block_index );
+
+		return( -1 );
+	}
+	if( libphdi_layer_map_set_entry_by_index(
+	     layer_map,
+	     block_index,
+	     entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set entry: %" PRIu64 ".",
+		 function,
+		 block_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the range of data at a specific offset
+ * Consecutive blocks that are stored contiguously in the same file or are sparse
+ * are combined into a single range, a mixed range never exceeds a single block
+ * The range layer is the (snapshot) layer of an allocated range
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_layer_map_get_range_at_offset(
+     libphdi_layer_map_t *layer_map,
+     libphdi_snapshot_values_t *snapshot_values,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     size64_t maximum_range_size,
+     uint8_t *range_type,
+     int *range_layer,
+     int *file_io_pool_entry,
+     off64_t *range_file_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	libphdi_layer_map_entry_t entry;
+
+	static char *function          = "libphdi_layer_map_get_range_at_offset";
+	size64_t block_data_size       = 0;
+	size64_t safe_range_size       = 0;
+	uint64_t block_index           = 0;
+	off64_t block_data_offset      = 0;
+	off64_t safe_range_file_offset = 0;
+	int safe_file_io_pool_entry    = 0;
+	int safe_range_layer           = 0;
+	uint8_t safe_range_type        = 0;
+
+	if( layer_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid layer map.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= layer_map->media_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_range_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum range size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range type.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_layer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range layer.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_file_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range file offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	block_index       = (uint64_t) offset / layer_map->block_size;
+	block_data_offset = offset % (off64_t) layer_map->block_size;
+
+	if( libphdi_internal_layer_map_get_resolved_entry_by_index(
+	     layer_map,
+	     snapshot_values,
+	     file_io_pool,
+	     block_index,
+	     &entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve resolved entry: %" PRIu64 ".",
+		 function,
+		 block_index );
+
+		return( -1 );
+	}
+	safe_range_type         = entry.type;
+	safe_range_layer        = (int) entry.layer;
+	safe_file_io_pool_entry = entry.file_io_pool_entry;
+	safe_range_file_offset  = entry.file_offset + block_data_offset;
+	safe_range_size         = layer_map->media_size - (size64_t) offset;
+
+	if( safe_range_size > ( layer_map->block_size - (size64_t) block_data_offset ) )
+	{
+		safe_range_size = layer_map->block_size - (size64_t) block_data_offset;
+	}
+	if( safe_range_type != LIBPHDI_LAYER_MAP_ENTRY_TYPE_MIXED )
+	{
+		for( block_index += 1;
+		     block_index < layer_map->number_of_blocks;
+		     block_index++ )
+		{
+			if( safe_range_size >= maximum_range_size )
+			{
+				break;
+			}
+			if( libphdi_internal_layer_map_get_resolved_entry_by_index(
+			     layer_map,
+			     snapshot_values,
+			     file_io_pool,
+			     block_index,
+			     &entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve resolved entry: %" PRIu64 ".",
+				 function,
+				 block_index );
+
+				return( -1 );
+			}
+			if( entry.type != safe_range_type )
+			{
+				break;
+			}
+			if( ( safe_range_type == LIBPHDI_LAYER_MAP_ENTRY_TYPE_ALLOCATED )
+			 && ( ( entry.file_io_pool_entry != safe_file_io_pool_entry )
+			  ||  ( entry.file_offset != ( safe_range_file_offset + (off64_t) safe_range_size ) ) ) )
+			{
+				break;
+			}
+			block_data_size = layer_map->media_size - ( block_index * layer_map->block_size );
+
+			if( block_data_size > layer_map->block_size )
+			{
+				block_data_size = layer_map->block_size;
+			}
+			safe_range_size += block_data_size;
+		}
+	}
+	if( safe_range_size > maximum_range_size )
+	{
+		safe_range_size = maximum_range_size;
+	}
+	*range_type         = safe_range_type;
+	*range_layer        = safe_range_layer;
+	*file_io_pool_entry = safe_file_io_pool_entry;
+	*range_file_offset  = safe_range_file_offset;
+	*range_size         = safe_range_size;
+
+	return( 1 );
+}
+
@@ -0,0 +1,146 @@
+/*
+ * Layer map functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPHDI_LAYER_MAP_H )
+#define _LIBPHDI_LAYER_MAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libphdi_libbfio.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_libcthreads.h"
+#include "libphdi_snapshot_values.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libphdi_layer_map_entry libphdi_layer_map_entry_t;
+
+struct libphdi_layer_map_entry
+{
+	/* The file offset of the block
+	 */
+	off64_t file_offset;
+
+	/* The file IO pool entry of the block
+	 */
+	int file_io_pool_entry;
+
+	/* The (snapshot) layer of the block, where 0 represents the current snapshot
+	 */
+	uint16_t layer;
+
+	/* The entry type
+	 */
+	uint8_t type;
+};
+
+typedef struct libphdi_layer_map libphdi_layer_map_t;
+
+struct libphdi_layer_map
+{
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The block size
+	 */
+	size64_t block_size;
+
+	/* The number of blocks
+	 */
+	uint64_t number_of_blocks;
+
+	/* The number of regions
+	 */
+	uint64_t number_of_regions;
+
+	/* The regions, each region contains LIBPHDI_LAYER_MAP_NUMBER_OF_ENTRIES_PER_REGION entries
+	 * a region is allocated when a block in the region is first resolved
+	 */
+	libphdi_layer_map_entry_t **regions;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libphdi_layer_map_initialize(
+     libphdi_layer_map_t **layer_map,
+     size64_t media_size,
+     size64_t block_size,
+     libcerror_error_t **error );
+
+int libphdi_layer_map_free(
+     libphdi_layer_map_t **layer_map,
+     libcerror_error_t **error );
+
+int libphdi_layer_map_get_entry_by_index(
+     libphdi_layer_map_t *layer_map,
+     uint64_t block_index,
+     libphdi_layer_map_entry_t *entry,
+     libcerror_error_t **error );
+
+int libphdi_layer_map_set_entry_by_index(
+     libphdi_layer_map_t *layer_map,
+     uint64_t block_index,
+     libphdi_layer_map_entry_t *entry,
+     libcerror_error_t **error );
+
+int libphdi_layer_map_resolve_entry_by_index(
+     libphdi_layer_map_t *layer_map,
+     libphdi_snapshot_values_t *snapshot_values,
+     libbfio_pool_t *file_io_pool,
+     uint64_t block_index,
+     libphdi_layer_map_entry_t *entry,
+     libcerror_error_t **error );
+
+int libphdi_internal_layer_map_get_resolved_entry_by_index(
+     libphdi_layer_map_t *layer_map,
+     libphdi_snapshot_values_t *snapshot_values,
+     libbfio_pool_t *file_io_pool,
+     uint64_t block_index,
+     libphdi_layer_map_entry_t *entry,
+     libcerror_error_t **error );
+
+int libphdi_layer_map_get_range_at_offset(
+     libphdi_layer_map_t *layer_map,
+     libphdi_snapshot_values_t *snapshot_values,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     size64_t maximum_range_size,
+     uint8_t *range_type,
+     int *range_layer,
+     int *file_io_pool_entry,
+     off64_t *range_file_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPHDI_LAYER_MAP_H ) */
+
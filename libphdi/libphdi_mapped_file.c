@@ -0,0 +1,487 @@
+/*
+ * Memory mapped file functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libphdi_borrowed_buffers.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_mapped_file.h"
+
+/* Creates a mapped file
+ * Make sure the value mapped_file is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_mapped_file_initialize(
+     libphdi_mapped_file_t **mapped_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_mapped_file_initialize";
+
+	if( mapped_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *mapped_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid mapped file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*mapped_file = memory_allocate_structure(
+	                libphdi_mapped_file_t );
+
+	if( *mapped_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create mapped file.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *mapped_file,
+	     0,
+	     sizeof( libphdi_mapped_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear mapped file.",
+		 function );
+
+		memory_free(
+		 *mapped_file );
+
+		*mapped_file = NULL;
+
+		return( -1 );
+	}
+	if( libphdi_borrowed_buffers_initialize(
+	     &( ( *mapped_file )->borrowed_buffers ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create borrowed buffers.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *mapped_file != NULL )
+	{
+		memory_free(
+		 *mapped_file );
+
+		*mapped_file = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a mapped file
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_mapped_file_free(
+     libphdi_mapped_file_t **mapped_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_mapped_file_free";
+	int result            = 1;
+
+	if( mapped_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *mapped_file != NULL )
+	{
+		if( libphdi_mapped_file_close(
+		     *mapped_file,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close mapped file.",
+			 function );
+
+			result = -1;
+		}
+		if( libphdi_borrowed_buffers_free(
+		     &( ( *mapped_file )->borrowed_buffers ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free borrowed buffers.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *mapped_file );
+
+		*mapped_file = NULL;
+	}
+	return( result );
+}
+
+/* Opens a mapped file
+ * The file is mapped read-only and shared into memory, if the file is truncated
+ * while mapped accessing the mapped data beyond the end of the file raises SIGBUS
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_mapped_file_open(
+     libphdi_mapped_file_t *mapped_file,
+     const char *filename,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_MMAP )
+	struct stat file_statistics;
+
+	void *data            = NULL;
+	int file_descriptor   = -1;
+#endif
+	static char *function = "libphdi_mapped_file_open";
+
+	if( mapped_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped file.",
+		 function );
+
+		return( -1 );
+	}
+	if( mapped_file->data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid mapped file - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MMAP )
+	/* The file descriptor should not be inherited by child processes
+	 */
+#if defined( O_CLOEXEC )
+	file_descriptor = open(
+	                   filename,
+	                   O_RDONLY | O_CLOEXEC );
+#else
+	file_descriptor = open(
+	                   filename,
+	                   O_RDONLY );
+#endif
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( fstat(
+	     file_descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( file_statistics.st_size <= 0 )
+	 || ( (uint64_t) file_statistics.st_size > (uint64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+#if SIZEOF_SIZE_T < 8
+	/* On 32-bit platforms the file size can exceed the size that can be mapped
+	 */
+	if( (uint64_t) file_statistics.st_size > (uint64_t) ( (size_t) -1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid file size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	data = mmap(
+	        NULL,
+	        (size_t) file_statistics.st_size,
+	        PROT_READ,
+	        MAP_SHARED,
+	        file_descriptor,
+	        0 );
+
+	if( data == MAP_FAILED )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to map file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	/* The mapping remains valid after the file descriptor is closed
+	 */
+	close(
+	 file_descriptor );
+
+	mapped_file->data      = (uint8_t *) data;
+	mapped_file->data_size = (size_t) file_statistics.st_size;
+
+	return( 1 );
+
+on_error:
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+	return( -1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: memory mapped files not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_MMAP ) */
+}
+
+/* Closes a mapped file
+ * Returns 0 if successful or -1 on error
+ */
+int libphdi_mapped_file_close(
+     libphdi_mapped_file_t *mapped_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_mapped_file_close";
+	int result            = 0;
+
+	if( mapped_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped file.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MMAP )
+	if( mapped_file->data != NULL )
+	{
+		if( munmap(
+		     mapped_file->data,
+		     mapped_file->data_size ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to unmap file.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif /* defined( HAVE_MMAP ) */
+
+	mapped_file->data      = NULL;
+	mapped_file->data_size = 0;
+
+	return( result );
+}
+
+/* Retrieves the mapped data at a specific offset
+ * Returns 1 if successful, 0 if the offset is beyond the end of the mapped data or -1 on error
+ */
+int libphdi_mapped_file_get_data_at_offset(
+     libphdi_mapped_file_t *mapped_file,
+     off64_t offset,
+     size64_t maximum_data_size,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_mapped_file_get_data_at_offset";
+	size_t safe_data_size = 0;
+
+	if( mapped_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped file.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mapped_file->data == NULL )
+	 || ( (size64_t) offset >= (size64_t) mapped_file->data_size ) )
+	{
+		return( 0 );
+	}
+	safe_data_size = mapped_file->data_size - (size_t) offset;
+
+	if( (size64_t) safe_data_size > maximum_data_size )
+	{
+		safe_data_size = (size_t) maximum_data_size;
+	}
+	*data      = &( mapped_file->data[ offset ] );
+	*data_size = safe_data_size;
+
+	return( 1 );
+}
+
@@ -0,0 +1,82 @@
+/*
+ * Memory mapped file functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPHDI_MAPPED_FILE_H )
+#define _LIBPHDI_MAPPED_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libphdi_borrowed_buffers.h"
+#include "libphdi_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libphdi_mapped_file libphdi_mapped_file_t;
+
+struct libphdi_mapped_file
+{
+	/* The mapped data
+	 */
+	uint8_t *data;
+
+	/* The mapped data size
+	 */
+	size_t data_size;
+
+	/* The buffers borrowed from the mapped data
+	 */
+	libphdi_borrowed_buffers_t *borrowed_buffers;
+};
+
+int libphdi_mapped_file_initialize(
+     libphdi_mapped_file_t **mapped_file,
+     libcerror_error_t **error );
+
+int libphdi_mapped_file_free(
+     libphdi_mapped_file_t **mapped_file,
+     libcerror_error_t **error );
+
+int libphdi_mapped_file_open(
+     libphdi_mapped_file_t *mapped_file,
+     const char *filename,
+     libcerror_error_t **error );
+
+int libphdi_mapped_file_close(
+     libphdi_mapped_file_t *mapped_file,
+     libcerror_error_t **error );
+
+int libphdi_mapped_file_get_data_at_offset(
+     libphdi_mapped_file_t *mapped_file,
+     off64_t offset,
+     size64_t maximum_data_size,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPHDI_MAPPED_FILE_H ) */
+
@@ -0,0 +1,3453 @@
+/*
+ * Metadata index functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "libphdi_definitions.h"
+#include "libphdi_disk_parameters.h"
+#include "libphdi_extent_values.h"
+#include "libphdi_image_values.h"
+#include "libphdi_libbfio.h"
+#include "libphdi_libcdata.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_libcnotify.h"
+#include "libphdi_metadata_index.h"
+#include "libphdi_snapshot_values.h"
+#include "libphdi_storage_image.h"
+#include "libphdi_system_string.h"
+
+#include "phdi_metadata_index.h"
+#include "phdi_sparse_image_header.h"
+
+const uint8_t phdi_metadata_index_signature[ 8 ] = {
+	'p', 'h', 'd', 'i', 'm', 'i', 'd', 'x' };
+
+/* Creates a metadata index
+ * Make sure the value metadata_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_metadata_index_initialize(
+     libphdi_metadata_index_t **metadata_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_metadata_index_initialize";
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *metadata_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid metadata index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*metadata_index = memory_allocate_structure(
+	                   libphdi_metadata_index_t );
+
+	if( *metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create metadata index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *metadata_index,
+	     0,
+	     sizeof( libphdi_metadata_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear metadata index.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *metadata_index != NULL )
+	{
+		memory_free(
+		 *metadata_index );
+
+		*metadata_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a metadata index
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_metadata_index_free(
+     libphdi_metadata_index_t **metadata_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_metadata_index_free";
+	int result            = 1;
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *metadata_index != NULL )
+	{
+		if( libphdi_metadata_index_clear(
+		     *metadata_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to clear metadata index.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *metadata_index )->filename != NULL )
+		{
+			memory_free(
+			 ( *metadata_index )->filename );
+		}
+		memory_free(
+		 *metadata_index );
+
+		*metadata_index = NULL;
+	}
+	return( result );
+}
+
+/* Clears the metadata index
+ * The filename is retained
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_metadata_index_clear(
+     libphdi_metadata_index_t *metadata_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_metadata_index_clear";
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_index->buffer != NULL )
+	{
+		memory_free(
+		 metadata_index->buffer );
+
+		metadata_index->buffer = NULL;
+	}
+	if( metadata_index->storage_images_data_offsets != NULL )
+	{
+		memory_free(
+		 metadata_index->storage_images_data_offsets );
+
+		metadata_index->storage_images_data_offsets = NULL;
+	}
+	metadata_index->buffer_size              = 0;
+	metadata_index->data                     = NULL;
+	metadata_index->data_size                = 0;
+	metadata_index->descriptor_size          = 0;
+	metadata_index->descriptor_checksum      = 0;
+	metadata_index->disk_type                = 0;
+	metadata_index->number_of_extents        = 0;
+	metadata_index->number_of_snapshots      = 0;
+	metadata_index->number_of_storage_images = 0;
+	metadata_index->snapshots_data_offset    = 0;
+	metadata_index->is_valid                 = 0;
+
+	return( 1 );
+}
+
+/* Sets the filename
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_metadata_index_set_filename(
+     libphdi_metadata_index_t *metadata_index,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_metadata_index_set_filename";
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( filename_length == 0 )
+	 || ( filename_length > (size_t) ( SSIZE_MAX - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_index->filename != NULL )
+	{
+		memory_free(
+		 metadata_index->filename );
+
+		metadata_index->filename      = NULL;
+		metadata_index->filename_size = 0;
+	}
+	if( libphdi_system_string_size_from_narrow_string(
+	     filename,
+	     filename_length + 1,
+	     &( metadata_index->filename_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine filename size.",
+		 function );
+
+		goto on_error;
+	}
+	metadata_index->filename = system_string_allocate(
+	                            metadata_index->filename_size );
+
+	if( metadata_index->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libphdi_system_string_copy_from_narrow_string(
+	     metadata_index->filename,
+	     metadata_index->filename_size,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set filename.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( metadata_index->filename != NULL )
+	{
+		memory_free(
+		 metadata_index->filename );
+
+		metadata_index->filename = NULL;
+	}
+	metadata_index->filename_size = 0;
+
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets the filename
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_metadata_index_set_filename_wide(
+     libphdi_metadata_index_t *metadata_index,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_metadata_index_set_filename_wide";
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( filename_length == 0 )
+	 || ( filename_length > (size_t) ( SSIZE_MAX - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_index->filename != NULL )
+	{
+		memory_free(
+		 metadata_index->filename );
+
+		metadata_index->filename      = NULL;
+		metadata_index->filename_size = 0;
+	}
+	if( libphdi_system_string_size_from_wide_string(
+	     filename,
+	     filename_length + 1,
+	     &( metadata_index->filename_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine filename size.",
+		 function );
+
+		goto on_error;
+	}
+	metadata_index->filename = system_string_allocate(
+	                            metadata_index->filename_size );
+
+	if( metadata_index->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libphdi_system_string_copy_from_wide_string(
+	     metadata_index->filename,
+	     metadata_index->filename_size,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set filename.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( metadata_index->filename != NULL )
+	{
+		memory_free(
+		 metadata_index->filename );
+
+		metadata_index->filename = NULL;
+	}
+	metadata_index->filename_size = 0;
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Calculates a 64-bit FNV-1a checksum of the data
+ * Use LIBPHDI_METADATA_INDEX_CHECKSUM_INITIAL_VALUE as the initial value of the first block of data
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_metadata_index_calculate_checksum(
+     uint64_t *checksum,
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t initial_value,
+     libcerror_error_t **error )
+{
+	static char *function  = "libphdi_metadata_index_calculate_checksum";
+	size_t data_offset     = 0;
+	uint64_t safe_checksum = 0;
+
+	if( checksum == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	safe_checksum = initial_value;
+
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		safe_checksum ^= data[ data_offset ];
+		safe_checksum *= 0x00000100000001b3ULL;
+	}
+	*checksum = safe_checksum;
+
+	return( 1 );
+}
+
+/* Retrieves a specific sample range of the block allocation table data
+ * A block allocation table of up to 3 sample sizes is sampled entirely, otherwise
+ * the start, middle and end of the block allocation table are sampled
+ * Returns 1 if successful, 0 if there is no such sample or -1 on error
+ */
+int libphdi_metadata_index_get_block_allocation_table_sample_range(
+     size64_t block_allocation_table_size,
+     int sample_index,
+     size64_t *sample_offset,
+     size64_t *sample_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_metadata_index_get_block_allocation_table_sample_range";
+
+	if( sample_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sample index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( sample_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sample offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( sample_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sample size.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_allocation_table_size <= ( 3 * LIBPHDI_METADATA_INDEX_BLOCK_ALLOCATION_TABLE_SAMPLE_SIZE ) )
+	{
+		if( ( sample_index > 0 )
+		 || ( block_allocation_table_size == 0 ) )
+		{
+			return( 0 );
+		}
+		*sample_offset = 0;
+		*sample_size   = block_allocation_table_size;
+
+		return( 1 );
+	}
+	if( sample_index == 0 )
+	{
+		*sample_offset = 0;
+	}
+	else if( sample_index == 1 )
+	{
+		/* The middle sample starts at a block allocation table entry boundary
+		 */
+		*sample_offset = ( block_allocation_table_size - LIBPHDI_METADATA_INDEX_BLOCK_ALLOCATION_TABLE_SAMPLE_SIZE ) / 2;
+		*sample_offset = *sample_offset & ~( (size64_t) 3 );
+	}
+	else if( sample_index == 2 )
+	{
+		*sample_offset = block_allocation_table_size - LIBPHDI_METADATA_INDEX_BLOCK_ALLOCATION_TABLE_SAMPLE_SIZE;
+	}
+	else
+	{
+		return( 0 );
+	}
+	*sample_size = LIBPHDI_METADATA_INDEX_BLOCK_ALLOCATION_TABLE_SAMPLE_SIZE;
+
+	return( 1 );
+}
+
+/* Reads the disk descriptor XML file to determine its size and checksum
+ * The index data is only valid for the disk descriptor XML file with the same size and checksum
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_metadata_index_read_descriptor_file_io_handle(
+     libphdi_metadata_index_t *metadata_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t *data         = NULL;
+	static char *function = "libphdi_metadata_index_read_descriptor_file_io_handle";
+	size64_t file_size    = 0;
+	size64_t file_offset  = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	uint64_t checksum     = LIBPHDI_METADATA_INDEX_CHECKSUM_INITIAL_VALUE;
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		goto on_error;
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * LIBPHDI_METADATA_INDEX_DESCRIPTOR_READ_SIZE );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	while( file_offset < file_size )
+	{
+		read_size = LIBPHDI_METADATA_INDEX_DESCRIPTOR_READ_SIZE;
+
+		if( (size64_t) read_size > ( file_size - file_offset ) )
+		{
+			read_size = (size_t) ( file_size - file_offset );
+		}
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              data,
+		              read_size,
+		              (off64_t) file_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIu64 " (0x%08" PRIx64 ").",
+			 function,
+			 file_offset,
+			 file_offset );
+
+			goto on_error;
+		}
+		if( libphdi_metadata_index_calculate_checksum(
+		     &checksum,
+		     data,
+		     read_size,
+		     checksum,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to calculate checksum.",
+			 function );
+
+			goto on_error;
+		}
+		file_offset += read_size;
+	}
+	memory_free(
+	 data );
+
+	metadata_index->descriptor_size     = file_size;
+	metadata_index->descriptor_checksum = checksum;
+
+	return( 1 );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
+/* Reads the metadata index data
+ * The data is not copied and must remain available while the metadata index is used
+ * Returns 1 if successful, 0 if the data is not a valid metadata index of the disk descriptor XML file or -1 on error
+ */
+int libphdi_metadata_index_read_data(
+     libphdi_metadata_index_t *metadata_index,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	phdi_metadata_index_file_header_t *file_header = NULL;
+	size_t *storage_images_data_offsets            = NULL;
+	static char *function                          = "libphdi_metadata_index_read_data";
+	size_t data_offset                             = 0;
+	size_t record_size                             = 0;
+	size_t snapshots_data_offset                   = 0;
+	size64_t extent_size                           = 0;
+	uint64_t calculated_checksum                   = 0;
+	uint64_t descriptor_checksum                   = 0;
+	uint64_t descriptor_size                       = 0;
+	uint64_t extent_offset                         = 0;
+	uint64_t stored_checksum                       = 0;
+	uint64_t stored_data_size                      = 0;
+	uint32_t disk_type                             = 0;
+	uint32_t file_io_pool_entry                    = 0;
+	uint32_t format_version                        = 0;
+	uint32_t image_index                           = 0;
+	uint32_t index                                 = 0;
+	uint32_t number_of_entries                     = 0;
+	uint32_t number_of_extents                     = 0;
+	uint32_t number_of_header_entries              = 0;
+	uint32_t number_of_images                      = 0;
+	uint32_t number_of_snapshots                   = 0;
+	uint32_t number_of_storage_images              = 0;
+	uint32_t value_32bit                           = 0;
+	int result                                     = -1;
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_index->data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid metadata index - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < ( sizeof( phdi_metadata_index_file_header_t ) + sizeof( phdi_metadata_index_disk_parameters_t ) ) )
+	{
+		return( 0 );
+	}
+	file_header = (phdi_metadata_index_file_header_t *) data;
+
+	if( memory_compare(
+	     file_header->signature,
+	     phdi_metadata_index_signature,
+	     8 ) != 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header->format_version,
+	 format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header->disk_type,
+	 disk_type );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 file_header->data_size,
+	 stored_data_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 file_header->checksum,
+	 stored_checksum );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 file_header->descriptor_size,
+	 descriptor_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 file_header->descriptor_checksum,
+	 descriptor_checksum );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header->number_of_extents,
+	 number_of_extents );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header->number_of_snapshots,
+	 number_of_snapshots );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header->number_of_storage_images,
+	 number_of_storage_images );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: format version\t\t\t: %" PRIu32 "\n",
+		 function,
+		 format_version );
+
+		libcnotify_printf(
+		 "%s: disk type\t\t\t\t: %" PRIu32 "\n",
+		 function,
+		 disk_type );
+
+		libcnotify_printf(
+		 "%s: data size\t\t\t\t: %" PRIu64 "\n",
+		 function,
+		 stored_data_size );
+
+		libcnotify_printf(
+		 "%s: checksum\t\t\t\t: 0x%016" PRIx64 "\n",
+		 function,
+		 stored_checksum );
+
+		libcnotify_printf(
+		 "%s: descriptor size\t\t\t: %" PRIu64 "\n",
+		 function,
+		 descriptor_size );
+
+		libcnotify_printf(
+		 "%s: descriptor checksum\t\t: 0x%016" PRIx64 "\n",
+		 function,
+		 descriptor_checksum );
+
+		libcnotify_printf(
+		 "%s: number of extents\t\t\t: %" PRIu32 "\n",
+		 function,
+		 number_of_extents );
+
+		libcnotify_printf(
+		 "%s: number of snapshots\t\t: %" PRIu32 "\n",
+		 function,
+		 number_of_snapshots );
+
+		libcnotify_printf(
+		 "%s: number of storage images\t\t: %" PRIu32 "\n",
+		 function,
+		 number_of_storage_images );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+	if( ( format_version != LIBPHDI_METADATA_INDEX_FORMAT_VERSION )
+	 || ( stored_data_size != (uint64_t) ( data_size - sizeof( phdi_metadata_index_file_header_t ) ) )
+	 || ( descriptor_size != (uint64_t) metadata_index->descriptor_size )
+	 || ( descriptor_checksum != metadata_index->descriptor_checksum )
+	 || ( number_of_extents == 0 )
+	 || ( number_of_extents > (uint32_t) INT_MAX )
+	 || ( number_of_snapshots > (uint32_t) INT_MAX )
+	 || ( number_of_storage_images > (uint32_t) INT_MAX ) )
+	{
+		return( 0 );
+	}
+	if( libphdi_metadata_index_calculate_checksum(
+	     &calculated_checksum,
+	     &( data[ sizeof( phdi_metadata_index_file_header_t ) ] ),
+	     data_size - sizeof( phdi_metadata_index_file_header_t ),
+	     LIBPHDI_METADATA_INDEX_CHECKSUM_INITIAL_VALUE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		goto on_error;
+	}
+	if( calculated_checksum != stored_checksum )
+	{
+		return( 0 );
+	}
+	/* The disk parameters record
+	 */
+	data_offset = sizeof( phdi_metadata_index_file_header_t );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (phdi_metadata_index_disk_parameters_t *) &( data[ data_offset ] ) )->name_size,
+	 value_32bit );
+
+	if( (size_t) value_32bit > ( data_size - data_offset - sizeof( phdi_metadata_index_disk_parameters_t ) ) )
+	{
+		return( 0 );
+	}
+	data_offset += sizeof( phdi_metadata_index_disk_parameters_t );
+
+	if( ( value_32bit != 0 )
+	 && ( data[ data_offset + value_32bit - 1 ] != 0 ) )
+	{
+		return( 0 );
+	}
+	record_size = ( (size_t) value_32bit + 7 ) & ~( (size_t) 7 );
+
+	if( record_size > ( data_size - data_offset ) )
+	{
+		return( 0 );
+	}
+	data_offset += record_size;
+
+	/* The extent records, each directly followed by its image records
+	 */
+	for( index = 0;
+	     index < number_of_extents;
+	     index++ )
+	{
+		if( sizeof( phdi_metadata_index_extent_t ) > ( data_size - data_offset ) )
+		{
+			return( 0 );
+		}
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (phdi_metadata_index_extent_t *) &( data[ data_offset ] ) )->offset,
+		 extent_offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (phdi_metadata_index_extent_t *) &( data[ data_offset ] ) )->size,
+		 extent_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (phdi_metadata_index_extent_t *) &( data[ data_offset ] ) )->number_of_images,
+		 number_of_images );
+
+		if( ( extent_offset > (uint64_t) INT64_MAX )
+		 || ( extent_size == 0 )
+		 || ( extent_size > ( (uint64_t) INT64_MAX - extent_offset ) )
+		 || ( number_of_images == 0 ) )
+		{
+			return( 0 );
+		}
+		data_offset += sizeof( phdi_metadata_index_extent_t );
+
+		for( image_index = 0;
+		     image_index < number_of_images;
+		     image_index++ )
+		{
+			if( sizeof( phdi_metadata_index_image_t ) > ( data_size - data_offset ) )
+			{
+				return( 0 );
+			}
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (phdi_metadata_index_image_t *) &( data[ data_offset ] ) )->filename_size,
+			 value_32bit );
+
+			data_offset += sizeof( phdi_metadata_index_image_t );
+
+			if( ( value_32bit < 2 )
+			 || ( (size_t) value_32bit > ( data_size - data_offset ) )
+			 || ( data[ data_offset + value_32bit - 1 ] != 0 ) )
+			{
+				return( 0 );
+			}
+			record_size = ( (size_t) value_32bit + 7 ) & ~( (size_t) 7 );
+
+			if( record_size > ( data_size - data_offset ) )
+			{
+				return( 0 );
+			}
+			data_offset += record_size;
+		}
+	}
+	/* The snapshot records
+	 */
+	if( (size_t) number_of_snapshots > ( ( data_size - data_offset ) / sizeof( phdi_metadata_index_snapshot_t ) ) )
+	{
+		return( 0 );
+	}
+	snapshots_data_offset = data_offset;
+
+	data_offset += (size_t) number_of_snapshots * sizeof( phdi_metadata_index_snapshot_t );
+
+	/* The storage image records
+	 */
+	if( number_of_storage_images > 0 )
+	{
+		if( (size_t) number_of_storage_images > ( ( data_size - data_offset ) / sizeof( phdi_metadata_index_storage_image_t ) ) )
+		{
+			return( 0 );
+		}
+		storage_images_data_offsets = (size_t *) memory_allocate(
+		                                          sizeof( size_t ) * number_of_storage_images );
+
+		if( storage_images_data_offsets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create storage images data offsets.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     storage_images_data_offsets,
+		     0,
+		     sizeof( size_t ) * number_of_storage_images ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear storage images data offsets.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( index = 0;
+	     index < number_of_storage_images;
+	     index++ )
+	{
+		if( sizeof( phdi_metadata_index_storage_image_t ) > ( data_size - data_offset ) )
+		{
+			goto on_invalid;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (phdi_metadata_index_storage_image_t *) &( data[ data_offset ] ) )->file_io_pool_entry,
+		 file_io_pool_entry );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (phdi_metadata_index_storage_image_t *) &( data[ data_offset ] ) )->number_of_entries,
+		 number_of_entries );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (phdi_sparse_image_header_t *) ( (phdi_metadata_index_storage_image_t *) &( data[ data_offset ] ) )->sparse_image_header )->number_of_allocation_table_entries,
+		 number_of_header_entries );
+
+		if( ( file_io_pool_entry >= number_of_storage_images )
+		 || ( ( number_of_entries != 0 )
+		  &&  ( number_of_entries != number_of_header_entries ) ) )
+		{
+			goto on_invalid;
+		}
+		/* Storage images that share a file IO pool entry contain the same data
+		 */
+		if( storage_images_data_offsets[ file_io_pool_entry ] == 0 )
+		{
+			storage_images_data_offsets[ file_io_pool_entry ] = data_offset;
+		}
+		data_offset += sizeof( phdi_metadata_index_storage_image_t );
+
+		if( (size_t) number_of_entries > ( ( data_size - data_offset ) / 4 ) )
+		{
+			goto on_invalid;
+		}
+		record_size = ( ( (size_t) number_of_entries * 4 ) + 7 ) & ~( (size_t) 7 );
+
+		if( record_size > ( data_size - data_offset ) )
+		{
+			goto on_invalid;
+		}
+		data_offset += record_size;
+	}
+	if( data_offset != data_size )
+	{
+		goto on_invalid;
+	}
+	metadata_index->data                        = data;
+	metadata_index->data_size                   = data_size;
+	metadata_index->disk_type                   = (int) disk_type;
+	metadata_index->number_of_extents           = (int) number_of_extents;
+	metadata_index->number_of_snapshots         = (int) number_of_snapshots;
+	metadata_index->number_of_storage_images    = (int) number_of_storage_images;
+	metadata_index->snapshots_data_offset       = snapshots_data_offset;
+	metadata_index->storage_images_data_offsets = storage_images_data_offsets;
+	metadata_index->is_valid                    = 1;
+
+	return( 1 );
+
+on_invalid:
+	result = 0;
+
+on_error:
+	if( storage_images_data_offsets != NULL )
+	{
+		memory_free(
+		 storage_images_data_offsets );
+	}
+	return( result );
+}
+
+/* Reads the metadata index file
+ * A metadata index file that cannot be opened is considered missing
+ * Returns 1 if successful, 0 if the metadata index file is missing or not valid or -1 on error
+ */
+int libphdi_metadata_index_read_file(
+     libphdi_metadata_index_t *metadata_index,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libphdi_metadata_index_read_file";
+	size64_t file_size               = 0;
+	ssize_t read_count               = 0;
+	int result                       = 0;
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_index->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid metadata index - missing filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( metadata_index->data != NULL )
+	 || ( metadata_index->buffer != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid metadata index - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfio_file_set_name_wide(
+	          file_io_handle,
+	          metadata_index->filename,
+	          metadata_index->filename_size - 1,
+	          error );
+#else
+	result = libbfio_file_set_name(
+	          file_io_handle,
+	          metadata_index->filename,
+	          metadata_index->filename_size - 1,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	/* A missing metadata index file is not an error, the index is rebuilt
+	 */
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to open metadata index file: %" PRIs_SYSTEM ".\n",
+			 function,
+			 metadata_index->filename );
+		}
+#endif
+		libcerror_error_free(
+		 error );
+
+		result = 0;
+
+		goto on_close;
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( file_size < sizeof( phdi_metadata_index_file_header_t ) )
+	 || ( file_size > (size64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		result = 0;
+
+		goto on_close;
+	}
+	metadata_index->buffer = (uint8_t *) memory_allocate(
+	                                      sizeof( uint8_t ) * (size_t) file_size );
+
+	if( metadata_index->buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	metadata_index->buffer_size = (size_t) file_size;
+
+	/* The metadata index file is read at once, since it can be replaced
+	 * by another process while it is in use
+	 */
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              metadata_index->buffer,
+	              metadata_index->buffer_size,
+	              0,
+	              error );
+
+	if( read_count != (ssize_t) metadata_index->buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read metadata index data.",
+		 function );
+
+		goto on_error;
+	}
+	result = libphdi_metadata_index_read_data(
+	          metadata_index,
+	          metadata_index->buffer,
+	          metadata_index->buffer_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read metadata index data.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	else if( result == 0 )
+	{
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: metadata index file: %" PRIs_SYSTEM " is not valid.\n",
+			 function,
+			 metadata_index->filename );
+		}
+	}
+#endif
+on_close:
+	if( result == 0 )
+	{
+		if( metadata_index->buffer != NULL )
+		{
+			memory_free(
+			 metadata_index->buffer );
+
+			metadata_index->buffer = NULL;
+		}
+		metadata_index->buffer_size = 0;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( metadata_index->buffer != NULL )
+	{
+		memory_free(
+		 metadata_index->buffer );
+
+		metadata_index->buffer = NULL;
+	}
+	if( metadata_index->storage_images_data_offsets != NULL )
+	{
+		memory_free(
+		 metadata_index->storage_images_data_offsets );
+
+		metadata_index->storage_images_data_offsets = NULL;
+	}
+	metadata_index->buffer_size = 0;
+	metadata_index->data        = NULL;
+	metadata_index->data_size   = 0;
+	metadata_index->is_valid    = 0;
+
+	return( -1 );
+}
+
+/* Retrieves the disk type
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_metadata_index_get_disk_type(
+     libphdi_metadata_index_t *metadata_index,
+     int *disk_type,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_metadata_index_get_disk_type";
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( disk_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk type.",
+		 function );
+
+		return( -1 );
+	}
+	*disk_type = metadata_index->disk_type;
+
+	return( 1 );
+}
+
+/* Retrieves the disk parameters
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_metadata_index_get_disk_parameters(
+     libphdi_metadata_index_t *metadata_index,
+     libphdi_disk_parameters_t *disk_parameters,
+     libcerror_error_t **error )
+{
+	phdi_metadata_index_disk_parameters_t *record = NULL;
+	static char *function                         = "libphdi_metadata_index_get_disk_parameters";
+	size_t data_offset                            = 0;
+	uint32_t name_size                            = 0;
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_index->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid metadata index - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( disk_parameters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk parameters.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset = sizeof( phdi_metadata_index_file_header_t );
+
+	record = (phdi_metadata_index_disk_parameters_t *) &( metadata_index->data[ data_offset ] );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 record->media_size,
+	 disk_parameters->media_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 record->number_of_sectors,
+	 disk_parameters->number_of_sectors );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 record->number_of_cylinders,
+	 disk_parameters->number_of_cylinders );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 record->number_of_heads,
+	 disk_parameters->number_of_heads );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 record->name_size,
+	 name_size );
+
+	data_offset += sizeof( phdi_metadata_index_disk_parameters_t );
+
+	if( name_size > 0 )
+	{
+		if( libphdi_disk_parameters_set_name(
+		     disk_parameters,
+		     &( metadata_index->data[ data_offset ] ),
+		     (size_t) name_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the extents
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_metadata_index_get_extents(
+     libphdi_metadata_index_t *metadata_index,
+     libcdata_array_t *extent_values_array,
+     libcerror_error_t **error )
+{
+	phdi_metadata_index_extent_t *extent_record = NULL;
+	phdi_metadata_index_image_t *image_record   = NULL;
+	libphdi_extent_values_t *extent_values      = NULL;
+	libphdi_image_values_t *image_values        = NULL;
+	static char *function                       = "libphdi_metadata_index_get_extents";
+	size_t data_offset                          = 0;
+	size64_t extent_size                        = 0;
+	uint64_t extent_offset                      = 0;
+	uint32_t filename_size                      = 0;
+	uint32_t image_index                        = 0;
+	uint32_t image_type                         = 0;
+	uint32_t name_size                          = 0;
+	uint32_t number_of_images                   = 0;
+	int entry_index                             = 0;
+	int extent_index                            = 0;
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_index->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid metadata index - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset = sizeof( phdi_metadata_index_file_header_t );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (phdi_metadata_index_disk_parameters_t *) &( metadata_index->data[ data_offset ] ) )->name_size,
+	 name_size );
+
+	data_offset += sizeof( phdi_metadata_index_disk_parameters_t );
+	data_offset += ( (size_t) name_size + 7 ) & ~( (size_t) 7 );
+
+	for( extent_index = 0;
+	     extent_index < metadata_index->number_of_extents;
+	     extent_index++ )
+	{
+		extent_record = (phdi_metadata_index_extent_t *) &( metadata_index->data[ data_offset ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 extent_record->offset,
+		 extent_offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 extent_record->size,
+		 extent_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 extent_record->number_of_images,
+		 number_of_images );
+
+		data_offset += sizeof( phdi_metadata_index_extent_t );
+
+		if( libphdi_extent_values_initialize(
+		     &extent_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create extent values.",
+			 function );
+
+			goto on_error;
+		}
+		if( libphdi_extent_values_set_range(
+		     extent_values,
+		     (off64_t) extent_offset,
+		     (off64_t) ( extent_offset + extent_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set extent values range.",
+			 function );
+
+			goto on_error;
+		}
+		for( image_index = 0;
+		     image_index < number_of_images;
+		     image_index++ )
+		{
+			image_record = (phdi_metadata_index_image_t *) &( metadata_index->data[ data_offset ] );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 image_record->type,
+			 image_type );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 image_record->filename_size,
+			 filename_size );
+
+			data_offset += sizeof( phdi_metadata_index_image_t );
+
+			if( libphdi_image_values_initialize(
+			     &image_values,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create image values.",
+				 function );
+
+				goto on_error;
+			}
+			if( memory_copy(
+			     image_values->identifier,
+			     image_record->identifier,
+			     16 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy identifier.",
+				 function );
+
+				goto on_error;
+			}
+			image_values->type = (int) image_type;
+
+			if( libphdi_image_values_set_filename(
+			     image_values,
+			     &( metadata_index->data[ data_offset ] ),
+			     (size_t) filename_size - 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set image filename.",
+				 function );
+
+				goto on_error;
+			}
+			data_offset += ( (size_t) filename_size + 7 ) & ~( (size_t) 7 );
+
+			if( libcdata_array_append_entry(
+			     extent_values->image_values_array,
+			     &entry_index,
+			     (intptr_t *) image_values,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append image values to array.",
+				 function );
+
+				goto on_error;
+			}
+			image_values = NULL;
+		}
+		if( libcdata_array_append_entry(
+		     extent_values_array,
+		     &entry_index,
+		     (intptr_t *) extent_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extent values to array.",
+			 function );
+
+			goto on_error;
+		}
+		extent_values = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( image_values != NULL )
+	{
+		libphdi_image_values_free(
+		 &image_values,
+		 NULL );
+	}
+	if( extent_values != NULL )
+	{
+		libphdi_extent_values_free(
+		 &extent_values,
+		 NULL );
+	}
+	libcdata_array_empty(
+	 extent_values_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_extent_values_free,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Retrieves the snapshots
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_metadata_index_get_snapshots(
+     libphdi_metadata_index_t *metadata_index,
+     libcdata_array_t *snapshot_values_array,
+     libcerror_error_t **error )
+{
+	phdi_metadata_index_snapshot_t *record     = NULL;
+	libphdi_snapshot_values_t *snapshot_values = NULL;
+	static char *function                      = "libphdi_metadata_index_get_snapshots";
+	size_t data_offset                         = 0;
+	int entry_index                            = 0;
+	int snapshot_index                         = 0;
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_index->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid metadata index - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset = metadata_index->snapshots_data_offset;
+
+	for( snapshot_index = 0;
+	     snapshot_index < metadata_index->number_of_snapshots;
+	     snapshot_index++ )
+	{
+		record = (phdi_metadata_index_snapshot_t *) &( metadata_index->data[ data_offset ] );
+
+		if( libphdi_snapshot_values_initialize(
+		     &snapshot_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create snapshot values.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     snapshot_values->identifier,
+		     record->identifier,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy identifier.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     snapshot_values->parent_identifier,
+		     record->parent_identifier,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy parent identifier.",
+			 function );
+
+			goto on_error;
+		}
+		data_offset += sizeof( phdi_metadata_index_snapshot_t );
+
+		if( libcdata_array_append_entry(
+		     snapshot_values_array,
+		     &entry_index,
+		     (intptr_t *) snapshot_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append snapshot values to array.",
+			 function );
+
+			goto on_error;
+		}
+		snapshot_values = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( snapshot_values != NULL )
+	{
+		libphdi_snapshot_values_free(
+		 &snapshot_values,
+		 NULL );
+	}
+	libcdata_array_empty(
+	 snapshot_values_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_snapshot_values_free,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Validates the storage image records against the extent data files
+ * A storage image record is valid if the size, file header and the checksum of samples
+ * of the block allocation table of the extent data file match. Only samples are read,
+ * so that validating the index requires less IO than reading the block allocation tables
+ * Returns 1 if all storage image records are valid, 0 if not or -1 on error
+ */
+int libphdi_metadata_index_validate_storage_images(
+     libphdi_metadata_index_t *metadata_index,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	uint8_t data[ LIBPHDI_METADATA_INDEX_BLOCK_ALLOCATION_TABLE_SAMPLE_SIZE ];
+	uint8_t header_data[ sizeof( phdi_sparse_image_header_t ) ];
+
+	phdi_metadata_index_storage_image_t *record = NULL;
+	static char *function                       = "libphdi_metadata_index_validate_storage_images";
+	size64_t file_size                          = 0;
+	size64_t sample_offset                      = 0;
+	size64_t sample_size                        = 0;
+	size64_t table_offset                       = 0;
+	size64_t table_size                         = 0;
+	size_t read_size                            = 0;
+	ssize_t read_count                          = 0;
+	uint64_t checksum                           = 0;
+	uint64_t stored_checksum                    = 0;
+	uint64_t stored_file_size                   = 0;
+	uint32_t number_of_entries                  = 0;
+	int file_io_pool_entry                      = 0;
+	int result                                  = 0;
+	int sample_index                            = 0;
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_index->is_valid == 0 )
+	{
+		return( 0 );
+	}
+	for( file_io_pool_entry = 0;
+	     file_io_pool_entry < metadata_index->number_of_storage_images;
+	     file_io_pool_entry++ )
+	{
+		if( metadata_index->storage_images_data_offsets[ file_io_pool_entry ] == 0 )
+		{
+			continue;
+		}
+		record = (phdi_metadata_index_storage_image_t *) &( metadata_index->data[ metadata_index->storage_images_data_offsets[ file_io_pool_entry ] ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 record->file_size,
+		 stored_file_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 record->number_of_entries,
+		 number_of_entries );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 record->block_allocation_table_sample_checksum,
+		 stored_checksum );
+
+		if( libbfio_pool_get_size(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     &file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve size of file IO pool entry: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+		if( (uint64_t) file_size != stored_file_size )
+		{
+			metadata_index->is_valid = 0;
+
+			return( 0 );
+		}
+		read_count = libbfio_pool_read_buffer_at_offset(
+		              file_io_pool,
+		              file_io_pool_entry,
+		              header_data,
+		              sizeof( phdi_sparse_image_header_t ),
+		              0,
+		              error );
+
+		if( read_count != (ssize_t) sizeof( phdi_sparse_image_header_t ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read file header data from file IO pool entry: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+		if( memory_compare(
+		     header_data,
+		     record->sparse_image_header,
+		     sizeof( phdi_sparse_image_header_t ) ) != 0 )
+		{
+			metadata_index->is_valid = 0;
+
+			return( 0 );
+		}
+		/* The block allocation table can be rewritten in place without changing
+		 * the size or file header of the extent data file
+		 */
+		if( number_of_entries == 0 )
+		{
+			continue;
+		}
+		table_size = (size64_t) number_of_entries * 4;
+
+		if( table_size > ( file_size - (size64_t) sizeof( phdi_sparse_image_header_t ) ) )
+		{
+			metadata_index->is_valid = 0;
+
+			return( 0 );
+		}
+		checksum = LIBPHDI_METADATA_INDEX_CHECKSUM_INITIAL_VALUE;
+
+		for( sample_index = 0;
+		     sample_index < 3;
+		     sample_index++ )
+		{
+			result = libphdi_metadata_index_get_block_allocation_table_sample_range(
+			          table_size,
+			          sample_index,
+			          &sample_offset,
+			          &sample_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve block allocation table sample: %d range.",
+				 function,
+				 sample_index );
+
+				return( -1 );
+			}
+			else if( result == 0 )
+			{
+				break;
+			}
+			table_offset = (size64_t) sizeof( phdi_sparse_image_header_t ) + sample_offset;
+
+			while( sample_size > 0 )
+			{
+				read_size = LIBPHDI_METADATA_INDEX_BLOCK_ALLOCATION_TABLE_SAMPLE_SIZE;
+
+				if( (size64_t) read_size > sample_size )
+				{
+					read_size = (size_t) sample_size;
+				}
+				read_count = libbfio_pool_read_buffer_at_offset(
+				              file_io_pool,
+				              file_io_pool_entry,
+				              data,
+				              read_size,
+				              (off64_t) table_offset,
+				              error );
+
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read block allocation table data from file IO pool entry: %d at offset: %" PRIu64 " (0x%08" PRIx64 ").",
+					 function,
+					 file_io_pool_entry,
+					 table_offset,
+					 table_offset );
+
+					return( -1 );
+				}
+				if( libphdi_metadata_index_calculate_checksum(
+				     &checksum,
+				     data,
+				     read_size,
+				     checksum,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to calculate block allocation table checksum.",
+					 function );
+
+					return( -1 );
+				}
+				table_offset += read_size;
+				sample_size  -= read_size;
+			}
+		}
+		if( checksum != stored_checksum )
+		{
+			metadata_index->is_valid = 0;
+
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the storage image of a specific file IO pool entry
+ * The file header and block allocation table of the storage image are read from the index data
+ * This function does not modify the metadata index and can be called concurrently
+ * Returns 1 if successful, 0 if the storage image is not stored in the index or -1 on error
+ */
+int libphdi_metadata_index_get_storage_image(
+     libphdi_metadata_index_t *metadata_index,
+     int file_io_pool_entry,
+     libphdi_storage_image_t *storage_image,
+     libcerror_error_t **error )
+{
+	phdi_metadata_index_storage_image_t *record = NULL;
+	static char *function                       = "libphdi_metadata_index_get_storage_image";
+	size_t data_offset                          = 0;
+	uint32_t number_of_entries                  = 0;
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_image == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( metadata_index->is_valid == 0 )
+	 || ( file_io_pool_entry < 0 )
+	 || ( file_io_pool_entry >= metadata_index->number_of_storage_images ) )
+	{
+		return( 0 );
+	}
+	data_offset = metadata_index->storage_images_data_offsets[ file_io_pool_entry ];
+
+	if( data_offset == 0 )
+	{
+		return( 0 );
+	}
+	record = (phdi_metadata_index_storage_image_t *) &( metadata_index->data[ data_offset ] );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 record->number_of_entries,
+	 number_of_entries );
+
+	/* The paged block allocation table of a large storage image is not stored in the index
+	 */
+	if( number_of_entries == 0 )
+	{
+		return( 0 );
+	}
+	if( libphdi_storage_image_read_file_header_data(
+	     storage_image,
+	     record->sparse_image_header,
+	     sizeof( phdi_sparse_image_header_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read storage image file header data.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset += sizeof( phdi_metadata_index_storage_image_t );
+
+	if( libphdi_storage_image_read_block_allocation_table_data(
+	     storage_image,
+	     &( metadata_index->data[ data_offset ] ),
+	     (size_t) number_of_entries * 4,
+	     file_io_pool_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read storage image block allocation table data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the block size of the storage image of a specific file IO pool entry
+ * The block size is read from the file header that is stored in the index data
+ * This function does not modify the metadata index and can be called concurrently
+ * Returns 1 if successful, 0 if the storage image is not stored in the index or -1 on error
+ */
+int libphdi_metadata_index_get_storage_image_block_size(
+     libphdi_metadata_index_t *metadata_index,
+     int file_io_pool_entry,
+     size64_t *block_size,
+     libcerror_error_t **error )
+{
+	phdi_metadata_index_storage_image_t *record = NULL;
+	libphdi_storage_image_t *storage_image      = NULL;
+	static char *function                       = "libphdi_metadata_index_get_storage_image_block_size";
+	size_t data_offset                          = 0;
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( metadata_index->is_valid == 0 )
+	 || ( file_io_pool_entry < 0 )
+	 || ( file_io_pool_entry >= metadata_index->number_of_storage_images ) )
+	{
+		return( 0 );
+	}
+	data_offset = metadata_index->storage_images_data_offsets[ file_io_pool_entry ];
+
+	if( data_offset == 0 )
+	{
+		return( 0 );
+	}
+	record = (phdi_metadata_index_storage_image_t *) &( metadata_index->data[ data_offset ] );
+
+	if( libphdi_storage_image_initialize(
+	     &storage_image,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create storage image.",
+		 function );
+
+		goto on_error;
+	}
+	if( libphdi_storage_image_read_file_header_data(
+	     storage_image,
+	     record->sparse_image_header,
+	     sizeof( phdi_sparse_image_header_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read storage image file header data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libphdi_storage_image_get_block_size(
+	     storage_image,
+	     block_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve storage image block size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libphdi_storage_image_free(
+	     &storage_image,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free storage image.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( storage_image != NULL )
+	{
+		libphdi_storage_image_free(
+		 &storage_image,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Appends a record to the index data that is being built
+ * The record data is followed by the trailing data and padded to a multiple of 8 bytes
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_metadata_index_append_data(
+     libphdi_metadata_index_t *metadata_index,
+     const uint8_t *record_data,
+     size_t record_data_size,
+     const uint8_t *trailing_data,
+     size_t trailing_data_size,
+     libcerror_error_t **error )
+{
+	uint8_t *reallocation = NULL;
+	static char *function = "libphdi_metadata_index_append_data";
+	size_t buffer_size    = 0;
+	size_t data_size      = 0;
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( metadata_index->data != NULL )
+	 && ( metadata_index->data != metadata_index->buffer ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid metadata index - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( record_data == NULL )
+	 && ( record_data_size != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( trailing_data == NULL )
+	 && ( trailing_data_size != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trailing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( record_data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	 || ( trailing_data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	 || ( ( record_data_size + trailing_data_size ) > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE - 7 - metadata_index->data_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	data_size = ( metadata_index->data_size + record_data_size + trailing_data_size + 7 ) & ~( (size_t) 7 );
+
+	if( data_size > metadata_index->buffer_size )
+	{
+		buffer_size = metadata_index->buffer_size * 2;
+
+		if( buffer_size < 4096 )
+		{
+			buffer_size = 4096;
+		}
+		if( ( buffer_size < data_size )
+		 || ( buffer_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+		{
+			buffer_size = data_size;
+		}
+		reallocation = (uint8_t *) memory_reallocate(
+		                            metadata_index->buffer,
+		                            sizeof( uint8_t ) * buffer_size );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize buffer.",
+			 function );
+
+			return( -1 );
+		}
+		metadata_index->buffer      = reallocation;
+		metadata_index->buffer_size = buffer_size;
+	}
+	if( memory_set(
+	     &( metadata_index->buffer[ metadata_index->data_size ] ),
+	     0,
+	     data_size - metadata_index->data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_data_size > 0 )
+	{
+		if( memory_copy(
+		     &( metadata_index->buffer[ metadata_index->data_size ] ),
+		     record_data,
+		     record_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy record data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( trailing_data_size > 0 )
+	{
+		if( memory_copy(
+		     &( metadata_index->buffer[ metadata_index->data_size + record_data_size ] ),
+		     trailing_data,
+		     trailing_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy trailing data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	metadata_index->data      = metadata_index->buffer;
+	metadata_index->data_size = data_size;
+
+	return( 1 );
+}
+
+/* Sets the values of the disk descriptor XML file in the index data that is being built
+ * Any previous index data is discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_metadata_index_set_values(
+     libphdi_metadata_index_t *metadata_index,
+     int disk_type,
+     libphdi_disk_parameters_t *disk_parameters,
+     libcdata_array_t *extent_values_array,
+     libcdata_array_t *snapshot_values_array,
+     libcerror_error_t **error )
+{
+	phdi_metadata_index_disk_parameters_t disk_parameters_record;
+	phdi_metadata_index_extent_t extent_record;
+	phdi_metadata_index_file_header_t file_header;
+	phdi_metadata_index_image_t image_record;
+	phdi_metadata_index_snapshot_t snapshot_record;
+
+	libphdi_extent_values_t *extent_values     = NULL;
+	libphdi_image_values_t *image_values       = NULL;
+	libphdi_snapshot_values_t *snapshot_values = NULL;
+	static char *function                      = "libphdi_metadata_index_set_values";
+	size64_t descriptor_size                   = 0;
+	uint64_t descriptor_checksum               = 0;
+	int extent_index                           = 0;
+	int image_index                            = 0;
+	int number_of_extents                      = 0;
+	int number_of_images                       = 0;
+	int number_of_snapshots                    = 0;
+	int snapshot_index                         = 0;
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( disk_parameters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk parameters.",
+		 function );
+
+		return( -1 );
+	}
+	if( disk_parameters->name_size > (size_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid disk parameters - name size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     extent_values_array,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     snapshot_values_array,
+	     &number_of_snapshots,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of snapshots.",
+		 function );
+
+		goto on_error;
+	}
+	/* The descriptor values are retained since they identify the index data
+	 */
+	descriptor_size     = metadata_index->descriptor_size;
+	descriptor_checksum = metadata_index->descriptor_checksum;
+
+	if( libphdi_metadata_index_clear(
+	     metadata_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear metadata index.",
+		 function );
+
+		goto on_error;
+	}
+	metadata_index->descriptor_size     = descriptor_size;
+	metadata_index->descriptor_checksum = descriptor_checksum;
+
+	/* The file header is set when the index data is written
+	 */
+	if( memory_set(
+	     &file_header,
+	     0,
+	     sizeof( phdi_metadata_index_file_header_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( libphdi_metadata_index_append_data(
+	     metadata_index,
+	     (uint8_t *) &file_header,
+	     sizeof( phdi_metadata_index_file_header_t ),
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     &disk_parameters_record,
+	     0,
+	     sizeof( phdi_metadata_index_disk_parameters_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear disk parameters record.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 disk_parameters_record.media_size,
+	 disk_parameters->media_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 disk_parameters_record.number_of_sectors,
+	 disk_parameters->number_of_sectors );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 disk_parameters_record.number_of_cylinders,
+	 disk_parameters->number_of_cylinders );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 disk_parameters_record.number_of_heads,
+	 disk_parameters->number_of_heads );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 disk_parameters_record.name_size,
+	 (uint32_t) disk_parameters->name_size );
+
+	if( libphdi_metadata_index_append_data(
+	     metadata_index,
+	     (uint8_t *) &disk_parameters_record,
+	     sizeof( phdi_metadata_index_disk_parameters_t ),
+	     disk_parameters->name,
+	     disk_parameters->name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append disk parameters record.",
+		 function );
+
+		goto on_error;
+	}
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     extent_values_array,
+		     extent_index,
+		     (intptr_t **) &extent_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent values: %d from array.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libphdi_extent_values_get_number_of_images(
+		     extent_values,
+		     &number_of_images,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of images of extent values: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     &extent_record,
+		     0,
+		     sizeof( phdi_metadata_index_extent_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear extent record.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_from_uint64_little_endian(
+		 extent_record.offset,
+		 (uint64_t) extent_values->offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 extent_record.size,
+		 extent_values->size );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 extent_record.number_of_images,
+		 (uint32_t) number_of_images );
+
+		if( libphdi_metadata_index_append_data(
+		     metadata_index,
+		     (uint8_t *) &extent_record,
+		     sizeof( phdi_metadata_index_extent_t ),
+		     NULL,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extent record: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		for( image_index = 0;
+		     image_index < number_of_images;
+		     image_index++ )
+		{
+			if( libphdi_extent_values_get_image_values_by_index(
+			     extent_values,
+			     image_index,
+			     &image_values,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve image values: %d from extent values: %d.",
+				 function,
+				 image_index,
+				 extent_index );
+
+				goto on_error;
+			}
+			if( ( image_values->filename == NULL )
+			 || ( image_values->filename_size < 2 )
+			 || ( image_values->filename_size > (size_t) UINT32_MAX ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid image values: %d of extent values: %d - filename value out of bounds.",
+				 function,
+				 image_index,
+				 extent_index );
+
+				goto on_error;
+			}
+			if( memory_copy(
+			     image_record.identifier,
+			     image_values->identifier,
+			     16 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy identifier.",
+				 function );
+
+				goto on_error;
+			}
+			byte_stream_copy_from_uint32_little_endian(
+			 image_record.type,
+			 (uint32_t) image_values->type );
+
+			byte_stream_copy_from_uint32_little_endian(
+			 image_record.filename_size,
+			 (uint32_t) image_values->filename_size );
+
+			if( libphdi_metadata_index_append_data(
+			     metadata_index,
+			     (uint8_t *) &image_record,
+			     sizeof( phdi_metadata_index_image_t ),
+			     image_values->filename,
+			     image_values->filename_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append image record: %d of extent: %d.",
+				 function,
+				 image_index,
+				 extent_index );
+
+				goto on_error;
+			}
+		}
+	}
+	metadata_index->snapshots_data_offset = metadata_index->data_size;
+
+	for( snapshot_index = 0;
+	     snapshot_index < number_of_snapshots;
+	     snapshot_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     snapshot_values_array,
+		     snapshot_index,
+		     (intptr_t **) &snapshot_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve snapshot values: %d from array.",
+			 function,
+			 snapshot_index );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     snapshot_record.identifier,
+		     snapshot_values->identifier,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy identifier.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     snapshot_record.parent_identifier,
+		     snapshot_values->parent_identifier,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy parent identifier.",
+			 function );
+
+			goto on_error;
+		}
+		if( libphdi_metadata_index_append_data(
+		     metadata_index,
+		     (uint8_t *) &snapshot_record,
+		     sizeof( phdi_metadata_index_snapshot_t ),
+		     NULL,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append snapshot record: %d.",
+			 function,
+			 snapshot_index );
+
+			goto on_error;
+		}
+	}
+	metadata_index->disk_type           = disk_type;
+	metadata_index->number_of_extents   = number_of_extents;
+	metadata_index->number_of_snapshots = number_of_snapshots;
+
+	return( 1 );
+
+on_error:
+	libphdi_metadata_index_clear(
+	 metadata_index,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Appends the storage image of a specific file IO pool entry to the index data that is being built
+ * The storage images must be appended in order of their file IO pool entry
+ * The file size and file header data are stored for every image type, so that an index can be
+ * validated against the extent data files, the block allocation table is only stored for
+ * a compressed image of which the block allocation table is not read in pages on demand
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_metadata_index_append_storage_image(
+     libphdi_metadata_index_t *metadata_index,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     int image_type,
+     libcerror_error_t **error )
+{
+	phdi_metadata_index_storage_image_t record;
+
+	libphdi_storage_image_t *storage_image    = NULL;
+	uint8_t *block_allocation_table_data      = NULL;
+	static char *function                     = "libphdi_metadata_index_append_storage_image";
+	size_t block_allocation_table_data_offset = 0;
+	size_t block_allocation_table_data_size   = 0;
+	size64_t file_size                        = 0;
+	size64_t sample_offset                    = 0;
+	size64_t sample_size                      = 0;
+	ssize_t read_count                        = 0;
+	uint64_t block_allocation_table_checksum  = 0;
+	uint32_t entry_index                      = 0;
+	uint32_t number_of_entries                = 0;
+	int result                                = 0;
+	int sample_index                          = 0;
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_index->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid metadata index - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_index->number_of_storage_images == INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid metadata index - number of storage images value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry != metadata_index->number_of_storage_images )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &record,
+	     0,
+	     sizeof( phdi_metadata_index_storage_image_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear storage image record.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_get_size(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size of file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	read_count = libbfio_pool_read_buffer_at_offset(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              record.sparse_image_header,
+	              sizeof( phdi_sparse_image_header_t ),
+	              0,
+	              error );
+
+	if( read_count != (ssize_t) sizeof( phdi_sparse_image_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header data from file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	if( image_type == LIBPHDI_IMAGE_TYPE_COMPRESSED )
+	{
+		if( libphdi_storage_image_initialize(
+		     &storage_image,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create storage image.",
+			 function );
+
+			goto on_error;
+		}
+		if( libphdi_storage_image_read_file_io_pool(
+		     storage_image,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read storage image from file IO pool entry: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+		if( storage_image->block_allocation_table != NULL )
+		{
+			number_of_entries                = storage_image->number_of_block_allocation_table_entries;
+			block_allocation_table_data_size = (size_t) number_of_entries * 4;
+
+			block_allocation_table_data = (uint8_t *) memory_allocate(
+			                                           sizeof( uint8_t ) * block_allocation_table_data_size );
+
+			if( block_allocation_table_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create block allocation table data.",
+				 function );
+
+				goto on_error;
+			}
+			for( entry_index = 0;
+			     entry_index < number_of_entries;
+			     entry_index++ )
+			{
+				byte_stream_copy_from_uint32_little_endian(
+				 &( block_allocation_table_data[ block_allocation_table_data_offset ] ),
+				 storage_image->block_allocation_table[ entry_index ] );
+
+				block_allocation_table_data_offset += 4;
+			}
+			block_allocation_table_checksum = LIBPHDI_METADATA_INDEX_CHECKSUM_INITIAL_VALUE;
+
+			for( sample_index = 0;
+			     sample_index < 3;
+			     sample_index++ )
+			{
+				result = libphdi_metadata_index_get_block_allocation_table_sample_range(
+				          (size64_t) block_allocation_table_data_size,
+				          sample_index,
+				          &sample_offset,
+				          &sample_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve block allocation table sample: %d range.",
+					 function,
+					 sample_index );
+
+					goto on_error;
+				}
+				else if( result == 0 )
+				{
+					break;
+				}
+				if( libphdi_metadata_index_calculate_checksum(
+				     &block_allocation_table_checksum,
+				     &( block_allocation_table_data[ sample_offset ] ),
+				     (size_t) sample_size,
+				     block_allocation_table_checksum,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to calculate block allocation table checksum.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+		if( libphdi_storage_image_free(
+		     &storage_image,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free storage image.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 record.file_size,
+	 (uint64_t) file_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 record.file_io_pool_entry,
+	 (uint32_t) file_io_pool_entry );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 record.number_of_entries,
+	 number_of_entries );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 record.block_allocation_table_sample_checksum,
+	 block_allocation_table_checksum );
+
+	if( libphdi_metadata_index_append_data(
+	     metadata_index,
+	     (uint8_t *) &record,
+	     sizeof( phdi_metadata_index_storage_image_t ),
+	     block_allocation_table_data,
+	     block_allocation_table_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append storage image record.",
+		 function );
+
+		goto on_error;
+	}
+	if( block_allocation_table_data != NULL )
+	{
+		memory_free(
+		 block_allocation_table_data );
+	}
+	metadata_index->number_of_storage_images += 1;
+
+	return( 1 );
+
+on_error:
+	if( block_allocation_table_data != NULL )
+	{
+		memory_free(
+		 block_allocation_table_data );
+	}
+	if( storage_image != NULL )
+	{
+		libphdi_storage_image_free(
+		 &storage_image,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the index data that was built to the metadata index file
+ * After the index data was written it is read, so that it can be used
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_metadata_index_write_file(
+     libphdi_metadata_index_t *metadata_index,
+     libcerror_error_t **error )
+{
+	phdi_metadata_index_file_header_t *file_header = NULL;
+	libbfio_handle_t *file_io_handle               = NULL;
+	static char *function                          = "libphdi_metadata_index_write_file";
+	size_t data_size                               = 0;
+	ssize_t write_count                            = 0;
+	uint64_t checksum                              = 0;
+	int result                                     = 0;
+
+	if( metadata_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata index.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_index->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid metadata index - missing filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( metadata_index->buffer == NULL )
+	 || ( metadata_index->data != metadata_index->buffer )
+	 || ( metadata_index->data_size < ( sizeof( phdi_metadata_index_file_header_t ) + sizeof( phdi_metadata_index_disk_parameters_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid metadata index - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libphdi_metadata_index_calculate_checksum(
+	     &checksum,
+	     &( metadata_index->buffer[ sizeof( phdi_metadata_index_file_header_t ) ] ),
+	     metadata_index->data_size - sizeof( phdi_metadata_index_file_header_t ),
+	     LIBPHDI_METADATA_INDEX_CHECKSUM_INITIAL_VALUE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		goto on_error;
+	}
+	file_header = (phdi_metadata_index_file_header_t *) metadata_index->buffer;
+
+	if( memory_copy(
+	     file_header->signature,
+	     phdi_metadata_index_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->format_version,
+	 LIBPHDI_METADATA_INDEX_FORMAT_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->disk_type,
+	 (uint32_t) metadata_index->disk_type );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header->data_size,
+	 (uint64_t) ( metadata_index->data_size - sizeof( phdi_metadata_index_file_header_t ) ) );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header->checksum,
+	 checksum );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header->descriptor_size,
+	 (uint64_t) metadata_index->descriptor_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header->descriptor_checksum,
+	 metadata_index->descriptor_checksum );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->number_of_extents,
+	 (uint32_t) metadata_index->number_of_extents );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->number_of_snapshots,
+	 (uint32_t) metadata_index->number_of_snapshots );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->number_of_storage_images,
+	 (uint32_t) metadata_index->number_of_storage_images );
+
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfio_file_set_name_wide(
+	          file_io_handle,
+	          metadata_index->filename,
+	          metadata_index->filename_size - 1,
+	          error );
+#else
+	result = libbfio_file_set_name(
+	          file_io_handle,
+	          metadata_index->filename,
+	          metadata_index->filename_size - 1,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open metadata index file: %" PRIs_SYSTEM ".",
+		 function,
+		 metadata_index->filename );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               metadata_index->buffer,
+	               metadata_index->data_size,
+	               error );
+
+	if( write_count != (ssize_t) metadata_index->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write metadata index data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close metadata index file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	data_size = metadata_index->data_size;
+
+	metadata_index->data      = NULL;
+	metadata_index->data_size = 0;
+
+	result = libphdi_metadata_index_read_data(
+	          metadata_index,
+	          metadata_index->buffer,
+	          data_size,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read metadata index data.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
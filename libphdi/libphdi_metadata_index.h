@@ -0,0 +1,229 @@
+/*
+ * Metadata index functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPHDI_METADATA_INDEX_H )
+#define _LIBPHDI_METADATA_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libphdi_disk_parameters.h"
+#include "libphdi_libbfio.h"
+#include "libphdi_libcdata.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_storage_image.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libphdi_metadata_index libphdi_metadata_index_t;
+
+struct libphdi_metadata_index
+{
+	/* The filename
+	 */
+	system_character_t *filename;
+
+	/* The filename size
+	 */
+	size_t filename_size;
+
+	/* The size of the disk descriptor XML file
+	 */
+	size64_t descriptor_size;
+
+	/* The checksum of the disk descriptor XML file
+	 */
+	uint64_t descriptor_checksum;
+
+	/* The index data
+	 */
+	const uint8_t *data;
+
+	/* The index data size
+	 */
+	size_t data_size;
+
+	/* The index data buffer, contains the index data that was read or is being built
+	 */
+	uint8_t *buffer;
+
+	/* The allocated size of the index data buffer
+	 */
+	size_t buffer_size;
+
+	/* The disk type
+	 */
+	int disk_type;
+
+	/* The number of extents
+	 */
+	int number_of_extents;
+
+	/* The number of snapshots
+	 */
+	int number_of_snapshots;
+
+	/* The number of storage images
+	 */
+	int number_of_storage_images;
+
+	/* The offset of the snapshot records in the index data
+	 */
+	size_t snapshots_data_offset;
+
+	/* The offsets of the storage image records in the index data
+	 */
+	size_t *storage_images_data_offsets;
+
+	/* Value to indicate the index data is valid and matches the disk descriptor XML file
+	 */
+	uint8_t is_valid;
+};
+
+int libphdi_metadata_index_initialize(
+     libphdi_metadata_index_t **metadata_index,
+     libcerror_error_t **error );
+
+int libphdi_metadata_index_free(
+     libphdi_metadata_index_t **metadata_index,
+     libcerror_error_t **error );
+
+int libphdi_metadata_index_clear(
+     libphdi_metadata_index_t *metadata_index,
+     libcerror_error_t **error );
+
+int libphdi_metadata_index_set_filename(
+     libphdi_metadata_index_t *metadata_index,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+int libphdi_metadata_index_set_filename_wide(
+     libphdi_metadata_index_t *metadata_index,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+int libphdi_metadata_index_calculate_checksum(
+     uint64_t *checksum,
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t initial_value,
+     libcerror_error_t **error );
+
+int libphdi_metadata_index_get_block_allocation_table_sample_range(
+     size64_t block_allocation_table_size,
+     int sample_index,
+     size64_t *sample_offset,
+     size64_t *sample_size,
+     libcerror_error_t **error );
+
+int libphdi_metadata_index_read_descriptor_file_io_handle(
+     libphdi_metadata_index_t *metadata_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libphdi_metadata_index_read_data(
+     libphdi_metadata_index_t *metadata_index,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libphdi_metadata_index_read_file(
+     libphdi_metadata_index_t *metadata_index,
+     libcerror_error_t **error );
+
+int libphdi_metadata_index_get_disk_type(
+     libphdi_metadata_index_t *metadata_index,
+     int *disk_type,
+     libcerror_error_t **error );
+
+int libphdi_metadata_index_get_disk_parameters(
+     libphdi_metadata_index_t *metadata_index,
+     libphdi_disk_parameters_t *disk_parameters,
+     libcerror_error_t **error );
+
+int libphdi_metadata_index_get_extents(
+     libphdi_metadata_index_t *metadata_index,
+     libcdata_array_t *extent_values_array,
+     libcerror_error_t **error );
+
+int libphdi_metadata_index_get_snapshots(
+     libphdi_metadata_index_t *metadata_index,
+     libcdata_array_t *snapshot_values_array,
+     libcerror_error_t **error );
+
+int libphdi_metadata_index_validate_storage_images(
+     libphdi_metadata_index_t *metadata_index,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
+int libphdi_metadata_index_get_storage_image(
+     libphdi_metadata_index_t *metadata_index,
+     int file_io_pool_entry,
+     libphdi_storage_image_t *storage_image,
+     libcerror_error_t **error );
+
+int libphdi_metadata_index_get_storage_image_block_size(
+     libphdi_metadata_index_t *metadata_index,
+     int file_io_pool_entry,
+     size64_t *block_size,
+     libcerror_error_t **error );
+
+int libphdi_metadata_index_append_data(
+     libphdi_metadata_index_t *metadata_index,
+     const uint8_t *record_data,
+     size_t record_data_size,
+     const uint8_t *trailing_data,
+     size_t trailing_data_size,
+     libcerror_error_t **error );
+
+int libphdi_metadata_index_set_values(
+     libphdi_metadata_index_t *metadata_index,
+     int disk_type,
+     libphdi_disk_parameters_t *disk_parameters,
+     libcdata_array_t *extent_values_array,
+     libcdata_array_t *snapshot_values_array,
+     libcerror_error_t **error );
+
+int libphdi_metadata_index_append_storage_image(
+     libphdi_metadata_index_t *metadata_index,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     int image_type,
+     libcerror_error_t **error );
+
+int libphdi_metadata_index_write_file(
+     libphdi_metadata_index_t *metadata_index,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPHDI_METADATA_INDEX_H ) */
+
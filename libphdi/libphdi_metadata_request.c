@@ -0,0 +1,249 @@
+/*
+ * Metadata request functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libphdi_extent_table.h"
+#include "libphdi_libbfio.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_metadata_request.h"
+#include "libphdi_storage_image.h"
+
+/* Creates a metadata request
+ * Make sure the value metadata_request is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_metadata_request_initialize(
+     libphdi_metadata_request_t **metadata_request,
+     libphdi_extent_table_t *extent_table,
+     int extent_index,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_metadata_request_initialize";
+
+	if( metadata_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata request.",
+		 function );
+
+		return( -1 );
+	}
+	if( *metadata_request != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid metadata request value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid extent index value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	*metadata_request = memory_allocate_structure(
+	                     libphdi_metadata_request_t );
+
+	if( *metadata_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create metadata request.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *metadata_request,
+	     0,
+	     sizeof( libphdi_metadata_request_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear metadata request.",
+		 function );
+
+		goto on_error;
+	}
+	( *metadata_request )->extent_table = extent_table;
+	( *metadata_request )->extent_index = extent_index;
+	( *metadata_request )->file_io_pool = file_io_pool;
+	( *metadata_request )->result       = -1;
+
+	return( 1 );
+
+on_error:
+	if( *metadata_request != NULL )
+	{
+		memory_free(
+		 *metadata_request );
+
+		*metadata_request = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a metadata request
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_metadata_request_free(
+     libphdi_metadata_request_t **metadata_request,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_metadata_request_free";
+	int result            = 1;
+
+	if( metadata_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata request.",
+		 function );
+
+		return( -1 );
+	}
+	if( *metadata_request != NULL )
+	{
+		/* The extent table and file IO pool are managed by the handle and not freed here
+		 */
+		if( ( *metadata_request )->storage_image != NULL )
+		{
+			if( libphdi_storage_image_free(
+			     &( ( *metadata_request )->storage_image ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free storage image.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *metadata_request );
+
+		*metadata_request = NULL;
+	}
+	return( result );
+}
+
+/* Reads the storage image file header and block allocation table of a metadata request
+ * The storage image is kept by the request until it is set in the extent files cache
+ * This function can be called concurrently for requests of different extents
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_metadata_request_read(
+     libphdi_metadata_request_t *metadata_request,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_metadata_request_read";
+
+	if( metadata_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata request.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_request->storage_image != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid metadata request - storage image value already set.",
+		 function );
+
+		return( -1 );
+	}
+	metadata_request->result = libphdi_extent_table_read_extent_file(
+	                            metadata_request->extent_table,
+	                            metadata_request->file_io_pool,
+	                            metadata_request->extent_index,
+	                            &( metadata_request->storage_image ),
+	                            error );
+
+	if( metadata_request->result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read extent file: %d.",
+		 function,
+		 metadata_request->extent_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
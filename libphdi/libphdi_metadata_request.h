@@ -0,0 +1,82 @@
+/*
+ * Metadata request functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPHDI_METADATA_REQUEST_H )
+#define _LIBPHDI_METADATA_REQUEST_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libphdi_extent_table.h"
+#include "libphdi_libbfio.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_storage_image.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libphdi_metadata_request libphdi_metadata_request_t;
+
+struct libphdi_metadata_request
+{
+	/* The extent table
+	 */
+	libphdi_extent_table_t *extent_table;
+
+	/* The extent index
+	 */
+	int extent_index;
+
+	/* The file IO pool
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The storage image that was read
+	 */
+	libphdi_storage_image_t *storage_image;
+
+	/* The result, 1 if the storage image was read or -1 if the read failed
+	 */
+	int result;
+};
+
+int libphdi_metadata_request_initialize(
+     libphdi_metadata_request_t **metadata_request,
+     libphdi_extent_table_t *extent_table,
+     int extent_index,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
+int libphdi_metadata_request_free(
+     libphdi_metadata_request_t **metadata_request,
+     libcerror_error_t **error );
+
+int libphdi_metadata_request_read(
+     libphdi_metadata_request_t *metadata_request,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPHDI_METADATA_REQUEST_H ) */
+
@@ -0,0 +1,69 @@
+/*
+ * Static tracing probe definitions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPHDI_PROBES_H )
+#define _LIBPHDI_PROBES_H
+
+#include <common.h>
+
+/* The probes are statically defined user-space tracepoints (USDT) of the libphdi provider
+ * that can be attached to with tools like bpftrace, perf or SystemTap, e.g.
+ *   bpftrace -e 'usdt:/usr/lib/libphdi.so:libphdi:file_io__read__done { @[arg0] = hist(arg3); }'
+ *
+ * block__resolve                      logical offset, snapshot level, result, file IO pool entry, file offset, range size
+ * block__sparse                       logical offset, snapshot level, size
+ * block__parent                       logical offset, snapshot level, size
+ * file_io__read__start                file IO pool entry, file offset, size
+ * file_io__read__done                 file IO pool entry, file offset, size, read count
+ * block_allocation_table__read__start file IO pool entry, number of entries, is paged
+ * block_allocation_table__read__done  file IO pool entry, result
+ * block_allocation_table__page__read  file IO pool entry, page index, file offset, read count
+ *
+ * When probes are not enabled the probe macros expand to nothing
+ */
+#if defined( HAVE_LIBPHDI_PROBES ) && defined( HAVE_SYS_SDT_H )
+#include <sys/sdt.h>
+
+#define LIBPHDI_PROBE2( name, argument1, argument2 ) \
+	DTRACE_PROBE2( libphdi, name, argument1, argument2 )
+
+#define LIBPHDI_PROBE3( name, argument1, argument2, argument3 ) \
+	DTRACE_PROBE3( libphdi, name, argument1, argument2, argument3 )
+
+#define LIBPHDI_PROBE4( name, argument1, argument2, argument3, argument4 ) \
+	DTRACE_PROBE4( libphdi, name, argument1, argument2, argument3, argument4 )
+
+#define LIBPHDI_PROBE6( name, argument1, argument2, argument3, argument4, argument5, argument6 ) \
+	DTRACE_PROBE6( libphdi, name, argument1, argument2, argument3, argument4, argument5, argument6 )
+
+#else
+#define LIBPHDI_PROBE2( name, argument1, argument2 )
+
+#define LIBPHDI_PROBE3( name, argument1, argument2, argument3 )
+
+#define LIBPHDI_PROBE4( name, argument1, argument2, argument3, argument4 )
+
+#define LIBPHDI_PROBE6( name, argument1, argument2, argument3, argument4, argument5, argument6 )
+
+#endif /* defined( HAVE_LIBPHDI_PROBES ) && defined( HAVE_SYS_SDT_H ) */
+
+#endif /* !defined( _LIBPHDI_PROBES_H ) */
+
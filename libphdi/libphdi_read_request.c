@@ -0,0 +1,176 @@
+/*
+ * Read request functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libphdi_libcerror.h"
+#include "libphdi_read_request.h"
+
+/* Creates a read request
+ * Make sure the value read_request is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_read_request_initialize(
+     libphdi_read_request_t **read_request,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     intptr_t user_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_read_request_initialize";
+
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_request != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read request value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	*read_request = memory_allocate_structure(
+	                 libphdi_read_request_t );
+
+	if( *read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read request.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_request,
+	     0,
+	     sizeof( libphdi_read_request_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read request.",
+		 function );
+
+		goto on_error;
+	}
+	( *read_request )->buffer      = buffer;
+	( *read_request )->buffer_size = buffer_size;
+	( *read_request )->offset      = offset;
+	( *read_request )->user_data   = user_data;
+	( *read_request )->read_count  = -1;
+
+	return( 1 );
+
+on_error:
+	if( *read_request != NULL )
+	{
+		memory_free(
+		 *read_request );
+
+		*read_request = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read request
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_read_request_free(
+     libphdi_read_request_t **read_request,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_read_request_free";
+
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_request != NULL )
+	{
+		/* The buffer is managed by the caller and not freed here
+		 */
+		memory_free(
+		 *read_request );
+
+		*read_request = NULL;
+	}
+	return( 1 );
+}
+
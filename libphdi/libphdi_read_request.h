@@ -0,0 +1,76 @@
+/*
+ * Read request functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPHDI_READ_REQUEST_H )
+#define _LIBPHDI_READ_REQUEST_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libphdi_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libphdi_read_request libphdi_read_request_t;
+
+struct libphdi_read_request
+{
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The user data that identifies the request
+	 */
+	intptr_t user_data;
+
+	/* The number of bytes read or -1 if the read failed
+	 */
+	ssize_t read_count;
+};
+
+int libphdi_read_request_initialize(
+     libphdi_read_request_t **read_request,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     intptr_t user_data,
+     libcerror_error_t **error );
+
+int libphdi_read_request_free(
+     libphdi_read_request_t **read_request,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPHDI_READ_REQUEST_H ) */
+
@@ -0,0 +1,544 @@
+/*
+ * Read vector functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libphdi_definitions.h"
+#include "libphdi_libbfio.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_libcnotify.h"
+#include "libphdi_read_vector.h"
+#include "libphdi_statistics.h"
+
+/* Creates a read vector
+ * Make sure the value read_vector is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_read_vector_initialize(
+     libphdi_read_vector_t **read_vector,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_read_vector_initialize";
+
+	if( read_vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_vector != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read vector value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*read_vector = memory_allocate_structure(
+	                libphdi_read_vector_t );
+
+	if( *read_vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read vector.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_vector,
+	     0,
+	     sizeof( libphdi_read_vector_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read vector.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *read_vector != NULL )
+	{
+		memory_free(
+		 *read_vector );
+
+		*read_vector = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read vector
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_read_vector_free(
+     libphdi_read_vector_t **read_vector,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_read_vector_free";
+
+	if( read_vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_vector != NULL )
+	{
+		if( ( *read_vector )->merge_buffer != NULL )
+		{
+			memory_free(
+			 ( *read_vector )->merge_buffer );
+		}
+		if( ( *read_vector )->segments != NULL )
+		{
+			memory_free(
+			 ( *read_vector )->segments );
+		}
+		memory_free(
+		 *read_vector );
+
+		*read_vector = NULL;
+	}
+	return( 1 );
+}
+
+/* Appends a segment to the read vector
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_read_vector_append_segment(
+     libphdi_read_vector_t *read_vector,
+     int request_index,
+     int file_io_pool_entry,
+     off64_t file_offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	libphdi_read_vector_segment_t *segment  = NULL;
+	libphdi_read_vector_segment_t *segments = NULL;
+	static char *function                   = "libphdi_read_vector_append_segment";
+	size_t segments_size                    = 0;
+	int number_of_allocated_segments        = 0;
+
+	if( read_vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( request_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid request index value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_vector->number_of_segments >= read_vector->number_of_allocated_segments )
+	{
+		if( read_vector->number_of_allocated_segments == 0 )
+		{
+			number_of_allocated_segments = 16;
+		}
+		else if( read_vector->number_of_allocated_segments > ( INT_MAX / 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of allocated segments value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		else
+		{
+			number_of_allocated_segments = read_vector->number_of_allocated_segments * 2;
+		}
+		segments_size = sizeof( libphdi_read_vector_segment_t ) * number_of_allocated_segments;
+
+		if( segments_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid segments size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		segments = (libphdi_read_vector_segment_t *) memory_reallocate(
+		                                              read_vector->segments,
+		                                              segments_size );
+
+		if( segments == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize segments.",
+			 function );
+
+			return( -1 );
+		}
+		read_vector->segments                     = segments;
+		read_vector->number_of_allocated_segments = number_of_allocated_segments;
+	}
+	segment = &( read_vector->segments[ read_vector->number_of_segments ] );
+
+	segment->request_index      = request_index;
+	segment->file_io_pool_entry = file_io_pool_entry;
+	segment->file_offset        = file_offset;
+	segment->buffer             = buffer;
+	segment->size               = size;
+
+	read_vector->number_of_segments += 1;
+
+	return( 1 );
+}
+
+/* Compares two segments by file IO pool entry and file offset
+ * Returns -1 if the first segment is less than the second, 0 if equal or 1 if greater
+ */
+int libphdi_read_vector_segment_compare(
+     const void *first_segment,
+     const void *second_segment )
+{
+	const libphdi_read_vector_segment_t *safe_first_segment  = (const libphdi_read_vector_segment_t *) first_segment;
+	const libphdi_read_vector_segment_t *safe_second_segment = (const libphdi_read_vector_segment_t *) second_segment;
+
+	if( safe_first_segment->file_io_pool_entry < safe_second_segment->file_io_pool_entry )
+	{
+		return( -1 );
+	}
+	if( safe_first_segment->file_io_pool_entry > safe_second_segment->file_io_pool_entry )
+	{
+		return( 1 );
+	}
+	if( safe_first_segment->file_offset < safe_second_segment->file_offset )
+	{
+		return( -1 );
+	}
+	if( safe_first_segment->file_offset > safe_second_segment->file_offset )
+	{
+		return( 1 );
+	}
+	if( safe_first_segment->request_index < safe_second_segment->request_index )
+	{
+		return( -1 );
+	}
+	if( safe_first_segment->request_index > safe_second_segment->request_index )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Sorts the segments of the read vector by file IO pool entry and file offset
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_read_vector_sort(
+     libphdi_read_vector_t *read_vector,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_read_vector_sort";
+
+	if( read_vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_vector->number_of_segments > 1 )
+	{
+		qsort(
+		 read_vector->segments,
+		 (size_t) read_vector->number_of_segments,
+		 sizeof( libphdi_read_vector_segment_t ),
+		 &libphdi_read_vector_segment_compare );
+	}
+	return( 1 );
+}
+
+/* Reads the segments of the read vector
+ * The segments must be sorted. Segments that are stored in the same file and are near
+ * each other are read with a single read into the merge buffer and copied from there
+ * The read count of a request is set to -1 if one of its segments could not be read
+ * Returns 1 if successful, 0 if one or more segments could not be read or -1 on error
+ */
+int libphdi_read_vector_read_from_file_io_pool(
+     libphdi_read_vector_t *read_vector,
+     libbfio_pool_t *file_io_pool,
+     libphdi_statistics_t *statistics,
+     ssize_t *read_counts,
+     int number_of_requests,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *read_error               = NULL;
+	libphdi_read_vector_segment_t *last_segment = NULL;
+	libphdi_read_vector_segment_t *segment      = NULL;
+	uint8_t *read_buffer                        = NULL;
+	static char *function                       = "libphdi_read_vector_read_from_file_io_pool";
+	size_t read_size                            = 0;
+	ssize_t read_count                          = 0;
+	off64_t last_segment_end_offset             = 0;
+	off64_t run_end_offset                      = 0;
+	int first_segment_index                     = 0;
+	int last_segment_index                      = 0;
+	int result                                  = 1;
+	int segment_index                           = 0;
+
+	if( read_vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_counts == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read counts.",
+		 function );
+
+		return( -1 );
+	}
+	for( segment_index = 0;
+	     segment_index < read_vector->number_of_segments;
+	     segment_index++ )
+	{
+		if( read_vector->segments[ segment_index ].request_index >= number_of_requests )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment: %d - request index value out of bounds.",
+			 function,
+			 segment_index );
+
+			return( -1 );
+		}
+	}
+	first_segment_index = 0;
+
+	while( first_segment_index < read_vector->number_of_segments )
+	{
+		segment        = &( read_vector->segments[ first_segment_index ] );
+		run_end_offset = segment->file_offset + (off64_t) segment->size;
+
+		/* Determine the neighbouring segments that can be read at once
+		 */
+		for( last_segment_index = first_segment_index + 1;
+		     last_segment_index < read_vector->number_of_segments;
+		     last_segment_index++ )
+		{
+			last_segment = &( read_vector->segments[ last_segment_index ] );
+
+			if( last_segment->file_io_pool_entry != segment->file_io_pool_entry )
+			{
+				break;
+			}
+			if( last_segment->file_offset > ( run_end_offset + LIBPHDI_READ_VECTOR_MAXIMUM_GAP_SIZE ) )
+			{
+				break;
+			}
+			last_segment_end_offset = last_segment->file_offset + (off64_t) last_segment->size;
+
+			if( last_segment_end_offset < run_end_offset )
+			{
+				last_segment_end_offset = run_end_offset;
+			}
+			if( (size64_t) ( last_segment_end_offset - segment->file_offset ) > LIBPHDI_READ_VECTOR_MAXIMUM_MERGE_SIZE )
+			{
+				break;
+			}
+			run_end_offset = last_segment_end_offset;
+		}
+		read_size = (size_t) ( run_end_offset - segment->file_offset );
+
+		if( last_segment_index == ( first_segment_index + 1 ) )
+		{
+			read_buffer = segment->buffer;
+		}
+		else
+		{
+			if( read_vector->merge_buffer == NULL )
+			{
+				read_vector->merge_buffer = (uint8_t *) memory_allocate(
+				                                         sizeof( uint8_t ) * LIBPHDI_READ_VECTOR_MAXIMUM_MERGE_SIZE );
+
+				if( read_vector->merge_buffer == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create merge buffer.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			read_buffer = read_vector->merge_buffer;
+		}
+		read_count = libphdi_statistics_read_buffer_at_offset(
+		              statistics,
+		              file_io_pool,
+		              segment->file_io_pool_entry,
+		              read_buffer,
+		              read_size,
+		              segment->file_offset,
+		              &read_error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			/* A failed read only fails the requests the segments belong to
+			 */
+			if( read_error != NULL )
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_print_error_backtrace(
+					 read_error );
+				}
+#endif
+				libcerror_error_free(
+				 &read_error );
+			}
+			for( segment_index = first_segment_index;
+			     segment_index < last_segment_index;
+			     segment_index++ )
+			{
+				read_counts[ read_vector->segments[ segment_index ].request_index ] = -1;
+			}
+			result = 0;
+		}
+		else if( read_buffer == read_vector->merge_buffer )
+		{
+			for( segment_index = first_segment_index;
+			     segment_index < last_segment_index;
+			     segment_index++ )
+			{
+				last_segment = &( read_vector->segments[ segment_index ] );
+
+				if( memory_copy(
+				     last_segment->buffer,
+				     &( read_buffer[ last_segment->file_offset - segment->file_offset ] ),
+				     last_segment->size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy segment: %d data.",
+					 function,
+					 segment_index );
+
+					return( -1 );
+				}
+			}
+		}
+		first_segment_index = last_segment_index;
+	}
+	return( result );
+}
+
@@ -0,0 +1,124 @@
+/*
+ * Read vector functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPHDI_READ_VECTOR_H )
+#define _LIBPHDI_READ_VECTOR_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libphdi_libbfio.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_statistics.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libphdi_read_vector_segment libphdi_read_vector_segment_t;
+
+struct libphdi_read_vector_segment
+{
+	/* The index of the request the segment belongs to
+	 */
+	int request_index;
+
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The offset of the data in the file
+	 */
+	off64_t file_offset;
+
+	/* The buffer the data is read into
+	 */
+	uint8_t *buffer;
+
+	/* The size of the data
+	 */
+	size_t size;
+};
+
+typedef struct libphdi_read_vector libphdi_read_vector_t;
+
+/* The read vector contains the stored data segments of a batch of read requests,
+ * the segments are sorted by file and file offset so that neighbouring segments
+ * are read with a single read
+ */
+struct libphdi_read_vector
+{
+	/* The segments
+	 */
+	libphdi_read_vector_segment_t *segments;
+
+	/* The number of segments
+	 */
+	int number_of_segments;
+
+	/* The number of allocated segments
+	 */
+	int number_of_allocated_segments;
+
+	/* The buffer used to read merged segments
+	 */
+	uint8_t *merge_buffer;
+};
+
+int libphdi_read_vector_initialize(
+     libphdi_read_vector_t **read_vector,
+     libcerror_error_t **error );
+
+int libphdi_read_vector_free(
+     libphdi_read_vector_t **read_vector,
+     libcerror_error_t **error );
+
+int libphdi_read_vector_append_segment(
+     libphdi_read_vector_t *read_vector,
+     int request_index,
+     int file_io_pool_entry,
+     off64_t file_offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int libphdi_read_vector_segment_compare(
+     const void *first_segment,
+     const void *second_segment );
+
+int libphdi_read_vector_sort(
+     libphdi_read_vector_t *read_vector,
+     libcerror_error_t **error );
+
+int libphdi_read_vector_read_from_file_io_pool(
+     libphdi_read_vector_t *read_vector,
+     libbfio_pool_t *file_io_pool,
+     libphdi_statistics_t *statistics,
+     ssize_t *read_counts,
+     int number_of_requests,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPHDI_READ_VECTOR_H ) */
+
@@ -0,0 +1,617 @@
+/*
+ * Readahead functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libphdi_definitions.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_libcthreads.h"
+#include "libphdi_readahead.h"
+
+/* Creates a readahead
+ * Make sure the value readahead is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_readahead_initialize(
+     libphdi_readahead_t **readahead,
+     size64_t maximum_window_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_readahead_initialize";
+
+	if( readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid readahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *readahead != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid readahead value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_window_size == 0 )
+	 || ( maximum_window_size > (size64_t) INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum window size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*readahead = memory_allocate_structure(
+	              libphdi_readahead_t );
+
+	if( *readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create readahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *readahead,
+	     0,
+	     sizeof( libphdi_readahead_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear readahead.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *readahead )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *readahead )->minimum_window_size = LIBPHDI_READAHEAD_MINIMUM_WINDOW_SIZE;
+	( *readahead )->maximum_window_size = maximum_window_size;
+
+	if( ( *readahead )->minimum_window_size > maximum_window_size )
+	{
+		( *readahead )->minimum_window_size = maximum_window_size;
+	}
+	return( 1 );
+
+on_error:
+	if( *readahead != NULL )
+	{
+		memory_free(
+		 *readahead );
+
+		*readahead = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a readahead
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_readahead_free(
+     libphdi_readahead_t **readahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_readahead_free";
+	int result            = 1;
+
+	if( readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid readahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *readahead != NULL )
+	{
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *readahead )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *readahead );
+
+		*readahead = NULL;
+	}
+	return( result );
+}
+
+/* Clears the streams of a readahead
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_readahead_clear(
+     libphdi_readahead_t *readahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_readahead_clear";
+	int result            = 1;
+
+	if( readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid readahead.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     readahead->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( memory_set(
+	     readahead->streams,
+	     0,
+	     sizeof( libphdi_readahead_stream_t ) * LIBPHDI_READAHEAD_NUMBER_OF_STREAMS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear streams.",
+		 function );
+
+		result = -1;
+	}
+	readahead->access_count = 0;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     readahead->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Updates the readahead with a read and determines the data to prefetch
+ * A read that continues a stream is considered sequential, otherwise the least
+ * recently used stream is replaced. Once a stream is sequential the data ahead
+ * of it is prefetched when less than half of the window remains prefetched,
+ * the window size is doubled for every prefetch up to the maximum window size
+ * Returns 1 if data should be prefetched, 0 if not or -1 on error
+ */
+int libphdi_readahead_update(
+     libphdi_readahead_t *readahead,
+     off64_t offset,
+     size64_t read_size,
+     off64_t *prefetch_offset,
+     size64_t *prefetch_size,
+     libcerror_error_t **error )
+{
+	libphdi_readahead_stream_t *stream = NULL;
+	static char *function              = "libphdi_readahead_update";
+	size64_t prefetched_size           = 0;
+	int stream_index                   = 0;
+	int result                         = 0;
+
+	if( readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid readahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_size == 0 )
+	 || ( read_size > (size64_t) ( INT64_MAX - offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( prefetch_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid prefetch offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( prefetch_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid prefetch size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     readahead->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	readahead->access_count += 1;
+
+	for( stream_index = 0;
+	     stream_index < LIBPHDI_READAHEAD_NUMBER_OF_STREAMS;
+	     stream_index++ )
+	{
+		if( ( readahead->streams[ stream_index ].number_of_sequential_reads > 0 )
+		 && ( readahead->streams[ stream_index ].next_offset == offset ) )
+		{
+			stream = &( readahead->streams[ stream_index ] );
+
+			break;
+		}
+	}
+	if( stream == NULL )
+	{
+		stream = &( readahead->streams[ 0 ] );
+
+		for( stream_index = 1;
+		     stream_index < LIBPHDI_READAHEAD_NUMBER_OF_STREAMS;
+		     stream_index++ )
+		{
+			if( readahead->streams[ stream_index ].last_access_count < stream->last_access_count )
+			{
+				stream = &( readahead->streams[ stream_index ] );
+			}
+		}
+		stream->next_offset                = offset + (off64_t) read_size;
+		stream->prefetch_end_offset        = stream->next_offset;
+		stream->window_size                = readahead->minimum_window_size;
+		stream->number_of_sequential_reads = 1;
+		stream->last_access_count          = readahead->access_count;
+	}
+	else
+	{
+		if( stream->number_of_sequential_reads < LIBPHDI_READAHEAD_SEQUENTIAL_READS_THRESHOLD )
+		{
+			stream->number_of_sequential_reads += 1;
+		}
+		stream->next_offset      += (off64_t) read_size;
+		stream->last_access_count = readahead->access_count;
+
+		if( stream->number_of_sequential_reads >= LIBPHDI_READAHEAD_SEQUENTIAL_READS_THRESHOLD )
+		{
+			/* The reader can pass the prefetched data when the prefetch falls behind
+			 */
+			if( stream->prefetch_end_offset < stream->next_offset )
+			{
+				stream->prefetch_end_offset = stream->next_offset;
+			}
+			prefetched_size = (size64_t) ( stream->prefetch_end_offset - stream->next_offset );
+
+			if( ( prefetched_size <= ( stream->window_size / 2 ) )
+			 && ( readahead->number_of_pending_requests < LIBPHDI_READAHEAD_MAXIMUM_NUMBER_OF_PENDING_REQUESTS )
+			 && ( stream->window_size > prefetched_size )
+			 && ( stream->prefetch_end_offset <= (off64_t) ( INT64_MAX - stream->window_size ) ) )
+			{
+				*prefetch_offset = stream->prefetch_end_offset;
+				*prefetch_size   = stream->window_size - prefetched_size;
+
+				stream->prefetch_end_offset += (off64_t) *prefetch_size;
+
+				if( stream->window_size <= ( readahead->maximum_window_size / 2 ) )
+				{
+					stream->window_size *= 2;
+				}
+				else
+				{
+					stream->window_size = readahead->maximum_window_size;
+				}
+				readahead->number_of_pending_requests += 1;
+
+				result = 1;
+			}
+		}
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     readahead->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Marks a pending request as completed
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_readahead_complete_request(
+     libphdi_readahead_t *readahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_readahead_complete_request";
+	int result            = 1;
+
+	if( readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid readahead.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     readahead->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( readahead->number_of_pending_requests <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid readahead - no pending requests.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		readahead->number_of_pending_requests -= 1;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     readahead->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Creates a readahead request
+ * Make sure the value request is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_readahead_request_initialize(
+     libphdi_readahead_request_t **request,
+     libphdi_readahead_t *readahead,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_readahead_request_initialize";
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		return( -1 );
+	}
+	if( *request != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid request value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( readahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid readahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*request = memory_allocate_structure(
+	            libphdi_readahead_request_t );
+
+	if( *request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create request.",
+		 function );
+
+		return( -1 );
+	}
+	( *request )->readahead = readahead;
+	( *request )->offset    = offset;
+	( *request )->size      = size;
+
+	return( 1 );
+}
+
+/* Frees a readahead request
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_readahead_request_free(
+     libphdi_readahead_request_t **request,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_readahead_request_free";
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		return( -1 );
+	}
+	if( *request != NULL )
+	{
+		memory_free(
+		 *request );
+
+		*request = NULL;
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,154 @@
+/*
+ * Readahead functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPHDI_READAHEAD_H )
+#define _LIBPHDI_READAHEAD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libphdi_definitions.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libphdi_readahead_stream libphdi_readahead_stream_t;
+
+struct libphdi_readahead_stream
+{
+	/* The offset that is expected to be read next
+	 */
+	off64_t next_offset;
+
+	/* The end offset of the data that was prefetched
+	 */
+	off64_t prefetch_end_offset;
+
+	/* The window size
+	 */
+	size64_t window_size;
+
+	/* The number of sequential reads
+	 */
+	uint32_t number_of_sequential_reads;
+
+	/* The access count of the last read, used to replace the least recently used stream
+	 */
+	uint64_t last_access_count;
+};
+
+typedef struct libphdi_readahead libphdi_readahead_t;
+
+/* The readahead detects sequential streams of reads and determines which data
+ * should be prefetched, multiple streams are tracked so that interleaved readers,
+ * such as multiple open files of a mount, are detected independently
+ */
+struct libphdi_readahead
+{
+	/* The streams
+	 */
+	libphdi_readahead_stream_t streams[ LIBPHDI_READAHEAD_NUMBER_OF_STREAMS ];
+
+	/* The minimum (initial) window size
+	 */
+	size64_t minimum_window_size;
+
+	/* The maximum window size
+	 */
+	size64_t maximum_window_size;
+
+	/* The access count
+	 */
+	uint64_t access_count;
+
+	/* The number of pending requests
+	 */
+	int number_of_pending_requests;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+typedef struct libphdi_readahead_request libphdi_readahead_request_t;
+
+struct libphdi_readahead_request
+{
+	/* The readahead the request belongs to
+	 */
+	libphdi_readahead_t *readahead;
+
+	/* The offset of the data to prefetch
+	 */
+	off64_t offset;
+
+	/* The size of the data to prefetch
+	 */
+	size64_t size;
+};
+
+int libphdi_readahead_initialize(
+     libphdi_readahead_t **readahead,
+     size64_t maximum_window_size,
+     libcerror_error_t **error );
+
+int libphdi_readahead_free(
+     libphdi_readahead_t **readahead,
+     libcerror_error_t **error );
+
+int libphdi_readahead_clear(
+     libphdi_readahead_t *readahead,
+     libcerror_error_t **error );
+
+int libphdi_readahead_update(
+     libphdi_readahead_t *readahead,
+     off64_t offset,
+     size64_t read_size,
+     off64_t *prefetch_offset,
+     size64_t *prefetch_size,
+     libcerror_error_t **error );
+
+int libphdi_readahead_complete_request(
+     libphdi_readahead_t *readahead,
+     libcerror_error_t **error );
+
+int libphdi_readahead_request_initialize(
+     libphdi_readahead_request_t **request,
+     libphdi_readahead_t *readahead,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libphdi_readahead_request_free(
+     libphdi_readahead_request_t **request,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPHDI_READAHEAD_H ) */
+
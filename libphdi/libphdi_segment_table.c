@@ -0,0 +1,559 @@
+/*
+ * Segment table functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libphdi_libbfio.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_segment_table.h"
+#include "libphdi_statistics.h"
+
+/* Creates a segment table
+ * Make sure the value segment_table is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_segment_table_initialize(
+     libphdi_segment_table_t **segment_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_segment_table_initialize";
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*segment_table = memory_allocate_structure(
+	                  libphdi_segment_table_t );
+
+	if( *segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segment_table,
+	     0,
+	     sizeof( libphdi_segment_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment table.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *segment_table != NULL )
+	{
+		memory_free(
+		 *segment_table );
+
+		*segment_table = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a segment table
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_segment_table_free(
+     libphdi_segment_table_t **segment_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_segment_table_free";
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_table != NULL )
+	{
+		if( ( *segment_table )->segments != NULL )
+		{
+			memory_free(
+			 ( *segment_table )->segments );
+		}
+		memory_free(
+		 *segment_table );
+
+		*segment_table = NULL;
+	}
+	return( 1 );
+}
+
+/* Appends a segment to the segment table
+ * The segment is mapped directly after the previous segment in the media data
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_segment_table_append_segment(
+     libphdi_segment_table_t *segment_table,
+     int file_io_pool_entry,
+     off64_t file_offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libphdi_segment_table_segment_t *segment  = NULL;
+	libphdi_segment_table_segment_t *segments = NULL;
+	static char *function                     = "libphdi_segment_table_append_segment";
+	size_t segments_size                      = 0;
+	int number_of_allocated_segments          = 0;
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file IO pool entry value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size64_t) INT64_MAX )
+	 || ( segment_table->media_size > ( (size64_t) INT64_MAX - size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table->number_of_segments >= segment_table->number_of_allocated_segments )
+	{
+		if( segment_table->number_of_allocated_segments == 0 )
+		{
+			number_of_allocated_segments = 16;
+		}
+		else if( segment_table->number_of_allocated_segments > ( INT_MAX / 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of allocated segments value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		else
+		{
+			number_of_allocated_segments = segment_table->number_of_allocated_segments * 2;
+		}
+		segments_size = sizeof( libphdi_segment_table_segment_t ) * number_of_allocated_segments;
+
+		if( segments_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid segments size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		segments = (libphdi_segment_table_segment_t *) memory_reallocate(
+		                                                segment_table->segments,
+		                                                segments_size );
+
+		if( segments == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize segments.",
+			 function );
+
+			return( -1 );
+		}
+		segment_table->segments                     = segments;
+		segment_table->number_of_allocated_segments = number_of_allocated_segments;
+	}
+	/* Equal segment sizes allow to determine the segment index directly from the offset
+	 */
+	if( segment_table->number_of_segments == 0 )
+	{
+		segment_table->equal_segment_size = size;
+	}
+	else if( ( segment_table->segments[ segment_table->number_of_segments - 1 ].size != segment_table->equal_segment_size )
+	      || ( size > segment_table->equal_segment_size ) )
+	{
+		segment_table->equal_segment_size = 0;
+	}
+	segment = &( segment_table->segments[ segment_table->number_of_segments ] );
+
+	segment->media_offset       = (off64_t) segment_table->media_size;
+	segment->size               = size;
+	segment->file_io_pool_entry = file_io_pool_entry;
+	segment->file_offset        = file_offset;
+
+	segment_table->number_of_segments += 1;
+	segment_table->media_size         += size;
+
+	return( 1 );
+}
+
+/* Retrieves the index of the segment that contains a specific offset
+ * The segment index is calculated if the segments have equal sizes otherwise
+ * a binary search is used since the segments are sorted by media offset
+ * Returns 1 if successful, 0 if the offset is beyond the segments or -1 on error
+ */
+int libphdi_segment_table_get_segment_index_at_offset(
+     libphdi_segment_table_t *segment_table,
+     off64_t offset,
+     int *segment_index,
+     libcerror_error_t **error )
+{
+	libphdi_segment_table_segment_t *segment = NULL;
+	static char *function                    = "libphdi_segment_table_get_segment_index_at_offset";
+	int first_segment_index                  = 0;
+	int last_segment_index                   = 0;
+	int middle_segment_index                 = 0;
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment index.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= segment_table->media_size )
+	{
+		return( 0 );
+	}
+	if( segment_table->equal_segment_size != 0 )
+	{
+		*segment_index = (int) ( (size64_t) offset / segment_table->equal_segment_size );
+
+		return( 1 );
+	}
+	last_segment_index = segment_table->number_of_segments - 1;
+
+	while( first_segment_index < last_segment_index )
+	{
+		middle_segment_index = first_segment_index + ( ( last_segment_index - first_segment_index + 1 ) / 2 );
+
+		segment = &( segment_table->segments[ middle_segment_index ] );
+
+		if( offset < segment->media_offset )
+		{
+			last_segment_index = middle_segment_index - 1;
+		}
+		else
+		{
+			first_segment_index = middle_segment_index;
+		}
+	}
+	*segment_index = first_segment_index;
+
+	return( 1 );
+}
+
+/* Retrieves the file range at a specific offset
+ * The range does not exceed the maximum range size or the end of the segment
+ * Returns 1 if successful, 0 if the offset is beyond the segments or -1 on error
+ */
+int libphdi_segment_table_get_range_at_offset(
+     libphdi_segment_table_t *segment_table,
+     off64_t offset,
+     size64_t maximum_range_size,
+     int *file_io_pool_entry,
+     off64_t *range_file_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	libphdi_segment_table_segment_t *segment = NULL;
+	static char *function                    = "libphdi_segment_table_get_range_at_offset";
+	size64_t segment_data_offset             = 0;
+	int result                               = 0;
+	int segment_index                        = 0;
+
+	if( file_io_pool_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_file_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range file offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	result = libphdi_segment_table_get_segment_index_at_offset(
+	          segment_table,
+	          offset,
+	          &segment_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment index at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		segment = &( segment_table->segments[ segment_index ] );
+
+		segment_data_offset = (size64_t) ( offset - segment->media_offset );
+
+		*file_io_pool_entry = segment->file_io_pool_entry;
+		*range_file_offset  = segment->file_offset + (off64_t) segment_data_offset;
+		*range_size         = segment->size - segment_data_offset;
+
+		if( *range_size > maximum_range_size )
+		{
+			*range_size = maximum_range_size;
+		}
+	}
+	return( result );
+}
+
+/* Reads data at a specific offset into a buffer
+ * Every segment touched by the read is read with a single positional read
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libphdi_segment_table_read_buffer_at_offset(
+         libphdi_segment_table_t *segment_table,
+         libbfio_pool_t *file_io_pool,
+         libphdi_statistics_t *statistics,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function     = "libphdi_segment_table_read_buffer_at_offset";
+	size64_t range_size       = 0;
+	size_t buffer_offset      = 0;
+	ssize_t read_count        = 0;
+	off64_t range_file_offset = 0;
+	int file_io_pool_entry    = 0;
+	int result                = 0;
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < buffer_size )
+	{
+		result = libphdi_segment_table_get_range_at_offset(
+		          segment_table,
+		          offset,
+		          (size64_t) ( buffer_size - buffer_offset ),
+		          &file_io_pool_entry,
+		          &range_file_offset,
+		          &range_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		read_count = libphdi_statistics_read_buffer_at_offset(
+		              statistics,
+		              file_io_pool,
+		              file_io_pool_entry,
+		              &( buffer[ buffer_offset ] ),
+		              (size_t) range_size,
+		              range_file_offset,
+		              error );
+
+		if( read_count != (ssize_t) range_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment data from file IO pool entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 file_io_pool_entry,
+			 range_file_offset,
+			 range_file_offset );
+
+			return( -1 );
+		}
+		buffer_offset += (size_t) read_count;
+		offset        += (off64_t) read_count;
+	}
+	return( (ssize_t) buffer_offset );
+}
+
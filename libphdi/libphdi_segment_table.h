@@ -0,0 +1,131 @@
+/*
+ * Segment table functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPHDI_SEGMENT_TABLE_H )
+#define _LIBPHDI_SEGMENT_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libphdi_libbfio.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_statistics.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libphdi_segment_table_segment libphdi_segment_table_segment_t;
+
+struct libphdi_segment_table_segment
+{
+	/* The offset of the segment in the media data
+	 */
+	off64_t media_offset;
+
+	/* The size of the segment
+	 */
+	size64_t size;
+
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The offset of the segment data in the file
+	 */
+	off64_t file_offset;
+};
+
+typedef struct libphdi_segment_table libphdi_segment_table_t;
+
+/* The segment table maps the media data of a fixed disk onto the plain extent files,
+ * the segments are stored in media order and are not modified after the image is
+ * opened, so lookups and reads require no locking and maintain no seek state
+ */
+struct libphdi_segment_table
+{
+	/* The segments
+	 */
+	libphdi_segment_table_segment_t *segments;
+
+	/* The number of segments
+	 */
+	int number_of_segments;
+
+	/* The number of allocated segments
+	 */
+	int number_of_allocated_segments;
+
+	/* The size of the media data mapped by the segments
+	 */
+	size64_t media_size;
+
+	/* The segment size if all segments, except for the last one, have the same size
+	 * and the last segment is not larger, or 0 otherwise
+	 */
+	size64_t equal_segment_size;
+};
+
+int libphdi_segment_table_initialize(
+     libphdi_segment_table_t **segment_table,
+     libcerror_error_t **error );
+
+int libphdi_segment_table_free(
+     libphdi_segment_table_t **segment_table,
+     libcerror_error_t **error );
+
+int libphdi_segment_table_append_segment(
+     libphdi_segment_table_t *segment_table,
+     int file_io_pool_entry,
+     off64_t file_offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libphdi_segment_table_get_segment_index_at_offset(
+     libphdi_segment_table_t *segment_table,
+     off64_t offset,
+     int *segment_index,
+     libcerror_error_t **error );
+
+int libphdi_segment_table_get_range_at_offset(
+     libphdi_segment_table_t *segment_table,
+     off64_t offset,
+     size64_t maximum_range_size,
+     int *file_io_pool_entry,
+     off64_t *range_file_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+ssize_t libphdi_segment_table_read_buffer_at_offset(
+         libphdi_segment_table_t *segment_table,
+         libbfio_pool_t *file_io_pool,
+         libphdi_statistics_t *statistics,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPHDI_SEGMENT_TABLE_H ) */
+
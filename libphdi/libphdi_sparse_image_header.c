@@ -416,6 +416,79 @@ int libphdi_sparse_image_header_read_file_io_handle(
 	return( 1 );
 }
 
+/* Reads the sparse image header using the file IO pool entry
+ * The header is read at a specific offset so that concurrent reads of the same
+ * file IO pool entry do not depend on the current offset of the file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_sparse_image_header_read_file_io_pool(
+     libphdi_sparse_image_header_t *sparse_image_header,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	uint8_t sparse_image_header_data[ sizeof( phdi_sparse_image_header_t ) ];
+
+	static char *function = "libphdi_sparse_image_header_read_file_io_pool";
+	ssize_t read_count    = 0;
+
+	if( sparse_image_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sparse image header.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading sparse image header at offset: 0 (0x00000000)\n",
+		 function );
+	}
+#endif
+	read_count = libbfio_pool_read_buffer_at_offset(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              sparse_image_header_data,
+	              sizeof( phdi_sparse_image_header_t ),
+	              0,
+	              error );
+
+	if( read_count != (ssize_t) sizeof( phdi_sparse_image_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sparse image header data at offset: 0 (0x00000000) from file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	if( libphdi_sparse_image_header_read_data(
+	     sparse_image_header,
+	     sparse_image_header_data,
+	     sizeof( phdi_sparse_image_header_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sparse image header.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Retrieves the block size
  * Returns 1 if successful or -1 on error
  */
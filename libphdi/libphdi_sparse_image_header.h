@@ -72,6 +72,12 @@ int libphdi_sparse_image_header_read_file_io_handle(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+int libphdi_sparse_image_header_read_file_io_pool(
+     libphdi_sparse_image_header_t *sparse_image_header,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
 int libphdi_sparse_image_header_get_block_size(
      libphdi_sparse_image_header_t *sparse_image_header,
      size64_t *block_size,
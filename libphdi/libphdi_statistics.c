@@ -0,0 +1,468 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#endif
+
+#include <time.h>
+
+#include "libphdi_definitions.h"
+#include "libphdi_libbfio.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_libcthreads.h"
+#include "libphdi_probes.h"
+#include "libphdi_statistics.h"
+
+/* Creates statistics
+ * Make sure the value statistics is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_statistics_initialize(
+     libphdi_statistics_t **statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_statistics_initialize";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *statistics != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid statistics value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*statistics = memory_allocate_structure(
+	               libphdi_statistics_t );
+
+	if( *statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *statistics,
+	     0,
+	     sizeof( libphdi_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *statistics != NULL )
+	{
+		memory_free(
+		 *statistics );
+
+		*statistics = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_statistics_free(
+     libphdi_statistics_t **statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_statistics_free";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *statistics != NULL )
+	{
+		memory_free(
+		 *statistics );
+
+		*statistics = NULL;
+	}
+	return( 1 );
+}
+
+/* Resets the statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_statistics_reset(
+     libphdi_statistics_t *statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_statistics_reset";
+	int statistic         = 0;
+	int snapshot_depth    = 0;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	for( statistic = 0;
+	     statistic < LIBPHDI_NUMBER_OF_STATISTICS;
+	     statistic++ )
+	{
+		libphdi_statistics_atomic_set(
+		 &( statistics->values[ statistic ] ),
+		 0 );
+	}
+	for( snapshot_depth = 0;
+	     snapshot_depth < LIBPHDI_STATISTICS_NUMBER_OF_SNAPSHOT_DEPTHS;
+	     snapshot_depth++ )
+	{
+		libphdi_statistics_atomic_set(
+		 &( statistics->snapshot_depth_values[ snapshot_depth ] ),
+		 0 );
+	}
+	return( 1 );
+}
+
+/* Adds a value to a specific statistic
+ * This function is called on the read path hence it does not fail, statistics
+ * that are NULL or an unsupported statistic are ignored
+ */
+void libphdi_statistics_add_value(
+      libphdi_statistics_t *statistics,
+      int statistic,
+      uint64_t value )
+{
+	if( ( statistics != NULL )
+	 && ( statistic >= 0 )
+	 && ( statistic < LIBPHDI_NUMBER_OF_STATISTICS ) )
+	{
+		libphdi_statistics_atomic_add(
+		 &( statistics->values[ statistic ] ),
+		 value );
+	}
+}
+
+/* Adds a number of bytes read to a specific snapshot depth
+ * Snapshot depths beyond the number of tracked depths are added to the deepest tracked depth
+ * This function is called on the read path hence it does not fail, statistics
+ * that are NULL are ignored
+ */
+void libphdi_statistics_add_snapshot_depth_value(
+      libphdi_statistics_t *statistics,
+      int snapshot_depth,
+      uint64_t value )
+{
+	if( ( statistics != NULL )
+	 && ( snapshot_depth >= 0 ) )
+	{
+		if( snapshot_depth >= LIBPHDI_STATISTICS_NUMBER_OF_SNAPSHOT_DEPTHS )
+		{
+			snapshot_depth = LIBPHDI_STATISTICS_NUMBER_OF_SNAPSHOT_DEPTHS - 1;
+		}
+		libphdi_statistics_atomic_add(
+		 &( statistics->snapshot_depth_values[ snapshot_depth ] ),
+		 value );
+	}
+}
+
+/* Retrieves the statistic values
+ * The values are stored in the order of the statistic definitions, a number of values
+ * smaller than the number of statistics retrieves only the first values
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_statistics_get_values(
+     libphdi_statistics_t *statistics,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_statistics_get_values";
+	int statistic         = 0;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_values <= 0 )
+	 || ( number_of_values > LIBPHDI_NUMBER_OF_STATISTICS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of values value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( statistic = 0;
+	     statistic < number_of_values;
+	     statistic++ )
+	{
+		values[ statistic ] = libphdi_statistics_atomic_get(
+		                       &( statistics->values[ statistic ] ) );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of bytes read from a specific snapshot depth
+ * Returns 1 if successful, 0 if the snapshot depth is not tracked or -1 on error
+ */
+int libphdi_statistics_get_snapshot_depth_value(
+     libphdi_statistics_t *statistics,
+     int snapshot_depth,
+     uint64_t *value,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_statistics_get_snapshot_depth_value";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( snapshot_depth < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid snapshot depth value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( snapshot_depth >= LIBPHDI_STATISTICS_NUMBER_OF_SNAPSHOT_DEPTHS )
+	{
+		return( 0 );
+	}
+	*value = libphdi_statistics_atomic_get(
+	          &( statistics->snapshot_depth_values[ snapshot_depth ] ) );
+
+	return( 1 );
+}
+
+/* Retrieves a monotonic timestamp in nanoseconds
+ * Returns the timestamp or 0 if not available
+ */
+uint64_t libphdi_statistics_get_timestamp(
+          void )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	struct timespec time_structure;
+#endif
+
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( frequency.QuadPart <= 0 ) )
+	{
+		return( 0 );
+	}
+	if( QueryPerformanceCounter(
+	     &counter ) == 0 )
+	{
+		return( 0 );
+	}
+	return( ( ( (uint64_t) counter.QuadPart / (uint64_t) frequency.QuadPart ) * 1000000000 )
+	      + ( ( ( (uint64_t) counter.QuadPart % (uint64_t) frequency.QuadPart ) * 1000000000 ) / (uint64_t) frequency.QuadPart ) );
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_structure.tv_sec * 1000000000 ) + (uint64_t) time_structure.tv_nsec );
+
+#else
+	return( 0 );
+
+#endif /* defined( HAVE_CLOCK_GETTIME ) */
+}
+
+/* Reads a buffer at a specific offset from a file IO pool entry
+ * The number of physical reads and bytes read are added to the statistics,
+ * the time spent is only added when measuring the IO time is enabled
+ * The read is traced by the file_io__read__start and file_io__read__done probes
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libphdi_statistics_read_buffer_at_offset(
+         libphdi_statistics_t *statistics,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	uint64_t end_timestamp   = 0;
+	uint64_t start_timestamp = 0;
+	ssize_t read_count       = 0;
+
+	LIBPHDI_PROBE3(
+	 file_io__read__start,
+	 file_io_pool_entry,
+	 (int64_t) offset,
+	 (uint64_t) buffer_size );
+
+	if( statistics == NULL )
+	{
+		read_count = libbfio_pool_read_buffer_at_offset(
+		              file_io_pool,
+		              file_io_pool_entry,
+		              buffer,
+		              buffer_size,
+		              offset,
+		              error );
+
+		LIBPHDI_PROBE4(
+		 file_io__read__done,
+		 file_io_pool_entry,
+		 (int64_t) offset,
+		 (uint64_t) buffer_size,
+		 (int64_t) read_count );
+
+		return( read_count );
+	}
+	if( statistics->measure_io_time != 0 )
+	{
+		start_timestamp = libphdi_statistics_get_timestamp();
+	}
+
+	read_count = libbfio_pool_read_buffer_at_offset(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              buffer,
+	              buffer_size,
+	              offset,
+	              error );
+
+	if( statistics->measure_io_time != 0 )
+	{
+		end_timestamp = libphdi_statistics_get_timestamp();
+	}
+
+	LIBPHDI_PROBE4(
+	 file_io__read__done,
+	 file_io_pool_entry,
+	 (int64_t) offset,
+	 (uint64_t) buffer_size,
+	 (int64_t) read_count );
+
+	if( end_timestamp > start_timestamp )
+	{
+		libphdi_statistics_atomic_add(
+		 &( statistics->values[ LIBPHDI_STATISTIC_IO_TIME ] ),
+		 end_timestamp - start_timestamp );
+	}
+	libphdi_statistics_atomic_add(
+	 &( statistics->values[ LIBPHDI_STATISTIC_NUMBER_OF_PHYSICAL_READS ] ),
+	 1 );
+
+	if( read_count > 0 )
+	{
+		libphdi_statistics_atomic_add(
+		 &( statistics->values[ LIBPHDI_STATISTIC_PHYSICAL_BYTES_READ ] ),
+		 (uint64_t) read_count );
+	}
+	return( read_count );
+}
+
@@ -0,0 +1,175 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPHDI_STATISTICS_H )
+#define _LIBPHDI_STATISTICS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libphdi_definitions.h"
+#include "libphdi_libbfio.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_libcthreads.h"
+
+/* The statistic values are updated by concurrent readers without holding a lock
+ * hence atomic operations are required when multi-threading is supported
+ * The 32-bit variants are used for int values, such as cache hints
+ */
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT ) && defined( __GNUC__ )
+#define libphdi_statistics_atomic_add( value, increment ) \
+	__atomic_fetch_add( value, increment, __ATOMIC_RELAXED )
+
+#define libphdi_statistics_atomic_sub( value, decrement ) \
+	__atomic_fetch_sub( value, decrement, __ATOMIC_RELAXED )
+
+#define libphdi_statistics_atomic_get( value ) \
+	__atomic_load_n( value, __ATOMIC_RELAXED )
+
+#define libphdi_statistics_atomic_set( value, new_value ) \
+	__atomic_store_n( value, new_value, __ATOMIC_RELAXED )
+
+#define libphdi_statistics_atomic_get32( value ) \
+	__atomic_load_n( value, __ATOMIC_RELAXED )
+
+#define libphdi_statistics_atomic_set32( value, new_value ) \
+	__atomic_store_n( value, new_value, __ATOMIC_RELAXED )
+
+#elif defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT ) && defined( WINAPI )
+#define libphdi_statistics_atomic_add( value, increment ) \
+	InterlockedExchangeAdd64( (LONG64 volatile *) value, (LONG64) increment )
+
+#define libphdi_statistics_atomic_sub( value, decrement ) \
+	InterlockedExchangeAdd64( (LONG64 volatile *) value, -( (LONG64) decrement ) )
+
+#define libphdi_statistics_atomic_get( value ) \
+	(uint64_t) InterlockedCompareExchange64( (LONG64 volatile *) value, 0, 0 )
+
+#define libphdi_statistics_atomic_set( value, new_value ) \
+	InterlockedExchange64( (LONG64 volatile *) value, (LONG64) new_value )
+
+#define libphdi_statistics_atomic_get32( value ) \
+	(int) InterlockedCompareExchange( (LONG volatile *) value, 0, 0 )
+
+#define libphdi_statistics_atomic_set32( value, new_value ) \
+	InterlockedExchange( (LONG volatile *) value, (LONG) new_value )
+
+#elif defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+/* The atomic operations are also used for values that are updated by readers
+ * that only hold the read lock, such as cache hints and cache statistics, hence
+ * plain loads and stores would be a data race
+ */
+#error Missing atomic operations required for multi-threading support, build with --enable-multi-threading-support=no
+
+#else
+#define libphdi_statistics_atomic_add( value, increment ) \
+	*( value ) += increment
+
+#define libphdi_statistics_atomic_sub( value, decrement ) \
+	*( value ) -= decrement
+
+#define libphdi_statistics_atomic_get( value ) \
+	*( value )
+
+#define libphdi_statistics_atomic_set( value, new_value ) \
+	*( value ) = new_value
+
+#define libphdi_statistics_atomic_get32( value ) \
+	*( value )
+
+#define libphdi_statistics_atomic_set32( value, new_value ) \
+	*( value ) = new_value
+
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libphdi_statistics libphdi_statistics_t;
+
+struct libphdi_statistics
+{
+	/* The statistic values
+	 */
+	uint64_t values[ LIBPHDI_NUMBER_OF_STATISTICS ];
+
+	/* The number of bytes read per snapshot depth, where 0 represents the current snapshot
+	 */
+	uint64_t snapshot_depth_values[ LIBPHDI_STATISTICS_NUMBER_OF_SNAPSHOT_DEPTHS ];
+
+	/* Value to indicate if the time spent in IO should be measured
+	 */
+	uint8_t measure_io_time;
+};
+
+int libphdi_statistics_initialize(
+     libphdi_statistics_t **statistics,
+     libcerror_error_t **error );
+
+int libphdi_statistics_free(
+     libphdi_statistics_t **statistics,
+     libcerror_error_t **error );
+
+int libphdi_statistics_reset(
+     libphdi_statistics_t *statistics,
+     libcerror_error_t **error );
+
+void libphdi_statistics_add_value(
+      libphdi_statistics_t *statistics,
+      int statistic,
+      uint64_t value );
+
+void libphdi_statistics_add_snapshot_depth_value(
+      libphdi_statistics_t *statistics,
+      int snapshot_depth,
+      uint64_t value );
+
+int libphdi_statistics_get_values(
+     libphdi_statistics_t *statistics,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error );
+
+int libphdi_statistics_get_snapshot_depth_value(
+     libphdi_statistics_t *statistics,
+     int snapshot_depth,
+     uint64_t *value,
+     libcerror_error_t **error );
+
+uint64_t libphdi_statistics_get_timestamp(
+          void );
+
+ssize_t libphdi_statistics_read_buffer_at_offset(
+         libphdi_statistics_t *statistics,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPHDI_STATISTICS_H ) */
+
@@ -24,14 +24,18 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libphdi_block_allocation_table.h"
 #include "libphdi_block_descriptor.h"
-#include "libphdi_block_tree.h"
+#include "libphdi_definitions.h"
 #include "libphdi_libbfio.h"
 #include "libphdi_libcerror.h"
 #include "libphdi_libcnotify.h"
-#include "libphdi_libfdata.h"
+#include "libphdi_probes.h"
+#include "libphdi_statistics.h"
 #include "libphdi_storage_image.h"
-#include "libphdi_unused.h"
+#include "libphdi_storage_image_registry.h"
+
+#include "phdi_sparse_image_header.h"
 
 /* Creates a storage image
  * Make sure the value storage_image is referencing, is set to NULL
@@ -150,18 +154,42 @@ int libphdi_storage_image_free(
 				result = -1;
 			}
 		}
-		if( ( *storage_image )->block_tree != NULL )
+		if( ( *storage_image )->registry_entry != NULL )
+		{
+			/* The block allocation table is managed by the registry entry
+			 */
+			( *storage_image )->block_allocation_table = NULL;
+
+			if( libphdi_storage_image_registry_release_entry(
+			     &( ( *storage_image )->registry_entry ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release registry entry.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *storage_image )->block_allocation_table != NULL )
+		{
+			memory_free(
+			 ( *storage_image )->block_allocation_table );
+		}
+		if( ( *storage_image )->paged_block_allocation_table != NULL )
 		{
-			if( libphdi_block_tree_free(
-			     &( ( *storage_image )->block_tree ),
-			     (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_block_descriptor_free,
+			if( libphdi_block_allocation_table_free(
+			     &( ( *storage_image )->paged_block_allocation_table ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free block tree.",
+				 "%s: unable to free paged block allocation table.",
 				 function );
 
 				result = -1;
@@ -184,7 +212,6 @@ int libphdi_storage_image_read_file_header(
      int file_io_pool_entry,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle                   = NULL;
 	libphdi_sparse_image_header_t *sparse_image_header = NULL;
 	static char *function                              = "libphdi_storage_image_read_file_header";
 	int result                                         = 0;
@@ -211,22 +238,6 @@ int libphdi_storage_image_read_file_header(
 
 		return( -1 );
 	}
-	if( libbfio_pool_get_handle(
-	     file_io_pool,
-	     file_io_pool_entry,
-	     &file_io_handle,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to retrieve file IO handle: %d from pool.",
-		 function,
-		 file_io_pool_entry );
-
-		goto on_error;
-	}
 	if( libphdi_sparse_image_header_initialize(
 	     &sparse_image_header,
 	     error ) != 1 )
@@ -240,9 +251,10 @@ int libphdi_storage_image_read_file_header(
 
 		goto on_error;
 	}
-	result = libphdi_sparse_image_header_read_file_io_handle(
+	result = libphdi_sparse_image_header_read_file_io_pool(
 	          sparse_image_header,
-	          file_io_handle,
+	          file_io_pool,
+	          file_io_pool_entry,
 	          error );
 
 	if( result == -1 )
@@ -251,8 +263,9 @@ int libphdi_storage_image_read_file_header(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read from file IO handle.",
-		 function );
+		 "%s: unable to read sparse image header from file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
 
 		goto on_error;
 	}
@@ -286,32 +299,17 @@ on_error:
 	return( -1 );
 }
 
-/* Reads the block allocation table from the storage image using the file IO pool entry
+/* Reads the file header data of the storage image
  * Returns 1 if successful or -1 on error
  */
-int libphdi_storage_image_read_block_allocation_table(
+int libphdi_storage_image_read_file_header_data(
      libphdi_storage_image_t *storage_image,
-     libbfio_pool_t *file_io_pool,
-     int file_io_pool_entry,
+     const uint8_t *data,
+     size_t data_size,
      libcerror_error_t **error )
 {
-	libphdi_block_descriptor_t *existing_block_descriptor = NULL;
-	libphdi_block_descriptor_t *new_block_descriptor      = NULL;
-	libphdi_block_tree_node_t *leaf_block_tree_node       = NULL;
-	uint8_t *block_allocation_table_data                  = NULL;
-	static char *function                                 = "libphdi_storage_image_read_block_allocation_table";
-	size64_t block_size                                   = 0;
-	size_t block_allocation_table_data_size               = 0;
-	size_t data_offset                                    = 0;
-	ssize_t read_count                                    = 0;
-	off64_t file_offset                                   = 0;
-	off64_t logical_offset                                = 0;
-	uint32_t block_allocation_table_entry                 = 0;
-	int leaf_value_index                                  = 0;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	int entry_index                                       = 0;
-#endif
+	libphdi_sparse_image_header_t *sparse_image_header = NULL;
+	static char *function                              = "libphdi_storage_image_read_file_header_data";
 
 	if( storage_image == NULL )
 	{
@@ -324,225 +322,247 @@ int libphdi_storage_image_read_block_allocation_table(
 
 		return( -1 );
 	}
-	if( storage_image->block_tree != NULL )
+	if( storage_image->sparse_image_header != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid storage image - block tree value already set.",
+		 "%s: invalid storage image - sparse image header value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( libphdi_sparse_image_header_get_block_size(
-	     storage_image->sparse_image_header,
-	     &block_size,
+	if( libphdi_sparse_image_header_initialize(
+	     &sparse_image_header,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve block size.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sparse image header.",
+		 function );
+
+		goto on_error;
+	}
+	if( libphdi_sparse_image_header_read_data(
+	     sparse_image_header,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sparse image header.",
+		 function );
+
+		goto on_error;
+	}
+	storage_image->sparse_image_header = sparse_image_header;
+
+	return( 1 );
+
+on_error:
+	if( sparse_image_header != NULL )
+	{
+		libphdi_sparse_image_header_free(
+		 &sparse_image_header,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the block allocation table data
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_storage_image_read_block_allocation_table_data(
+     libphdi_storage_image_t *storage_image,
+     const uint8_t *data,
+     size_t data_size,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	static char *function                 = "libphdi_storage_image_read_block_allocation_table_data";
+	size_t data_offset                    = 0;
+	uint32_t block_allocation_table_entry = 0;
+	uint32_t entry_index                  = 0;
+	uint32_t number_of_entries            = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	size64_t block_size                   = 0;
+	off64_t file_offset                   = 0;
+	off64_t logical_offset                = 0;
+#endif
+
+	if( storage_image == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( storage_image->sparse_image_header->number_of_allocation_table_entries == 0 )
-	 || ( storage_image->sparse_image_header->number_of_allocation_table_entries > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / 4 ) ) )
+	if( storage_image->sparse_image_header == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid storage image - invalid sparse image header value - number of allocation table entries value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid storage image - missing sparse image header.",
 		 function );
 
 		return( -1 );
 	}
-	block_allocation_table_data_size = (size_t) storage_image->sparse_image_header->number_of_allocation_table_entries * 4;
-
-	block_allocation_table_data = (uint8_t *) memory_allocate(
-	                                           sizeof( uint8_t ) * block_allocation_table_data_size );
-
-	if( block_allocation_table_data == NULL )
+	if( ( storage_image->block_allocation_table != NULL )
+	 || ( storage_image->paged_block_allocation_table != NULL ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create block allocation table data.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid storage image - block allocation table value already set.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	read_count = libbfio_pool_read_buffer(
-	              file_io_pool,
-	              file_io_pool_entry,
-	              block_allocation_table_data,
-	              block_allocation_table_data_size,
-	              error );
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
 
-	if( read_count != (ssize_t) block_allocation_table_data_size )
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	 || ( ( data_size / 4 ) > (size_t) UINT32_MAX )
+	 || ( ( data_size % 4 ) != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read block allocation table data from file IO pool entry: %d.",
-		 function,
-		 file_io_pool_entry );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
+		if( libphdi_sparse_image_header_get_block_size(
+		     storage_image->sparse_image_header,
+		     &block_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block size.",
+			 function );
+
+			return( -1 );
+		}
 		libcnotify_printf(
 		 "%s: block allocation table data:\n",
 		 function );
 		libcnotify_print_data(
-		 block_allocation_table_data,
-		 block_allocation_table_data_size,
+		 data,
+		 data_size,
 		 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
 	}
 #endif
-	if( libphdi_block_tree_initialize(
-	     &( storage_image->block_tree ),
-	     (size64_t) storage_image->sparse_image_header->number_of_sectors * 512,
-	     block_size,
-	     error ) != 1 )
+	number_of_entries = (uint32_t) ( data_size / 4 );
+
+	storage_image->block_allocation_table = (uint32_t *) memory_allocate(
+	                                                      sizeof( uint32_t ) * number_of_entries );
+
+	if( storage_image->block_allocation_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create block tree.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block allocation table.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	while( data_offset < block_allocation_table_data_size )
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
 	{
 		byte_stream_copy_to_uint32_little_endian(
-		 &( block_allocation_table_data[ data_offset ] ),
+		 &( data[ data_offset ] ),
 		 block_allocation_table_entry );
 
 		data_offset += 4;
 
-		if( block_allocation_table_entry != 0 )
-		{
-			file_offset = (off64_t) block_allocation_table_entry * 512;
+		storage_image->block_allocation_table[ entry_index ] = block_allocation_table_entry;
 
 #if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: entry index\t: %d\n",
-				 function,
-				 entry_index );
-
-				libcnotify_printf(
-				 "%s: entry offset\t: %" PRIi64 " (0x%08" PRIx64 ")\n",
-				 function,
-				 logical_offset,
-				 logical_offset );
-
-				libcnotify_printf(
-				 "%s: entry value\t: %" PRIu32 "\n",
-				 function,
-				 block_allocation_table_entry );
-
-				libcnotify_printf(
-				 "%s: file offset\t: %" PRIi64 " (0x%08" PRIx64 ")\n",
-				 function,
-				 (off64_t) file_offset,
-				 (off64_t) file_offset );
-
-				libcnotify_printf(
-				 "\n" );
-			}
-#endif /* defined( HAVE_DEBUG_OUTPUT ) */
-
-			if( libphdi_block_descriptor_initialize(
-			     &new_block_descriptor,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create block descriptor.",
-				 function );
-
-				goto on_error;
-			}
-			new_block_descriptor->file_io_pool_entry = file_io_pool_entry;
-			new_block_descriptor->file_offset        = file_offset;
-
-			if( libphdi_block_tree_insert_block_descriptor_by_offset(
-			     storage_image->block_tree,
-			     logical_offset,
-			     new_block_descriptor,
-			     &leaf_value_index,
-			     &leaf_block_tree_node,
-			     &existing_block_descriptor,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to insert block descriptor in block tree.",
-				 function );
-
-				goto on_error;
-			}
-			new_block_descriptor = NULL;
+		if( ( libcnotify_verbose != 0 )
+		 && ( block_allocation_table_entry != 0 ) )
+		{
+			file_offset    = (off64_t) block_allocation_table_entry * 512;
+			logical_offset = (off64_t) entry_index * block_size;
+
+			libcnotify_printf(
+			 "%s: entry index\t: %" PRIu32 "\n",
+			 function,
+			 entry_index );
+
+			libcnotify_printf(
+			 "%s: entry offset\t: %" PRIi64 " (0x%08" PRIx64 ")\n",
+			 function,
+			 logical_offset,
+			 logical_offset );
+
+			libcnotify_printf(
+			 "%s: entry value\t: %" PRIu32 "\n",
+			 function,
+			 block_allocation_table_entry );
+
+			libcnotify_printf(
+			 "%s: file offset\t: %" PRIi64 " (0x%08" PRIx64 ")\n",
+			 function,
+			 file_offset,
+			 file_offset );
+
+			libcnotify_printf(
+			 "\n" );
 		}
-		logical_offset += (off64_t) block_size;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-		entry_index++;
-#endif
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
 	}
-	memory_free(
-	 block_allocation_table_data );
+	storage_image->number_of_block_allocation_table_entries = number_of_entries;
+	storage_image->file_io_pool_entry                       = file_io_pool_entry;
 
 	return( 1 );
-
-on_error:
-	if( new_block_descriptor != NULL )
-	{
-		libphdi_block_descriptor_free(
-		 &new_block_descriptor,
-		 NULL );
-	}
-	if( storage_image->block_tree != NULL )
-	{
-		libphdi_block_tree_free(
-		 &( storage_image->block_tree ),
-		 (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_block_descriptor_free,
-		 NULL );
-	}
-	if( block_allocation_table_data != NULL )
-	{
-		memory_free(
-		 block_allocation_table_data );
-	}
-	return( -1 );
 }
 
-/* Retrieves the block size
+/* Reads the block allocation table from the storage image using the file IO pool entry
  * Returns 1 if successful or -1 on error
  */
-int libphdi_storage_image_get_block_size(
+int libphdi_storage_image_read_block_allocation_table(
      libphdi_storage_image_t *storage_image,
-     size64_t *block_size,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
      libcerror_error_t **error )
 {
-	static char *function = "libphdi_storage_image_get_block_size";
+	uint8_t *block_allocation_table_data    = NULL;
+	static char *function                   = "libphdi_storage_image_read_block_allocation_table";
+	size_t block_allocation_table_data_size = 0;
+	ssize_t read_count                      = 0;
 
 	if( storage_image == NULL )
 	{
@@ -555,247 +575,872 @@ int libphdi_storage_image_get_block_size(
 
 		return( -1 );
 	}
-	if( libphdi_sparse_image_header_get_block_size(
-	     storage_image->sparse_image_header,
-	     block_size,
-	     error ) != 1 )
+	if( storage_image->sparse_image_header == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve block size.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid storage image - missing sparse image header.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
-}
-
-/* Retrieves the block descriptor at a specific offset
- * Returns 1 if successful, 0 if not available or -1 on error
- */
-int libphdi_storage_image_get_block_descriptor_at_offset(
-     libphdi_storage_image_t *storage_image,
-     off64_t offset,
-     libphdi_block_descriptor_t **block_descriptor,
-     off64_t *block_offset,
-     libcerror_error_t **error )
-{
-	static char *function = "libphdi_storage_image_get_block_descriptor_at_offset";
-	int result            = 0;
-
-	if( storage_image == NULL )
+	if( ( storage_image->sparse_image_header->number_of_allocation_table_entries == 0 )
+	 || ( storage_image->sparse_image_header->number_of_allocation_table_entries > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / 4 ) ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid storage image.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid storage image - invalid sparse image header value - number of allocation table entries value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	result = libphdi_block_tree_get_block_descriptor_by_offset(
-	          storage_image->block_tree,
-	          offset,
-	          block_descriptor,
-	          block_offset,
-	          error );
+	if( storage_image->sparse_image_header->number_of_allocation_table_entries > ( LIBPHDI_MAXIMUM_CACHE_ENTRIES_BLOCK_ALLOCATION_TABLE_PAGES * LIBPHDI_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES_PER_PAGE ) )
+	{
+		LIBPHDI_PROBE3(
+		 block_allocation_table__read__start,
+		 file_io_pool_entry,
+		 storage_image->sparse_image_header->number_of_allocation_table_entries,
+		 1 );
+
+		/* The block allocation table directly follows the sparse image header
+		 * and is read in pages on demand
+		 */
+		if( libphdi_block_allocation_table_initialize(
+		     &( storage_image->paged_block_allocation_table ),
+		     file_io_pool_entry,
+		     (off64_t) sizeof( phdi_sparse_image_header_t ),
+		     storage_image->sparse_image_header->number_of_allocation_table_entries,
+		     LIBPHDI_MAXIMUM_CACHE_ENTRIES_BLOCK_ALLOCATION_TABLE_PAGES,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create paged block allocation table.",
+			 function );
 
-	if( result == -1 )
+			goto on_error;
+		}
+		storage_image->number_of_block_allocation_table_entries = storage_image->sparse_image_header->number_of_allocation_table_entries;
+		storage_image->file_io_pool_entry                       = file_io_pool_entry;
+
+		LIBPHDI_PROBE2(
+		 block_allocation_table__read__done,
+		 file_io_pool_entry,
+		 1 );
+
+		return( 1 );
+	}
+	LIBPHDI_PROBE3(
+	 block_allocation_table__read__start,
+	 file_io_pool_entry,
+	 storage_image->sparse_image_header->number_of_allocation_table_entries,
+	 0 );
+
+	block_allocation_table_data_size = (size_t) storage_image->sparse_image_header->number_of_allocation_table_entries * 4;
+
+	block_allocation_table_data = (uint8_t *) memory_allocate(
+	                                           sizeof( uint8_t ) * block_allocation_table_data_size );
+
+	if( block_allocation_table_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve block descriptor for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block allocation table data.",
+		 function );
+
+		goto on_error;
+	}
+	/* The block allocation table directly follows the sparse image header
+	 * and is read at a specific offset so that concurrent reads of the same
+	 * file IO pool entry do not affect it
+	 */
+	read_count = libbfio_pool_read_buffer_at_offset(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              block_allocation_table_data,
+	              block_allocation_table_data_size,
+	              (off64_t) sizeof( phdi_sparse_image_header_t ),
+	              error );
+
+	if( read_count != (ssize_t) block_allocation_table_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block allocation table data from file IO pool entry: %d.",
 		 function,
-		 offset,
-		 offset );
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	if( libphdi_storage_image_read_block_allocation_table_data(
+	     storage_image,
+	     block_allocation_table_data,
+	     block_allocation_table_data_size,
+	     file_io_pool_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block allocation table.",
+		 function );
+
+		goto on_error;
+	}
+	libphdi_statistics_add_value(
+	 storage_image->statistics,
+	 LIBPHDI_STATISTIC_BLOCK_ALLOCATION_TABLE_READS,
+	 1 );
+
+	memory_free(
+	 block_allocation_table_data );
+
+	LIBPHDI_PROBE2(
+	 block_allocation_table__read__done,
+	 file_io_pool_entry,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( block_allocation_table_data != NULL )
+	{
+		memory_free(
+		 block_allocation_table_data );
+	}
+	LIBPHDI_PROBE2(
+	 block_allocation_table__read__done,
+	 file_io_pool_entry,
+	 -1 );
+
+	return( -1 );
+}
+
+/* Shares the block allocation table of the storage image using the registry
+ * An identical block allocation table that was read by another storage image,
+ * for example of a base image used by multiple handles, replaces the one read
+ * Paged block allocation tables are not shared
+ * Returns 1 if successful, 0 if the block allocation table cannot be shared or -1 on error
+ */
+int libphdi_storage_image_share_block_allocation_table(
+     libphdi_storage_image_t *storage_image,
+     libphdi_storage_image_registry_t *registry,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_storage_image_share_block_allocation_table";
+
+	if( storage_image == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image.",
+		 function );
 
 		return( -1 );
 	}
-	return( result );
+	if( storage_image->registry_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid storage image - registry entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_image->block_allocation_table == NULL )
+	{
+		return( 0 );
+	}
+	if( libphdi_storage_image_registry_insert_block_allocation_table(
+	     registry,
+	     &( storage_image->block_allocation_table ),
+	     storage_image->number_of_block_allocation_table_entries,
+	     &( storage_image->registry_entry ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert block allocation table into registry.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
 }
 
-/* Reads a storage image
- * Callback function for the storage images list
- * Returns 1 if successful or -1 on error
+/* Retrieves a specific block allocation table entry
+ * When no file IO pool is provided a block allocation table page that is not loaded is not read
+ * Returns 1 if successful, 0 if the block allocation table page is not loaded or -1 on error
  */
-int libphdi_storage_image_read_element_data(
-     intptr_t *data_handle LIBPHDI_ATTRIBUTE_UNUSED,
+int libphdi_storage_image_get_block_allocation_table_entry(
+     libphdi_storage_image_t *storage_image,
      libbfio_pool_t *file_io_pool,
-     libfdata_list_element_t *element,
-     libfdata_cache_t *storage_image_cache,
-     int file_io_pool_entry,
-     off64_t storage_image_offset LIBPHDI_ATTRIBUTE_UNUSED,
-     size64_t storage_image_size LIBPHDI_ATTRIBUTE_UNUSED,
-     uint32_t element_flags LIBPHDI_ATTRIBUTE_UNUSED,
-     uint8_t read_flags LIBPHDI_ATTRIBUTE_UNUSED,
+     uint64_t block_index,
+     uint32_t *block_allocation_table_entry,
      libcerror_error_t **error )
 {
-	libphdi_storage_image_t *storage_image = NULL;
-	static char *function                  = "libphdi_storage_image_read_element_data";
+	static char *function = "libphdi_storage_image_get_block_allocation_table_entry";
+	int result            = 0;
+
+	if( storage_image == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_index >= (uint64_t) storage_image->number_of_block_allocation_table_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block index value out of bounds.",
+		 function );
 
-	LIBPHDI_UNREFERENCED_PARAMETER( data_handle )
-	LIBPHDI_UNREFERENCED_PARAMETER( storage_image_offset )
-	LIBPHDI_UNREFERENCED_PARAMETER( storage_image_size )
-	LIBPHDI_UNREFERENCED_PARAMETER( element_flags )
-	LIBPHDI_UNREFERENCED_PARAMETER( read_flags )
+		return( -1 );
+	}
+	if( block_allocation_table_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block allocation table entry.",
+		 function );
 
-	if( libphdi_storage_image_initialize(
-	     &storage_image,
+		return( -1 );
+	}
+	if( storage_image->block_allocation_table != NULL )
+	{
+		*block_allocation_table_entry = storage_image->block_allocation_table[ block_index ];
+	}
+	else if( ( storage_image->paged_block_allocation_table != NULL )
+	      && ( file_io_pool == NULL ) )
+	{
+		result = libphdi_block_allocation_table_get_loaded_entry_by_index(
+		          storage_image->paged_block_allocation_table,
+		          (uint32_t) block_index,
+		          block_allocation_table_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block allocation table entry: %" PRIu64 ".",
+			 function,
+			 block_index );
+
+			return( -1 );
+		}
+		return( result );
+	}
+	else if( storage_image->paged_block_allocation_table != NULL )
+	{
+		/* A page that is not loaded is read by libphdi_block_allocation_table_get_entry_by_index
+		 */
+		if( storage_image->paged_block_allocation_table->pages[ block_index / LIBPHDI_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES_PER_PAGE ] == NULL )
+		{
+			libphdi_statistics_add_value(
+			 storage_image->statistics,
+			 LIBPHDI_STATISTIC_BLOCK_ALLOCATION_TABLE_READS,
+			 1 );
+		}
+		if( libphdi_block_allocation_table_get_entry_by_index(
+		     storage_image->paged_block_allocation_table,
+		     file_io_pool,
+		     (uint32_t) block_index,
+		     block_allocation_table_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block allocation table entry: %" PRIu64 ".",
+			 function,
+			 block_index );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid storage image - missing block allocation table.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the block size
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_storage_image_get_block_size(
+     libphdi_storage_image_t *storage_image,
+     size64_t *block_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_storage_image_get_block_size";
+
+	if( storage_image == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image.",
+		 function );
+
+		return( -1 );
+	}
+	if( libphdi_sparse_image_header_get_block_size(
+	     storage_image->sparse_image_header,
+	     block_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create storage image.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block size.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libphdi_storage_image_read_file_header(
-	     storage_image,
-	     file_io_pool,
-	     file_io_pool_entry,
+	return( 1 );
+}
+
+/* Retrieves the block descriptor at a specific offset
+ * The block descriptor is owned by the storage image and is overwritten
+ * by the next call, as are the other storage image functions this function
+ * is not multi-thread safe
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libphdi_storage_image_get_block_descriptor_at_offset(
+     libphdi_storage_image_t *storage_image,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     libphdi_block_descriptor_t **block_descriptor,
+     off64_t *block_offset,
+     libcerror_error_t **error )
+{
+	static char *function                 = "libphdi_storage_image_get_block_descriptor_at_offset";
+	size64_t block_size                   = 0;
+	uint64_t block_index                  = 0;
+	uint32_t block_allocation_table_entry = 0;
+
+	if( storage_image == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( storage_image->block_allocation_table == NULL )
+	 && ( storage_image->paged_block_allocation_table == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid storage image - missing block allocation table.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( libphdi_sparse_image_header_get_block_size(
+	     storage_image->sparse_image_header,
+	     &block_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read storage image file header.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block size.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libphdi_storage_image_read_block_allocation_table(
+	if( block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	block_index   = (uint64_t) offset / block_size;
+	*block_offset = (off64_t) ( (uint64_t) offset % block_size );
+
+	if( block_index >= (uint64_t) storage_image->number_of_block_allocation_table_entries )
+	{
+		return( 0 );
+	}
+	if( libphdi_storage_image_get_block_allocation_table_entry(
 	     storage_image,
 	     file_io_pool,
-	     file_io_pool_entry,
+	     block_index,
+	     &block_allocation_table_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read storage image block allocation table.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block allocation table entry: %" PRIu64 ".",
+		 function,
+		 block_index );
+
+		return( -1 );
+	}
+	if( block_allocation_table_entry == 0 )
+	{
+		return( 0 );
+	}
+	storage_image->block_descriptor.file_io_pool_entry = storage_image->file_io_pool_entry;
+	storage_image->block_descriptor.file_offset        = (off64_t) block_allocation_table_entry * 512;
+
+	*block_descriptor = &( storage_image->block_descriptor );
+
+	return( 1 );
+}
+
+/* Retrieves the range of blocks at a specific offset
+ * The range consists of consecutive blocks that are either all stored contiguously
+ * in the same file or all unallocated (sparse), up to the maximum range size
+ * When no file IO pool is provided only the loaded block allocation table pages are used
+ * and the range ends at the first block allocation table page that is not loaded
+ * Returns 1 if successful, 0 if the block allocation table page of the offset is not loaded or -1 on error
+ */
+int libphdi_storage_image_get_block_range(
+     libphdi_storage_image_t *storage_image,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     size64_t maximum_range_size,
+     int *file_io_pool_entry,
+     off64_t *range_file_offset,
+     size64_t *range_size,
+     uint8_t *range_is_sparse,
+     libcerror_error_t **error )
+{
+	static char *function                      = "libphdi_storage_image_get_block_range";
+	size64_t block_size                        = 0;
+	size64_t data_size                         = 0;
+	size64_t safe_range_size                   = 0;
+	uint64_t block_index                       = 0;
+	uint64_t number_of_blocks                  = 0;
+	off64_t block_offset                       = 0;
+	uint32_t block_allocation_table_entry      = 0;
+	uint32_t next_block_allocation_table_entry = 0;
+	uint32_t sectors_per_block                 = 0;
+	int entry_result                           = 0;
+	int result                                 = 0;
+
+	if( storage_image == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image.",
 		 function );
 
-		goto on_error;
+		return( -1 );
+	}
+	if( storage_image->sparse_image_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid storage image - missing sparse image header.",
+		 function );
+
+		return( -1 );
 	}
-	if( libfdata_list_element_set_element_value(
-	     element,
-	     (intptr_t *) file_io_pool,
-	     (libfdata_cache_t *) storage_image_cache,
-	     (intptr_t *) storage_image,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_storage_image_free,
-	     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+	if( ( storage_image->block_allocation_table == NULL )
+	 && ( storage_image->paged_block_allocation_table == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid storage image - missing block allocation table.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_file_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range file offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_is_sparse == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range is sparse.",
+		 function );
+
+		return( -1 );
+	}
+	if( libphdi_sparse_image_header_get_block_size(
+	     storage_image->sparse_image_header,
+	     &block_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set storage image as element value.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block size.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	return( 1 );
+	if( block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
 
-on_error:
-	if( storage_image != NULL )
+		return( -1 );
+	}
+	data_size = (size64_t) storage_image->sparse_image_header->number_of_sectors * 512;
+
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= data_size ) )
 	{
-		libphdi_storage_image_free(
-		 &storage_image,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
 	}
-	return( -1 );
+	sectors_per_block = storage_image->sparse_image_header->block_size;
+	block_index       = (uint64_t) offset / block_size;
+	block_offset      = (off64_t) ( (uint64_t) offset % block_size );
+
+	/* Blocks beyond the end of the block allocation table are sparse
+	 */
+	number_of_blocks = storage_image->number_of_block_allocation_table_entries;
+
+	if( block_index < number_of_blocks )
+	{
+		result = libphdi_storage_image_get_block_allocation_table_entry(
+		          storage_image,
+		          file_io_pool,
+		          block_index,
+		          &block_allocation_table_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block allocation table entry: %" PRIu64 ".",
+			 function,
+			 block_index );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+	}
+	result = 0;
+
+	if( block_allocation_table_entry != 0 )
+	{
+		*file_io_pool_entry = storage_image->file_io_pool_entry;
+		*range_file_offset  = ( (off64_t) block_allocation_table_entry * 512 ) + block_offset;
+
+		result = 1;
+	}
+	safe_range_size = block_size - block_offset;
+
+	/* Extend the range while the next block is stored in the same manner
+	 */
+	for( block_index += 1;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		if( ( safe_range_size >= maximum_range_size )
+		 || ( ( (size64_t) offset + safe_range_size ) >= data_size ) )
+		{
+			break;
+		}
+		entry_result = libphdi_storage_image_get_block_allocation_table_entry(
+		                storage_image,
+		                file_io_pool,
+		                block_index,
+		                &next_block_allocation_table_entry,
+		                error );
+
+		if( entry_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block allocation table entry: %" PRIu64 ".",
+			 function,
+			 block_index );
+
+			return( -1 );
+		}
+		else if( entry_result == 0 )
+		{
+			break;
+		}
+		if( result == 0 )
+		{
+			if( next_block_allocation_table_entry != 0 )
+			{
+				break;
+			}
+		}
+		else
+		{
+			if( ( sectors_per_block > ( UINT32_MAX - block_allocation_table_entry ) )
+			 || ( next_block_allocation_table_entry != ( block_allocation_table_entry + sectors_per_block ) ) )
+			{
+				break;
+			}
+			block_allocation_table_entry = next_block_allocation_table_entry;
+		}
+		safe_range_size += block_size;
+	}
+	/* A sparse range extends to the end of the data when the block allocation table ends
+	 */
+	if( ( result == 0 )
+	 && ( block_index >= number_of_blocks ) )
+	{
+		safe_range_size = data_size - (size64_t) offset;
+	}
+	if( safe_range_size > maximum_range_size )
+	{
+		safe_range_size = maximum_range_size;
+	}
+	if( safe_range_size > ( data_size - (size64_t) offset ) )
+	{
+		safe_range_size = data_size - (size64_t) offset;
+	}
+	*range_size      = safe_range_size;
+	*range_is_sparse = (uint8_t) ( result == 0 );
+
+	return( 1 );
 }
 
-/* Reads segment data into a buffer
- * Callback function for the segments stream
- * Returns the number of bytes read or -1 on error
+/* Retrieves the range of blocks at a specific offset
+ * The range consists of consecutive blocks that are either all stored contiguously
+ * in the same file or all unallocated (sparse), up to the maximum range size
+ * Returns 1 if the range is allocated, 0 if the range is sparse or -1 on error
  */
-ssize_t libphdi_storage_image_read_segment_data(
-         intptr_t *data_handle LIBPHDI_ATTRIBUTE_UNUSED,
-         libbfio_pool_t *file_io_pool,
-         int segment_index LIBPHDI_ATTRIBUTE_UNUSED,
-         int segment_file_index,
-         uint8_t *segment_data,
-         size_t segment_data_size,
-         uint32_t segment_flags LIBPHDI_ATTRIBUTE_UNUSED,
-         uint8_t read_flags LIBPHDI_ATTRIBUTE_UNUSED,
-         libcerror_error_t **error )
+int libphdi_storage_image_get_block_range_at_offset(
+     libphdi_storage_image_t *storage_image,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     size64_t maximum_range_size,
+     int *file_io_pool_entry,
+     off64_t *range_file_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
 {
-	static char *function = "libphdi_storage_image_read_segment_data";
-	ssize_t read_count    = 0;
-
-	LIBPHDI_UNREFERENCED_PARAMETER( data_handle )
-	LIBPHDI_UNREFERENCED_PARAMETER( segment_index )
-	LIBPHDI_UNREFERENCED_PARAMETER( segment_flags )
-	LIBPHDI_UNREFERENCED_PARAMETER( read_flags )
-
-	read_count = libbfio_pool_read_buffer(
-	              file_io_pool,
-	              segment_file_index,
-	              segment_data,
-	              segment_data_size,
-	              error );
+	static char *function   = "libphdi_storage_image_get_block_range_at_offset";
+	uint8_t range_is_sparse = 0;
 
-	if( read_count == -1 )
+	if( libphdi_storage_image_get_block_range(
+	     storage_image,
+	     file_io_pool,
+	     offset,
+	     maximum_range_size,
+	     file_io_pool_entry,
+	     range_file_offset,
+	     range_size,
+	     &range_is_sparse,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read segment data.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
 
 		return( -1 );
 	}
-	return( read_count );
+	if( range_is_sparse != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
 }
 
-/* Seeks a certain segment offset
- * Callback function for the segments stream
- * Returns the offset or -1 on error
+/* Reads the file header and block allocation table of the storage image using the file IO pool entry
+ * Returns 1 if successful or -1 on error
  */
-off64_t libphdi_storage_image_seek_segment_offset(
-         intptr_t *data_handle LIBPHDI_ATTRIBUTE_UNUSED,
-         libbfio_pool_t *file_io_pool,
-         int segment_index LIBPHDI_ATTRIBUTE_UNUSED,
-         int segment_file_index,
-         off64_t segment_offset,
-         libcerror_error_t **error )
+int libphdi_storage_image_read_file_io_pool(
+     libphdi_storage_image_t *storage_image,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
 {
-	static char *function = "libphdi_storage_image_seek_segment_offset";
+	static char *function = "libphdi_storage_image_read_file_io_pool";
 
-	LIBPHDI_UNREFERENCED_PARAMETER( data_handle )
-	LIBPHDI_UNREFERENCED_PARAMETER( segment_index )
+	if( storage_image == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image.",
+		 function );
 
-	segment_offset = libbfio_pool_seek_offset(
-	                  file_io_pool,
-	                  segment_file_index,
-	                  segment_offset,
-	                  SEEK_SET,
-	                  error );
+		return( -1 );
+	}
+	if( libphdi_storage_image_read_file_header(
+	     storage_image,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read storage image file header.",
+		 function );
 
-	if( segment_offset == -1 )
+		return( -1 );
+	}
+	if( libphdi_storage_image_read_block_allocation_table(
+	     storage_image,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to seek segment offset.",
+		 "%s: unable to read storage image block allocation table.",
 		 function );
 
 		return( -1 );
 	}
-	return( segment_offset );
+	return( 1 );
 }
 
@@ -25,11 +25,13 @@
 #include <common.h>
 #include <types.h>
 
+#include "libphdi_block_allocation_table.h"
 #include "libphdi_block_descriptor.h"
-#include "libphdi_block_tree.h"
+#include "libphdi_libbfio.h"
 #include "libphdi_libcerror.h"
-#include "libphdi_libfdata.h"
 #include "libphdi_sparse_image_header.h"
+#include "libphdi_statistics.h"
+#include "libphdi_storage_image_registry.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -43,9 +45,36 @@ struct libphdi_storage_image
 	 */
 	libphdi_sparse_image_header_t *sparse_image_header;
 
-	/* The block tree
+	/* The block allocation table, contains the sector number of every block
+	 * or 0 if the block is sparse
 	 */
-	libphdi_block_tree_t *block_tree;
+	uint32_t *block_allocation_table;
+
+	/* The paged block allocation table, used instead of the block allocation table
+	 * when the number of entries is too large to be read at once
+	 */
+	libphdi_block_allocation_table_t *paged_block_allocation_table;
+
+	/* The number of block allocation table entries
+	 */
+	uint32_t number_of_block_allocation_table_entries;
+
+	/* The file IO pool entry that contains the blocks
+	 */
+	int file_io_pool_entry;
+
+	/* The block descriptor returned by libphdi_storage_image_get_block_descriptor_at_offset
+	 */
+	libphdi_block_descriptor_t block_descriptor;
+
+	/* The read statistics, which are managed by the handle
+	 */
+	libphdi_statistics_t *statistics;
+
+	/* The storage image registry entry that contains the block allocation table
+	 * or NULL if the block allocation table is not shared
+	 */
+	libphdi_storage_image_registry_entry_t *registry_entry;
 };
 
 int libphdi_storage_image_initialize(
@@ -62,12 +91,37 @@ int libphdi_storage_image_read_file_header(
      int file_io_pool_entry,
      libcerror_error_t **error );
 
+int libphdi_storage_image_read_file_header_data(
+     libphdi_storage_image_t *storage_image,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libphdi_storage_image_read_block_allocation_table_data(
+     libphdi_storage_image_t *storage_image,
+     const uint8_t *data,
+     size_t data_size,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
 int libphdi_storage_image_read_block_allocation_table(
      libphdi_storage_image_t *storage_image,
      libbfio_pool_t *file_io_pool,
      int file_io_pool_entry,
      libcerror_error_t **error );
 
+int libphdi_storage_image_share_block_allocation_table(
+     libphdi_storage_image_t *storage_image,
+     libphdi_storage_image_registry_t *registry,
+     libcerror_error_t **error );
+
+int libphdi_storage_image_get_block_allocation_table_entry(
+     libphdi_storage_image_t *storage_image,
+     libbfio_pool_t *file_io_pool,
+     uint64_t block_index,
+     uint32_t *block_allocation_table_entry,
+     libcerror_error_t **error );
+
 int libphdi_storage_image_get_block_size(
      libphdi_storage_image_t *storage_image,
      size64_t *block_size,
@@ -75,41 +129,38 @@ int libphdi_storage_image_get_block_size(
 
 int libphdi_storage_image_get_block_descriptor_at_offset(
      libphdi_storage_image_t *storage_image,
+     libbfio_pool_t *file_io_pool,
      off64_t offset,
      libphdi_block_descriptor_t **block_descriptor,
      off64_t *block_offset,
      libcerror_error_t **error );
 
-int libphdi_storage_image_read_element_data(
-     intptr_t *data_handle,
+int libphdi_storage_image_get_block_range(
+     libphdi_storage_image_t *storage_image,
      libbfio_pool_t *file_io_pool,
-     libfdata_list_element_t *element,
-     libfdata_cache_t *storage_image_cache,
-     int file_io_pool_entry,
-     off64_t element_offset,
-     size64_t storage_image_size,
-     uint32_t element_flags,
-     uint8_t read_flags,
+     off64_t offset,
+     size64_t maximum_range_size,
+     int *file_io_pool_entry,
+     off64_t *range_file_offset,
+     size64_t *range_size,
+     uint8_t *range_is_sparse,
      libcerror_error_t **error );
 
-ssize_t libphdi_storage_image_read_segment_data(
-         intptr_t *data_handle,
-         libbfio_pool_t *file_io_pool,
-         int segment_index,
-         int segment_file_index,
-         uint8_t *segment_data,
-         size_t segment_data_size,
-         uint32_t segment_flags,
-         uint8_t read_flags,
-         libcerror_error_t **error );
-
-off64_t libphdi_storage_image_seek_segment_offset(
-         intptr_t *data_handle,
-         libbfio_pool_t *file_io_pool,
-         int segment_index,
-         int segment_file_index,
-         off64_t segment_offset,
-         libcerror_error_t **error );
+int libphdi_storage_image_get_block_range_at_offset(
+     libphdi_storage_image_t *storage_image,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     size64_t maximum_range_size,
+     int *file_io_pool_entry,
+     off64_t *range_file_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+int libphdi_storage_image_read_file_io_pool(
+     libphdi_storage_image_t *storage_image,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
 
 #if defined( __cplusplus )
 }
@@ -0,0 +1,957 @@
+/*
+ * Storage image cache functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libphdi_definitions.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_statistics.h"
+#include "libphdi_storage_image.h"
+#include "libphdi_storage_image_cache.h"
+
+/* Creates a storage image cache
+ * Make sure the value storage_image_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_storage_image_cache_initialize(
+     libphdi_storage_image_cache_t **storage_image_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_storage_image_cache_initialize";
+
+	if( storage_image_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *storage_image_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid storage image cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*storage_image_cache = memory_allocate_structure(
+	                        libphdi_storage_image_cache_t );
+
+	if( *storage_image_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create storage image cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *storage_image_cache,
+	     0,
+	     sizeof( libphdi_storage_image_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear storage image cache.",
+		 function );
+
+		goto on_error;
+	}
+	( *storage_image_cache )->last_used_extent_index    = -1;
+	( *storage_image_cache )->maximum_number_of_entries = maximum_number_of_entries;
+
+	return( 1 );
+
+on_error:
+	if( *storage_image_cache != NULL )
+	{
+		memory_free(
+		 *storage_image_cache );
+
+		*storage_image_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a storage image cache
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_storage_image_cache_free(
+     libphdi_storage_image_cache_t **storage_image_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_storage_image_cache_free";
+	int extent_index      = 0;
+	int result            = 1;
+
+	if( storage_image_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *storage_image_cache != NULL )
+	{
+		if( ( *storage_image_cache )->entries != NULL )
+		{
+			for( extent_index = 0;
+			     extent_index < ( *storage_image_cache )->entries_size;
+			     extent_index++ )
+			{
+				if( ( *storage_image_cache )->entries[ extent_index ] == NULL )
+				{
+					continue;
+				}
+				if( libphdi_storage_image_free(
+				     &( ( *storage_image_cache )->entries[ extent_index ]->storage_image ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free storage image: %d.",
+					 function,
+					 extent_index );
+
+					result = -1;
+				}
+				memory_free(
+				 ( *storage_image_cache )->entries[ extent_index ] );
+			}
+			memory_free(
+			 ( *storage_image_cache )->entries );
+		}
+		memory_free(
+		 *storage_image_cache );
+
+		*storage_image_cache = NULL;
+	}
+	return( result );
+}
+
+/* Removes an entry from its segment
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_storage_image_cache_remove_entry(
+     libphdi_storage_image_cache_t *storage_image_cache,
+     libphdi_storage_image_cache_entry_t *entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_storage_image_cache_remove_entry";
+
+	if( storage_image_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->segment == LIBPHDI_STORAGE_IMAGE_CACHE_SEGMENT_PROBATIONARY )
+	{
+		if( entry == storage_image_cache->first_probationary_entry )
+		{
+			storage_image_cache->first_probationary_entry = entry->next_entry;
+		}
+		if( entry == storage_image_cache->last_probationary_entry )
+		{
+			storage_image_cache->last_probationary_entry = entry->previous_entry;
+		}
+		storage_image_cache->number_of_probationary_entries -= 1;
+	}
+	else if( entry->segment == LIBPHDI_STORAGE_IMAGE_CACHE_SEGMENT_PROTECTED )
+	{
+		if( entry == storage_image_cache->first_protected_entry )
+		{
+			storage_image_cache->first_protected_entry = entry->next_entry;
+		}
+		if( entry == storage_image_cache->last_protected_entry )
+		{
+			storage_image_cache->last_protected_entry = entry->previous_entry;
+		}
+		storage_image_cache->number_of_protected_entries -= 1;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported entry segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->previous_entry != NULL )
+	{
+		entry->previous_entry->next_entry = entry->next_entry;
+	}
+	if( entry->next_entry != NULL )
+	{
+		entry->next_entry->previous_entry = entry->previous_entry;
+	}
+	entry->previous_entry = NULL;
+	entry->next_entry     = NULL;
+	entry->segment        = 0;
+
+	return( 1 );
+}
+
+/* Inserts an entry as the most recently used entry of a segment
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_storage_image_cache_insert_entry(
+     libphdi_storage_image_cache_t *storage_image_cache,
+     libphdi_storage_image_cache_entry_t *entry,
+     uint8_t segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_storage_image_cache_insert_entry";
+
+	if( storage_image_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	entry->previous_entry = NULL;
+	entry->segment        = segment;
+
+	if( segment == LIBPHDI_STORAGE_IMAGE_CACHE_SEGMENT_PROBATIONARY )
+	{
+		entry->next_entry = storage_image_cache->first_probationary_entry;
+
+		if( storage_image_cache->first_probationary_entry != NULL )
+		{
+			storage_image_cache->first_probationary_entry->previous_entry = entry;
+		}
+		else
+		{
+			storage_image_cache->last_probationary_entry = entry;
+		}
+		storage_image_cache->first_probationary_entry        = entry;
+		storage_image_cache->number_of_probationary_entries += 1;
+	}
+	else if( segment == LIBPHDI_STORAGE_IMAGE_CACHE_SEGMENT_PROTECTED )
+	{
+		entry->next_entry = storage_image_cache->first_protected_entry;
+
+		if( storage_image_cache->first_protected_entry != NULL )
+		{
+			storage_image_cache->first_protected_entry->previous_entry = entry;
+		}
+		else
+		{
+			storage_image_cache->last_protected_entry = entry;
+		}
+		storage_image_cache->first_protected_entry        = entry;
+		storage_image_cache->number_of_protected_entries += 1;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported segment.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Promotes an entry to the most recently used entry of the protected segment
+ * The least recently used entry of the protected segment is moved back to
+ * the probationary segment when the protected segment is full
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_storage_image_cache_promote_entry(
+     libphdi_storage_image_cache_t *storage_image_cache,
+     libphdi_storage_image_cache_entry_t *entry,
+     libcerror_error_t **error )
+{
+	libphdi_storage_image_cache_entry_t *protected_entry = NULL;
+	static char *function                                = "libphdi_storage_image_cache_promote_entry";
+	int maximum_number_of_protected_entries              = 0;
+
+	if( storage_image_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libphdi_storage_image_cache_remove_entry(
+	     storage_image_cache,
+	     entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to remove entry: %d.",
+		 function,
+		 entry->extent_index );
+
+		return( -1 );
+	}
+	maximum_number_of_protected_entries = storage_image_cache->maximum_number_of_entries
+	                                    - ( storage_image_cache->maximum_number_of_entries / 4 );
+
+	if( storage_image_cache->number_of_protected_entries >= maximum_number_of_protected_entries )
+	{
+		/* Move the least recently used protected entry back to the probationary segment
+		 */
+		protected_entry = storage_image_cache->last_protected_entry;
+
+		if( protected_entry != NULL )
+		{
+			if( libphdi_storage_image_cache_remove_entry(
+			     storage_image_cache,
+			     protected_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to remove entry: %d.",
+				 function,
+				 protected_entry->extent_index );
+
+				return( -1 );
+			}
+			if( libphdi_storage_image_cache_insert_entry(
+			     storage_image_cache,
+			     protected_entry,
+			     LIBPHDI_STORAGE_IMAGE_CACHE_SEGMENT_PROBATIONARY,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert entry: %d.",
+				 function,
+				 protected_entry->extent_index );
+
+				return( -1 );
+			}
+		}
+	}
+	if( libphdi_storage_image_cache_insert_entry(
+	     storage_image_cache,
+	     entry,
+	     LIBPHDI_STORAGE_IMAGE_CACHE_SEGMENT_PROTECTED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert entry: %d.",
+		 function,
+		 entry->extent_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Evicts the least recently used entry, entries of the probationary segment are evicted first
+ * An entry that was marked as referenced by a concurrent reader is given a second chance,
+ * it is promoted instead and its mark is cleared
+ * Returns 1 if successful, 0 if the cache is empty or -1 on error
+ */
+int libphdi_storage_image_cache_evict_entry(
+     libphdi_storage_image_cache_t *storage_image_cache,
+     libcerror_error_t **error )
+{
+	libphdi_storage_image_cache_entry_t *entry = NULL;
+	static char *function                      = "libphdi_storage_image_cache_evict_entry";
+	int result                                 = 1;
+
+	if( storage_image_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image cache.",
+		 function );
+
+		return( -1 );
+	}
+	entry = storage_image_cache->last_probationary_entry;
+
+	if( entry == NULL )
+	{
+		entry = storage_image_cache->last_protected_entry;
+	}
+	/* Every iteration clears a referenced mark, hence the loop ends
+	 */
+	while( ( entry != NULL )
+	    && ( libphdi_statistics_atomic_get32(
+	          &( entry->is_referenced ) ) != 0 ) )
+	{
+		libphdi_statistics_atomic_set32(
+		 &( entry->is_referenced ),
+		 0 );
+
+		if( libphdi_storage_image_cache_promote_entry(
+		     storage_image_cache,
+		     entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to promote entry: %d.",
+			 function,
+			 entry->extent_index );
+
+			return( -1 );
+		}
+		entry = storage_image_cache->last_probationary_entry;
+
+		if( entry == NULL )
+		{
+			entry = storage_image_cache->last_protected_entry;
+		}
+	}
+	if( entry == NULL )
+	{
+		return( 0 );
+	}
+	if( libphdi_storage_image_cache_remove_entry(
+	     storage_image_cache,
+	     entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to remove entry: %d.",
+		 function,
+		 entry->extent_index );
+
+		return( -1 );
+	}
+	storage_image_cache->entries[ entry->extent_index ] = NULL;
+
+	if( libphdi_storage_image_free(
+	     &( entry->storage_image ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free storage image: %d.",
+		 function,
+		 entry->extent_index );
+
+		result = -1;
+	}
+	memory_free(
+	 entry );
+
+	return( result );
+}
+
+/* Retrieves the storage image of a specific extent
+ * Returns 1 if successful, 0 if not cached or -1 on error
+ */
+int libphdi_storage_image_cache_get_storage_image_by_index(
+     libphdi_storage_image_cache_t *storage_image_cache,
+     int extent_index,
+     libphdi_storage_image_t **storage_image,
+     libcerror_error_t **error )
+{
+	libphdi_storage_image_cache_entry_t *entry = NULL;
+	static char *function                      = "libphdi_storage_image_cache_get_storage_image_by_index";
+
+	if( storage_image_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_image == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_index < storage_image_cache->entries_size )
+	{
+		entry = storage_image_cache->entries[ extent_index ];
+	}
+	if( entry == NULL )
+	{
+		storage_image_cache->number_of_misses += 1;
+
+		return( 0 );
+	}
+	storage_image_cache->number_of_hits += 1;
+
+	libphdi_statistics_atomic_set32(
+	 &( entry->is_referenced ),
+	 0 );
+
+	/* Repeated use of the most recently used entry, such as by a sequential
+	 * read of an extent, does not promote the entry
+	 */
+	if( extent_index != libphdi_statistics_atomic_get32(
+	                     &( storage_image_cache->last_used_extent_index ) ) )
+	{
+		if( libphdi_storage_image_cache_promote_entry(
+		     storage_image_cache,
+		     entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to promote entry: %d.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		libphdi_statistics_atomic_set32(
+		 &( storage_image_cache->last_used_extent_index ),
+		 extent_index );
+	}
+	*storage_image = entry->storage_image;
+
+	return( 1 );
+}
+
+/* Retrieves the storage image of a specific extent without reordering the segments
+ * Use after another entry was used only marks the entry as referenced, so that it
+ * is promoted the next time an entry is evicted. The mark, the most recently used
+ * extent index and the number of hits are modified atomically, hence the function
+ * can be called by concurrent readers
+ * Returns 1 if successful, 0 if not cached or -1 on error
+ */
+int libphdi_storage_image_cache_peek_storage_image_by_index(
+     libphdi_storage_image_cache_t *storage_image_cache,
+     int extent_index,
+     libphdi_storage_image_t **storage_image,
+     libcerror_error_t **error )
+{
+	libphdi_storage_image_cache_entry_t *entry = NULL;
+	static char *function                      = "libphdi_storage_image_cache_peek_storage_image_by_index";
+
+	if( storage_image_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_image == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_index < storage_image_cache->entries_size )
+	{
+		entry = storage_image_cache->entries[ extent_index ];
+	}
+	if( entry == NULL )
+	{
+		return( 0 );
+	}
+	libphdi_statistics_atomic_add(
+	 &( storage_image_cache->number_of_hits ),
+	 1 );
+
+	if( extent_index != libphdi_statistics_atomic_get32(
+	                     &( storage_image_cache->last_used_extent_index ) ) )
+	{
+		libphdi_statistics_atomic_set32(
+		 &( entry->is_referenced ),
+		 1 );
+
+		libphdi_statistics_atomic_set32(
+		 &( storage_image_cache->last_used_extent_index ),
+		 extent_index );
+	}
+	*storage_image = entry->storage_image;
+
+	return( 1 );
+}
+
+/* Sets the storage image of a specific extent
+ * The storage image cache takes over management of the storage image
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_storage_image_cache_set_storage_image_by_index(
+     libphdi_storage_image_cache_t *storage_image_cache,
+     int extent_index,
+     libphdi_storage_image_t *storage_image,
+     libcerror_error_t **error )
+{
+	libphdi_storage_image_cache_entry_t **entries = NULL;
+	libphdi_storage_image_cache_entry_t *entry    = NULL;
+	static char *function                         = "libphdi_storage_image_cache_set_storage_image_by_index";
+	size_t entries_size                           = 0;
+	int entries_size_value                        = 0;
+
+	if( storage_image_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_index < 0 )
+	 || ( extent_index == INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_image == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_index < storage_image_cache->entries_size )
+	 && ( storage_image_cache->entries[ extent_index ] != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid storage image cache - entry: %d value already set.",
+		 function,
+		 extent_index );
+
+		return( -1 );
+	}
+	if( extent_index >= storage_image_cache->entries_size )
+	{
+		entries_size_value = extent_index + 1;
+		entries_size       = sizeof( libphdi_storage_image_cache_entry_t * ) * entries_size_value;
+
+		if( entries_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid entries size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		entries = (libphdi_storage_image_cache_entry_t **) memory_reallocate(
+		                                                    storage_image_cache->entries,
+		                                                    entries_size );
+
+		if( entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize entries.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     &( entries[ storage_image_cache->entries_size ] ),
+		     0,
+		     sizeof( libphdi_storage_image_cache_entry_t * ) * ( entries_size_value - storage_image_cache->entries_size ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear entries.",
+			 function );
+
+			storage_image_cache->entries = entries;
+
+			return( -1 );
+		}
+		storage_image_cache->entries      = entries;
+		storage_image_cache->entries_size = entries_size_value;
+	}
+	while( ( storage_image_cache->number_of_probationary_entries + storage_image_cache->number_of_protected_entries ) >= storage_image_cache->maximum_number_of_entries )
+	{
+		if( libphdi_storage_image_cache_evict_entry(
+		     storage_image_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to evict entry.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	entry = memory_allocate_structure(
+	         libphdi_storage_image_cache_entry_t );
+
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entry.",
+		 function );
+
+		return( -1 );
+	}
+	entry->extent_index  = extent_index;
+	entry->storage_image = storage_image;
+	entry->is_referenced = 0;
+
+	if( libphdi_storage_image_cache_insert_entry(
+	     storage_image_cache,
+	     entry,
+	     LIBPHDI_STORAGE_IMAGE_CACHE_SEGMENT_PROBATIONARY,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert entry: %d.",
+		 function,
+		 extent_index );
+
+		memory_free(
+		 entry );
+
+		return( -1 );
+	}
+	storage_image_cache->entries[ extent_index ] = entry;
+
+	libphdi_statistics_atomic_set32(
+	 &( storage_image_cache->last_used_extent_index ),
+	 extent_index );
+
+	return( 1 );
+}
+
+/* Sets the maximum number of entries
+ * Entries are evicted when the cache contains more entries than the new maximum
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_storage_image_cache_set_maximum_number_of_entries(
+     libphdi_storage_image_cache_t *storage_image_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_storage_image_cache_set_maximum_number_of_entries";
+
+	if( storage_image_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage image cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	storage_image_cache->maximum_number_of_entries = maximum_number_of_entries;
+
+	while( ( storage_image_cache->number_of_probationary_entries + storage_image_cache->number_of_protected_entries ) > maximum_number_of_entries )
+	{
+		if( libphdi_storage_image_cache_evict_entry(
+		     storage_image_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to evict entry.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,182 @@
+/*
+ * Storage image cache functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPHDI_STORAGE_IMAGE_CACHE_H )
+#define _LIBPHDI_STORAGE_IMAGE_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libphdi_libcerror.h"
+#include "libphdi_storage_image.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libphdi_storage_image_cache_entry libphdi_storage_image_cache_entry_t;
+
+struct libphdi_storage_image_cache_entry
+{
+	/* The extent index
+	 */
+	int extent_index;
+
+	/* The storage image
+	 */
+	libphdi_storage_image_t *storage_image;
+
+	/* The segment that contains the entry
+	 */
+	uint8_t segment;
+
+	/* Value to indicate the entry was used by a concurrent reader, which is updated atomically
+	 */
+	int is_referenced;
+
+	/* The previous entry in the segment
+	 */
+	libphdi_storage_image_cache_entry_t *previous_entry;
+
+	/* The next entry in the segment
+	 */
+	libphdi_storage_image_cache_entry_t *next_entry;
+};
+
+typedef struct libphdi_storage_image_cache libphdi_storage_image_cache_t;
+
+/* The storage image cache is a segmented least recently used cache
+ * New entries are added to the probationary segment and are only moved
+ * to the protected segment when they are used again after another entry
+ * was used, so that a single pass over the extents does not evict
+ * the storage images that are used repeatedly
+ * Concurrent readers only mark an entry as referenced, a referenced entry
+ * is promoted instead of evicted the next time an entry is evicted
+ */
+struct libphdi_storage_image_cache
+{
+	/* The entries by extent index
+	 */
+	libphdi_storage_image_cache_entry_t **entries;
+
+	/* The number of entries by extent index that were allocated
+	 */
+	int entries_size;
+
+	/* The first (most recently used) entry of the probationary segment
+	 */
+	libphdi_storage_image_cache_entry_t *first_probationary_entry;
+
+	/* The last (least recently used) entry of the probationary segment
+	 */
+	libphdi_storage_image_cache_entry_t *last_probationary_entry;
+
+	/* The first (most recently used) entry of the protected segment
+	 */
+	libphdi_storage_image_cache_entry_t *first_protected_entry;
+
+	/* The last (least recently used) entry of the protected segment
+	 */
+	libphdi_storage_image_cache_entry_t *last_protected_entry;
+
+	/* The extent index of the most recently used entry, which is updated atomically
+	 */
+	int last_used_extent_index;
+
+	/* The number of entries in the probationary segment
+	 */
+	int number_of_probationary_entries;
+
+	/* The number of entries in the protected segment
+	 */
+	int number_of_protected_entries;
+
+	/* The maximum number of entries
+	 */
+	int maximum_number_of_entries;
+
+	/* The number of cache hits
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of cache misses
+	 */
+	uint64_t number_of_misses;
+};
+
+int libphdi_storage_image_cache_initialize(
+     libphdi_storage_image_cache_t **storage_image_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libphdi_storage_image_cache_free(
+     libphdi_storage_image_cache_t **storage_image_cache,
+     libcerror_error_t **error );
+
+int libphdi_storage_image_cache_remove_entry(
+     libphdi_storage_image_cache_t *storage_image_cache,
+     libphdi_storage_image_cache_entry_t *entry,
+     libcerror_error_t **error );
+
+int libphdi_storage_image_cache_insert_entry(
+     libphdi_storage_image_cache_t *storage_image_cache,
+     libphdi_storage_image_cache_entry_t *entry,
+     uint8_t segment,
+     libcerror_error_t **error );
+
+int libphdi_storage_image_cache_promote_entry(
+     libphdi_storage_image_cache_t *storage_image_cache,
+     libphdi_storage_image_cache_entry_t *entry,
+     libcerror_error_t **error );
+
+int libphdi_storage_image_cache_evict_entry(
+     libphdi_storage_image_cache_t *storage_image_cache,
+     libcerror_error_t **error );
+
+int libphdi_storage_image_cache_get_storage_image_by_index(
+     libphdi_storage_image_cache_t *storage_image_cache,
+     int extent_index,
+     libphdi_storage_image_t **storage_image,
+     libcerror_error_t **error );
+
+int libphdi_storage_image_cache_peek_storage_image_by_index(
+     libphdi_storage_image_cache_t *storage_image_cache,
+     int extent_index,
+     libphdi_storage_image_t **storage_image,
+     libcerror_error_t **error );
+
+int libphdi_storage_image_cache_set_storage_image_by_index(
+     libphdi_storage_image_cache_t *storage_image_cache,
+     int extent_index,
+     libphdi_storage_image_t *storage_image,
+     libcerror_error_t **error );
+
+int libphdi_storage_image_cache_set_maximum_number_of_entries(
+     libphdi_storage_image_cache_t *storage_image_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPHDI_STORAGE_IMAGE_CACHE_H ) */
+
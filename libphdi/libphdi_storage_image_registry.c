@@ -0,0 +1,816 @@
+/*
+ * Storage image registry functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libphdi_definitions.h"
+#include "libphdi_libcdata.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_libcthreads.h"
+#include "libphdi_metadata_index.h"
+#include "libphdi_storage_image_registry.h"
+#include "libphdi_types.h"
+
+/* Frees a storage image registry entry
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_storage_image_registry_entry_free(
+     libphdi_storage_image_registry_entry_t **registry_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libphdi_storage_image_registry_entry_free";
+
+	if( registry_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid registry entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *registry_entry != NULL )
+	{
+		if( ( *registry_entry )->block_allocation_table != NULL )
+		{
+			memory_free(
+			 ( *registry_entry )->block_allocation_table );
+		}
+		memory_free(
+		 *registry_entry );
+
+		*registry_entry = NULL;
+	}
+	return( 1 );
+}
+
+/* Creates a storage image registry
+ * Make sure the value registry is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_storage_image_registry_initialize(
+     libphdi_storage_image_registry_t **registry,
+     libcerror_error_t **error )
+{
+	libphdi_internal_storage_image_registry_t *internal_registry = NULL;
+	static char *function                                        = "libphdi_storage_image_registry_initialize";
+
+	if( registry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid registry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *registry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid registry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_registry = memory_allocate_structure(
+	                     libphdi_internal_storage_image_registry_t );
+
+	if( internal_registry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create registry.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_registry,
+	     0,
+	     sizeof( libphdi_internal_storage_image_registry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear registry.",
+		 function );
+
+		memory_free(
+		 internal_registry );
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( internal_registry->entries_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create entries array.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( internal_registry->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	*registry = (libphdi_storage_image_registry_t *) internal_registry;
+
+	return( 1 );
+
+on_error:
+	if( internal_registry != NULL )
+	{
+		if( internal_registry->entries_array != NULL )
+		{
+			libcdata_array_free(
+			 &( internal_registry->entries_array ),
+			 NULL,
+			 NULL );
+		}
+		memory_free(
+		 internal_registry );
+	}
+	return( -1 );
+}
+
+/* Frees a storage image registry
+ * The registry must be freed after the handles that use it
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_storage_image_registry_free(
+     libphdi_storage_image_registry_t **registry,
+     libcerror_error_t **error )
+{
+	libphdi_internal_storage_image_registry_t *internal_registry = NULL;
+	static char *function                                        = "libphdi_storage_image_registry_free";
+	int result                                                   = 1;
+
+	if( registry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid registry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *registry != NULL )
+	{
+		internal_registry = (libphdi_internal_storage_image_registry_t *) *registry;
+
+		if( internal_registry->number_of_references != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid registry - %d storage images still reference the registry.",
+			 function,
+			 internal_registry->number_of_references );
+
+			return( -1 );
+		}
+		*registry = NULL;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( internal_registry->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( libcdata_array_free(
+		     &( internal_registry->entries_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_storage_image_registry_entry_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free entries array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 internal_registry );
+	}
+	return( result );
+}
+
+/* Retrieves the number of distinct block allocation tables in the registry
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_storage_image_registry_get_number_of_block_allocation_tables(
+     libphdi_storage_image_registry_t *registry,
+     int *number_of_block_allocation_tables,
+     libcerror_error_t **error )
+{
+	libphdi_internal_storage_image_registry_t *internal_registry = NULL;
+	static char *function                                        = "libphdi_storage_image_registry_get_number_of_block_allocation_tables";
+	int result                                                   = 1;
+
+	if( registry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid registry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_registry = (libphdi_internal_storage_image_registry_t *) registry;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_registry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_number_of_entries(
+	     internal_registry->entries_array,
+	     number_of_block_allocation_tables,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_registry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of storage images that reference a block allocation table in the registry
+ * The difference with the number of block allocation tables is the number of copies that were avoided
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_storage_image_registry_get_number_of_references(
+     libphdi_storage_image_registry_t *registry,
+     int *number_of_references,
+     libcerror_error_t **error )
+{
+	libphdi_internal_storage_image_registry_t *internal_registry = NULL;
+	static char *function                                        = "libphdi_storage_image_registry_get_number_of_references";
+
+	if( registry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid registry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_registry = (libphdi_internal_storage_image_registry_t *) registry;
+
+	if( number_of_references == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of references.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_registry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_references = internal_registry->number_of_references;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_registry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Inserts a block allocation table into the registry
+ * If an identical block allocation table is already in the registry the block allocation table
+ * is freed and replaced by the registered copy, otherwise the registry takes over management
+ * of the block allocation table. The registered copy must be released with
+ * libphdi_storage_image_registry_release_entry
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_storage_image_registry_insert_block_allocation_table(
+     libphdi_storage_image_registry_t *registry,
+     uint32_t **block_allocation_table,
+     uint32_t number_of_block_allocation_table_entries,
+     libphdi_storage_image_registry_entry_t **registry_entry,
+     libcerror_error_t **error )
+{
+	libphdi_internal_storage_image_registry_t *internal_registry = NULL;
+	libphdi_storage_image_registry_entry_t *safe_registry_entry  = NULL;
+	static char *function                                        = "libphdi_storage_image_registry_insert_block_allocation_table";
+	size_t block_allocation_table_size                           = 0;
+	uint64_t checksum                                            = 0;
+	int entry_index                                              = 0;
+	int number_of_entries                                        = 0;
+	int result                                                   = 1;
+
+	if( registry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid registry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_registry = (libphdi_internal_storage_image_registry_t *) registry;
+
+	if( ( block_allocation_table == NULL )
+	 || ( *block_allocation_table == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block allocation table.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_block_allocation_table_entries == 0 )
+	 || ( number_of_block_allocation_table_entries > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / 4 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of block allocation table entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( registry_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid registry entry.",
+		 function );
+
+		return( -1 );
+	}
+	block_allocation_table_size = (size_t) number_of_block_allocation_table_entries * 4;
+
+	/* The checksum is calculated before the lock is grabbed since it reads
+	 * the entire block allocation table
+	 */
+	if( libphdi_metadata_index_calculate_checksum(
+	     &checksum,
+	     (uint8_t *) *block_allocation_table,
+	     block_allocation_table_size,
+	     LIBPHDI_METADATA_INDEX_CHECKSUM_INITIAL_VALUE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate block allocation table checksum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_registry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_number_of_entries(
+	     internal_registry->entries_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		goto on_error;
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_registry->entries_array,
+		     entry_index,
+		     (intptr_t **) &safe_registry_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		if( safe_registry_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing entry: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		/* The checksum only selects candidates, the block allocation tables
+		 * are compared in full so that different tables are never shared
+		 */
+		if( ( safe_registry_entry->checksum == checksum )
+		 && ( safe_registry_entry->number_of_block_allocation_table_entries == number_of_block_allocation_table_entries )
+		 && ( memory_compare(
+		       safe_registry_entry->block_allocation_table,
+		       *block_allocation_table,
+		       block_allocation_table_size ) == 0 ) )
+		{
+			break;
+		}
+		safe_registry_entry = NULL;
+	}
+	if( safe_registry_entry != NULL )
+	{
+		memory_free(
+		 *block_allocation_table );
+
+		*block_allocation_table = safe_registry_entry->block_allocation_table;
+	}
+	else
+	{
+		safe_registry_entry = memory_allocate_structure(
+		                       libphdi_storage_image_registry_entry_t );
+
+		if( safe_registry_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entry.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     safe_registry_entry,
+		     0,
+		     sizeof( libphdi_storage_image_registry_entry_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear entry.",
+			 function );
+
+			memory_free(
+			 safe_registry_entry );
+
+			goto on_error;
+		}
+		if( libcdata_array_append_entry(
+		     internal_registry->entries_array,
+		     &entry_index,
+		     (intptr_t *) safe_registry_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append entry to array.",
+			 function );
+
+			memory_free(
+			 safe_registry_entry );
+
+			goto on_error;
+		}
+		safe_registry_entry->registry                                 = internal_registry;
+		safe_registry_entry->checksum                                 = checksum;
+		safe_registry_entry->block_allocation_table                   = *block_allocation_table;
+		safe_registry_entry->number_of_block_allocation_table_entries = number_of_block_allocation_table_entries;
+	}
+	safe_registry_entry->number_of_references += 1;
+	internal_registry->number_of_references   += 1;
+
+	*registry_entry = safe_registry_entry;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_registry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_registry->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Releases a storage image registry entry
+ * The entry, including its block allocation table, is freed when it is no longer referenced
+ * Returns 1 if successful or -1 on error
+ */
+int libphdi_storage_image_registry_release_entry(
+     libphdi_storage_image_registry_entry_t **registry_entry,
+     libcerror_error_t **error )
+{
+	libphdi_internal_storage_image_registry_t *internal_registry = NULL;
+	libphdi_storage_image_registry_entry_t *array_entry          = NULL;
+	libphdi_storage_image_registry_entry_t *safe_registry_entry  = NULL;
+	static char *function                                        = "libphdi_storage_image_registry_release_entry";
+	int entry_index                                              = 0;
+	int number_of_entries                                        = 0;
+	int result                                                   = 1;
+
+	if( registry_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid registry entry.",
+		 function );
+
+		return( -1 );
+	}
+	safe_registry_entry = *registry_entry;
+
+	if( safe_registry_entry == NULL )
+	{
+		return( 1 );
+	}
+	internal_registry = safe_registry_entry->registry;
+
+	if( internal_registry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid registry entry - missing registry.",
+		 function );
+
+		return( -1 );
+	}
+	*registry_entry = NULL;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_registry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	safe_registry_entry->number_of_references -= 1;
+	internal_registry->number_of_references   -= 1;
+
+	if( safe_registry_entry->number_of_references <= 0 )
+	{
+		if( libcdata_array_get_number_of_entries(
+		     internal_registry->entries_array,
+		     &number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of entries.",
+			 function );
+
+			result = -1;
+		}
+		for( entry_index = 0;
+		     ( result == 1 ) && ( entry_index < number_of_entries );
+		     entry_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_registry->entries_array,
+			     entry_index,
+			     (intptr_t **) &array_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve entry: %d.",
+				 function,
+				 entry_index );
+
+				result = -1;
+			}
+			else if( array_entry == safe_registry_entry )
+			{
+				if( libcdata_array_remove_entry(
+				     internal_registry->entries_array,
+				     entry_index,
+				     (intptr_t **) &array_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+					 "%s: unable to remove entry: %d.",
+					 function,
+					 entry_index );
+
+					result = -1;
+				}
+				else if( libphdi_storage_image_registry_entry_free(
+				          &safe_registry_entry,
+				          error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free entry.",
+					 function );
+
+					result = -1;
+				}
+				break;
+			}
+		}
+	}
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_registry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
@@ -0,0 +1,124 @@
+/*
+ * Storage image registry functions
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPHDI_STORAGE_IMAGE_REGISTRY_H )
+#define _LIBPHDI_STORAGE_IMAGE_REGISTRY_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libphdi_extern.h"
+#include "libphdi_libcdata.h"
+#include "libphdi_libcerror.h"
+#include "libphdi_libcthreads.h"
+#include "libphdi_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libphdi_internal_storage_image_registry libphdi_internal_storage_image_registry_t;
+
+typedef struct libphdi_storage_image_registry_entry libphdi_storage_image_registry_entry_t;
+
+struct libphdi_storage_image_registry_entry
+{
+	/* The registry that contains the entry
+	 */
+	libphdi_internal_storage_image_registry_t *registry;
+
+	/* The checksum of the block allocation table
+	 */
+	uint64_t checksum;
+
+	/* The block allocation table, which is shared read-only between storage images
+	 */
+	uint32_t *block_allocation_table;
+
+	/* The number of block allocation table entries
+	 */
+	uint32_t number_of_block_allocation_table_entries;
+
+	/* The number of storage images that reference the entry
+	 */
+	int number_of_references;
+};
+
+struct libphdi_internal_storage_image_registry
+{
+	/* The entries array
+	 */
+	libcdata_array_t *entries_array;
+
+	/* The number of storage images that reference an entry
+	 */
+	int number_of_references;
+
+#if defined( HAVE_LIBPHDI_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libphdi_storage_image_registry_entry_free(
+     libphdi_storage_image_registry_entry_t **registry_entry,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_storage_image_registry_initialize(
+     libphdi_storage_image_registry_t **registry,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_storage_image_registry_free(
+     libphdi_storage_image_registry_t **registry,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_storage_image_registry_get_number_of_block_allocation_tables(
+     libphdi_storage_image_registry_t *registry,
+     int *number_of_block_allocation_tables,
+     libcerror_error_t **error );
+
+LIBPHDI_EXTERN \
+int libphdi_storage_image_registry_get_number_of_references(
+     libphdi_storage_image_registry_t *registry,
+     int *number_of_references,
+     libcerror_error_t **error );
+
+int libphdi_storage_image_registry_insert_block_allocation_table(
+     libphdi_storage_image_registry_t *registry,
+     uint32_t **block_allocation_table,
+     uint32_t number_of_block_allocation_table_entries,
+     libphdi_storage_image_registry_entry_t **registry_entry,
+     libcerror_error_t **error );
+
+int libphdi_storage_image_registry_release_entry(
+     libphdi_storage_image_registry_entry_t **registry_entry,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPHDI_STORAGE_IMAGE_REGISTRY_H ) */
+
@@ -34,16 +34,20 @@
 /* The following type definitions hide internal data structures
  */
 #if defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI )
+typedef struct libphdi_data_cache {}		libphdi_data_cache_t;
 typedef struct libphdi_extent_descriptor {}	libphdi_extent_descriptor_t;
 typedef struct libphdi_handle {}		libphdi_handle_t;
 typedef struct libphdi_image_descriptor {}	libphdi_image_descriptor_t;
 typedef struct libphdi_snapshot {}		libphdi_snapshot_t;
+typedef struct libphdi_storage_image_registry {}	libphdi_storage_image_registry_t;
 
 #else
+typedef intptr_t libphdi_data_cache_t;
 typedef intptr_t libphdi_extent_descriptor_t;
 typedef intptr_t libphdi_handle_t;
 typedef intptr_t libphdi_image_descriptor_t;
 typedef intptr_t libphdi_snapshot_t;
+typedef intptr_t libphdi_storage_image_registry_t;
 
 #endif /* defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI ) */
 
@@ -35,12 +35,9 @@
 #include "libphdi_types.h"
 #include "libphdi_xml_tag.h"
 
-#define YYMALLOC	libphdi_xml_scanner_alloc
-#define YYREALLOC	libphdi_xml_scanner_realloc
-#define YYFREE		libphdi_xml_scanner_free
-
-#define YYLEX_PARAM	NULL
-#define YYPARSE_PARAM	parser_state
+#define YYMALLOC	memory_allocate
+#define YYREALLOC	memory_reallocate
+#define YYFREE		memory_free
 
 #if defined( HAVE_DEBUG_OUTPUT )
 #define libphdi_xml_parser_rule_print( string ) \
@@ -54,8 +51,14 @@
 /* %name-prefix="libphdi_xml_scanner_" replaced by -p libphdi_xml_scanner_ */
 /* %no-lines replaced by -l */
 
-%lex-param { (void *) NULL }
+/* The parser is pure and the scanner is reentrant so that multiple buffers
+ * can be parsed concurrently
+ */
+%define api.pure
+
+%lex-param { void *scanner }
 %parse-param { void *parser_state }
+%parse-param { void *scanner }
 
 %start xml_plist_main
 
@@ -114,42 +117,34 @@ extern \
 int libphdi_xml_scanner_suppress_error;
 
 extern \
-int libphdi_xml_scanner_lex_destroy(
-     void );
+int libphdi_xml_scanner_lex_init(
+     void **scanner );
 
 extern \
-void *libphdi_xml_scanner_alloc(
-       yy_size_t size );
-
-extern \
-void *libphdi_xml_scanner_realloc(
-       void *buffer,
-       yy_size_t size );
-
-extern \
-void *libphdi_xml_scanner_free(
-       void *buffer );
+int libphdi_xml_scanner_lex_destroy(
+     void *scanner );
 
 extern \
 int libphdi_xml_scanner_lex(
-     void *user_data );
+     YYSTYPE *value,
+     void *scanner );
 
 extern \
 void libphdi_xml_scanner_error(
       void *parser_state,
+      void *scanner,
       const char *error_string );
 
 extern \
 YY_BUFFER_STATE libphdi_xml_scanner__scan_buffer(
                  char *buffer,
-                 yy_size_t buffer_size );
+                 yy_size_t buffer_size,
+                 void *scanner );
 
 extern \
 void libphdi_xml_scanner__delete_buffer(
-      YY_BUFFER_STATE buffer_state );
-
-extern \
-size_t libphdi_xml_scanner_buffer_offset;
+      YY_BUFFER_STATE buffer_state,
+      void *scanner );
 
 static char *libphdi_xml_parser_function = "libphdi_xml_parser";
 
@@ -435,6 +430,10 @@ xml_attribute
 
 %%
 
+/* Parses the XML in the buffer
+ * The buffer must end with 2 zero bytes
+ * Returns 1 if successful or -1 on error
+ */
 int libphdi_xml_parser_parse_buffer(
      libphdi_disk_descriptor_xml_file_t *disk_descriptor_xml_file,
      uint8_t *buffer,
@@ -442,27 +441,40 @@ int libphdi_xml_parser_parse_buffer(
      libcerror_error_t **error )
 {
 	libphdi_xml_parser_state_t parser_state;
-	
+
 	YY_BUFFER_STATE buffer_state = NULL;
+	void *scanner                = NULL;
 	static char *function        = "libphdi_xml_parser_parse_buffer";
 	int result                   = -1;
 
+	parser_state.disk_descriptor_xml_file = disk_descriptor_xml_file;
+	parser_state.error                    = error;
+	parser_state.root_tag                 = NULL;
+	parser_state.current_tag              = NULL;
+	parser_state.parent_tag               = NULL;
+
+	if( libphdi_xml_scanner_lex_init(
+	     &scanner ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create scanner.",
+		 function );
+
+		return( -1 );
+	}
 	buffer_state = libphdi_xml_scanner__scan_buffer(
 	                (char *) buffer,
-	                buffer_size );
-
-	libphdi_xml_scanner_buffer_offset = 0;
+	                buffer_size,
+	                scanner );
 
 	if( buffer_state != NULL )
 	{
-		parser_state.disk_descriptor_xml_file = disk_descriptor_xml_file;
-		parser_state.error                    = error;
-		parser_state.root_tag                 = NULL;
-		parser_state.current_tag              = NULL;
-		parser_state.parent_tag               = NULL;
-
 		if( libphdi_xml_scanner_parse(
-		     &parser_state ) == 0 )
+		     &parser_state,
+		     scanner ) == 0 )
 		{
 			if( libphdi_disk_descriptor_xml_file_set_root_tag(
 			     disk_descriptor_xml_file,
@@ -486,9 +498,11 @@ int libphdi_xml_parser_parse_buffer(
 			}
 		}
 		libphdi_xml_scanner__delete_buffer(
-		 buffer_state );
+		 buffer_state,
+		 scanner );
 	}
-	libphdi_xml_scanner_lex_destroy();
+	libphdi_xml_scanner_lex_destroy(
+	 scanner );
 
 	if( parser_state.root_tag != NULL )
 	{
@@ -0,0 +1,235 @@
+/*
+ * The metadata index file of a Parallels Hard Disk image
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _PHDI_METADATA_INDEX_H )
+#define _PHDI_METADATA_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The metadata index file is not part of the Parallels format, it is written by the library.
+ * All values are stored in little-endian and every record starts on an 8 byte boundary.
+ * The file header is followed by the disk parameters record, the extent records,
+ * each directly followed by its image records, the snapshot records and the storage
+ * image records.
+ */
+
+typedef struct phdi_metadata_index_file_header phdi_metadata_index_file_header_t;
+
+struct phdi_metadata_index_file_header
+{
+	/* Signature
+	 * Consists of 8 bytes
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 * Consists of 4 bytes
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* The disk type
+	 * Consists of 4 bytes
+	 */
+	uint8_t disk_type[ 4 ];
+
+	/* The size of the data that follows the file header
+	 * Consists of 8 bytes
+	 */
+	uint8_t data_size[ 8 ];
+
+	/* The checksum of the data that follows the file header
+	 * Consists of 8 bytes
+	 */
+	uint8_t checksum[ 8 ];
+
+	/* The size of the disk descriptor XML file
+	 * Consists of 8 bytes
+	 */
+	uint8_t descriptor_size[ 8 ];
+
+	/* The checksum of the disk descriptor XML file
+	 * Consists of 8 bytes
+	 */
+	uint8_t descriptor_checksum[ 8 ];
+
+	/* The number of extents
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_extents[ 4 ];
+
+	/* The number of snapshots
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_snapshots[ 4 ];
+
+	/* The number of storage images
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_storage_images[ 4 ];
+
+	/* Unknown (padding)
+	 * Consists of 4 bytes
+	 */
+	uint8_t unknown1[ 4 ];
+};
+
+typedef struct phdi_metadata_index_disk_parameters phdi_metadata_index_disk_parameters_t;
+
+struct phdi_metadata_index_disk_parameters
+{
+	/* The media size
+	 * Consists of 8 bytes
+	 */
+	uint8_t media_size[ 8 ];
+
+	/* The number of sectors
+	 * Consists of 8 bytes
+	 */
+	uint8_t number_of_sectors[ 8 ];
+
+	/* The number of cylinders
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_cylinders[ 4 ];
+
+	/* The number of heads
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_heads[ 4 ];
+
+	/* The name size, including the end-of-string character,
+	 * the name directly follows the record
+	 * Consists of 4 bytes
+	 */
+	uint8_t name_size[ 4 ];
+
+	/* Unknown (padding)
+	 * Consists of 4 bytes
+	 */
+	uint8_t unknown1[ 4 ];
+};
+
+typedef struct phdi_metadata_index_extent phdi_metadata_index_extent_t;
+
+struct phdi_metadata_index_extent
+{
+	/* The offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t offset[ 8 ];
+
+	/* The size
+	 * Consists of 8 bytes
+	 */
+	uint8_t size[ 8 ];
+
+	/* The number of images
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_images[ 4 ];
+
+	/* Unknown (padding)
+	 * Consists of 4 bytes
+	 */
+	uint8_t unknown1[ 4 ];
+};
+
+typedef struct phdi_metadata_index_image phdi_metadata_index_image_t;
+
+struct phdi_metadata_index_image
+{
+	/* The identifier
+	 * Consists of 16 bytes
+	 */
+	uint8_t identifier[ 16 ];
+
+	/* The type
+	 * Consists of 4 bytes
+	 */
+	uint8_t type[ 4 ];
+
+	/* The filename size, including the end-of-string character,
+	 * the UTF-8 encoded filename directly follows the record
+	 * Consists of 4 bytes
+	 */
+	uint8_t filename_size[ 4 ];
+};
+
+typedef struct phdi_metadata_index_snapshot phdi_metadata_index_snapshot_t;
+
+struct phdi_metadata_index_snapshot
+{
+	/* The identifier
+	 * Consists of 16 bytes
+	 */
+	uint8_t identifier[ 16 ];
+
+	/* The parent identifier
+	 * Consists of 16 bytes
+	 */
+	uint8_t parent_identifier[ 16 ];
+};
+
+typedef struct phdi_metadata_index_storage_image phdi_metadata_index_storage_image_t;
+
+struct phdi_metadata_index_storage_image
+{
+	/* The file size of the storage image
+	 * Consists of 8 bytes
+	 */
+	uint8_t file_size[ 8 ];
+
+	/* The file IO pool entry
+	 * Consists of 4 bytes
+	 */
+	uint8_t file_io_pool_entry[ 4 ];
+
+	/* The number of block allocation table entries, the entries directly follow the record
+	 * or 0 if the block allocation table is not stored in the index
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_entries[ 4 ];
+
+	/* The checksum of the samples of the block allocation table that directly
+	 * follows the sparse image header in the file or 0 if the block allocation
+	 * table is not stored in the index
+	 * Consists of 8 bytes
+	 */
+	uint8_t block_allocation_table_sample_checksum[ 8 ];
+
+	/* The sparse image header
+	 * Contains the first 64 bytes of the file for a plain storage image
+	 * Consists of 64 bytes
+	 */
+	uint8_t sparse_image_header[ 64 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _PHDI_METADATA_INDEX_H ) */
+
@@ -0,0 +1,2674 @@
+/*
+ * Benchmark handle
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <math.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#endif
+
+#include <time.h>
+
+#include "bench_handle.h"
+#include "byte_size_string.h"
+#include "phditools_libcerror.h"
+#include "phditools_libcnotify.h"
+#include "phditools_libcthreads.h"
+#include "phditools_libphdi.h"
+
+#define BENCH_HANDLE_NOTIFY_STREAM			stdout
+
+#define BENCH_HANDLE_MAXIMUM_BLOCK_SIZE			( 64 * 1024 * 1024 )
+#define BENCH_HANDLE_MAXIMUM_NUMBER_OF_READS		( 128 * 1024 * 1024 )
+#define BENCH_HANDLE_MAXIMUM_NUMBER_OF_THREADS		64
+#define BENCH_HANDLE_MAXIMUM_QUEUE_DEPTH		256
+
+/* The exponent of the zipfian distribution
+ */
+#define BENCH_HANDLE_ZIPFIAN_EXPONENT			0.99
+
+/* Creates a benchmark handle
+ * Make sure the value bench_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_initialize(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_initialize";
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid benchmark handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*bench_handle = memory_allocate_structure(
+	                 bench_handle_t );
+
+	if( *bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create benchmark handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *bench_handle,
+	     0,
+	     sizeof( bench_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear benchmark handle.",
+		 function );
+
+		memory_free(
+		 *bench_handle );
+
+		*bench_handle = NULL;
+
+		return( -1 );
+	}
+	if( libphdi_handle_initialize(
+	     &( ( *bench_handle )->input_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *bench_handle )->access_pattern    = BENCH_HANDLE_ACCESS_PATTERN_SEQUENTIAL;
+	( *bench_handle )->offset_selection  = BENCH_HANDLE_OFFSET_SELECTION_ALL;
+	( *bench_handle )->output_format     = BENCH_HANDLE_OUTPUT_FORMAT_TEXT;
+	( *bench_handle )->block_size        = 4096;
+	( *bench_handle )->number_of_reads   = 10000;
+	( *bench_handle )->number_of_threads = 1;
+	( *bench_handle )->queue_depth       = 1;
+	( *bench_handle )->seed              = 1;
+	( *bench_handle )->notify_stream     = BENCH_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *bench_handle != NULL )
+	{
+		memory_free(
+		 *bench_handle );
+
+		*bench_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a benchmark handle
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_free(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_free";
+	int result            = 1;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_handle != NULL )
+	{
+		if( ( *bench_handle )->input_handle != NULL )
+		{
+			if( libphdi_handle_free(
+			     &( ( *bench_handle )->input_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *bench_handle )->ranges != NULL )
+		{
+			memory_free(
+			 ( *bench_handle )->ranges );
+		}
+		memory_free(
+		 *bench_handle );
+
+		*bench_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the benchmark handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_signal_abort(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_signal_abort";
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->abort = 1;
+
+	if( bench_handle->input_handle != NULL )
+	{
+		if( libphdi_handle_signal_abort(
+		     bench_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input handle to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Copies a decimal string to an unsigned 64-bit value
+ * Returns 1 if successful, 0 if the string is not a decimal value or -1 on error
+ */
+int bench_handle_copy_decimal_string_to_64_bit(
+     const system_character_t *string,
+     uint64_t *value,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_copy_decimal_string_to_64_bit";
+	size_t string_index   = 0;
+	uint64_t safe_value   = 0;
+	uint8_t digit         = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] == 0 )
+	{
+		return( 0 );
+	}
+	for( string_index = 0;
+	     string[ string_index ] != 0;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] < (system_character_t) '0' )
+		 || ( string[ string_index ] > (system_character_t) '9' ) )
+		{
+			return( 0 );
+		}
+		digit = (uint8_t) ( string[ string_index ] - (system_character_t) '0' );
+
+		if( safe_value > ( ( UINT64_MAX - digit ) / 10 ) )
+		{
+			return( 0 );
+		}
+		safe_value = ( safe_value * 10 ) + digit;
+	}
+	*value = safe_value;
+
+	return( 1 );
+}
+
+/* Sets the access pattern
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_access_pattern(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_access_pattern";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 6 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "random" ),
+		     6 ) == 0 )
+		{
+			bench_handle->access_pattern = BENCH_HANDLE_ACCESS_PATTERN_RANDOM;
+			result                       = 1;
+		}
+	}
+	else if( string_length == 7 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "zipfian" ),
+		     7 ) == 0 )
+		{
+			bench_handle->access_pattern = BENCH_HANDLE_ACCESS_PATTERN_ZIPFIAN;
+			result                       = 1;
+		}
+	}
+	else if( string_length == 10 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "sequential" ),
+		     10 ) == 0 )
+		{
+			bench_handle->access_pattern = BENCH_HANDLE_ACCESS_PATTERN_SEQUENTIAL;
+			result                       = 1;
+		}
+	}
+	return( result );
+}
+
+/* Sets the offset selection
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_offset_selection(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_offset_selection";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 3 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "all" ),
+		     3 ) == 0 )
+		{
+			bench_handle->offset_selection = BENCH_HANDLE_OFFSET_SELECTION_ALL;
+			result                         = 1;
+		}
+	}
+	else if( string_length == 6 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "parent" ),
+		     6 ) == 0 )
+		{
+			bench_handle->offset_selection = BENCH_HANDLE_OFFSET_SELECTION_PARENT_SNAPSHOTS;
+			result                         = 1;
+		}
+	}
+	else if( string_length == 7 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "current" ),
+		     7 ) == 0 )
+		{
+			bench_handle->offset_selection = BENCH_HANDLE_OFFSET_SELECTION_CURRENT_SNAPSHOT;
+			result                         = 1;
+		}
+	}
+	return( result );
+}
+
+/* Sets the output format
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_output_format(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_output_format";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 4 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "json" ),
+		     4 ) == 0 )
+		{
+			bench_handle->output_format = BENCH_HANDLE_OUTPUT_FORMAT_JSON;
+			result                      = 1;
+		}
+		else if( system_string_compare(
+		          string,
+		          _SYSTEM_STRING( "text" ),
+		          4 ) == 0 )
+		{
+			bench_handle->output_format = BENCH_HANDLE_OUTPUT_FORMAT_TEXT;
+			result                      = 1;
+		}
+	}
+	return( result );
+}
+
+/* Sets the block size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_block_size(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_block_size";
+	size_t string_length  = 0;
+	uint64_t size_value   = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( byte_size_string_convert(
+	     string,
+	     string_length,
+	     &size_value,
+	     NULL ) != 1 )
+	{
+		return( 0 );
+	}
+	if( ( size_value == 0 )
+	 || ( size_value > (uint64_t) BENCH_HANDLE_MAXIMUM_BLOCK_SIZE ) )
+	{
+		return( 0 );
+	}
+	bench_handle->block_size = (size_t) size_value;
+
+	return( 1 );
+}
+
+/* Sets the number of reads per thread
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_number_of_reads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_number_of_reads";
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = bench_handle_copy_decimal_string_to_64_bit(
+	          string,
+	          &value_64bit,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit value.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( ( value_64bit == 0 )
+		 || ( value_64bit > (uint64_t) BENCH_HANDLE_MAXIMUM_NUMBER_OF_READS ) )
+		{
+			return( 0 );
+		}
+		bench_handle->number_of_reads = value_64bit;
+	}
+	return( result );
+}
+
+/* Sets the number of threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_number_of_threads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_number_of_threads";
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = bench_handle_copy_decimal_string_to_64_bit(
+	          string,
+	          &value_64bit,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit value.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( value_64bit == 0 )
+		 || ( value_64bit > (uint64_t) BENCH_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+#else
+		if( value_64bit != 1 )
+#endif
+		{
+			return( 0 );
+		}
+		bench_handle->number_of_threads = (int) value_64bit;
+	}
+	return( result );
+}
+
+/* Sets the queue depth per thread
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_queue_depth(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_queue_depth";
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = bench_handle_copy_decimal_string_to_64_bit(
+	          string,
+	          &value_64bit,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit value.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( ( value_64bit == 0 )
+		 || ( value_64bit > (uint64_t) BENCH_HANDLE_MAXIMUM_QUEUE_DEPTH ) )
+		{
+			return( 0 );
+		}
+		bench_handle->queue_depth = (int) value_64bit;
+	}
+	return( result );
+}
+
+/* Sets the seed of the pseudo random number generator
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_seed(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_seed";
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = bench_handle_copy_decimal_string_to_64_bit(
+	          string,
+	          &value_64bit,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit value.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		bench_handle->seed = value_64bit;
+	}
+	return( result );
+}
+
+/* Opens an input handle
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_open_input_handle(
+     libphdi_handle_t *input_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_open_input_handle";
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libphdi_handle_open_wide(
+	     input_handle,
+	     filename,
+	     LIBPHDI_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libphdi_handle_open(
+	     input_handle,
+	     filename,
+	     LIBPHDI_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libphdi_handle_open_extent_data_files(
+	     input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		libphdi_handle_close(
+		 input_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends a range of offsets to read
+ * Only complete blocks are read hence the remainder of the range is ignored
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_append_range(
+     bench_handle_t *bench_handle,
+     off64_t range_offset,
+     size64_t range_size,
+     libcerror_error_t **error )
+{
+	bench_handle_range_t *ranges = NULL;
+	static char *function        = "bench_handle_append_range";
+	uint64_t number_of_blocks    = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid benchmark handle - missing block size.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_blocks = range_size / bench_handle->block_size;
+
+	if( number_of_blocks == 0 )
+	{
+		return( 1 );
+	}
+	if( bench_handle->number_of_ranges >= ( INT_MAX - 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of ranges value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	ranges = (bench_handle_range_t *) memory_reallocate(
+	                                   bench_handle->ranges,
+	                                   sizeof( bench_handle_range_t ) * ( bench_handle->number_of_ranges + 1 ) );
+
+	if( ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize ranges.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->ranges = ranges;
+
+	ranges[ bench_handle->number_of_ranges ].offset            = range_offset;
+	ranges[ bench_handle->number_of_ranges ].first_block_index = bench_handle->number_of_blocks;
+	ranges[ bench_handle->number_of_ranges ].number_of_blocks  = number_of_blocks;
+
+	bench_handle->number_of_ranges += 1;
+	bench_handle->number_of_blocks += number_of_blocks;
+
+	return( 1 );
+}
+
+/* Determines the ranges of offsets to read based on the offset selection
+ * The parent snapshots selection consists of the allocated data that is not stored
+ * in the current snapshot, hence reads of which fall through to a parent snapshot
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_determine_ranges(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function        = "bench_handle_determine_ranges";
+	size64_t current_range_size  = 0;
+	size64_t range_size          = 0;
+	off64_t current_offset       = 0;
+	off64_t current_range_offset = 0;
+	off64_t range_end_offset     = 0;
+	off64_t range_offset         = 0;
+	uint8_t allocation_flags     = 0;
+	int result                   = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->offset_selection == BENCH_HANDLE_OFFSET_SELECTION_ALL )
+	{
+		if( bench_handle_append_range(
+		     bench_handle,
+		     0,
+		     bench_handle->media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append range.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( bench_handle->offset_selection == BENCH_HANDLE_OFFSET_SELECTION_CURRENT_SNAPSHOT )
+	{
+		allocation_flags = LIBPHDI_ALLOCATION_FLAG_CURRENT_SNAPSHOT_ONLY;
+	}
+	while( (size64_t) range_offset < bench_handle->media_size )
+	{
+		result = libphdi_handle_get_allocated_range(
+		          bench_handle->input_handle,
+		          range_offset,
+		          allocation_flags,
+		          &range_offset,
+		          &range_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve allocated range.",
+			 function );
+
+			return( -1 );
+		}
+		else if( ( result == 0 )
+		      || ( range_size == 0 ) )
+		{
+			break;
+		}
+		range_end_offset = range_offset + (off64_t) range_size;
+
+		if( bench_handle->offset_selection == BENCH_HANDLE_OFFSET_SELECTION_CURRENT_SNAPSHOT )
+		{
+			if( bench_handle_append_range(
+			     bench_handle,
+			     range_offset,
+			     range_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append range.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			/* Exclude the parts of the range that are stored in the current snapshot
+			 */
+			current_offset = range_offset;
+
+			while( current_offset < range_end_offset )
+			{
+				result = libphdi_handle_get_allocated_range(
+				          bench_handle->input_handle,
+				          current_offset,
+				          LIBPHDI_ALLOCATION_FLAG_CURRENT_SNAPSHOT_ONLY,
+				          &current_range_offset,
+				          &current_range_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve allocated range of current snapshot.",
+					 function );
+
+					return( -1 );
+				}
+				else if( ( result == 0 )
+				      || ( current_range_offset >= range_end_offset ) )
+				{
+					current_range_offset = range_end_offset;
+					current_range_size   = 0;
+				}
+				if( current_range_offset > current_offset )
+				{
+					if( bench_handle_append_range(
+					     bench_handle,
+					     current_offset,
+					     (size64_t) ( current_range_offset - current_offset ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+						 "%s: unable to append range.",
+						 function );
+
+						return( -1 );
+					}
+				}
+				if( current_range_size == 0 )
+				{
+					break;
+				}
+				current_offset = current_range_offset + (off64_t) current_range_size;
+			}
+		}
+		range_offset = range_end_offset;
+	}
+	return( 1 );
+}
+
+/* Opens the benchmark handle
+ * The block size and offset selection must be set before the input is opened
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_open_input(
+     bench_handle_t *bench_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_open_input";
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle_open_input_handle(
+	     bench_handle->input_handle,
+	     filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->filename = filename;
+
+	if( libphdi_handle_get_media_size(
+	     bench_handle->input_handle,
+	     &( bench_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle_determine_ranges(
+	     bench_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine ranges.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->number_of_blocks == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: no blocks of the block size available for the offset selection.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes the benchmark handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int bench_handle_close(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_close";
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->input_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid benchmark handle - missing input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libphdi_handle_close(
+	     bench_handle->input_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the offset of a block
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_get_block_offset(
+     bench_handle_t *bench_handle,
+     uint64_t block_index,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	bench_handle_range_t *range = NULL;
+	static char *function       = "bench_handle_get_block_offset";
+	int range_index             = 0;
+	int range_index_end         = 0;
+	int range_index_start       = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_index >= bench_handle->number_of_blocks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	/* The ranges are stored in order of their first block index
+	 */
+	range_index_end = bench_handle->number_of_ranges;
+
+	while( ( range_index_end - range_index_start ) > 1 )
+	{
+		range_index = range_index_start + ( ( range_index_end - range_index_start ) / 2 );
+
+		if( block_index < bench_handle->ranges[ range_index ].first_block_index )
+		{
+			range_index_end = range_index;
+		}
+		else
+		{
+			range_index_start = range_index;
+		}
+	}
+	range = &( bench_handle->ranges[ range_index_start ] );
+
+	*offset = range->offset + (off64_t) ( ( block_index - range->first_block_index ) * bench_handle->block_size );
+
+	return( 1 );
+}
+
+/* Retrieves a timestamp in nanoseconds of a monotonic clock
+ * Returns the timestamp or 0 if not available
+ */
+uint64_t bench_handle_get_timestamp(
+          void )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+	if( QueryPerformanceFrequency(
+	     &frequency ) == 0 )
+	{
+		return( 0 );
+	}
+	if( QueryPerformanceCounter(
+	     &counter ) == 0 )
+	{
+		return( 0 );
+	}
+	return( (uint64_t) ( ( (double) counter.QuadPart * 1000000000.0 ) / (double) frequency.QuadPart ) );
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	struct timespec time_structure;
+
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_structure.tv_sec * 1000000000 ) + (uint64_t) time_structure.tv_nsec );
+
+#elif defined( HAVE_SYS_TIME_H )
+	struct timeval time_structure;
+
+	if( gettimeofday(
+	     &time_structure,
+	     NULL ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_structure.tv_sec * 1000000000 ) + ( (uint64_t) time_structure.tv_usec * 1000 ) );
+
+#else
+	return( 0 );
+
+#endif
+}
+
+/* Retrieves the next pseudo random number
+ * The pseudo random number generator is splitmix64, which is fast and
+ * reproducible for the same seed across platforms
+ * Returns the pseudo random number
+ */
+uint64_t bench_handle_worker_get_random(
+          bench_handle_worker_t *worker )
+{
+	uint64_t value = 0;
+
+	worker->random_state += 0x9e3779b97f4a7c15ULL;
+
+	value = worker->random_state;
+	value = ( value ^ ( value >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+	value = ( value ^ ( value >> 27 ) ) * 0x94d049bb133111ebULL;
+
+	return( value ^ ( value >> 31 ) );
+}
+
+/* Computes log1p( x ) / x of the zipfian distribution
+ * Returns the value
+ */
+double bench_handle_zipfian_helper1(
+        double x )
+{
+	if( fabs( x ) > 1e-8 )
+	{
+		return( log1p( x ) / x );
+	}
+	return( 1.0 - ( x * ( 0.5 - ( x * ( ( 1.0 / 3.0 ) - ( 0.25 * x ) ) ) ) ) );
+}
+
+/* Computes expm1( x ) / x of the zipfian distribution
+ * Returns the value
+ */
+double bench_handle_zipfian_helper2(
+        double x )
+{
+	if( fabs( x ) > 1e-8 )
+	{
+		return( expm1( x ) / x );
+	}
+	return( 1.0 + ( x * 0.5 * ( 1.0 + ( x / 3.0 * ( 1.0 + ( 0.25 * x ) ) ) ) ) );
+}
+
+/* Computes the integral of the hat function of the zipfian distribution
+ * Returns the value
+ */
+double bench_handle_zipfian_h_integral(
+        double x )
+{
+	double log_x = log( x );
+
+	return( bench_handle_zipfian_helper2( ( 1.0 - BENCH_HANDLE_ZIPFIAN_EXPONENT ) * log_x ) * log_x );
+}
+
+/* Computes the hat function of the zipfian distribution
+ * Returns the value
+ */
+double bench_handle_zipfian_h(
+        double x )
+{
+	return( exp( -BENCH_HANDLE_ZIPFIAN_EXPONENT * log( x ) ) );
+}
+
+/* Computes the inverse of the integral of the hat function of the zipfian distribution
+ * Returns the value
+ */
+double bench_handle_zipfian_h_integral_inverse(
+        double x )
+{
+	double t = x * ( 1.0 - BENCH_HANDLE_ZIPFIAN_EXPONENT );
+
+	if( t < -1.0 )
+	{
+		t = -1.0;
+	}
+	return( exp( bench_handle_zipfian_helper1( t ) * x ) );
+}
+
+/* Initializes the values of the zipfian distribution
+ * The ranks are sampled using rejection-inversion, which does not require
+ * values to be precomputed for every block
+ */
+void bench_handle_zipfian_initialize(
+      bench_handle_t *bench_handle )
+{
+	bench_handle->zipfian_h_integral_x1               = bench_handle_zipfian_h_integral( 1.5 ) - 1.0;
+	bench_handle->zipfian_h_integral_number_of_blocks = bench_handle_zipfian_h_integral( (double) bench_handle->number_of_blocks + 0.5 );
+	bench_handle->zipfian_s                           = 2.0 - bench_handle_zipfian_h_integral_inverse( bench_handle_zipfian_h_integral( 2.5 ) - bench_handle_zipfian_h( 2.0 ) );
+}
+
+/* Retrieves the next zipfian distributed rank
+ * Returns the rank, where 1 is the most frequent rank
+ */
+uint64_t bench_handle_worker_get_zipfian_rank(
+          bench_handle_worker_t *worker )
+{
+	bench_handle_t *bench_handle = worker->bench_handle;
+	double u                     = 0.0;
+	double x                     = 0.0;
+	uint64_t rank                = 0;
+
+	for( ;; )
+	{
+		u = bench_handle->zipfian_h_integral_number_of_blocks
+		  + ( (double) ( bench_handle_worker_get_random( worker ) >> 11 ) / 9007199254740992.0 )
+		  * ( bench_handle->zipfian_h_integral_x1 - bench_handle->zipfian_h_integral_number_of_blocks );
+
+		x = bench_handle_zipfian_h_integral_inverse( u );
+
+		if( x < 1.5 )
+		{
+			rank = 1;
+		}
+		else if( x >= ( (double) bench_handle->number_of_blocks + 0.5 ) )
+		{
+			rank = bench_handle->number_of_blocks;
+		}
+		else
+		{
+			rank = (uint64_t) ( x + 0.5 );
+		}
+		if( ( ( (double) rank - x ) <= bench_handle->zipfian_s )
+		 || ( u >= ( bench_handle_zipfian_h_integral( (double) rank + 0.5 ) - bench_handle_zipfian_h( (double) rank ) ) ) )
+		{
+			break;
+		}
+	}
+	return( rank );
+}
+
+/* Retrieves the index of the next block to read
+ * The zipfian ranks are scrambled with a FNV-1a hash so that the frequently
+ * read blocks are spread across the offsets
+ * Returns the block index
+ */
+uint64_t bench_handle_worker_get_next_block_index(
+          bench_handle_worker_t *worker )
+{
+	bench_handle_t *bench_handle = worker->bench_handle;
+	uint64_t block_index         = 0;
+	uint64_t hash                = 0;
+	uint64_t rank                = 0;
+	uint8_t byte_index           = 0;
+
+	switch( bench_handle->access_pattern )
+	{
+		case BENCH_HANDLE_ACCESS_PATTERN_RANDOM:
+			block_index = bench_handle_worker_get_random( worker ) % bench_handle->number_of_blocks;
+			break;
+
+		case BENCH_HANDLE_ACCESS_PATTERN_ZIPFIAN:
+			rank = bench_handle_worker_get_zipfian_rank( worker );
+			hash = 0xcbf29ce484222325ULL;
+
+			for( byte_index = 0;
+			     byte_index < 8;
+			     byte_index++ )
+			{
+				hash ^= rank & 0xff;
+				hash *= 0x100000001b3ULL;
+				rank >>= 8;
+			}
+			block_index = hash % bench_handle->number_of_blocks;
+			break;
+
+		case BENCH_HANDLE_ACCESS_PATTERN_SEQUENTIAL:
+		default:
+			block_index = worker->sequential_block_index;
+
+			worker->sequential_block_index += 1;
+
+			if( worker->sequential_block_index >= bench_handle->number_of_blocks )
+			{
+				worker->sequential_block_index = 0;
+			}
+			break;
+	}
+	return( block_index );
+}
+
+
+/* Reads the blocks of a worker using synchronous reads
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_worker_read_synchronous(
+     bench_handle_worker_t *worker,
+     libcerror_error_t **error )
+{
+	bench_handle_t *bench_handle = NULL;
+	uint8_t *buffer              = NULL;
+	static char *function        = "bench_handle_worker_read_synchronous";
+	ssize_t read_count           = 0;
+	off64_t offset               = 0;
+	uint64_t block_index         = 0;
+	uint64_t read_index          = 0;
+	uint64_t start_timestamp     = 0;
+
+	if( worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle = worker->bench_handle;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * bench_handle->block_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	for( read_index = 0;
+	     read_index < bench_handle->number_of_reads;
+	     read_index++ )
+	{
+		if( bench_handle->abort != 0 )
+		{
+			break;
+		}
+		block_index = bench_handle_worker_get_next_block_index(
+		               worker );
+
+		if( bench_handle_get_block_offset(
+		     bench_handle,
+		     block_index,
+		     &offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve offset of block: %" PRIu64 ".",
+			 function,
+			 block_index );
+
+			goto on_error;
+		}
+		start_timestamp = bench_handle_get_timestamp();
+
+		read_count = libphdi_handle_read_buffer_at_offset(
+		              worker->input_handle,
+		              buffer,
+		              bench_handle->block_size,
+		              offset,
+		              error );
+
+		worker->latencies[ worker->number_of_latencies++ ] = bench_handle_get_timestamp() - start_timestamp;
+
+		if( read_count != (ssize_t) bench_handle->block_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read block: %" PRIu64 " at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 block_index,
+			 offset,
+			 offset );
+
+			goto on_error;
+		}
+		worker->number_of_bytes_read += (uint64_t) read_count;
+	}
+	memory_free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+/* Reads the blocks of a worker using asynchronous reads
+ * The user data of an asynchronous read is the index of its buffer slot
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_worker_read_asynchronous(
+     bench_handle_worker_t *worker,
+     libcerror_error_t **error )
+{
+	bench_handle_t *bench_handle = NULL;
+	uint64_t *start_timestamps   = NULL;
+	uint8_t *buffers             = NULL;
+	int *free_slots              = NULL;
+	static char *function        = "bench_handle_worker_read_asynchronous";
+	intptr_t user_data           = 0;
+	ssize_t read_count           = 0;
+	off64_t offset               = 0;
+	uint64_t block_index         = 0;
+	uint64_t number_of_submitted = 0;
+	int number_of_free_slots     = 0;
+	int number_of_outstanding    = 0;
+	int result                   = 0;
+	int slot_index               = 0;
+
+	if( worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle = worker->bench_handle;
+
+	buffers = (uint8_t *) memory_allocate(
+	                       sizeof( uint8_t ) * bench_handle->block_size * bench_handle->queue_depth );
+
+	if( buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffers.",
+		 function );
+
+		goto on_error;
+	}
+	start_timestamps = (uint64_t *) memory_allocate(
+	                                 sizeof( uint64_t ) * bench_handle->queue_depth );
+
+	if( start_timestamps == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create start timestamps.",
+		 function );
+
+		goto on_error;
+	}
+	free_slots = (int *) memory_allocate(
+	                      sizeof( int ) * bench_handle->queue_depth );
+
+	if( free_slots == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create free slots.",
+		 function );
+
+		goto on_error;
+	}
+	for( slot_index = 0;
+	     slot_index < bench_handle->queue_depth;
+	     slot_index++ )
+	{
+		free_slots[ slot_index ] = bench_handle->queue_depth - 1 - slot_index;
+	}
+	number_of_free_slots = bench_handle->queue_depth;
+
+	for( ;; )
+	{
+		while( ( bench_handle->abort == 0 )
+		    && ( number_of_free_slots > 0 )
+		    && ( number_of_submitted < bench_handle->number_of_reads ) )
+		{
+			block_index = bench_handle_worker_get_next_block_index(
+			               worker );
+
+			if( bench_handle_get_block_offset(
+			     bench_handle,
+			     block_index,
+			     &offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve offset of block: %" PRIu64 ".",
+				 function,
+				 block_index );
+
+				goto on_error;
+			}
+			slot_index = free_slots[ number_of_free_slots - 1 ];
+
+			start_timestamps[ slot_index ] = bench_handle_get_timestamp();
+
+			result = libphdi_handle_submit_read_buffer_at_offset(
+			          worker->input_handle,
+			          &( buffers[ bench_handle->block_size * slot_index ] ),
+			          bench_handle->block_size,
+			          offset,
+			          (intptr_t) slot_index,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to submit read of block: %" PRIu64 " at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 block_index,
+				 offset,
+				 offset );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				/* The maximum number of outstanding reads of the handle was reached
+				 */
+				break;
+			}
+			number_of_free_slots--;
+			number_of_outstanding++;
+			number_of_submitted++;
+		}
+		if( number_of_outstanding == 0 )
+		{
+			if( ( bench_handle->abort != 0 )
+			 || ( number_of_submitted >= bench_handle->number_of_reads ) )
+			{
+				break;
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to submit read.",
+			 function );
+
+			goto on_error;
+		}
+		result = libphdi_handle_get_completed_read(
+		          worker->input_handle,
+		          1,
+		          &user_data,
+		          &read_count,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve completed read.",
+			 function );
+
+			goto on_error;
+		}
+		slot_index = (int) user_data;
+
+		if( ( slot_index < 0 )
+		 || ( slot_index >= bench_handle->queue_depth ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid slot index value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		worker->latencies[ worker->number_of_latencies++ ] = bench_handle_get_timestamp() - start_timestamps[ slot_index ];
+
+		free_slots[ number_of_free_slots++ ] = slot_index;
+
+		number_of_outstanding--;
+
+		if( read_count != (ssize_t) bench_handle->block_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read block.",
+			 function );
+
+			goto on_error;
+		}
+		worker->number_of_bytes_read += (uint64_t) read_count;
+	}
+	memory_free(
+	 free_slots );
+	memory_free(
+	 start_timestamps );
+	memory_free(
+	 buffers );
+
+	return( 1 );
+
+on_error:
+	/* Make sure no outstanding read references the buffers before they are freed
+	 */
+	while( number_of_outstanding > 0 )
+	{
+		if( libphdi_handle_get_completed_read(
+		     worker->input_handle,
+		     1,
+		     &user_data,
+		     &read_count,
+		     NULL ) != 1 )
+		{
+			break;
+		}
+		number_of_outstanding--;
+	}
+	if( free_slots != NULL )
+	{
+		memory_free(
+		 free_slots );
+	}
+	if( start_timestamps != NULL )
+	{
+		memory_free(
+		 start_timestamps );
+	}
+	if( buffers != NULL )
+	{
+		memory_free(
+		 buffers );
+	}
+	return( -1 );
+}
+
+/* Runs a worker
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_worker_run(
+     void *arguments )
+{
+	bench_handle_worker_t *worker = NULL;
+
+	if( arguments == NULL )
+	{
+		return( -1 );
+	}
+	worker = (bench_handle_worker_t *) arguments;
+
+	if( worker->bench_handle->queue_depth > 1 )
+	{
+		worker->result = bench_handle_worker_read_asynchronous(
+		                  worker,
+		                  &( worker->error ) );
+	}
+	else
+	{
+		worker->result = bench_handle_worker_read_synchronous(
+		                  worker,
+		                  &( worker->error ) );
+	}
+	return( worker->result );
+}
+
+/* Compares two latencies
+ * Returns -1 if the first latency is smaller, 1 if it is larger or 0 if they are equal
+ */
+int bench_handle_compare_latencies(
+     const void *first_latency,
+     const void *second_latency )
+{
+	uint64_t first_value  = *( (const uint64_t *) first_latency );
+	uint64_t second_value = *( (const uint64_t *) second_latency );
+
+	if( first_value < second_value )
+	{
+		return( -1 );
+	}
+	else if( first_value > second_value )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the latency of a percentile
+ * The percentile is expressed in hundredths of a percent, for example 9990 for the 99.9th percentile
+ * Returns the latency in nanoseconds
+ */
+uint64_t bench_handle_get_percentile_latency(
+          const uint64_t *latencies,
+          uint64_t number_of_latencies,
+          uint64_t percentile )
+{
+	uint64_t latency_index = 0;
+
+	if( ( latencies == NULL )
+	 || ( number_of_latencies == 0 ) )
+	{
+		return( 0 );
+	}
+	/* Use the nearest-rank method: ceil( percentile * number_of_latencies ) - 1
+	 */
+	latency_index = ( ( percentile * number_of_latencies ) + 9999 ) / 10000;
+
+	if( latency_index > 0 )
+	{
+		latency_index -= 1;
+	}
+	if( latency_index >= number_of_latencies )
+	{
+		latency_index = number_of_latencies - 1;
+	}
+	return( latencies[ latency_index ] );
+}
+
+/* Retrieves the string of the access pattern
+ * Returns the string
+ */
+const char *bench_handle_get_access_pattern_string(
+             int access_pattern )
+{
+	switch( access_pattern )
+	{
+		case BENCH_HANDLE_ACCESS_PATTERN_RANDOM:
+			return( "random" );
+
+		case BENCH_HANDLE_ACCESS_PATTERN_SEQUENTIAL:
+			return( "sequential" );
+
+		case BENCH_HANDLE_ACCESS_PATTERN_ZIPFIAN:
+			return( "zipfian" );
+
+		default:
+			break;
+	}
+	return( "unknown" );
+}
+
+/* Retrieves the string of the offset selection
+ * Returns the string
+ */
+const char *bench_handle_get_offset_selection_string(
+             int offset_selection )
+{
+	switch( offset_selection )
+	{
+		case BENCH_HANDLE_OFFSET_SELECTION_ALL:
+			return( "all" );
+
+		case BENCH_HANDLE_OFFSET_SELECTION_CURRENT_SNAPSHOT:
+			return( "current" );
+
+		case BENCH_HANDLE_OFFSET_SELECTION_PARENT_SNAPSHOTS:
+			return( "parent" );
+
+		default:
+			break;
+	}
+	return( "unknown" );
+}
+
+/* Prints the results
+ * The latencies must be sorted in ascending order
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_results_fprint(
+     bench_handle_t *bench_handle,
+     const uint64_t *latencies,
+     uint64_t number_of_latencies,
+     uint64_t number_of_bytes_read,
+     libcerror_error_t **error )
+{
+	static char *function          = "bench_handle_results_fprint";
+	double elapsed_seconds         = 0.0;
+	double input_output_per_second = 0.0;
+	double mebibytes_per_second    = 0.0;
+	uint64_t latency_maximum       = 0;
+	uint64_t latency_minimum       = 0;
+	uint64_t latency_p50           = 0;
+	uint64_t latency_p99           = 0;
+	uint64_t latency_p999          = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( latencies == NULL )
+	 && ( number_of_latencies > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid latencies.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_latencies > 0 )
+	{
+		latency_minimum = latencies[ 0 ];
+		latency_maximum = latencies[ number_of_latencies - 1 ];
+	}
+	latency_p50  = bench_handle_get_percentile_latency(
+	                latencies,
+	                number_of_latencies,
+	                5000 );
+	latency_p99  = bench_handle_get_percentile_latency(
+	                latencies,
+	                number_of_latencies,
+	                9900 );
+	latency_p999 = bench_handle_get_percentile_latency(
+	                latencies,
+	                number_of_latencies,
+	                9990 );
+
+	elapsed_seconds = (double) bench_handle->elapsed_time / 1000000000.0;
+
+	if( elapsed_seconds > 0.0 )
+	{
+		mebibytes_per_second    = ( (double) number_of_bytes_read / ( 1024.0 * 1024.0 ) ) / elapsed_seconds;
+		input_output_per_second = (double) number_of_latencies / elapsed_seconds;
+	}
+	if( bench_handle->output_format == BENCH_HANDLE_OUTPUT_FORMAT_JSON )
+	{
+		fprintf(
+		 bench_handle->notify_stream,
+		 "{\"access_pattern\": \"%s\", \"offset_selection\": \"%s\", \"block_size\": %" PRIzd ", \"number_of_threads\": %d, \"queue_depth\": %d, \"seed\": %" PRIu64 ", ",
+		 bench_handle_get_access_pattern_string(
+		  bench_handle->access_pattern ),
+		 bench_handle_get_offset_selection_string(
+		  bench_handle->offset_selection ),
+		 bench_handle->block_size,
+		 bench_handle->number_of_threads,
+		 bench_handle->queue_depth,
+		 bench_handle->seed );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\"number_of_reads\": %" PRIu64 ", \"number_of_bytes_read\": %" PRIu64 ", \"elapsed_time\": %.6f, \"throughput\": %.2f, \"iops\": %.2f, ",
+		 number_of_latencies,
+		 number_of_bytes_read,
+		 elapsed_seconds,
+		 mebibytes_per_second,
+		 input_output_per_second );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\"latency\": {\"minimum\": %" PRIu64 ", \"p50\": %" PRIu64 ", \"p99\": %" PRIu64 ", \"p999\": %" PRIu64 ", \"maximum\": %" PRIu64 "}}\n",
+		 latency_minimum,
+		 latency_p50,
+		 latency_p99,
+		 latency_p999,
+		 latency_maximum );
+	}
+	else
+	{
+		fprintf(
+		 bench_handle->notify_stream,
+		 "Parallels Hard Disk image read benchmark:\n" );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tAccess pattern\t\t: %s\n",
+		 bench_handle_get_access_pattern_string(
+		  bench_handle->access_pattern ) );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tOffset selection\t: %s\n",
+		 bench_handle_get_offset_selection_string(
+		  bench_handle->offset_selection ) );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tBlock size\t\t: %" PRIzd " bytes\n",
+		 bench_handle->block_size );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tNumber of threads\t: %d\n",
+		 bench_handle->number_of_threads );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tQueue depth\t\t: %d\n",
+		 bench_handle->queue_depth );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tSeed\t\t\t: %" PRIu64 "\n",
+		 bench_handle->seed );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\n" );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tNumber of reads\t\t: %" PRIu64 "\n",
+		 number_of_latencies );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tNumber of bytes read\t: %" PRIu64 "\n",
+		 number_of_bytes_read );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tElapsed time\t\t: %.6f seconds\n",
+		 elapsed_seconds );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tThroughput\t\t: %.2f MiB/s\n",
+		 mebibytes_per_second );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tIOPS\t\t\t: %.2f\n",
+		 input_output_per_second );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\n" );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tLatency minimum\t\t: %" PRIu64 " ns\n",
+		 latency_minimum );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tLatency p50\t\t: %" PRIu64 " ns\n",
+		 latency_p50 );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tLatency p99\t\t: %" PRIu64 " ns\n",
+		 latency_p99 );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tLatency p99.9\t\t: %" PRIu64 " ns\n",
+		 latency_p999 );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tLatency maximum\t\t: %" PRIu64 " ns\n",
+		 latency_maximum );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\n" );
+	}
+	return( 1 );
+}
+
+/* Frees the workers
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_free_workers(
+     bench_handle_t *bench_handle,
+     bench_handle_worker_t **workers,
+     libcerror_error_t **error )
+{
+	bench_handle_worker_t *worker = NULL;
+	static char *function         = "bench_handle_free_workers";
+	int result                    = 1;
+	int worker_index              = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( workers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid workers.",
+		 function );
+
+		return( -1 );
+	}
+	if( *workers == NULL )
+	{
+		return( 1 );
+	}
+	for( worker_index = 0;
+	     worker_index < bench_handle->number_of_threads;
+	     worker_index++ )
+	{
+		worker = &( ( *workers )[ worker_index ] );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( worker->thread != NULL )
+		{
+			if( libcthreads_thread_join(
+			     &( worker->thread ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread of worker: %d.",
+				 function,
+				 worker_index );
+
+				result = -1;
+			}
+		}
+#endif
+		if( ( worker->input_handle != NULL )
+		 && ( worker->input_handle != bench_handle->input_handle ) )
+		{
+			if( libphdi_handle_close(
+			     worker->input_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close input handle of worker: %d.",
+				 function,
+				 worker_index );
+
+				result = -1;
+			}
+			if( libphdi_handle_free(
+			     &( worker->input_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input handle of worker: %d.",
+				 function,
+				 worker_index );
+
+				result = -1;
+			}
+		}
+		if( worker->error != NULL )
+		{
+			libcerror_error_free(
+			 &( worker->error ) );
+		}
+		if( worker->latencies != NULL )
+		{
+			memory_free(
+			 worker->latencies );
+		}
+	}
+	memory_free(
+	 *workers );
+
+	*workers = NULL;
+
+	return( result );
+}
+
+/* Runs the benchmark
+ * Every worker reads the number of reads, where a queue depth of 1 uses
+ * synchronous reads of the shared input handle and a larger queue depth
+ * uses asynchronous reads of an input handle per worker
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int bench_handle_run(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	bench_handle_worker_t *worker  = NULL;
+	bench_handle_worker_t *workers = NULL;
+	uint64_t *latencies            = NULL;
+	static char *function          = "bench_handle_run";
+	uint64_t number_of_bytes_read  = 0;
+	uint64_t number_of_latencies   = 0;
+	uint64_t start_timestamp       = 0;
+	int worker_index               = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->number_of_blocks == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid benchmark handle - missing blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bench_handle->number_of_threads <= 0 )
+	 || ( bench_handle->number_of_threads > BENCH_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid benchmark handle - number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	workers = (bench_handle_worker_t *) memory_allocate(
+	                                     sizeof( bench_handle_worker_t ) * bench_handle->number_of_threads );
+
+	if( workers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create workers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     workers,
+	     0,
+	     sizeof( bench_handle_worker_t ) * bench_handle->number_of_threads ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear workers.",
+		 function );
+
+		memory_free(
+		 workers );
+
+		return( -1 );
+	}
+	if( bench_handle->access_pattern == BENCH_HANDLE_ACCESS_PATTERN_ZIPFIAN )
+	{
+		bench_handle_zipfian_initialize(
+		 bench_handle );
+	}
+	for( worker_index = 0;
+	     worker_index < bench_handle->number_of_threads;
+	     worker_index++ )
+	{
+		worker = &( workers[ worker_index ] );
+
+		worker->bench_handle           = bench_handle;
+		worker->worker_index           = worker_index;
+		worker->random_state           = bench_handle->seed + ( (uint64_t) worker_index << 32 );
+		worker->sequential_block_index = ( bench_handle->number_of_blocks / bench_handle->number_of_threads ) * worker_index;
+
+		worker->latencies = (uint64_t *) memory_allocate(
+		                                  sizeof( uint64_t ) * bench_handle->number_of_reads );
+
+		if( worker->latencies == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create latencies of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		if( bench_handle->queue_depth > 1 )
+		{
+			/* The asynchronous reads are retrieved per handle hence every worker needs its own handle
+			 */
+			if( libphdi_handle_initialize(
+			     &( worker->input_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize input handle of worker: %d.",
+				 function,
+				 worker_index );
+
+				goto on_error;
+			}
+			if( bench_handle_open_input_handle(
+			     worker->input_handle,
+			     bench_handle->filename,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open input handle of worker: %d.",
+				 function,
+				 worker_index );
+
+				libphdi_handle_free(
+				 &( worker->input_handle ),
+				 NULL );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			worker->input_handle = bench_handle->input_handle;
+		}
+	}
+	start_timestamp = bench_handle_get_timestamp();
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( bench_handle->number_of_threads > 1 )
+	{
+		for( worker_index = 0;
+		     worker_index < bench_handle->number_of_threads;
+		     worker_index++ )
+		{
+			worker = &( workers[ worker_index ] );
+
+			if( libcthreads_thread_create(
+			     &( worker->thread ),
+			     NULL,
+			     &bench_handle_worker_run,
+			     (void *) worker,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create thread of worker: %d.",
+				 function,
+				 worker_index );
+
+				bench_handle->abort = 1;
+
+				goto on_error;
+			}
+		}
+		for( worker_index = 0;
+		     worker_index < bench_handle->number_of_threads;
+		     worker_index++ )
+		{
+			worker = &( workers[ worker_index ] );
+
+			if( libcthreads_thread_join(
+			     &( worker->thread ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread of worker: %d.",
+				 function,
+				 worker_index );
+
+				bench_handle->abort = 1;
+
+				goto on_error;
+			}
+		}
+	}
+	else
+#endif
+	{
+		bench_handle_worker_run(
+		 (void *) &( workers[ 0 ] ) );
+	}
+	bench_handle->elapsed_time = bench_handle_get_timestamp() - start_timestamp;
+
+	for( worker_index = 0;
+	     worker_index < bench_handle->number_of_threads;
+	     worker_index++ )
+	{
+		worker = &( workers[ worker_index ] );
+
+		if( worker->result != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 worker->error );
+
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: worker: %d failed.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		number_of_latencies  += worker->number_of_latencies;
+		number_of_bytes_read += worker->number_of_bytes_read;
+	}
+	if( number_of_latencies > 0 )
+	{
+		latencies = (uint64_t *) memory_allocate(
+		                          sizeof( uint64_t ) * number_of_latencies );
+
+		if( latencies == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create latencies.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_latencies = 0;
+
+		for( worker_index = 0;
+		     worker_index < bench_handle->number_of_threads;
+		     worker_index++ )
+		{
+			worker = &( workers[ worker_index ] );
+
+			if( memory_copy(
+			     &( latencies[ number_of_latencies ] ),
+			     worker->latencies,
+			     sizeof( uint64_t ) * worker->number_of_latencies ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy latencies of worker: %d.",
+				 function,
+				 worker_index );
+
+				goto on_error;
+			}
+			number_of_latencies += worker->number_of_latencies;
+		}
+		qsort(
+		 latencies,
+		 (size_t) number_of_latencies,
+		 sizeof( uint64_t ),
+		 &bench_handle_compare_latencies );
+	}
+	if( bench_handle_free_workers(
+	     bench_handle,
+	     &workers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free workers.",
+		 function );
+
+		goto on_error;
+	}
+	if( bench_handle_results_fprint(
+	     bench_handle,
+	     latencies,
+	     number_of_latencies,
+	     number_of_bytes_read,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print results.",
+		 function );
+
+		goto on_error;
+	}
+	if( latencies != NULL )
+	{
+		memory_free(
+		 latencies );
+	}
+	if( bench_handle->abort != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+	if( latencies != NULL )
+	{
+		memory_free(
+		 latencies );
+	}
+	if( workers != NULL )
+	{
+		bench_handle_free_workers(
+		 bench_handle,
+		 &workers,
+		 NULL );
+	}
+	return( -1 );
+}
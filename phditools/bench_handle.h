@@ -0,0 +1,374 @@
+/*
+ * Benchmark handle
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BENCH_HANDLE_H )
+#define _BENCH_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "phditools_libcerror.h"
+#include "phditools_libcthreads.h"
+#include "phditools_libphdi.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+enum BENCH_HANDLE_ACCESS_PATTERNS
+{
+	BENCH_HANDLE_ACCESS_PATTERN_SEQUENTIAL	= (int) 's',
+	BENCH_HANDLE_ACCESS_PATTERN_RANDOM	= (int) 'r',
+	BENCH_HANDLE_ACCESS_PATTERN_ZIPFIAN	= (int) 'z'
+};
+
+enum BENCH_HANDLE_OFFSET_SELECTIONS
+{
+	BENCH_HANDLE_OFFSET_SELECTION_ALL		= (int) 'a',
+	BENCH_HANDLE_OFFSET_SELECTION_CURRENT_SNAPSHOT	= (int) 'c',
+	BENCH_HANDLE_OFFSET_SELECTION_PARENT_SNAPSHOTS	= (int) 'p'
+};
+
+enum BENCH_HANDLE_OUTPUT_FORMATS
+{
+	BENCH_HANDLE_OUTPUT_FORMAT_JSON		= (int) 'j',
+	BENCH_HANDLE_OUTPUT_FORMAT_TEXT		= (int) 't'
+};
+
+typedef struct bench_handle_range bench_handle_range_t;
+
+struct bench_handle_range
+{
+	/* The (media) offset
+	 */
+	off64_t offset;
+
+	/* The index of the first block in the range
+	 */
+	uint64_t first_block_index;
+
+	/* The number of blocks in the range
+	 */
+	uint64_t number_of_blocks;
+};
+
+typedef struct bench_handle bench_handle_t;
+
+typedef struct bench_handle_worker bench_handle_worker_t;
+
+struct bench_handle_worker
+{
+	/* The benchmark handle
+	 */
+	bench_handle_t *bench_handle;
+
+	/* The input handle, which is either shared or owned by the worker
+	 */
+	libphdi_handle_t *input_handle;
+
+	/* The worker index
+	 */
+	int worker_index;
+
+	/* The pseudo random number generator state
+	 */
+	uint64_t random_state;
+
+	/* The next block index of the sequential access pattern
+	 */
+	uint64_t sequential_block_index;
+
+	/* The read latencies in nanoseconds
+	 */
+	uint64_t *latencies;
+
+	/* The number of latencies
+	 */
+	uint64_t number_of_latencies;
+
+	/* The number of bytes read
+	 */
+	uint64_t number_of_bytes_read;
+
+	/* The result of the worker
+	 */
+	int result;
+
+	/* The error of the worker
+	 */
+	libcerror_error_t *error;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The worker thread
+	 */
+	libcthreads_thread_t *thread;
+#endif
+};
+
+struct bench_handle
+{
+	/* The filename of the input
+	 */
+	const system_character_t *filename;
+
+	/* The input handle
+	 */
+	libphdi_handle_t *input_handle;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The access pattern
+	 */
+	int access_pattern;
+
+	/* The offset selection
+	 */
+	int offset_selection;
+
+	/* The output format
+	 */
+	int output_format;
+
+	/* The block size
+	 */
+	size_t block_size;
+
+	/* The number of reads per thread
+	 */
+	uint64_t number_of_reads;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The queue depth per thread
+	 */
+	int queue_depth;
+
+	/* The seed of the pseudo random number generator
+	 */
+	uint64_t seed;
+
+	/* The ranges of the offsets to read
+	 */
+	bench_handle_range_t *ranges;
+
+	/* The number of ranges
+	 */
+	int number_of_ranges;
+
+	/* The number of blocks in the ranges
+	 */
+	uint64_t number_of_blocks;
+
+	/* The integral of the hat function of the zipfian distribution at the first rank
+	 */
+	double zipfian_h_integral_x1;
+
+	/* The integral of the hat function of the zipfian distribution at the last rank
+	 */
+	double zipfian_h_integral_number_of_blocks;
+
+	/* The rejection threshold of the zipfian distribution
+	 */
+	double zipfian_s;
+
+	/* The elapsed time in nanoseconds
+	 */
+	uint64_t elapsed_time;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int bench_handle_initialize(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_free(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_signal_abort(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_copy_decimal_string_to_64_bit(
+     const system_character_t *string,
+     uint64_t *value,
+     libcerror_error_t **error );
+
+int bench_handle_set_access_pattern(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_offset_selection(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_output_format(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_block_size(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_number_of_reads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_number_of_threads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_queue_depth(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_seed(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_open_input_handle(
+     libphdi_handle_t *input_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int bench_handle_append_range(
+     bench_handle_t *bench_handle,
+     off64_t range_offset,
+     size64_t range_size,
+     libcerror_error_t **error );
+
+int bench_handle_determine_ranges(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_open_input(
+     bench_handle_t *bench_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int bench_handle_close(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_get_block_offset(
+     bench_handle_t *bench_handle,
+     uint64_t block_index,
+     off64_t *offset,
+     libcerror_error_t **error );
+
+uint64_t bench_handle_get_timestamp(
+          void );
+
+uint64_t bench_handle_worker_get_random(
+          bench_handle_worker_t *worker );
+
+double bench_handle_zipfian_helper1(
+        double x );
+
+double bench_handle_zipfian_helper2(
+        double x );
+
+double bench_handle_zipfian_h_integral(
+        double x );
+
+double bench_handle_zipfian_h(
+        double x );
+
+double bench_handle_zipfian_h_integral_inverse(
+        double x );
+
+void bench_handle_zipfian_initialize(
+      bench_handle_t *bench_handle );
+
+uint64_t bench_handle_worker_get_zipfian_rank(
+          bench_handle_worker_t *worker );
+
+uint64_t bench_handle_worker_get_next_block_index(
+          bench_handle_worker_t *worker );
+
+int bench_handle_worker_read_synchronous(
+     bench_handle_worker_t *worker,
+     libcerror_error_t **error );
+
+int bench_handle_worker_read_asynchronous(
+     bench_handle_worker_t *worker,
+     libcerror_error_t **error );
+
+int bench_handle_worker_run(
+     void *arguments );
+
+int bench_handle_compare_latencies(
+     const void *first_latency,
+     const void *second_latency );
+
+uint64_t bench_handle_get_percentile_latency(
+          const uint64_t *latencies,
+          uint64_t number_of_latencies,
+          uint64_t percentile );
+
+const char *bench_handle_get_access_pattern_string(
+             int access_pattern );
+
+const char *bench_handle_get_offset_selection_string(
+             int offset_selection );
+
+int bench_handle_results_fprint(
+     bench_handle_t *bench_handle,
+     const uint64_t *latencies,
+     uint64_t number_of_latencies,
+     uint64_t number_of_bytes_read,
+     libcerror_error_t **error );
+
+int bench_handle_free_workers(
+     bench_handle_t *bench_handle,
+     bench_handle_worker_t **workers,
+     libcerror_error_t **error );
+
+int bench_handle_run(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BENCH_HANDLE_H ) */
+
@@ -0,0 +1,2670 @@
+/*
+ * Generate handle
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#include "byte_size_string.h"
+#include "generate_handle.h"
+#include "phditools_libcerror.h"
+#include "phditools_libcfile.h"
+#include "phditools_libcpath.h"
+
+#define GENERATE_HANDLE_NOTIFY_STREAM				stdout
+
+#define GENERATE_HANDLE_MAXIMUM_BLOCK_SIZE			( 64 * 1024 * 1024 )
+#define GENERATE_HANDLE_MAXIMUM_NUMBER_OF_EXTENTS		4096
+#define GENERATE_HANDLE_MAXIMUM_NUMBER_OF_SNAPSHOTS		256
+
+/* The number of block allocation table entries written at once
+ */
+#define GENERATE_HANDLE_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES	16384
+
+/* The size of the name of the storage data image file, which is formatted as:
+ * harddisk.hdd.<extent>.{<GUID>}.hds
+ */
+#define GENERATE_HANDLE_IMAGE_FILENAME_SIZE			64
+
+/* The size of a GUID string with surrounding braces including the end-of-string character
+ */
+#define GENERATE_HANDLE_IDENTIFIER_STRING_SIZE			39
+
+const uint8_t generate_handle_sparse_image_signature[ 16 ] = {
+	'W', 'i', 't', 'h', 'o', 'u', 't', 'F', 'r', 'e', 'e', 'S', 'p', 'a', 'c', 'e' };
+
+const uint8_t generate_handle_block_stamp_signature[ 4 ] = {
+	'P', 'H', 'D', 'G' };
+
+/* Creates a generate handle
+ * Make sure the value generate_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_initialize(
+     generate_handle_t **generate_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_initialize";
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *generate_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid generate handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*generate_handle = memory_allocate_structure(
+	                    generate_handle_t );
+
+	if( *generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create generate handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *generate_handle,
+	     0,
+	     sizeof( generate_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear generate handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *generate_handle )->disk_type           = GENERATE_HANDLE_DISK_TYPE_EXPANDING;
+	( *generate_handle )->media_size          = 64 * 1024 * 1024;
+	( *generate_handle )->block_size          = 1024 * 1024;
+	( *generate_handle )->number_of_extents   = 1;
+	( *generate_handle )->number_of_snapshots = 1;
+	( *generate_handle )->allocation_density  = 50;
+	( *generate_handle )->snapshot_density    = 10;
+	( *generate_handle )->seed                = 1;
+	( *generate_handle )->notify_stream       = GENERATE_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *generate_handle != NULL )
+	{
+		memory_free(
+		 *generate_handle );
+
+		*generate_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a generate handle
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_free(
+     generate_handle_t **generate_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_free";
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *generate_handle != NULL )
+	{
+		memory_free(
+		 *generate_handle );
+
+		*generate_handle = NULL;
+	}
+	return( 1 );
+}
+
+/* Signals the generate handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_signal_abort(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_signal_abort";
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	generate_handle->abort = 1;
+
+	return( 1 );
+}
+
+/* Copies a decimal string to an unsigned 64-bit value
+ * Returns 1 if successful, 0 if the string is not a decimal value or -1 on error
+ */
+int generate_handle_copy_decimal_string_to_64_bit(
+     const system_character_t *string,
+     uint64_t *value,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_copy_decimal_string_to_64_bit";
+	size_t string_index   = 0;
+	uint64_t safe_value   = 0;
+	uint8_t digit         = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] == 0 )
+	{
+		return( 0 );
+	}
+	for( string_index = 0;
+	     string[ string_index ] != 0;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] < (system_character_t) '0' )
+		 || ( string[ string_index ] > (system_character_t) '9' ) )
+		{
+			return( 0 );
+		}
+		digit = (uint8_t) ( string[ string_index ] - (system_character_t) '0' );
+
+		if( safe_value > ( ( UINT64_MAX - digit ) / 10 ) )
+		{
+			return( 0 );
+		}
+		safe_value = ( safe_value * 10 ) + digit;
+	}
+	*value = safe_value;
+
+	return( 1 );
+}
+
+/* Sets the block size
+ * The block size must be a multiple of 512
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_block_size(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_block_size";
+	size_t string_length  = 0;
+	uint64_t size_value   = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( byte_size_string_convert(
+	     string,
+	     string_length,
+	     &size_value,
+	     NULL ) != 1 )
+	{
+		return( 0 );
+	}
+	if( ( size_value == 0 )
+	 || ( size_value > (uint64_t) GENERATE_HANDLE_MAXIMUM_BLOCK_SIZE )
+	 || ( ( size_value % 512 ) != 0 ) )
+	{
+		return( 0 );
+	}
+	generate_handle->block_size = (size64_t) size_value;
+
+	return( 1 );
+}
+
+/* Sets the media size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_media_size(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_media_size";
+	size_t string_length  = 0;
+	uint64_t size_value   = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( byte_size_string_convert(
+	     string,
+	     string_length,
+	     &size_value,
+	     NULL ) != 1 )
+	{
+		return( 0 );
+	}
+	if( ( size_value == 0 )
+	 || ( size_value > (uint64_t) INT64_MAX ) )
+	{
+		return( 0 );
+	}
+	generate_handle->media_size = (size64_t) size_value;
+
+	return( 1 );
+}
+
+/* Sets the disk type
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_disk_type(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_disk_type";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 5 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "fixed" ),
+		     5 ) == 0 )
+		{
+			generate_handle->disk_type = GENERATE_HANDLE_DISK_TYPE_FIXED;
+			result                     = 1;
+		}
+	}
+	else if( string_length == 9 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "expanding" ),
+		     9 ) == 0 )
+		{
+			generate_handle->disk_type = GENERATE_HANDLE_DISK_TYPE_EXPANDING;
+			result                     = 1;
+		}
+	}
+	return( result );
+}
+
+/* Sets the number of extents
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_number_of_extents(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_number_of_extents";
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = generate_handle_copy_decimal_string_to_64_bit(
+	          string,
+	          &value_64bit,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit value.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( ( value_64bit == 0 )
+		 || ( value_64bit > (uint64_t) GENERATE_HANDLE_MAXIMUM_NUMBER_OF_EXTENTS ) )
+		{
+			return( 0 );
+		}
+		generate_handle->number_of_extents = (int) value_64bit;
+	}
+	return( result );
+}
+
+/* Sets the number of snapshots
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_number_of_snapshots(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_number_of_snapshots";
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = generate_handle_copy_decimal_string_to_64_bit(
+	          string,
+	          &value_64bit,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit value.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( ( value_64bit == 0 )
+		 || ( value_64bit > (uint64_t) GENERATE_HANDLE_MAXIMUM_NUMBER_OF_SNAPSHOTS ) )
+		{
+			return( 0 );
+		}
+		generate_handle->number_of_snapshots = (int) value_64bit;
+	}
+	return( result );
+}
+
+/* Copies a percentage string to a value
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_percentage(
+     const system_character_t *string,
+     uint8_t *percentage,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_percentage";
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( percentage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid percentage.",
+		 function );
+
+		return( -1 );
+	}
+	result = generate_handle_copy_decimal_string_to_64_bit(
+	          string,
+	          &value_64bit,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit value.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( value_64bit > 100 )
+		{
+			return( 0 );
+		}
+		*percentage = (uint8_t) value_64bit;
+	}
+	return( result );
+}
+
+/* Sets the percentage of blocks stored in the base image
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_allocation_density(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_allocation_density";
+	int result            = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = generate_handle_set_percentage(
+	          string,
+	          &( generate_handle->allocation_density ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set allocation density.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Sets the percentage of blocks stored in every snapshot other than the base image
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_snapshot_density(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_snapshot_density";
+	int result            = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = generate_handle_set_percentage(
+	          string,
+	          &( generate_handle->snapshot_density ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set snapshot density.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Sets the percentage of stored blocks that is moved to a random physical position
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_fragmentation(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_fragmentation";
+	int result            = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = generate_handle_set_percentage(
+	          string,
+	          &( generate_handle->fragmentation ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set fragmentation.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Sets the seed
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_seed(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_seed";
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = generate_handle_copy_decimal_string_to_64_bit(
+	          string,
+	          &value_64bit,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit value.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		generate_handle->seed = value_64bit;
+	}
+	return( result );
+}
+
+/* Retrieves a pseudo random value
+ * The value is mixed using the splitmix64 finalizer, hence the same input
+ * always results in the same pseudo random value across platforms
+ * Returns the pseudo random value
+ */
+uint64_t generate_handle_get_random_value(
+          uint64_t value )
+{
+	value += 0x9e3779b97f4a7c15ULL;
+	value  = ( value ^ ( value >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+	value  = ( value ^ ( value >> 27 ) ) * 0x94d049bb133111ebULL;
+
+	return( value ^ ( value >> 31 ) );
+}
+
+/* Determines if a block is stored in a specific snapshot
+ * Whether a block is stored is derived from the seed, the snapshot index and the block index,
+ * hence it can be determined without keeping an allocation map in memory
+ * Returns 1 if the block is stored or 0 if not
+ */
+int generate_handle_block_is_stored(
+     generate_handle_t *generate_handle,
+     int snapshot_index,
+     uint64_t block_index )
+{
+	uint64_t random_value = 0;
+	uint8_t density       = 0;
+
+	if( snapshot_index == 0 )
+	{
+		density = generate_handle->allocation_density;
+	}
+	else
+	{
+		density = generate_handle->snapshot_density;
+	}
+	random_value = generate_handle_get_random_value(
+	                generate_handle->seed
+	                ^ ( (uint64_t) snapshot_index << 48 )
+	                ^ generate_handle_get_random_value(
+	                   block_index ) );
+
+	if( ( random_value % 100 ) < density )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the index of the snapshot that a read of the block is resolved from
+ * Returns 1 if successful, 0 if the block is sparse or -1 on error
+ */
+int generate_handle_get_block_snapshot_index(
+     generate_handle_t *generate_handle,
+     uint64_t block_index,
+     int *snapshot_index,
+     libcerror_error_t **error )
+{
+	static char *function   = "generate_handle_get_block_snapshot_index";
+	int safe_snapshot_index = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( snapshot_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid snapshot index.",
+		 function );
+
+		return( -1 );
+	}
+	/* The plain storage data image file of the current snapshot contains all the data
+	 * of a fixed disk, hence the parent snapshots are never read
+	 */
+	for( safe_snapshot_index = generate_handle->number_of_snapshots - 1;
+	     safe_snapshot_index >= 0;
+	     safe_snapshot_index-- )
+	{
+		if( generate_handle_block_is_stored(
+		     generate_handle,
+		     safe_snapshot_index,
+		     block_index ) != 0 )
+		{
+			*snapshot_index = safe_snapshot_index;
+
+			return( 1 );
+		}
+		if( generate_handle->disk_type == GENERATE_HANDLE_DISK_TYPE_FIXED )
+		{
+			break;
+		}
+	}
+	return( 0 );
+}
+
+/* Retrieves the blocks of an extent
+ * The blocks are divided evenly over the extents, where the last extent contains the remainder
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_get_extent_range(
+     generate_handle_t *generate_handle,
+     int extent_index,
+     uint64_t *first_block_index,
+     uint64_t *number_of_blocks,
+     libcerror_error_t **error )
+{
+	static char *function                = "generate_handle_get_extent_range";
+	uint64_t number_of_blocks_per_extent = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_index < 0 )
+	 || ( extent_index >= generate_handle->number_of_extents ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first block index.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of blocks.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_blocks_per_extent = generate_handle->number_of_blocks / generate_handle->number_of_extents;
+
+	*first_block_index = number_of_blocks_per_extent * extent_index;
+
+	if( extent_index == ( generate_handle->number_of_extents - 1 ) )
+	{
+		*number_of_blocks = generate_handle->number_of_blocks - *first_block_index;
+	}
+	else
+	{
+		*number_of_blocks = number_of_blocks_per_extent;
+	}
+	return( 1 );
+}
+
+/* Retrieves the stamp of a block
+ * The stamp consists of the media offset of the block (8 bytes), the snapshot index (4 bytes)
+ * and the signature "PHDG" (4 bytes), all integers are stored in little-endian
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_get_block_stamp(
+     generate_handle_t *generate_handle,
+     uint64_t block_index,
+     int snapshot_index,
+     uint8_t *stamp,
+     size_t stamp_size,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_get_block_stamp";
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stamp.",
+		 function );
+
+		return( -1 );
+	}
+	if( stamp_size < GENERATE_HANDLE_BLOCK_STAMP_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid stamp size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 &( stamp[ 0 ] ),
+	 block_index * generate_handle->block_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( stamp[ 8 ] ),
+	 (uint32_t) snapshot_index );
+
+	if( memory_copy(
+	     &( stamp[ 12 ] ),
+	     generate_handle_block_stamp_signature,
+	     4 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the identifier of a snapshot
+ * The identifier is a version 4 GUID derived from the seed, where a snapshot index
+ * of -1 is used for the identifier of the disk
+ */
+void generate_handle_get_snapshot_identifier(
+      generate_handle_t *generate_handle,
+      int snapshot_index,
+      uint8_t *identifier )
+{
+	uint64_t random_value = 0;
+
+	random_value = generate_handle_get_random_value(
+	                generate_handle->seed ^ ( (uint64_t) ( snapshot_index + 1 ) << 32 ) );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( identifier[ 0 ] ),
+	 random_value );
+
+	random_value = generate_handle_get_random_value(
+	                random_value );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( identifier[ 8 ] ),
+	 random_value );
+
+	identifier[ 6 ] = ( identifier[ 6 ] & 0x0f ) | 0x40;
+	identifier[ 8 ] = ( identifier[ 8 ] & 0x3f ) | 0x80;
+}
+
+/* Copies an identifier to a GUID string with surrounding braces
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_copy_identifier_to_string(
+     const uint8_t *identifier,
+     char *string,
+     size_t string_size,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_copy_identifier_to_string";
+	int print_count       = 0;
+
+	if( identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size < GENERATE_HANDLE_IDENTIFIER_STRING_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid string size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	print_count = narrow_string_snprintf(
+	               string,
+	               string_size,
+	               "{%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x}",
+	               identifier[ 0 ], identifier[ 1 ], identifier[ 2 ], identifier[ 3 ],
+	               identifier[ 4 ], identifier[ 5 ],
+	               identifier[ 6 ], identifier[ 7 ],
+	               identifier[ 8 ], identifier[ 9 ],
+	               identifier[ 10 ], identifier[ 11 ], identifier[ 12 ], identifier[ 13 ], identifier[ 14 ], identifier[ 15 ] );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= string_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set string.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the name of the storage data image file of an extent in a snapshot
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_get_image_filename(
+     generate_handle_t *generate_handle,
+     int extent_index,
+     int snapshot_index,
+     char *filename,
+     size_t filename_size,
+     libcerror_error_t **error )
+{
+	char identifier_string[ GENERATE_HANDLE_IDENTIFIER_STRING_SIZE ];
+	uint8_t identifier[ 16 ];
+
+	static char *function = "generate_handle_get_image_filename";
+	int print_count       = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	generate_handle_get_snapshot_identifier(
+	 generate_handle,
+	 snapshot_index,
+	 identifier );
+
+	if( generate_handle_copy_identifier_to_string(
+	     identifier,
+	     identifier_string,
+	     GENERATE_HANDLE_IDENTIFIER_STRING_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy identifier to string.",
+		 function );
+
+		return( -1 );
+	}
+	print_count = narrow_string_snprintf(
+	               filename,
+	               filename_size,
+	               "harddisk.hdd.%d.%s.hds",
+	               extent_index,
+	               identifier_string );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= filename_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens a file in a directory for writing, the file is truncated if it exists
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_open_file(
+     const system_character_t *directory,
+     const char *filename,
+     libcfile_file_t **file,
+     libcerror_error_t **error )
+{
+	system_character_t *path = NULL;
+	static char *function    = "generate_handle_open_file";
+	size_t filename_length   = 0;
+	size_t path_size         = 0;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	wchar_t *wide_filename   = NULL;
+	size_t filename_index    = 0;
+#endif
+
+	if( directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = narrow_string_length(
+	                   filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	/* The generated filenames only contain ASCII characters
+	 */
+	wide_filename = wide_string_allocate(
+	                 filename_length + 1 );
+
+	if( wide_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create wide filename.",
+		 function );
+
+		goto on_error;
+	}
+	for( filename_index = 0;
+	     filename_index <= filename_length;
+	     filename_index++ )
+	{
+		wide_filename[ filename_index ] = (wchar_t) filename[ filename_index ];
+	}
+	if( libcpath_path_join_wide(
+	     &path,
+	     &path_size,
+	     directory,
+	     wide_string_length(
+	      directory ),
+	     wide_filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libcpath_path_join(
+	     &path,
+	     &path_size,
+	     directory,
+	     narrow_string_length(
+	      directory ),
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create path.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_initialize(
+	     file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcfile_file_open_wide(
+	     *file,
+	     path,
+	     LIBCFILE_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+#else
+	if( libcfile_file_open(
+	     *file,
+	     path,
+	     LIBCFILE_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %" PRIs_SYSTEM ".",
+		 function,
+		 path );
+
+		goto on_error;
+	}
+	memory_free(
+	 path );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	memory_free(
+	 wide_filename );
+#endif
+	return( 1 );
+
+on_error:
+	if( *file != NULL )
+	{
+		libcfile_file_free(
+		 file,
+		 NULL );
+	}
+	if( path != NULL )
+	{
+		memory_free(
+		 path );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( wide_filename != NULL )
+	{
+		memory_free(
+		 wide_filename );
+	}
+#endif
+	return( -1 );
+}
+
+/* Writes the stamp of a block at a specific file offset
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_write_block_stamp(
+     generate_handle_t *generate_handle,
+     libcfile_file_t *file,
+     off64_t file_offset,
+     uint64_t block_index,
+     int snapshot_index,
+     libcerror_error_t **error )
+{
+	uint8_t stamp[ GENERATE_HANDLE_BLOCK_STAMP_SIZE ];
+
+	static char *function = "generate_handle_write_block_stamp";
+	ssize_t write_count   = 0;
+
+	if( generate_handle_get_block_stamp(
+	     generate_handle,
+	     block_index,
+	     snapshot_index,
+	     stamp,
+	     GENERATE_HANDLE_BLOCK_STAMP_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve stamp of block: %" PRIu64 ".",
+		 function,
+		 block_index );
+
+		return( -1 );
+	}
+	if( libcfile_file_seek_offset(
+	     file,
+	     file_offset,
+	     SEEK_SET,
+	     error ) != file_offset )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	write_count = libcfile_file_write_buffer(
+	               file,
+	               stamp,
+	               GENERATE_HANDLE_BLOCK_STAMP_SIZE,
+	               error );
+
+	if( write_count != (ssize_t) GENERATE_HANDLE_BLOCK_STAMP_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write stamp of block: %" PRIu64 ".",
+		 function,
+		 block_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes a sparse (compressed) storage data image file
+ * The data of the stored blocks is not written, only the block stamps, the remainder of
+ * the blocks is left as a hole by resizing the file
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int generate_handle_write_sparse_image_file(
+     generate_handle_t *generate_handle,
+     libcfile_file_t *file,
+     int extent_index,
+     int snapshot_index,
+     libcerror_error_t **error )
+{
+	uint8_t file_header_data[ 64 ];
+
+	uint8_t *table_data              = NULL;
+	uint32_t *block_slots            = NULL;
+	static char *function            = "generate_handle_write_sparse_image_file";
+	size_t table_data_offset         = 0;
+	size_t table_data_size           = 0;
+	ssize_t write_count              = 0;
+	uint64_t block_index             = 0;
+	uint64_t data_start_sector       = 0;
+	uint64_t first_block_index       = 0;
+	uint64_t number_of_blocks        = 0;
+	uint64_t number_of_cylinders     = 0;
+	uint64_t number_of_sectors       = 0;
+	uint64_t number_of_stored_blocks = 0;
+	uint64_t random_state            = 0;
+	uint64_t sectors_per_block       = 0;
+	uint64_t slot_index              = 0;
+	uint64_t stored_block_index      = 0;
+	uint64_t swap_index              = 0;
+	uint32_t block_slot              = 0;
+	uint32_t table_entry             = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( generate_handle_get_extent_range(
+	     generate_handle,
+	     extent_index,
+	     &first_block_index,
+	     &number_of_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range of extent: %d.",
+		 function,
+		 extent_index );
+
+		goto on_error;
+	}
+	if( number_of_blocks > (uint64_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of blocks value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		if( generate_handle_block_is_stored(
+		     generate_handle,
+		     snapshot_index,
+		     first_block_index + block_index ) != 0 )
+		{
+			number_of_stored_blocks++;
+		}
+	}
+	sectors_per_block = generate_handle->block_size / 512;
+	number_of_sectors = number_of_blocks * sectors_per_block;
+
+	/* The data of the first block starts after the file header and block allocation table
+	 * on the next block boundary
+	 */
+	data_start_sector = 64 + ( number_of_blocks * 4 );
+	data_start_sector = ( data_start_sector + generate_handle->block_size - 1 ) / generate_handle->block_size;
+	data_start_sector = data_start_sector * sectors_per_block;
+
+	if( ( data_start_sector + ( number_of_stored_blocks * sectors_per_block ) ) > (uint64_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of stored blocks value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	/* The block slots map the stored blocks to their physical position in the file,
+	 * with fragmentation a part of the stored blocks is swapped with a random other slot
+	 */
+	if( number_of_stored_blocks > 0 )
+	{
+		block_slots = (uint32_t *) memory_allocate(
+		                            sizeof( uint32_t ) * (size_t) number_of_stored_blocks );
+
+		if( block_slots == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create block slots.",
+			 function );
+
+			goto on_error;
+		}
+		for( slot_index = 0;
+		     slot_index < number_of_stored_blocks;
+		     slot_index++ )
+		{
+			block_slots[ slot_index ] = (uint32_t) slot_index;
+		}
+		random_state = generate_handle_get_random_value(
+		                generate_handle->seed
+		                ^ ( (uint64_t) extent_index << 32 )
+		                ^ (uint64_t) snapshot_index );
+
+		for( slot_index = 0;
+		     slot_index < number_of_stored_blocks;
+		     slot_index++ )
+		{
+			random_state = generate_handle_get_random_value(
+			                random_state );
+
+			if( ( random_state % 100 ) >= generate_handle->fragmentation )
+			{
+				continue;
+			}
+			random_state = generate_handle_get_random_value(
+			                random_state );
+
+			swap_index = random_state % number_of_stored_blocks;
+
+			block_slot                = block_slots[ slot_index ];
+			block_slots[ slot_index ] = block_slots[ swap_index ];
+			block_slots[ swap_index ] = block_slot;
+		}
+	}
+	number_of_cylinders = number_of_sectors / ( 16 * 32 );
+
+	if( number_of_cylinders > (uint64_t) UINT32_MAX )
+	{
+		number_of_cylinders = UINT32_MAX;
+	}
+	if( memory_set(
+	     file_header_data,
+	     0,
+	     64 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file header data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     file_header_data,
+	     generate_handle_sparse_image_signature,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( file_header_data[ 16 ] ),
+	 2 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( file_header_data[ 20 ] ),
+	 16 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( file_header_data[ 24 ] ),
+	 (uint32_t) number_of_cylinders );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( file_header_data[ 28 ] ),
+	 (uint32_t) sectors_per_block );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( file_header_data[ 32 ] ),
+	 (uint32_t) number_of_blocks );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( file_header_data[ 36 ] ),
+	 number_of_sectors );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( file_header_data[ 48 ] ),
+	 (uint32_t) data_start_sector );
+
+	write_count = libcfile_file_write_buffer(
+	               file,
+	               file_header_data,
+	               64,
+	               error );
+
+	if( write_count != (ssize_t) 64 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header.",
+		 function );
+
+		goto on_error;
+	}
+	/* The block allocation table is written in chunks to bound the memory usage
+	 */
+	table_data_size = GENERATE_HANDLE_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES * 4;
+
+	table_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * table_data_size );
+
+	if( table_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block allocation table data.",
+		 function );
+
+		goto on_error;
+	}
+	stored_block_index = 0;
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		table_entry = 0;
+
+		if( generate_handle_block_is_stored(
+		     generate_handle,
+		     snapshot_index,
+		     first_block_index + block_index ) != 0 )
+		{
+			table_entry = (uint32_t) ( data_start_sector + ( block_slots[ stored_block_index ] * sectors_per_block ) );
+
+			stored_block_index++;
+		}
+		byte_stream_copy_from_uint32_little_endian(
+		 &( table_data[ table_data_offset ] ),
+		 table_entry );
+
+		table_data_offset += 4;
+
+		if( ( table_data_offset < table_data_size )
+		 && ( ( block_index + 1 ) < number_of_blocks ) )
+		{
+			continue;
+		}
+		write_count = libcfile_file_write_buffer(
+		               file,
+		               table_data,
+		               table_data_offset,
+		               error );
+
+		if( write_count != (ssize_t) table_data_offset )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write block allocation table.",
+			 function );
+
+			goto on_error;
+		}
+		table_data_offset = 0;
+
+		if( generate_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	memory_free(
+	 table_data );
+
+	table_data = NULL;
+
+	if( generate_handle->abort != 0 )
+	{
+		if( block_slots != NULL )
+		{
+			memory_free(
+			 block_slots );
+		}
+		return( 0 );
+	}
+	if( libcfile_file_resize(
+	     file,
+	     (size64_t) ( data_start_sector + ( number_of_stored_blocks * sectors_per_block ) ) * 512,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize file.",
+		 function );
+
+		goto on_error;
+	}
+	stored_block_index = 0;
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		if( generate_handle->abort != 0 )
+		{
+			break;
+		}
+		if( generate_handle_block_is_stored(
+		     generate_handle,
+		     snapshot_index,
+		     first_block_index + block_index ) == 0 )
+		{
+			continue;
+		}
+		if( generate_handle_write_block_stamp(
+		     generate_handle,
+		     file,
+		     (off64_t) ( data_start_sector + ( block_slots[ stored_block_index ] * sectors_per_block ) ) * 512,
+		     first_block_index + block_index,
+		     snapshot_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write stamp of block: %" PRIu64 ".",
+			 function,
+			 first_block_index + block_index );
+
+			goto on_error;
+		}
+		stored_block_index++;
+	}
+	if( block_slots != NULL )
+	{
+		memory_free(
+		 block_slots );
+	}
+	generate_handle->number_of_stored_blocks += stored_block_index;
+
+	if( generate_handle->abort != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+	if( table_data != NULL )
+	{
+		memory_free(
+		 table_data );
+	}
+	if( block_slots != NULL )
+	{
+		memory_free(
+		 block_slots );
+	}
+	return( -1 );
+}
+
+/* Writes a plain storage data image file
+ * The file is resized to the size of the extent, hence the blocks that are not stored
+ * are left as a hole, and the block stamps are written at the offsets of the stored blocks
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int generate_handle_write_plain_image_file(
+     generate_handle_t *generate_handle,
+     libcfile_file_t *file,
+     int extent_index,
+     int snapshot_index,
+     libcerror_error_t **error )
+{
+	static char *function            = "generate_handle_write_plain_image_file";
+	uint64_t block_index             = 0;
+	uint64_t first_block_index       = 0;
+	uint64_t number_of_blocks        = 0;
+	uint64_t number_of_stored_blocks = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( generate_handle_get_extent_range(
+	     generate_handle,
+	     extent_index,
+	     &first_block_index,
+	     &number_of_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range of extent: %d.",
+		 function,
+		 extent_index );
+
+		return( -1 );
+	}
+	if( libcfile_file_resize(
+	     file,
+	     number_of_blocks * generate_handle->block_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize file.",
+		 function );
+
+		return( -1 );
+	}
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		if( generate_handle->abort != 0 )
+		{
+			break;
+		}
+		if( generate_handle_block_is_stored(
+		     generate_handle,
+		     snapshot_index,
+		     first_block_index + block_index ) == 0 )
+		{
+			continue;
+		}
+		if( generate_handle_write_block_stamp(
+		     generate_handle,
+		     file,
+		     (off64_t) ( block_index * generate_handle->block_size ),
+		     first_block_index + block_index,
+		     snapshot_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write stamp of block: %" PRIu64 ".",
+			 function,
+			 first_block_index + block_index );
+
+			return( -1 );
+		}
+		number_of_stored_blocks++;
+	}
+	generate_handle->number_of_stored_blocks += number_of_stored_blocks;
+
+	if( generate_handle->abort != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Writes the disk descriptor file
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_write_disk_descriptor_file(
+     generate_handle_t *generate_handle,
+     const system_character_t *directory,
+     libcerror_error_t **error )
+{
+	char filename[ GENERATE_HANDLE_IMAGE_FILENAME_SIZE ];
+	char identifier_string[ GENERATE_HANDLE_IDENTIFIER_STRING_SIZE ];
+	char parent_identifier_string[ GENERATE_HANDLE_IDENTIFIER_STRING_SIZE ];
+	uint8_t identifier[ 16 ];
+
+	libcfile_file_t *file      = NULL;
+	char *image_type           = NULL;
+	char *xml_data             = NULL;
+	static char *function      = "generate_handle_write_disk_descriptor_file";
+	size_t xml_data_offset     = 0;
+	size_t xml_data_size       = 0;
+	ssize_t write_count        = 0;
+	uint64_t first_block_index = 0;
+	uint64_t number_of_blocks  = 0;
+	uint64_t number_of_sectors = 0;
+	uint64_t sectors_per_block = 0;
+	int extent_index           = 0;
+	int print_count            = 0;
+	int snapshot_index         = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( generate_handle->disk_type == GENERATE_HANDLE_DISK_TYPE_FIXED )
+	{
+		image_type = "Plain";
+	}
+	else
+	{
+		image_type = "Compressed";
+	}
+	number_of_sectors = generate_handle->media_size / 512;
+	sectors_per_block = generate_handle->block_size / 512;
+
+	/* Every Storage element is less than 256 bytes, every Image and Shot element
+	 * less than 256 bytes and the remainder less than 2048 bytes
+	 */
+	xml_data_size = 2048
+	              + ( (size_t) generate_handle->number_of_extents * ( 256 + ( (size_t) generate_handle->number_of_snapshots * 256 ) ) )
+	              + ( (size_t) generate_handle->number_of_snapshots * 256 );
+
+	xml_data = narrow_string_allocate(
+	            xml_data_size );
+
+	if( xml_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create XML data.",
+		 function );
+
+		goto on_error;
+	}
+	generate_handle_get_snapshot_identifier(
+	 generate_handle,
+	 -1,
+	 identifier );
+
+	if( generate_handle_copy_identifier_to_string(
+	     identifier,
+	     identifier_string,
+	     GENERATE_HANDLE_IDENTIFIER_STRING_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy disk identifier to string.",
+		 function );
+
+		goto on_error;
+	}
+	print_count = narrow_string_snprintf(
+	               xml_data,
+	               xml_data_size,
+	               "<?xml version='1.0' encoding='UTF-8'?>\n"
+	               "<Parallels_disk_image Version=\"1.0\">\n"
+	               "    <Disk_Parameters>\n"
+	               "        <Disk_size>%" PRIu64 "</Disk_size>\n"
+	               "        <Cylinders>%" PRIu64 "</Cylinders>\n"
+	               "        <PhysicalSectorSize>4096</PhysicalSectorSize>\n"
+	               "        <LogicSectorSize>512</LogicSectorSize>\n"
+	               "        <Heads>16</Heads>\n"
+	               "        <Sectors>32</Sectors>\n"
+	               "        <Padding>0</Padding>\n"
+	               "        <Encryption>\n"
+	               "            <Engine>{00000000-0000-0000-0000-000000000000}</Engine>\n"
+	               "            <Data></Data>\n"
+	               "        </Encryption>\n"
+	               "        <UID>%s</UID>\n"
+	               "        <Name>harddisk</Name>\n"
+	               "        <Miscellaneous>\n"
+	               "            <CompatLevel>level2</CompatLevel>\n"
+	               "            <Bootable>1</Bootable>\n"
+	               "            <ChangeState>0</ChangeState>\n"
+	               "            <SuspendState>0</SuspendState>\n"
+	               "        </Miscellaneous>\n"
+	               "    </Disk_Parameters>\n"
+	               "    <StorageData>\n",
+	               number_of_sectors,
+	               number_of_sectors / ( 16 * 32 ),
+	               identifier_string );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= xml_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set disk parameters XML data.",
+		 function );
+
+		goto on_error;
+	}
+	xml_data_offset = (size_t) print_count;
+
+	for( extent_index = 0;
+	     extent_index < generate_handle->number_of_extents;
+	     extent_index++ )
+	{
+		if( generate_handle_get_extent_range(
+		     generate_handle,
+		     extent_index,
+		     &first_block_index,
+		     &number_of_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range of extent: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		print_count = narrow_string_snprintf(
+		               &( xml_data[ xml_data_offset ] ),
+		               xml_data_size - xml_data_offset,
+		               "        <Storage>\n"
+		               "            <Start>%" PRIu64 "</Start>\n"
+		               "            <End>%" PRIu64 "</End>\n"
+		               "            <Blocksize>%" PRIu64 "</Blocksize>\n",
+		               first_block_index * sectors_per_block,
+		               ( first_block_index + number_of_blocks ) * sectors_per_block,
+		               sectors_per_block );
+
+		if( ( print_count < 0 )
+		 || ( (size_t) print_count >= ( xml_data_size - xml_data_offset ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set storage: %d XML data.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		xml_data_offset += (size_t) print_count;
+
+		for( snapshot_index = 0;
+		     snapshot_index < generate_handle->number_of_snapshots;
+		     snapshot_index++ )
+		{
+			generate_handle_get_snapshot_identifier(
+			 generate_handle,
+			 snapshot_index,
+			 identifier );
+
+			if( generate_handle_copy_identifier_to_string(
+			     identifier,
+			     identifier_string,
+			     GENERATE_HANDLE_IDENTIFIER_STRING_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+				 "%s: unable to copy snapshot: %d identifier to string.",
+				 function,
+				 snapshot_index );
+
+				goto on_error;
+			}
+			if( generate_handle_get_image_filename(
+			     generate_handle,
+			     extent_index,
+			     snapshot_index,
+			     filename,
+			     GENERATE_HANDLE_IMAGE_FILENAME_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve image filename.",
+				 function );
+
+				goto on_error;
+			}
+			print_count = narrow_string_snprintf(
+			               &( xml_data[ xml_data_offset ] ),
+			               xml_data_size - xml_data_offset,
+			               "            <Image>\n"
+			               "                <GUID>%s</GUID>\n"
+			               "                <Type>%s</Type>\n"
+			               "                <File>%s</File>\n"
+			               "            </Image>\n",
+			               identifier_string,
+			               image_type,
+			               filename );
+
+			if( ( print_count < 0 )
+			 || ( (size_t) print_count >= ( xml_data_size - xml_data_offset ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set image XML data.",
+				 function );
+
+				goto on_error;
+			}
+			xml_data_offset += (size_t) print_count;
+		}
+		print_count = narrow_string_snprintf(
+		               &( xml_data[ xml_data_offset ] ),
+		               xml_data_size - xml_data_offset,
+		               "        </Storage>\n" );
+
+		if( ( print_count < 0 )
+		 || ( (size_t) print_count >= ( xml_data_size - xml_data_offset ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set storage: %d XML data.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		xml_data_offset += (size_t) print_count;
+	}
+	print_count = narrow_string_snprintf(
+	               &( xml_data[ xml_data_offset ] ),
+	               xml_data_size - xml_data_offset,
+	               "    </StorageData>\n"
+	               "    <Snapshots>\n" );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= ( xml_data_size - xml_data_offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set snapshots XML data.",
+		 function );
+
+		goto on_error;
+	}
+	xml_data_offset += (size_t) print_count;
+
+	/* The first Shot element is the current snapshot, hence the snapshots are
+	 * written from the most recent one to the base image
+	 */
+	for( snapshot_index = generate_handle->number_of_snapshots - 1;
+	     snapshot_index >= 0;
+	     snapshot_index-- )
+	{
+		generate_handle_get_snapshot_identifier(
+		 generate_handle,
+		 snapshot_index,
+		 identifier );
+
+		if( generate_handle_copy_identifier_to_string(
+		     identifier,
+		     identifier_string,
+		     GENERATE_HANDLE_IDENTIFIER_STRING_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy snapshot: %d identifier to string.",
+			 function,
+			 snapshot_index );
+
+			goto on_error;
+		}
+		if( snapshot_index == 0 )
+		{
+			if( memory_set(
+			     identifier,
+			     0,
+			     16 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear parent identifier.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			generate_handle_get_snapshot_identifier(
+			 generate_handle,
+			 snapshot_index - 1,
+			 identifier );
+		}
+		if( generate_handle_copy_identifier_to_string(
+		     identifier,
+		     parent_identifier_string,
+		     GENERATE_HANDLE_IDENTIFIER_STRING_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy parent identifier to string.",
+			 function );
+
+			goto on_error;
+		}
+		print_count = narrow_string_snprintf(
+		               &( xml_data[ xml_data_offset ] ),
+		               xml_data_size - xml_data_offset,
+		               "        <Shot>\n"
+		               "            <GUID>%s</GUID>\n"
+		               "            <ParentGUID>%s</ParentGUID>\n"
+		               "        </Shot>\n",
+		               identifier_string,
+		               parent_identifier_string );
+
+		if( ( print_count < 0 )
+		 || ( (size_t) print_count >= ( xml_data_size - xml_data_offset ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set snapshot: %d XML data.",
+			 function,
+			 snapshot_index );
+
+			goto on_error;
+		}
+		xml_data_offset += (size_t) print_count;
+	}
+	print_count = narrow_string_snprintf(
+	               &( xml_data[ xml_data_offset ] ),
+	               xml_data_size - xml_data_offset,
+	               "    </Snapshots>\n"
+	               "</Parallels_disk_image>\n" );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= ( xml_data_size - xml_data_offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set snapshots XML data.",
+		 function );
+
+		goto on_error;
+	}
+	xml_data_offset += (size_t) print_count;
+
+	if( generate_handle_open_file(
+	     directory,
+	     "DiskDescriptor.xml",
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open disk descriptor file.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libcfile_file_write_buffer(
+	               file,
+	               (uint8_t *) xml_data,
+	               xml_data_offset,
+	               error );
+
+	if( write_count != (ssize_t) xml_data_offset )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write disk descriptor file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close disk descriptor file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free disk descriptor file.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 xml_data );
+
+	return( 1 );
+
+on_error:
+	if( file != NULL )
+	{
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	if( xml_data != NULL )
+	{
+		memory_free(
+		 xml_data );
+	}
+	return( -1 );
+}
+
+/* Writes the disk descriptor and storage data image files into a directory
+ * The directory is created if it does not exist
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int generate_handle_write(
+     generate_handle_t *generate_handle,
+     const system_character_t *directory,
+     libcerror_error_t **error )
+{
+	char filename[ GENERATE_HANDLE_IMAGE_FILENAME_SIZE ];
+
+	libcfile_file_t *file = NULL;
+	static char *function = "generate_handle_write";
+	int extent_index      = 0;
+	int result            = 0;
+	int snapshot_index    = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( generate_handle->media_size == 0 )
+	 || ( ( generate_handle->media_size % generate_handle->block_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported media size: %" PRIu64 " value not a multiple of block size: %" PRIu64 ".",
+		 function,
+		 generate_handle->media_size,
+		 generate_handle->block_size );
+
+		return( -1 );
+	}
+	generate_handle->number_of_blocks        = generate_handle->media_size / generate_handle->block_size;
+	generate_handle->number_of_stored_blocks = 0;
+
+	if( (uint64_t) generate_handle->number_of_extents > generate_handle->number_of_blocks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of extents: %d value exceeds number of blocks: %" PRIu64 ".",
+		 function,
+		 generate_handle->number_of_extents,
+		 generate_handle->number_of_blocks );
+
+		return( -1 );
+	}
+	/* The data of a plain storage data image file is read at the media offset of the extent,
+	 * hence only a single extent is supported for a fixed disk
+	 */
+	if( ( generate_handle->disk_type == GENERATE_HANDLE_DISK_TYPE_FIXED )
+	 && ( generate_handle->number_of_extents != 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of extents: %d for fixed disk.",
+		 function,
+		 generate_handle->number_of_extents );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_exists_wide(
+	          directory,
+	          error );
+#else
+	result = libcfile_file_exists(
+	          directory,
+	          error );
+#endif
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if directory: %" PRIs_SYSTEM " exists.",
+		 function,
+		 directory );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libcpath_path_make_directory_wide(
+		          directory,
+		          error );
+#else
+		result = libcpath_path_make_directory(
+		          directory,
+		          error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to create directory: %" PRIs_SYSTEM ".",
+			 function,
+			 directory );
+
+			goto on_error;
+		}
+	}
+	for( snapshot_index = 0;
+	     snapshot_index < generate_handle->number_of_snapshots;
+	     snapshot_index++ )
+	{
+		for( extent_index = 0;
+		     extent_index < generate_handle->number_of_extents;
+		     extent_index++ )
+		{
+			if( generate_handle_get_image_filename(
+			     generate_handle,
+			     extent_index,
+			     snapshot_index,
+			     filename,
+			     GENERATE_HANDLE_IMAGE_FILENAME_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve image filename.",
+				 function );
+
+				goto on_error;
+			}
+			if( generate_handle_open_file(
+			     directory,
+			     filename,
+			     &file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open image file: %s.",
+				 function,
+				 filename );
+
+				goto on_error;
+			}
+			if( generate_handle->disk_type == GENERATE_HANDLE_DISK_TYPE_FIXED )
+			{
+				result = generate_handle_write_plain_image_file(
+				          generate_handle,
+				          file,
+				          extent_index,
+				          snapshot_index,
+				          error );
+			}
+			else
+			{
+				result = generate_handle_write_sparse_image_file(
+				          generate_handle,
+				          file,
+				          extent_index,
+				          snapshot_index,
+				          error );
+			}
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write image file: %s.",
+				 function,
+				 filename );
+
+				goto on_error;
+			}
+			if( libcfile_file_close(
+			     file,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close image file: %s.",
+				 function,
+				 filename );
+
+				goto on_error;
+			}
+			if( libcfile_file_free(
+			     &file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free image file.",
+				 function );
+
+				goto on_error;
+			}
+			if( result == 0 )
+			{
+				return( 0 );
+			}
+		}
+	}
+	if( generate_handle_write_disk_descriptor_file(
+	     generate_handle,
+	     directory,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write disk descriptor file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file != NULL )
+	{
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	return( -1 );
+}
+
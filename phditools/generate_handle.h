@@ -0,0 +1,261 @@
+/*
+ * Generate handle
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _GENERATE_HANDLE_H )
+#define _GENERATE_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "phditools_libcerror.h"
+#include "phditools_libcfile.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of the stamp written at the start of every stored block
+ */
+#define GENERATE_HANDLE_BLOCK_STAMP_SIZE	16
+
+enum GENERATE_HANDLE_DISK_TYPES
+{
+	GENERATE_HANDLE_DISK_TYPE_EXPANDING	= (int) 'e',
+	GENERATE_HANDLE_DISK_TYPE_FIXED		= (int) 'f'
+};
+
+typedef struct generate_handle generate_handle_t;
+
+struct generate_handle
+{
+	/* The disk type
+	 */
+	int disk_type;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The block size
+	 */
+	size64_t block_size;
+
+	/* The number of blocks
+	 */
+	uint64_t number_of_blocks;
+
+	/* The number of extents
+	 */
+	int number_of_extents;
+
+	/* The number of snapshots, including the base image
+	 */
+	int number_of_snapshots;
+
+	/* The percentage of blocks stored in the base image
+	 */
+	uint8_t allocation_density;
+
+	/* The percentage of blocks stored in every other snapshot
+	 */
+	uint8_t snapshot_density;
+
+	/* The percentage of stored blocks that is moved to a random physical position
+	 */
+	uint8_t fragmentation;
+
+	/* The seed of the pseudo random number generator
+	 */
+	uint64_t seed;
+
+	/* The number of stored blocks that was written
+	 */
+	uint64_t number_of_stored_blocks;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int generate_handle_initialize(
+     generate_handle_t **generate_handle,
+     libcerror_error_t **error );
+
+int generate_handle_free(
+     generate_handle_t **generate_handle,
+     libcerror_error_t **error );
+
+int generate_handle_signal_abort(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error );
+
+int generate_handle_copy_decimal_string_to_64_bit(
+     const system_character_t *string,
+     uint64_t *value,
+     libcerror_error_t **error );
+
+int generate_handle_set_block_size(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_media_size(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_disk_type(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_number_of_extents(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_number_of_snapshots(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_percentage(
+     const system_character_t *string,
+     uint8_t *percentage,
+     libcerror_error_t **error );
+
+int generate_handle_set_allocation_density(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_snapshot_density(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_fragmentation(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_seed(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+uint64_t generate_handle_get_random_value(
+          uint64_t value );
+
+int generate_handle_block_is_stored(
+     generate_handle_t *generate_handle,
+     int snapshot_index,
+     uint64_t block_index );
+
+int generate_handle_get_block_snapshot_index(
+     generate_handle_t *generate_handle,
+     uint64_t block_index,
+     int *snapshot_index,
+     libcerror_error_t **error );
+
+int generate_handle_get_extent_range(
+     generate_handle_t *generate_handle,
+     int extent_index,
+     uint64_t *first_block_index,
+     uint64_t *number_of_blocks,
+     libcerror_error_t **error );
+
+int generate_handle_get_block_stamp(
+     generate_handle_t *generate_handle,
+     uint64_t block_index,
+     int snapshot_index,
+     uint8_t *stamp,
+     size_t stamp_size,
+     libcerror_error_t **error );
+
+void generate_handle_get_snapshot_identifier(
+      generate_handle_t *generate_handle,
+      int snapshot_index,
+      uint8_t *identifier );
+
+int generate_handle_copy_identifier_to_string(
+     const uint8_t *identifier,
+     char *string,
+     size_t string_size,
+     libcerror_error_t **error );
+
+int generate_handle_get_image_filename(
+     generate_handle_t *generate_handle,
+     int extent_index,
+     int snapshot_index,
+     char *filename,
+     size_t filename_size,
+     libcerror_error_t **error );
+
+int generate_handle_open_file(
+     const system_character_t *directory,
+     const char *filename,
+     libcfile_file_t **file,
+     libcerror_error_t **error );
+
+int generate_handle_write_block_stamp(
+     generate_handle_t *generate_handle,
+     libcfile_file_t *file,
+     off64_t file_offset,
+     uint64_t block_index,
+     int snapshot_index,
+     libcerror_error_t **error );
+
+int generate_handle_write_sparse_image_file(
+     generate_handle_t *generate_handle,
+     libcfile_file_t *file,
+     int extent_index,
+     int snapshot_index,
+     libcerror_error_t **error );
+
+int generate_handle_write_plain_image_file(
+     generate_handle_t *generate_handle,
+     libcfile_file_t *file,
+     int extent_index,
+     int snapshot_index,
+     libcerror_error_t **error );
+
+int generate_handle_write_disk_descriptor_file(
+     generate_handle_t *generate_handle,
+     const system_character_t *directory,
+     libcerror_error_t **error );
+
+int generate_handle_write(
+     generate_handle_t *generate_handle,
+     const system_character_t *directory,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _GENERATE_HANDLE_H ) */
+
@@ -30,6 +30,7 @@
 #include "mount_file_system.h"
 #include "mount_handle.h"
 #include "phditools_libcerror.h"
+#include "phditools_libcnotify.h"
 #include "phditools_libcpath.h"
 #include "phditools_libphdi.h"
 
@@ -239,6 +240,32 @@ int mount_handle_set_path_prefix(
 	return( 1 );
 }
 
+/* Sets if the storage image metadata should be read when the image is opened
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_set_warm_metadata(
+     mount_handle_t *mount_handle,
+     uint8_t warm_metadata,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_warm_metadata";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	mount_handle->warm_metadata = warm_metadata;
+
+	return( 1 );
+}
+
 /* Opens the mount handle
  * Returns 1 if successful, 0 if not or -1 on error
  */
@@ -247,9 +274,10 @@ int mount_handle_open(
      const system_character_t *filename,
      libcerror_error_t **error )
 {
-	libphdi_handle_t *phdi_handle = NULL;
-	static char *function         = "mount_handle_open";
-	int result                    = 0;
+	libcerror_error_t *warm_metadata_error = NULL;
+	libphdi_handle_t *phdi_handle          = NULL;
+	static char *function                  = "mount_handle_open";
+	int result                             = 0;
 
 	if( mount_handle == NULL )
 	{
@@ -323,6 +351,34 @@ int mount_handle_open(
 
 		goto on_error;
 	}
+	if( mount_handle->warm_metadata != 0 )
+	{
+		/* The storage image metadata is read up front so that the first reads
+		 * of the mounted image do not have to wait for it. A failure is not fatal
+		 * since the metadata is otherwise read when the data is read
+		 */
+		if( libphdi_handle_warm_metadata(
+		     phdi_handle,
+		     &warm_metadata_error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to read storage image metadata.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 warm_metadata_error );
+			libcerror_error_free(
+			 &warm_metadata_error );
+		}
+	}
+	/* Readahead is only available if libphdi was built with multi-thread support
+	 * hence a failure to enable it is ignored
+	 */
+	libphdi_handle_set_readahead_window_size(
+	 phdi_handle,
+	 MOUNT_HANDLE_READAHEAD_WINDOW_SIZE,
+	 NULL );
+
 	if( mount_file_system_append_handle(
 	     mount_handle->file_system,
 	     phdi_handle,
@@ -35,6 +35,11 @@
 extern "C" {
 #endif
 
+/* The readahead window size, the mounted files are typically read
+ * in small sequential requests
+ */
+#define MOUNT_HANDLE_READAHEAD_WINDOW_SIZE	( 4 * 1024 * 1024 )
+
 typedef struct mount_handle mount_handle_t;
 
 struct mount_handle
@@ -46,6 +51,10 @@ struct mount_handle
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
+
+	/* Value to indicate the storage image metadata should be read when the image is opened
+	 */
+	uint8_t warm_metadata;
 };
 
 int mount_handle_initialize(
@@ -66,6 +75,11 @@ int mount_handle_set_path_prefix(
      size_t path_prefix_size,
      libcerror_error_t **error );
 
+int mount_handle_set_warm_metadata(
+     mount_handle_t *mount_handle,
+     uint8_t warm_metadata,
+     libcerror_error_t **error );
+
 int mount_handle_open(
      mount_handle_t *mount_handle,
      const system_character_t *filename,
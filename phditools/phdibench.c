@@ -0,0 +1,606 @@
+/*
+ * Benchmarks reading a Parallels Hard Disk image file
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "bench_handle.h"
+#include "phditools_getopt.h"
+#include "phditools_libcerror.h"
+#include "phditools_libclocale.h"
+#include "phditools_libcnotify.h"
+#include "phditools_libphdi.h"
+#include "phditools_output.h"
+#include "phditools_signal.h"
+#include "phditools_unused.h"
+
+bench_handle_t *phdibench_bench_handle = NULL;
+int phdibench_abort                    = 0;
+
+/* Prints usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use phdibench to benchmark reading the media data of a Parallels Hard\n"
+	                 "Disk image file.\n\n" );
+
+	fprintf( stream, "Usage: phdibench [ -b block_size ] [ -c number_of_reads ]\n"
+	                 "                 [ -f format ] [ -m access_pattern ]\n"
+	                 "                 [ -o offset_selection ] [ -q queue_depth ]\n"
+	                 "                 [ -s seed ] [ -t number_of_threads ] [ -hvV ]\n"
+	                 "                 source\n\n" );
+
+	fprintf( stream, "\tsource: the source file\n\n" );
+
+	fprintf( stream, "\t-b:     specify the number of bytes per read (default is 4096)\n" );
+	fprintf( stream, "\t-c:     specify the number of reads per thread (default is 10000)\n" );
+	fprintf( stream, "\t-f:     specify the output format, options: json, text (default)\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-m:     specify the access pattern, options: random,\n"
+	                 "\t        sequential (default), zipfian\n" );
+	fprintf( stream, "\t-o:     specify the offsets to read, options: all (default), current\n"
+	                 "\t        (data stored in the current snapshot), parent (data stored\n"
+	                 "\t        in parent snapshots)\n" );
+	fprintf( stream, "\t-q:     specify the number of outstanding reads per thread (default\n"
+	                 "\t        is 1), a queue depth larger than 1 uses asynchronous reads\n" );
+	fprintf( stream, "\t-s:     specify the seed of the pseudo random number generator\n"
+	                 "\t        (default is 1)\n" );
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	fprintf( stream, "\t-t:     specify the number of threads (default is 1)\n" );
+#endif
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+}
+
+/* Signal handler for phdibench
+ */
+void phdibench_signal_handler(
+      phditools_signal_t signal PHDITOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "phdibench_signal_handler";
+
+	PHDITOOLS_UNREFERENCED_PARAMETER( signal )
+
+	phdibench_abort = 1;
+
+	if( phdibench_bench_handle != NULL )
+	{
+		if( bench_handle_signal_abort(
+		     phdibench_bench_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal benchmark handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libphdi_error_t *error                       = NULL;
+	system_character_t *option_access_pattern    = NULL;
+	system_character_t *option_block_size        = NULL;
+	system_character_t *option_number_of_reads   = NULL;
+	system_character_t *option_number_of_threads = NULL;
+	system_character_t *option_offset_selection  = NULL;
+	system_character_t *option_output_format     = NULL;
+	system_character_t *option_queue_depth       = NULL;
+	system_character_t *option_seed              = NULL;
+	system_character_t *source                   = NULL;
+	char *program                                = "phdibench";
+	system_integer_t option                      = 0;
+	int result                                   = 0;
+	int verbose                                  = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "phditools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( phditools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	while( ( option = phditools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:c:f:hm:o:q:s:t:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				phditools_output_version_fprint(
+				 stdout,
+				 program );
+
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_block_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'c':
+				option_number_of_reads = optarg;
+
+				break;
+
+			case (system_integer_t) 'f':
+				option_output_format = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				phditools_output_version_fprint(
+				 stdout,
+				 program );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'm':
+				option_access_pattern = optarg;
+
+				break;
+
+			case (system_integer_t) 'o':
+				option_offset_selection = optarg;
+
+				break;
+
+			case (system_integer_t) 'q':
+				option_queue_depth = optarg;
+
+				break;
+
+			case (system_integer_t) 's':
+				option_seed = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_number_of_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				phditools_output_version_fprint(
+				 stdout,
+				 program );
+
+				phditools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		phditools_output_version_fprint(
+		 stdout,
+		 program );
+
+		fprintf(
+		 stderr,
+		 "Missing source file.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libphdi_notify_set_stream(
+	 stderr,
+	 NULL );
+	libphdi_notify_set_verbose(
+	 verbose );
+
+	if( bench_handle_initialize(
+	     &phdibench_bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize benchmark handle.\n" );
+
+		goto on_error;
+	}
+	if( option_output_format != NULL )
+	{
+		result = bench_handle_set_output_format(
+		          phdibench_bench_handle,
+		          option_output_format,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set output format.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported output format.\n" );
+
+			goto on_error;
+		}
+	}
+	/* The version is not printed with JSON output so that the output can be parsed
+	 */
+	if( phdibench_bench_handle->output_format == BENCH_HANDLE_OUTPUT_FORMAT_TEXT )
+	{
+		phditools_output_version_fprint(
+		 stdout,
+		 program );
+	}
+	if( option_access_pattern != NULL )
+	{
+		result = bench_handle_set_access_pattern(
+		          phdibench_bench_handle,
+		          option_access_pattern,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set access pattern.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported access pattern.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_block_size != NULL )
+	{
+		result = bench_handle_set_block_size(
+		          phdibench_bench_handle,
+		          option_block_size,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set block size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported block size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_reads != NULL )
+	{
+		result = bench_handle_set_number_of_reads(
+		          phdibench_bench_handle,
+		          option_number_of_reads,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of reads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of reads.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_threads != NULL )
+	{
+		result = bench_handle_set_number_of_threads(
+		          phdibench_bench_handle,
+		          option_number_of_threads,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_offset_selection != NULL )
+	{
+		result = bench_handle_set_offset_selection(
+		          phdibench_bench_handle,
+		          option_offset_selection,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set offset selection.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported offset selection.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_queue_depth != NULL )
+	{
+		result = bench_handle_set_queue_depth(
+		          phdibench_bench_handle,
+		          option_queue_depth,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set queue depth.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported queue depth.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_seed != NULL )
+	{
+		result = bench_handle_set_seed(
+		          phdibench_bench_handle,
+		          option_seed,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set seed.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported seed.\n" );
+
+			goto on_error;
+		}
+	}
+	if( bench_handle_open_input(
+	     phdibench_bench_handle,
+	     source,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open source file.\n" );
+
+		goto on_error;
+	}
+	if( phditools_signal_attach(
+	     phdibench_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = bench_handle_run(
+	          phdibench_bench_handle,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to run benchmark.\n" );
+
+		goto on_error;
+	}
+	if( phditools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( bench_handle_close(
+	     phdibench_bench_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close benchmark handle.\n" );
+
+		goto on_error;
+	}
+	if( bench_handle_free(
+	     &phdibench_bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free benchmark handle.\n" );
+
+		goto on_error;
+	}
+	if( phdibench_abort != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "%s: ABORTED\n",
+		 program );
+
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( phdibench_bench_handle != NULL )
+	{
+		bench_handle_free(
+		 &phdibench_bench_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
@@ -0,0 +1,631 @@
+/*
+ * Generates a synthetic Parallels Hard Disk image
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "generate_handle.h"
+#include "phditools_getopt.h"
+#include "phditools_libcerror.h"
+#include "phditools_libclocale.h"
+#include "phditools_libcnotify.h"
+#include "phditools_output.h"
+#include "phditools_signal.h"
+#include "phditools_unused.h"
+
+generate_handle_t *phdigenerate_generate_handle = NULL;
+int phdigenerate_abort                          = 0;
+
+/* Prints usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use phdigenerate to generate a synthetic Parallels Hard Disk image with\n"
+	                 "a known layout, for testing and benchmarking.\n\n" );
+
+	fprintf( stream, "Usage: phdigenerate [ -b block_size ] [ -d disk_type ]\n"
+	                 "                    [ -e number_of_extents ] [ -f fragmentation ]\n"
+	                 "                    [ -m media_size ] [ -n number_of_snapshots ]\n"
+	                 "                    [ -p allocation_density ] [ -s seed ]\n"
+	                 "                    [ -w snapshot_density ] [ -hvV ] target\n\n" );
+
+	fprintf( stream, "\ttarget: the directory to write the image to, the directory is created\n"
+	                 "\t        if it does not exist\n\n" );
+
+	fprintf( stream, "\t-b:     specify the block size, which must be a multiple of 512\n"
+	                 "\t        (default is 1MiB)\n" );
+	fprintf( stream, "\t-d:     specify the disk type, options: expanding (default), fixed\n" );
+	fprintf( stream, "\t-e:     specify the number of extents (default is 1), a fixed disk\n"
+	                 "\t        supports a single extent\n" );
+	fprintf( stream, "\t-f:     specify the percentage of stored blocks that is moved to\n"
+	                 "\t        a random position in the storage data image file (default is 0)\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-m:     specify the media size, which must be a multiple of the block\n"
+	                 "\t        size (default is 64MiB)\n" );
+	fprintf( stream, "\t-n:     specify the number of snapshots including the base image\n"
+	                 "\t        (default is 1)\n" );
+	fprintf( stream, "\t-p:     specify the percentage of blocks stored in the base image\n"
+	                 "\t        (default is 50)\n" );
+	fprintf( stream, "\t-s:     specify the seed of the pseudo random number generator\n"
+	                 "\t        (default is 1)\n" );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+	fprintf( stream, "\t-w:     specify the percentage of blocks written in every snapshot\n"
+	                 "\t        other than the base image (default is 10)\n" );
+}
+
+/* Signal handler for phdigenerate
+ */
+void phdigenerate_signal_handler(
+      phditools_signal_t signal PHDITOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "phdigenerate_signal_handler";
+
+	PHDITOOLS_UNREFERENCED_PARAMETER( signal )
+
+	phdigenerate_abort = 1;
+
+	if( phdigenerate_generate_handle != NULL )
+	{
+		if( generate_handle_signal_abort(
+		     phdigenerate_generate_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal generate handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error                       = NULL;
+	system_character_t *option_allocation_density  = NULL;
+	system_character_t *option_block_size          = NULL;
+	system_character_t *option_disk_type           = NULL;
+	system_character_t *option_fragmentation       = NULL;
+	system_character_t *option_media_size          = NULL;
+	system_character_t *option_number_of_extents   = NULL;
+	system_character_t *option_number_of_snapshots = NULL;
+	system_character_t *option_seed                = NULL;
+	system_character_t *option_snapshot_density    = NULL;
+	system_character_t *target                     = NULL;
+	char *program                                  = "phdigenerate";
+	system_integer_t option                        = 0;
+	int result                                     = 0;
+	int verbose                                    = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "phditools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( phditools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	while( ( option = phditools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:d:e:f:hm:n:p:s:vVw:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				phditools_output_version_fprint(
+				 stdout,
+				 program );
+
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_block_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'd':
+				option_disk_type = optarg;
+
+				break;
+
+			case (system_integer_t) 'e':
+				option_number_of_extents = optarg;
+
+				break;
+
+			case (system_integer_t) 'f':
+				option_fragmentation = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				phditools_output_version_fprint(
+				 stdout,
+				 program );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'm':
+				option_media_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'n':
+				option_number_of_snapshots = optarg;
+
+				break;
+
+			case (system_integer_t) 'p':
+				option_allocation_density = optarg;
+
+				break;
+
+			case (system_integer_t) 's':
+				option_seed = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				phditools_output_version_fprint(
+				 stdout,
+				 program );
+
+				phditools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'w':
+				option_snapshot_density = optarg;
+
+				break;
+		}
+	}
+	if( optind == argc )
+	{
+		phditools_output_version_fprint(
+		 stdout,
+		 program );
+
+		fprintf(
+		 stderr,
+		 "Missing target directory.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	target = argv[ optind ];
+
+	phditools_output_version_fprint(
+	 stdout,
+	 program );
+
+	libcnotify_verbose_set(
+	 verbose );
+
+	if( generate_handle_initialize(
+	     &phdigenerate_generate_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize generate handle.\n" );
+
+		goto on_error;
+	}
+	if( option_allocation_density != NULL )
+	{
+		result = generate_handle_set_allocation_density(
+		          phdigenerate_generate_handle,
+		          option_allocation_density,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set allocation density.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported allocation density.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_block_size != NULL )
+	{
+		result = generate_handle_set_block_size(
+		          phdigenerate_generate_handle,
+		          option_block_size,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set block size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported block size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_disk_type != NULL )
+	{
+		result = generate_handle_set_disk_type(
+		          phdigenerate_generate_handle,
+		          option_disk_type,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set disk type.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported disk type.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_fragmentation != NULL )
+	{
+		result = generate_handle_set_fragmentation(
+		          phdigenerate_generate_handle,
+		          option_fragmentation,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set fragmentation.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported fragmentation.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_media_size != NULL )
+	{
+		result = generate_handle_set_media_size(
+		          phdigenerate_generate_handle,
+		          option_media_size,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set media size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported media size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_extents != NULL )
+	{
+		result = generate_handle_set_number_of_extents(
+		          phdigenerate_generate_handle,
+		          option_number_of_extents,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of extents.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of extents.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_snapshots != NULL )
+	{
+		result = generate_handle_set_number_of_snapshots(
+		          phdigenerate_generate_handle,
+		          option_number_of_snapshots,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of snapshots.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of snapshots.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_seed != NULL )
+	{
+		result = generate_handle_set_seed(
+		          phdigenerate_generate_handle,
+		          option_seed,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set seed.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported seed.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_snapshot_density != NULL )
+	{
+		result = generate_handle_set_snapshot_density(
+		          phdigenerate_generate_handle,
+		          option_snapshot_density,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set snapshot density.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported snapshot density.\n" );
+
+			goto on_error;
+		}
+	}
+	if( phditools_signal_attach(
+	     phdigenerate_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	fprintf(
+	 stdout,
+	 "Generating image in: %" PRIs_SYSTEM "\n",
+	 target );
+
+	result = generate_handle_write(
+	          phdigenerate_generate_handle,
+	          target,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to generate image.\n" );
+
+		goto on_error;
+	}
+	if( phditools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "Number of blocks\t\t: %" PRIu64 "\n",
+		 phdigenerate_generate_handle->number_of_blocks );
+
+		fprintf(
+		 stdout,
+		 "Number of stored blocks\t\t: %" PRIu64 "\n",
+		 phdigenerate_generate_handle->number_of_stored_blocks );
+
+		fprintf(
+		 stdout,
+		 "\n" );
+	}
+	if( generate_handle_free(
+	     &phdigenerate_generate_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free generate handle.\n" );
+
+		goto on_error;
+	}
+	if( phdigenerate_abort != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "%s: ABORTED\n",
+		 program );
+
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( phdigenerate_generate_handle != NULL )
+	{
+		generate_handle_free(
+		 &phdigenerate_generate_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -66,7 +66,7 @@ void usage_fprint(
 	}
 	fprintf( stream, "Use phdimount to mount a Parallels Hard Disk image file\n\n" );
 
-	fprintf( stream, "Usage: phdimount [ -X extended_options ] [ -hvV ] image mount_point\n\n" );
+	fprintf( stream, "Usage: phdimount [ -X extended_options ] [ -hvVw ] image mount_point\n\n" );
 
 	fprintf( stream, "\timage:       a Parallels Hard Disk image file\n\n" );
 	fprintf( stream, "\tmount_point: the directory to serve as mount point\n\n" );
@@ -75,6 +75,8 @@ void usage_fprint(
 	fprintf( stream, "\t-v:          verbose output to stderr, while phdimount will remain running in the\n"
 	                 "\t             foreground\n" );
 	fprintf( stream, "\t-V:          print version\n" );
+	fprintf( stream, "\t-w:          read the storage image metadata of all snapshots when the\n"
+	                 "\t             image is opened\n" );
 	fprintf( stream, "\t-X:          extended options to pass to sub system\n" );
 }
 
@@ -140,6 +142,7 @@ int main( int argc, char * const argv[] )
 	size_t path_prefix_size                     = 0;
 	int result                                  = 0;
 	int verbose                                 = 0;
+	uint8_t warm_metadata                       = 0;
 
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
 	struct fuse_operations phdimount_fuse_operations;
@@ -194,7 +197,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = phditools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "hvVX:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "hvVwX:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -227,6 +230,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'w':
+				warm_metadata = 1;
+
+				break;
+
 			case (system_integer_t) 'X':
 				option_extended_options = optarg;
 
@@ -297,6 +305,17 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( mount_handle_set_warm_metadata(
+	     phdimount_mount_handle,
+	     warm_metadata,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set warm metadata.\n" );
+
+		goto on_error;
+	}
 	if( mount_handle_open(
 	     phdimount_mount_handle,
 	     source,
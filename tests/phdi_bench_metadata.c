@@ -0,0 +1,1218 @@
+/*
+ * Library metadata structures benchmark program
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_MALLOC_H )
+#include <malloc.h>
+#endif
+
+#if defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#endif
+
+#include <time.h>
+
+#include "phdi_test_getopt.h"
+#include "phdi_test_libcerror.h"
+#include "phdi_test_libphdi.h"
+#include "phdi_test_unused.h"
+
+#include "../libphdi/libphdi_block_descriptor.h"
+#include "../libphdi/libphdi_block_tree.h"
+#include "../libphdi/libphdi_segment_table.h"
+#include "../libphdi/libphdi_sparse_image_header.h"
+#include "../libphdi/libphdi_storage_image.h"
+
+/* The block size in sectors, which corresponds to 1 MiB
+ */
+#define PHDI_BENCH_METADATA_BLOCK_SIZE			2048
+
+/* The sector of the first data block
+ */
+#define PHDI_BENCH_METADATA_DATA_START_SECTOR		2048
+
+#define PHDI_BENCH_METADATA_DEFAULT_NUMBER_OF_LOOKUPS	1000000
+#define PHDI_BENCH_METADATA_MAXIMUM_NUMBER_OF_ENTRIES	( 1024 * 1024 )
+#define PHDI_BENCH_METADATA_MAXIMUM_NUMBER_OF_LOOKUPS	( 64 * 1024 * 1024 )
+
+/* Copies a decimal string to an unsigned 64-bit value
+ * Returns 1 if successful or 0 if the string is not a decimal value
+ */
+int phdi_bench_metadata_copy_decimal_string_to_64_bit(
+     const system_character_t *string,
+     uint64_t *value )
+{
+	size_t string_index = 0;
+	uint64_t safe_value = 0;
+	uint8_t digit       = 0;
+
+	if( string[ 0 ] == 0 )
+	{
+		return( 0 );
+	}
+	for( string_index = 0;
+	     string[ string_index ] != 0;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] < (system_character_t) '0' )
+		 || ( string[ string_index ] > (system_character_t) '9' ) )
+		{
+			return( 0 );
+		}
+		digit = (uint8_t) ( string[ string_index ] - (system_character_t) '0' );
+
+		if( safe_value > ( ( UINT64_MAX - digit ) / 10 ) )
+		{
+			return( 0 );
+		}
+		safe_value = ( safe_value * 10 ) + digit;
+	}
+	*value = safe_value;
+
+	return( 1 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+typedef struct phdi_bench_metadata_result phdi_bench_metadata_result_t;
+
+struct phdi_bench_metadata_result
+{
+	/* The time it took to create the structure in nano seconds
+	 */
+	uint64_t open_time;
+
+	/* The total time of the inserts in nano seconds
+	 */
+	uint64_t insert_time;
+
+	/* The number of inserts
+	 */
+	uint64_t number_of_inserts;
+
+	/* The total time of the lookups in nano seconds
+	 */
+	uint64_t lookup_time;
+
+	/* The number of lookups
+	 */
+	uint64_t number_of_lookups;
+
+	/* The number of lookups that returned a value
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of bytes of heap in use by the structure
+	 */
+	uint64_t heap_size;
+};
+
+uint32_t phdi_bench_metadata_number_of_entries[ 3 ] = {
+	4096, 65536, 1048576 };
+
+int phdi_bench_metadata_densities[ 3 ] = {
+	10, 50, 100 };
+
+int phdi_bench_metadata_number_of_extents[ 4 ] = {
+	1, 16, 256, 4096 };
+
+/* Retrieves a monotonic timestamp in nano seconds
+ * Returns the timestamp or 0 if not available
+ */
+uint64_t phdi_bench_metadata_get_timestamp(
+          void )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+	if( QueryPerformanceFrequency(
+	     &frequency ) == 0 )
+	{
+		return( 0 );
+	}
+	if( QueryPerformanceCounter(
+	     &counter ) == 0 )
+	{
+		return( 0 );
+	}
+	return( (uint64_t) ( ( (double) counter.QuadPart * 1000000000.0 ) / (double) frequency.QuadPart ) );
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	struct timespec time_structure;
+
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_structure.tv_sec * 1000000000 ) + (uint64_t) time_structure.tv_nsec );
+
+#elif defined( HAVE_SYS_TIME_H )
+	struct timeval time_structure;
+
+	if( gettimeofday(
+	     &time_structure,
+	     NULL ) != 0 )
+	{
+		return( 0 );
+	}
+	return( ( (uint64_t) time_structure.tv_sec * 1000000000 ) + ( (uint64_t) time_structure.tv_usec * 1000 ) );
+
+#else
+	return( 0 );
+
+#endif
+}
+
+/* Retrieves the number of bytes of heap in use
+ * Returns the number of bytes or 0 if not available
+ */
+uint64_t phdi_bench_metadata_get_heap_size(
+          void )
+{
+#if defined( HAVE_MALLOC_H ) && defined( HAVE_MALLINFO2 )
+	struct mallinfo2 malloc_information;
+
+	malloc_information = mallinfo2();
+
+	/* Large allocations are memory mapped and not part of uordblks
+	 */
+	return( (uint64_t) malloc_information.uordblks + (uint64_t) malloc_information.hblkhd );
+#else
+	return( 0 );
+#endif
+}
+
+/* Retrieves the next pseudo random number
+ * The pseudo random number generator is splitmix64, which is fast and
+ * reproducible for the same seed across platforms
+ * Returns the pseudo random number
+ */
+uint64_t phdi_bench_metadata_get_random(
+          uint64_t *random_state )
+{
+	uint64_t value = 0;
+
+	*random_state += 0x9e3779b97f4a7c15ULL;
+
+	value = *random_state;
+	value = ( value ^ ( value >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+	value = ( value ^ ( value >> 27 ) ) * 0x94d049bb133111ebULL;
+
+	return( value ^ ( value >> 31 ) );
+}
+
+/* Fills block allocation table data where density percent of the blocks are allocated
+ * The allocated blocks are stored contiguously in order of their block index
+ */
+void phdi_bench_metadata_fill_block_allocation_table_data(
+      uint8_t *data,
+      uint32_t number_of_entries,
+      int density,
+      uint64_t *random_state )
+{
+	uint32_t block_allocation_table_entry = 0;
+	uint32_t entry_index                  = 0;
+	uint32_t number_of_allocated_blocks   = 0;
+
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		block_allocation_table_entry = 0;
+
+		if( ( phdi_bench_metadata_get_random(
+		       random_state ) % 100 ) < (uint64_t) density )
+		{
+			block_allocation_table_entry = PHDI_BENCH_METADATA_DATA_START_SECTOR
+			                             + ( number_of_allocated_blocks * PHDI_BENCH_METADATA_BLOCK_SIZE );
+
+			number_of_allocated_blocks++;
+		}
+		byte_stream_copy_from_uint32_little_endian(
+		 &( data[ entry_index * 4 ] ),
+		 block_allocation_table_entry );
+	}
+}
+
+/* Fills the lookup offsets with random offsets smaller than the maximum offset
+ */
+void phdi_bench_metadata_fill_offsets(
+      off64_t *offsets,
+      uint64_t number_of_offsets,
+      uint64_t maximum_offset,
+      uint64_t *random_state )
+{
+	uint64_t offset_index = 0;
+
+	for( offset_index = 0;
+	     offset_index < number_of_offsets;
+	     offset_index++ )
+	{
+		offsets[ offset_index ] = (off64_t) ( phdi_bench_metadata_get_random(
+		                                       random_state ) % maximum_offset );
+	}
+}
+
+/* Prints a benchmark result
+ */
+void phdi_bench_metadata_print_result(
+      const char *structure_name,
+      uint32_t number_of_entries,
+      int density,
+      phdi_bench_metadata_result_t *result )
+{
+	fprintf(
+	 stdout,
+	 "%-10s %8" PRIu32 " %3d%% %10" PRIu64 "",
+	 structure_name,
+	 number_of_entries,
+	 density,
+	 result->open_time / 1000 );
+
+	if( result->number_of_inserts > 0 )
+	{
+		fprintf(
+		 stdout,
+		 " %9" PRIu64 "",
+		 result->insert_time / result->number_of_inserts );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 " %9s",
+		 "-" );
+	}
+	if( result->number_of_lookups > 0 )
+	{
+		fprintf(
+		 stdout,
+		 " %9" PRIu64 "",
+		 result->lookup_time / result->number_of_lookups );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 " %9s",
+		 "-" );
+	}
+	if( ( result->heap_size > 0 )
+	 && ( number_of_entries > 0 ) )
+	{
+		fprintf(
+		 stdout,
+		 " %14" PRIu64 "",
+		 ( result->heap_size * 1000000 ) / number_of_entries );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 " %14s",
+		 "-" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+}
+
+/* Benchmarks the in-memory block allocation table of the storage image
+ * Returns 1 if successful or -1 on error
+ */
+int phdi_bench_metadata_block_allocation_table(
+     const uint8_t *data,
+     uint32_t number_of_entries,
+     const off64_t *offsets,
+     uint64_t number_of_offsets,
+     phdi_bench_metadata_result_t *result,
+     libcerror_error_t **error )
+{
+	libphdi_block_descriptor_t *block_descriptor = NULL;
+	libphdi_storage_image_t *storage_image       = NULL;
+	static char *function                        = "phdi_bench_metadata_block_allocation_table";
+	off64_t block_offset                         = 0;
+	uint64_t heap_size                           = 0;
+	uint64_t offset_index                        = 0;
+	uint64_t timestamp                           = 0;
+	int lookup_result                            = 0;
+
+	if( libphdi_storage_image_initialize(
+	     &storage_image,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create storage image.",
+		 function );
+
+		goto on_error;
+	}
+	if( libphdi_sparse_image_header_initialize(
+	     &( storage_image->sparse_image_header ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sparse image header.",
+		 function );
+
+		goto on_error;
+	}
+	storage_image->sparse_image_header->block_size                         = PHDI_BENCH_METADATA_BLOCK_SIZE;
+	storage_image->sparse_image_header->number_of_allocation_table_entries = number_of_entries;
+	storage_image->sparse_image_header->number_of_sectors                  = (uint64_t) number_of_entries * PHDI_BENCH_METADATA_BLOCK_SIZE;
+	storage_image->sparse_image_header->data_start_sector                  = PHDI_BENCH_METADATA_DATA_START_SECTOR;
+
+	heap_size = phdi_bench_metadata_get_heap_size();
+	timestamp = phdi_bench_metadata_get_timestamp();
+
+	if( libphdi_storage_image_read_block_allocation_table_data(
+	     storage_image,
+	     data,
+	     (size_t) number_of_entries * 4,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block allocation table data.",
+		 function );
+
+		goto on_error;
+	}
+	result->open_time = phdi_bench_metadata_get_timestamp() - timestamp;
+	result->heap_size = phdi_bench_metadata_get_heap_size() - heap_size;
+
+	timestamp = phdi_bench_metadata_get_timestamp();
+
+	for( offset_index = 0;
+	     offset_index < number_of_offsets;
+	     offset_index++ )
+	{
+		lookup_result = libphdi_storage_image_get_block_descriptor_at_offset(
+		                 storage_image,
+		                 NULL,
+		                 offsets[ offset_index ],
+		                 &block_descriptor,
+		                 &block_offset,
+		                 error );
+
+		if( lookup_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block descriptor at offset: %" PRIi64 ".",
+			 function,
+			 offsets[ offset_index ] );
+
+			goto on_error;
+		}
+		else if( lookup_result != 0 )
+		{
+			result->number_of_hits += 1;
+		}
+	}
+	result->lookup_time       = phdi_bench_metadata_get_timestamp() - timestamp;
+	result->number_of_lookups = number_of_offsets;
+
+	if( libphdi_storage_image_free(
+	     &storage_image,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free storage image.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( storage_image != NULL )
+	{
+		libphdi_storage_image_free(
+		 &storage_image,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Benchmarks the block tree using the allocated blocks of the block allocation table data
+ * The insert time includes creating the block descriptor
+ * Returns 1 if successful or -1 on error
+ */
+int phdi_bench_metadata_block_tree(
+     const uint8_t *data,
+     uint32_t number_of_entries,
+     const off64_t *offsets,
+     uint64_t number_of_offsets,
+     phdi_bench_metadata_result_t *result,
+     libcerror_error_t **error )
+{
+	libphdi_block_descriptor_t *block_descriptor          = NULL;
+	libphdi_block_descriptor_t *existing_block_descriptor = NULL;
+	libphdi_block_tree_t *block_tree                      = NULL;
+	libphdi_block_tree_node_t *leaf_block_tree_node       = NULL;
+	static char *function                                 = "phdi_bench_metadata_block_tree";
+	off64_t block_offset                                  = 0;
+	uint64_t heap_size                                    = 0;
+	uint64_t offset_index                                 = 0;
+	uint64_t timestamp                                    = 0;
+	uint32_t block_allocation_table_entry                 = 0;
+	uint32_t entry_index                                  = 0;
+	int leaf_value_index                                  = 0;
+	int lookup_result                                     = 0;
+
+	heap_size = phdi_bench_metadata_get_heap_size();
+	timestamp = phdi_bench_metadata_get_timestamp();
+
+	if( libphdi_block_tree_initialize(
+	     &block_tree,
+	     (size64_t) number_of_entries * PHDI_BENCH_METADATA_BLOCK_SIZE * 512,
+	     (size64_t) PHDI_BENCH_METADATA_BLOCK_SIZE * 512,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create block tree.",
+		 function );
+
+		goto on_error;
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( data[ entry_index * 4 ] ),
+		 block_allocation_table_entry );
+
+		if( block_allocation_table_entry == 0 )
+		{
+			continue;
+		}
+		if( libphdi_block_descriptor_initialize(
+		     &block_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create block descriptor.",
+			 function );
+
+			goto on_error;
+		}
+		block_descriptor->file_io_pool_entry = 0;
+		block_descriptor->file_offset        = (off64_t) block_allocation_table_entry * 512;
+
+		if( libphdi_block_tree_insert_block_descriptor_by_offset(
+		     block_tree,
+		     (off64_t) entry_index * PHDI_BENCH_METADATA_BLOCK_SIZE * 512,
+		     block_descriptor,
+		     &leaf_value_index,
+		     &leaf_block_tree_node,
+		     &existing_block_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert block descriptor: %" PRIu32 " in block tree.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		block_descriptor = NULL;
+
+		result->number_of_inserts += 1;
+	}
+	result->insert_time = phdi_bench_metadata_get_timestamp() - timestamp;
+	result->open_time   = result->insert_time;
+	result->heap_size   = phdi_bench_metadata_get_heap_size() - heap_size;
+
+	timestamp = phdi_bench_metadata_get_timestamp();
+
+	for( offset_index = 0;
+	     offset_index < number_of_offsets;
+	     offset_index++ )
+	{
+		lookup_result = libphdi_block_tree_get_block_descriptor_by_offset(
+		                 block_tree,
+		                 offsets[ offset_index ],
+		                 &block_descriptor,
+		                 &block_offset,
+		                 error );
+
+		if( lookup_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block descriptor at offset: %" PRIi64 ".",
+			 function,
+			 offsets[ offset_index ] );
+
+			block_descriptor = NULL;
+
+			goto on_error;
+		}
+		else if( lookup_result != 0 )
+		{
+			result->number_of_hits += 1;
+		}
+	}
+	result->lookup_time       = phdi_bench_metadata_get_timestamp() - timestamp;
+	result->number_of_lookups = number_of_offsets;
+
+	block_descriptor = NULL;
+
+	if( libphdi_block_tree_free(
+	     &block_tree,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_block_descriptor_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free block tree.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( block_descriptor != NULL )
+	{
+		libphdi_block_descriptor_free(
+		 &block_descriptor,
+		 NULL );
+	}
+	if( block_tree != NULL )
+	{
+		libphdi_block_tree_free(
+		 &block_tree,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_block_descriptor_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Benchmarks the segment table that maps media offsets to extents
+ * The extents have different sizes so that the segment index is searched
+ * Returns 1 if successful or -1 on error
+ */
+int phdi_bench_metadata_extent_table(
+     int number_of_extents,
+     off64_t *offsets,
+     uint64_t number_of_offsets,
+     uint64_t *random_state,
+     phdi_bench_metadata_result_t *result,
+     libcerror_error_t **error )
+{
+	libphdi_segment_table_t *segment_table = NULL;
+	static char *function                  = "phdi_bench_metadata_extent_table";
+	size64_t extent_size                   = 0;
+	uint64_t heap_size                     = 0;
+	uint64_t media_size                    = 0;
+	uint64_t offset_index                  = 0;
+	uint64_t timestamp                     = 0;
+	int extent_index                       = 0;
+	int lookup_result                      = 0;
+	int segment_index                      = 0;
+
+	heap_size = phdi_bench_metadata_get_heap_size();
+	timestamp = phdi_bench_metadata_get_timestamp();
+
+	if( libphdi_segment_table_initialize(
+	     &segment_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment table.",
+		 function );
+
+		goto on_error;
+	}
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		/* Extents of 1 GiB - 2 GiB in multitudes of the block size
+		 */
+		extent_size = (size64_t) ( 1024 + ( phdi_bench_metadata_get_random(
+		                                     random_state ) % 1024 ) ) * PHDI_BENCH_METADATA_BLOCK_SIZE * 512;
+
+		if( libphdi_segment_table_append_segment(
+		     segment_table,
+		     extent_index,
+		     0,
+		     extent_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extent: %d to segment table.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		media_size += extent_size;
+
+		result->number_of_inserts += 1;
+	}
+	result->insert_time = phdi_bench_metadata_get_timestamp() - timestamp;
+	result->open_time   = result->insert_time;
+	result->heap_size   = phdi_bench_metadata_get_heap_size() - heap_size;
+
+	phdi_bench_metadata_fill_offsets(
+	 offsets,
+	 number_of_offsets,
+	 media_size,
+	 random_state );
+
+	timestamp = phdi_bench_metadata_get_timestamp();
+
+	for( offset_index = 0;
+	     offset_index < number_of_offsets;
+	     offset_index++ )
+	{
+		lookup_result = libphdi_segment_table_get_segment_index_at_offset(
+		                 segment_table,
+		                 offsets[ offset_index ],
+		                 &segment_index,
+		                 error );
+
+		if( lookup_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent index at offset: %" PRIi64 ".",
+			 function,
+			 offsets[ offset_index ] );
+
+			goto on_error;
+		}
+		else if( lookup_result != 0 )
+		{
+			result->number_of_hits += 1;
+		}
+	}
+	result->lookup_time       = phdi_bench_metadata_get_timestamp() - timestamp;
+	result->number_of_lookups = number_of_offsets;
+
+	if( libphdi_segment_table_free(
+	     &segment_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free segment table.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( segment_table != NULL )
+	{
+		libphdi_segment_table_free(
+		 &segment_table,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Runs the block allocation table and block tree benchmarks
+ * Returns 1 if successful or -1 on error
+ */
+int phdi_bench_metadata_run_blocks(
+     uint32_t number_of_entries,
+     int density,
+     uint64_t number_of_lookups,
+     uint64_t *random_state,
+     libcerror_error_t **error )
+{
+	phdi_bench_metadata_result_t result;
+
+	off64_t *offsets      = NULL;
+	uint8_t *data         = NULL;
+	static char *function = "phdi_bench_metadata_run_blocks";
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * number_of_entries * 4 );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block allocation table data.",
+		 function );
+
+		goto on_error;
+	}
+	offsets = (off64_t *) memory_allocate(
+	                       sizeof( off64_t ) * number_of_lookups );
+
+	if( offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create offsets.",
+		 function );
+
+		goto on_error;
+	}
+	phdi_bench_metadata_fill_block_allocation_table_data(
+	 data,
+	 number_of_entries,
+	 density,
+	 random_state );
+
+	phdi_bench_metadata_fill_offsets(
+	 offsets,
+	 number_of_lookups,
+	 (uint64_t) number_of_entries * PHDI_BENCH_METADATA_BLOCK_SIZE * 512,
+	 random_state );
+
+	if( memory_set(
+	     &result,
+	     0,
+	     sizeof( phdi_bench_metadata_result_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear result.",
+		 function );
+
+		goto on_error;
+	}
+	if( phdi_bench_metadata_block_allocation_table(
+	     data,
+	     number_of_entries,
+	     offsets,
+	     number_of_lookups,
+	     &result,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to benchmark block allocation table.",
+		 function );
+
+		goto on_error;
+	}
+	phdi_bench_metadata_print_result(
+	 "bat",
+	 number_of_entries,
+	 density,
+	 &result );
+
+	if( memory_set(
+	     &result,
+	     0,
+	     sizeof( phdi_bench_metadata_result_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear result.",
+		 function );
+
+		goto on_error;
+	}
+	if( phdi_bench_metadata_block_tree(
+	     data,
+	     number_of_entries,
+	     offsets,
+	     number_of_lookups,
+	     &result,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to benchmark block tree.",
+		 function );
+
+		goto on_error;
+	}
+	phdi_bench_metadata_print_result(
+	 "block_tree",
+	 number_of_entries,
+	 density,
+	 &result );
+
+	memory_free(
+	 offsets );
+
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( offsets != NULL )
+	{
+		memory_free(
+		 offsets );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
+/* Runs the extent table benchmark
+ * Returns 1 if successful or -1 on error
+ */
+int phdi_bench_metadata_run_extents(
+     int number_of_extents,
+     uint64_t number_of_lookups,
+     uint64_t *random_state,
+     libcerror_error_t **error )
+{
+	phdi_bench_metadata_result_t result;
+
+	off64_t *offsets      = NULL;
+	static char *function = "phdi_bench_metadata_run_extents";
+
+	offsets = (off64_t *) memory_allocate(
+	                       sizeof( off64_t ) * number_of_lookups );
+
+	if( offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create offsets.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     &result,
+	     0,
+	     sizeof( phdi_bench_metadata_result_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear result.",
+		 function );
+
+		goto on_error;
+	}
+	if( phdi_bench_metadata_extent_table(
+	     number_of_extents,
+	     offsets,
+	     number_of_lookups,
+	     random_state,
+	     &result,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to benchmark extent table.",
+		 function );
+
+		goto on_error;
+	}
+	phdi_bench_metadata_print_result(
+	 "extents",
+	 (uint32_t) number_of_extents,
+	 100,
+	 &result );
+
+	memory_free(
+	 offsets );
+
+	return( 1 );
+
+on_error:
+	if( offsets != NULL )
+	{
+		memory_free(
+		 offsets );
+	}
+	return( -1 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+	libcerror_error_t *error        = NULL;
+	uint64_t random_state           = 1;
+	int density_index               = 0;
+	int extent_index                = 0;
+	int size_index                  = 0;
+#endif
+	system_integer_t option         = 0;
+	uint64_t density                = 0;
+	uint64_t number_of_entries      = 0;
+	uint64_t number_of_lookups      = PHDI_BENCH_METADATA_DEFAULT_NUMBER_OF_LOOKUPS;
+	uint64_t seed                   = 1;
+	int number_of_densities         = 3;
+	int number_of_sizes             = 3;
+
+	while( ( option = phdi_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "c:d:e:s:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) 'c':
+				if( ( phdi_bench_metadata_copy_decimal_string_to_64_bit(
+				       optarg,
+				       &number_of_lookups ) != 1 )
+				 || ( number_of_lookups == 0 )
+				 || ( number_of_lookups > PHDI_BENCH_METADATA_MAXIMUM_NUMBER_OF_LOOKUPS ) )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported number of lookups: %" PRIs_SYSTEM ".\n",
+					 optarg );
+
+					return( EXIT_FAILURE );
+				}
+				break;
+
+			case (system_integer_t) 'd':
+				if( ( phdi_bench_metadata_copy_decimal_string_to_64_bit(
+				       optarg,
+				       &density ) != 1 )
+				 || ( density > 100 ) )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported density: %" PRIs_SYSTEM ".\n",
+					 optarg );
+
+					return( EXIT_FAILURE );
+				}
+				number_of_densities = 1;
+
+				break;
+
+			case (system_integer_t) 'e':
+				if( ( phdi_bench_metadata_copy_decimal_string_to_64_bit(
+				       optarg,
+				       &number_of_entries ) != 1 )
+				 || ( number_of_entries == 0 )
+				 || ( number_of_entries > PHDI_BENCH_METADATA_MAXIMUM_NUMBER_OF_ENTRIES ) )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported number of entries: %" PRIs_SYSTEM ".\n",
+					 optarg );
+
+					return( EXIT_FAILURE );
+				}
+				number_of_sizes = 1;
+
+				break;
+
+			case (system_integer_t) 's':
+				if( phdi_bench_metadata_copy_decimal_string_to_64_bit(
+				     optarg,
+				     &seed ) != 1 )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported seed: %" PRIs_SYSTEM ".\n",
+					 optarg );
+
+					return( EXIT_FAILURE );
+				}
+				break;
+
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+		}
+	}
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+	random_state = seed;
+
+	fprintf(
+	 stdout,
+	 "%-10s %8s %4s %10s %9s %9s %14s\n",
+	 "structure",
+	 "entries",
+	 "dens",
+	 "open (us)",
+	 "ns/insert",
+	 "ns/lookup",
+	 "heap/M entries" );
+
+	for( size_index = 0;
+	     size_index < number_of_sizes;
+	     size_index++ )
+	{
+		if( number_of_entries == 0 )
+		{
+			number_of_entries = phdi_bench_metadata_number_of_entries[ size_index ];
+		}
+		for( density_index = 0;
+		     density_index < number_of_densities;
+		     density_index++ )
+		{
+			if( number_of_densities > 1 )
+			{
+				density = (uint64_t) phdi_bench_metadata_densities[ density_index ];
+			}
+			if( phdi_bench_metadata_run_blocks(
+			     (uint32_t) number_of_entries,
+			     (int) density,
+			     number_of_lookups,
+			     &random_state,
+			     &error ) != 1 )
+			{
+				goto on_error;
+			}
+		}
+		if( number_of_sizes > 1 )
+		{
+			number_of_entries = 0;
+		}
+	}
+	for( extent_index = 0;
+	     extent_index < 4;
+	     extent_index++ )
+	{
+		if( phdi_bench_metadata_run_extents(
+		     phdi_bench_metadata_number_of_extents[ extent_index ],
+		     number_of_lookups,
+		     &random_state,
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+#else
+	PHDI_TEST_UNREFERENCED_PARAMETER( density )
+	PHDI_TEST_UNREFERENCED_PARAMETER( number_of_densities )
+	PHDI_TEST_UNREFERENCED_PARAMETER( number_of_entries )
+	PHDI_TEST_UNREFERENCED_PARAMETER( number_of_lookups )
+	PHDI_TEST_UNREFERENCED_PARAMETER( number_of_sizes )
+	PHDI_TEST_UNREFERENCED_PARAMETER( seed )
+
+	fprintf(
+	 stdout,
+	 "Benchmark requires access to the library internals.\n" );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+}
+
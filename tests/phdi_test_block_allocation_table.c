@@ -0,0 +1,815 @@
+/*
+ * Library block_allocation_table type test program
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "phdi_test_functions.h"
+#include "phdi_test_libbfio.h"
+#include "phdi_test_libcerror.h"
+#include "phdi_test_libphdi.h"
+#include "phdi_test_macros.h"
+#include "phdi_test_memory.h"
+#include "phdi_test_unused.h"
+
+#include "../libphdi/libphdi_block_allocation_table.h"
+#include "../libphdi/libphdi_definitions.h"
+
+/* The test data contains a 64 byte header followed by 3 pages of entries
+ * where the last page is partially filled, entry N contains the value N + 1
+ */
+#define PHDI_TEST_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES	( ( 2 * LIBPHDI_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES_PER_PAGE ) + 10 )
+
+uint8_t phdi_test_block_allocation_table_data1[ 64 + ( PHDI_TEST_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES * 4 ) ];
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+/* Tests the libphdi_block_allocation_table_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_block_allocation_table_initialize(
+     void )
+{
+	libcerror_error_t *error                                 = NULL;
+	libphdi_block_allocation_table_t *block_allocation_table = NULL;
+	int result                                               = 0;
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+	int number_of_malloc_fail_tests                          = 2;
+	int number_of_memset_fail_tests                          = 2;
+	int test_number                                          = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libphdi_block_allocation_table_initialize(
+	          &block_allocation_table,
+	          0,
+	          64,
+	          PHDI_TEST_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES,
+	          2,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "block_allocation_table",
+	 block_allocation_table );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT32(
+	 "block_allocation_table->number_of_pages",
+	 block_allocation_table->number_of_pages,
+	 3 );
+
+	result = libphdi_block_allocation_table_free(
+	          &block_allocation_table,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "block_allocation_table",
+	 block_allocation_table );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_block_allocation_table_initialize(
+	          NULL,
+	          0,
+	          64,
+	          PHDI_TEST_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES,
+	          2,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	block_allocation_table = (libphdi_block_allocation_table_t *) 0x12345678UL;
+
+	result = libphdi_block_allocation_table_initialize(
+	          &block_allocation_table,
+	          0,
+	          64,
+	          PHDI_TEST_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES,
+	          2,
+	          &error );
+
+	block_allocation_table = NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_block_allocation_table_initialize(
+	          &block_allocation_table,
+	          0,
+	          64,
+	          0,
+	          2,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_block_allocation_table_initialize(
+	          &block_allocation_table,
+	          0,
+	          64,
+	          PHDI_TEST_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_block_allocation_table_initialize with malloc failing
+		 */
+		phdi_test_malloc_attempts_before_fail = test_number;
+
+		result = libphdi_block_allocation_table_initialize(
+		          &block_allocation_table,
+		          0,
+		          64,
+		          PHDI_TEST_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES,
+		          2,
+		          &error );
+
+		if( phdi_test_malloc_attempts_before_fail != -1 )
+		{
+			phdi_test_malloc_attempts_before_fail = -1;
+
+			if( block_allocation_table != NULL )
+			{
+				libphdi_block_allocation_table_free(
+				 &block_allocation_table,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "block_allocation_table",
+			 block_allocation_table );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_block_allocation_table_initialize with memset failing
+		 */
+		phdi_test_memset_attempts_before_fail = test_number;
+
+		result = libphdi_block_allocation_table_initialize(
+		          &block_allocation_table,
+		          0,
+		          64,
+		          PHDI_TEST_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES,
+		          2,
+		          &error );
+
+		if( phdi_test_memset_attempts_before_fail != -1 )
+		{
+			phdi_test_memset_attempts_before_fail = -1;
+
+			if( block_allocation_table != NULL )
+			{
+				libphdi_block_allocation_table_free(
+				 &block_allocation_table,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "block_allocation_table",
+			 block_allocation_table );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PHDI_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_allocation_table != NULL )
+	{
+		libphdi_block_allocation_table_free(
+		 &block_allocation_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_block_allocation_table_free function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_block_allocation_table_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libphdi_block_allocation_table_free(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_block_allocation_table_get_entry_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_block_allocation_table_get_entry_by_index(
+     void )
+{
+	libbfio_handle_t *file_io_handle                         = NULL;
+	libbfio_pool_t *file_io_pool                             = NULL;
+	libcerror_error_t *error                                 = NULL;
+	libphdi_block_allocation_table_t *block_allocation_table = NULL;
+	uint32_t entry                                           = 0;
+	int file_io_pool_entry                                   = 0;
+	int result                                               = 0;
+
+	/* Initialize test
+	 */
+	result = phdi_test_open_file_io_handle(
+	          &file_io_handle,
+	          phdi_test_block_allocation_table_data1,
+	          64 + ( PHDI_TEST_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES * 4 ),
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_initialize(
+	          &file_io_pool,
+	          0,
+	          LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_append_handle(
+	          file_io_pool,
+	          &file_io_pool_entry,
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The file IO handle is now managed by the file IO pool
+	 */
+	file_io_handle = NULL;
+
+	result = libphdi_block_allocation_table_initialize(
+	          &block_allocation_table,
+	          file_io_pool_entry,
+	          64,
+	          PHDI_TEST_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES,
+	          2,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "block_allocation_table",
+	 block_allocation_table );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_block_allocation_table_get_entry_by_index(
+	          block_allocation_table,
+	          file_io_pool,
+	          5,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT32(
+	 "entry",
+	 entry,
+	 6 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_block_allocation_table_get_entry_by_index(
+	          block_allocation_table,
+	          file_io_pool,
+	          LIBPHDI_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES_PER_PAGE + 7,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT32(
+	 "entry",
+	 entry,
+	 LIBPHDI_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES_PER_PAGE + 8 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "block_allocation_table->number_of_loaded_pages",
+	 block_allocation_table->number_of_loaded_pages,
+	 2 );
+
+	/* Reading the last, partial, page reuses the least recently used page
+	 */
+	result = libphdi_block_allocation_table_get_entry_by_index(
+	          block_allocation_table,
+	          file_io_pool,
+	          PHDI_TEST_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES - 1,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT32(
+	 "entry",
+	 entry,
+	 PHDI_TEST_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "block_allocation_table->number_of_loaded_pages",
+	 block_allocation_table->number_of_loaded_pages,
+	 2 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "block_allocation_table->pages[ 0 ]",
+	 block_allocation_table->pages[ 0 ] );
+
+	/* Only entries of loaded pages are retrieved without reading
+	 */
+	result = libphdi_block_allocation_table_get_loaded_entry_by_index(
+	          block_allocation_table,
+	          PHDI_TEST_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES - 2,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT32(
+	 "entry",
+	 entry,
+	 PHDI_TEST_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES - 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_block_allocation_table_get_loaded_entry_by_index(
+	          block_allocation_table,
+	          0,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "block_allocation_table->pages[ 0 ]",
+	 block_allocation_table->pages[ 0 ] );
+
+	/* Retrieving an entry by index clears the referenced mark of the page
+	 */
+	result = libphdi_block_allocation_table_get_entry_by_index(
+	          block_allocation_table,
+	          file_io_pool,
+	          PHDI_TEST_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES - 2,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "block_allocation_table->pages[ 2 ]->is_referenced",
+	 block_allocation_table->pages[ 2 ]->is_referenced,
+	 0 );
+
+	/* Retrieving an entry of a loaded page marks the page as referenced
+	 */
+	result = libphdi_block_allocation_table_get_loaded_entry_by_index(
+	          block_allocation_table,
+	          LIBPHDI_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES_PER_PAGE + 7,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "block_allocation_table->pages[ 1 ]->is_referenced",
+	 block_allocation_table->pages[ 1 ]->is_referenced,
+	 1 );
+
+	/* The referenced least recently used page is given a second chance
+	 */
+	result = libphdi_block_allocation_table_get_entry_by_index(
+	          block_allocation_table,
+	          file_io_pool,
+	          0,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT32(
+	 "entry",
+	 entry,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "block_allocation_table->pages[ 1 ]",
+	 block_allocation_table->pages[ 1 ] );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "block_allocation_table->pages[ 2 ]",
+	 block_allocation_table->pages[ 2 ] );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "block_allocation_table->pages[ 1 ]->is_referenced",
+	 block_allocation_table->pages[ 1 ]->is_referenced,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libphdi_block_allocation_table_get_entry_by_index(
+	          NULL,
+	          file_io_pool,
+	          0,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_block_allocation_table_get_entry_by_index(
+	          block_allocation_table,
+	          file_io_pool,
+	          PHDI_TEST_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_block_allocation_table_get_entry_by_index(
+	          block_allocation_table,
+	          file_io_pool,
+	          0,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_block_allocation_table_free(
+	          &block_allocation_table,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "block_allocation_table",
+	 block_allocation_table );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_free(
+	          &file_io_pool,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_allocation_table != NULL )
+	{
+		libphdi_block_allocation_table_free(
+		 &block_allocation_table,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+	uint32_t entry_index = 0;
+#endif
+
+	PHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	PHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+	for( entry_index = 0;
+	     entry_index < PHDI_TEST_BLOCK_ALLOCATION_TABLE_NUMBER_OF_ENTRIES;
+	     entry_index++ )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 &( phdi_test_block_allocation_table_data1[ 64 + ( entry_index * 4 ) ] ),
+		 entry_index + 1 );
+	}
+	PHDI_TEST_RUN(
+	 "libphdi_block_allocation_table_initialize",
+	 phdi_test_block_allocation_table_initialize );
+
+	PHDI_TEST_RUN(
+	 "libphdi_block_allocation_table_free",
+	 phdi_test_block_allocation_table_free );
+
+	/* TODO: add tests for libphdi_block_allocation_table_read_page */
+
+	PHDI_TEST_RUN(
+	 "libphdi_block_allocation_table_get_entry_by_index",
+	 phdi_test_block_allocation_table_get_entry_by_index );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,614 @@
+/*
+ * Library borrowed_buffers type test program
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "phdi_test_libcerror.h"
+#include "phdi_test_libphdi.h"
+#include "phdi_test_macros.h"
+#include "phdi_test_memory.h"
+#include "phdi_test_unused.h"
+
+#include "../libphdi/libphdi_borrowed_buffers.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+/* Tests the libphdi_borrowed_buffers_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_borrowed_buffers_initialize(
+     void )
+{
+	libcerror_error_t *error                     = NULL;
+	libphdi_borrowed_buffers_t *borrowed_buffers = NULL;
+	int result                                   = 0;
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+	int number_of_malloc_fail_tests              = 2;
+	int number_of_memset_fail_tests              = 1;
+	int test_number                              = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libphdi_borrowed_buffers_initialize(
+	          &borrowed_buffers,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "borrowed_buffers",
+	 borrowed_buffers );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_borrowed_buffers_free(
+	          &borrowed_buffers,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "borrowed_buffers",
+	 borrowed_buffers );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_borrowed_buffers_initialize(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	borrowed_buffers = (libphdi_borrowed_buffers_t *) 0x12345678UL;
+
+	result = libphdi_borrowed_buffers_initialize(
+	          &borrowed_buffers,
+	          &error );
+
+	borrowed_buffers = NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_borrowed_buffers_initialize with malloc failing
+		 */
+		phdi_test_malloc_attempts_before_fail = test_number;
+
+		result = libphdi_borrowed_buffers_initialize(
+		          &borrowed_buffers,
+		          &error );
+
+		if( phdi_test_malloc_attempts_before_fail != -1 )
+		{
+			phdi_test_malloc_attempts_before_fail = -1;
+
+			if( borrowed_buffers != NULL )
+			{
+				libphdi_borrowed_buffers_free(
+				 &borrowed_buffers,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "borrowed_buffers",
+			 borrowed_buffers );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_borrowed_buffers_initialize with memset failing
+		 */
+		phdi_test_memset_attempts_before_fail = test_number;
+
+		result = libphdi_borrowed_buffers_initialize(
+		          &borrowed_buffers,
+		          &error );
+
+		if( phdi_test_memset_attempts_before_fail != -1 )
+		{
+			phdi_test_memset_attempts_before_fail = -1;
+
+			if( borrowed_buffers != NULL )
+			{
+				libphdi_borrowed_buffers_free(
+				 &borrowed_buffers,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "borrowed_buffers",
+			 borrowed_buffers );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PHDI_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( borrowed_buffers != NULL )
+	{
+		libphdi_borrowed_buffers_free(
+		 &borrowed_buffers,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_borrowed_buffers_free function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_borrowed_buffers_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libphdi_borrowed_buffers_free(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_borrowed_buffers_append_buffer and libphdi_borrowed_buffers_remove_buffer functions
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_borrowed_buffers_append_and_remove_buffer(
+     void )
+{
+	uint8_t data[ 32 ];
+
+	libcerror_error_t *error                     = NULL;
+	libphdi_borrowed_buffers_t *borrowed_buffers = NULL;
+	int number_of_buffers                        = 0;
+	int result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_borrowed_buffers_initialize(
+	          &borrowed_buffers,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "borrowed_buffers",
+	 borrowed_buffers );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_borrowed_buffers_append_buffer(
+	          borrowed_buffers,
+	          data,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The same buffer can be borrowed multiple times
+	 */
+	result = libphdi_borrowed_buffers_append_buffer(
+	          borrowed_buffers,
+	          data,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_borrowed_buffers_append_buffer(
+	          borrowed_buffers,
+	          &( data[ 16 ] ),
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_borrowed_buffers_get_number_of_buffers(
+	          borrowed_buffers,
+	          &number_of_buffers,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "number_of_buffers",
+	 number_of_buffers,
+	 3 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A buffer that was not borrowed cannot be removed
+	 */
+	result = libphdi_borrowed_buffers_remove_buffer(
+	          borrowed_buffers,
+	          &( data[ 8 ] ),
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_borrowed_buffers_remove_buffer(
+	          borrowed_buffers,
+	          data,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_borrowed_buffers_remove_buffer(
+	          borrowed_buffers,
+	          data,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A buffer cannot be removed more times than it was borrowed
+	 */
+	result = libphdi_borrowed_buffers_remove_buffer(
+	          borrowed_buffers,
+	          data,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_borrowed_buffers_get_number_of_buffers(
+	          borrowed_buffers,
+	          &number_of_buffers,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "number_of_buffers",
+	 number_of_buffers,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_borrowed_buffers_append_buffer(
+	          NULL,
+	          data,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_borrowed_buffers_append_buffer(
+	          borrowed_buffers,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_borrowed_buffers_remove_buffer(
+	          NULL,
+	          data,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_borrowed_buffers_remove_buffer(
+	          borrowed_buffers,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_borrowed_buffers_get_number_of_buffers(
+	          NULL,
+	          &number_of_buffers,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_borrowed_buffers_free(
+	          &borrowed_buffers,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "borrowed_buffers",
+	 borrowed_buffers );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( borrowed_buffers != NULL )
+	{
+		libphdi_borrowed_buffers_free(
+		 &borrowed_buffers,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	PHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+	PHDI_TEST_RUN(
+	 "libphdi_borrowed_buffers_initialize",
+	 phdi_test_borrowed_buffers_initialize );
+
+	PHDI_TEST_RUN(
+	 "libphdi_borrowed_buffers_free",
+	 phdi_test_borrowed_buffers_free );
+
+	PHDI_TEST_RUN(
+	 "libphdi_borrowed_buffers_append_buffer",
+	 phdi_test_borrowed_buffers_append_and_remove_buffer );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+}
+
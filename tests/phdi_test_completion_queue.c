@@ -0,0 +1,954 @@
+/*
+ * Library completion_queue type test program
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "phdi_test_libcerror.h"
+#include "phdi_test_libphdi.h"
+#include "phdi_test_macros.h"
+#include "phdi_test_memory.h"
+#include "phdi_test_unused.h"
+
+#include "../libphdi/libphdi_completion_queue.h"
+#include "../libphdi/libphdi_read_request.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+/* Tests the libphdi_completion_queue_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_completion_queue_initialize(
+     void )
+{
+	libcerror_error_t *error                     = NULL;
+	libphdi_completion_queue_t *completion_queue = NULL;
+	int result                                   = 0;
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+	int number_of_malloc_fail_tests              = 2;
+	int number_of_memset_fail_tests              = 2;
+	int test_number                              = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libphdi_completion_queue_initialize(
+	          &completion_queue,
+	          4,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "completion_queue",
+	 completion_queue );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_completion_queue_free(
+	          &completion_queue,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "completion_queue",
+	 completion_queue );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_completion_queue_initialize(
+	          NULL,
+	          4,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	completion_queue = (libphdi_completion_queue_t *) 0x12345678UL;
+
+	result = libphdi_completion_queue_initialize(
+	          &completion_queue,
+	          4,
+	          &error );
+
+	completion_queue = NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_completion_queue_initialize(
+	          &completion_queue,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_completion_queue_initialize with malloc failing
+		 */
+		phdi_test_malloc_attempts_before_fail = test_number;
+
+		result = libphdi_completion_queue_initialize(
+		          &completion_queue,
+		          4,
+		          &error );
+
+		if( phdi_test_malloc_attempts_before_fail != -1 )
+		{
+			phdi_test_malloc_attempts_before_fail = -1;
+
+			if( completion_queue != NULL )
+			{
+				libphdi_completion_queue_free(
+				 &completion_queue,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "completion_queue",
+			 completion_queue );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_completion_queue_initialize with memset failing
+		 */
+		phdi_test_memset_attempts_before_fail = test_number;
+
+		result = libphdi_completion_queue_initialize(
+		          &completion_queue,
+		          4,
+		          &error );
+
+		if( phdi_test_memset_attempts_before_fail != -1 )
+		{
+			phdi_test_memset_attempts_before_fail = -1;
+
+			if( completion_queue != NULL )
+			{
+				libphdi_completion_queue_free(
+				 &completion_queue,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "completion_queue",
+			 completion_queue );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PHDI_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( completion_queue != NULL )
+	{
+		libphdi_completion_queue_free(
+		 &completion_queue,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_completion_queue_free function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_completion_queue_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libphdi_completion_queue_free(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_completion_queue_reserve_request function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_completion_queue_reserve_request(
+     void )
+{
+	libcerror_error_t *error                     = NULL;
+	libphdi_completion_queue_t *completion_queue = NULL;
+	int number_of_completed_requests             = 0;
+	int number_of_pending_requests               = 0;
+	int result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_completion_queue_initialize(
+	          &completion_queue,
+	          2,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "completion_queue",
+	 completion_queue );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_completion_queue_reserve_request(
+	          completion_queue,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_completion_queue_reserve_request(
+	          completion_queue,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test reserving a request in a full completion queue
+	 */
+	result = libphdi_completion_queue_reserve_request(
+	          completion_queue,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_completion_queue_cancel_request(
+	          completion_queue,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_completion_queue_get_number_of_requests(
+	          completion_queue,
+	          &number_of_pending_requests,
+	          &number_of_completed_requests,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "number_of_pending_requests",
+	 number_of_pending_requests,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "number_of_completed_requests",
+	 number_of_completed_requests,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_completion_queue_reserve_request(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_completion_queue_cancel_request(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_completion_queue_free(
+	          &completion_queue,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "completion_queue",
+	 completion_queue );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( completion_queue != NULL )
+	{
+		libphdi_completion_queue_free(
+		 &completion_queue,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_completion_queue_complete_request and libphdi_completion_queue_get_completed_request functions
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_completion_queue_get_completed_request(
+     void )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error                     = NULL;
+	libphdi_completion_queue_t *completion_queue = NULL;
+	libphdi_read_request_t *read_request         = NULL;
+	int request_index                            = 0;
+	int result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_completion_queue_initialize(
+	          &completion_queue,
+	          2,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "completion_queue",
+	 completion_queue );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test retrieving a completed request from an empty completion queue
+	 */
+	result = libphdi_completion_queue_get_completed_request(
+	          completion_queue,
+	          1,
+	          &read_request,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "read_request",
+	 read_request );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( request_index = 0;
+	     request_index < 2;
+	     request_index++ )
+	{
+		result = libphdi_completion_queue_reserve_request(
+		          completion_queue,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libphdi_read_request_initialize(
+		          &read_request,
+		          buffer,
+		          16,
+		          (off64_t) request_index * 16,
+		          (intptr_t) request_index,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NOT_NULL(
+		 "read_request",
+		 read_request );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_request->read_count = 16;
+
+		result = libphdi_completion_queue_complete_request(
+		          completion_queue,
+		          read_request,
+		          &error );
+
+		read_request = NULL;
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Completed requests are retrieved in order of completion
+	 */
+	for( request_index = 0;
+	     request_index < 2;
+	     request_index++ )
+	{
+		result = libphdi_completion_queue_get_completed_request(
+		          completion_queue,
+		          0,
+		          &read_request,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NOT_NULL(
+		 "read_request",
+		 read_request );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "read_request->user_data",
+		 (int) read_request->user_data,
+		 request_index );
+
+		PHDI_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_request->read_count",
+		 read_request->read_count,
+		 (ssize_t) 16 );
+
+		result = libphdi_read_request_free(
+		          &read_request,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libphdi_completion_queue_get_completed_request(
+	          completion_queue,
+	          0,
+	          &read_request,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_completion_queue_complete_request(
+	          completion_queue,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_completion_queue_get_completed_request(
+	          NULL,
+	          0,
+	          &read_request,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_completion_queue_get_completed_request(
+	          completion_queue,
+	          0,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_completion_queue_free(
+	          &completion_queue,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "completion_queue",
+	 completion_queue );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_request != NULL )
+	{
+		libphdi_read_request_free(
+		 &read_request,
+		 NULL );
+	}
+	if( completion_queue != NULL )
+	{
+		libphdi_completion_queue_free(
+		 &completion_queue,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_read_request_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_read_request_initialize(
+     void )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error             = NULL;
+	libphdi_read_request_t *read_request = NULL;
+	int result                           = 0;
+
+	/* Test regular cases
+	 */
+	result = libphdi_read_request_initialize(
+	          &read_request,
+	          buffer,
+	          16,
+	          0,
+	          (intptr_t) 1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "read_request",
+	 read_request );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_request->read_count",
+	 read_request->read_count,
+	 (ssize_t) -1 );
+
+	result = libphdi_read_request_free(
+	          &read_request,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "read_request",
+	 read_request );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_read_request_initialize(
+	          NULL,
+	          buffer,
+	          16,
+	          0,
+	          (intptr_t) 1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_read_request_initialize(
+	          &read_request,
+	          NULL,
+	          16,
+	          0,
+	          (intptr_t) 1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_read_request_initialize(
+	          &read_request,
+	          buffer,
+	          16,
+	          -1,
+	          (intptr_t) 1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_read_request_free(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_request != NULL )
+	{
+		libphdi_read_request_free(
+		 &read_request,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	PHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+	PHDI_TEST_RUN(
+	 "libphdi_completion_queue_initialize",
+	 phdi_test_completion_queue_initialize );
+
+	PHDI_TEST_RUN(
+	 "libphdi_completion_queue_free",
+	 phdi_test_completion_queue_free );
+
+	PHDI_TEST_RUN(
+	 "libphdi_completion_queue_reserve_request",
+	 phdi_test_completion_queue_reserve_request );
+
+	PHDI_TEST_RUN(
+	 "libphdi_completion_queue_get_completed_request",
+	 phdi_test_completion_queue_get_completed_request );
+
+	PHDI_TEST_RUN(
+	 "libphdi_read_request_initialize",
+	 phdi_test_read_request_initialize );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,532 @@
+/*
+ * Library data_block type test program
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "phdi_test_libcerror.h"
+#include "phdi_test_libphdi.h"
+#include "phdi_test_macros.h"
+#include "phdi_test_memory.h"
+#include "phdi_test_unused.h"
+
+#include "../libphdi/libphdi_data_block.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+/* Tests the libphdi_data_block_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_data_block_initialize(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libphdi_data_block_t *data_block = NULL;
+	int result                       = 0;
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+	int number_of_malloc_fail_tests  = 2;
+	int number_of_memset_fail_tests  = 1;
+	int test_number                  = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libphdi_data_block_initialize(
+	          &data_block,
+	          512,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "data_block",
+	 data_block );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_data_block_free(
+	          &data_block,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "data_block",
+	 data_block );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_data_block_initialize(
+	          NULL,
+	          512,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	data_block = (libphdi_data_block_t *) 0x12345678UL;
+
+	result = libphdi_data_block_initialize(
+	          &data_block,
+	          512,
+	          &error );
+
+	data_block = NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_data_block_initialize(
+	          &data_block,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_data_block_initialize with malloc failing
+		 */
+		phdi_test_malloc_attempts_before_fail = test_number;
+
+		result = libphdi_data_block_initialize(
+		          &data_block,
+		          512,
+		          &error );
+
+		if( phdi_test_malloc_attempts_before_fail != -1 )
+		{
+			phdi_test_malloc_attempts_before_fail = -1;
+
+			if( data_block != NULL )
+			{
+				libphdi_data_block_free(
+				 &data_block,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "data_block",
+			 data_block );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_data_block_initialize with memset failing
+		 */
+		phdi_test_memset_attempts_before_fail = test_number;
+
+		result = libphdi_data_block_initialize(
+		          &data_block,
+		          512,
+		          &error );
+
+		if( phdi_test_memset_attempts_before_fail != -1 )
+		{
+			phdi_test_memset_attempts_before_fail = -1;
+
+			if( data_block != NULL )
+			{
+				libphdi_data_block_free(
+				 &data_block,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "data_block",
+			 data_block );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PHDI_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_block != NULL )
+	{
+		libphdi_data_block_free(
+		 &data_block,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_data_block_free function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_data_block_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libphdi_data_block_free(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_data_block_copy_data function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_data_block_copy_data(
+     void )
+{
+	uint8_t buffer[ 64 ];
+
+	libcerror_error_t *error         = NULL;
+	libphdi_data_block_t *data_block = NULL;
+	size_t data_offset               = 0;
+	ssize_t read_count               = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_data_block_initialize(
+	          &data_block,
+	          32,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "data_block",
+	 data_block );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_offset = 0;
+	     data_offset < 32;
+	     data_offset++ )
+	{
+		data_block->data[ data_offset ] = (uint8_t) data_offset;
+	}
+	/* Test regular cases
+	 */
+	read_count = libphdi_data_block_copy_data(
+	              data_block,
+	              8,
+	              buffer,
+	              16,
+	              &error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 (uint8_t) 8 );
+
+	/* Test copy beyond the end of the data block
+	 */
+	read_count = libphdi_data_block_copy_data(
+	              data_block,
+	              24,
+	              buffer,
+	              64,
+	              &error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 8 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libphdi_data_block_copy_data(
+	              NULL,
+	              0,
+	              buffer,
+	              16,
+	              &error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libphdi_data_block_copy_data(
+	              data_block,
+	              32,
+	              buffer,
+	              16,
+	              &error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libphdi_data_block_copy_data(
+	              data_block,
+	              0,
+	              NULL,
+	              16,
+	              &error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libphdi_data_block_copy_data(
+	              data_block,
+	              0,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              &error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_data_block_free(
+	          &data_block,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "data_block",
+	 data_block );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_block != NULL )
+	{
+		libphdi_data_block_free(
+		 &data_block,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	PHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+	PHDI_TEST_RUN(
+	 "libphdi_data_block_initialize",
+	 phdi_test_data_block_initialize );
+
+	PHDI_TEST_RUN(
+	 "libphdi_data_block_free",
+	 phdi_test_data_block_free );
+
+	PHDI_TEST_RUN(
+	 "libphdi_data_block_copy_data",
+	 phdi_test_data_block_copy_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,1257 @@
+/*
+ * Library data_cache type test program
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "phdi_test_libcerror.h"
+#include "phdi_test_libphdi.h"
+#include "phdi_test_macros.h"
+#include "phdi_test_memory.h"
+#include "phdi_test_unused.h"
+
+#include "../libphdi/libphdi_data_block.h"
+#include "../libphdi/libphdi_data_cache.h"
+#include "../libphdi/libphdi_definitions.h"
+
+/* Tests the libphdi_data_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_data_cache_initialize(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libphdi_data_cache_t *data_cache = NULL;
+	int result                       = 0;
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+	int number_of_malloc_fail_tests  = 1;
+	int number_of_memset_fail_tests  = 1;
+	int test_number                  = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libphdi_data_cache_initialize(
+	          &data_cache,
+	          LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS * LIBPHDI_DATA_BLOCK_SIZE,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "data_cache",
+	 data_cache );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_data_cache_free(
+	          &data_cache,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "data_cache",
+	 data_cache );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_data_cache_initialize(
+	          NULL,
+	          LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS * LIBPHDI_DATA_BLOCK_SIZE,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	data_cache = (libphdi_data_cache_t *) 0x12345678UL;
+
+	result = libphdi_data_cache_initialize(
+	          &data_cache,
+	          LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS * LIBPHDI_DATA_BLOCK_SIZE,
+	          &error );
+
+	data_cache = NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_data_cache_initialize(
+	          &data_cache,
+	          LIBPHDI_DATA_BLOCK_SIZE,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "data_cache",
+	 data_cache );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_data_cache_initialize with malloc failing
+		 */
+		phdi_test_malloc_attempts_before_fail = test_number;
+
+		result = libphdi_data_cache_initialize(
+		          &data_cache,
+		          LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS * LIBPHDI_DATA_BLOCK_SIZE,
+		          &error );
+
+		if( phdi_test_malloc_attempts_before_fail != -1 )
+		{
+			phdi_test_malloc_attempts_before_fail = -1;
+
+			if( data_cache != NULL )
+			{
+				libphdi_data_cache_free(
+				 &data_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "data_cache",
+			 data_cache );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_data_cache_initialize with memset failing
+		 */
+		phdi_test_memset_attempts_before_fail = test_number;
+
+		result = libphdi_data_cache_initialize(
+		          &data_cache,
+		          LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS * LIBPHDI_DATA_BLOCK_SIZE,
+		          &error );
+
+		if( phdi_test_memset_attempts_before_fail != -1 )
+		{
+			phdi_test_memset_attempts_before_fail = -1;
+
+			if( data_cache != NULL )
+			{
+				libphdi_data_cache_free(
+				 &data_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "data_cache",
+			 data_cache );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PHDI_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_cache != NULL )
+	{
+		libphdi_data_cache_free(
+		 &data_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_data_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_data_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libphdi_data_cache_free(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_data_cache_get_maximum_cache_size function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_data_cache_get_maximum_cache_size(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libphdi_data_cache_t *data_cache = NULL;
+	size64_t maximum_cache_size      = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_data_cache_initialize(
+	          &data_cache,
+	          2 * LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS * LIBPHDI_DATA_BLOCK_SIZE,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "data_cache",
+	 data_cache );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_data_cache_get_maximum_cache_size(
+	          data_cache,
+	          &maximum_cache_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "maximum_cache_size",
+	 (uint64_t) maximum_cache_size,
+	 (uint64_t) ( 2 * LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS * LIBPHDI_DATA_BLOCK_SIZE ) );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_data_cache_get_maximum_cache_size(
+	          NULL,
+	          &maximum_cache_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_data_cache_get_maximum_cache_size(
+	          data_cache,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_data_cache_free(
+	          &data_cache,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "data_cache",
+	 data_cache );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_cache != NULL )
+	{
+		libphdi_data_cache_free(
+		 &data_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+/* Creates a test data block
+ * Returns a pointer to the data block if successful or NULL on error
+ */
+libphdi_data_block_t *phdi_test_data_cache_create_data_block(
+                       uint8_t byte_value )
+{
+	libphdi_data_block_t *data_block = NULL;
+
+	if( libphdi_data_block_initialize(
+	     &data_block,
+	     LIBPHDI_DATA_BLOCK_SIZE,
+	     NULL ) != 1 )
+	{
+		return( NULL );
+	}
+	if( memory_set(
+	     data_block->data,
+	     byte_value,
+	     data_block->data_size ) == NULL )
+	{
+		libphdi_data_block_free(
+		 &data_block,
+		 NULL );
+
+		return( NULL );
+	}
+	return( data_block );
+}
+
+/* Tests the libphdi_data_cache_client_insert_data_block function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_data_cache_client_insert_data_block(
+     void )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error                        = NULL;
+	libphdi_data_block_t *data_block                = NULL;
+	libphdi_data_cache_client_t *data_cache_client1 = NULL;
+	libphdi_data_cache_client_t *data_cache_client2 = NULL;
+	libphdi_data_cache_t *data_cache                = NULL;
+	size64_t cache_size                             = 0;
+	ssize_t read_count                              = 0;
+	uint64_t number_of_hits                         = 0;
+	uint64_t number_of_misses                       = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_data_cache_initialize(
+	          &data_cache,
+	          LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS * LIBPHDI_DATA_BLOCK_SIZE,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "data_cache",
+	 data_cache );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_data_cache_client_initialize(
+	          &data_cache_client1,
+	          data_cache,
+	          2,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "data_cache_client1",
+	 data_cache_client1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_data_cache_client_initialize(
+	          &data_cache_client2,
+	          data_cache,
+	          1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "data_cache_client2",
+	 data_cache_client2 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The base image is shared between both clients
+	 */
+	result = libphdi_data_cache_client_set_file(
+	          data_cache_client1,
+	          0,
+	          (uint8_t *) "base.hds",
+	          9,
+	          4 * LIBPHDI_DATA_BLOCK_SIZE,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_data_cache_client_set_file(
+	          data_cache_client1,
+	          1,
+	          (uint8_t *) "delta.hds",
+	          10,
+	          4 * LIBPHDI_DATA_BLOCK_SIZE,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_data_cache_client_set_file(
+	          data_cache_client2,
+	          0,
+	          (uint8_t *) "base.hds",
+	          9,
+	          4 * LIBPHDI_DATA_BLOCK_SIZE,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "file_identifier",
+	 data_cache_client2->file_identifiers[ 0 ],
+	 data_cache_client1->file_identifiers[ 0 ] );
+
+	/* Test regular cases
+	 */
+	read_count = libphdi_data_cache_client_copy_data(
+	              data_cache_client2,
+	              0,
+	              LIBPHDI_DATA_BLOCK_SIZE,
+	              0,
+	              buffer,
+	              16,
+	              &error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_block = phdi_test_data_cache_create_data_block(
+	              0x5a );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "data_block",
+	 data_block );
+
+	result = libphdi_data_cache_client_insert_data_block(
+	          data_cache_client1,
+	          0,
+	          LIBPHDI_DATA_BLOCK_SIZE,
+	          &data_block,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "data_block",
+	 data_block );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The data block that was added by the first client is found by the second client
+	 */
+	read_count = libphdi_data_cache_client_copy_data(
+	              data_cache_client2,
+	              0,
+	              LIBPHDI_DATA_BLOCK_SIZE,
+	              512,
+	              buffer,
+	              16,
+	              &error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 0x5a );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The same offset in another file is not cached
+	 */
+	read_count = libphdi_data_cache_client_copy_data(
+	              data_cache_client1,
+	              1,
+	              LIBPHDI_DATA_BLOCK_SIZE,
+	              0,
+	              buffer,
+	              16,
+	              &error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A data block that is already cached is not inserted again
+	 */
+	data_block = phdi_test_data_cache_create_data_block(
+	              0xa5 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "data_block",
+	 data_block );
+
+	result = libphdi_data_cache_client_insert_data_block(
+	          data_cache_client2,
+	          0,
+	          LIBPHDI_DATA_BLOCK_SIZE,
+	          &data_block,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "data_block",
+	 data_block );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_data_cache_get_cache_size(
+	          data_cache,
+	          &cache_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "cache_size",
+	 (uint64_t) cache_size,
+	 (uint64_t) LIBPHDI_DATA_BLOCK_SIZE );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_data_cache_client_get_cache_size(
+	          data_cache_client1,
+	          &cache_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "cache_size",
+	 (uint64_t) cache_size,
+	 (uint64_t) LIBPHDI_DATA_BLOCK_SIZE );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_data_cache_client_get_cache_size(
+	          data_cache_client2,
+	          &cache_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "cache_size",
+	 (uint64_t) cache_size,
+	 (uint64_t) 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_data_cache_get_statistics(
+	          data_cache,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_hits",
+	 number_of_hits,
+	 (uint64_t) 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_misses",
+	 number_of_misses,
+	 (uint64_t) 2 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The cached data remains available after the client that added it is freed
+	 */
+	result = libphdi_data_cache_client_free(
+	          &data_cache_client1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "data_cache_client1",
+	 data_cache_client1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libphdi_data_cache_client_copy_data(
+	              data_cache_client2,
+	              0,
+	              LIBPHDI_DATA_BLOCK_SIZE,
+	              0,
+	              buffer,
+	              16,
+	              &error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_data_cache_free(
+	          &data_cache,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "data_cache",
+	 data_cache );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_data_cache_client_insert_data_block(
+	          NULL,
+	          0,
+	          0,
+	          &data_block,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_data_cache_client_insert_data_block(
+	          data_cache_client2,
+	          1,
+	          0,
+	          &data_block,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_data_cache_client_insert_data_block(
+	          data_cache_client2,
+	          0,
+	          0,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_data_cache_client_free(
+	          &data_cache_client2,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "data_cache_client2",
+	 data_cache_client2 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_data_cache_free(
+	          &data_cache,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "data_cache",
+	 data_cache );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_block != NULL )
+	{
+		libphdi_data_block_free(
+		 &data_block,
+		 NULL );
+	}
+	if( data_cache_client2 != NULL )
+	{
+		libphdi_data_cache_client_free(
+		 &data_cache_client2,
+		 NULL );
+	}
+	if( data_cache_client1 != NULL )
+	{
+		libphdi_data_cache_client_free(
+		 &data_cache_client1,
+		 NULL );
+	}
+	if( data_cache != NULL )
+	{
+		libphdi_data_cache_free(
+		 &data_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_data_cache_shard_evict_entry function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_data_cache_shard_evict_entry(
+     void )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error                       = NULL;
+	libphdi_data_block_t *data_block               = NULL;
+	libphdi_data_cache_client_t *data_cache_client = NULL;
+	libphdi_data_cache_t *data_cache               = NULL;
+	size64_t cache_size                            = 0;
+	ssize_t read_count                             = 0;
+	off64_t file_offset                            = 0;
+	int block_index                                = 0;
+	int number_of_cached_blocks                    = 0;
+	int result                                     = 0;
+
+	/* Initialize test, every shard can contain a single data block
+	 */
+	result = libphdi_data_cache_initialize(
+	          &data_cache,
+	          LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS * LIBPHDI_DATA_BLOCK_SIZE,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_data_cache_client_initialize(
+	          &data_cache_client,
+	          data_cache,
+	          1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_data_cache_client_set_file(
+	          data_cache_client,
+	          0,
+	          (uint8_t *) "base.hds",
+	          9,
+	          256 * LIBPHDI_DATA_BLOCK_SIZE,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( block_index = 0;
+	     block_index < 256;
+	     block_index++ )
+	{
+		data_block = phdi_test_data_cache_create_data_block(
+		              (uint8_t) block_index );
+
+		PHDI_TEST_ASSERT_IS_NOT_NULL(
+		 "data_block",
+		 data_block );
+
+		file_offset = (off64_t) block_index * LIBPHDI_DATA_BLOCK_SIZE;
+
+		result = libphdi_data_cache_client_insert_data_block(
+		          data_cache_client,
+		          0,
+		          file_offset,
+		          &data_block,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* The size of the cached data does not exceed the maximum cache size
+	 */
+	result = libphdi_data_cache_get_cache_size(
+	          data_cache,
+	          &cache_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_LESS_THAN_UINT64(
+	 "cache_size",
+	 (uint64_t) cache_size,
+	 (uint64_t) ( LIBPHDI_DATA_CACHE_NUMBER_OF_SHARDS * LIBPHDI_DATA_BLOCK_SIZE ) + 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The last inserted data block is the most recently used entry of its shard
+	 */
+	read_count = libphdi_data_cache_client_copy_data(
+	              data_cache_client,
+	              0,
+	              file_offset,
+	              0,
+	              buffer,
+	              16,
+	              &error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 255 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( block_index = 0;
+	     block_index < 256;
+	     block_index++ )
+	{
+		file_offset = (off64_t) block_index * LIBPHDI_DATA_BLOCK_SIZE;
+
+		read_count = libphdi_data_cache_client_copy_data(
+		              data_cache_client,
+		              0,
+		              file_offset,
+		              0,
+		              buffer,
+		              16,
+		              &error );
+
+		PHDI_TEST_ASSERT_NOT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		if( read_count > 0 )
+		{
+			number_of_cached_blocks++;
+		}
+	}
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "cache_size",
+	 (uint64_t) cache_size,
+	 (uint64_t) number_of_cached_blocks * LIBPHDI_DATA_BLOCK_SIZE );
+
+	/* Clean up
+	 */
+	result = libphdi_data_cache_client_free(
+	          &data_cache_client,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_data_cache_free(
+	          &data_cache,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_block != NULL )
+	{
+		libphdi_data_block_free(
+		 &data_block,
+		 NULL );
+	}
+	if( data_cache_client != NULL )
+	{
+		libphdi_data_cache_client_free(
+		 &data_cache_client,
+		 NULL );
+	}
+	if( data_cache != NULL )
+	{
+		libphdi_data_cache_free(
+		 &data_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	PHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+	PHDI_TEST_RUN(
+	 "libphdi_data_cache_initialize",
+	 phdi_test_data_cache_initialize );
+
+	PHDI_TEST_RUN(
+	 "libphdi_data_cache_free",
+	 phdi_test_data_cache_free );
+
+	PHDI_TEST_RUN(
+	 "libphdi_data_cache_get_maximum_cache_size",
+	 phdi_test_data_cache_get_maximum_cache_size );
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+	PHDI_TEST_RUN(
+	 "libphdi_data_cache_client_insert_data_block",
+	 phdi_test_data_cache_client_insert_data_block );
+
+	PHDI_TEST_RUN(
+	 "libphdi_data_cache_shard_evict_entry",
+	 phdi_test_data_cache_shard_evict_entry );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
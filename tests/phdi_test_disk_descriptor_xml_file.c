@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -31,6 +32,7 @@
 #include "phdi_test_libbfio.h"
 #include "phdi_test_libcdata.h"
 #include "phdi_test_libcerror.h"
+#include "phdi_test_libcthreads.h"
 #include "phdi_test_libphdi.h"
 #include "phdi_test_macros.h"
 #include "phdi_test_memory.h"
@@ -41,6 +43,49 @@
 #include "../libphdi/libphdi_extent_values.h"
 #include "../libphdi/libphdi_snapshot_values.h"
 
+/* Disk descriptor XML file data terminated by 2 zero bytes
+ */
+uint8_t phdi_test_disk_descriptor_xml_file_data1[] =
+	"<?xml version='1.0' encoding='UTF-8'?>\n"
+	"<Parallels_disk_image Version=\"1.0\">\n"
+	"    <Disk_Parameters>\n"
+	"        <Disk_size>8192</Disk_size>\n"
+	"        <Cylinders>8</Cylinders>\n"
+	"        <Heads>16</Heads>\n"
+	"        <Sectors>32</Sectors>\n"
+	"        <Padding>0</Padding>\n"
+	"        <Name>test</Name>\n"
+	"    </Disk_Parameters>\n"
+	"    <StorageData>\n"
+	"        <Storage>\n"
+	"            <Start>0</Start>\n"
+	"            <End>8192</End>\n"
+	"            <Blocksize>2048</Blocksize>\n"
+	"            <Image>\n"
+	"                <GUID>{5fbaabe3-6958-40ff-92a7-860e329aab41}</GUID>\n"
+	"                <Type>Compressed</Type>\n"
+	"                <File>test.hds</File>\n"
+	"            </Image>\n"
+	"        </Storage>\n"
+	"    </StorageData>\n"
+	"    <Snapshots>\n"
+	"        <Shot>\n"
+	"            <GUID>{5fbaabe3-6958-40ff-92a7-860e329aab41}</GUID>\n"
+	"            <ParentGUID>{00000000-0000-0000-0000-000000000000}</ParentGUID>\n"
+	"        </Shot>\n"
+	"    </Snapshots>\n"
+	"</Parallels_disk_image>\n"
+	"\0";
+
+/* Disk descriptor XML file data with mismatching tags terminated by 2 zero bytes
+ */
+uint8_t phdi_test_disk_descriptor_xml_file_error_data1[] =
+	"<Parallels_disk_image>\n"
+	"    <Disk_Parameters>\n"
+	"    </StorageData>\n"
+	"</Parallels_disk_image>\n"
+	"\0";
+
 #if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
 
 /* Tests the libphdi_disk_descriptor_xml_file_initialize function
@@ -276,6 +321,401 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libphdi_disk_descriptor_xml_file_read_data function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_disk_descriptor_xml_file_read_data(
+     void )
+{
+	uint8_t data[ sizeof( phdi_test_disk_descriptor_xml_file_data1 ) ];
+
+	libcerror_error_t *error                                     = NULL;
+	libphdi_disk_descriptor_xml_file_t *disk_descriptor_xml_file = NULL;
+	void *memcpy_result                                          = NULL;
+	int result                                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_disk_descriptor_xml_file_initialize(
+	          &disk_descriptor_xml_file,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "disk_descriptor_xml_file",
+	 disk_descriptor_xml_file );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The scanner modifies the data hence a copy is used
+	 */
+	memcpy_result = memory_copy(
+	                 data,
+	                 phdi_test_disk_descriptor_xml_file_data1,
+	                 sizeof( phdi_test_disk_descriptor_xml_file_data1 ) );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "memcpy_result",
+	 memcpy_result );
+
+	/* Test regular cases
+	 */
+	result = libphdi_disk_descriptor_xml_file_read_data(
+	          disk_descriptor_xml_file,
+	          data,
+	          sizeof( phdi_test_disk_descriptor_xml_file_data1 ),
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "disk_descriptor_xml_file->disk_parameters_tag",
+	 disk_descriptor_xml_file->disk_parameters_tag );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "disk_descriptor_xml_file->storage_data_tag",
+	 disk_descriptor_xml_file->storage_data_tag );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "disk_descriptor_xml_file->snapshots_tag",
+	 disk_descriptor_xml_file->snapshots_tag );
+
+	/* Test error cases
+	 */
+	result = libphdi_disk_descriptor_xml_file_read_data(
+	          NULL,
+	          data,
+	          sizeof( phdi_test_disk_descriptor_xml_file_data1 ),
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libphdi_disk_descriptor_xml_file_read_data with root tag already set
+	 */
+	result = libphdi_disk_descriptor_xml_file_read_data(
+	          disk_descriptor_xml_file,
+	          data,
+	          sizeof( phdi_test_disk_descriptor_xml_file_data1 ),
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_disk_descriptor_xml_file_free(
+	          &disk_descriptor_xml_file,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "disk_descriptor_xml_file",
+	 disk_descriptor_xml_file );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Initialize test
+	 */
+	result = libphdi_disk_descriptor_xml_file_initialize(
+	          &disk_descriptor_xml_file,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "disk_descriptor_xml_file",
+	 disk_descriptor_xml_file );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_disk_descriptor_xml_file_read_data(
+	          disk_descriptor_xml_file,
+	          NULL,
+	          sizeof( phdi_test_disk_descriptor_xml_file_data1 ),
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_disk_descriptor_xml_file_read_data(
+	          disk_descriptor_xml_file,
+	          data,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libphdi_disk_descriptor_xml_file_read_data with mismatching tags
+	 */
+	memcpy_result = memory_copy(
+	                 data,
+	                 phdi_test_disk_descriptor_xml_file_error_data1,
+	                 sizeof( phdi_test_disk_descriptor_xml_file_error_data1 ) );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "memcpy_result",
+	 memcpy_result );
+
+	result = libphdi_disk_descriptor_xml_file_read_data(
+	          disk_descriptor_xml_file,
+	          data,
+	          sizeof( phdi_test_disk_descriptor_xml_file_error_data1 ),
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_disk_descriptor_xml_file_free(
+	          &disk_descriptor_xml_file,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "disk_descriptor_xml_file",
+	 disk_descriptor_xml_file );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( disk_descriptor_xml_file != NULL )
+	{
+		libphdi_disk_descriptor_xml_file_free(
+		 &disk_descriptor_xml_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBPHDI )
+
+/* Reads the disk descriptor XML file data repeatedly from a thread
+ * Returns 1 if successful or -1 on error
+ */
+int phdi_test_disk_descriptor_xml_file_read_data_thread_function(
+     int *thread_result )
+{
+	uint8_t data[ sizeof( phdi_test_disk_descriptor_xml_file_data1 ) ];
+
+	libphdi_disk_descriptor_xml_file_t *disk_descriptor_xml_file = NULL;
+	int iteration                                                = 0;
+	int result                                                   = 0;
+
+	*thread_result = 0;
+
+	for( iteration = 0;
+	     iteration < 256;
+	     iteration++ )
+	{
+		if( memory_copy(
+		     data,
+		     phdi_test_disk_descriptor_xml_file_data1,
+		     sizeof( phdi_test_disk_descriptor_xml_file_data1 ) ) == NULL )
+		{
+			return( -1 );
+		}
+		if( libphdi_disk_descriptor_xml_file_initialize(
+		     &disk_descriptor_xml_file,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+		result = libphdi_disk_descriptor_xml_file_read_data(
+		          disk_descriptor_xml_file,
+		          data,
+		          sizeof( phdi_test_disk_descriptor_xml_file_data1 ),
+		          NULL );
+
+		if( ( result == 1 )
+		 && ( ( disk_descriptor_xml_file->disk_parameters_tag == NULL )
+		  ||  ( disk_descriptor_xml_file->storage_data_tag == NULL )
+		  ||  ( disk_descriptor_xml_file->snapshots_tag == NULL ) ) )
+		{
+			result = -1;
+		}
+		if( libphdi_disk_descriptor_xml_file_free(
+		     &disk_descriptor_xml_file,
+		     NULL ) != 1 )
+		{
+			result = -1;
+		}
+		if( result != 1 )
+		{
+			return( -1 );
+		}
+	}
+	*thread_result = 1;
+
+	return( 1 );
+}
+
+/* Tests the libphdi_disk_descriptor_xml_file_read_data function from multiple threads
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_disk_descriptor_xml_file_read_data_threaded(
+     void )
+{
+	libcthreads_thread_t *threads[ 4 ] = { NULL, NULL, NULL, NULL };
+	libcerror_error_t *error           = NULL;
+	int thread_results[ 4 ]            = { 0, 0, 0, 0 };
+	int thread_index                   = 0;
+	int result                         = 0;
+
+	/* Test regular cases
+	 */
+	for( thread_index = 0;
+	     thread_index < 4;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_create(
+		          &( threads[ thread_index ] ),
+		          NULL,
+		          (int (*)(void *)) &phdi_test_disk_descriptor_xml_file_read_data_thread_function,
+		          (void *) &( thread_results[ thread_index ] ),
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( thread_index = 0;
+	     thread_index < 4;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_join(
+		          &( threads[ thread_index ] ),
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "thread_result",
+		 thread_results[ thread_index ],
+		 1 );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( thread_index = 0;
+	     thread_index < 4;
+	     thread_index++ )
+	{
+		if( threads[ thread_index ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( threads[ thread_index ] ),
+			 NULL );
+		}
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBPHDI ) */
+
 /* Tests the libphdi_disk_descriptor_xml_file_get_disk_parameters function
  * Returns 1 if successful or 0 if not
  */
@@ -631,7 +1071,17 @@ int main(
 	 "libphdi_disk_descriptor_xml_file_free",
 	 phdi_test_disk_descriptor_xml_file_free );
 
-	/* TODO: add tests for libphdi_disk_descriptor_xml_file_read_data */
+	PHDI_TEST_RUN(
+	 "libphdi_disk_descriptor_xml_file_read_data",
+	 phdi_test_disk_descriptor_xml_file_read_data );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBPHDI )
+
+	PHDI_TEST_RUN(
+	 "libphdi_disk_descriptor_xml_file_read_data_threaded",
+	 phdi_test_disk_descriptor_xml_file_read_data_threaded );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBPHDI ) */
 
 	/* TODO: add tests for libphdi_disk_descriptor_xml_file_read_file_io_handle */
 
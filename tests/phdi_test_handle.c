@@ -1690,6 +1690,7 @@ int phdi_test_handle_read_buffer_at_offset(
 	size64_t remaining_media_size = 0;
 	size_t read_size              = 0;
 	ssize_t read_count            = 0;
+	off64_t current_offset        = 0;
 	off64_t offset                = 0;
 	off64_t read_offset           = 0;
 	int number_of_tests           = 1024;
@@ -1737,6 +1738,37 @@ int phdi_test_handle_read_buffer_at_offset(
 	 "error",
 	 error );
 
+	/* An abort signalled before the read started should not abort the read
+	 */
+	result = libphdi_handle_signal_abort(
+	          handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libphdi_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              PHDI_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	if( media_size > 8 )
 	{
 		/* Read buffer on media_size boundary
@@ -1775,6 +1807,22 @@ int phdi_test_handle_read_buffer_at_offset(
 		 "error",
 		 error );
 	}
+	/* Reading at a specific offset should not change the current offset
+	 */
+	result = libphdi_handle_get_offset(
+	          handle,
+	          &current_offset,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	/* Stress test read buffer
 	 */
 	timestamp = time(
@@ -1830,8 +1878,6 @@ int phdi_test_handle_read_buffer_at_offset(
 		 "error",
 		 error );
 
-		read_offset += read_count;
-
 		result = libphdi_handle_get_offset(
 		          handle,
 		          &offset,
@@ -1845,7 +1891,7 @@ int phdi_test_handle_read_buffer_at_offset(
 		PHDI_TEST_ASSERT_EQUAL_INT64(
 		 "offset",
 		 offset,
-		 read_offset );
+		 current_offset );
 
 		PHDI_TEST_ASSERT_IS_NULL(
 		 "error",
@@ -2381,169 +2427,3481 @@ on_error:
 	return( 0 );
 }
 
-/* The main program
+/* Tests the libphdi_handle_get_data_block_cache_size and libphdi_handle_set_data_block_cache_size functions
+ * Returns 1 if successful or 0 if not
  */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-int wmain(
-     int argc,
-     wchar_t * const argv[] )
-#else
-int main(
-     int argc,
-     char * const argv[] )
-#endif
+int phdi_test_handle_data_block_cache_size(
+     void )
 {
-	libbfio_handle_t *file_io_handle = NULL;
-	libcerror_error_t *error         = NULL;
-	libphdi_handle_t *handle         = NULL;
-	system_character_t *source       = NULL;
-	system_integer_t option          = 0;
-	size_t string_length             = 0;
-	int result                       = 0;
+	libcerror_error_t *error = NULL;
+	libphdi_handle_t *handle = NULL;
+	size64_t cache_size      = 0;
+	int result               = 0;
 
-	while( ( option = phdi_test_getopt(
-	                   argc,
-	                   argv,
-	                   _SYSTEM_STRING( "" ) ) ) != (system_integer_t) -1 )
-	{
-		switch( option )
-		{
-			case (system_integer_t) '?':
-			default:
-				fprintf(
-				 stderr,
-				 "Invalid argument: %" PRIs_SYSTEM ".\n",
-				 argv[ optind - 1 ] );
+	/* Initialize test
+	 */
+	result = libphdi_handle_initialize(
+	          &handle,
+	          &error );
 
-				return( EXIT_FAILURE );
-		}
-	}
-	if( optind < argc )
-	{
-		source = argv[ optind ];
-	}
-#if defined( HAVE_DEBUG_OUTPUT ) && defined( PHDI_TEST_HANDLE_VERBOSE )
-	libphdi_notify_set_verbose(
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
 	 1 );
-	libphdi_notify_set_stream(
-	 stderr,
-	 NULL );
-#endif
 
-	PHDI_TEST_RUN(
-	 "libphdi_handle_initialize",
-	 phdi_test_handle_initialize );
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
 
-	PHDI_TEST_RUN(
-	 "libphdi_handle_free",
-	 phdi_test_handle_free );
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
-	if( source != NULL )
-	{
-		result = libbfio_file_initialize(
-		          &file_io_handle,
-		          &error );
+	/* Test regular cases
+	 */
+	result = libphdi_handle_get_data_block_cache_size(
+	          handle,
+	          &cache_size,
+	          &error );
 
-		PHDI_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	        PHDI_TEST_ASSERT_IS_NOT_NULL(
-	         "file_io_handle",
-	         file_io_handle );
+	PHDI_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "cache_size",
+	 (int64_t) cache_size,
+	 (int64_t) 0 );
 
-	        PHDI_TEST_ASSERT_IS_NULL(
-	         "error",
-	         error );
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		string_length = system_string_length(
-		                 source );
+	result = libphdi_handle_set_data_block_cache_size(
+	          handle,
+	          ( 4 * 1024 * 1024 ) + 1,
+	          &error );
 
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		result = libbfio_file_set_name_wide(
-		          file_io_handle,
-		          source,
-		          string_length,
-		          &error );
-#else
-		result = libbfio_file_set_name(
-		          file_io_handle,
-		          source,
-		          string_length,
-		          &error );
-#endif
-		PHDI_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	        PHDI_TEST_ASSERT_IS_NULL(
-	         "error",
-	         error );
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		result = libphdi_check_file_signature_file_io_handle(
-		          file_io_handle,
-		          &error );
+	result = libphdi_handle_get_data_block_cache_size(
+	          handle,
+	          &cache_size,
+	          &error );
 
-		PHDI_TEST_ASSERT_NOT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		PHDI_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-	}
-	if( result != 0 )
-	{
-		PHDI_TEST_RUN_WITH_ARGS(
-		 "libphdi_handle_open",
-		 phdi_test_handle_open,
-		 source );
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "cache_size",
+	 (uint64_t) cache_size,
+	 (uint64_t) ( 4 * 1024 * 1024 ) );
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		PHDI_TEST_RUN_WITH_ARGS(
-		 "libphdi_handle_open_wide",
-		 phdi_test_handle_open_wide,
-		 source );
+	result = libphdi_handle_set_data_block_cache_size(
+	          handle,
+	          0,
+	          &error );
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		PHDI_TEST_RUN_WITH_ARGS(
-		 "libphdi_handle_open_file_io_handle",
-		 phdi_test_handle_open_file_io_handle,
-		 source );
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		PHDI_TEST_RUN(
-		 "libphdi_handle_close",
-		 phdi_test_handle_close );
+	result = libphdi_handle_get_data_block_cache_size(
+	          handle,
+	          &cache_size,
+	          &error );
 
-		PHDI_TEST_RUN_WITH_ARGS(
-		 "libphdi_handle_open_close",
-		 phdi_test_handle_open_close,
-		 source );
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		/* Initialize handle for tests
-		 */
-		result = phdi_test_handle_open_source(
-		          &handle,
-		          source,
-		          file_io_handle,
-		          &error );
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "cache_size",
+	 (uint64_t) cache_size,
+	 (uint64_t) 0 );
 
-		PHDI_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		PHDI_TEST_ASSERT_IS_NOT_NULL(
-		 "handle",
-		 handle );
+	/* Test error cases
+	 */
+	result = libphdi_handle_get_data_block_cache_size(
+	          NULL,
+	          &cache_size,
+	          &error );
 
-		PHDI_TEST_ASSERT_IS_NULL(
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_data_block_cache_size(
+	          handle,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_set_data_block_cache_size(
+	          NULL,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_set_data_block_cache_size(
+	          handle,
+	          1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_handle_free(
+	          &handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libphdi_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_handle_get_data_block_cache_statistics function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_handle_get_data_block_cache_statistics(
+     libphdi_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error  = NULL;
+	uint64_t number_of_hits   = 0;
+	uint64_t number_of_misses = 0;
+	size64_t media_size       = 0;
+	ssize_t read_count        = 0;
+	int result                = 0;
+
+	/* Determine size
+	 */
+	result = libphdi_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 16 )
+	{
+		/* Read the same partial data block twice to cause a cache hit
+		 */
+		read_count = libphdi_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              0,
+		              &error );
+
+		PHDI_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libphdi_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              0,
+		              &error );
+
+		PHDI_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libphdi_handle_get_data_block_cache_statistics(
+	          handle,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size > 16 )
+	{
+		PHDI_TEST_ASSERT_NOT_EQUAL_INT64(
+		 "number_of_hits",
+		 (int64_t) number_of_hits,
+		 (int64_t) 0 );
+	}
+	/* Test error cases
+	 */
+	result = libphdi_handle_get_data_block_cache_statistics(
+	          NULL,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_data_block_cache_statistics(
+	          handle,
+	          NULL,
+	          &number_of_misses,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_data_block_cache_statistics(
+	          handle,
+	          &number_of_hits,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_handle_get_statistics function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_handle_get_statistics(
+     libphdi_handle_t *handle )
+{
+	uint64_t values[ LIBPHDI_STATISTIC_IO_TIME + 1 ];
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	uint64_t number_of_bytes = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libphdi_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_handle_reset_statistics(
+	          handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_handle_set_measure_io_time(
+	          handle,
+	          1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size > 16 )
+	{
+		read_count = libphdi_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              0,
+		              &error );
+
+		PHDI_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libphdi_handle_get_statistics(
+	          handle,
+	          values,
+	          LIBPHDI_STATISTIC_IO_TIME + 1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size > 16 )
+	{
+		PHDI_TEST_ASSERT_EQUAL_UINT64(
+		 "values[ LIBPHDI_STATISTIC_LOGICAL_BYTES_READ ]",
+		 values[ LIBPHDI_STATISTIC_LOGICAL_BYTES_READ ],
+		 (uint64_t) 16 );
+	}
+	result = libphdi_handle_get_snapshot_depth_statistics(
+	          handle,
+	          0,
+	          &number_of_bytes,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_handle_reset_statistics(
+	          handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_handle_get_statistics(
+	          handle,
+	          values,
+	          LIBPHDI_STATISTIC_IO_TIME + 1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBPHDI_STATISTIC_LOGICAL_BYTES_READ ]",
+	 values[ LIBPHDI_STATISTIC_LOGICAL_BYTES_READ ],
+	 (uint64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libphdi_handle_get_statistics(
+	          NULL,
+	          values,
+	          LIBPHDI_STATISTIC_IO_TIME + 1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_statistics(
+	          handle,
+	          NULL,
+	          LIBPHDI_STATISTIC_IO_TIME + 1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_snapshot_depth_statistics(
+	          handle,
+	          -1,
+	          &number_of_bytes,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_reset_statistics(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_set_measure_io_time(
+	          NULL,
+	          1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_handle_get_next_data_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_handle_get_next_data_offset(
+     libphdi_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	off64_t data_offset      = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libphdi_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_handle_get_next_data_offset(
+	          handle,
+	          0,
+	          0,
+	          &data_offset,
+	          &error );
+
+	PHDI_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result != 0 )
+	{
+		PHDI_TEST_ASSERT_LESS_THAN_UINT64(
+		 "data_offset",
+		 (uint64_t) data_offset,
+		 (uint64_t) media_size );
+	}
+	result = libphdi_handle_get_next_data_offset(
+	          handle,
+	          0,
+	          LIBPHDI_ALLOCATION_FLAG_CURRENT_SNAPSHOT_ONLY,
+	          &data_offset,
+	          &error );
+
+	PHDI_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_handle_get_next_data_offset(
+	          handle,
+	          (off64_t) media_size,
+	          0,
+	          &data_offset,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_handle_get_next_data_offset(
+	          NULL,
+	          0,
+	          0,
+	          &data_offset,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_next_data_offset(
+	          handle,
+	          -1,
+	          0,
+	          &data_offset,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_next_data_offset(
+	          handle,
+	          0,
+	          0xff,
+	          &data_offset,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_next_data_offset(
+	          handle,
+	          0,
+	          0,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_handle_get_next_hole_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_handle_get_next_hole_offset(
+     libphdi_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	off64_t hole_offset      = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libphdi_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 0 )
+	{
+		result = libphdi_handle_get_next_hole_offset(
+		          handle,
+		          0,
+		          0,
+		          &hole_offset,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		PHDI_TEST_ASSERT_LESS_THAN_UINT64(
+		 "hole_offset",
+		 (uint64_t) hole_offset,
+		 (uint64_t) media_size + 1 );
+
+		result = libphdi_handle_get_next_hole_offset(
+		          handle,
+		          0,
+		          LIBPHDI_ALLOCATION_FLAG_CURRENT_SNAPSHOT_ONLY,
+		          &hole_offset,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libphdi_handle_get_next_hole_offset(
+	          handle,
+	          (off64_t) media_size,
+	          0,
+	          &hole_offset,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_handle_get_next_hole_offset(
+	          NULL,
+	          0,
+	          0,
+	          &hole_offset,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_next_hole_offset(
+	          handle,
+	          -1,
+	          0,
+	          &hole_offset,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_next_hole_offset(
+	          handle,
+	          0,
+	          0xff,
+	          &hole_offset,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_next_hole_offset(
+	          handle,
+	          0,
+	          0,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_handle_get_allocated_range function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_handle_get_allocated_range(
+     libphdi_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	size64_t range_size      = 0;
+	off64_t offset           = 0;
+	off64_t range_offset     = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libphdi_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	do
+	{
+		result = libphdi_handle_get_allocated_range(
+		          handle,
+		          offset,
+		          0,
+		          &range_offset,
+		          &range_size,
+		          &error );
+
+		PHDI_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( result != 0 )
+		{
+			PHDI_TEST_ASSERT_LESS_THAN_UINT64(
+			 "range_offset",
+			 (uint64_t) range_offset,
+			 (uint64_t) media_size );
+
+			PHDI_TEST_ASSERT_NOT_EQUAL_INT64(
+			 "range_size",
+			 (int64_t) range_size,
+			 (int64_t) 0 );
+
+			PHDI_TEST_ASSERT_LESS_THAN_UINT64(
+			 "range_size",
+			 (uint64_t) range_size,
+			 (uint64_t) ( media_size - range_offset ) + 1 );
+
+			PHDI_TEST_ASSERT_LESS_THAN_UINT64(
+			 "offset",
+			 (uint64_t) offset,
+			 (uint64_t) ( range_offset + range_size ) );
+
+			offset = range_offset + (off64_t) range_size;
+		}
+	}
+	while( result != 0 );
+
+	result = libphdi_handle_get_allocated_range(
+	          handle,
+	          (off64_t) media_size,
+	          LIBPHDI_ALLOCATION_FLAG_CURRENT_SNAPSHOT_ONLY,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_handle_get_allocated_range(
+	          NULL,
+	          0,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_allocated_range(
+	          handle,
+	          -1,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_allocated_range(
+	          handle,
+	          0,
+	          0xff,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_allocated_range(
+	          handle,
+	          0,
+	          0,
+	          NULL,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_allocated_range(
+	          handle,
+	          0,
+	          0,
+	          &range_offset,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_handle_get_readahead_window_size and libphdi_handle_set_readahead_window_size functions
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_handle_readahead_window_size(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	libphdi_handle_t *handle = NULL;
+	size64_t window_size     = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_handle_initialize(
+	          &handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_handle_get_readahead_window_size(
+	          handle,
+	          &window_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "window_size",
+	 (uint64_t) window_size,
+	 (uint64_t) 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBPHDI )
+	result = libphdi_handle_set_readahead_window_size(
+	          handle,
+	          ( 1024 * 1024 ) + 1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_handle_get_readahead_window_size(
+	          handle,
+	          &window_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "window_size",
+	 (uint64_t) window_size,
+	 (uint64_t) ( 1024 * 1024 ) );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_handle_set_readahead_window_size(
+	          handle,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_handle_get_readahead_window_size(
+	          handle,
+	          &window_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "window_size",
+	 (uint64_t) window_size,
+	 (uint64_t) 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#else
+	result = libphdi_handle_set_readahead_window_size(
+	          handle,
+	          1024 * 1024,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBPHDI ) */
+
+	/* Test error cases
+	 */
+	result = libphdi_handle_get_readahead_window_size(
+	          NULL,
+	          &window_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_readahead_window_size(
+	          handle,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_set_readahead_window_size(
+	          NULL,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_set_readahead_window_size(
+	          handle,
+	          1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_handle_free(
+	          &handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libphdi_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_handle_get_number_of_metadata_prefetch_threads and libphdi_handle_set_number_of_metadata_prefetch_threads functions
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_handle_number_of_metadata_prefetch_threads(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	libphdi_handle_t *handle = NULL;
+	int number_of_threads    = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_handle_initialize(
+	          &handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_handle_get_number_of_metadata_prefetch_threads(
+	          handle,
+	          &number_of_threads,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_handle_set_number_of_metadata_prefetch_threads(
+	          handle,
+	          4,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_handle_get_number_of_metadata_prefetch_threads(
+	          handle,
+	          &number_of_threads,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 4 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_handle_set_number_of_metadata_prefetch_threads(
+	          handle,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_handle_get_number_of_metadata_prefetch_threads(
+	          handle,
+	          &number_of_threads,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_handle_get_number_of_metadata_prefetch_threads(
+	          NULL,
+	          &number_of_threads,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_number_of_metadata_prefetch_threads(
+	          handle,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_set_number_of_metadata_prefetch_threads(
+	          NULL,
+	          4,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_set_number_of_metadata_prefetch_threads(
+	          handle,
+	          -1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_set_number_of_metadata_prefetch_threads(
+	          handle,
+	          1024,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libphdi_handle_warm_metadata with a handle without extent data files
+	 */
+	result = libphdi_handle_warm_metadata(
+	          handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_warm_metadata(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_handle_free(
+	          &handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libphdi_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_handle_warm_metadata function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_handle_warm_metadata(
+     libphdi_handle_t *handle )
+{
+	libcerror_error_t *error  = NULL;
+	uint64_t number_of_hits   = 0;
+	uint64_t number_of_misses = 0;
+	uint64_t warm_misses      = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libphdi_handle_warm_metadata(
+	          handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_handle_get_extent_files_cache_statistics(
+	          handle,
+	          &number_of_hits,
+	          &warm_misses,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The storage images that are already cached are not read again
+	 */
+	result = libphdi_handle_warm_metadata(
+	          handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_handle_get_extent_files_cache_statistics(
+	          handle,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_misses",
+	 number_of_misses,
+	 warm_misses );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_handle_read_vector function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_handle_read_vector(
+     libphdi_handle_t *handle )
+{
+	uint8_t expected_buffer[ 4096 ];
+	uint8_t vector_buffers[ 4 ][ 4096 ];
+	void *buffers[ 4 ];
+	size_t buffer_sizes[ 4 ];
+	off64_t offsets[ 4 ];
+	ssize_t read_counts[ 4 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	size_t buffer_index      = 0;
+	int request_index        = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libphdi_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The requests are not in order, the third request is partially beyond
+	 * the end of the media data and the fourth request is fully beyond it
+	 */
+	for( request_index = 0;
+	     request_index < 4;
+	     request_index++ )
+	{
+		buffers[ request_index ]      = vector_buffers[ request_index ];
+		buffer_sizes[ request_index ] = 4096;
+	}
+	offsets[ 0 ] = (off64_t) ( media_size / 2 );
+	offsets[ 1 ] = 0;
+	offsets[ 2 ] = ( media_size > 1024 ) ? (off64_t) ( media_size - 1024 ) : 0;
+	offsets[ 3 ] = (off64_t) media_size + 4096;
+
+	result = libphdi_handle_read_vector(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          4,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( request_index = 0;
+	     request_index < 4;
+	     request_index++ )
+	{
+		read_count = libphdi_handle_read_buffer_at_offset(
+		              handle,
+		              expected_buffer,
+		              4096,
+		              offsets[ request_index ],
+		              &error );
+
+		PHDI_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_counts[ request_index ],
+		 read_count );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( buffer_index = 0;
+		     buffer_index < (size_t) read_count;
+		     buffer_index++ )
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "vector_buffers[ request_index ][ buffer_index ]",
+			 (int) vector_buffers[ request_index ][ buffer_index ],
+			 (int) expected_buffer[ buffer_index ] );
+		}
+	}
+	result = libphdi_handle_read_vector(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_handle_read_vector(
+	          NULL,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          4,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_read_vector(
+	          handle,
+	          NULL,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          4,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_read_vector(
+	          handle,
+	          buffers,
+	          NULL,
+	          offsets,
+	          read_counts,
+	          4,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_read_vector(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          NULL,
+	          read_counts,
+	          4,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_read_vector(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          NULL,
+	          4,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_read_vector(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          -1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offsets[ 1 ] = -1;
+
+	result = libphdi_handle_read_vector(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          4,
+	          &error );
+
+	offsets[ 1 ] = 0;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	buffers[ 1 ] = NULL;
+
+	result = libphdi_handle_read_vector(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          4,
+	          &error );
+
+	buffers[ 1 ] = vector_buffers[ 1 ];
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_handle_submit_read_buffer_at_offset and libphdi_handle_get_completed_read functions
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_handle_submit_read_buffer_at_offset(
+     libphdi_handle_t *handle )
+{
+	uint8_t expected_buffer[ 4096 ];
+	uint8_t read_buffers[ 4 ][ 4096 ];
+	off64_t offsets[ 4 ];
+
+	libcerror_error_t *error        = NULL;
+	intptr_t user_data              = 0;
+	size64_t media_size             = 0;
+	ssize_t expected_read_count     = 0;
+	ssize_t read_count              = 0;
+	size_t buffer_index             = 0;
+	int number_of_outstanding_reads = 0;
+	int request_index               = 0;
+	int result                      = 0;
+
+	/* Determine size
+	 */
+	result = libphdi_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The fourth read is beyond the end of the media data
+	 */
+	offsets[ 0 ] = (off64_t) ( media_size / 2 );
+	offsets[ 1 ] = 0;
+	offsets[ 2 ] = ( media_size > 1024 ) ? (off64_t) ( media_size - 1024 ) : 0;
+	offsets[ 3 ] = (off64_t) media_size + 4096;
+
+	for( request_index = 0;
+	     request_index < 4;
+	     request_index++ )
+	{
+		result = libphdi_handle_submit_read_buffer_at_offset(
+		          handle,
+		          read_buffers[ request_index ],
+		          4096,
+		          offsets[ request_index ],
+		          (intptr_t) request_index,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libphdi_handle_get_number_of_outstanding_reads(
+	          handle,
+	          &number_of_outstanding_reads,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "number_of_outstanding_reads",
+	 number_of_outstanding_reads,
+	 4 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The reads can complete in any order
+	 */
+	for( request_index = 0;
+	     request_index < 4;
+	     request_index++ )
+	{
+		result = libphdi_handle_get_completed_read(
+		          handle,
+		          1,
+		          &user_data,
+		          &read_count,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		PHDI_TEST_ASSERT_GREATER_THAN_INT(
+		 "user_data",
+		 (int) user_data,
+		 -1 );
+
+		PHDI_TEST_ASSERT_LESS_THAN_INT(
+		 "user_data",
+		 (int) user_data,
+		 4 );
+
+		expected_read_count = libphdi_handle_read_buffer_at_offset(
+		                       handle,
+		                       expected_buffer,
+		                       4096,
+		                       offsets[ user_data ],
+		                       &error );
+
+		PHDI_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 expected_read_count );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( buffer_index = 0;
+		     buffer_index < (size_t) read_count;
+		     buffer_index++ )
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "read_buffers[ user_data ][ buffer_index ]",
+			 (int) read_buffers[ user_data ][ buffer_index ],
+			 (int) expected_buffer[ buffer_index ] );
+		}
+	}
+	/* Test retrieving a completed read without outstanding reads
+	 */
+	result = libphdi_handle_get_completed_read(
+	          handle,
+	          1,
+	          &user_data,
+	          &read_count,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_handle_submit_read_buffer_at_offset(
+	          NULL,
+	          read_buffers[ 0 ],
+	          4096,
+	          0,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_submit_read_buffer_at_offset(
+	          handle,
+	          NULL,
+	          4096,
+	          0,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_submit_read_buffer_at_offset(
+	          handle,
+	          read_buffers[ 0 ],
+	          (size_t) SSIZE_MAX + 1,
+	          0,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_submit_read_buffer_at_offset(
+	          handle,
+	          read_buffers[ 0 ],
+	          4096,
+	          -1,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_completed_read(
+	          NULL,
+	          0,
+	          &user_data,
+	          &read_count,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_completed_read(
+	          handle,
+	          0,
+	          NULL,
+	          &read_count,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_completed_read(
+	          handle,
+	          0,
+	          &user_data,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_number_of_outstanding_reads(
+	          NULL,
+	          &number_of_outstanding_reads,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_get_number_of_outstanding_reads(
+	          handle,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	/* Make sure no outstanding reads reference the buffers on the stack
+	 */
+	while( libphdi_handle_get_completed_read(
+	        handle,
+	        1,
+	        &user_data,
+	        &read_count,
+	        NULL ) == 1 )
+	{
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBPHDI )
+
+/* Tests the libphdi_handle_read_buffer_at_offset function with readahead
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_handle_read_buffer_at_offset_with_readahead(
+     libphdi_handle_t *handle )
+{
+	uint8_t buffer[ 4096 ];
+
+	libcerror_error_t *error   = NULL;
+	size64_t media_size        = 0;
+	size64_t read_size         = 0;
+	ssize_t read_count         = 0;
+	off64_t offset             = 0;
+	uint64_t checksum          = 0;
+	uint64_t expected_checksum = 0;
+	size_t buffer_index        = 0;
+	int pass                   = 0;
+	int result                 = 0;
+
+	/* Determine size
+	 */
+	result = libphdi_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_size = media_size;
+
+	if( read_size > ( 4 * 1024 * 1024 ) )
+	{
+		read_size = 4 * 1024 * 1024;
+	}
+	/* Test regular cases
+	 * The data is read sequentially without readahead and with readahead
+	 */
+	for( pass = 0;
+	     pass < 2;
+	     pass++ )
+	{
+		result = libphdi_handle_set_readahead_window_size(
+		          handle,
+		          ( pass == 0 ) ? 0 : ( 1024 * 1024 ),
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		checksum = 0;
+
+		for( offset = 0;
+		     (size64_t) offset < read_size;
+		     offset += read_count )
+		{
+			read_count = libphdi_handle_read_buffer_at_offset(
+			              handle,
+			              buffer,
+			              4096,
+			              offset,
+			              &error );
+
+			PHDI_TEST_ASSERT_GREATER_THAN_INT(
+			 "read_count",
+			 (int) read_count,
+			 0 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			for( buffer_index = 0;
+			     buffer_index < (size_t) read_count;
+			     buffer_index++ )
+			{
+				checksum = ( checksum * 31 ) + buffer[ buffer_index ];
+			}
+		}
+		if( pass == 0 )
+		{
+			expected_checksum = checksum;
+		}
+	}
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "checksum",
+	 checksum,
+	 expected_checksum );
+
+	/* Clean up
+	 */
+	result = libphdi_handle_set_readahead_window_size(
+	          handle,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	libphdi_handle_set_readahead_window_size(
+	 handle,
+	 0,
+	 NULL );
+
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBPHDI ) */
+
+/* Tests the libphdi_handle_set_memory_map_extent_data_files function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_handle_set_memory_map_extent_data_files(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	libphdi_handle_t *handle = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_handle_initialize(
+	          &handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_handle_set_memory_map_extent_data_files(
+	          handle,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_handle_set_memory_map_extent_data_files(
+	          NULL,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_handle_free(
+	          &handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libphdi_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_handle_borrow_buffer_at_offset and libphdi_handle_release_buffer functions
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_handle_borrow_buffer_at_offset(
+     libphdi_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	const uint8_t *buffer    = NULL;
+	size_t buffer_size       = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libphdi_handle_borrow_buffer_at_offset(
+	          handle,
+	          0,
+	          512,
+	          &buffer,
+	          &buffer_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result != 0 )
+	{
+		PHDI_TEST_ASSERT_IS_NOT_NULL(
+		 "buffer",
+		 buffer );
+
+		result = libphdi_handle_release_buffer(
+		          handle,
+		          buffer,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test libphdi_handle_release_buffer with a buffer that was already released
+		 */
+		result = libphdi_handle_release_buffer(
+		          handle,
+		          buffer,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		PHDI_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Test error cases
+	 */
+	result = libphdi_handle_borrow_buffer_at_offset(
+	          NULL,
+	          0,
+	          512,
+	          &buffer,
+	          &buffer_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_borrow_buffer_at_offset(
+	          handle,
+	          -1,
+	          512,
+	          &buffer,
+	          &buffer_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_borrow_buffer_at_offset(
+	          handle,
+	          0,
+	          0,
+	          &buffer,
+	          &buffer_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_borrow_buffer_at_offset(
+	          handle,
+	          0,
+	          512,
+	          NULL,
+	          &buffer_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_borrow_buffer_at_offset(
+	          handle,
+	          0,
+	          512,
+	          &buffer,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libphdi_handle_release_buffer without borrowed buffers
+	 */
+	result = libphdi_handle_release_buffer(
+	          handle,
+	          (const uint8_t *) &buffer_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_release_buffer(
+	          NULL,
+	          (const uint8_t *) &buffer_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_release_buffer(
+	          handle,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_handle_clone function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_handle_clone(
+     libphdi_handle_t *handle )
+{
+	uint8_t clone_buffer[ 4096 ];
+	uint8_t expected_buffer[ 4096 ];
+
+	libcerror_error_t *error             = NULL;
+	libphdi_handle_t *closed_handle      = NULL;
+	libphdi_handle_t *destination_handle = NULL;
+	libphdi_handle_t *second_handle      = NULL;
+	off64_t offset                       = 0;
+	ssize_t read_count                   = 0;
+	size_t buffer_index                  = 0;
+	int result                           = 0;
+
+	read_count = libphdi_handle_read_buffer_at_offset(
+	              handle,
+	              expected_buffer,
+	              4096,
+	              0,
+	              &error );
+
+	PHDI_TEST_ASSERT_NOT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_handle_clone(
+	          &destination_handle,
+	          handle,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "destination_handle",
+	 destination_handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The clone has its own current offset
+	 */
+	result = libphdi_handle_get_offset(
+	          destination_handle,
+	          &offset,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libphdi_handle_read_buffer(
+	              destination_handle,
+	              clone_buffer,
+	              4096,
+	              &error );
+
+	PHDI_TEST_ASSERT_NOT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( buffer_index = 0;
+	     buffer_index < (size_t) read_count;
+	     buffer_index++ )
+	{
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "clone_buffer[ buffer_index ]",
+		 (int) clone_buffer[ buffer_index ],
+		 (int) expected_buffer[ buffer_index ] );
+	}
+	/* The clone of a clone with a separate file IO pool
+	 */
+	result = libphdi_handle_clone(
+	          &second_handle,
+	          destination_handle,
+	          LIBPHDI_CLONE_FLAG_SEPARATE_FILE_IO_POOL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "second_handle",
+	 second_handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libphdi_handle_read_buffer_at_offset(
+	              second_handle,
+	              clone_buffer,
+	              4096,
+	              0,
+	              &error );
+
+	PHDI_TEST_ASSERT_NOT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( buffer_index = 0;
+	     buffer_index < (size_t) read_count;
+	     buffer_index++ )
+	{
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "clone_buffer[ buffer_index ]",
+		 (int) clone_buffer[ buffer_index ],
+		 (int) expected_buffer[ buffer_index ] );
+	}
+	/* The shared metadata cannot be changed while the handle has clones
+	 */
+	result = libphdi_handle_set_data_block_cache_size(
+	          handle,
+	          4 * 1024 * 1024,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_set_data_block_cache_size(
+	          destination_handle,
+	          4 * 1024 * 1024,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_handle_free(
+	          &second_handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "second_handle",
+	 second_handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_handle_free(
+	          &destination_handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "destination_handle",
+	 destination_handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_handle_clone(
+	          NULL,
+	          handle,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	destination_handle = (libphdi_handle_t *) 0x12345678UL;
+
+	result = libphdi_handle_clone(
+	          &destination_handle,
+	          handle,
+	          0,
+	          &error );
+
+	destination_handle = NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_clone(
+	          &destination_handle,
+	          NULL,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_clone(
+	          &destination_handle,
+	          handle,
+	          0xff,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test clone of a handle without extent data files
+	 */
+	result = libphdi_handle_initialize(
+	          &closed_handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_handle_clone(
+	          &destination_handle,
+	          closed_handle,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "destination_handle",
+	 destination_handle );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_handle_free(
+	          &closed_handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( closed_handle != NULL )
+	{
+		libphdi_handle_free(
+		 &closed_handle,
+		 NULL );
+	}
+	if( second_handle != NULL )
+	{
+		libphdi_handle_free(
+		 &second_handle,
+		 NULL );
+	}
+	if( destination_handle != NULL )
+	{
+		libphdi_handle_free(
+		 &destination_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libphdi_handle_t *handle         = NULL;
+	system_character_t *source       = NULL;
+	system_integer_t option          = 0;
+	size_t string_length             = 0;
+	int result                       = 0;
+
+	while( ( option = phdi_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+		}
+	}
+	if( optind < argc )
+	{
+		source = argv[ optind ];
+	}
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( PHDI_TEST_HANDLE_VERBOSE )
+	libphdi_notify_set_verbose(
+	 1 );
+	libphdi_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+
+	PHDI_TEST_RUN(
+	 "libphdi_handle_initialize",
+	 phdi_test_handle_initialize );
+
+	PHDI_TEST_RUN(
+	 "libphdi_handle_free",
+	 phdi_test_handle_free );
+
+	PHDI_TEST_RUN(
+	 "libphdi_handle_data_block_cache_size",
+	 phdi_test_handle_data_block_cache_size );
+
+	PHDI_TEST_RUN(
+	 "libphdi_handle_set_memory_map_extent_data_files",
+	 phdi_test_handle_set_memory_map_extent_data_files );
+
+	PHDI_TEST_RUN(
+	 "libphdi_handle_readahead_window_size",
+	 phdi_test_handle_readahead_window_size );
+
+	PHDI_TEST_RUN(
+	 "libphdi_handle_number_of_metadata_prefetch_threads",
+	 phdi_test_handle_number_of_metadata_prefetch_threads );
+
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+	if( source != NULL )
+	{
+		result = libbfio_file_initialize(
+		          &file_io_handle,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        PHDI_TEST_ASSERT_IS_NOT_NULL(
+	         "file_io_handle",
+	         file_io_handle );
+
+	        PHDI_TEST_ASSERT_IS_NULL(
+	         "error",
+	         error );
+
+		string_length = system_string_length(
+		                 source );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libbfio_file_set_name_wide(
+		          file_io_handle,
+		          source,
+		          string_length,
+		          &error );
+#else
+		result = libbfio_file_set_name(
+		          file_io_handle,
+		          source,
+		          string_length,
+		          &error );
+#endif
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        PHDI_TEST_ASSERT_IS_NULL(
+	         "error",
+	         error );
+
+		result = libphdi_check_file_signature_file_io_handle(
+		          file_io_handle,
+		          &error );
+
+		PHDI_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	if( result != 0 )
+	{
+		PHDI_TEST_RUN_WITH_ARGS(
+		 "libphdi_handle_open",
+		 phdi_test_handle_open,
+		 source );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+		PHDI_TEST_RUN_WITH_ARGS(
+		 "libphdi_handle_open_wide",
+		 phdi_test_handle_open_wide,
+		 source );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+		PHDI_TEST_RUN_WITH_ARGS(
+		 "libphdi_handle_open_file_io_handle",
+		 phdi_test_handle_open_file_io_handle,
+		 source );
+
+		PHDI_TEST_RUN(
+		 "libphdi_handle_close",
+		 phdi_test_handle_close );
+
+		PHDI_TEST_RUN_WITH_ARGS(
+		 "libphdi_handle_open_close",
+		 phdi_test_handle_open_close,
+		 source );
+
+		/* Initialize handle for tests
+		 */
+		result = phdi_test_handle_open_source(
+		          &handle,
+		          source,
+		          file_io_handle,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NOT_NULL(
+		 "handle",
+		 handle );
+
+		PHDI_TEST_ASSERT_IS_NULL(
 		 "error",
 		 error );
 
@@ -2560,6 +5918,11 @@ int main(
 
 #endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
 
+		PHDI_TEST_RUN_WITH_ARGS(
+		 "libphdi_handle_warm_metadata",
+		 phdi_test_handle_warm_metadata,
+		 handle );
+
 		PHDI_TEST_RUN_WITH_ARGS(
 		 "libphdi_handle_read_buffer",
 		 phdi_test_handle_read_buffer,
@@ -2570,6 +5933,25 @@ int main(
 		 phdi_test_handle_read_buffer_at_offset,
 		 handle );
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBPHDI )
+
+		PHDI_TEST_RUN_WITH_ARGS(
+		 "libphdi_handle_read_buffer_at_offset_with_readahead",
+		 phdi_test_handle_read_buffer_at_offset_with_readahead,
+		 handle );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBPHDI ) */
+
+		PHDI_TEST_RUN_WITH_ARGS(
+		 "libphdi_handle_read_vector",
+		 phdi_test_handle_read_vector,
+		 handle );
+
+		PHDI_TEST_RUN_WITH_ARGS(
+		 "libphdi_handle_submit_read_buffer_at_offset",
+		 phdi_test_handle_submit_read_buffer_at_offset,
+		 handle );
+
 #if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
 
 		/* TODO: add tests for libphdi_internal_handle_seek_offset */
@@ -2591,6 +5973,41 @@ int main(
 		 phdi_test_handle_get_media_size,
 		 handle );
 
+		PHDI_TEST_RUN_WITH_ARGS(
+		 "libphdi_handle_get_next_data_offset",
+		 phdi_test_handle_get_next_data_offset,
+		 handle );
+
+		PHDI_TEST_RUN_WITH_ARGS(
+		 "libphdi_handle_get_next_hole_offset",
+		 phdi_test_handle_get_next_hole_offset,
+		 handle );
+
+		PHDI_TEST_RUN_WITH_ARGS(
+		 "libphdi_handle_get_allocated_range",
+		 phdi_test_handle_get_allocated_range,
+		 handle );
+
+		PHDI_TEST_RUN_WITH_ARGS(
+		 "libphdi_handle_get_data_block_cache_statistics",
+		 phdi_test_handle_get_data_block_cache_statistics,
+		 handle );
+
+		PHDI_TEST_RUN_WITH_ARGS(
+		 "libphdi_handle_get_statistics",
+		 phdi_test_handle_get_statistics,
+		 handle );
+
+		PHDI_TEST_RUN_WITH_ARGS(
+		 "libphdi_handle_borrow_buffer_at_offset",
+		 phdi_test_handle_borrow_buffer_at_offset,
+		 handle );
+
+		PHDI_TEST_RUN_WITH_ARGS(
+		 "libphdi_handle_clone",
+		 phdi_test_handle_clone,
+		 handle );
+
 		/* TODO: add tests for libphdi_handle_get_utf8_name_size */
 
 		/* TODO: add tests for libphdi_handle_get_utf8_name */
@@ -0,0 +1,1009 @@
+/*
+ * Library layer_map type test program
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "phdi_test_libcerror.h"
+#include "phdi_test_libphdi.h"
+#include "phdi_test_macros.h"
+#include "phdi_test_memory.h"
+#include "phdi_test_unused.h"
+
+#include "../libphdi/libphdi_definitions.h"
+#include "../libphdi/libphdi_layer_map.h"
+
+#define PHDI_TEST_LAYER_MAP_BLOCK_SIZE	1048576
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+/* Tests the libphdi_layer_map_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_layer_map_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libphdi_layer_map_t *layer_map  = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 3;
+	int number_of_memset_fail_tests = 2;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libphdi_layer_map_initialize(
+	          &layer_map,
+	          (size64_t) 16 * PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+	          PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "layer_map",
+	 layer_map );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_layer_map_free(
+	          &layer_map,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "layer_map",
+	 layer_map );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_layer_map_initialize(
+	          NULL,
+	          (size64_t) 16 * PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+	          PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	layer_map = (libphdi_layer_map_t *) 0x12345678UL;
+
+	result = libphdi_layer_map_initialize(
+	          &layer_map,
+	          (size64_t) 16 * PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+	          PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+	          &error );
+
+	layer_map = NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_layer_map_initialize(
+	          &layer_map,
+	          (size64_t) 16 * PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_layer_map_initialize with malloc failing
+		 */
+		phdi_test_malloc_attempts_before_fail = test_number;
+
+		result = libphdi_layer_map_initialize(
+		          &layer_map,
+		          (size64_t) 16 * PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+		          PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+		          &error );
+
+		if( phdi_test_malloc_attempts_before_fail != -1 )
+		{
+			phdi_test_malloc_attempts_before_fail = -1;
+
+			if( layer_map != NULL )
+			{
+				libphdi_layer_map_free(
+				 &layer_map,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "layer_map",
+			 layer_map );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_layer_map_initialize with memset failing
+		 */
+		phdi_test_memset_attempts_before_fail = test_number;
+
+		result = libphdi_layer_map_initialize(
+		          &layer_map,
+		          (size64_t) 16 * PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+		          PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+		          &error );
+
+		if( phdi_test_memset_attempts_before_fail != -1 )
+		{
+			phdi_test_memset_attempts_before_fail = -1;
+
+			if( layer_map != NULL )
+			{
+				libphdi_layer_map_free(
+				 &layer_map,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "layer_map",
+			 layer_map );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PHDI_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( layer_map != NULL )
+	{
+		libphdi_layer_map_free(
+		 &layer_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_layer_map_free function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_layer_map_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libphdi_layer_map_free(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_layer_map_get_entry_by_index and libphdi_layer_map_set_entry_by_index functions
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_layer_map_get_entry_by_index(
+     libphdi_layer_map_t *layer_map )
+{
+	libphdi_layer_map_entry_t entry;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libphdi_layer_map_get_entry_by_index(
+	          layer_map,
+	          8,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT8(
+	 "entry.type",
+	 entry.type,
+	 (uint8_t) LIBPHDI_LAYER_MAP_ENTRY_TYPE_UNRESOLVED );
+
+	entry.file_offset        = 0x00300000;
+	entry.file_io_pool_entry = 1;
+	entry.layer              = 3;
+	entry.type               = LIBPHDI_LAYER_MAP_ENTRY_TYPE_ALLOCATED;
+
+	result = libphdi_layer_map_set_entry_by_index(
+	          layer_map,
+	          8,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	entry.type = LIBPHDI_LAYER_MAP_ENTRY_TYPE_UNRESOLVED;
+
+	result = libphdi_layer_map_get_entry_by_index(
+	          layer_map,
+	          8,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT8(
+	 "entry.type",
+	 entry.type,
+	 (uint8_t) LIBPHDI_LAYER_MAP_ENTRY_TYPE_ALLOCATED );
+
+	PHDI_TEST_ASSERT_EQUAL_INT64(
+	 "entry.file_offset",
+	 (int64_t) entry.file_offset,
+	 (int64_t) 0x00300000 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "entry.file_io_pool_entry",
+	 entry.file_io_pool_entry,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT16(
+	 "entry.layer",
+	 entry.layer,
+	 (uint16_t) 3 );
+
+	/* Test error cases
+	 */
+	result = libphdi_layer_map_get_entry_by_index(
+	          NULL,
+	          8,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_layer_map_get_entry_by_index(
+	          layer_map,
+	          16,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_layer_map_get_entry_by_index(
+	          layer_map,
+	          8,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_layer_map_set_entry_by_index(
+	          NULL,
+	          8,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_layer_map_set_entry_by_index(
+	          layer_map,
+	          16,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_layer_map_get_range_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_layer_map_get_range_at_offset(
+     libphdi_layer_map_t *layer_map )
+{
+	libphdi_layer_map_entry_t entry;
+
+	libcerror_error_t *error  = NULL;
+	size64_t range_size       = 0;
+	off64_t range_file_offset = 0;
+	int file_io_pool_entry    = 0;
+	int range_layer           = 0;
+	int result                = 0;
+	uint8_t range_type        = 0;
+
+	/* Initialize test
+	 * block 0 and 1 are stored contiguously, block 2 is stored elsewhere
+	 * and block 3 and 4 are sparse
+	 */
+	entry.file_io_pool_entry = 0;
+	entry.layer              = 1;
+	entry.type               = LIBPHDI_LAYER_MAP_ENTRY_TYPE_ALLOCATED;
+
+	entry.file_offset = 0x00100000;
+
+	result = libphdi_layer_map_set_entry_by_index(
+	          layer_map,
+	          0,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	entry.file_offset = 0x00200000;
+
+	result = libphdi_layer_map_set_entry_by_index(
+	          layer_map,
+	          1,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	entry.file_offset = 0x00800000;
+
+	result = libphdi_layer_map_set_entry_by_index(
+	          layer_map,
+	          2,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	entry.file_offset        = 0;
+	entry.file_io_pool_entry = -1;
+	entry.layer              = 0;
+	entry.type               = LIBPHDI_LAYER_MAP_ENTRY_TYPE_SPARSE;
+
+	result = libphdi_layer_map_set_entry_by_index(
+	          layer_map,
+	          3,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_layer_map_set_entry_by_index(
+	          layer_map,
+	          4,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	entry.type = LIBPHDI_LAYER_MAP_ENTRY_TYPE_MIXED;
+
+	result = libphdi_layer_map_set_entry_by_index(
+	          layer_map,
+	          5,
+	          &entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_layer_map_get_range_at_offset(
+	          layer_map,
+	          NULL,
+	          NULL,
+	          512,
+	          (size64_t) 4 * PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+	          &range_type,
+	          &range_layer,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT8(
+	 "range_type",
+	 range_type,
+	 (uint8_t) LIBPHDI_LAYER_MAP_ENTRY_TYPE_ALLOCATED );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "range_layer",
+	 range_layer,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_entry",
+	 file_io_pool_entry,
+	 0 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT64(
+	 "range_file_offset",
+	 (int64_t) range_file_offset,
+	 (int64_t) 0x00100200 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 range_size,
+	 (uint64_t) ( 2 * PHDI_TEST_LAYER_MAP_BLOCK_SIZE ) - 512 );
+
+	result = libphdi_layer_map_get_range_at_offset(
+	          layer_map,
+	          NULL,
+	          NULL,
+	          (off64_t) 3 * PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+	          (size64_t) 4 * PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+	          &range_type,
+	          &range_layer,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT8(
+	 "range_type",
+	 range_type,
+	 (uint8_t) LIBPHDI_LAYER_MAP_ENTRY_TYPE_SPARSE );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 range_size,
+	 (uint64_t) ( 2 * PHDI_TEST_LAYER_MAP_BLOCK_SIZE ) );
+
+	result = libphdi_layer_map_get_range_at_offset(
+	          layer_map,
+	          NULL,
+	          NULL,
+	          (off64_t) 5 * PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+	          (size64_t) 4 * PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+	          &range_type,
+	          &range_layer,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT8(
+	 "range_type",
+	 range_type,
+	 (uint8_t) LIBPHDI_LAYER_MAP_ENTRY_TYPE_MIXED );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 range_size,
+	 (uint64_t) PHDI_TEST_LAYER_MAP_BLOCK_SIZE );
+
+	/* Test error cases
+	 */
+	result = libphdi_layer_map_get_range_at_offset(
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          (size64_t) 4 * PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+	          &range_type,
+	          &range_layer,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_layer_map_get_range_at_offset(
+	          layer_map,
+	          NULL,
+	          NULL,
+	          -1,
+	          (size64_t) 4 * PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+	          &range_type,
+	          &range_layer,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_layer_map_get_range_at_offset(
+	          layer_map,
+	          NULL,
+	          NULL,
+	          0,
+	          0,
+	          &range_type,
+	          &range_layer,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_layer_map_get_range_at_offset(
+	          layer_map,
+	          NULL,
+	          NULL,
+	          0,
+	          (size64_t) 4 * PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+	          NULL,
+	          &range_layer,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_layer_map_get_range_at_offset(
+	          layer_map,
+	          NULL,
+	          NULL,
+	          0,
+	          (size64_t) 4 * PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+	          &range_type,
+	          NULL,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_layer_map_get_range_at_offset(
+	          layer_map,
+	          NULL,
+	          NULL,
+	          0,
+	          (size64_t) 4 * PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+	          &range_type,
+	          &range_layer,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+	libcerror_error_t *error       = NULL;
+	libphdi_layer_map_t *layer_map = NULL;
+	int result                     = 0;
+#endif
+
+	PHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	PHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+	PHDI_TEST_RUN(
+	 "libphdi_layer_map_initialize",
+	 phdi_test_layer_map_initialize );
+
+	PHDI_TEST_RUN(
+	 "libphdi_layer_map_free",
+	 phdi_test_layer_map_free );
+
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+
+	/* Initialize layer map for tests
+	 */
+	result = libphdi_layer_map_initialize(
+	          &layer_map,
+	          (size64_t) 16 * PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+	          PHDI_TEST_LAYER_MAP_BLOCK_SIZE,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "layer_map",
+	 layer_map );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_RUN_WITH_ARGS(
+	 "libphdi_layer_map_get_entry_by_index",
+	 phdi_test_layer_map_get_entry_by_index,
+	 layer_map );
+
+	PHDI_TEST_RUN_WITH_ARGS(
+	 "libphdi_layer_map_get_range_at_offset",
+	 phdi_test_layer_map_get_range_at_offset,
+	 layer_map );
+
+	/* Clean up
+	 */
+	result = libphdi_layer_map_free(
+	          &layer_map,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "layer_map",
+	 layer_map );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( layer_map != NULL )
+	{
+		libphdi_layer_map_free(
+		 &layer_map,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+}
+
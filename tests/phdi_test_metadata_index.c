@@ -0,0 +1,1480 @@
+/*
+ * Library metadata_index type test program
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "phdi_test_libcdata.h"
+#include "phdi_test_libcerror.h"
+#include "phdi_test_libphdi.h"
+#include "phdi_test_macros.h"
+#include "phdi_test_memory.h"
+#include "phdi_test_unused.h"
+
+#include "../libphdi/libphdi_definitions.h"
+#include "../libphdi/libphdi_disk_parameters.h"
+#include "../libphdi/libphdi_extent_values.h"
+#include "../libphdi/libphdi_image_values.h"
+#include "../libphdi/libphdi_metadata_index.h"
+#include "../libphdi/libphdi_snapshot_values.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+/* Tests the libphdi_metadata_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_metadata_index_initialize(
+     void )
+{
+	libcerror_error_t *error                 = NULL;
+	libphdi_metadata_index_t *metadata_index = NULL;
+	int result                               = 0;
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+	int number_of_malloc_fail_tests          = 1;
+	int number_of_memset_fail_tests          = 1;
+	int test_number                          = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libphdi_metadata_index_initialize(
+	          &metadata_index,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "metadata_index",
+	 metadata_index );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_metadata_index_free(
+	          &metadata_index,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "metadata_index",
+	 metadata_index );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_metadata_index_initialize(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	metadata_index = (libphdi_metadata_index_t *) 0x12345678UL;
+
+	result = libphdi_metadata_index_initialize(
+	          &metadata_index,
+	          &error );
+
+	metadata_index = NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_metadata_index_initialize with malloc failing
+		 */
+		phdi_test_malloc_attempts_before_fail = test_number;
+
+		result = libphdi_metadata_index_initialize(
+		          &metadata_index,
+		          &error );
+
+		if( phdi_test_malloc_attempts_before_fail != -1 )
+		{
+			phdi_test_malloc_attempts_before_fail = -1;
+
+			if( metadata_index != NULL )
+			{
+				libphdi_metadata_index_free(
+				 &metadata_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "metadata_index",
+			 metadata_index );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_metadata_index_initialize with memset failing
+		 */
+		phdi_test_memset_attempts_before_fail = test_number;
+
+		result = libphdi_metadata_index_initialize(
+		          &metadata_index,
+		          &error );
+
+		if( phdi_test_memset_attempts_before_fail != -1 )
+		{
+			phdi_test_memset_attempts_before_fail = -1;
+
+			if( metadata_index != NULL )
+			{
+				libphdi_metadata_index_free(
+				 &metadata_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "metadata_index",
+			 metadata_index );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PHDI_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( metadata_index != NULL )
+	{
+		libphdi_metadata_index_free(
+		 &metadata_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_metadata_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_metadata_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libphdi_metadata_index_free(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_metadata_index_calculate_checksum function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_metadata_index_calculate_checksum(
+     void )
+{
+	uint8_t data[ 6 ]        = { 'f', 'o', 'o', 'b', 'a', 'r' };
+	libcerror_error_t *error = NULL;
+	uint64_t checksum        = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libphdi_metadata_index_calculate_checksum(
+	          &checksum,
+	          data,
+	          6,
+	          LIBPHDI_METADATA_INDEX_CHECKSUM_INITIAL_VALUE,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "checksum",
+	 checksum,
+	 (uint64_t) 0x85944171f73967e8ULL );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the checksum can be calculated in blocks
+	 */
+	result = libphdi_metadata_index_calculate_checksum(
+	          &checksum,
+	          data,
+	          3,
+	          LIBPHDI_METADATA_INDEX_CHECKSUM_INITIAL_VALUE,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_metadata_index_calculate_checksum(
+	          &checksum,
+	          &( data[ 3 ] ),
+	          3,
+	          checksum,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "checksum",
+	 checksum,
+	 (uint64_t) 0x85944171f73967e8ULL );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_metadata_index_calculate_checksum(
+	          NULL,
+	          data,
+	          6,
+	          LIBPHDI_METADATA_INDEX_CHECKSUM_INITIAL_VALUE,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_metadata_index_calculate_checksum(
+	          &checksum,
+	          NULL,
+	          6,
+	          LIBPHDI_METADATA_INDEX_CHECKSUM_INITIAL_VALUE,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_metadata_index_get_block_allocation_table_sample_range function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_metadata_index_get_block_allocation_table_sample_range(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	size64_t sample_offset   = 0;
+	size64_t sample_size     = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libphdi_metadata_index_get_block_allocation_table_sample_range(
+	          1024,
+	          0,
+	          &sample_offset,
+	          &sample_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "sample_offset",
+	 sample_offset,
+	 (uint64_t) 0 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "sample_size",
+	 sample_size,
+	 (uint64_t) 1024 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A small block allocation table is sampled entirely
+	 */
+	result = libphdi_metadata_index_get_block_allocation_table_sample_range(
+	          1024,
+	          1,
+	          &sample_offset,
+	          &sample_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A large block allocation table is sampled at the start, middle and end
+	 */
+	result = libphdi_metadata_index_get_block_allocation_table_sample_range(
+	          1048580,
+	          1,
+	          &sample_offset,
+	          &sample_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "sample_offset",
+	 sample_offset,
+	 (uint64_t) 522240 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "sample_size",
+	 sample_size,
+	 (uint64_t) LIBPHDI_METADATA_INDEX_BLOCK_ALLOCATION_TABLE_SAMPLE_SIZE );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_metadata_index_get_block_allocation_table_sample_range(
+	          1048580,
+	          2,
+	          &sample_offset,
+	          &sample_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "sample_offset",
+	 sample_offset,
+	 (uint64_t) 1048580 - LIBPHDI_METADATA_INDEX_BLOCK_ALLOCATION_TABLE_SAMPLE_SIZE );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_metadata_index_get_block_allocation_table_sample_range(
+	          1048580,
+	          3,
+	          &sample_offset,
+	          &sample_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_metadata_index_get_block_allocation_table_sample_range(
+	          1024,
+	          -1,
+	          &sample_offset,
+	          &sample_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_metadata_index_get_block_allocation_table_sample_range(
+	          1024,
+	          0,
+	          NULL,
+	          &sample_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_metadata_index_get_block_allocation_table_sample_range(
+	          1024,
+	          0,
+	          &sample_offset,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_metadata_index_read_data function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_metadata_index_read_data(
+     void )
+{
+	uint8_t data[ 128 ];
+
+	libcerror_error_t *error                 = NULL;
+	libphdi_metadata_index_t *metadata_index = NULL;
+	int result                               = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_metadata_index_initialize(
+	          &metadata_index,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "metadata_index",
+	 metadata_index );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_set(
+	          data,
+	          0,
+	          128 ) != NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 */
+	result = libphdi_metadata_index_read_data(
+	          metadata_index,
+	          data,
+	          128,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT8(
+	 "metadata_index->is_valid",
+	 metadata_index->is_valid,
+	 0 );
+
+	result = libphdi_metadata_index_read_data(
+	          metadata_index,
+	          data,
+	          16,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_metadata_index_read_data(
+	          NULL,
+	          data,
+	          128,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_metadata_index_read_data(
+	          metadata_index,
+	          NULL,
+	          128,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_metadata_index_free(
+	          &metadata_index,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "metadata_index",
+	 metadata_index );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( metadata_index != NULL )
+	{
+		libphdi_metadata_index_free(
+		 &metadata_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_metadata_index_set_values function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_metadata_index_set_values(
+     void )
+{
+	uint8_t identifier[ 16 ]                      = {
+		0xe3, 0xab, 0xba, 0x5f, 0x58, 0x69, 0xff, 0x40, 0x92, 0xa7, 0x86, 0x0e, 0x32, 0x9a, 0xab, 0x41 };
+
+	libcdata_array_t *extent_values_array         = NULL;
+	libcdata_array_t *snapshot_values_array       = NULL;
+	libcerror_error_t *error                      = NULL;
+	libphdi_disk_parameters_t *disk_parameters    = NULL;
+	libphdi_extent_values_t *extent_values        = NULL;
+	libphdi_image_values_t *image_values          = NULL;
+	libphdi_metadata_index_t *metadata_index      = NULL;
+	libphdi_snapshot_values_t *snapshot_values    = NULL;
+	size64_t block_size                           = 0;
+	int disk_type                                 = 0;
+	int entry_index                               = 0;
+	int number_of_entries                         = 0;
+	int result                                    = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_disk_parameters_initialize(
+	          &disk_parameters,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	disk_parameters->media_size          = 8388608;
+	disk_parameters->number_of_cylinders = 16;
+	disk_parameters->number_of_heads     = 16;
+	disk_parameters->number_of_sectors   = 16384;
+
+	result = libphdi_disk_parameters_set_name(
+	          disk_parameters,
+	          (uint8_t *) "test",
+	          5,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_initialize(
+	          &extent_values_array,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_initialize(
+	          &snapshot_values_array,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_extent_values_initialize(
+	          &extent_values,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_extent_values_set_range(
+	          extent_values,
+	          0,
+	          16384,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_image_values_initialize(
+	          &image_values,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_copy(
+	          image_values->identifier,
+	          identifier,
+	          16 ) != NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	image_values->type = LIBPHDI_IMAGE_TYPE_COMPRESSED;
+
+	result = libphdi_image_values_set_filename(
+	          image_values,
+	          (uint8_t *) "test.hds",
+	          8,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_append_entry(
+	          extent_values->image_values_array,
+	          &entry_index,
+	          (intptr_t *) image_values,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	image_values = NULL;
+
+	result = libcdata_array_append_entry(
+	          extent_values_array,
+	          &entry_index,
+	          (intptr_t *) extent_values,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	extent_values = NULL;
+
+	result = libphdi_snapshot_values_initialize(
+	          &snapshot_values,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_copy(
+	          snapshot_values->identifier,
+	          identifier,
+	          16 ) != NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcdata_array_append_entry(
+	          snapshot_values_array,
+	          &entry_index,
+	          (intptr_t *) snapshot_values,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	snapshot_values = NULL;
+
+	result = libphdi_metadata_index_initialize(
+	          &metadata_index,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_metadata_index_set_values(
+	          metadata_index,
+	          LIBPHDI_DISK_TYPE_EXPANDING,
+	          disk_parameters,
+	          extent_values_array,
+	          snapshot_values_array,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT8(
+	 "metadata_index->is_valid",
+	 metadata_index->is_valid,
+	 0 );
+
+	PHDI_TEST_ASSERT_EQUAL_SIZE(
+	 "metadata_index->data_size % 8",
+	 metadata_index->data_size % 8,
+	 (size_t) 0 );
+
+	/* Test that the values can be retrieved from the index data
+	 */
+	result = libphdi_metadata_index_get_disk_type(
+	          metadata_index,
+	          &disk_type,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "disk_type",
+	 disk_type,
+	 LIBPHDI_DISK_TYPE_EXPANDING );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_empty(
+	          extent_values_array,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_extent_values_free,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_metadata_index_get_extents(
+	          metadata_index,
+	          extent_values_array,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_get_number_of_entries(
+	          extent_values_array,
+	          &number_of_entries,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_get_entry_by_index(
+	          extent_values_array,
+	          0,
+	          (intptr_t **) &extent_values,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "extent_values->size",
+	 (uint64_t) extent_values->size,
+	 (uint64_t) 16384 );
+
+	result = libphdi_extent_values_get_image_values_by_index(
+	          extent_values,
+	          0,
+	          &image_values,
+	          &error );
+
+	extent_values = NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "image_values->type",
+	 image_values->type,
+	 LIBPHDI_IMAGE_TYPE_COMPRESSED );
+
+	PHDI_TEST_ASSERT_EQUAL_SIZE(
+	 "image_values->filename_size",
+	 image_values->filename_size,
+	 (size_t) 9 );
+
+	result = memory_compare(
+	          image_values->identifier,
+	          identifier,
+	          16 );
+
+	image_values = NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libcdata_array_empty(
+	          snapshot_values_array,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_snapshot_values_free,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_metadata_index_get_snapshots(
+	          metadata_index,
+	          snapshot_values_array,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_get_number_of_entries(
+	          snapshot_values_array,
+	          &number_of_entries,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the index data is not used before it was written
+	 */
+	result = libphdi_metadata_index_get_storage_image(
+	          metadata_index,
+	          0,
+	          (libphdi_storage_image_t *) 0x12345678UL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_metadata_index_get_storage_image_block_size(
+	          metadata_index,
+	          0,
+	          &block_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_metadata_index_get_storage_image_block_size(
+	          metadata_index,
+	          0,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_metadata_index_validate_storage_images(
+	          metadata_index,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_metadata_index_validate_storage_images(
+	          NULL,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error cases
+	 */
+	result = libphdi_metadata_index_set_values(
+	          NULL,
+	          LIBPHDI_DISK_TYPE_EXPANDING,
+	          disk_parameters,
+	          extent_values_array,
+	          snapshot_values_array,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_metadata_index_set_values(
+	          metadata_index,
+	          LIBPHDI_DISK_TYPE_EXPANDING,
+	          NULL,
+	          extent_values_array,
+	          snapshot_values_array,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_metadata_index_free(
+	          &metadata_index,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_free(
+	          &snapshot_values_array,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_snapshot_values_free,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_free(
+	          &extent_values_array,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_extent_values_free,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_disk_parameters_free(
+	          &disk_parameters,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( metadata_index != NULL )
+	{
+		libphdi_metadata_index_free(
+		 &metadata_index,
+		 NULL );
+	}
+	if( snapshot_values != NULL )
+	{
+		libphdi_snapshot_values_free(
+		 &snapshot_values,
+		 NULL );
+	}
+	if( image_values != NULL )
+	{
+		libphdi_image_values_free(
+		 &image_values,
+		 NULL );
+	}
+	if( extent_values != NULL )
+	{
+		libphdi_extent_values_free(
+		 &extent_values,
+		 NULL );
+	}
+	if( snapshot_values_array != NULL )
+	{
+		libcdata_array_free(
+		 &snapshot_values_array,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_snapshot_values_free,
+		 NULL );
+	}
+	if( extent_values_array != NULL )
+	{
+		libcdata_array_free(
+		 &extent_values_array,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libphdi_extent_values_free,
+		 NULL );
+	}
+	if( disk_parameters != NULL )
+	{
+		libphdi_disk_parameters_free(
+		 &disk_parameters,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	PHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+	PHDI_TEST_RUN(
+	 "libphdi_metadata_index_initialize",
+	 phdi_test_metadata_index_initialize );
+
+	PHDI_TEST_RUN(
+	 "libphdi_metadata_index_free",
+	 phdi_test_metadata_index_free );
+
+	PHDI_TEST_RUN(
+	 "libphdi_metadata_index_calculate_checksum",
+	 phdi_test_metadata_index_calculate_checksum );
+
+	PHDI_TEST_RUN(
+	 "libphdi_metadata_index_get_block_allocation_table_sample_range",
+	 phdi_test_metadata_index_get_block_allocation_table_sample_range );
+
+	PHDI_TEST_RUN(
+	 "libphdi_metadata_index_read_data",
+	 phdi_test_metadata_index_read_data );
+
+	PHDI_TEST_RUN(
+	 "libphdi_metadata_index_set_values",
+	 phdi_test_metadata_index_set_values );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,955 @@
+/*
+ * Library read vector type test program
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "phdi_test_functions.h"
+#include "phdi_test_libbfio.h"
+#include "phdi_test_libcerror.h"
+#include "phdi_test_libphdi.h"
+#include "phdi_test_macros.h"
+#include "phdi_test_memory.h"
+#include "phdi_test_unused.h"
+
+#include "../libphdi/libphdi_read_vector.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+/* Tests the libphdi_read_vector_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_read_vector_initialize(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libphdi_read_vector_t *read_vector = NULL;
+	int result                         = 0;
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+	int number_of_malloc_fail_tests    = 1;
+	int number_of_memset_fail_tests    = 1;
+	int test_number                    = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libphdi_read_vector_initialize(
+	          &read_vector,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "read_vector",
+	 read_vector );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_read_vector_free(
+	          &read_vector,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "read_vector",
+	 read_vector );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_read_vector_initialize(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_vector = (libphdi_read_vector_t *) 0x12345678UL;
+
+	result = libphdi_read_vector_initialize(
+	          &read_vector,
+	          &error );
+
+	read_vector = NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_read_vector_initialize with malloc failing
+		 */
+		phdi_test_malloc_attempts_before_fail = test_number;
+
+		result = libphdi_read_vector_initialize(
+		          &read_vector,
+		          &error );
+
+		if( phdi_test_malloc_attempts_before_fail != -1 )
+		{
+			phdi_test_malloc_attempts_before_fail = -1;
+
+			if( read_vector != NULL )
+			{
+				libphdi_read_vector_free(
+				 &read_vector,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "read_vector",
+			 read_vector );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_read_vector_initialize with memset failing
+		 */
+		phdi_test_memset_attempts_before_fail = test_number;
+
+		result = libphdi_read_vector_initialize(
+		          &read_vector,
+		          &error );
+
+		if( phdi_test_memset_attempts_before_fail != -1 )
+		{
+			phdi_test_memset_attempts_before_fail = -1;
+
+			if( read_vector != NULL )
+			{
+				libphdi_read_vector_free(
+				 &read_vector,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "read_vector",
+			 read_vector );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PHDI_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_vector != NULL )
+	{
+		libphdi_read_vector_free(
+		 &read_vector,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_read_vector_free function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_read_vector_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libphdi_read_vector_free(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_read_vector_append_segment and libphdi_read_vector_sort functions
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_read_vector_append_segment(
+     void )
+{
+	uint8_t buffer[ 64 ];
+
+	libcerror_error_t *error           = NULL;
+	libphdi_read_vector_t *read_vector = NULL;
+	int result                         = 0;
+	int segment_index                  = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_read_vector_initialize(
+	          &read_vector,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "read_vector",
+	 read_vector );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases, more segments than initially allocated are
+	 * appended in descending file offset order
+	 */
+	for( segment_index = 0;
+	     segment_index < 32;
+	     segment_index++ )
+	{
+		result = libphdi_read_vector_append_segment(
+		          read_vector,
+		          segment_index,
+		          segment_index % 2,
+		          (off64_t) ( 32 - segment_index ) * 1024,
+		          buffer,
+		          64,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "read_vector->number_of_segments",
+	 read_vector->number_of_segments,
+	 32 );
+
+	result = libphdi_read_vector_sort(
+	          read_vector,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The segments of file IO pool entry 0 are sorted first by ascending file offset
+	 */
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "read_vector->segments[ 0 ].file_io_pool_entry",
+	 read_vector->segments[ 0 ].file_io_pool_entry,
+	 0 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "read_vector->segments[ 0 ].request_index",
+	 read_vector->segments[ 0 ].request_index,
+	 30 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "read_vector->segments[ 15 ].request_index",
+	 read_vector->segments[ 15 ].request_index,
+	 0 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "read_vector->segments[ 16 ].file_io_pool_entry",
+	 read_vector->segments[ 16 ].file_io_pool_entry,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "read_vector->segments[ 16 ].request_index",
+	 read_vector->segments[ 16 ].request_index,
+	 31 );
+
+	/* Test error cases
+	 */
+	result = libphdi_read_vector_append_segment(
+	          NULL,
+	          0,
+	          0,
+	          0,
+	          buffer,
+	          64,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_read_vector_append_segment(
+	          read_vector,
+	          -1,
+	          0,
+	          0,
+	          buffer,
+	          64,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_read_vector_append_segment(
+	          read_vector,
+	          0,
+	          0,
+	          -1,
+	          buffer,
+	          64,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_read_vector_append_segment(
+	          read_vector,
+	          0,
+	          0,
+	          0,
+	          NULL,
+	          64,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_read_vector_append_segment(
+	          read_vector,
+	          0,
+	          0,
+	          0,
+	          buffer,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_read_vector_sort(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_read_vector_free(
+	          &read_vector,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "read_vector",
+	 read_vector );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_vector != NULL )
+	{
+		libphdi_read_vector_free(
+		 &read_vector,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_read_vector_read_from_file_io_pool function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_read_vector_read_from_file_io_pool(
+     void )
+{
+	uint8_t data[ 256 ];
+	uint8_t first_buffer[ 32 ];
+	uint8_t second_buffer[ 32 ];
+	uint8_t third_buffer[ 16 ];
+	uint8_t fourth_buffer[ 16 ];
+	ssize_t read_counts[ 4 ];
+
+	libbfio_handle_t *file_io_handle   = NULL;
+	libbfio_pool_t *file_io_pool       = NULL;
+	libcerror_error_t *error           = NULL;
+	libphdi_read_vector_t *read_vector = NULL;
+	size_t data_offset                 = 0;
+	int file_io_pool_entry             = 0;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 256;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) data_offset;
+	}
+	result = phdi_test_open_file_io_handle(
+	          &file_io_handle,
+	          data,
+	          256,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_initialize(
+	          &file_io_pool,
+	          0,
+	          LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_append_handle(
+	          file_io_pool,
+	          &file_io_pool_entry,
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The file IO handle is now managed by the file IO pool
+	 */
+	file_io_handle = NULL;
+
+	result = libphdi_read_vector_initialize(
+	          &read_vector,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "read_vector",
+	 read_vector );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The first 3 segments are neighbours and are read at once, the last segment
+	 * is beyond the end of the data and fails
+	 */
+	result = libphdi_read_vector_append_segment(
+	          read_vector,
+	          0,
+	          file_io_pool_entry,
+	          64,
+	          first_buffer,
+	          32,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libphdi_read_vector_append_segment(
+	          read_vector,
+	          1,
+	          file_io_pool_entry,
+	          0,
+	          second_buffer,
+	          32,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libphdi_read_vector_append_segment(
+	          read_vector,
+	          2,
+	          file_io_pool_entry,
+	          40,
+	          third_buffer,
+	          16,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libphdi_read_vector_append_segment(
+	          read_vector,
+	          3,
+	          file_io_pool_entry,
+	          1048576,
+	          fourth_buffer,
+	          16,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_read_vector_sort(
+	          read_vector,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_counts[ 0 ] = 32;
+	read_counts[ 1 ] = 32;
+	read_counts[ 2 ] = 16;
+	read_counts[ 3 ] = 16;
+
+	/* Test regular cases
+	 */
+	result = libphdi_read_vector_read_from_file_io_pool(
+	          read_vector,
+	          file_io_pool,
+	          NULL,
+	          read_counts,
+	          4,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_counts[ 0 ]",
+	 read_counts[ 0 ],
+	 (ssize_t) 32 );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_counts[ 1 ]",
+	 read_counts[ 1 ],
+	 (ssize_t) 32 );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_counts[ 2 ]",
+	 read_counts[ 2 ],
+	 (ssize_t) 16 );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_counts[ 3 ]",
+	 read_counts[ 3 ],
+	 (ssize_t) -1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "first_buffer[ 0 ]",
+	 (int) first_buffer[ 0 ],
+	 64 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "first_buffer[ 31 ]",
+	 (int) first_buffer[ 31 ],
+	 95 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "second_buffer[ 0 ]",
+	 (int) second_buffer[ 0 ],
+	 0 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "second_buffer[ 31 ]",
+	 (int) second_buffer[ 31 ],
+	 31 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "third_buffer[ 0 ]",
+	 (int) third_buffer[ 0 ],
+	 40 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "third_buffer[ 15 ]",
+	 (int) third_buffer[ 15 ],
+	 55 );
+
+	/* Test error cases
+	 */
+	result = libphdi_read_vector_read_from_file_io_pool(
+	          NULL,
+	          file_io_pool,
+	          NULL,
+	          read_counts,
+	          4,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_read_vector_read_from_file_io_pool(
+	          read_vector,
+	          file_io_pool,
+	          NULL,
+	          NULL,
+	          4,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_read_vector_read_from_file_io_pool(
+	          read_vector,
+	          file_io_pool,
+	          NULL,
+	          read_counts,
+	          2,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_read_vector_free(
+	          &read_vector,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "read_vector",
+	 read_vector );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_free(
+	          &file_io_pool,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_vector != NULL )
+	{
+		libphdi_read_vector_free(
+		 &read_vector,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	PHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+	PHDI_TEST_RUN(
+	 "libphdi_read_vector_initialize",
+	 phdi_test_read_vector_initialize );
+
+	PHDI_TEST_RUN(
+	 "libphdi_read_vector_free",
+	 phdi_test_read_vector_free );
+
+	PHDI_TEST_RUN(
+	 "libphdi_read_vector_append_segment",
+	 phdi_test_read_vector_append_segment );
+
+	PHDI_TEST_RUN(
+	 "libphdi_read_vector_read_from_file_io_pool",
+	 phdi_test_read_vector_read_from_file_io_pool );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+}
+
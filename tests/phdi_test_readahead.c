@@ -0,0 +1,1080 @@
+/*
+ * Library readahead type test program
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "phdi_test_libcerror.h"
+#include "phdi_test_libphdi.h"
+#include "phdi_test_macros.h"
+#include "phdi_test_memory.h"
+#include "phdi_test_unused.h"
+
+#include "../libphdi/libphdi_readahead.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+/* Tests the libphdi_readahead_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_readahead_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libphdi_readahead_t *readahead  = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libphdi_readahead_initialize(
+	          &readahead,
+	          1048576,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "readahead",
+	 readahead );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_readahead_free(
+	          &readahead,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "readahead",
+	 readahead );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_readahead_initialize(
+	          NULL,
+	          1048576,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	readahead = (libphdi_readahead_t *) 0x12345678UL;
+
+	result = libphdi_readahead_initialize(
+	          &readahead,
+	          1048576,
+	          &error );
+
+	readahead = NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_readahead_initialize(
+	          &readahead,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_readahead_initialize with malloc failing
+		 */
+		phdi_test_malloc_attempts_before_fail = test_number;
+
+		result = libphdi_readahead_initialize(
+		          &readahead,
+		          1048576,
+		          &error );
+
+		if( phdi_test_malloc_attempts_before_fail != -1 )
+		{
+			phdi_test_malloc_attempts_before_fail = -1;
+
+			if( readahead != NULL )
+			{
+				libphdi_readahead_free(
+				 &readahead,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "readahead",
+			 readahead );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_readahead_initialize with memset failing
+		 */
+		phdi_test_memset_attempts_before_fail = test_number;
+
+		result = libphdi_readahead_initialize(
+		          &readahead,
+		          1048576,
+		          &error );
+
+		if( phdi_test_memset_attempts_before_fail != -1 )
+		{
+			phdi_test_memset_attempts_before_fail = -1;
+
+			if( readahead != NULL )
+			{
+				libphdi_readahead_free(
+				 &readahead,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "readahead",
+			 readahead );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PHDI_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( readahead != NULL )
+	{
+		libphdi_readahead_free(
+		 &readahead,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_readahead_free function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_readahead_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libphdi_readahead_free(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_readahead_clear function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_readahead_clear(
+     void )
+{
+	libcerror_error_t *error       = NULL;
+	libphdi_readahead_t *readahead = NULL;
+	int result                     = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_readahead_initialize(
+	          &readahead,
+	          1048576,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "readahead",
+	 readahead );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_readahead_clear(
+	          readahead,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_readahead_clear(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_readahead_free(
+	          &readahead,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "readahead",
+	 readahead );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( readahead != NULL )
+	{
+		libphdi_readahead_free(
+		 &readahead,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_readahead_update function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_readahead_update(
+     void )
+{
+	libcerror_error_t *error       = NULL;
+	libphdi_readahead_t *readahead = NULL;
+	size64_t prefetch_size         = 0;
+	off64_t prefetch_offset        = 0;
+	int result                     = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_readahead_initialize(
+	          &readahead,
+	          1048576,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "readahead",
+	 readahead );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_readahead_update(
+	          readahead,
+	          0,
+	          65536,
+	          &prefetch_offset,
+	          &prefetch_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_readahead_update(
+	          readahead,
+	          65536,
+	          65536,
+	          &prefetch_offset,
+	          &prefetch_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT64(
+	 "prefetch_offset",
+	 (int64_t) prefetch_offset,
+	 (int64_t) 131072 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "prefetch_size",
+	 (uint64_t) prefetch_size,
+	 (uint64_t) 131072 );
+
+	result = libphdi_readahead_update(
+	          readahead,
+	          131072,
+	          65536,
+	          &prefetch_offset,
+	          &prefetch_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT64(
+	 "prefetch_offset",
+	 (int64_t) prefetch_offset,
+	 (int64_t) 262144 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "prefetch_size",
+	 (uint64_t) prefetch_size,
+	 (uint64_t) 196608 );
+
+	/* Test a read that is not sequential does not affect the sequential stream
+	 */
+	result = libphdi_readahead_update(
+	          readahead,
+	          16777216,
+	          4096,
+	          &prefetch_offset,
+	          &prefetch_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_readahead_update(
+	          readahead,
+	          196608,
+	          65536,
+	          &prefetch_offset,
+	          &prefetch_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT64(
+	 "prefetch_offset",
+	 (int64_t) prefetch_offset,
+	 (int64_t) 458752 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "prefetch_size",
+	 (uint64_t) prefetch_size,
+	 (uint64_t) 327680 );
+
+	/* Test error cases
+	 */
+	result = libphdi_readahead_update(
+	          NULL,
+	          0,
+	          65536,
+	          &prefetch_offset,
+	          &prefetch_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_readahead_update(
+	          readahead,
+	          -1,
+	          65536,
+	          &prefetch_offset,
+	          &prefetch_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_readahead_update(
+	          readahead,
+	          0,
+	          0,
+	          &prefetch_offset,
+	          &prefetch_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_readahead_update(
+	          readahead,
+	          0,
+	          65536,
+	          NULL,
+	          &prefetch_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_readahead_update(
+	          readahead,
+	          0,
+	          65536,
+	          &prefetch_offset,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_readahead_free(
+	          &readahead,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "readahead",
+	 readahead );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( readahead != NULL )
+	{
+		libphdi_readahead_free(
+		 &readahead,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_readahead_complete_request function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_readahead_complete_request(
+     void )
+{
+	libcerror_error_t *error       = NULL;
+	libphdi_readahead_t *readahead = NULL;
+	size64_t prefetch_size         = 0;
+	off64_t prefetch_offset        = 0;
+	int result                     = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_readahead_initialize(
+	          &readahead,
+	          1048576,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "readahead",
+	 readahead );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_readahead_update(
+	          readahead,
+	          0,
+	          65536,
+	          &prefetch_offset,
+	          &prefetch_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_readahead_update(
+	          readahead,
+	          65536,
+	          65536,
+	          &prefetch_offset,
+	          &prefetch_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_readahead_complete_request(
+	          readahead,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_readahead_complete_request(
+	          readahead,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_readahead_complete_request(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_readahead_free(
+	          &readahead,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "readahead",
+	 readahead );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( readahead != NULL )
+	{
+		libphdi_readahead_free(
+		 &readahead,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_readahead_request_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_readahead_request_initialize(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libphdi_readahead_t *readahead       = NULL;
+	libphdi_readahead_request_t *request = NULL;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_readahead_initialize(
+	          &readahead,
+	          1048576,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "readahead",
+	 readahead );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_readahead_request_initialize(
+	          &request,
+	          readahead,
+	          131072,
+	          65536,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "request",
+	 request );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT64(
+	 "request->offset",
+	 (int64_t) request->offset,
+	 (int64_t) 131072 );
+
+	result = libphdi_readahead_request_free(
+	          &request,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "request",
+	 request );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_readahead_request_initialize(
+	          NULL,
+	          readahead,
+	          131072,
+	          65536,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_readahead_request_initialize(
+	          &request,
+	          NULL,
+	          131072,
+	          65536,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_readahead_request_initialize(
+	          &request,
+	          readahead,
+	          -1,
+	          65536,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_readahead_request_free(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_readahead_free(
+	          &readahead,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "readahead",
+	 readahead );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( request != NULL )
+	{
+		libphdi_readahead_request_free(
+		 &request,
+		 NULL );
+	}
+	if( readahead != NULL )
+	{
+		libphdi_readahead_free(
+		 &readahead,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	PHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+	PHDI_TEST_RUN(
+	 "libphdi_readahead_initialize",
+	 phdi_test_readahead_initialize );
+
+	PHDI_TEST_RUN(
+	 "libphdi_readahead_free",
+	 phdi_test_readahead_free );
+
+	PHDI_TEST_RUN(
+	 "libphdi_readahead_clear",
+	 phdi_test_readahead_clear );
+
+	PHDI_TEST_RUN(
+	 "libphdi_readahead_update",
+	 phdi_test_readahead_update );
+
+	PHDI_TEST_RUN(
+	 "libphdi_readahead_complete_request",
+	 phdi_test_readahead_complete_request );
+
+	PHDI_TEST_RUN(
+	 "libphdi_readahead_request_initialize",
+	 phdi_test_readahead_request_initialize );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,1449 @@
+/*
+ * Library read vector type test program
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "phdi_test_functions.h"
+#include "phdi_test_libbfio.h"
+#include "phdi_test_libcerror.h"
+#include "phdi_test_libphdi.h"
+#include "phdi_test_macros.h"
+#include "phdi_test_memory.h"
+#include "phdi_test_unused.h"
+
+#include "../libphdi/libphdi_segment_table.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+/* Tests the libphdi_segment_table_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_segment_table_initialize(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libphdi_segment_table_t *segment_table = NULL;
+	int result                             = 0;
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+	int number_of_malloc_fail_tests        = 1;
+	int number_of_memset_fail_tests        = 1;
+	int test_number                        = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libphdi_segment_table_initialize(
+	          &segment_table,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_table",
+	 segment_table );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_segment_table_free(
+	          &segment_table,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "segment_table",
+	 segment_table );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_segment_table_initialize(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	segment_table = (libphdi_segment_table_t *) 0x12345678UL;
+
+	result = libphdi_segment_table_initialize(
+	          &segment_table,
+	          &error );
+
+	segment_table = NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_segment_table_initialize with malloc failing
+		 */
+		phdi_test_malloc_attempts_before_fail = test_number;
+
+		result = libphdi_segment_table_initialize(
+		          &segment_table,
+		          &error );
+
+		if( phdi_test_malloc_attempts_before_fail != -1 )
+		{
+			phdi_test_malloc_attempts_before_fail = -1;
+
+			if( segment_table != NULL )
+			{
+				libphdi_segment_table_free(
+				 &segment_table,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "segment_table",
+			 segment_table );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_segment_table_initialize with memset failing
+		 */
+		phdi_test_memset_attempts_before_fail = test_number;
+
+		result = libphdi_segment_table_initialize(
+		          &segment_table,
+		          &error );
+
+		if( phdi_test_memset_attempts_before_fail != -1 )
+		{
+			phdi_test_memset_attempts_before_fail = -1;
+
+			if( segment_table != NULL )
+			{
+				libphdi_segment_table_free(
+				 &segment_table,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "segment_table",
+			 segment_table );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PHDI_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_table != NULL )
+	{
+		libphdi_segment_table_free(
+		 &segment_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_segment_table_free function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_segment_table_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libphdi_segment_table_free(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_segment_table_append_segment function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_segment_table_append_segment(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libphdi_segment_table_t *segment_table = NULL;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_segment_table_initialize(
+	          &segment_table,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_table",
+	 segment_table );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_segment_table_append_segment(
+	          segment_table,
+	          0,
+	          512,
+	          1024,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_segment_table_append_segment(
+	          segment_table,
+	          1,
+	          0,
+	          2048,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "segment_table->number_of_segments",
+	 segment_table->number_of_segments,
+	 2 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "segment_table->media_size",
+	 segment_table->media_size,
+	 (uint64_t) 3072 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT64(
+	 "segment_table->segments[ 1 ].media_offset",
+	 (int64_t) segment_table->segments[ 1 ].media_offset,
+	 (int64_t) 1024 );
+
+	/* Test error cases
+	 */
+	result = libphdi_segment_table_append_segment(
+	          NULL,
+	          0,
+	          0,
+	          1024,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_segment_table_append_segment(
+	          segment_table,
+	          -1,
+	          0,
+	          1024,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_segment_table_append_segment(
+	          segment_table,
+	          0,
+	          -1,
+	          1024,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_segment_table_append_segment(
+	          segment_table,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_segment_table_free(
+	          &segment_table,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "segment_table",
+	 segment_table );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_table != NULL )
+	{
+		libphdi_segment_table_free(
+		 &segment_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_segment_table_get_segment_index_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_segment_table_get_segment_index_at_offset(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libphdi_segment_table_t *segment_table = NULL;
+	off64_t offset                         = 0;
+	int result                             = 0;
+	int segment_index                      = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_segment_table_initialize(
+	          &segment_table,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_table",
+	 segment_table );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The segments have equal sizes except for the last segment which is smaller
+	 */
+	for( segment_index = 0;
+	     segment_index < 8;
+	     segment_index++ )
+	{
+		result = libphdi_segment_table_append_segment(
+		          segment_table,
+		          segment_index,
+		          0,
+		          ( segment_index == 7 ) ? 256 : 1024,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "segment_table->equal_segment_size",
+	 (uint64_t) segment_table->equal_segment_size,
+	 (uint64_t) 1024 );
+
+	/* Test regular cases
+	 */
+	for( offset = 0;
+	     offset < 7424;
+	     offset += 128 )
+	{
+		result = libphdi_segment_table_get_segment_index_at_offset(
+		          segment_table,
+		          offset,
+		          &segment_index,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "segment_index",
+		 segment_index,
+		 (int) ( offset / 1024 ) );
+	}
+	result = libphdi_segment_table_get_segment_index_at_offset(
+	          segment_table,
+	          7424,
+	          &segment_index,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with segments that have different sizes
+	 */
+	result = libphdi_segment_table_append_segment(
+	          segment_table,
+	          8,
+	          0,
+	          1024,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "segment_table->equal_segment_size",
+	 (uint64_t) segment_table->equal_segment_size,
+	 (uint64_t) 0 );
+
+	result = libphdi_segment_table_get_segment_index_at_offset(
+	          segment_table,
+	          7424,
+	          &segment_index,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "segment_index",
+	 segment_index,
+	 8 );
+
+	result = libphdi_segment_table_get_segment_index_at_offset(
+	          segment_table,
+	          7423,
+	          &segment_index,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "segment_index",
+	 segment_index,
+	 7 );
+
+	/* Test error cases
+	 */
+	result = libphdi_segment_table_get_segment_index_at_offset(
+	          NULL,
+	          0,
+	          &segment_index,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_segment_table_get_segment_index_at_offset(
+	          segment_table,
+	          -1,
+	          &segment_index,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_segment_table_get_segment_index_at_offset(
+	          segment_table,
+	          0,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_segment_table_free(
+	          &segment_table,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "segment_table",
+	 segment_table );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_table != NULL )
+	{
+		libphdi_segment_table_free(
+		 &segment_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_segment_table_get_range_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_segment_table_get_range_at_offset(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libphdi_segment_table_t *segment_table = NULL;
+	size64_t range_size                    = 0;
+	off64_t range_file_offset              = 0;
+	int file_io_pool_entry                 = 0;
+	int result                             = 0;
+	int segment_index                      = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_segment_table_initialize(
+	          &segment_table,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_table",
+	 segment_table );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Segment 0 maps media offset 0 to 1023, segment 1 maps 1024 to 1535
+	 * and segment 2 maps 1536 to 3583
+	 */
+	for( segment_index = 0;
+	     segment_index < 3;
+	     segment_index++ )
+	{
+		result = libphdi_segment_table_append_segment(
+		          segment_table,
+		          segment_index,
+		          (off64_t) segment_index * 256,
+		          ( segment_index == 1 ) ? 512 : ( segment_index + 1 ) * 1024,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	result = libphdi_segment_table_get_range_at_offset(
+	          segment_table,
+	          0,
+	          4096,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_entry",
+	 file_io_pool_entry,
+	 0 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT64(
+	 "range_file_offset",
+	 (int64_t) range_file_offset,
+	 (int64_t) 0 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 1024 );
+
+	result = libphdi_segment_table_get_range_at_offset(
+	          segment_table,
+	          1100,
+	          4096,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_entry",
+	 file_io_pool_entry,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT64(
+	 "range_file_offset",
+	 (int64_t) range_file_offset,
+	 (int64_t) 332 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 436 );
+
+	result = libphdi_segment_table_get_range_at_offset(
+	          segment_table,
+	          3583,
+	          4096,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_entry",
+	 file_io_pool_entry,
+	 2 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 1 );
+
+	/* Test maximum range size
+	 */
+	result = libphdi_segment_table_get_range_at_offset(
+	          segment_table,
+	          1536,
+	          16,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_entry",
+	 file_io_pool_entry,
+	 2 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT64(
+	 "range_file_offset",
+	 (int64_t) range_file_offset,
+	 (int64_t) 512 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 16 );
+
+	/* Test offset beyond the segments
+	 */
+	result = libphdi_segment_table_get_range_at_offset(
+	          segment_table,
+	          3584,
+	          4096,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_segment_table_get_range_at_offset(
+	          NULL,
+	          0,
+	          4096,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_segment_table_get_range_at_offset(
+	          segment_table,
+	          -1,
+	          4096,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_segment_table_get_range_at_offset(
+	          segment_table,
+	          0,
+	          4096,
+	          NULL,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_segment_table_get_range_at_offset(
+	          segment_table,
+	          0,
+	          4096,
+	          &file_io_pool_entry,
+	          NULL,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_segment_table_get_range_at_offset(
+	          segment_table,
+	          0,
+	          4096,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_segment_table_free(
+	          &segment_table,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "segment_table",
+	 segment_table );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_table != NULL )
+	{
+		libphdi_segment_table_free(
+		 &segment_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_segment_table_read_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_segment_table_read_buffer_at_offset(
+     void )
+{
+	uint8_t buffer[ 192 ];
+	uint8_t data[ 256 ];
+
+	libbfio_handle_t *file_io_handle       = NULL;
+	libbfio_pool_t *file_io_pool           = NULL;
+	libcerror_error_t *error               = NULL;
+	libphdi_segment_table_t *segment_table = NULL;
+	size_t data_offset                     = 0;
+	ssize_t read_count                     = 0;
+	int file_io_pool_entry                 = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 256;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) data_offset;
+	}
+	result = phdi_test_open_file_io_handle(
+	          &file_io_handle,
+	          data,
+	          256,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_initialize(
+	          &file_io_pool,
+	          0,
+	          LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_append_handle(
+	          file_io_pool,
+	          &file_io_pool_entry,
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The file IO handle is now managed by the file IO pool
+	 */
+	file_io_handle = NULL;
+
+	result = libphdi_segment_table_initialize(
+	          &segment_table,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_table",
+	 segment_table );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The media data consists of the second half of the file followed by the first half
+	 */
+	result = libphdi_segment_table_append_segment(
+	          segment_table,
+	          file_io_pool_entry,
+	          128,
+	          128,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_segment_table_append_segment(
+	          segment_table,
+	          file_io_pool_entry,
+	          0,
+	          128,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	read_count = libphdi_segment_table_read_buffer_at_offset(
+	              segment_table,
+	              file_io_pool,
+	              NULL,
+	              buffer,
+	              192,
+	              64,
+	              &error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 192 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_offset = 0;
+	     data_offset < 192;
+	     data_offset++ )
+	{
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "buffer[ data_offset ]",
+		 (int) buffer[ data_offset ],
+		 (int) data[ ( data_offset + 192 ) % 256 ] );
+	}
+	/* Test reading beyond the end of the segments
+	 */
+	read_count = libphdi_segment_table_read_buffer_at_offset(
+	              segment_table,
+	              file_io_pool,
+	              NULL,
+	              buffer,
+	              192,
+	              192,
+	              &error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 64 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libphdi_segment_table_read_buffer_at_offset(
+	              segment_table,
+	              file_io_pool,
+	              NULL,
+	              buffer,
+	              192,
+	              256,
+	              &error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libphdi_segment_table_read_buffer_at_offset(
+	              NULL,
+	              file_io_pool,
+	              NULL,
+	              buffer,
+	              192,
+	              0,
+	              &error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libphdi_segment_table_read_buffer_at_offset(
+	              segment_table,
+	              file_io_pool,
+	              NULL,
+	              NULL,
+	              192,
+	              0,
+	              &error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libphdi_segment_table_read_buffer_at_offset(
+	              segment_table,
+	              file_io_pool,
+	              NULL,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	PHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_segment_table_free(
+	          &segment_table,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "segment_table",
+	 segment_table );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_free(
+	          &file_io_pool,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_table != NULL )
+	{
+		libphdi_segment_table_free(
+		 &segment_table,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	PHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+	PHDI_TEST_RUN(
+	 "libphdi_segment_table_initialize",
+	 phdi_test_segment_table_initialize );
+
+	PHDI_TEST_RUN(
+	 "libphdi_segment_table_free",
+	 phdi_test_segment_table_free );
+
+	PHDI_TEST_RUN(
+	 "libphdi_segment_table_append_segment",
+	 phdi_test_segment_table_append_segment );
+
+	PHDI_TEST_RUN(
+	 "libphdi_segment_table_get_segment_index_at_offset",
+	 phdi_test_segment_table_get_segment_index_at_offset );
+
+	PHDI_TEST_RUN(
+	 "libphdi_segment_table_get_range_at_offset",
+	 phdi_test_segment_table_get_range_at_offset );
+
+	PHDI_TEST_RUN(
+	 "libphdi_segment_table_read_buffer_at_offset",
+	 phdi_test_segment_table_read_buffer_at_offset );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,740 @@
+/*
+ * Library statistics type test program
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "phdi_test_libcerror.h"
+#include "phdi_test_libphdi.h"
+#include "phdi_test_macros.h"
+#include "phdi_test_memory.h"
+#include "phdi_test_unused.h"
+
+#include "../libphdi/libphdi_statistics.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+/* Tests the libphdi_statistics_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_statistics_initialize(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libphdi_statistics_t *statistics = NULL;
+	int result                       = 0;
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+	int number_of_malloc_fail_tests  = 1;
+	int number_of_memset_fail_tests  = 1;
+	int test_number                  = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libphdi_statistics_initialize(
+	          &statistics,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "statistics",
+	 statistics );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_statistics_free(
+	          &statistics,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "statistics",
+	 statistics );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_statistics_initialize(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	statistics = (libphdi_statistics_t *) 0x12345678UL;
+
+	result = libphdi_statistics_initialize(
+	          &statistics,
+	          &error );
+
+	statistics = NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_statistics_initialize with malloc failing
+		 */
+		phdi_test_malloc_attempts_before_fail = test_number;
+
+		result = libphdi_statistics_initialize(
+		          &statistics,
+		          &error );
+
+		if( phdi_test_malloc_attempts_before_fail != -1 )
+		{
+			phdi_test_malloc_attempts_before_fail = -1;
+
+			if( statistics != NULL )
+			{
+				libphdi_statistics_free(
+				 &statistics,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "statistics",
+			 statistics );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_statistics_initialize with memset failing
+		 */
+		phdi_test_memset_attempts_before_fail = test_number;
+
+		result = libphdi_statistics_initialize(
+		          &statistics,
+		          &error );
+
+		if( phdi_test_memset_attempts_before_fail != -1 )
+		{
+			phdi_test_memset_attempts_before_fail = -1;
+
+			if( statistics != NULL )
+			{
+				libphdi_statistics_free(
+				 &statistics,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "statistics",
+			 statistics );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PHDI_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( statistics != NULL )
+	{
+		libphdi_statistics_free(
+		 &statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_statistics_free function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_statistics_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libphdi_statistics_free(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_statistics_get_values function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_statistics_get_values(
+     void )
+{
+	uint64_t values[ LIBPHDI_NUMBER_OF_STATISTICS ];
+
+	libcerror_error_t *error         = NULL;
+	libphdi_statistics_t *statistics = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_statistics_initialize(
+	          &statistics,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "statistics",
+	 statistics );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	libphdi_statistics_add_value(
+	 statistics,
+	 LIBPHDI_STATISTIC_LOGICAL_BYTES_READ,
+	 512 );
+
+	libphdi_statistics_add_value(
+	 statistics,
+	 LIBPHDI_STATISTIC_LOGICAL_BYTES_READ,
+	 1024 );
+
+	libphdi_statistics_add_value(
+	 statistics,
+	 LIBPHDI_STATISTIC_SPARSE_BYTES_READ,
+	 4096 );
+
+	/* Values for an unsupported statistic are ignored
+	 */
+	libphdi_statistics_add_value(
+	 statistics,
+	 LIBPHDI_NUMBER_OF_STATISTICS,
+	 1 );
+
+	/* Test regular cases
+	 */
+	result = libphdi_statistics_get_values(
+	          statistics,
+	          values,
+	          LIBPHDI_NUMBER_OF_STATISTICS,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBPHDI_STATISTIC_LOGICAL_BYTES_READ ]",
+	 values[ LIBPHDI_STATISTIC_LOGICAL_BYTES_READ ],
+	 (uint64_t) 1536 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBPHDI_STATISTIC_SPARSE_BYTES_READ ]",
+	 values[ LIBPHDI_STATISTIC_SPARSE_BYTES_READ ],
+	 (uint64_t) 4096 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBPHDI_STATISTIC_PHYSICAL_BYTES_READ ]",
+	 values[ LIBPHDI_STATISTIC_PHYSICAL_BYTES_READ ],
+	 (uint64_t) 0 );
+
+	result = libphdi_statistics_reset(
+	          statistics,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_statistics_get_values(
+	          statistics,
+	          values,
+	          1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBPHDI_STATISTIC_LOGICAL_BYTES_READ ]",
+	 values[ LIBPHDI_STATISTIC_LOGICAL_BYTES_READ ],
+	 (uint64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libphdi_statistics_get_values(
+	          NULL,
+	          values,
+	          LIBPHDI_NUMBER_OF_STATISTICS,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_statistics_get_values(
+	          statistics,
+	          NULL,
+	          LIBPHDI_NUMBER_OF_STATISTICS,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_statistics_get_values(
+	          statistics,
+	          values,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_statistics_get_values(
+	          statistics,
+	          values,
+	          LIBPHDI_NUMBER_OF_STATISTICS + 1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_statistics_free(
+	          &statistics,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "statistics",
+	 statistics );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( statistics != NULL )
+	{
+		libphdi_statistics_free(
+		 &statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_statistics_get_snapshot_depth_value function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_statistics_get_snapshot_depth_value(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libphdi_statistics_t *statistics = NULL;
+	uint64_t value                   = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_statistics_initialize(
+	          &statistics,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "statistics",
+	 statistics );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	libphdi_statistics_add_snapshot_depth_value(
+	 statistics,
+	 1,
+	 2048 );
+
+	/* Depths beyond the tracked depths are accounted to the deepest tracked depth
+	 */
+	libphdi_statistics_add_snapshot_depth_value(
+	 statistics,
+	 LIBPHDI_STATISTICS_NUMBER_OF_SNAPSHOT_DEPTHS + 4,
+	 512 );
+
+	/* Test regular cases
+	 */
+	result = libphdi_statistics_get_snapshot_depth_value(
+	          statistics,
+	          1,
+	          &value,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 2048 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_statistics_get_snapshot_depth_value(
+	          statistics,
+	          LIBPHDI_STATISTICS_NUMBER_OF_SNAPSHOT_DEPTHS - 1,
+	          &value,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 512 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_statistics_get_snapshot_depth_value(
+	          statistics,
+	          LIBPHDI_STATISTICS_NUMBER_OF_SNAPSHOT_DEPTHS,
+	          &value,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_statistics_get_snapshot_depth_value(
+	          NULL,
+	          0,
+	          &value,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_statistics_get_snapshot_depth_value(
+	          statistics,
+	          -1,
+	          &value,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_statistics_get_snapshot_depth_value(
+	          statistics,
+	          0,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_statistics_free(
+	          &statistics,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "statistics",
+	 statistics );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( statistics != NULL )
+	{
+		libphdi_statistics_free(
+		 &statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	PHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+	PHDI_TEST_RUN(
+	 "libphdi_statistics_initialize",
+	 phdi_test_statistics_initialize );
+
+	PHDI_TEST_RUN(
+	 "libphdi_statistics_free",
+	 phdi_test_statistics_free );
+
+	PHDI_TEST_RUN(
+	 "libphdi_statistics_get_values",
+	 phdi_test_statistics_get_values );
+
+	PHDI_TEST_RUN(
+	 "libphdi_statistics_get_snapshot_depth_value",
+	 phdi_test_statistics_get_snapshot_depth_value );
+
+	/* TODO: add tests for libphdi_statistics_read_buffer_at_offset */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+}
+
@@ -33,10 +33,69 @@
 #include "phdi_test_memory.h"
 #include "phdi_test_unused.h"
 
+#include "../libphdi/libphdi_sparse_image_header.h"
 #include "../libphdi/libphdi_storage_image.h"
 
+/* Block allocation table of 8 blocks of 8 sectors where blocks 0 - 2 and 6 - 7 are stored
+ * contiguously, blocks 3 - 4 are sparse and block 5 is stored separately
+ */
+uint8_t phdi_test_storage_image_block_allocation_table_data1[ 32 ] = {
+	0x10, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x50, 0x00, 0x00, 0x00, 0x58, 0x00, 0x00, 0x00 };
+
 #if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
 
+/* Creates a storage image with a sparse image header for testing
+ * Returns 1 if successful or -1 on error
+ */
+int phdi_test_storage_image_initialize_with_sparse_image_header(
+     libphdi_storage_image_t **storage_image,
+     libcerror_error_t **error )
+{
+	static char *function = "phdi_test_storage_image_initialize_with_sparse_image_header";
+
+	if( libphdi_storage_image_initialize(
+	     storage_image,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create storage image.",
+		 function );
+
+		goto on_error;
+	}
+	if( libphdi_sparse_image_header_initialize(
+	     &( ( *storage_image )->sparse_image_header ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sparse image header.",
+		 function );
+
+		goto on_error;
+	}
+	( *storage_image )->sparse_image_header->block_size                         = 8;
+	( *storage_image )->sparse_image_header->number_of_allocation_table_entries = 8;
+	( *storage_image )->sparse_image_header->number_of_sectors                  = 64;
+
+	return( 1 );
+
+on_error:
+	if( *storage_image != NULL )
+	{
+		libphdi_storage_image_free(
+		 storage_image,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Tests the libphdi_storage_image_initialize function
  * Returns 1 if successful or 0 if not
  */
@@ -270,36 +329,853 @@ on_error:
 	return( 0 );
 }
 
-#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+/* Tests the libphdi_storage_image_read_block_allocation_table_data function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_storage_image_read_block_allocation_table_data(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libphdi_storage_image_t *storage_image = NULL;
+	int result                             = 0;
 
-/* The main program
+	/* Initialize test
+	 */
+	result = phdi_test_storage_image_initialize_with_sparse_image_header(
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "storage_image",
+	 storage_image );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_storage_image_read_block_allocation_table_data(
+	          storage_image,
+	          phdi_test_storage_image_block_allocation_table_data1,
+	          32,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_storage_image_read_block_allocation_table_data(
+	          NULL,
+	          phdi_test_storage_image_block_allocation_table_data1,
+	          32,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_read_block_allocation_table_data(
+	          storage_image,
+	          phdi_test_storage_image_block_allocation_table_data1,
+	          32,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_storage_image_free(
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "storage_image",
+	 storage_image );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Initialize test
+	 */
+	result = phdi_test_storage_image_initialize_with_sparse_image_header(
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "storage_image",
+	 storage_image );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_storage_image_read_block_allocation_table_data(
+	          storage_image,
+	          NULL,
+	          32,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_read_block_allocation_table_data(
+	          storage_image,
+	          phdi_test_storage_image_block_allocation_table_data1,
+	          0,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_read_block_allocation_table_data(
+	          storage_image,
+	          phdi_test_storage_image_block_allocation_table_data1,
+	          31,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_storage_image_free(
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "storage_image",
+	 storage_image );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( storage_image != NULL )
+	{
+		libphdi_storage_image_free(
+		 &storage_image,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_storage_image_get_block_descriptor_at_offset function
+ * Returns 1 if successful or 0 if not
  */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-int wmain(
-     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
-     wchar_t * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
-#else
-int main(
-     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
-     char * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
-#endif
+int phdi_test_storage_image_get_block_descriptor_at_offset(
+     void )
 {
-	PHDI_TEST_UNREFERENCED_PARAMETER( argc )
-	PHDI_TEST_UNREFERENCED_PARAMETER( argv )
+	libcerror_error_t *error                     = NULL;
+	libphdi_block_descriptor_t *block_descriptor = NULL;
+	libphdi_storage_image_t *storage_image       = NULL;
+	off64_t block_offset                         = 0;
+	int result                                   = 0;
 
-#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+	/* Initialize test
+	 */
+	result = phdi_test_storage_image_initialize_with_sparse_image_header(
+	          &storage_image,
+	          &error );
 
-	PHDI_TEST_RUN(
-	 "libphdi_storage_image_initialize",
-	 phdi_test_storage_image_initialize );
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	PHDI_TEST_RUN(
-	 "libphdi_storage_image_free",
-	 phdi_test_storage_image_free );
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "storage_image",
+	 storage_image );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* TODO: add tests for libphdi_storage_image_open_read */
+	result = libphdi_storage_image_read_block_allocation_table_data(
+	          storage_image,
+	          phdi_test_storage_image_block_allocation_table_data1,
+	          32,
+	          3,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_storage_image_get_block_descriptor_at_offset(
+	          storage_image,
+	          NULL,
+	          5 * 4096 + 100,
+	          &block_descriptor,
+	          &block_offset,
+	          &error );
 
-	/* TODO: add tests for libphdi_storage_image_read_element_data */
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "block_descriptor",
+	 block_descriptor );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "block_descriptor->file_io_pool_entry",
+	 block_descriptor->file_io_pool_entry,
+	 3 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT64(
+	 "block_descriptor->file_offset",
+	 (int64_t) block_descriptor->file_offset,
+	 (int64_t) 32768 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT64(
+	 "block_offset",
+	 (int64_t) block_offset,
+	 (int64_t) 100 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_storage_image_get_block_descriptor_at_offset(
+	          storage_image,
+	          NULL,
+	          3 * 4096,
+	          &block_descriptor,
+	          &block_offset,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_storage_image_get_block_descriptor_at_offset(
+	          NULL,
+	          NULL,
+	          0,
+	          &block_descriptor,
+	          &block_offset,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_get_block_descriptor_at_offset(
+	          storage_image,
+	          NULL,
+	          -1,
+	          &block_descriptor,
+	          &block_offset,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_get_block_descriptor_at_offset(
+	          storage_image,
+	          NULL,
+	          0,
+	          NULL,
+	          &block_offset,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_get_block_descriptor_at_offset(
+	          storage_image,
+	          NULL,
+	          0,
+	          &block_descriptor,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_storage_image_free(
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "storage_image",
+	 storage_image );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( storage_image != NULL )
+	{
+		libphdi_storage_image_free(
+		 &storage_image,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_storage_image_get_block_range_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_storage_image_get_block_range_at_offset(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libphdi_storage_image_t *storage_image = NULL;
+	size64_t range_size                    = 0;
+	off64_t range_file_offset              = 0;
+	int file_io_pool_entry                 = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = phdi_test_storage_image_initialize_with_sparse_image_header(
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "storage_image",
+	 storage_image );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_storage_image_read_block_allocation_table_data(
+	          storage_image,
+	          phdi_test_storage_image_block_allocation_table_data1,
+	          32,
+	          3,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_storage_image_get_block_range_at_offset(
+	          storage_image,
+	          NULL,
+	          0,
+	          1024 * 1024,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_entry",
+	 file_io_pool_entry,
+	 3 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT64(
+	 "range_file_offset",
+	 (int64_t) range_file_offset,
+	 (int64_t) 8192 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 12288 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_storage_image_get_block_range_at_offset(
+	          storage_image,
+	          NULL,
+	          100,
+	          5000,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT64(
+	 "range_file_offset",
+	 (int64_t) range_file_offset,
+	 (int64_t) 8292 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 5000 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_storage_image_get_block_range_at_offset(
+	          storage_image,
+	          NULL,
+	          12288,
+	          1024 * 1024,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 8192 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_storage_image_get_block_range_at_offset(
+	          storage_image,
+	          NULL,
+	          20480,
+	          1024 * 1024,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT64(
+	 "range_file_offset",
+	 (int64_t) range_file_offset,
+	 (int64_t) 32768 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 4096 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_storage_image_get_block_range_at_offset(
+	          storage_image,
+	          NULL,
+	          24586,
+	          1024 * 1024,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT64(
+	 "range_file_offset",
+	 (int64_t) range_file_offset,
+	 (int64_t) 40970 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 8182 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_storage_image_get_block_range_at_offset(
+	          NULL,
+	          NULL,
+	          0,
+	          1024 * 1024,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_get_block_range_at_offset(
+	          storage_image,
+	          NULL,
+	          -1,
+	          1024 * 1024,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_get_block_range_at_offset(
+	          storage_image,
+	          NULL,
+	          32768,
+	          1024 * 1024,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_get_block_range_at_offset(
+	          storage_image,
+	          NULL,
+	          0,
+	          1024 * 1024,
+	          NULL,
+	          &range_file_offset,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_get_block_range_at_offset(
+	          storage_image,
+	          NULL,
+	          0,
+	          1024 * 1024,
+	          &file_io_pool_entry,
+	          NULL,
+	          &range_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_get_block_range_at_offset(
+	          storage_image,
+	          NULL,
+	          0,
+	          1024 * 1024,
+	          &file_io_pool_entry,
+	          &range_file_offset,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_storage_image_free(
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "storage_image",
+	 storage_image );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( storage_image != NULL )
+	{
+		libphdi_storage_image_free(
+		 &storage_image,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	PHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+	PHDI_TEST_RUN(
+	 "libphdi_storage_image_initialize",
+	 phdi_test_storage_image_initialize );
+
+	PHDI_TEST_RUN(
+	 "libphdi_storage_image_free",
+	 phdi_test_storage_image_free );
+
+	/* TODO: add tests for libphdi_storage_image_read_file_header */
+
+	PHDI_TEST_RUN(
+	 "libphdi_storage_image_read_block_allocation_table_data",
+	 phdi_test_storage_image_read_block_allocation_table_data );
+
+	/* TODO: add tests for libphdi_storage_image_read_block_allocation_table */
+
+	PHDI_TEST_RUN(
+	 "libphdi_storage_image_get_block_descriptor_at_offset",
+	 phdi_test_storage_image_get_block_descriptor_at_offset );
+
+	PHDI_TEST_RUN(
+	 "libphdi_storage_image_get_block_range_at_offset",
+	 phdi_test_storage_image_get_block_range_at_offset );
 
 #endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
 
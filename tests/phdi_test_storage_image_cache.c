@@ -0,0 +1,1282 @@
+/*
+ * Library storage_image_cache type test program
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "phdi_test_libcerror.h"
+#include "phdi_test_libphdi.h"
+#include "phdi_test_macros.h"
+#include "phdi_test_memory.h"
+#include "phdi_test_unused.h"
+
+#include "../libphdi/libphdi_storage_image.h"
+#include "../libphdi/libphdi_storage_image_cache.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+/* Adds a new storage image to the storage image cache for testing
+ * Returns 1 if successful or -1 on error
+ */
+int phdi_test_storage_image_cache_set_new_storage_image(
+     libphdi_storage_image_cache_t *storage_image_cache,
+     int extent_index,
+     libcerror_error_t **error )
+{
+	libphdi_storage_image_t *storage_image = NULL;
+	static char *function                  = "phdi_test_storage_image_cache_set_new_storage_image";
+
+	if( libphdi_storage_image_initialize(
+	     &storage_image,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create storage image.",
+		 function );
+
+		goto on_error;
+	}
+	if( libphdi_storage_image_cache_set_storage_image_by_index(
+	     storage_image_cache,
+	     extent_index,
+	     storage_image,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set storage image: %d.",
+		 function,
+		 extent_index );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( storage_image != NULL )
+	{
+		libphdi_storage_image_free(
+		 &storage_image,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the libphdi_storage_image_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_storage_image_cache_initialize(
+     void )
+{
+	libcerror_error_t *error                           = NULL;
+	libphdi_storage_image_cache_t *storage_image_cache = NULL;
+	int result                                         = 0;
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+	int number_of_malloc_fail_tests                    = 1;
+	int number_of_memset_fail_tests                    = 1;
+	int test_number                                    = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libphdi_storage_image_cache_initialize(
+	          &storage_image_cache,
+	          4,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "storage_image_cache",
+	 storage_image_cache );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_storage_image_cache_free(
+	          &storage_image_cache,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "storage_image_cache",
+	 storage_image_cache );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_storage_image_cache_initialize(
+	          NULL,
+	          4,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	storage_image_cache = (libphdi_storage_image_cache_t *) 0x12345678UL;
+
+	result = libphdi_storage_image_cache_initialize(
+	          &storage_image_cache,
+	          4,
+	          &error );
+
+	storage_image_cache = NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_cache_initialize(
+	          &storage_image_cache,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_storage_image_cache_initialize with malloc failing
+		 */
+		phdi_test_malloc_attempts_before_fail = test_number;
+
+		result = libphdi_storage_image_cache_initialize(
+		          &storage_image_cache,
+		          4,
+		          &error );
+
+		if( phdi_test_malloc_attempts_before_fail != -1 )
+		{
+			phdi_test_malloc_attempts_before_fail = -1;
+
+			if( storage_image_cache != NULL )
+			{
+				libphdi_storage_image_cache_free(
+				 &storage_image_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "storage_image_cache",
+			 storage_image_cache );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_storage_image_cache_initialize with memset failing
+		 */
+		phdi_test_memset_attempts_before_fail = test_number;
+
+		result = libphdi_storage_image_cache_initialize(
+		          &storage_image_cache,
+		          4,
+		          &error );
+
+		if( phdi_test_memset_attempts_before_fail != -1 )
+		{
+			phdi_test_memset_attempts_before_fail = -1;
+
+			if( storage_image_cache != NULL )
+			{
+				libphdi_storage_image_cache_free(
+				 &storage_image_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "storage_image_cache",
+			 storage_image_cache );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PHDI_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( storage_image_cache != NULL )
+	{
+		libphdi_storage_image_cache_free(
+		 &storage_image_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_storage_image_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_storage_image_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libphdi_storage_image_cache_free(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_storage_image_cache_get_storage_image_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_storage_image_cache_get_storage_image_by_index(
+     void )
+{
+	libcerror_error_t *error                           = NULL;
+	libphdi_storage_image_cache_t *storage_image_cache = NULL;
+	libphdi_storage_image_t *storage_image             = NULL;
+	int extent_index                                   = 0;
+	int result                                         = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_storage_image_cache_initialize(
+	          &storage_image_cache,
+	          4,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "storage_image_cache",
+	 storage_image_cache );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = phdi_test_storage_image_cache_set_new_storage_image(
+	          storage_image_cache,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_storage_image_cache_get_storage_image_by_index(
+	          storage_image_cache,
+	          0,
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "storage_image",
+	 storage_image );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Repeated use of the most recently used entry does not promote it
+	 */
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "storage_image_cache->number_of_protected_entries",
+	 storage_image_cache->number_of_protected_entries,
+	 0 );
+
+	result = phdi_test_storage_image_cache_set_new_storage_image(
+	          storage_image_cache,
+	          1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Use after another entry was used promotes the entry
+	 */
+	result = libphdi_storage_image_cache_get_storage_image_by_index(
+	          storage_image_cache,
+	          0,
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "storage_image_cache->number_of_protected_entries",
+	 storage_image_cache->number_of_protected_entries,
+	 1 );
+
+	/* A single pass over other extents does not evict the promoted entry
+	 */
+	for( extent_index = 2;
+	     extent_index < 6;
+	     extent_index++ )
+	{
+		result = phdi_test_storage_image_cache_set_new_storage_image(
+		          storage_image_cache,
+		          extent_index,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libphdi_storage_image_cache_get_storage_image_by_index(
+	          storage_image_cache,
+	          1,
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_storage_image_cache_get_storage_image_by_index(
+	          storage_image_cache,
+	          0,
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_storage_image_cache_get_storage_image_by_index(
+	          storage_image_cache,
+	          100,
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "storage_image_cache->number_of_hits",
+	 storage_image_cache->number_of_hits,
+	 (uint64_t) 3 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "storage_image_cache->number_of_misses",
+	 storage_image_cache->number_of_misses,
+	 (uint64_t) 2 );
+
+	/* Test error cases
+	 */
+	result = libphdi_storage_image_cache_get_storage_image_by_index(
+	          NULL,
+	          0,
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_cache_get_storage_image_by_index(
+	          storage_image_cache,
+	          -1,
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_cache_get_storage_image_by_index(
+	          storage_image_cache,
+	          0,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_storage_image_cache_free(
+	          &storage_image_cache,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "storage_image_cache",
+	 storage_image_cache );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( storage_image_cache != NULL )
+	{
+		libphdi_storage_image_cache_free(
+		 &storage_image_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_storage_image_cache_peek_storage_image_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_storage_image_cache_peek_storage_image_by_index(
+     void )
+{
+	libcerror_error_t *error                           = NULL;
+	libphdi_storage_image_cache_t *storage_image_cache = NULL;
+	libphdi_storage_image_t *storage_image             = NULL;
+	int extent_index                                   = 0;
+	int result                                         = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_storage_image_cache_initialize(
+	          &storage_image_cache,
+	          4,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "storage_image_cache",
+	 storage_image_cache );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( extent_index = 0;
+	     extent_index < 2;
+	     extent_index++ )
+	{
+		result = phdi_test_storage_image_cache_set_new_storage_image(
+		          storage_image_cache,
+		          extent_index,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	result = libphdi_storage_image_cache_peek_storage_image_by_index(
+	          storage_image_cache,
+	          0,
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "storage_image",
+	 storage_image );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Peeking does not promote the entry, but marks it as referenced
+	 * since another entry was used
+	 */
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "storage_image_cache->number_of_protected_entries",
+	 storage_image_cache->number_of_protected_entries,
+	 0 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "storage_image_cache->entries[ 0 ]->is_referenced",
+	 storage_image_cache->entries[ 0 ]->is_referenced,
+	 1 );
+
+	/* The referenced entry is promoted instead of evicted
+	 */
+	for( extent_index = 2;
+	     extent_index < 5;
+	     extent_index++ )
+	{
+		result = phdi_test_storage_image_cache_set_new_storage_image(
+		          storage_image_cache,
+		          extent_index,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "storage_image_cache->entries[ 0 ]",
+	 storage_image_cache->entries[ 0 ] );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "storage_image_cache->entries[ 1 ]",
+	 storage_image_cache->entries[ 1 ] );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "storage_image_cache->number_of_protected_entries",
+	 storage_image_cache->number_of_protected_entries,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "storage_image_cache->entries[ 0 ]->is_referenced",
+	 storage_image_cache->entries[ 0 ]->is_referenced,
+	 0 );
+
+	result = libphdi_storage_image_cache_peek_storage_image_by_index(
+	          storage_image_cache,
+	          100,
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "storage_image_cache->number_of_hits",
+	 storage_image_cache->number_of_hits,
+	 (uint64_t) 1 );
+
+	/* Test error cases
+	 */
+	result = libphdi_storage_image_cache_peek_storage_image_by_index(
+	          NULL,
+	          0,
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_cache_peek_storage_image_by_index(
+	          storage_image_cache,
+	          -1,
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_cache_peek_storage_image_by_index(
+	          storage_image_cache,
+	          0,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_storage_image_cache_free(
+	          &storage_image_cache,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "storage_image_cache",
+	 storage_image_cache );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( storage_image_cache != NULL )
+	{
+		libphdi_storage_image_cache_free(
+		 &storage_image_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_storage_image_cache_set_storage_image_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_storage_image_cache_set_storage_image_by_index(
+     void )
+{
+	libcerror_error_t *error                           = NULL;
+	libphdi_storage_image_cache_t *storage_image_cache = NULL;
+	libphdi_storage_image_t *storage_image             = NULL;
+	int result                                         = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_storage_image_cache_initialize(
+	          &storage_image_cache,
+	          2,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "storage_image_cache",
+	 storage_image_cache );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_storage_image_initialize(
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "storage_image",
+	 storage_image );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_storage_image_cache_set_storage_image_by_index(
+	          storage_image_cache,
+	          3,
+	          storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "storage_image_cache->entries_size",
+	 storage_image_cache->entries_size,
+	 4 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "storage_image_cache->number_of_probationary_entries",
+	 storage_image_cache->number_of_probationary_entries,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libphdi_storage_image_cache_set_storage_image_by_index(
+	          NULL,
+	          0,
+	          storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_cache_set_storage_image_by_index(
+	          storage_image_cache,
+	          -1,
+	          storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_cache_set_storage_image_by_index(
+	          storage_image_cache,
+	          0,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The storage image is managed by the storage image cache
+	 */
+	result = libphdi_storage_image_cache_set_storage_image_by_index(
+	          storage_image_cache,
+	          3,
+	          storage_image,
+	          &error );
+
+	storage_image = NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_storage_image_cache_free(
+	          &storage_image_cache,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "storage_image_cache",
+	 storage_image_cache );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( storage_image != NULL )
+	{
+		libphdi_storage_image_free(
+		 &storage_image,
+		 NULL );
+	}
+	if( storage_image_cache != NULL )
+	{
+		libphdi_storage_image_cache_free(
+		 &storage_image_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_storage_image_cache_set_maximum_number_of_entries function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_storage_image_cache_set_maximum_number_of_entries(
+     void )
+{
+	libcerror_error_t *error                           = NULL;
+	libphdi_storage_image_cache_t *storage_image_cache = NULL;
+	libphdi_storage_image_t *storage_image             = NULL;
+	int extent_index                                   = 0;
+	int result                                         = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_storage_image_cache_initialize(
+	          &storage_image_cache,
+	          4,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "storage_image_cache",
+	 storage_image_cache );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( extent_index = 0;
+	     extent_index < 4;
+	     extent_index++ )
+	{
+		result = phdi_test_storage_image_cache_set_new_storage_image(
+		          storage_image_cache,
+		          extent_index,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libphdi_storage_image_cache_get_storage_image_by_index(
+	          storage_image_cache,
+	          0,
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libphdi_storage_image_cache_set_maximum_number_of_entries(
+	          storage_image_cache,
+	          1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "storage_image_cache->number_of_probationary_entries",
+	 storage_image_cache->number_of_probationary_entries,
+	 0 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "storage_image_cache->number_of_protected_entries",
+	 storage_image_cache->number_of_protected_entries,
+	 1 );
+
+	result = libphdi_storage_image_cache_get_storage_image_by_index(
+	          storage_image_cache,
+	          0,
+	          &storage_image,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_storage_image_cache_set_maximum_number_of_entries(
+	          NULL,
+	          1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_cache_set_maximum_number_of_entries(
+	          storage_image_cache,
+	          0,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libphdi_storage_image_cache_free(
+	          &storage_image_cache,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "storage_image_cache",
+	 storage_image_cache );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( storage_image_cache != NULL )
+	{
+		libphdi_storage_image_cache_free(
+		 &storage_image_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	PHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+	PHDI_TEST_RUN(
+	 "libphdi_storage_image_cache_initialize",
+	 phdi_test_storage_image_cache_initialize );
+
+	PHDI_TEST_RUN(
+	 "libphdi_storage_image_cache_free",
+	 phdi_test_storage_image_cache_free );
+
+	PHDI_TEST_RUN(
+	 "libphdi_storage_image_cache_get_storage_image_by_index",
+	 phdi_test_storage_image_cache_get_storage_image_by_index );
+
+	PHDI_TEST_RUN(
+	 "libphdi_storage_image_cache_peek_storage_image_by_index",
+	 phdi_test_storage_image_cache_peek_storage_image_by_index );
+
+	PHDI_TEST_RUN(
+	 "libphdi_storage_image_cache_set_storage_image_by_index",
+	 phdi_test_storage_image_cache_set_storage_image_by_index );
+
+	PHDI_TEST_RUN(
+	 "libphdi_storage_image_cache_set_maximum_number_of_entries",
+	 phdi_test_storage_image_cache_set_maximum_number_of_entries );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
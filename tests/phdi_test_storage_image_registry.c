@@ -0,0 +1,835 @@
+/*
+ * Library storage_image_registry type test program
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "phdi_test_libcerror.h"
+#include "phdi_test_libphdi.h"
+#include "phdi_test_macros.h"
+#include "phdi_test_memory.h"
+#include "phdi_test_unused.h"
+
+#include "../libphdi/libphdi_storage_image_registry.h"
+
+/* Tests the libphdi_storage_image_registry_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_storage_image_registry_initialize(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libphdi_storage_image_registry_t *registry = NULL;
+	int result                                 = 0;
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+	int number_of_malloc_fail_tests            = 1;
+	int number_of_memset_fail_tests            = 1;
+	int test_number                            = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libphdi_storage_image_registry_initialize(
+	          &registry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "registry",
+	 registry );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_storage_image_registry_free(
+	          &registry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "registry",
+	 registry );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_storage_image_registry_initialize(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	registry = (libphdi_storage_image_registry_t *) 0x12345678UL;
+
+	result = libphdi_storage_image_registry_initialize(
+	          &registry,
+	          &error );
+
+	registry = NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PHDI_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_storage_image_registry_initialize with malloc failing
+		 */
+		phdi_test_malloc_attempts_before_fail = test_number;
+
+		result = libphdi_storage_image_registry_initialize(
+		          &registry,
+		          &error );
+
+		if( phdi_test_malloc_attempts_before_fail != -1 )
+		{
+			phdi_test_malloc_attempts_before_fail = -1;
+
+			if( registry != NULL )
+			{
+				libphdi_storage_image_registry_free(
+				 &registry,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "registry",
+			 registry );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libphdi_storage_image_registry_initialize with memset failing
+		 */
+		phdi_test_memset_attempts_before_fail = test_number;
+
+		result = libphdi_storage_image_registry_initialize(
+		          &registry,
+		          &error );
+
+		if( phdi_test_memset_attempts_before_fail != -1 )
+		{
+			phdi_test_memset_attempts_before_fail = -1;
+
+			if( registry != NULL )
+			{
+				libphdi_storage_image_registry_free(
+				 &registry,
+				 NULL );
+			}
+		}
+		else
+		{
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "registry",
+			 registry );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PHDI_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( registry != NULL )
+	{
+		libphdi_storage_image_registry_free(
+		 &registry,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_storage_image_registry_free function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_storage_image_registry_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libphdi_storage_image_registry_free(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+/* Creates a test block allocation table
+ * Returns a pointer to the block allocation table if successful or NULL on error
+ */
+uint32_t *phdi_test_storage_image_registry_create_block_allocation_table(
+           uint32_t number_of_entries,
+           uint32_t first_sector_number )
+{
+	uint32_t *block_allocation_table = NULL;
+	uint32_t entry_index             = 0;
+
+	block_allocation_table = (uint32_t *) memory_allocate(
+	                                       sizeof( uint32_t ) * number_of_entries );
+
+	if( block_allocation_table != NULL )
+	{
+		for( entry_index = 0;
+		     entry_index < number_of_entries;
+		     entry_index++ )
+		{
+			/* Every other block is sparse
+			 */
+			if( ( entry_index % 2 ) == 0 )
+			{
+				block_allocation_table[ entry_index ] = first_sector_number + ( entry_index * 8 );
+			}
+			else
+			{
+				block_allocation_table[ entry_index ] = 0;
+			}
+		}
+	}
+	return( block_allocation_table );
+}
+
+/* Tests the libphdi_storage_image_registry_insert_block_allocation_table function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_storage_image_registry_insert_block_allocation_table(
+     void )
+{
+	libcerror_error_t *error                                = NULL;
+	libphdi_storage_image_registry_entry_t *registry_entry1 = NULL;
+	libphdi_storage_image_registry_entry_t *registry_entry2 = NULL;
+	libphdi_storage_image_registry_entry_t *registry_entry3 = NULL;
+	libphdi_storage_image_registry_t *registry              = NULL;
+	uint32_t *block_allocation_table1                       = NULL;
+	uint32_t *block_allocation_table2                       = NULL;
+	uint32_t *block_allocation_table3                       = NULL;
+	int number_of_block_allocation_tables                   = 0;
+	int number_of_references                                = 0;
+	int result                                              = 0;
+
+	/* Initialize test
+	 */
+	result = libphdi_storage_image_registry_initialize(
+	          &registry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "registry",
+	 registry );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	block_allocation_table1 = phdi_test_storage_image_registry_create_block_allocation_table(
+	                           64,
+	                           32 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "block_allocation_table1",
+	 block_allocation_table1 );
+
+	block_allocation_table2 = phdi_test_storage_image_registry_create_block_allocation_table(
+	                           64,
+	                           32 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "block_allocation_table2",
+	 block_allocation_table2 );
+
+	block_allocation_table3 = phdi_test_storage_image_registry_create_block_allocation_table(
+	                           64,
+	                           40 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "block_allocation_table3",
+	 block_allocation_table3 );
+
+	/* Test regular cases
+	 */
+	result = libphdi_storage_image_registry_insert_block_allocation_table(
+	          registry,
+	          &block_allocation_table1,
+	          64,
+	          &registry_entry1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "registry_entry1",
+	 registry_entry1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that an identical block allocation table is replaced by the registered copy
+	 */
+	result = libphdi_storage_image_registry_insert_block_allocation_table(
+	          registry,
+	          &block_allocation_table2,
+	          64,
+	          &registry_entry2,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INTPTR(
+	 "registry_entry2",
+	 (intptr_t) registry_entry2,
+	 (intptr_t) registry_entry1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INTPTR(
+	 "block_allocation_table2",
+	 (intptr_t) block_allocation_table2,
+	 (intptr_t) block_allocation_table1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a different block allocation table is not shared
+	 */
+	result = libphdi_storage_image_registry_insert_block_allocation_table(
+	          registry,
+	          &block_allocation_table3,
+	          64,
+	          &registry_entry3,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_NOT_EQUAL_INTPTR(
+	 "registry_entry3",
+	 (intptr_t) registry_entry3,
+	 (intptr_t) registry_entry1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT32(
+	 "block_allocation_table3[ 2 ]",
+	 block_allocation_table3[ 2 ],
+	 (uint32_t) 56 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_storage_image_registry_get_number_of_block_allocation_tables(
+	          registry,
+	          &number_of_block_allocation_tables,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "number_of_block_allocation_tables",
+	 number_of_block_allocation_tables,
+	 2 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_storage_image_registry_get_number_of_references(
+	          registry,
+	          &number_of_references,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "number_of_references",
+	 number_of_references,
+	 3 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_storage_image_registry_insert_block_allocation_table(
+	          NULL,
+	          &block_allocation_table1,
+	          64,
+	          &registry_entry1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_registry_insert_block_allocation_table(
+	          registry,
+	          NULL,
+	          64,
+	          &registry_entry1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_registry_insert_block_allocation_table(
+	          registry,
+	          &block_allocation_table1,
+	          0,
+	          &registry_entry1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libphdi_storage_image_registry_insert_block_allocation_table(
+	          registry,
+	          &block_allocation_table1,
+	          64,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test that the registry cannot be freed while it is referenced
+	 */
+	result = libphdi_storage_image_registry_free(
+	          &registry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "registry",
+	 registry );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	block_allocation_table1 = NULL;
+	block_allocation_table2 = NULL;
+	block_allocation_table3 = NULL;
+
+	result = libphdi_storage_image_registry_release_entry(
+	          &registry_entry3,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "registry_entry3",
+	 registry_entry3 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_storage_image_registry_release_entry(
+	          &registry_entry2,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_storage_image_registry_get_number_of_block_allocation_tables(
+	          registry,
+	          &number_of_block_allocation_tables,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "number_of_block_allocation_tables",
+	 number_of_block_allocation_tables,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_storage_image_registry_release_entry(
+	          &registry_entry1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_storage_image_registry_get_number_of_block_allocation_tables(
+	          registry,
+	          &number_of_block_allocation_tables,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "number_of_block_allocation_tables",
+	 number_of_block_allocation_tables,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_storage_image_registry_free(
+	          &registry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "registry",
+	 registry );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( registry_entry3 != NULL )
+	{
+		libphdi_storage_image_registry_release_entry(
+		 &registry_entry3,
+		 NULL );
+	}
+	else if( block_allocation_table3 != NULL )
+	{
+		memory_free(
+		 block_allocation_table3 );
+	}
+	if( registry_entry2 != NULL )
+	{
+		libphdi_storage_image_registry_release_entry(
+		 &registry_entry2,
+		 NULL );
+	}
+	else if( block_allocation_table2 != NULL )
+	{
+		memory_free(
+		 block_allocation_table2 );
+	}
+	if( registry_entry1 != NULL )
+	{
+		libphdi_storage_image_registry_release_entry(
+		 &registry_entry1,
+		 NULL );
+	}
+	else if( block_allocation_table1 != NULL )
+	{
+		memory_free(
+		 block_allocation_table1 );
+	}
+	if( registry != NULL )
+	{
+		libphdi_storage_image_registry_free(
+		 &registry,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libphdi_storage_image_registry_release_entry function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_storage_image_registry_release_entry(
+     void )
+{
+	libcerror_error_t *error                               = NULL;
+	libphdi_storage_image_registry_entry_t *registry_entry = NULL;
+	int result                                             = 0;
+
+	/* Test regular cases
+	 */
+	result = libphdi_storage_image_registry_release_entry(
+	          &registry_entry,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libphdi_storage_image_registry_release_entry(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	PHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+	PHDI_TEST_RUN(
+	 "libphdi_storage_image_registry_initialize",
+	 phdi_test_storage_image_registry_initialize );
+
+	PHDI_TEST_RUN(
+	 "libphdi_storage_image_registry_free",
+	 phdi_test_storage_image_registry_free );
+
+#if defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT )
+
+	PHDI_TEST_RUN(
+	 "libphdi_storage_image_registry_insert_block_allocation_table",
+	 phdi_test_storage_image_registry_insert_block_allocation_table );
+
+	PHDI_TEST_RUN(
+	 "libphdi_storage_image_registry_release_entry",
+	 phdi_test_storage_image_registry_release_entry );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPHDI_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
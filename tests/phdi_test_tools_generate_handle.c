@@ -0,0 +1,1613 @@
+/*
+ * Tools generate handle type test program
+ *
+ * Copyright (C) 2015-2025, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "phdi_test_libcerror.h"
+#include "phdi_test_libphdi.h"
+#include "phdi_test_macros.h"
+#include "phdi_test_unused.h"
+
+#include "../phditools/generate_handle.h"
+
+/* The directory the generated images are written to, which is relative
+ * to the working directory of the test
+ */
+#define PHDI_TEST_TOOLS_GENERATE_HANDLE_DIRECTORY	_SYSTEM_STRING( "phdi_test_tools_generate_handle.tmp" )
+
+/* The size of the reads of the media data, which is not a multiple of the block size
+ */
+#define PHDI_TEST_TOOLS_GENERATE_HANDLE_READ_SIZE	( ( 3 * 1048576 ) + 4099 )
+
+/* The maximum number of requests of a vector read
+ */
+#define PHDI_TEST_TOOLS_GENERATE_HANDLE_NUMBER_OF_REQUESTS	16
+
+/* Tests the generate_handle_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_tools_generate_handle_initialize(
+     void )
+{
+	generate_handle_t *generate_handle = NULL;
+	libcerror_error_t *error           = NULL;
+	int result                         = 0;
+
+	/* Test regular cases
+	 */
+	result = generate_handle_initialize(
+	          &generate_handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "generate_handle",
+	 generate_handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = generate_handle_free(
+	          &generate_handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "generate_handle",
+	 generate_handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = generate_handle_initialize(
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	generate_handle = (generate_handle_t *) 0x12345678UL;
+
+	result = generate_handle_initialize(
+	          &generate_handle,
+	          &error );
+
+	generate_handle = NULL;
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( generate_handle != NULL )
+	{
+		generate_handle_free(
+		 &generate_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the generate_handle_set_block_size function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_tools_generate_handle_set_block_size(
+     void )
+{
+	generate_handle_t *generate_handle = NULL;
+	libcerror_error_t *error           = NULL;
+	int result                         = 0;
+
+	result = generate_handle_initialize(
+	          &generate_handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "generate_handle",
+	 generate_handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = generate_handle_set_block_size(
+	          generate_handle,
+	          _SYSTEM_STRING( "65536" ),
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "generate_handle->block_size",
+	 (uint64_t) generate_handle->block_size,
+	 (uint64_t) 65536 );
+
+	/* The block size must be a multiple of 512
+	 */
+	result = generate_handle_set_block_size(
+	          generate_handle,
+	          _SYSTEM_STRING( "1000" ),
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "generate_handle->block_size",
+	 (uint64_t) generate_handle->block_size,
+	 (uint64_t) 65536 );
+
+	/* Test error cases
+	 */
+	result = generate_handle_set_block_size(
+	          NULL,
+	          _SYSTEM_STRING( "65536" ),
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = generate_handle_set_block_size(
+	          generate_handle,
+	          NULL,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = generate_handle_free(
+	          &generate_handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "generate_handle",
+	 generate_handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( generate_handle != NULL )
+	{
+		generate_handle_free(
+		 &generate_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the generate_handle_set_disk_type function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_tools_generate_handle_set_disk_type(
+     void )
+{
+	generate_handle_t *generate_handle = NULL;
+	libcerror_error_t *error           = NULL;
+	int result                         = 0;
+
+	result = generate_handle_initialize(
+	          &generate_handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "generate_handle",
+	 generate_handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = generate_handle_set_disk_type(
+	          generate_handle,
+	          _SYSTEM_STRING( "fixed" ),
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "generate_handle->disk_type",
+	 generate_handle->disk_type,
+	 GENERATE_HANDLE_DISK_TYPE_FIXED );
+
+	result = generate_handle_set_disk_type(
+	          generate_handle,
+	          _SYSTEM_STRING( "bogus" ),
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = generate_handle_set_disk_type(
+	          NULL,
+	          _SYSTEM_STRING( "fixed" ),
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = generate_handle_free(
+	          &generate_handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "generate_handle",
+	 generate_handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( generate_handle != NULL )
+	{
+		generate_handle_free(
+		 &generate_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the generate_handle_block_is_stored function
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_tools_generate_handle_block_is_stored(
+     void )
+{
+	generate_handle_t *generate_handle = NULL;
+	libcerror_error_t *error           = NULL;
+	uint64_t block_index               = 0;
+	uint64_t number_of_stored_blocks   = 0;
+	int result                         = 0;
+
+	result = generate_handle_initialize(
+	          &generate_handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "generate_handle",
+	 generate_handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the allocation is deterministic and close to the allocation density
+	 */
+	for( block_index = 0;
+	     block_index < 10000;
+	     block_index++ )
+	{
+		result = generate_handle_block_is_stored(
+		          generate_handle,
+		          0,
+		          block_index );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 generate_handle_block_is_stored(
+		  generate_handle,
+		  0,
+		  block_index ) );
+
+		if( result != 0 )
+		{
+			number_of_stored_blocks++;
+		}
+	}
+	PHDI_TEST_ASSERT_LESS_THAN_UINT64(
+	 "number_of_stored_blocks",
+	 number_of_stored_blocks,
+	 (uint64_t) 5500 );
+
+	PHDI_TEST_ASSERT_LESS_THAN_UINT64(
+	 "number_of_stored_blocks",
+	 (uint64_t) 4500,
+	 number_of_stored_blocks );
+
+	/* Clean up
+	 */
+	result = generate_handle_free(
+	          &generate_handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "generate_handle",
+	 generate_handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( generate_handle != NULL )
+	{
+		generate_handle_free(
+		 &generate_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Reads the media data of a generated image in reads of several MiB that cross
+ * block boundaries and compares it against the expected block stamps
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_tools_generate_handle_read_media_data(
+     generate_handle_t *generate_handle,
+     libphdi_handle_t *handle )
+{
+	uint8_t stamp[ GENERATE_HANDLE_BLOCK_STAMP_SIZE ];
+
+	libcerror_error_t *error = NULL;
+	uint8_t *buffer          = NULL;
+	uint8_t *expected_data   = NULL;
+	void *memcpy_result      = NULL;
+	void *memset_result      = NULL;
+	size64_t read_size       = 0;
+	size_t stamp_offset      = 0;
+	size_t stamp_size        = 0;
+	ssize_t read_count       = 0;
+	off64_t block_offset     = 0;
+	off64_t offset           = 0;
+	uint64_t block_index     = 0;
+	int result               = 0;
+	int snapshot_index       = 0;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * PHDI_TEST_TOOLS_GENERATE_HANDLE_READ_SIZE );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	expected_data = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * PHDI_TEST_TOOLS_GENERATE_HANDLE_READ_SIZE );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "expected_data",
+	 expected_data );
+
+	/* Start in the middle of the first block so that every read starts and ends within a block
+	 */
+	offset = (off64_t) ( generate_handle->block_size / 2 ) + 7;
+
+	while( (size64_t) offset < generate_handle->media_size )
+	{
+		read_size = generate_handle->media_size - (size64_t) offset;
+
+		if( read_size > PHDI_TEST_TOOLS_GENERATE_HANDLE_READ_SIZE )
+		{
+			read_size = PHDI_TEST_TOOLS_GENERATE_HANDLE_READ_SIZE;
+		}
+		read_count = libphdi_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              (size_t) read_size,
+		              offset,
+		              &error );
+
+		PHDI_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) read_size );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The data of a block consists of its stamp followed by zero bytes
+		 */
+		memset_result = memory_set(
+		                 expected_data,
+		                 0,
+		                 (size_t) read_size );
+
+		PHDI_TEST_ASSERT_IS_NOT_NULL(
+		 "memset_result",
+		 memset_result );
+
+		for( block_index = (uint64_t) offset / generate_handle->block_size;
+		     block_index < generate_handle->number_of_blocks;
+		     block_index++ )
+		{
+			block_offset = (off64_t) ( block_index * generate_handle->block_size );
+
+			if( block_offset >= ( offset + (off64_t) read_size ) )
+			{
+				break;
+			}
+			if( ( block_offset + GENERATE_HANDLE_BLOCK_STAMP_SIZE ) <= offset )
+			{
+				continue;
+			}
+			result = generate_handle_get_block_snapshot_index(
+			          generate_handle,
+			          block_index,
+			          &snapshot_index,
+			          &error );
+
+			PHDI_TEST_ASSERT_NOT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			/* A block that is not stored in any snapshot is read as zero bytes
+			 */
+			if( result == 0 )
+			{
+				continue;
+			}
+			result = generate_handle_get_block_stamp(
+			          generate_handle,
+			          block_index,
+			          snapshot_index,
+			          stamp,
+			          GENERATE_HANDLE_BLOCK_STAMP_SIZE,
+			          &error );
+
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			/* Only the part of the stamp that is within the read is compared
+			 */
+			stamp_offset = 0;
+			stamp_size   = GENERATE_HANDLE_BLOCK_STAMP_SIZE;
+
+			if( block_offset < offset )
+			{
+				stamp_offset = (size_t) ( offset - block_offset );
+				stamp_size  -= stamp_offset;
+				block_offset = offset;
+			}
+			if( ( block_offset + (off64_t) stamp_size ) > ( offset + (off64_t) read_size ) )
+			{
+				stamp_size = (size_t) ( ( offset + (off64_t) read_size ) - block_offset );
+			}
+			memcpy_result = memory_copy(
+			                 &( expected_data[ block_offset - offset ] ),
+			                 &( stamp[ stamp_offset ] ),
+			                 stamp_size );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "memcpy_result",
+			 memcpy_result );
+		}
+		result = memory_compare(
+		          buffer,
+		          expected_data,
+		          (size_t) read_size );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		offset += (off64_t) read_size;
+	}
+	/* Clean up
+	 */
+	memory_free(
+	 expected_data );
+
+	expected_data = NULL;
+
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( expected_data != NULL )
+	{
+		memory_free(
+		 expected_data );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( 0 );
+}
+
+/* Retrieves the stamp that is expected at the start of a block
+ * A block that is not stored in any snapshot is read as zero bytes
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_tools_generate_handle_get_expected_stamp(
+     generate_handle_t *generate_handle,
+     uint64_t block_index,
+     uint8_t *stamp )
+{
+	libcerror_error_t *error = NULL;
+	void *memset_result      = NULL;
+	int result               = 0;
+	int snapshot_index       = 0;
+
+	result = generate_handle_get_block_snapshot_index(
+	          generate_handle,
+	          block_index,
+	          &snapshot_index,
+	          &error );
+
+	PHDI_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result == 0 )
+	{
+		memset_result = memory_set(
+		                 stamp,
+		                 0,
+		                 sizeof( uint8_t ) * GENERATE_HANDLE_BLOCK_STAMP_SIZE );
+
+		PHDI_TEST_ASSERT_IS_NOT_NULL(
+		 "memset_result",
+		 memset_result );
+	}
+	else
+	{
+		result = generate_handle_get_block_stamp(
+		          generate_handle,
+		          block_index,
+		          snapshot_index,
+		          stamp,
+		          GENERATE_HANDLE_BLOCK_STAMP_SIZE,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Reads the stamp of every block of a generated image with vector reads
+ * and compares it against the expected block stamp
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_tools_generate_handle_read_vector(
+     generate_handle_t *generate_handle,
+     libphdi_handle_t *handle )
+{
+	uint8_t buffers_data[ PHDI_TEST_TOOLS_GENERATE_HANDLE_NUMBER_OF_REQUESTS ][ GENERATE_HANDLE_BLOCK_STAMP_SIZE ];
+	uint8_t expected_stamp[ GENERATE_HANDLE_BLOCK_STAMP_SIZE ];
+	void *buffers[ PHDI_TEST_TOOLS_GENERATE_HANDLE_NUMBER_OF_REQUESTS ];
+	size_t buffer_sizes[ PHDI_TEST_TOOLS_GENERATE_HANDLE_NUMBER_OF_REQUESTS ];
+	off64_t offsets[ PHDI_TEST_TOOLS_GENERATE_HANDLE_NUMBER_OF_REQUESTS ];
+	ssize_t read_counts[ PHDI_TEST_TOOLS_GENERATE_HANDLE_NUMBER_OF_REQUESTS ];
+
+	libcerror_error_t *error = NULL;
+	uint64_t block_index     = 0;
+	int number_of_requests   = 0;
+	int request_index        = 0;
+	int result               = 0;
+
+	for( block_index = 0;
+	     block_index < generate_handle->number_of_blocks;
+	     block_index += (uint64_t) number_of_requests )
+	{
+		number_of_requests = PHDI_TEST_TOOLS_GENERATE_HANDLE_NUMBER_OF_REQUESTS;
+
+		if( (uint64_t) number_of_requests > ( generate_handle->number_of_blocks - block_index ) )
+		{
+			number_of_requests = (int) ( generate_handle->number_of_blocks - block_index );
+		}
+		/* The requests are submitted in reverse order of their offsets
+		 */
+		for( request_index = 0;
+		     request_index < number_of_requests;
+		     request_index++ )
+		{
+			buffers[ request_index ]      = buffers_data[ request_index ];
+			buffer_sizes[ request_index ] = GENERATE_HANDLE_BLOCK_STAMP_SIZE;
+			offsets[ request_index ]      = (off64_t) ( ( block_index + (uint64_t) ( number_of_requests - 1 - request_index ) ) * generate_handle->block_size );
+			read_counts[ request_index ]  = 0;
+		}
+		result = libphdi_handle_read_vector(
+		          handle,
+		          buffers,
+		          buffer_sizes,
+		          offsets,
+		          read_counts,
+		          number_of_requests,
+		          &error );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( request_index = 0;
+		     request_index < number_of_requests;
+		     request_index++ )
+		{
+			PHDI_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_counts[ request_index ]",
+			 read_counts[ request_index ],
+			 (ssize_t) GENERATE_HANDLE_BLOCK_STAMP_SIZE );
+
+			result = phdi_test_tools_generate_handle_get_expected_stamp(
+			          generate_handle,
+			          block_index + (uint64_t) ( number_of_requests - 1 - request_index ),
+			          expected_stamp );
+
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			result = memory_compare(
+			          buffers_data[ request_index ],
+			          expected_stamp,
+			          GENERATE_HANDLE_BLOCK_STAMP_SIZE );
+
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Retrieves the allocation of every block of a generated image, including the
+ * data stored in parent snapshots, and compares it against the stored blocks
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_tools_generate_handle_get_allocation(
+     generate_handle_t *generate_handle,
+     libphdi_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	off64_t block_offset     = 0;
+	off64_t next_offset      = 0;
+	uint64_t block_index     = 0;
+	int result               = 0;
+	int snapshot_index       = 0;
+
+	for( block_index = 0;
+	     block_index < generate_handle->number_of_blocks;
+	     block_index++ )
+	{
+		block_offset = (off64_t) ( block_index * generate_handle->block_size );
+
+		result = generate_handle_get_block_snapshot_index(
+		          generate_handle,
+		          block_index,
+		          &snapshot_index,
+		          &error );
+
+		PHDI_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( result != 0 )
+		{
+			/* A block that is stored in any snapshot is data
+			 */
+			result = libphdi_handle_get_next_data_offset(
+			          handle,
+			          block_offset,
+			          0,
+			          &next_offset,
+			          &error );
+
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			PHDI_TEST_ASSERT_EQUAL_INT64(
+			 "next_offset",
+			 (int64_t) next_offset,
+			 (int64_t) block_offset );
+		}
+		else if( generate_handle->disk_type == GENERATE_HANDLE_DISK_TYPE_EXPANDING )
+		{
+			/* A block of an expanding disk that is not stored in any snapshot is a hole
+			 */
+			result = libphdi_handle_get_next_hole_offset(
+			          handle,
+			          block_offset,
+			          0,
+			          &next_offset,
+			          &error );
+
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			PHDI_TEST_ASSERT_EQUAL_INT64(
+			 "next_offset",
+			 (int64_t) next_offset,
+			 (int64_t) block_offset );
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Borrows the stamp of every block of a generated image and compares it
+ * against the expected block stamp
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_tools_generate_handle_borrow_buffers(
+     generate_handle_t *generate_handle,
+     libphdi_handle_t *handle )
+{
+	uint8_t expected_stamp[ GENERATE_HANDLE_BLOCK_STAMP_SIZE ];
+
+	libcerror_error_t *error          = NULL;
+	libphdi_handle_t *borrowed_handle = NULL;
+	const uint8_t *buffer             = NULL;
+	size_t buffer_size                = 0;
+	uint64_t block_index              = 0;
+	int result                        = 0;
+
+	for( block_index = 0;
+	     block_index < generate_handle->number_of_blocks;
+	     block_index++ )
+	{
+		result = libphdi_handle_borrow_buffer_at_offset(
+		          handle,
+		          (off64_t) ( block_index * generate_handle->block_size ),
+		          GENERATE_HANDLE_BLOCK_STAMP_SIZE,
+		          &buffer,
+		          &buffer_size,
+		          &error );
+
+		PHDI_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The data cannot be borrowed without memory mapping support
+		 */
+		if( result == 0 )
+		{
+			continue;
+		}
+		PHDI_TEST_ASSERT_EQUAL_SIZE(
+		 "buffer_size",
+		 buffer_size,
+		 (size_t) GENERATE_HANDLE_BLOCK_STAMP_SIZE );
+
+		result = phdi_test_tools_generate_handle_get_expected_stamp(
+		          generate_handle,
+		          block_index,
+		          expected_stamp );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = memory_compare(
+		          buffer,
+		          expected_stamp,
+		          GENERATE_HANDLE_BLOCK_STAMP_SIZE );
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* Test that the handle is not freed while a buffer is borrowed
+		 */
+		if( block_index == 0 )
+		{
+			borrowed_handle = handle;
+
+			result = libphdi_handle_free(
+			          &borrowed_handle,
+			          &error );
+
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "borrowed_handle",
+			 borrowed_handle );
+
+			PHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+		result = libphdi_handle_release_buffer(
+		          handle,
+		          buffer,
+		          &error );
+
+		buffer = NULL;
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer != NULL )
+	{
+		libphdi_handle_release_buffer(
+		 handle,
+		 buffer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the generate_handle_write function by generating an image and reading
+ * the stamp of every block and the media data back with libphdi
+ * Returns 1 if successful or 0 if not
+ */
+int phdi_test_tools_generate_handle_write(
+     const system_character_t *disk_type,
+     const system_character_t *media_size,
+     const system_character_t *block_size,
+     const system_character_t *number_of_extents,
+     const system_character_t *number_of_snapshots,
+     const system_character_t *fragmentation )
+{
+	uint8_t buffer[ GENERATE_HANDLE_BLOCK_STAMP_SIZE ];
+	uint8_t empty_stamp[ GENERATE_HANDLE_BLOCK_STAMP_SIZE ];
+	uint8_t expected_stamp[ GENERATE_HANDLE_BLOCK_STAMP_SIZE ];
+
+	generate_handle_t *generate_handle = NULL;
+	libcerror_error_t *error           = NULL;
+	libphdi_handle_t *handle           = NULL;
+	void *memset_result                = NULL;
+	size64_t media_data_size           = 0;
+	ssize_t read_count                 = 0;
+	uint64_t block_index               = 0;
+	int result                         = 0;
+	int snapshot_index                 = 0;
+
+	/* Initialize test
+	 */
+	memset_result = memory_set(
+	                 empty_stamp,
+	                 0,
+	                 sizeof( uint8_t ) * GENERATE_HANDLE_BLOCK_STAMP_SIZE );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "memset_result",
+	 memset_result );
+
+	result = generate_handle_initialize(
+	          &generate_handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "generate_handle",
+	 generate_handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = generate_handle_set_disk_type(
+	          generate_handle,
+	          disk_type,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = generate_handle_set_media_size(
+	          generate_handle,
+	          media_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = generate_handle_set_block_size(
+	          generate_handle,
+	          block_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = generate_handle_set_number_of_extents(
+	          generate_handle,
+	          number_of_extents,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = generate_handle_set_number_of_snapshots(
+	          generate_handle,
+	          number_of_snapshots,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = generate_handle_set_fragmentation(
+	          generate_handle,
+	          fragmentation,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = generate_handle_write(
+	          generate_handle,
+	          PHDI_TEST_TOOLS_GENERATE_HANDLE_DIRECTORY,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Read the generated image back with libphdi
+	 */
+	result = libphdi_handle_initialize(
+	          &handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libphdi_handle_open_wide(
+	          handle,
+	          PHDI_TEST_TOOLS_GENERATE_HANDLE_DIRECTORY,
+	          LIBPHDI_OPEN_READ,
+	          &error );
+#else
+	result = libphdi_handle_open(
+	          handle,
+	          PHDI_TEST_TOOLS_GENERATE_HANDLE_DIRECTORY,
+	          LIBPHDI_OPEN_READ,
+	          &error );
+#endif
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Map the extent data files so that the block stamps can be borrowed
+	 */
+	result = libphdi_handle_set_memory_map_extent_data_files(
+	          handle,
+	          1,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_handle_open_extent_data_files(
+	          handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_handle_get_media_size(
+	          handle,
+	          &media_data_size,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "media_data_size",
+	 (uint64_t) media_data_size,
+	 (uint64_t) generate_handle->media_size );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( block_index = 0;
+	     block_index < generate_handle->number_of_blocks;
+	     block_index++ )
+	{
+		read_count = libphdi_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              GENERATE_HANDLE_BLOCK_STAMP_SIZE,
+		              (off64_t) ( block_index * generate_handle->block_size ),
+		              &error );
+
+		PHDI_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) GENERATE_HANDLE_BLOCK_STAMP_SIZE );
+
+		PHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = generate_handle_get_block_snapshot_index(
+		          generate_handle,
+		          block_index,
+		          &snapshot_index,
+		          &error );
+
+		PHDI_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		/* A block that is not stored in any snapshot is read as zero bytes
+		 */
+		if( result == 0 )
+		{
+			result = memory_compare(
+			          buffer,
+			          empty_stamp,
+			          GENERATE_HANDLE_BLOCK_STAMP_SIZE );
+		}
+		else
+		{
+			result = generate_handle_get_block_stamp(
+			          generate_handle,
+			          block_index,
+			          snapshot_index,
+			          expected_stamp,
+			          GENERATE_HANDLE_BLOCK_STAMP_SIZE,
+			          &error );
+
+			PHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			PHDI_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = memory_compare(
+			          buffer,
+			          expected_stamp,
+			          GENERATE_HANDLE_BLOCK_STAMP_SIZE );
+		}
+
+		PHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Read the media data in reads that cross block boundaries
+	 */
+	result = phdi_test_tools_generate_handle_read_media_data(
+	          generate_handle,
+	          handle );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Read the block stamps with vector reads, which resolve the data ranges
+	 * without the data block cache
+	 */
+	result = phdi_test_tools_generate_handle_read_vector(
+	          generate_handle,
+	          handle );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = phdi_test_tools_generate_handle_borrow_buffers(
+	          generate_handle,
+	          handle );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = phdi_test_tools_generate_handle_get_allocation(
+	          generate_handle,
+	          handle );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Clean up
+	 */
+	result = libphdi_handle_close(
+	          handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libphdi_handle_free(
+	          &handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = generate_handle_free(
+	          &generate_handle,
+	          &error );
+
+	PHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "generate_handle",
+	 generate_handle );
+
+	PHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libphdi_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( generate_handle != NULL )
+	{
+		generate_handle_free(
+		 &generate_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	PHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+	PHDI_TEST_RUN(
+	 "generate_handle_initialize",
+	 phdi_test_tools_generate_handle_initialize );
+
+	PHDI_TEST_RUN(
+	 "generate_handle_set_block_size",
+	 phdi_test_tools_generate_handle_set_block_size );
+
+	PHDI_TEST_RUN(
+	 "generate_handle_set_disk_type",
+	 phdi_test_tools_generate_handle_set_disk_type );
+
+	PHDI_TEST_RUN(
+	 "generate_handle_block_is_stored",
+	 phdi_test_tools_generate_handle_block_is_stored );
+
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+
+	/* Expanding disk with a single extent and no snapshots
+	 */
+	PHDI_TEST_RUN_WITH_ARGS(
+	 "generate_handle_write",
+	 phdi_test_tools_generate_handle_write,
+	 _SYSTEM_STRING( "expanding" ),
+	 _SYSTEM_STRING( "4194304" ),
+	 _SYSTEM_STRING( "65536" ),
+	 _SYSTEM_STRING( "1" ),
+	 _SYSTEM_STRING( "1" ),
+	 _SYSTEM_STRING( "0" ) );
+
+	/* Expanding disk with multiple extents, a snapshot chain and fragmentation
+	 */
+	PHDI_TEST_RUN_WITH_ARGS(
+	 "generate_handle_write",
+	 phdi_test_tools_generate_handle_write,
+	 _SYSTEM_STRING( "expanding" ),
+	 _SYSTEM_STRING( "8388608" ),
+	 _SYSTEM_STRING( "65536" ),
+	 _SYSTEM_STRING( "3" ),
+	 _SYSTEM_STRING( "4" ),
+	 _SYSTEM_STRING( "50" ) );
+
+	/* Expanding disk with a snapshot chain of 1 MiB blocks that is read in multiple MiB
+	 */
+	PHDI_TEST_RUN_WITH_ARGS(
+	 "generate_handle_write",
+	 phdi_test_tools_generate_handle_write,
+	 _SYSTEM_STRING( "expanding" ),
+	 _SYSTEM_STRING( "33554432" ),
+	 _SYSTEM_STRING( "1048576" ),
+	 _SYSTEM_STRING( "2" ),
+	 _SYSTEM_STRING( "3" ),
+	 _SYSTEM_STRING( "25" ) );
+
+	/* Expanding disk with a snapshot chain of 32 MiB blocks, which exceeds the maximum
+	 * block size of the layer map, hence the data of the parent snapshot is resolved
+	 * without a layer map
+	 */
+	PHDI_TEST_RUN_WITH_ARGS(
+	 "generate_handle_write",
+	 phdi_test_tools_generate_handle_write,
+	 _SYSTEM_STRING( "expanding" ),
+	 _SYSTEM_STRING( "134217728" ),
+	 _SYSTEM_STRING( "33554432" ),
+	 _SYSTEM_STRING( "1" ),
+	 _SYSTEM_STRING( "2" ),
+	 _SYSTEM_STRING( "0" ) );
+
+	/* Fixed disk with a snapshot
+	 */
+	PHDI_TEST_RUN_WITH_ARGS(
+	 "generate_handle_write",
+	 phdi_test_tools_generate_handle_write,
+	 _SYSTEM_STRING( "fixed" ),
+	 _SYSTEM_STRING( "1048576" ),
+	 _SYSTEM_STRING( "4096" ),
+	 _SYSTEM_STRING( "1" ),
+	 _SYSTEM_STRING( "2" ),
+	 _SYSTEM_STRING( "0" ) );
+
+#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -7,7 +7,7 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
-LIBRARY_TESTS="block_descriptor block_tree block_tree_node data_files disk_descriptor_xml_file disk_parameters error extent_descriptor extent_table extent_values image_descriptor image_values io_handle notify snapshot_values system_string xml_tag";
+LIBRARY_TESTS="block_allocation_table block_descriptor block_tree block_tree_node borrowed_buffers completion_queue data_block data_cache data_files disk_descriptor_xml_file disk_parameters error extent_descriptor extent_table extent_values image_descriptor image_values io_handle layer_map mapped_file metadata_index notify read_vector readahead segment_table snapshot_values statistics storage_image storage_image_cache storage_image_registry system_string tools_generate_handle xml_tag";
 LIBRARY_TESTS_WITH_INPUT="handle support";
 OPTION_SETS=();
 